@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+"""Stage the SPIFFS data folder as pre-compressed, content-hashed assets.
+
+Reads source/ESPEED32/data and writes build/spiffs_data, which is what
+mkspiffs packs. Every file gets an ETag (hash of the bytes the browser
+ends up with). Text assets are stored gzip-only when that is smaller, so the
+firmware never has to probe for a ".gz" twin. Local src/href references in
+HTML pages get a "?v=<etag>" suffix; the firmware serves such versioned URLs
+with far-future caching and everything else with revalidation (304).
+
+The firmware loads the resulting /assets.json into its route table at boot.
+"""
+
+from __future__ import annotations
+
+import argparse
+import gzip
+import hashlib
+import json
+import posixpath
+import re
+import shutil
+import sys
+from pathlib import Path
+
+
+ROOT_DIR = Path(__file__).resolve().parents[1]
+DATA_DIR = ROOT_DIR / "source/ESPEED32" / "data"
+STAGE_DIR = ROOT_DIR / "build" / "spiffs_data"
+MANIFEST_NAME = "assets.json"
+
+# Keep in sync with STATIC_ASSET_MAX_ROUTES / STATIC_ASSET_PATH_MAX in static_assets.h
+MAX_ROUTES = 48
+PATH_MAX = 47
+ETAG_LEN = 16
+
+COMPRESSIBLE = {".html", ".css", ".js", ".svg", ".txt"}
+SKIPPED = {".md"}
+# Read by the firmware itself with SPIFFS.open(): never compressed or renamed
+RAW_PATHS = {"/ui/release.json"}
+
+REF_RE = re.compile(r'((?:src|href)=")([^"#?:]+)(")')
+
+
+class AssetBuildError(RuntimeError):
+    pass
+
+
+def parse_args() -> argparse.Namespace:
+    parser = argparse.ArgumentParser(description="Stage SPIFFS assets with gzip and ETags.")
+    parser.add_argument("--data", type=Path, default=DATA_DIR, help="Source data folder.")
+    parser.add_argument("--out", type=Path, default=STAGE_DIR, help="Staging folder for mkspiffs.")
+    return parser.parse_args()
+
+
+def etag_for(content: bytes) -> str:
+    return hashlib.sha256(content).hexdigest()[:ETAG_LEN]
+
+
+def gzip_bytes(content: bytes) -> bytes:
+    # mtime=0 keeps the output byte-identical between builds
+    return gzip.compress(content, compresslevel=9, mtime=0)
+
+
+def rewrite_refs(html: str, page_path: str, etags: dict[str, str]) -> str:
+    page_dir = posixpath.dirname(page_path)
+
+    def repl(match: re.Match[str]) -> str:
+        ref = match.group(2)
+        if ref.startswith("//"):
+            return match.group(0)
+        target = ref if ref.startswith("/") else posixpath.join(page_dir, ref)
+        target = posixpath.normpath(target)
+        etag = etags.get(target)
+        if etag is None:
+            return match.group(0)
+        return f"{match.group(1)}{ref}?v={etag}{match.group(3)}"
+
+    return REF_RE.sub(repl, html)
+
+
+def collect(data_dir: Path) -> dict[str, bytes]:
+    files: dict[str, bytes] = {}
+    for path in sorted(data_dir.rglob("*")):
+        if not path.is_file() or path.name.startswith(".") or path.suffix in SKIPPED:
+            continue
+        if path.suffix == ".gz":
+            continue  # Stale hand-made twins; every text asset is compressed here
+        route = "/" + path.relative_to(data_dir).as_posix()
+        if len(route) + 3 > PATH_MAX:  # Room for the ".gz" suffix on the device
+            raise AssetBuildError(f"Path too long for the firmware route table: {route}")
+        files[route] = path.read_bytes()
+    return files
+
+
+def build(data_dir: Path, out_dir: Path) -> int:
+    if not data_dir.is_dir():
+        raise AssetBuildError(f"Data directory not found: {data_dir}")
+    files = collect(data_dir)
+    if len(files) > MAX_ROUTES:
+        raise AssetBuildError(f"{len(files)} assets, firmware route table holds {MAX_ROUTES}")
+
+    # HTML pages reference the other assets, so hash those first
+    etags: dict[str, str] = {}
+    for route, content in files.items():
+        if not route.endswith(".html"):
+            etags[route] = etag_for(content)
+    for route, content in files.items():
+        if route.endswith(".html"):
+            text = rewrite_refs(content.decode("utf-8"), route, etags)
+            files[route] = text.encode("utf-8")
+            etags[route] = etag_for(files[route])
+
+    if out_dir.exists():
+        shutil.rmtree(out_dir)
+    out_dir.mkdir(parents=True)
+
+    entries = []
+    raw_bytes = 0
+    stored_bytes = 0
+    for route, content in files.items():
+        stored = content
+        compressed = False
+        if route not in RAW_PATHS and posixpath.splitext(route)[1] in COMPRESSIBLE:
+            packed = gzip_bytes(content)
+            if len(packed) < len(content):
+                stored = packed
+                compressed = True
+        target = out_dir / (route.lstrip("/") + (".gz" if compressed else ""))
+        target.parent.mkdir(parents=True, exist_ok=True)
+        target.write_bytes(stored)
+        raw_bytes += len(content)
+        stored_bytes += len(stored)
+        entries.append({"path": route, "etag": etags[route], "gzip": 1 if compressed else 0, "size": len(stored)})
+
+    manifest = {"format": 1, "assets": entries}
+    (out_dir / MANIFEST_NAME).write_text(json.dumps(manifest, separators=(",", ":")) + "\n", encoding="utf-8")
+
+    print(f"[ASSETS] {len(entries)} assets, {raw_bytes} -> {stored_bytes} bytes in {out_dir}")
+    return 0
+
+
+def main() -> int:
+    args = parse_args()
+    try:
+        return build(args.data.resolve(), args.out.resolve())
+    except AssetBuildError as exc:
+        print(f"[ASSETS] {exc}", file=sys.stderr)
+        return 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
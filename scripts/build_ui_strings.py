@@ -0,0 +1,232 @@
+#!/usr/bin/env python3
+"""Generate the OLED label string pool from ui_strings_src.json.
+
+Reads source/ESPEED32/ui_strings_src.json and writes ui_string_pool.h and
+ui_string_pool.cpp next to it. Every label is stored once, in upper case, in
+one character pool (strings that end another string share its tail). Each
+[table][language][item] is a 16-bit index entry: a 14-bit pool offset plus a
+2-bit rule that ui_text_access.cpp uses to derive the Pascal-case spelling on
+the fly, so the firmware no longer carries a second copy of every table.
+
+Source format, per table:
+  "text":      {"<LANG>": [upper-case labels...]}   same item count per language
+  "pascal":    {"<LANG>" or "*": [spellings...]}    optional: Pascal spellings that are not
+                                                    title case (only the first letter upper)
+  "caseFixed": true                                 optional: shown as written in both cases
+
+Run it after editing the JSON (flash_all.sh runs it before compiling); use
+--check in CI to fail when the generated files are stale.
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import sys
+from pathlib import Path
+
+
+ROOT_DIR = Path(__file__).resolve().parents[1]
+SKETCH_DIR = ROOT_DIR / "source/ESPEED32"
+SOURCE_JSON = SKETCH_DIR / "ui_strings_src.json"
+OUT_HEADER = "ui_string_pool.h"
+OUT_SOURCE = "ui_string_pool.cpp"
+
+OFFSET_BITS = 14
+CASE_FIXED = 0
+CASE_TITLE = 1
+CASE_SENTENCE = 2
+
+
+class StringPoolError(RuntimeError):
+    pass
+
+
+def parse_args() -> argparse.Namespace:
+    parser = argparse.ArgumentParser(description="Generate the deduplicated UI label pool.")
+    parser.add_argument("--src", type=Path, default=SOURCE_JSON, help="Label source JSON.")
+    parser.add_argument("--out", type=Path, default=SKETCH_DIR, help="Folder for the generated files.")
+    parser.add_argument("--check", action="store_true", help="Only verify the generated files are current.")
+    return parser.parse_args()
+
+
+def title_case(text: str) -> str:
+    """Must match uiTextApplyCase() UI_TEXT_CASE_TITLE."""
+    out = []
+    in_word = False
+    for ch in text:
+        if ch.isalpha():
+            out.append(ch.lower() if in_word else ch.upper())
+            in_word = True
+        else:
+            out.append(ch)
+            in_word = False
+    return "".join(out)
+
+
+def sentence_case(text: str) -> str:
+    """Must match uiTextApplyCase() UI_TEXT_CASE_SENTENCE."""
+    out = []
+    seen = False
+    for ch in text:
+        if ch.isalpha():
+            out.append(ch.lower() if seen else ch.upper())
+            seen = True
+        else:
+            out.append(ch)
+    return "".join(out)
+
+
+def case_rule(table_id: str, lang: str, text: str, overrides: list[str], fixed: bool) -> int:
+    if fixed:
+        return CASE_FIXED
+    if text != text.upper():
+        raise StringPoolError(f"{table_id}/{lang}: '{text}' is not upper case (or mark the table caseFixed)")
+    for spelling in overrides:
+        if spelling.upper() != text:
+            continue
+        if spelling == title_case(text):
+            return CASE_TITLE
+        if spelling == sentence_case(text):
+            return CASE_SENTENCE
+        raise StringPoolError(f"{table_id}/{lang}: Pascal '{spelling}' is neither title nor sentence case")
+    return CASE_TITLE
+
+
+def load_tables(path: Path) -> tuple[list[str], list[dict]]:
+    data = json.loads(path.read_text(encoding="utf-8"))
+    languages = data["languages"]
+    tables = []
+    for table in data["tables"]:
+        table_id = table["id"]
+        texts = table["text"]
+        if sorted(texts) != sorted(languages):
+            raise StringPoolError(f"{table_id}: languages must be exactly {languages}")
+        counts = {len(texts[lang]) for lang in languages}
+        if len(counts) != 1:
+            raise StringPoolError(f"{table_id}: item count differs between languages")
+        pascal = table.get("pascal", {})
+        unknown = set(pascal) - set(languages) - {"*"}
+        if unknown:
+            raise StringPoolError(f"{table_id}: unknown pascal language(s) {sorted(unknown)}")
+        fixed = bool(table.get("caseFixed", False))
+        entries = []
+        for lang in languages:
+            overrides = pascal.get("*", []) + pascal.get(lang, [])
+            for text in texts[lang]:
+                if not text.isascii() or '"' in text or "\\" in text:
+                    raise StringPoolError(f"{table_id}/{lang}: '{text}' must be plain ASCII")
+                entries.append((lang, text, case_rule(table_id, lang, text, overrides, fixed)))
+        tables.append({"id": table_id, "count": counts.pop(), "entries": entries})
+    return languages, tables
+
+
+def build_pool(tables: list[dict]) -> tuple[list[tuple[int, str]], dict[str, int]]:
+    unique = sorted({text for table in tables for _, text, _ in table["entries"]}, key=lambda s: (-len(s), s))
+    placed: list[tuple[int, str]] = []
+    offsets: dict[str, int] = {}
+    size = 0
+    for text in unique:
+        host = next((item for item in placed if item[1].endswith(text)), None)
+        if host is not None:
+            offsets[text] = host[0] + len(host[1]) - len(text)
+            continue
+        placed.append((size, text))
+        offsets[text] = size
+        size += len(text) + 1
+    if size >= (1 << OFFSET_BITS):
+        raise StringPoolError(f"pool is {size} bytes, offsets only cover {1 << OFFSET_BITS}")
+    return placed, offsets
+
+
+def render(languages: list[str], tables: list[dict], placed: list[tuple[int, str]], offsets: dict[str, int]) -> tuple[str, str]:
+    pool_size = sum(len(text) + 1 for _, text in placed)
+    entry_count = sum(len(table["entries"]) for table in tables)
+    max_len = max(len(text) for _, text in placed)
+    banner = f"/* Generated by scripts/build_ui_strings.py from {SOURCE_JSON.name}. Do not edit. */\n"
+
+    h = [banner, "#ifndef UI_STRING_POOL_H_", "#define UI_STRING_POOL_H_", "", "#include <stdint.h>", ""]
+    h.append(f"/* {pool_size} pool bytes and {entry_count} index entries for {len(languages)} languages */")
+    h.append("typedef enum {")
+    for table in tables:
+        h.append(f"  UI_TEXT_{table['id']},")
+    h.append("  UI_TEXT_TABLE_COUNT")
+    h.append("} UiTextTable_enum;")
+    h.append("")
+    for table in tables:
+        name = f"UI_TEXT_{table['id']}_COUNT"
+        h.append(f"#define {name:<36}{table['count']}")
+    h.append("")
+    h.append(f"#define UI_TEXT_LANG_COUNT        {len(languages)}")
+    h.append(f"#define UI_TEXT_MAX_LEN           {max_len}     /* Longest label, without the terminator */")
+    h.append(f"#define UI_TEXT_OFFSET_MASK       0x{(1 << OFFSET_BITS) - 1:04X}U")
+    h.append(f"#define UI_TEXT_CASE_SHIFT        {OFFSET_BITS}")
+    h.append(f"#define UI_TEXT_CASE_FIXED        {CASE_FIXED}     /* Shown as stored in both text cases */")
+    h.append(f"#define UI_TEXT_CASE_TITLE        {CASE_TITLE}     /* Pascal: first letter of every word upper */")
+    h.append(f"#define UI_TEXT_CASE_SENTENCE     {CASE_SENTENCE}     /* Pascal: only the first letter upper */")
+    h.append("")
+    h.append("typedef struct {")
+    h.append("  uint16_t firstEntry;   /* UI_TEXT_INDEX position of [language 0][item 0] */")
+    h.append("  uint8_t itemCount;     /* Items per language */")
+    h.append("} UiTextTable_type;")
+    h.append("")
+    h.append("extern const char UI_TEXT_POOL[];")
+    h.append("extern const uint16_t UI_TEXT_INDEX[];")
+    h.append("extern const UiTextTable_type UI_TEXT_TABLES[UI_TEXT_TABLE_COUNT];")
+    h.append("")
+    h.append("#endif  /* UI_STRING_POOL_H_ */")
+
+    c = [banner, f'#include "{OUT_HEADER}"', ""]
+    c.append("/* Upper-case labels, each stored once */")
+    c.append("const char UI_TEXT_POOL[] =")
+    for offset, text in placed:
+        c.append(f'  /* {offset:4d} */ "{text}\\0"')
+    c[-1] += ";"
+    c.append("")
+    c.append("/* [table][language][item]: pool offset | case rule << UI_TEXT_CASE_SHIFT */")
+    c.append("const uint16_t UI_TEXT_INDEX[] = {")
+    for table in tables:
+        c.append(f"  /* {table['id']} */")
+        for li, lang in enumerate(languages):
+            row = table["entries"][li * table["count"]:(li + 1) * table["count"]]
+            values = ", ".join(f"0x{offsets[text] | (rule << OFFSET_BITS):04X}" for _, text, rule in row)
+            c.append(f"  /* {lang:<3} */ {values},")
+    c.append("};")
+    c.append("")
+    c.append("const UiTextTable_type UI_TEXT_TABLES[UI_TEXT_TABLE_COUNT] = {")
+    first = 0
+    for table in tables:
+        c.append(f"  {{{first:4d}, {table['count']:2d}}},  /* UI_TEXT_{table['id']} */")
+        first += len(table["entries"])
+    c.append("};")
+    return "\n".join(h) + "\n", "\n".join(c) + "\n"
+
+
+def main() -> int:
+    args = parse_args()
+    try:
+        languages, tables = load_tables(args.src)
+        placed, offsets = build_pool(tables)
+    except (StringPoolError, KeyError, json.JSONDecodeError) as exc:
+        print(f"[UI STRINGS] {exc}", file=sys.stderr)
+        return 1
+    header, source = render(languages, tables, placed, offsets)
+    outputs = {args.out / OUT_HEADER: header, args.out / OUT_SOURCE: source}
+    if args.check:
+        stale = [path.name for path, text in outputs.items()
+                 if not path.exists() or path.read_text(encoding="utf-8") != text]
+        if stale:
+            print(f"[UI STRINGS] Stale: {', '.join(stale)}; run scripts/build_ui_strings.py", file=sys.stderr)
+            return 1
+        return 0
+    for path, text in outputs.items():
+        if not path.exists() or path.read_text(encoding="utf-8") != text:
+            path.write_text(text, encoding="utf-8")
+    total = sum(len(t["entries"]) for t in tables)
+    pool_size = sum(len(text) + 1 for _, text in placed)
+    print(f"[UI STRINGS] {total} labels -> {pool_size} pool bytes + {total * 2} index bytes")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
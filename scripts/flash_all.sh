@@ -5,6 +5,7 @@ ROOT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
 ARDUINO_JSON="$ROOT_DIR/.vscode/arduino.json"
 SPIFFS_SCRIPT="$ROOT_DIR/scripts/upload_spiffs.sh"
 DOCS_REFRESH_SCRIPT="$ROOT_DIR/scripts/refresh_generated_docs.sh"
+UI_STRINGS_SCRIPT="$ROOT_DIR/scripts/build_ui_strings.py"
 
 PORT=""
 BAUD=""
@@ -255,6 +256,10 @@ fi
 if [[ "$SPIFFS_ONLY" -eq 0 ]]; then
   mkdir -p "$BUILD_DIR"
 
+  if [[ -f "$UI_STRINGS_SCRIPT" ]] && command -v python3 >/dev/null 2>&1; then
+    python3 "$UI_STRINGS_SCRIPT"
+  fi
+
   echo "[FLASH] Compiling firmware"
   compile_cmd=(arduino-cli compile --fqbn "$BOARD" --build-path "$BUILD_DIR")
   if [[ -n "$BOARD_OPTIONS" ]]; then
@@ -0,0 +1,472 @@
+/* Host build of the control-path math (source/ESPEED32/control_math.h) and of the throttle
+ * table builder (throttle_lut.cpp, built against the shim in scripts/host/shim).
+ * Golden vectors: every stage is driven through a fixed grid of settings and input traces;
+ * the outputs of each case are hashed and compared with control_math_golden.txt. Throttle
+ * tables are built by throttleLutService() and digested entry by entry; each table must also
+ * match throttleCurveEvaluate() and never fall with the trigger.
+ * Accuracy: controlMathAtan2Deg10() against atan2() over the TLE493D 12-bit and 14-bit
+ * field ranges, failing when the error exceeds HOST_ATAN_MAX_ERR_DEG10.
+ * Benchmark: ns per call of each stage and of the chained per-tick pipeline. Lap detection
+ * is not covered: it still lives inline in the control task with its hardware inputs.
+ *
+ *   control_math_host --check control_math_golden.txt
+ *   control_math_host --update control_math_golden.txt   (after an intended behaviour change)
+ *   control_math_host --bench [iterations]
+ *
+ * Built and run by scripts/host_checks.sh. */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "control_math.h"
+#include "throttle_lut.h"
+
+/* Firmware constants the stages are called with (HAL.h, slot_ESC.h) */
+#define HOST_THROTTLE_NORMALIZED     256
+#define HOST_THROTTLE_DEADBAND_NORM  ((3 * HOST_THROTTLE_NORMALIZED) / 100)
+#define HOST_SENSI_SCALE             2
+#define HOST_ANTISPIN_MAX_VALUE      999
+#define HOST_ESC_PERIOD_US           500U
+
+/* Host side of active_tuning.h: throttleLutService() publishes from it, lookups key on it */
+ActiveTuning_type g_hostTuning;
+ESC_type g_escVar;
+
+void activeTuningGetPublished(ActiveTuning_type* out) {
+  *out = g_hostTuning;
+}
+
+const ActiveTuning_type* activeTuningTick() {
+  return &g_hostTuning;
+}
+
+static_assert(HOST_THROTTLE_NORMALIZED == THROTTLE_NORMALIZED, "host mirror of HAL.h out of step");
+
+/* Allowed |controlMathAtan2Deg10() - 10 * atan2()| [0.1 deg]: truncation to 0.1 deg plus table error */
+#define HOST_ATAN_MAX_ERR_DEG10      1.1
+
+typedef struct {
+  const char* name;
+  TriggerFilterParams_type params;
+} HostFilterProfile_type;
+
+/* TRIGGER_FILTER_DEF_* per sensor family; max and speed cutoffs are shared */
+static const HostFilterProfile_type HOST_FILTER_PROFILES[] = {
+  {"as5600",  {50, 3000, 150,  200}},
+  {"mt6701",  {80, 3000, 1500, 200}},
+  {"analog",  {30, 3000, 30,   200}},
+  {"tle493d", {40, 3000, 200,  200}},
+};
+
+/* FNV-1a over the 16-bit outputs of one case */
+typedef struct {
+  uint32_t hash;
+  uint32_t count;
+  uint32_t last;
+} HostDigest_type;
+
+static void hostDigestBegin(HostDigest_type* d) {
+  d->hash = 2166136261UL;
+  d->count = 0;
+  d->last = 0;
+}
+
+static void hostDigestAdd(HostDigest_type* d, uint32_t value) {
+  d->hash = (d->hash ^ (value & 0xFFU)) * 16777619UL;
+  d->hash = (d->hash ^ ((value >> 8) & 0xFFU)) * 16777619UL;
+  d->count++;
+  d->last = value;
+}
+
+/* Deterministic noise for the traces */
+static uint32_t g_hostLcg = 1;
+
+static int32_t hostNoise(int32_t amplitude) {
+  g_hostLcg = g_hostLcg * 1664525UL + 1013904223UL;
+  return (amplitude > 0) ? (int32_t)((g_hostLcg >> 8) % (uint32_t)(2 * amplitude + 1)) - amplitude : 0;
+}
+
+/* Requested permille over 4000 ticks: press, hold, feather, release, stab, partial lift */
+static uint16_t hostRequestTrace(uint32_t tick, uint16_t maxPermille) {
+  uint32_t phase = tick % 4000U;
+  uint32_t value;
+  if (phase < 200U) value = 0;
+  else if (phase < 1200U) value = maxPermille;
+  else if (phase < 2000U) value = (maxPermille * (400U + ((phase - 1200U) % 200U) * 3U)) / 1000U;
+  else if (phase < 2400U) value = 0;
+  else if (phase < 2600U) value = (maxPermille * (phase - 2400U)) / 200U;
+  else if (phase < 3200U) value = maxPermille / 2U;
+  else value = maxPermille;
+  return (uint16_t)((value > 1000U) ? 1000U : value);
+}
+
+/* Raw trigger reading trace around a calibrated span: rest, snap press, slow squeeze, release */
+static int16_t hostRawTrace(uint32_t tick, int16_t minRaw, int16_t maxRaw, int32_t noise) {
+  int32_t span = maxRaw - minRaw;
+  uint32_t phase = tick % 3000U;
+  int32_t pos;
+  if (phase < 300U) pos = 0;
+  else if (phase < 320U) pos = (span * (int32_t)(phase - 300U)) / 20;
+  else if (phase < 1000U) pos = span;
+  else if (phase < 2000U) pos = (span * (int32_t)(phase - 1000U)) / 1000;
+  else if (phase < 2010U) pos = span - (span * (int32_t)(phase - 2000U)) / 10;
+  else pos = 0;
+  return (int16_t)(minRaw + pos + hostNoise(noise));
+}
+
+static void hostSetTuning(uint16_t sensiRaw, uint16_t maxSpeed, uint16_t fade, uint16_t vertexInput,
+                          uint16_t vertexSpeedDiff, const ThrottleCurveShape_type* shape) {
+  memset(&g_hostTuning, 0, sizeof(g_hostTuning));
+  g_hostTuning.effectiveSensi_raw = sensiRaw;
+  g_hostTuning.maxSpeed = maxSpeed;
+  g_hostTuning.fade = fade;
+  g_hostTuning.vertexInput = vertexInput;
+  g_hostTuning.vertexSpeedDiff = vertexSpeedDiff;
+  g_hostTuning.curveShape = *shape;
+}
+
+/* Build the table for g_hostTuning and digest every entry; false if it disagrees with the direct curve */
+static bool hostDigestThrottleTable(HostDigest_type* d) {
+  ThrottleLutStats_type before, after;
+  throttleLutGetStats(&before);
+  bool built = throttleLutService();
+  ThrottleLutKey_type key;
+  throttleLutKeyFromTuning(&g_hostTuning, &key);
+  bool ok = built;
+  uint16_t prev = 0;
+  hostDigestBegin(d);
+  for (uint32_t i = 0; i < THROTTLE_LUT_ENTRIES; i++) {
+    uint16_t entry = throttleLutLookup((uint16_t)i);
+    ok = ok && entry == throttleCurveEvaluate(&key, (uint16_t)i) && entry <= 1000U;
+    ok = ok && entry >= prev;
+    prev = entry;
+    hostDigestAdd(d, entry);
+  }
+  throttleLutGetStats(&after);
+  return ok && after.fallbacks == before.fallbacks;  /* Every lookup was served by the new table */
+}
+
+static bool hostRunGolden(std::map<std::string, HostDigest_type>* out) {
+  char name[96];
+  HostDigest_type d;
+
+  /* Normalize and clamp: full 12-bit sweep over normal, reversed, narrow and degenerate spans */
+  static const struct { uint16_t minIn, maxIn; bool reversed; } CAL[] = {
+    {200, 3800, false}, {200, 3800, true}, {1000, 1200, false}, {0, 4095, true}, {500, 500, false}, {3000, 3001, false},
+  };
+  for (const auto& c : CAL) {
+    hostDigestBegin(&d);
+    for (uint32_t raw = 0; raw <= 4095U; raw++) {
+      hostDigestAdd(&d, controlMathNormalizeAndClamp((uint16_t)raw, c.minIn, c.maxIn, HOST_THROTTLE_NORMALIZED, c.reversed));
+    }
+    snprintf(name, sizeof(name), "normalize min=%u max=%u rev=%u", c.minIn, c.maxIn, c.reversed ? 1U : 0U);
+    (*out)[name] = d;
+  }
+
+  /* Deadband over the normalized range */
+  static const uint16_t DEADBAND[] = {0, HOST_THROTTLE_DEADBAND_NORM, 20};
+  for (uint16_t deadBand : DEADBAND) {
+    hostDigestBegin(&d);
+    for (uint32_t v = 0; v <= HOST_THROTTLE_NORMALIZED; v++) {
+      hostDigestAdd(&d, controlMathAddDeadBand((uint16_t)v, 0, HOST_THROTTLE_NORMALIZED, deadBand));
+    }
+    snprintf(name, sizeof(name), "deadband db=%u", deadBand);
+    (*out)[name] = d;
+  }
+
+  /* Anti-spin ramp: antiSpin x SENSI x maxSpeed, 12000 control ticks of a driving trace */
+  static const uint16_t ANTISPIN[] = {0, 1, 20, 50, 100, 200, 500, 999};
+  static const uint16_t SENSI[] = {0, 20, 60, 120, 180};
+  static const uint16_t MAXSPEED[] = {20, 50, 80, 100};
+  for (uint16_t antiSpin : ANTISPIN) {
+    for (uint16_t sensi : SENSI) {
+      for (uint16_t maxSpeed : MAXSPEED) {
+        AntiSpinRamp_type ramp = {0, 0};
+        AntiSpinRampParams_type params = {antiSpin, HOST_ANTISPIN_MAX_VALUE, sensi, HOST_SENSI_SCALE, maxSpeed};
+        hostDigestBegin(&d);
+        uint32_t now_us = 0;
+        for (uint32_t tick = 0; tick < 12000U; tick++) {
+          now_us += HOST_ESC_PERIOD_US + (uint32_t)(tick % 7U == 0U ? 37U : 0U);  /* Occasional late tick */
+          hostDigestAdd(&d, controlMathAntiSpinRamp(&ramp, hostRequestTrace(tick, (uint16_t)(maxSpeed * 10U)), &params, now_us));
+        }
+        snprintf(name, sizeof(name), "antispin as=%u sensi=%u max=%u", antiSpin, sensi, maxSpeed);
+        (*out)[name] = d;
+      }
+    }
+  }
+
+  /* Adaptive trigger filter: every sensor profile against clean, noisy and jittered traces */
+  static const struct { const char* name; int16_t minRaw, maxRaw; int32_t noise; uint32_t jitter_us; } TRACE[] = {
+    {"clean", 300, 3700, 0, 0}, {"noisy", 300, 3700, 12, 0}, {"jitter", 300, 3700, 4, 180}, {"narrow", 1800, 2100, 2, 0},
+  };
+  for (const auto& p : HOST_FILTER_PROFILES) {
+    for (const auto& t : TRACE) {
+      TriggerFilter_type state;
+      memset(&state, 0, sizeof(state));
+      controlMathTriggerFilterReset(&state);
+      hostDigestBegin(&d);
+      g_hostLcg = 1;
+      uint32_t now_us = 1000;
+      for (uint32_t tick = 0; tick < 9000U; tick++) {
+        now_us += HOST_ESC_PERIOD_US + ((t.jitter_us > 0) ? (uint32_t)(hostNoise((int32_t)t.jitter_us) + (int32_t)t.jitter_us) : 0U);
+        int16_t filtered = controlMathTriggerFilter(&state, hostRawTrace(tick, t.minRaw, t.maxRaw, t.noise), now_us, &p.params);
+        hostDigestAdd(&d, (uint16_t)filtered);
+        if (tick % 500U == 499U) {
+          hostDigestAdd(&d, (uint16_t)controlMathTriggerFilterLagUs(&state));
+        }
+      }
+      snprintf(name, sizeof(name), "filter %s %s", p.name, t.name);
+      (*out)[name] = d;
+    }
+  }
+
+  /* Throttle table: SENSI x LIMIT x FADE x (vertex curves, multi-point curves); pairs the car
+   * settings reject (LIMIT below SENSI + 5%) are skipped */
+  static const uint16_t LUT_SENSI[] = {0, 41, 120, 180};  /* [0.5%] 41 = odd half-percent step */
+  static const uint16_t LUT_MAXSPEED[] = {20, 65, 100};
+  static const uint16_t LUT_FADE[] = {0, 12, 45};         /* 45 is clamped to FADE_MAX_VALUE */
+  static const struct { uint16_t input, speedDiff; } LUT_VERTEX[] = {
+    {HOST_THROTTLE_NORMALIZED / 2, 50}, {40, 10}, {220, 90},
+  };
+  static const struct { const char* name; ThrottleCurveShape_type shape; } LUT_SHAPE[] = {
+    {"linear3", {THROTTLE_CURVE_MODE_LINEAR, 3, {{25, 10}, {50, 40}, {75, 85}}}},
+    {"spline3", {THROTTLE_CURVE_MODE_SPLINE, 3, {{25, 10}, {50, 40}, {75, 85}}}},
+    {"spline1", {THROTTLE_CURVE_MODE_SPLINE, 1, {{30, 70}}}},
+    {"spline6", {THROTTLE_CURVE_MODE_SPLINE, 6, {{5, 0}, {15, 30}, {20, 30}, {60, 35}, {90, 95}, {99, 100}}}},
+  };
+  bool lutOk = true;
+  for (uint16_t sensi : LUT_SENSI) {
+    for (uint16_t maxSpeed : LUT_MAXSPEED) {
+      if (maxSpeed < (sensi + HOST_SENSI_SCALE - 1U) / HOST_SENSI_SCALE + 5U) {
+        continue;
+      }
+      for (uint16_t fade : LUT_FADE) {
+        ThrottleCurveShape_type vertexShape;
+        memset(&vertexShape, 0, sizeof(vertexShape));
+        for (const auto& v : LUT_VERTEX) {
+          hostSetTuning(sensi, maxSpeed, fade, v.input, v.speedDiff, &vertexShape);
+          snprintf(name, sizeof(name), "lut sensi=%u max=%u fade=%u vertex=%u:%u", sensi, maxSpeed, fade, v.input,
+                   v.speedDiff);
+          if (!hostDigestThrottleTable(&d)) {
+            printf("FAILED   %s\n", name);
+            lutOk = false;
+          }
+          (*out)[name] = d;
+        }
+        for (const auto& s : LUT_SHAPE) {
+          hostSetTuning(sensi, maxSpeed, fade, HOST_THROTTLE_NORMALIZED / 2, 50, &s.shape);
+          snprintf(name, sizeof(name), "lut sensi=%u max=%u fade=%u %s", sensi, maxSpeed, fade, s.name);
+          if (!hostDigestThrottleTable(&d)) {
+            printf("FAILED   %s\n", name);
+            lutOk = false;
+          }
+          (*out)[name] = d;
+        }
+      }
+    }
+  }
+  return lutOk;
+}
+
+/* Largest error over a square grid of field vectors [-range, range) in steps of stride */
+static double hostAtan2MaxErr(int32_t range, int32_t stride, int32_t* worstY, int32_t* worstX) {
+  double maxErr = 0.0;
+  for (int32_t y = -range; y < range; y += stride) {
+    for (int32_t x = -range; x < range; x += stride) {
+      if (x == 0 && y == 0) {
+        continue;
+      }
+      double ref = atan2((double)y, (double)x) * (1800.0 / M_PI);
+      if (ref < 0.0) ref += 3600.0;
+      double err = fabs((double)controlMathAtan2Deg10(y, x) - ref);
+      if (err > 1800.0) err = 3600.0 - err;   /* Either side of 0 deg */
+      if (err > maxErr) {
+        maxErr = err;
+        *worstY = y;
+        *worstX = x;
+      }
+    }
+  }
+  return maxErr;
+}
+
+static bool hostCheckAtan2() {
+  /* Every vector of the W2B6 (12-bit signed) and P3B6 (14-bit signed) field ranges */
+  static const struct { const char* name; int32_t range, stride; } SWEEP[] = {
+    {"12-bit", 2048, 1}, {"14-bit", 8192, 1},
+  };
+  bool ok = true;
+  for (const auto& s : SWEEP) {
+    int32_t worstY = 0, worstX = 0;
+    double maxErr = hostAtan2MaxErr(s.range, s.stride, &worstY, &worstX);
+    bool pass = maxErr <= HOST_ATAN_MAX_ERR_DEG10;
+    printf("%s atan2 %-10s max error %.3f x0.1 deg at (y=%ld, x=%ld)\n", pass ? "OK      " : "FAILED  ", s.name,
+           maxErr, (long)worstY, (long)worstX);
+    ok = ok && pass;
+  }
+  return ok;
+}
+
+static bool hostWriteGolden(const char* path, const std::map<std::string, HostDigest_type>& cases) {
+  FILE* f = fopen(path, "w");
+  if (f == nullptr) {
+    fprintf(stderr, "cannot write %s\n", path);
+    return false;
+  }
+  fprintf(f, "# control_math.h / throttle_lut.cpp golden vectors: <hash> <outputs> <last output> <case>\n");
+  fprintf(f, "# Regenerate with control_math_host --update only for an intended behaviour change.\n");
+  for (const auto& c : cases) {
+    fprintf(f, "%08lx %lu %lu %s\n", (unsigned long)c.second.hash, (unsigned long)c.second.count,
+            (unsigned long)c.second.last, c.first.c_str());
+  }
+  fclose(f);
+  printf("wrote %u cases to %s\n", (unsigned)cases.size(), path);
+  return true;
+}
+
+static bool hostCheckGolden(const char* path, const std::map<std::string, HostDigest_type>& cases) {
+  FILE* f = fopen(path, "r");
+  if (f == nullptr) {
+    fprintf(stderr, "cannot read %s\n", path);
+    return false;
+  }
+  std::map<std::string, HostDigest_type> golden;
+  char line[256];
+  while (fgets(line, sizeof(line), f) != nullptr) {
+    if (line[0] == '#' || line[0] == '\n') {
+      continue;
+    }
+    unsigned long hash, count, last;
+    int used = 0;
+    if (sscanf(line, "%lx %lu %lu %n", &hash, &count, &last, &used) != 3) {
+      continue;
+    }
+    std::string name(line + used);
+    while (!name.empty() && (name.back() == '\n' || name.back() == '\r')) name.pop_back();
+    golden[name] = {(uint32_t)hash, (uint32_t)count, (uint32_t)last};
+  }
+  fclose(f);
+
+  unsigned failures = 0;
+  for (const auto& c : cases) {
+    auto it = golden.find(c.first);
+    if (it == golden.end()) {
+      printf("MISSING  %s\n", c.first.c_str());
+      failures++;
+    } else if (it->second.hash != c.second.hash || it->second.count != c.second.count) {
+      printf("CHANGED  %s (last output %lu, golden %lu)\n", c.first.c_str(),
+             (unsigned long)c.second.last, (unsigned long)it->second.last);
+      failures++;
+    }
+  }
+  for (const auto& g : golden) {
+    if (cases.find(g.first) == cases.end()) {
+      printf("STALE    %s\n", g.first.c_str());
+      failures++;
+    }
+  }
+  printf("%u cases, %u failed\n", (unsigned)cases.size(), failures);
+  return failures == 0;
+}
+
+/* Keeps the optimizer from dropping the benchmarked calls */
+static volatile uint32_t g_hostSink;
+
+template <typename Fn>
+static double hostTimeNs(uint32_t iterations, Fn fn) {
+  auto start = std::chrono::steady_clock::now();
+  uint32_t acc = 0;
+  for (uint32_t i = 0; i < iterations; i++) {
+    acc += fn(i);
+  }
+  auto end = std::chrono::steady_clock::now();
+  g_hostSink = acc;
+  return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+static void hostRunBench(uint32_t iterations) {
+  const TriggerFilterParams_type& filterParams = HOST_FILTER_PROFILES[3].params;
+  AntiSpinRampParams_type antiParams = {100, HOST_ANTISPIN_MAX_VALUE, 40, HOST_SENSI_SCALE, 100};
+  std::vector<int16_t> raw(4096);
+  g_hostLcg = 1;
+  for (uint32_t i = 0; i < raw.size(); i++) {
+    raw[i] = hostRawTrace(i * 3U, 300, 3700, 8);
+  }
+
+  printf("%-12s %10s\n", "stage", "ns/call");
+  printf("%-12s %10.2f\n", "normalize", hostTimeNs(iterations, [&](uint32_t i) {
+    return (uint32_t)controlMathNormalizeAndClamp((uint16_t)raw[i & 4095U], 300, 3700, HOST_THROTTLE_NORMALIZED, false);
+  }));
+  printf("%-12s %10.2f\n", "deadband", hostTimeNs(iterations, [&](uint32_t i) {
+    return (uint32_t)controlMathAddDeadBand((uint16_t)(i % (HOST_THROTTLE_NORMALIZED + 1U)), 0, HOST_THROTTLE_NORMALIZED,
+                                            HOST_THROTTLE_DEADBAND_NORM);
+  }));
+  TriggerFilter_type filter;
+  memset(&filter, 0, sizeof(filter));
+  printf("%-12s %10.2f\n", "filter", hostTimeNs(iterations, [&](uint32_t i) {
+    return (uint32_t)(uint16_t)controlMathTriggerFilter(&filter, raw[i & 4095U], i * HOST_ESC_PERIOD_US, &filterParams);
+  }));
+  AntiSpinRamp_type ramp = {0, 0};
+  printf("%-12s %10.2f\n", "antispin", hostTimeNs(iterations, [&](uint32_t i) {
+    return (uint32_t)controlMathAntiSpinRamp(&ramp, hostRequestTrace(i, 1000), &antiParams, i * HOST_ESC_PERIOD_US);
+  }));
+
+  /* Throttle curve: the table lookup the control loop runs, and the direct spline it falls back to */
+  ThrottleCurveShape_type spline = {THROTTLE_CURVE_MODE_SPLINE, 3, {{25, 10}, {50, 40}, {75, 85}}};
+  hostSetTuning(40, 100, 12, HOST_THROTTLE_NORMALIZED / 2, 50, &spline);
+  throttleLutService();
+  ThrottleLutKey_type splineKey;
+  throttleLutKeyFromTuning(&g_hostTuning, &splineKey);
+  printf("%-12s %10.2f\n", "lut", hostTimeNs(iterations, [&](uint32_t i) {
+    return (uint32_t)throttleLutLookup((uint16_t)(i % THROTTLE_LUT_ENTRIES));
+  }));
+  printf("%-12s %10.2f\n", "spline", hostTimeNs(iterations, [&](uint32_t i) {
+    return (uint32_t)throttleCurveEvaluate(&splineKey, (uint16_t)(i % THROTTLE_LUT_ENTRIES));
+  }));
+
+  /* One control tick: filter -> normalize -> deadband -> curve table -> anti-spin */
+  TriggerFilter_type tickFilter;
+  memset(&tickFilter, 0, sizeof(tickFilter));
+  AntiSpinRamp_type tickRamp = {0, 0};
+  printf("%-12s %10.2f\n", "tick", hostTimeNs(iterations, [&](uint32_t i) {
+    uint32_t now_us = i * HOST_ESC_PERIOD_US;
+    int16_t filtered = controlMathTriggerFilter(&tickFilter, raw[i & 4095U], now_us, &filterParams);
+    uint16_t norm = controlMathNormalizeAndClamp((uint16_t)filtered, 300, 3700, HOST_THROTTLE_NORMALIZED, false);
+    norm = controlMathAddDeadBand(norm, 0, HOST_THROTTLE_NORMALIZED, HOST_THROTTLE_DEADBAND_NORM);
+    uint16_t requested = throttleLutLookup(norm);
+    return (uint32_t)controlMathAntiSpinRamp(&tickRamp, requested, &antiParams, now_us);
+  }));
+  printf("(host CPU figures: compare runs on the same machine, not with the ESP32)\n");
+}
+
+static void hostUsage(const char* argv0) {
+  fprintf(stderr, "usage: %s --check FILE | --update FILE | --bench [iterations]\n", argv0);
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    hostUsage(argv[0]);
+    return 2;
+  }
+  if (strcmp(argv[1], "--bench") == 0) {
+    uint32_t iterations = (argc > 2) ? (uint32_t)strtoul(argv[2], nullptr, 10) : 5000000UL;
+    hostRunBench(iterations > 0 ? iterations : 1U);
+    return 0;
+  }
+  if (argc < 3 || (strcmp(argv[1], "--check") != 0 && strcmp(argv[1], "--update") != 0)) {
+    hostUsage(argv[0]);
+    return 2;
+  }
+  std::map<std::string, HostDigest_type> cases;
+  bool lutOk = hostRunGolden(&cases);
+  if (strcmp(argv[1], "--update") == 0) {
+    return (lutOk && hostWriteGolden(argv[2], cases)) ? 0 : 1;  /* Never record a broken table */
+  }
+  bool atanOk = hostCheckAtan2();
+  return (hostCheckGolden(argv[2], cases) && atanOk && lutOk) ? 0 : 1;
+}
@@ -0,0 +1,23 @@
+/* Host stand-in for the Arduino core: only what the host-built firmware sources use.
+ * min/max/constrain/map follow arduino-esp32 (map() returns -1 on an empty input range). */
+#ifndef HOST_ARDUINO_H_
+#define HOST_ARDUINO_H_
+
+#include <stdint.h>
+#include <algorithm>
+#include <cmath>
+
+using std::max;
+using std::min;
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+static inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  const long run = in_max - in_min;
+  if (run == 0) {
+    return -1;
+  }
+  return ((x - in_min) * (out_max - out_min)) / run + out_min;
+}
+
+#endif  /* HOST_ARDUINO_H_ */
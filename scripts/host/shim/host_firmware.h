@@ -0,0 +1,93 @@
+/* Thin HAL shim for host builds of firmware sources that only need constants and plain types.
+ * Force-included (g++ -include) ahead of the source: it claims the HAL.h, slot_ESC.h and
+ * active_tuning.h include guards, so the real headers (Wire, OneBitDisplay, FreeRTOS ...)
+ * are skipped and the declarations below stand in for them.
+ * Every definition mirrors the firmware header named next to it; keep them in step. */
+#ifndef HOST_FIRMWARE_H_
+#define HOST_FIRMWARE_H_
+
+#define HAL_H_
+#define SLOT_ESC_H_
+#define ACTIVE_TUNING_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* HAL.h */
+#define THROTTLE_NORMALIZED         256
+
+/* slot_ESC.h */
+#define SENSI_SCALE                 2
+#define THROTTLE_CURVE_POINTS_MAX   6
+#define THROTTLE_CURVE_MODE_VERTEX  0
+#define THROTTLE_CURVE_MODE_LINEAR  1
+#define THROTTLE_CURVE_MODE_SPLINE  2
+#define FADE_MAX_VALUE              30
+
+typedef struct {
+  uint16_t inputThrottle;
+  uint16_t curveSpeedDiff;
+} ThrottleCurveVertex_type;
+
+typedef struct {
+  uint8_t input_pct;
+  uint8_t output_pct;
+} ThrottleCurvePoint_type;
+
+typedef struct {
+  uint8_t mode;
+  uint8_t count;
+  ThrottleCurvePoint_type points[THROTTLE_CURVE_POINTS_MAX];
+} ThrottleCurveShape_type;
+
+/* CarParam_type: the curve fields only */
+typedef struct {
+  uint16_t minSpeed;
+  uint16_t maxSpeed;
+  ThrottleCurveVertex_type throttleCurveVertex;
+  uint16_t fade;
+  ThrottleCurveShape_type throttleCurveShape;
+} CarParam_type;
+
+/* ESC_type: the fields host-built sources read */
+typedef struct {
+  uint16_t effectiveSensi_raw;
+} ESC_type;
+
+static inline uint16_t fadePctToThrottleNorm(uint16_t fadePct) {
+  if (fadePct >= 100U) {
+    return THROTTLE_NORMALIZED;
+  }
+  return (uint16_t)(((uint32_t)fadePct * (uint32_t)THROTTLE_NORMALIZED) / 100U);
+}
+
+static inline uint16_t curveVertexInputWithFade(uint16_t fadeThrottleNorm, uint16_t baseCurveInputNorm) {
+  if (fadeThrottleNorm >= THROTTLE_NORMALIZED) {
+    return THROTTLE_NORMALIZED;
+  }
+  return (uint16_t)(fadeThrottleNorm +
+                    (((uint32_t)(THROTTLE_NORMALIZED - fadeThrottleNorm) * (uint32_t)baseCurveInputNorm) /
+                     (uint32_t)THROTTLE_NORMALIZED));
+}
+
+static inline bool throttleCurveShapeActive(const ThrottleCurveShape_type* shape) {
+  return shape->mode != THROTTLE_CURVE_MODE_VERTEX && shape->count > 0;
+}
+
+/* active_tuning.h: the curve fields only */
+typedef struct {
+  bool extPotSensi;
+  uint16_t maxSpeed;
+  uint16_t fade;
+  uint16_t vertexInput;
+  uint16_t vertexSpeedDiff;
+  ThrottleCurveShape_type curveShape;
+  uint16_t effectiveSensi_raw;
+} ActiveTuning_type;
+
+/* Host side of the active tuning: both the published copy and the control-task snapshot */
+extern ActiveTuning_type g_hostTuning;
+void activeTuningGetPublished(ActiveTuning_type* out);
+const ActiveTuning_type* activeTuningTick();
+
+#endif  /* HOST_FIRMWARE_H_ */
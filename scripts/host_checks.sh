@@ -0,0 +1,69 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+ROOT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+SRC_DIR="$ROOT_DIR/source/ESPEED32"
+HOST_DIR="$ROOT_DIR/scripts/host"
+BUILD_DIR="${HOST_BUILD_DIR:-$ROOT_DIR/_host_build}"
+CXX="${CXX:-g++}"
+
+BENCH=0
+UPDATE=0
+ITERATIONS=""
+
+usage() {
+  cat <<USAGE
+Usage: $(basename "$0") [--bench [ITERATIONS]] [--update]
+
+Builds the firmware's host-portable math (control_math.h) and the throttle table
+builder (throttle_lut.cpp, against the HAL shim in scripts/host/shim) natively, checks
+them against the golden vectors in scripts/host/control_math_golden.txt, and sweeps the
+TLE493D atan2 over the full 12-bit and 14-bit field ranges.
+
+Options:
+  --bench [N]   Also report ns per call of each control stage (default 5000000 calls)
+  --update      Rewrite the golden vectors (only for an intended behaviour change)
+  -h, --help    Show this help
+USAGE
+}
+
+while [[ $# -gt 0 ]]; do
+  case "$1" in
+    --bench)
+      BENCH=1
+      if [[ $# -ge 2 && "$2" =~ ^[0-9]+$ ]]; then
+        ITERATIONS="$2"
+        shift
+      fi
+      shift
+      ;;
+    --update)
+      UPDATE=1
+      shift
+      ;;
+    -h|--help)
+      usage
+      exit 0
+      ;;
+    *)
+      echo "Unknown argument: $1" >&2
+      usage
+      exit 1
+      ;;
+  esac
+done
+
+mkdir -p "$BUILD_DIR"
+# The shim comes first and is force-included, so firmware sources see it instead of HAL.h
+"$CXX" -std=c++17 -O2 -Wall -Wextra -I"$HOST_DIR/shim" -I"$SRC_DIR" -include host_firmware.h \
+  "$HOST_DIR/control_math_host.cpp" "$SRC_DIR/throttle_lut.cpp" -o "$BUILD_DIR/control_math_host"
+
+if [[ "$UPDATE" -eq 1 ]]; then
+  "$BUILD_DIR/control_math_host" --update "$HOST_DIR/control_math_golden.txt"
+else
+  "$BUILD_DIR/control_math_host" --check "$HOST_DIR/control_math_golden.txt"
+fi
+
+if [[ "$BENCH" -eq 1 ]]; then
+  "$BUILD_DIR/control_math_host" --bench ${ITERATIONS}
+fi
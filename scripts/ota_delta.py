@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""Build (and optionally upload) a block-delta firmware image for /ota-fw.
+
+The delta describes the new app image block by block against the image the
+controller is running now: unchanged blocks are copied on the device from its
+running partition, 0xFF/0x00 runs are filled, and only the rest is sent. The
+record format is documented in source/ESPEED32/ota_pipeline.h.
+
+The controller verifies the SHA-256 of the rebuilt image before accepting it,
+so a wrong --base results in a rejected upload, never in a bad image.
+"""
+
+from __future__ import annotations
+
+import argparse
+import base64
+import hashlib
+import struct
+import sys
+import urllib.request
+import uuid
+from pathlib import Path
+
+
+MAGIC = b"E32D"
+VERSION = 1
+BLOCK_SHIFT = 12
+BLOCK_SIZE = 1 << BLOCK_SHIFT
+
+OP_LITERAL = 0x00
+OP_COPY = 0x01
+OP_FILL = 0x02
+
+
+def parse_args() -> argparse.Namespace:
+    parser = argparse.ArgumentParser(description="Build an ESPEED32 delta OTA image.")
+    parser.add_argument("--base", type=Path, required=True, help="Firmware .bin currently on the controller.")
+    parser.add_argument("--target", type=Path, required=True, help="New firmware .bin.")
+    parser.add_argument("--out", type=Path, help="Write the delta file here.")
+    parser.add_argument("--upload", metavar="URL", help="POST the delta, e.g. http://192.168.4.1/ota-fw")
+    parser.add_argument("--user", default="espeed32", help="Controller UI user name.")
+    parser.add_argument("--password", default="espeed32", help="Controller UI password.")
+    parser.add_argument("--no-restart", action="store_true", help="Ask the controller to defer its restart.")
+    return parser.parse_args()
+
+
+def build_delta(base: bytes, target: bytes) -> tuple[bytes, dict[str, int]]:
+    digest = hashlib.sha256(target).digest()
+    out = bytearray(MAGIC)
+    out += struct.pack("<BBHI", VERSION, BLOCK_SHIFT, 0, len(target))
+    out += digest
+
+    counts = {"literal": 0, "copy": 0, "fill": 0}
+    for offset in range(0, len(target), BLOCK_SIZE):
+        block = target[offset:offset + BLOCK_SIZE]
+        if base[offset:offset + len(block)] == block:
+            out.append(OP_COPY)
+            counts["copy"] += 1
+        elif block == bytes([block[0]]) * len(block):
+            out += bytes([OP_FILL, block[0]])
+            counts["fill"] += 1
+        else:
+            out.append(OP_LITERAL)
+            out += block
+            counts["literal"] += 1
+    return bytes(out), counts
+
+
+def upload(url: str, payload: bytes, image_sha: str, user: str, password: str, restart: bool) -> int:
+    boundary = uuid.uuid4().hex
+    body = (
+        f"--{boundary}\r\n"
+        'Content-Disposition: form-data; name="file"; filename="delta.bin"\r\n'
+        "Content-Type: application/octet-stream\r\n\r\n"
+    ).encode() + payload + f"\r\n--{boundary}--\r\n".encode()
+    if not restart:
+        url += ("&" if "?" in url else "?") + "restart=0"
+    request = urllib.request.Request(url, data=body, method="POST")
+    request.add_header("Content-Type", f"multipart/form-data; boundary={boundary}")
+    request.add_header("X-Binary-SHA256", image_sha)
+    token = base64.b64encode(f"{user}:{password}".encode()).decode()
+    request.add_header("Authorization", f"Basic {token}")
+    try:
+        with urllib.request.urlopen(request, timeout=900) as response:
+            print(f"[OTA] {response.status} {response.read().decode(errors='replace').strip()}")
+            return 0
+    except urllib.error.HTTPError as exc:
+        print(f"[OTA] {exc.code} {exc.read().decode(errors='replace').strip()}", file=sys.stderr)
+        return 1
+
+
+def main() -> int:
+    args = parse_args()
+    base = args.base.read_bytes()
+    target = args.target.read_bytes()
+    delta, counts = build_delta(base, target)
+    print(f"[OTA] {len(target)} byte image -> {len(delta)} byte delta "
+          f"({counts['copy']} copied, {counts['fill']} filled, {counts['literal']} sent blocks)")
+
+    if args.out is not None:
+        args.out.write_bytes(delta)
+    if args.upload:
+        return upload(args.upload, delta, hashlib.sha256(target).hexdigest(),
+                      args.user, args.password, not args.no_restart)
+    if args.out is None:
+        print("[OTA] Nothing to do: pass --out and/or --upload", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
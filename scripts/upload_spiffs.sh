@@ -8,6 +8,8 @@ IMAGE_PATH="$BUILD_DIR/espeed32_spiffs.bin"
 ARDUINO_JSON="$ROOT_DIR/.vscode/arduino.json"
 DOCS_REFRESH_SCRIPT="$ROOT_DIR/scripts/refresh_generated_docs.sh"
 MANIFEST_SCRIPT="$ROOT_DIR/scripts/generate_spiffs_release_manifest.sh"
+ASSETS_SCRIPT="$ROOT_DIR/scripts/build_spiffs_assets.py"
+STAGE_DIR="$BUILD_DIR/spiffs_data"
 
 PARTITION_OFFSET="0x290000"
 PARTITION_SIZE="0x160000"
@@ -203,8 +205,15 @@ fi
 
 "$MANIFEST_SCRIPT"
 
-echo "[SPIFFS] Building image from $DATA_DIR"
-"$MKSPiffs_BIN" -c "$DATA_DIR" -b "$BLOCK_SIZE" -p "$PAGE_SIZE" -s "$PARTITION_SIZE" "$IMAGE_PATH"
+if [[ ! -f "$ASSETS_SCRIPT" ]]; then
+  echo "Missing asset staging script: $ASSETS_SCRIPT" >&2
+  exit 1
+fi
+
+python3 "$ASSETS_SCRIPT" --data "$DATA_DIR" --out "$STAGE_DIR"
+
+echo "[SPIFFS] Building image from $STAGE_DIR"
+"$MKSPiffs_BIN" -c "$STAGE_DIR" -b "$BLOCK_SIZE" -p "$PAGE_SIZE" -s "$PARTITION_SIZE" "$IMAGE_PATH"
 
 echo "[SPIFFS] Image ready: $IMAGE_PATH"
 
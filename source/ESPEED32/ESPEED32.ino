@@ -23,9 +23,27 @@
 #include "settings_about_screen.h"
 #include "menu_car.h"
 #include "ui_render.h"
+#include "oled_screen_cache.h"
 #include "task_control_loop.h"
 #include "ext_pot.h"
 #include "telemetry_logging.h"
+#include "throttle_lut.h"
+#include "active_tuning.h"
+#include "input_events.h"
+#include "settings_store.h"
+#include "car_profiles.h"
+#include "lap_engine.h"
+#include "race_link.h"
+#include "telemetry_session_log.h"
+#include "telemetry_pyramid.h"
+#include "telemetry_stream.h"
+#include "task_monitor.h"
+#include "buzzer.h"
+#include "scheduler_profile.h"
+#include "sleep_wake.h"
+#include "boot_timing.h"
+#include "control_math.h"
+#include "trigger_lut.h"
 
 /* Version defined in slot_ESC.h */
 
@@ -72,6 +90,8 @@ static uint16_t g_originalValueBeforeEdit = 0;        /* Store original value wh
 static bool g_isEditingCarSelection = false;          /* Flag to prevent g_carSel update during CAR edit */
 static bool g_antiSpinStepEditActive = false;         /* True while ANTIS uses stepped encoder editing */
 static uint16_t g_antiSpinEditLastEncoder = 0;        /* Raw encoder position used to detect ANTIS step changes */
+static uint8_t g_calibLinStep = 0;                    /* CALIBRATION: 0 = min/max sweep, N = capturing point N */
+static int16_t g_calibLinPoints[TRIGGER_LIN_POINTS];  /* CALIBRATION: readings captured so far */
 
 /* Stored Variables (EEPROM/Preferences) */
 StoredVar_type g_storedVar;
@@ -85,11 +105,14 @@ uint16_t g_adcVoltageRange_mV = ACD_VOLTAGE_RANGE_DEFAULT_MVOLTS; /* Global ADC
 /* ESC Runtime Variables */
 ESC_type g_escVar {
   .outputSpeed_pct = 0,
+  .outputSpeed_permille = 0,
   .trigger_raw = 0,
   .trigger_norm = 0,
   .encoderPos = 1,
   .Vin_mV = 0,
   .motorCurrent_mA = 0,
+  .chipTemp_C = INT16_MIN,
+  .thermalLimit_pct = 100,
   .effectiveBrake_pct = BRAKE_DEFAULT,
   .effectiveSensi_raw = MIN_SPEED_DEFAULT,
   .lapCount = 0,
@@ -141,8 +164,6 @@ void toggleSettingsLock() {
 /* Menu Navigation State */
 static bool g_inSettingsMenu = false;  /* Track if we're currently in the settings submenu */
 static bool g_escapeToMain = false;    /* Set by any submenu long press → cascade-breaks to RUNNING for race mode toggle */
-static bool g_raceToggleReleaseGuardActive = false;  /* Swallow release click after race-mode long press. */
-static uint32_t g_raceToggleReleaseAtMs = 0;  /* Release timestamp used to re-arm short presses after race toggle. */
 static uint16_t g_wifiTimedMinutes = 10;      /* Runtime-only default for timed WiFi activation */
 static bool g_wifiTimedActive = false;        /* True when background WiFi should auto-stop on deadline */
 static uint32_t g_wifiTimedStopAtMs = 0;      /* millis() deadline for auto-stop */
@@ -150,14 +171,6 @@ static uint16_t g_loggingTimedMinutes = 30;   /* Runtime-only default for timed
 static bool g_loggingTimedActive = false;     /* True when logging should auto-stop on deadline */
 static uint32_t g_loggingTimedStopAtMs = 0;   /* millis() deadline for telemetry logging stop */
 static const char* PREF_KEY_SENSI_HALF = "sensi_half_v1"; /* migration marker for 0.5% SENSI storage */
-static const char* PREF_KEY_STATS_ENABLED = "stats_en_v1"; /* persistent STATS visibility toggle */
-static const char* PREF_KEY_ANTIS_STEP = "antis_step_v1";  /* persistent ANTIS encoder step */
-static const char* PREF_KEY_ANTIS_STEP_PCT = "antis_pct_v1"; /* persistent ANTIS percent-step */
-static const char* PREF_KEY_ANTIS_MODE = "antis_mode_v1";  /* persistent ANTIS display/edit mode */
-static const char* PREF_KEY_ENC_INVERT = "enc_inv_v1";     /* persistent encoder inversion toggle */
-static const char* PREF_KEY_ADC_RANGE = "adc_rng_mv_v1";   /* persistent ADC voltage calibration */
-static const char* PREF_KEY_EXT_POT1_TARGET = "ext_pot1_tgt";
-static const char* PREF_KEY_EXT_POT2_TARGET = "ext_pot2_tgt";
 static const char* PREF_KEY_EXT_POT_ENABLED_LEGACY = "ext_pot_en";
 static const char* PREF_KEY_EXT_POT_TARGET_LEGACY = "ext_pot_tgt";
 static bool g_startWiFiAfterOtaBoot = false;
@@ -204,7 +217,7 @@ void applyEncoderInvertSetting(uint16_t enabled) {
 }
 
 static bool isAntiSpinEditTarget() {
-  return g_encoderSelectedValuePtr == &g_storedVar.carParam[g_carSel].antiSpin;
+  return g_encoderSelectedValuePtr == &g_storedVar.activeCar.antiSpin;
 }
 
 static void beginSteppedValueEdit() {
@@ -300,44 +313,12 @@ static void applyRaceModeToggle(MenuState_enum &menuState, uint32_t &lastLongPre
   g_encoderMainSelector = 1;
   g_escVar.encoderPos = 1;
   lastLongPressTime = millis();
-  g_raceToggleReleaseGuardActive = true;
-  g_raceToggleReleaseAtMs = 0;
+  inputEventsFlush();  /* Button still held: its release must not count as a click */
   saveEEPROM(g_storedVar);
   if (g_storedVar.soundRace) keySound();
   g_lastEncoderInteraction = millis();
 }
 
-/**
- * @brief Hold off short-press handling until the encoder button is released after a race-mode long press.
- * @details RUNNING uses raw press/release detection, so we only need to wait for a clean release
- *          plus a short debounce window before re-arming short clicks.
- * @param encoderButtonPressed Current raw encoder button state.
- * @return true while short presses should remain blocked.
- */
-static bool serviceRaceModeToggleReleaseGuard(bool encoderButtonPressed) {
-  if (!g_raceToggleReleaseGuardActive) {
-    return false;
-  }
-
-  if (encoderButtonPressed) {
-    g_raceToggleReleaseAtMs = 0;
-    return true;
-  }
-
-  if (g_raceToggleReleaseAtMs == 0) {
-    g_raceToggleReleaseAtMs = millis();
-    return true;
-  }
-
-  if ((uint32_t)(millis() - g_raceToggleReleaseAtMs) < BUTTON_DEBOUNCE_AFTER_LONG_MS) {
-    return true;
-  }
-
-  g_raceToggleReleaseGuardActive = false;
-  g_raceToggleReleaseAtMs = 0;
-  return false;
-}
-
 void requestEscapeToMain() {
   g_escapeToMain = true;
 }
@@ -489,16 +470,26 @@ void initDisplayMenuItems();
  * @brief Main setup function - initializes hardware and creates FreeRTOS tasks
  */
 void setup() {
+  bootTimingMark(BOOT_STAGE_SETUP);
+  sleepWakeBootBegin();  /* Before the pins are set up: releases them from the RTC after deep sleep */
+
   /* Pin and Serial Setup */
   HAL_PinSetup();
+  buzzerBegin();
 
   /* HalfBridge & Hardware Setup */
   HalfBridge_Setup();
+  bootTimingMark(BOOT_STAGE_HW);
 
   /* Mark this firmware as valid unconditionally so the ESP32 bootloader
    * does not roll back regardless of stored-var migration state. */
   esp_ota_mark_app_valid_cancel_rollback();
 
+  settingsStoreBegin();
+  lapEngineBegin();
+  raceLinkBegin();
+  telemetryLogBegin();
+
   /* Create FreeRTOS Tasks */
   /* Task 1: UI and state machine (low priority, core 0) */
   xTaskCreatePinnedToCore(
@@ -533,6 +524,7 @@ void setup() {
     1,            /* Priority 1 — same as Task1, time-sliced fairly */
     &WiFiTask,    /* Task handle */
     0);           /* Core 0 — same core as Task1, safe without mutex */
+  schedProfileBegin(WiFiTask);  /* RACE raises WiFiTask above Task1 during a heat */
 }
 
 void applyAdcVoltageRangeMilliVolts(uint16_t range_mV) {
@@ -551,6 +543,7 @@ void applyAdcVoltageRangeMilliVolts(uint16_t range_mV) {
  * @note Runs on Core 0 with lower priority
  */
 void Task1code(void *pvParameters) {
+  controlLoopDeadlineBegin();  /* Monitor interrupt on core 0, away from the loop it watches */
   for (;;) {
     StateMachine_enum prevState = g_currState;
     static uint16_t prevFreqPWM = 0;
@@ -560,31 +553,69 @@ void Task1code(void *pvParameters) {
     /* Read motor current (voltage is read exclusively in Task2 to avoid ADC contention) */
     g_escVar.motorCurrent_mA = HAL_ReadMotorCurrent();
     serviceTimedWiFiPortal();
+    telemetryServiceEvents((uint8_t)g_carSel, &g_storedVar.activeCar);
+    controlLoopServiceDeadlineEvents((uint8_t)g_carSel, &g_storedVar.activeCar);
 
     /* Update selected car if initialization complete */
     if (g_currState != INIT) {
       g_carSel = g_storedVar.selectedCarNumber;
+      carProfileSelect(g_carSel);  /* Page the profile in if the selection changed */
+      activeTuningService();  /* Hand menu/web edits of the selected car to the control task */
+    }
+    throttleLutService();     /* Rebuild the throttle table if curve params or SENSI changed */
+    if (g_currState != CALIBRATION) {
+      triggerLutService(g_storedVar.minTrigger_raw, g_storedVar.maxTrigger_raw);  /* Once per saved calibration */
     }
 
     /* Task 1 state machine */
     switch (g_currState) {
-      case INIT:
+      case INIT: {
+
+        /* Woken by a button from deep sleep: drive on the RTC copy of the settings while NVS loads */
+        bool fastWake = sleepWakeRestoreSettings(&g_storedVar);
+        if (fastWake) {
+          g_carSel = g_storedVar.selectedCarNumber;
+          activeTuningService();
+          throttleLutService();
+          bootTimingMark(BOOT_STAGE_SETTINGS);
+          g_currState = WELCOME;
+        }
 
         g_pref.begin("stored_var", false); /* Open the "stored" namespace in read/write mode. If it doesn't exist, it creates it */
 
-        if (g_pref.isKey("stored_var_ver") && g_pref.isKey("sw_maj_ver") && g_pref.isKey("sw_min_ver") && g_pref.isKey("user_param")) /* If all keys exists, then check their value */
+        if (g_pref.isKey("stored_var_ver") && g_pref.isKey("sw_maj_ver") && g_pref.isKey("sw_min_ver") && settingsStoreIsPresent(g_pref)) /* If all keys exists, then check their value */
         {
           /* Get the values of the sw version */
           swMajVer = g_pref.getUChar("sw_maj_ver");
           swMinVer = g_pref.getUChar("sw_min_ver");
           storedVarVersion = g_pref.getUChar("stored_var_ver");
 
-          if ((storedVarVersion == STORED_VAR_VERSION) ) /* If the storedVariable version keys is equal to the STORED_VAR MACRO, then the stored param are already initialized woh the proper format*/
+          bool settingsLoaded = false;
+          if (storedVarVersion == STORED_VAR_VERSION) /* If the storedVariable version keys is equal to the STORED_VAR MACRO, then the stored param are already initialized woh the proper format*/
+          {
+            if (fastWake) {
+              static StoredVar_type nvsVars;                                  /* Same content; primes the store's shadow only */
+              settingsLoaded = settingsStoreLoad(g_pref, &nvsVars);
+            } else {
+              settingsLoaded = settingsStoreLoad(g_pref, &g_storedVar);       /* Per-profile blobs, or the legacy user_param */
+            }
+            if (!settingsLoaded && fastWake) {
+              g_currState = INIT;   /* Stop driving on the RTC copy; the defaults below replace it */
+            }
+          }
+
+          if (settingsLoaded) /* Stored param read back in the proper format; otherwise fall back to the defaults below */
           {
-            g_pref.getBytes("user_param", &g_storedVar, sizeof(g_storedVar)); /* Get the value of the stored user_param */
             g_statsEnabled = g_pref.getUChar(PREF_KEY_STATS_ENABLED, STATS_ENABLED_DEFAULT) ? 1 : 0;
             g_encoderInvertEnabled = g_pref.getUChar(PREF_KEY_ENC_INVERT, ENCODER_INVERT_DEFAULT) ? 1 : 0;
             applyAdcVoltageRangeMilliVolts(g_pref.getUShort(PREF_KEY_ADC_RANGE, ACD_VOLTAGE_RANGE_DEFAULT_MVOLTS));
+            {
+              int16_t linPoints[TRIGGER_LIN_POINTS] = {0};
+              if (g_pref.getBytesLength(PREF_KEY_TRIGGER_LIN) == sizeof(linPoints)) {
+                g_pref.getBytes(PREF_KEY_TRIGGER_LIN, linPoints, sizeof(linPoints));
+              }
+              triggerLutSetPoints(linPoints);  /* A different TRIGGER_LIN_POINTS build reads as none */
+            }
             if (g_pref.isKey(PREF_KEY_EXT_POT1_TARGET) || g_pref.isKey(PREF_KEY_EXT_POT2_TARGET)) {
               g_extPotTarget[0] = constrain(g_pref.getUChar(PREF_KEY_EXT_POT1_TARGET, EXT_POT1_TARGET_DEFAULT),
                                             EXT_POT_TARGET_MIN, EXT_POT_TARGET_MAX);
@@ -608,13 +639,19 @@ void Task1code(void *pvParameters) {
             g_antiSpinDisplayMode = constrain(g_pref.getUChar(PREF_KEY_ANTIS_MODE, ANTISPIN_UI_MODE_DEFAULT),
                                               ANTISPIN_UI_MODE_MS, ANTISPIN_UI_MODE_TEXT);
 
-            /* One-time migration: old firmware stored SENSI in whole-percent units. */
+            /* One-time migration: old firmware stored SENSI in whole-percent units.
+               Profiles without a blob are defaults, already in half-percent units. */
             if (!g_pref.getBool(PREF_KEY_SENSI_HALF, false)) {
-              for (uint8_t i = 0; i < CAR_MAX_COUNT; i++) {
-                uint32_t migrated = (uint32_t)g_storedVar.carParam[i].minSpeed * SENSI_SCALE;
-                g_storedVar.carParam[i].minSpeed = (uint16_t)min((uint32_t)MIN_SPEED_MAX_VALUE, migrated);
+              for (uint16_t i = 0; i < CAR_MAX_COUNT; i++) {
+                CarParam_type car;
+                if (!carProfileRead(i, &car)) {
+                  continue;
+                }
+                uint32_t migrated = (uint32_t)car.minSpeed * SENSI_SCALE;
+                car.minSpeed = (uint16_t)min((uint32_t)MIN_SPEED_MAX_VALUE, migrated);
+                carProfileWrite(i, &car);
               }
-              g_pref.putBytes("user_param", &g_storedVar, sizeof(g_storedVar));
+              saveEEPROM(g_storedVar);
               g_pref.putBool(PREF_KEY_SENSI_HALF, true);
             }
             initMenuItems();                                                  /* init menu items with EEPROM stored variables */
@@ -636,7 +673,7 @@ void Task1code(void *pvParameters) {
             }
 
             /* If button is pressed at startup, go to CALIBRATION state */
-            if (digitalRead(ENCODER_BUTTON_PIN) == BUTTON_PRESSED)
+            if (!fastWake && digitalRead(ENCODER_BUTTON_PIN) == BUTTON_PRESSED)
             {
               g_currState = CALIBRATION;      /* Go to CALIBRATION state */
               /* Reset Min and Max to the opposite side, in order to have effective calibration */
@@ -655,7 +692,7 @@ void Task1code(void *pvParameters) {
               
               obdFill(&g_obd, OBD_WHITE, 1); /* Clear OLED */
             }
-            else if (digitalRead(BUTT_PIN) == BUTTON_PRESSED)
+            else if (!fastWake && digitalRead(BUTT_PIN) == BUTTON_PRESSED)
             {
               /* Hold brake button at startup → run self-test */
               g_currState = WELCOME;
@@ -665,9 +702,24 @@ void Task1code(void *pvParameters) {
             }
             else  /* If button is NOT pressed at startup, go to RUNNING state */
             {
-              g_currState = WELCOME;                    /* Go to WELCOME state */
-              g_carSel = g_storedVar.selectedCarNumber; /* now it is safe to address the proper car */
+              /* Fast boot: hand the car to Task2 and let it drive before any UI work */
+              if (!fastWake) {
+                g_carSel = g_storedVar.selectedCarNumber; /* now it is safe to address the proper car */
+                activeTuningService();
+                throttleLutService();
+                bootTimingMark(BOOT_STAGE_SETTINGS);
+                g_currState = WELCOME;                    /* Go to WELCOME state: Task2 drives from here */
+              }
+
               initDisplayAndEncoder();  /* init and clear OLED and Encoder */
+              bootTimingMark(BOOT_STAGE_UI);
+              if (fastWake) {
+                /* The wake press must not reach the menu */
+                while (digitalRead(ENCODER_BUTTON_PIN) == BUTTON_PRESSED) {
+                  vTaskDelay(10);
+                }
+                inputEventsFlush();
+              }
               if (g_startWiFiAfterOtaBoot) {
                 startTimedWiFiPortal(getWiFiTimedMinutes());
                 g_startWiFiAfterOtaBoot = false;
@@ -685,6 +737,7 @@ void Task1code(void *pvParameters) {
         /* If the code reaches here it means that:
         - the sw version keys are not present --> stored var are not initialized
         - the sw version stored are not up to date --> stored var are initialized but might be outdated
+        - the stored var could not be read back --> treated as not initialized
 
         Calibration values are NOT stored, go to CALIBRATION state */
         initDisplayAndEncoder();  /* init and clear OLED and Encoder */
@@ -716,6 +769,7 @@ void Task1code(void *pvParameters) {
         g_extPotTarget[0] = EXT_POT1_TARGET_DEFAULT;
         g_extPotTarget[1] = EXT_POT2_TARGET_DEFAULT;
         resetExtPotFilter();
+        triggerLutSetPoints(nullptr);
 
         /* Reset Min and Max to the opposite side, in order to have effective calibration */
         g_storedVar.minTrigger_raw = MAX_INT16;
@@ -732,24 +786,58 @@ void Task1code(void *pvParameters) {
         }
 
         break;
+      }
 
 
-      case CALIBRATION:
-        /* Read Throttle */
-        throttleCalibration(g_escVar.trigger_raw);    /* trigger raw is continuously read on task2 */
-        showScreenCalibration(g_escVar.trigger_raw);  /* Show calibration screen */
-        /* Exit calibration if button is presseded */
-        if (g_rotaryEncoder.isEncoderButtonClicked())  /* exit calibration and save calibration data to EEPROM */
+      case CALIBRATION: {
+        bool calibDone = false;
+        if (g_calibLinStep == 0) {
+          /* Read Throttle */
+          throttleCalibration(g_escVar.trigger_raw);    /* trigger raw is continuously read on task2 */
+          showScreenCalibration(g_escVar.trigger_raw);  /* Show calibration screen */
+          /* Min/max done: go on to the linearization points, or exit if there are none */
+          if (g_rotaryEncoder.isEncoderButtonClicked())
+          {
+            if (TRIGGER_LIN_POINTS > 0 && g_storedVar.maxTrigger_raw > g_storedVar.minTrigger_raw) {
+              g_calibLinStep = 1;
+              obdFill(&g_obd, OBD_WHITE, 1);
+            } else {
+              triggerLutSetPoints(nullptr);
+              calibDone = true;
+            }
+          }
+        } else {
+          showScreenCalibrationPoint(g_calibLinStep, g_escVar.trigger_raw);
+          if (g_rotaryEncoder.isEncoderButtonClicked()) {
+            g_calibLinPoints[g_calibLinStep - 1] = g_escVar.trigger_raw;
+            if (++g_calibLinStep > TRIGGER_LIN_POINTS) {
+              bool valid = triggerLutPointsValid(g_calibLinPoints, g_storedVar.minTrigger_raw, g_storedVar.maxTrigger_raw);
+              triggerLutSetPoints(valid ? g_calibLinPoints : nullptr);  /* Out of order: straight line */
+              calibDone = true;
+            } else {
+              obdFill(&g_obd, OBD_WHITE, 1);
+            }
+          } else if (digitalRead(BUTT_PIN) == BUTTON_PRESSED) {
+            while (digitalRead(BUTT_PIN) == BUTTON_PRESSED) vTaskDelay(1);
+            triggerLutSetPoints(nullptr);  /* Skip: straight line from min to max */
+            calibDone = true;
+          }
+        }
+        /* Exit calibration and save calibration data to EEPROM */
+        if (calibDone)
         {
+          g_calibLinStep = 0;
           if (g_storedVar.soundBoot) {
             offSound();
           }
           initMenuItems();  /* Init Menu Items */
           saveEEPROM(g_storedVar);  /* Save modified calibration values to EEPROM */
+          triggerLutService(g_storedVar.minTrigger_raw, g_storedVar.maxTrigger_raw);  /* Table ready before driving */
           HalfBridge_Enable();    /* Enable HalfBridge */
           g_currState = WELCOME;  /* Go to WELCOME state */
         }
         break;
+      }
 
 
       case WELCOME:
@@ -760,10 +848,12 @@ void Task1code(void *pvParameters) {
 
           The user trigger input is being elaborated and the correct speed (PWM) output is being produced for the whole duration of the WELCOME state */
 
-        if (g_storedVar.startupDelay > 0) {
+        if (g_storedVar.startupDelay > 0 && !sleepWakeIsFastWake()) {
           showScreenWelcome();    /* Show welcome screen */
           delay(g_storedVar.startupDelay * STARTUP_DELAY_STEP_MS);  /* Configurable startup delay */
         }
+        bootTimingMark(BOOT_STAGE_UI);  /* Calibration/self-test paths bring the UI up later */
+        bootTimingLog();
         g_currState = RUNNING;  /* Go to RUNNING state */
         break;
 
@@ -792,125 +882,86 @@ void Task1code(void *pvParameters) {
           encoderBoundariesSet = true;
         }
 
-        /* Handle race mode toggle: either from a submenu escape or direct long press */
+        /* Input events: race mode toggle (long press), menu click and brake "back" */
         static uint32_t lastLongPressTime = 0;
-        static uint32_t buttonPressStartTime = 0;
         static uint32_t lastShortPressTime = 0;
-        static bool buttonWasPressed = false;
-        static bool buttonLongPressHandled = false;
-        bool encoderButtonPressed = (digitalRead(ENCODER_BUTTON_PIN) == BUTTON_PRESSED);
-        bool raceToggleReleaseGuardActive = serviceRaceModeToggleReleaseGuard(encoderButtonPressed);
+        static uint32_t lastBrakeButtonPressTime = 0;
         bool encoderShortClick = false;
+        bool brakeButtonPressed = false;
 
         if (g_escapeToMain) {
           /* Return from submenu long press → toggle race mode immediately */
           g_escapeToMain = false;
           applyRaceModeToggle(menuState, lastLongPressTime);
-          raceToggleReleaseGuardActive = true;
-          buttonPressStartTime = 0;
-          lastShortPressTime = 0;
-          buttonWasPressed = false;
-          buttonLongPressHandled = true;
-        } else if (!raceToggleReleaseGuardActive) {
-          /* Direct press/release handling in RUNNING, independent of the encoder library click timeout logic. */
-          if (encoderButtonPressed) {
-            if (!buttonWasPressed) {
-              buttonPressStartTime = millis();
-              buttonWasPressed = true;
-              buttonLongPressHandled = false;
-            }
-            if (!buttonLongPressHandled &&
-                millis() - buttonPressStartTime > BUTTON_LONG_PRESS_MS &&
-                millis() - lastLongPressTime > BUTTON_LONG_PRESS_MS) {
-              applyRaceModeToggle(menuState, lastLongPressTime);
-              raceToggleReleaseGuardActive = true;
-              buttonLongPressHandled = true;
+        }
+
+        InputEvent_type inputEvent;
+        while (inputEventsGet(&inputEvent)) {
+          if (inputEvent.source == INPUT_SOURCE_ENC_BUTTON) {
+            if (inputEvent.type == INPUT_EVENT_LONG_PRESS && millis() - lastLongPressTime > BUTTON_LONG_PRESS_MS) {
+              applyRaceModeToggle(menuState, lastLongPressTime);  /* Flushes the queue: the release gives no click */
+              break;
             }
-          } else if (buttonWasPressed) {
-            uint32_t pressDuration = millis() - buttonPressStartTime;
-            buttonWasPressed = false;
-            buttonPressStartTime = 0;
-
-            if (!buttonLongPressHandled &&
-                pressDuration >= BUTTON_CLICK_MIN_MS &&
-                (lastShortPressTime == 0 || millis() - lastShortPressTime >= BUTTON_SHORT_PRESS_DEBOUNCE_MS)) {
+            if (inputEvent.type == INPUT_EVENT_CLICK &&
+                (lastShortPressTime == 0 || inputEvent.timeMs - lastShortPressTime >= BUTTON_SHORT_PRESS_DEBOUNCE_MS)) {
               encoderShortClick = true;
-              lastShortPressTime = millis();
+              lastShortPressTime = inputEvent.timeMs;
+            }
+          } else if (inputEvent.source == INPUT_SOURCE_BRAKE_BUTTON && inputEvent.type == INPUT_EVENT_PRESS) {
+            if (inputEvent.timeMs - lastBrakeButtonPressTime > BUTTON_SHORT_PRESS_DEBOUNCE_MS) {
+              brakeButtonPressed = true;
+              lastBrakeButtonPressTime = inputEvent.timeMs;
             }
-
-            buttonLongPressHandled = false;
           }
-        } else {
-          buttonPressStartTime = 0;
-          buttonWasPressed = false;
-          buttonLongPressHandled = false;
         }
 
-        /* Check for brake button press - acts as "back" in edit mode */
-        static bool brakeButtonWasPressedInMenu = false;
-        static uint32_t lastBrakeButtonPressTime = 0;
-
         /* In GRID mode: brake button exits edit mode (in addition to reducing brake) */
-        if (g_storedVar.viewMode == VIEW_MODE_GRID && menuState == VALUE_SELECTION && digitalRead(BUTT_PIN) == BUTTON_PRESSED) {
-          if (!brakeButtonWasPressedInMenu && millis() - lastBrakeButtonPressTime > BUTTON_SHORT_PRESS_DEBOUNCE_MS) {
-            brakeButtonWasPressedInMenu = true;
-            lastBrakeButtonPressTime = millis();
+        if (brakeButtonPressed && g_storedVar.viewMode == VIEW_MODE_GRID && menuState == VALUE_SELECTION) {
+          /* Restore original value (cancel changes) */
+          if (g_encoderSelectedValuePtr != NULL) {
+            *g_encoderSelectedValuePtr = g_originalValueBeforeEdit;
+            g_encoderSelectedValuePtr = NULL;
+          }
+          endSteppedValueEdit();
+
+          menuState = ITEM_SELECTION;
+          g_rotaryEncoder.setAcceleration(MENU_ACCELERATION);
 
+          uint8_t gridItems;
+          if (g_storedVar.raceViewMode == RACE_VIEW_SIMPLE) {
+            gridItems = g_storedVar.gridCarSelectEnabled ? 3 : 2;
+          } else {
+            gridItems = g_storedVar.gridCarSelectEnabled ? 5 : 4;
+          }
+          setUiEncoderBoundaries(1, gridItems, false);
+          resetUiEncoder(g_encoderMainSelector);
+          g_escVar.encoderPos = g_encoderMainSelector;
+          g_isEditingCarSelection = false;
+          obdFill(&g_obd, OBD_WHITE, 1);
+          g_lastEncoderInteraction = millis();
+        }
+        else if (brakeButtonPressed && g_storedVar.viewMode == VIEW_MODE_LIST) {
+          /* If in VALUE_SELECTION, cancel changes and go back to ITEM_SELECTION */
+          if (menuState == VALUE_SELECTION) {
             /* Restore original value (cancel changes) */
             if (g_encoderSelectedValuePtr != NULL) {
               *g_encoderSelectedValuePtr = g_originalValueBeforeEdit;
-              g_encoderSelectedValuePtr = NULL;
+              g_encoderSelectedValuePtr = NULL;  /* Clear pointer after use */
             }
             endSteppedValueEdit();
 
             menuState = ITEM_SELECTION;
             g_rotaryEncoder.setAcceleration(MENU_ACCELERATION);
-
-            uint8_t gridItems;
-            if (g_storedVar.raceViewMode == RACE_VIEW_SIMPLE) {
-              gridItems = g_storedVar.gridCarSelectEnabled ? 3 : 2;
-            } else {
-              gridItems = g_storedVar.gridCarSelectEnabled ? 5 : 4;
-            }
-            setUiEncoderBoundaries(1, gridItems, false);
+            setUiEncoderBoundaries(1, getMainMenuItemsCount(), false);
             resetUiEncoder(g_encoderMainSelector);
             g_escVar.encoderPos = g_encoderMainSelector;
+            /* Clear car editing flag */
             g_isEditingCarSelection = false;
-            obdFill(&g_obd, OBD_WHITE, 1);
+            /* Do NOT save to EEPROM - we're canceling the change */
+            obdFill(&g_obd, OBD_WHITE, 1);  /* Clear screen */
             g_lastEncoderInteraction = millis();
           }
-        }
-        else if (g_storedVar.viewMode == VIEW_MODE_LIST && digitalRead(BUTT_PIN) == BUTTON_PRESSED) {
-          if (!brakeButtonWasPressedInMenu && millis() - lastBrakeButtonPressTime > BUTTON_SHORT_PRESS_DEBOUNCE_MS) {
-            brakeButtonWasPressedInMenu = true;
-            lastBrakeButtonPressTime = millis();
-
-            /* If in VALUE_SELECTION, cancel changes and go back to ITEM_SELECTION */
-            if (menuState == VALUE_SELECTION) {
-              /* Restore original value (cancel changes) */
-              if (g_encoderSelectedValuePtr != NULL) {
-                *g_encoderSelectedValuePtr = g_originalValueBeforeEdit;
-                g_encoderSelectedValuePtr = NULL;  /* Clear pointer after use */
-              }
-              endSteppedValueEdit();
-
-              menuState = ITEM_SELECTION;
-              g_rotaryEncoder.setAcceleration(MENU_ACCELERATION);
-              setUiEncoderBoundaries(1, getMainMenuItemsCount(), false);
-              resetUiEncoder(g_encoderMainSelector);
-              g_escVar.encoderPos = g_encoderMainSelector;
-              /* Clear car editing flag */
-              g_isEditingCarSelection = false;
-              /* Do NOT save to EEPROM - we're canceling the change */
-              obdFill(&g_obd, OBD_WHITE, 1);  /* Clear screen */
-              g_lastEncoderInteraction = millis();
-            }
-            /* If already in ITEM_SELECTION, brake button doesn't do anything in main menu */
-          }
-        }
-        /* Reset flag when button is released */
-        if (digitalRead(BUTT_PIN) != BUTTON_PRESSED) {
-          brakeButtonWasPressedInMenu = false;
+          /* If already in ITEM_SELECTION, brake button doesn't do anything in main menu */
         }
 
         /* Configurable brake hold in ITEM_SELECTION toggles settings lock */
@@ -940,6 +991,7 @@ void Task1code(void *pvParameters) {
           } else {
             menuState = rotary_onButtonClick(menuState);  /* This function is called if the encoder is pressed
                                                              Take the current menu state and returns the next menu state */
+            inputEventsFlush();                           /* Input a submenu already acted on */
             g_lastEncoderInteraction = millis();          /* Update last encoder interaction */
           }
         }
@@ -971,14 +1023,10 @@ void Task1code(void *pvParameters) {
 
         /* Show Main Menu display */
         printMainMenu(menuState);
-        if (g_storedVar.carParam[g_carSel].freqPWM != prevFreqPWM)  /* if PWM freq parameter is changed, update motor PWM */
+        if (g_storedVar.activeCar.freqPWM != prevFreqPWM)  /* if PWM freq parameter is changed, update motor PWM */
         {
-          prevFreqPWM = g_storedVar.carParam[g_carSel].freqPWM;
-          ledcDetach(HB_IN_PIN);
-          ledcDetach(HB_INH_PIN);
-          uint16_t freqTmp = g_storedVar.carParam[g_carSel].freqPWM * 100;
-          ledcAttachChannel(HB_IN_PIN, freqTmp, THR_PWM_RES_BIT, THR_IN_PWM_CHAN);
-          ledcAttachChannel(HB_INH_PIN, freqTmp, THR_PWM_RES_BIT, THR_INH_PWM_CHAN);
+          prevFreqPWM = g_storedVar.activeCar.freqPWM;
+          HalfBridge_RequestPwmFrequency((uint32_t)g_storedVar.activeCar.freqPWM * 100);  /* Applied by Task2 */
         }
         if (g_escVar.outputSpeed_pct == 100) /* indicate 100% throttle also on the internal ESP32 LED*/
           digitalWrite(LED_BUILTIN, 1);
@@ -998,10 +1046,16 @@ void Task1code(void *pvParameters) {
         break;
     }
 
-    if (g_currState != prevState) /* Every time FSM machine change state */
+    if (g_currState != prevState) { /* Every time FSM machine change state */
       obdFill(&g_obd, OBD_WHITE, 1);
+      inputEventsFlush();
+    }
+
+    /* RACE while the grid (race) view is up: throttles the portal, raises WiFiTask */
+    schedProfileService(g_currState == RUNNING && g_storedVar.viewMode == VIEW_MODE_GRID);
 
-    vTaskDelay(1); /* Yield to WiFiTask (priority 0) every iteration */
+    /* Sleep until input arrives or the next refresh of the live values is due (also yields to WiFiTask) */
+    inputEventsWait(schedProfileUiWaitMs());
   }
 }
 
@@ -1012,8 +1066,17 @@ void Task1code(void *pvParameters) {
  *          from blocking the encoder and state machine in Task1.
  */
 void WiFiTaskcode(void *pvParameters) {
+  uint32_t lastPortalService_ms = 0;
   for (;;) {
-    serviceWiFiPortal();
+    lapEngineService();
+    raceLinkService();
+    telemetryLogService();
+    telemetryPyramidService();
+    telemetryStreamService();
+    taskMonitorService();
+    if (schedProfilePortalDue(&lastPortalService_ms)) {
+      serviceWiFiPortal();  /* Every pass in TUNING, every SCHED_RACE_PORTAL_PERIOD_MS in RACE */
+    }
     vTaskDelay(1);
   }
 }
@@ -1033,13 +1096,20 @@ void loop() {}
  */
 void showScreenWelcome()
 {
+  sprintf(msgStr, "v%d.%d", SW_MAJOR_VERSION, SW_MINOR_VERSION);
+  uint32_t screenKey = oledScreenKeyAddString(oledScreenKeyBegin(OLED_SCREEN_WELCOME), msgStr);
+  if (oledScreenCacheShow(screenKey)) {
+    return;
+  }
+
   /* Display "ESPEED" in large font */
-  obdWriteString(&g_obd, 0, 24, 14, (char *)"ESPEED", FONT_12x16, OBD_BLACK, 1);
+  oledFrameClear();
+  obdWriteString(&g_obd, 0, 24, 14, (char *)"ESPEED", FONT_12x16, OBD_BLACK, OLED_FRAME_RENDER);
 
   /* Display version in smaller font, centered below with spacing */
-  sprintf(msgStr, "v%d.%d", SW_MAJOR_VERSION, SW_MINOR_VERSION);
   uint8_t versionWidth = strlen(msgStr) * 6;  /* 6px per char for FONT_6x8 */
-  obdWriteString(&g_obd, 0, (OLED_WIDTH - versionWidth) / 2, 36, msgStr, FONT_6x8, OBD_BLACK, 1);
+  obdWriteString(&g_obd, 0, (OLED_WIDTH - versionWidth) / 2, 36, msgStr, FONT_6x8, OBD_BLACK, OLED_FRAME_RENDER);
+  oledScreenCachePresent(screenKey);
 }
 
 
@@ -1098,8 +1168,28 @@ void showScreenCalibration(int16_t adcRaw)
   obdWriteString(&g_obd, 0, 0, 56, msgStr, FONT_6x8, OBD_BLACK, 1);
 }
 
-#define ANTIS_SPEED_START_MIN 30  /* [%] Start anti-spin only for throttle requests above this threshold */
-#define ANTIS_SPEED_START_MAX 65  /* [%] Maximum anti-spin start threshold */
+/**
+ * Show one linearization step of the calibration: hold the trigger at a fraction of its travel and click.
+ *
+ * @param point 1..TRIGGER_LIN_POINTS
+ * @param adcRaw The raw trigger value read from the ADC
+ */
+void showScreenCalibrationPoint(uint8_t point, int16_t adcRaw)
+{
+  sprintf(msgStr, "%s", STR_CALIBRATION[g_storedVar.language]);
+  int calWidth = strlen(msgStr) * 6;
+  obdWriteString(&g_obd, 0, (OLED_WIDTH - calWidth) / 2, 0, msgStr, FONT_6x8, OBD_WHITE, 1);
+
+  sprintf(msgStr, "Point %u/%u: hold the", (unsigned)point, (unsigned)TRIGGER_LIN_POINTS);
+  obdWriteString(&g_obd, 0, 0, 8, msgStr, FONT_6x8, OBD_BLACK, 1);
+  sprintf(msgStr, "trigger at %2u%% travel", (unsigned)((100U * point) / (TRIGGER_LIN_POINTS + 1U)));
+  obdWriteString(&g_obd, 0, 0, 16, msgStr, FONT_6x8, OBD_BLACK, 1);
+
+  sprintf(msgStr, "Raw throttle %4d  ", adcRaw);
+  obdWriteString(&g_obd, 0, 0, 32, msgStr, FONT_6x8, OBD_BLACK, 1);
+
+  obdWriteString(&g_obd, 0, 0, 56, (char *)"enc>capture brk>skip", FONT_6x8, OBD_BLACK, 1);
+}
 
 /**
  * @brief Apply anti-spin control to prevent car drift
@@ -1107,167 +1197,33 @@ void showScreenCalibration(int16_t adcRaw)
  *          Anti-spin time is the ramp time from the anti-spin start point up toward maxSpeed.
  *          It is not a pure trigger delay.
  *          Anti-spin is bypassed at low duty cycles (< antispinPercStart) where current is too low to cause spinning.
+ *          Car parameters come from the control task's snapshot (activeTuningTick()).
  *          The antispinPercStart threshold varies with the antiSpin setting:
  *          - High antiSpin (200ms) = Low threshold (powerful motor/slippery track)
  *          - Low antiSpin = High threshold (good traction)
  * 
- * @param requestedSpeed [%] Requested output speed (0-100%)
- * @return [%] Actual output speed respecting anti-spin ramp limits
+ * @param requestedSpeed [0.1%] Requested output speed (0-1000)
+ * @return [0.1%] Actual output speed respecting anti-spin ramp limits
  */
 uint16_t throttleAntiSpin3(uint16_t requestedSpeed) {
-  static uint32_t lastOutputSpeedx1000 = 0;
-  static unsigned long prevCall_uS = 0;
-  
-  unsigned long currCall_uS = micros();
-  unsigned long deltaTime_uS = currCall_uS - prevCall_uS;
-  prevCall_uS = currCall_uS;
-
-  /* Calculate dynamic anti-spin start threshold based on anti-spin setting */
-  uint16_t antispinPercStart = map((long)g_storedVar.carParam[g_carSel].antiSpin, 0, (long)ANTISPIN_MAX_VALUE, 
-                                    (long)ANTIS_SPEED_START_MAX, (long)ANTIS_SPEED_START_MIN);
-  uint16_t antispinPercStartRaw = antispinPercStart * SENSI_SCALE;
-
-  /* Bypass anti-spin if disabled */
-  if (g_storedVar.carParam[g_carSel].antiSpin == 0) {
-    lastOutputSpeedx1000 = getEffectiveSensiRaw() * 500;
-    return requestedSpeed;
-  }
-
-  /* Bypass anti-spin at low speeds (insufficient current for wheel spin) */
-  if (requestedSpeed < antispinPercStart) {
-    lastOutputSpeedx1000 = requestedSpeed * 1000;
-    return requestedSpeed;
-  }
-
-  /* Allow immediate deceleration (braking) */
-  if ((uint32_t)requestedSpeed * 1000 <= lastOutputSpeedx1000) {
-    lastOutputSpeedx1000 = requestedSpeed * 1000;
-    return requestedSpeed;
-  }
-
-  /* Apply anti-spin ramp for acceleration */
-  uint16_t minSpeedTmpRaw = max(getEffectiveSensiRaw(), antispinPercStartRaw);
-  uint16_t maxSpeedRaw = g_storedVar.carParam[g_carSel].maxSpeed * SENSI_SCALE;
-  
-  /* Convert the 0.5%-unit span into the existing x1000-percent ramp units.
-   * deltaTime is in us while antiSpin is in ms, so the required conversion is /2 overall. */
-  uint32_t maxDeltaSpeedx1000 = ((uint32_t)(maxSpeedRaw - minSpeedTmpRaw) * deltaTime_uS) /
-                                 ((uint32_t)g_storedVar.carParam[g_carSel].antiSpin * 2UL);
-
-  uint32_t outputSpeedX1000;
-  
-  /* Check if we can increase speed by full delta or if we're close to target */
-  if (lastOutputSpeedx1000 < ((uint32_t)requestedSpeed * 1000 - maxDeltaSpeedx1000)) {
-    outputSpeedX1000 = lastOutputSpeedx1000 + maxDeltaSpeedx1000;
-  } else {
-    outputSpeedX1000 = requestedSpeed * 1000;  /* Target reached */
-  }
-
-  /* Ensure ramp starts from minSpeed, not zero */
-  if (outputSpeedX1000 < getEffectiveSensiRaw() * 500) {
-    outputSpeedX1000 = getEffectiveSensiRaw() * 500;
-  }
-
-  lastOutputSpeedx1000 = outputSpeedX1000;
-  return outputSpeedX1000 / 1000;
+  static AntiSpinRamp_type ramp = {0, 0};
+  const ActiveTuning_type* tuning = activeTuningTick();
+  const AntiSpinRampParams_type params = {
+    tuning->antiSpin, ANTISPIN_MAX_VALUE, tuning->effectiveSensi_raw, SENSI_SCALE, tuning->maxSpeed
+  };
+  return controlMathAntiSpinRamp(&ramp, requestedSpeed, &params, micros());
 }
 
 
 /**
- * Accounts for a deadband in an input value.
- * 
- * @param inputVal The input value
- * @param minVal The lower bound of the input value range
- * @param maxVal The upper bound of the input value range
- * @param deadBand The deadband as absolute value (not a percentage)
- * @return If the input value is less than the minVal + deadBand, it returns minVal.
-           If the input value is more than the maxVal - deadBand, it returns the maxVal.
-           Otherwise, it returns the inputVal, scaled in order to range from minVal to maxVal.
- */
-uint16_t addDeadBand(uint16_t inputVal, uint16_t minVal, uint16_t maxVal, uint16_t deadBand) 
-{
-  uint16_t retVal = 0;
-
-  /* If the inputVal is less than deadBand_pct, return 0 */
-  if (inputVal < minVal + deadBand) 
-  {
-    retVal = 0;
-  } 
-  /* If the inputVal is more than maxValue - deadBand, return maxValue */
-  else if (inputVal > maxVal - deadBand) 
-  {
-    retVal = maxVal;
-  } 
-  else 
-  {
-    /* retVal = (THROTTLE_NORMALIZED * (inputVal - deadBand)) / (THROTTLE_NORMALIZED - 2 * deadBand); TODO: verify what this is suppose to do */
-    retVal = map(inputVal, deadBand, maxVal - deadBand, minVal, maxVal);  /* Scale the inputValue (which ranges from (minVal + deadBand) to (maxVal - deadBand))
-                                                                             so that it ranges from minVal to maxVal */
-  }
-
-  return retVal;
-}
-
-/**
- * throttleCurve2: Map trigger position(throttle) to speed (duty) on a broken line curve, with midpoint set as throttleCurveVertex
- * dual throttle curve: When decelerating , if dragB is higher than 100%-minSpeed, then set a lower minSpeed
+ * throttleCurve2: Map trigger position(throttle) to speed (duty) on the selected car's throttle curve
+ * @details Served from the precomputed table in throttle_lut.cpp; see throttleCurveEvaluate() for the curve itself
  * @param inputThrottleNorm The input Trigger value, normalized between 0 and THROTTLE_NORMALIZED
- * @return duty cyle to be applied at that specific thrigger position on the selected curve
+ * @return [0.1%] duty cyle to be applied at that specific thrigger position on the selected curve (0-1000)
  */
-uint16_t throttleCurve2(uint16_t inputThrottleNorm )
+uint16_t throttleCurve2(uint16_t inputThrottleNorm)
 {
-  uint16_t outputSpeed = 0;           /* The requested output speed (duty cycle) from 0% to 100% */
-  uint32_t throttleCurveVertexSpeedRaw;  /* Output speed in 0.5% units at the curve vertex */
-  uint16_t outputSpeedRaw = 0;           /* Output speed in 0.5% units */
-  uint16_t tmpMinSpeedRaw;               /* Minimum speed in 0.5% units */
-  uint16_t maxSpeedRaw;                  /* Maximum speed in 0.5% units */
-  uint16_t fadeThrottleNorm;
-  uint16_t curveVertexInputNorm;
-
-  /* dual throttle curve: When decelerating , if dragB is higher than 100%-minSpeed, then set a lower minSpeed on the curve to allow the desired drag brake to be applied*/
-  tmpMinSpeedRaw = getEffectiveSensiRaw();
-  maxSpeedRaw = g_storedVar.carParam[g_carSel].maxSpeed * SENSI_SCALE;
-  fadeThrottleNorm = fadePctToThrottleNorm(min((uint16_t)FADE_MAX_VALUE, g_storedVar.carParam[g_carSel].fade));
-  curveVertexInputNorm = curveVertexInputWithFade(fadeThrottleNorm, g_storedVar.carParam[g_carSel].throttleCurveVertex.inputThrottle);
-
-  /* Calculate the output speed of the throttle curve vertex
-     This is calculated as the curveSpeedDiff (from 10% to 90%) percentage of the difference between minSpeed and maxSpeed */
-  throttleCurveVertexSpeedRaw = tmpMinSpeedRaw + (((uint32_t)maxSpeedRaw - (uint32_t)tmpMinSpeedRaw) * ((uint32_t)g_storedVar.carParam[g_carSel].throttleCurveVertex.curveSpeedDiff) / 100);
-
-  if (inputThrottleNorm == 0)   /* If input throttle is 0 --> output speed is 0% */
-  {
-    outputSpeedRaw = 0;
-  }
-  else if (fadeThrottleNorm > 0 && inputThrottleNorm <= fadeThrottleNorm)
-  {
-    /* FADE fills the gap between 0 output and SENSI over the first part of trigger travel. */
-    outputSpeedRaw = (uint16_t)map(inputThrottleNorm, 0, fadeThrottleNorm, 0, tmpMinSpeedRaw);
-  }
-  else if (inputThrottleNorm <= curveVertexInputNorm)
-  {
-    if (curveVertexInputNorm <= fadeThrottleNorm)
-    {
-      outputSpeedRaw = (uint16_t)throttleCurveVertexSpeedRaw;
-    }
-    else
-    {
-      outputSpeedRaw = (uint16_t)map(inputThrottleNorm, fadeThrottleNorm, curveVertexInputNorm, tmpMinSpeedRaw, throttleCurveVertexSpeedRaw);
-    }
-  }
-  else
-  {
-    if (curveVertexInputNorm >= THROTTLE_NORMALIZED)
-    {
-      outputSpeedRaw = maxSpeedRaw;
-    }
-    else
-    {
-      outputSpeedRaw = (uint16_t)map(inputThrottleNorm, curveVertexInputNorm, THROTTLE_NORMALIZED, throttleCurveVertexSpeedRaw, maxSpeedRaw);
-    }
-  }
-
-  outputSpeed = (outputSpeedRaw + 1U) / SENSI_SCALE;  /* round to nearest whole percent */
-  return outputSpeed;
+  return throttleLutLookup(inputThrottleNorm);
 }
 
 /**
@@ -1330,12 +1286,12 @@ MenuState_enum rotary_onButtonClick(MenuState_enum currMenuState)
         /* SIMPLE mode: 0=BRAKE, 1=SENSI, 2=CAR */
         switch (gridItem) {
           case 0:  /* BRAKE */
-            g_encoderSelectedValuePtr = &g_storedVar.carParam[g_carSel].brake;
+            g_encoderSelectedValuePtr = &g_storedVar.activeCar.brake;
             selectedParamMaxValue = BRAKE_MAX_VALUE;
             selectedParamMinValue = 0;
             break;
           case 1:  /* SENSI (minSpeed) */
-            g_encoderSelectedValuePtr = &g_storedVar.carParam[g_carSel].minSpeed;
+            g_encoderSelectedValuePtr = &g_storedVar.activeCar.minSpeed;
             selectedParamMaxValue = MIN_SPEED_MAX_VALUE;
             selectedParamMinValue = 0;
             break;
@@ -1353,22 +1309,22 @@ MenuState_enum rotary_onButtonClick(MenuState_enum currMenuState)
         /* FULL mode: 0=BRAKE, 1=SENSI, 2=ANTIS, 3=CURVE, 4=CAR */
         switch (gridItem) {
           case 0:  /* BRAKE */
-            g_encoderSelectedValuePtr = &g_storedVar.carParam[g_carSel].brake;
+            g_encoderSelectedValuePtr = &g_storedVar.activeCar.brake;
             selectedParamMaxValue = BRAKE_MAX_VALUE;
             selectedParamMinValue = 0;
             break;
           case 1:  /* SENSI (minSpeed) */
-            g_encoderSelectedValuePtr = &g_storedVar.carParam[g_carSel].minSpeed;
+            g_encoderSelectedValuePtr = &g_storedVar.activeCar.minSpeed;
             selectedParamMaxValue = MIN_SPEED_MAX_VALUE;
             selectedParamMinValue = 0;
             break;
           case 2:  /* ANTIS (antiSpin) */
-            g_encoderSelectedValuePtr = &g_storedVar.carParam[g_carSel].antiSpin;
+            g_encoderSelectedValuePtr = &g_storedVar.activeCar.antiSpin;
             selectedParamMaxValue = antiSpinUiMaxValue(g_antiSpinDisplayMode);
             selectedParamMinValue = 0;
             break;
           case 3:  /* CURVE */
-            g_encoderSelectedValuePtr = &g_storedVar.carParam[g_carSel].throttleCurveVertex.curveSpeedDiff;
+            g_encoderSelectedValuePtr = &g_storedVar.activeCar.throttleCurveVertex.curveSpeedDiff;
             selectedParamMaxValue = THROTTLE_CURVE_SPEED_DIFF_MAX_VALUE;
             selectedParamMinValue = THROTTLE_CURVE_SPEED_DIFF_MIN_VALUE;
             break;
@@ -1449,43 +1405,6 @@ MenuState_enum rotary_onButtonClick(MenuState_enum currMenuState)
   }
 }
 
-/**
- * Take an ADC raw value where the max and min has been recorded and returns the value scaled
- * 
- * @param raw The raw ADC value
- * @param minIn The lowest reading of the ADC
- * @param maxIn The highest reading of the ADC
- * @param normalizedMax The new max value of the scale
- * @param isReversed Whether the throttle is reversed or not
- * @return The raw ADC value scaled from 0 to normalizedMax
- */
-uint16_t normalizeAndClamp(uint16_t raw, uint16_t minIn, uint16_t maxIn, uint16_t normalizedMax, bool isReversed)
-{
-  uint16_t retVal = 0;  /* From 0 to normalizedMax */
-
-  if (maxIn == minIn)  /* If maxIn == minIn avoid division by 0 */
-  {
-    retVal = 0;
-  }
-  else
-  {
-    raw = constrain(raw, minIn, maxIn); /* Make sure the raw value is constrained between minIn and maxIn */
-
-    if (isReversed == true)  /* If throttle is reversed (it goes to low values when pressed) */
-    {
-      raw = abs(maxIn - raw);
-    }
-    else
-    {
-      raw = abs(raw - minIn);
-    }
-
-    retVal = ((uint32_t)raw * normalizedMax) / (maxIn - minIn); /* Scale the raw reading */
-  }
-
-  return retVal;
-}
-
 /**
  * Saturate an input value between a upper and lower bound
  * 
@@ -1510,17 +1429,22 @@ uint16_t saturateParamValue(uint16_t paramValue, uint16_t minValue, uint16_t max
 }
 
 
+/**
+ * @brief Queue the settings for the store task (see settings_store.h)
+ * @details Returns without touching flash; edits made within the coalescing window are
+ *          written together, and only the car profiles / keys that changed.
+ */
 void saveEEPROM(StoredVar_type toSave) {
-  g_pref.begin("stored_var", false);                      /* Open the "stored" namespace in read/write mode */
-  g_pref.putBytes("user_param", &toSave, sizeof(toSave)); /* Put the value of the stored user_param */
-  g_pref.putUChar(PREF_KEY_STATS_ENABLED, g_statsEnabled ? 1 : 0);
-  g_pref.putUShort(PREF_KEY_ANTIS_STEP, constrain(g_antiSpinStepMs, ANTISPIN_STEP_MIN, ANTISPIN_STEP_MAX));
-  g_pref.putUShort(PREF_KEY_ANTIS_STEP_PCT, constrain(g_antiSpinStepPct, ANTISPIN_STEP_PCT_MIN, ANTISPIN_STEP_PCT_MAX));
-  g_pref.putUChar(PREF_KEY_ANTIS_MODE, constrain(g_antiSpinDisplayMode, ANTISPIN_UI_MODE_MS, ANTISPIN_UI_MODE_TEXT));
-  g_pref.putUChar(PREF_KEY_ENC_INVERT, g_encoderInvertEnabled ? 1 : 0);
-  g_pref.putUShort(PREF_KEY_ADC_RANGE, constrain(g_adcVoltageRange_mV, ADC_VOLTAGE_RANGE_MIN_MVOLTS, ADC_VOLTAGE_RANGE_MAX_MVOLTS));
-  g_pref.putUChar(PREF_KEY_EXT_POT1_TARGET, constrain(g_extPotTarget[0], EXT_POT_TARGET_MIN, EXT_POT_TARGET_MAX));
-  g_pref.putUChar(PREF_KEY_EXT_POT2_TARGET, constrain(g_extPotTarget[1], EXT_POT_TARGET_MIN, EXT_POT_TARGET_MAX));
-  g_pref.end();                                           /* Close the namespace */
-  saveWiFiNetworkSettings();
+  SettingsExtras_type extras;
+  extras.statsEnabled = g_statsEnabled ? 1 : 0;
+  extras.antiSpinStepMs = constrain(g_antiSpinStepMs, ANTISPIN_STEP_MIN, ANTISPIN_STEP_MAX);
+  extras.antiSpinStepPct = constrain(g_antiSpinStepPct, ANTISPIN_STEP_PCT_MIN, ANTISPIN_STEP_PCT_MAX);
+  extras.antiSpinDisplayMode = constrain(g_antiSpinDisplayMode, ANTISPIN_UI_MODE_MS, ANTISPIN_UI_MODE_TEXT);
+  extras.encoderInvert = g_encoderInvertEnabled ? 1 : 0;
+  extras.adcVoltageRange_mV = constrain(g_adcVoltageRange_mV, ADC_VOLTAGE_RANGE_MIN_MVOLTS, ADC_VOLTAGE_RANGE_MAX_MVOLTS);
+  extras.extPotTarget[0] = constrain(g_extPotTarget[0], EXT_POT_TARGET_MIN, EXT_POT_TARGET_MAX);
+  extras.extPotTarget[1] = constrain(g_extPotTarget[1], EXT_POT_TARGET_MIN, EXT_POT_TARGET_MAX);
+  triggerLutGetPoints(extras.triggerLinPoints);
+  settingsStoreRequest(&toSave, &extras);
+  saveWiFiNetworkSettings();  /* Compare-before-write: only touches flash when Wi-Fi settings changed */
 }
@@ -3,8 +3,14 @@
 /*********************************************************************************************************************/
 #include "HAL.h"
 #include "slot_ESC.h"
+#include "adc_sampler.h"
+#include "current_sampler.h"
+#include "buzzer.h"
+#include "control_math.h"
 #include <math.h>
 #include <Preferences.h>
+#include <driver/ledc.h>
+#include <soc/soc_caps.h>
 
 /* Datasheet tAPC is in the sub-millisecond range; keep a small margin plus retries. */
 static constexpr uint16_t TLE493D_I2C_STABILIZE_MS = 2;
@@ -12,6 +18,11 @@ static constexpr uint8_t TLE493D_INIT_RETRIES = 6;
 static constexpr uint16_t TLE493D_INIT_RETRY_DELAY_MS = 2;
 static constexpr int32_t TLE493D_MIN_VECTOR_SQ = 16;
 static constexpr int BOOT_SOUND_NOTE_MS = 20;
+
+/* Trigger sensor read kernel. Each family/variant has its own straight-line read + unpack;
+ * the one in use is bound here once (at build time, or by TLE493D variant detection) so the
+ * per-tick read is a single indirect call with no variant branching. */
+typedef int16_t (*TriggerSensorRead_fn)();
 /* Include appropriate sensor library based on selection */
 #ifdef AS5600_MAG
   #include "AS5600.h"
@@ -191,24 +202,71 @@ static constexpr int BOOT_SOUND_NOTE_MS = 20;
       g_tleYavg = y;
       g_tleFilterInit = true;
     }
+#if TRIGGER_FILTER_MODE == TRIGGER_FILTER_AVG2
     g_tleXavg = (g_tleXavg * 3 + x) / 4;
     g_tleYavg = (g_tleYavg * 3 + y) / 4;
+#else
+    /* The control loop's trigger filter smooths the angle; a second stage here only adds lag */
+    g_tleXavg = x;
+    g_tleYavg = y;
+#endif
 
     int32_t vecSq = (int32_t)g_tleXavg * (int32_t)g_tleXavg + (int32_t)g_tleYavg * (int32_t)g_tleYavg;
     if (vecSq < TLE493D_MIN_VECTOR_SQ && g_tleLastAngleValid) {
       return g_tleLastAngle;
     }
 
-    float angleRad = atan2((float)g_tleYavg, (float)g_tleXavg);
-    float angleDeg = angleRad * 180.0f / PI;
-    if (angleDeg < 0.0f) angleDeg += 360.0f;
-
-    int16_t angle10 = (int16_t)(angleDeg * 10.0f);
+    int16_t angle10 = controlMathAtan2Deg10(g_tleYavg, g_tleXavg);
     g_tleLastAngle = angle10;
     g_tleLastAngleValid = true;
     return angle10;
   }
 
+  /* Frame layouts: bytes to read and a branch-free unpack to signed X/Y.
+     Sign extension: place the field's MSB at bit 15, then arithmetic-shift back down. */
+  struct TLE493D_W2B6Frame {    /* Also W2B6_A0: Bx/By 12-bit, high byte + shared low nibbles in byte 4 */
+    static constexpr uint8_t BYTES = 7;
+    static inline void unpack(const uint8_t* d, int16_t* x, int16_t* y) {
+      *x = (int16_t)(((uint16_t)d[0] << 8) | (d[4] & 0xF0)) >> 4;
+      *y = (int16_t)(((uint16_t)d[1] << 8) | ((d[4] & 0x0F) << 4)) >> 4;
+    }
+  };
+
+  struct TLE493D_P3B6Frame {    /* Bx/By 14-bit: high byte + 6 low bits in the next byte */
+    static constexpr uint8_t BYTES = 4;
+    static inline void unpack(const uint8_t* d, int16_t* x, int16_t* y) {
+      *x = (int16_t)(((uint16_t)d[0] << 8) | ((d[1] & 0x3F) << 2)) >> 2;
+      *y = (int16_t)(((uint16_t)d[2] << 8) | ((d[3] & 0x3F) << 2)) >> 2;
+    }
+  };
+
+  template <typename Frame>
+  static int16_t TLE493D_ReadAngle() {
+    uint8_t data[Frame::BYTES];
+    if (!TLE493D_ReadFrame(g_tleAddress, data, Frame::BYTES)) {
+      return g_tleLastAngleValid ? g_tleLastAngle : 0;  /* Bus error: hold the last angle */
+    }
+    int16_t x, y;
+    Frame::unpack(data, &x, &y);
+    return TLE493D_ComputeAngle10(x, y);
+  }
+
+  static int16_t TLE493D_ReadNone() {
+    return 0;
+  }
+
+  static TriggerSensorRead_fn TLE493D_ReadFnFor(TLE493DVariant variant) {
+    switch (variant) {
+      case TLE493DVariant::W2B6:
+      case TLE493DVariant::W2B6_A0: return TLE493D_ReadAngle<TLE493D_W2B6Frame>;
+      case TLE493DVariant::P3B6: return TLE493D_ReadAngle<TLE493D_P3B6Frame>;
+      default: return TLE493D_ReadNone;
+    }
+  }
+
+  /* Rebound by TLE493D_ApplyMode(); a pointer store, so the sampler never sees a torn value */
+  static volatile TriggerSensorRead_fn g_triggerSensorRead = TLE493D_ReadNone;
+
   static uint8_t TLE493D_NormalizeOverrideMode(uint16_t mode) {
     if (mode > TRIGGER_SENSOR_TYPE_MAX) return TRIGGER_SENSOR_TYPE_AUTO;
     return (uint8_t)mode;
@@ -242,6 +300,7 @@ static constexpr int BOOT_SOUND_NOTE_MS = 20;
   }
 
   static void TLE493D_ResetRuntimeState() {
+    g_triggerSensorRead = TLE493D_ReadNone;
     g_tleVariant = TLE493DVariant::NONE;
     g_tleAddress = TLE493D_W2B6_A3_ADDR;
     g_tleXavg = 0;
@@ -346,6 +405,7 @@ static constexpr int BOOT_SOUND_NOTE_MS = 20;
     if (tleReady) {
       g_tleVariant = detectedVariant;
       g_tleAddress = detectedAddress;
+      g_triggerSensorRead = TLE493D_ReadFnFor(detectedVariant);
       TLE493D_SaveCachedConfig(detectedVariant, detectedAddress);
     }
 
@@ -387,9 +447,10 @@ static constexpr int BOOT_SOUND_NOTE_MS = 20;
  */
 void HAL_InitHW() {
   /* Initialize serial for debugging */
-  Serial.begin(115200);
+  Serial.setTxBufferSize(HAL_SERIAL_TX_BUFFER_BYTES);
+  Serial.begin(HAL_SERIAL_BAUD);
 #ifdef AS5600_MAG
-  Wire1.begin(SDA0_PIN, SCL0_PIN, 400000L);
+  Wire1.begin(SDA0_PIN, SCL0_PIN, AS5600_I2C_CLOCK_HZ);
 #endif
   /* Configure ADC for current sensing on GPIO25 */
   analogSetAttenuation(ADC_11db);  /* Set ADC range to 0-3.3V */
@@ -397,21 +458,101 @@ void HAL_InitHW() {
 
 #ifdef TLE493D_MAG
   /* Initialize I2C for TLE493D sensor */
-  Wire1.begin(SDA0_PIN, SCL0_PIN, 100000L);
+  Wire1.begin(SDA0_PIN, SCL0_PIN, TLE493D_I2C_CLOCK_HZ);
   delay(TLE493D_I2C_STABILIZE_MS);  /* Wait for I2C stabilization */
   g_tleOverrideMode = TLE493D_LoadOverrideMode();
   TLE493D_ApplyMode(g_tleOverrideMode);
 #endif
 
   /* Configure motor control PWM channels */
-  ledcAttachChannel(HB_IN_PIN, PWM_FREQ_DEFAULT * 1000, THR_PWM_RES_BIT, THR_IN_PWM_CHAN);
-  ledcAttachChannel(HB_INH_PIN, PWM_FREQ_DEFAULT * 1000, THR_PWM_RES_BIT, THR_INH_PWM_CHAN);
+  HAL_AttachMotorPwm(PWM_FREQ_DEFAULT * 100);   /* PWM_FREQ_DEFAULT is in 100 Hz units */
+}
+
+static volatile uint8_t g_motorPwmResBits = THR_PWM_RES_BIT;
+/* HAL_SetMotorPwmFrequency() outcomes; written by the control task only */
+static volatile uint32_t g_motorPwmRetimes = 0;
+static volatile uint32_t g_motorPwmReattaches = 0;
+static volatile int32_t g_motorPwmRetimeError = ESP_OK;   /* Last ledc_set_freq() failure */
+
+static_assert(THR_IN_PWM_CHAN / SOC_LEDC_CHANNEL_NUM == THR_INH_PWM_CHAN / SOC_LEDC_CHANNEL_NUM &&
+              (THR_IN_PWM_CHAN / 2) % 4 == (THR_INH_PWM_CHAN / 2) % 4,
+              "IN and INH must share one LEDC timer for the in-place retime");
+
+/**
+ * @brief (Re)attach both motor PWM channels at the highest resolution the frequency allows
+ * @details Between THR_PWM_RES_BIT and THR_PWM_RES_BIT_MAX bits; over the 1-5 kHz PWM_F range
+ *          that is always 12 bits. The current/back-EMF samplers must be told about the new
+ *          frequency afterwards (they re-enable the pad inputs).
+ * @return Resolution in bits
+ */
+static uint8_t HAL_MotorPwmResolutionFor(uint32_t freq_hz) {
+  uint8_t bits = THR_PWM_RES_BIT;
+  while (bits < THR_PWM_RES_BIT_MAX && freq_hz > 0 &&
+         (uint64_t)freq_hz << (bits + 1) <= THR_PWM_SRC_CLK_HZ) {
+    bits++;
+  }
+  return bits;
+}
+
+uint8_t HAL_AttachMotorPwm(uint32_t freq_hz) {
+  uint8_t bits = HAL_MotorPwmResolutionFor(freq_hz);
+  ledcDetach(HB_IN_PIN);
+  ledcDetach(HB_INH_PIN);
+  g_motorPwmResBits = bits;
+  ledcAttachChannel(HB_IN_PIN, freq_hz, bits, THR_IN_PWM_CHAN);
+  ledcAttachChannel(HB_INH_PIN, freq_hz, bits, THR_INH_PWM_CHAN);
+  return bits;
+}
+
+/**
+ * @brief Change the motor PWM frequency without detaching the channels
+ * @details IN and INH run off the same LEDC timer, so one divider update retimes both and
+ *          keeps their phase relation; the timer latches the new divider at its next overflow,
+ *          i.e. on a period boundary, and the duty counts stay valid. Only a frequency that
+ *          needs a different resolution falls back to HAL_AttachMotorPwm().
+ *          Call from the control task (HalfBridge_ServicePwmFrequency()), which owns the duty writes.
+ *          Every fall back is counted (HAL_GetMotorPwmRetimeStats(), /api/info motorPwm).
+ * @return false if the frequency had to be applied by re-attaching the channels
+ */
+bool HAL_SetMotorPwmFrequency(uint32_t freq_hz) {
+  if (freq_hz != 0 && HAL_MotorPwmResolutionFor(freq_hz) == g_motorPwmResBits) {
+    esp_err_t err = ledc_set_freq(THR_PWM_LEDC_MODE, THR_PWM_LEDC_TIMER, freq_hz);
+    if (err == ESP_OK) {
+      g_motorPwmRetimes = g_motorPwmRetimes + 1U;
+      return true;
+    }
+    g_motorPwmRetimeError = err;
+  }
+  HAL_AttachMotorPwm(freq_hz);
+  g_motorPwmReattaches = g_motorPwmReattaches + 1U;
+  return false;
+}
+
+/**
+ * @brief In-place retimes, re-attach fall backs and the last retime error since boot
+ */
+void HAL_GetMotorPwmRetimeStats(uint32_t* retimes, uint32_t* reattaches, int32_t* lastError) {
+  if (retimes != nullptr) *retimes = g_motorPwmRetimes;
+  if (reattaches != nullptr) *reattaches = g_motorPwmReattaches;
+  if (lastError != nullptr) *lastError = g_motorPwmRetimeError;
+}
+
+uint8_t HAL_GetMotorPwmResolution() {
+  return g_motorPwmResBits;
+}
+
+/**
+ * @brief Duty count written for "100%" at the current resolution
+ * @details One count short of always-on, i.e. 255 at 8 bits as before.
+ */
+uint32_t HAL_GetMotorPwmMaxDuty() {
+  return (1UL << g_motorPwmResBits) - 1UL;
 }
 
 /**
  * @brief Write PWM value to motor control channel
  * @param pwmChan PWM channel number
- * @param value PWM duty cycle value (0-255)
+ * @param value PWM duty in counts (0-HAL_GetMotorPwmMaxDuty())
  * @note Adapted for ESP32 3.0.0 library (ledcWrite takes PIN, not CHANNEL)
  */
 void HALanalogWrite(const int pwmChan, int value) {
@@ -429,56 +570,24 @@ void HALanalogWrite(const int pwmChan, int value) {
   }
 }
 
+/* Fixed-family read kernels: bound at build time, the call inlines */
+#if defined(AS5600_MAG) || defined(AS5600L_MAG)
+  static inline int16_t TriggerSensor_ReadAS5600() { return (int16_t)as5600.readAngle(); }
+  static constexpr TriggerSensorRead_fn g_triggerSensorRead = TriggerSensor_ReadAS5600;
+#elif defined(MT6701_MAG)
+  static inline int16_t TriggerSensor_ReadMT6701() { return (int16_t)mt6701.getAngleDegrees(); }
+  static constexpr TriggerSensorRead_fn g_triggerSensorRead = TriggerSensor_ReadMT6701;
+#elif defined(ANALOG_TRIG)
+  static inline int16_t TriggerSensor_ReadAnalog() { return (int16_t)analogRead(AN_THROT_PIN); }
+  static constexpr TriggerSensorRead_fn g_triggerSensorRead = TriggerSensor_ReadAnalog;
+#endif
+
 /**
  * @brief Read raw trigger value from configured sensor
  * @return Raw trigger value (sensor-dependent scale)
  */
 int16_t HAL_ReadTriggerRaw() {
-  uint16_t retVal = 0;
-
-  #if defined(AS5600_MAG) || defined(AS5600L)
-    retVal = as5600.readAngle();
-
-  #elif defined(MT6701_MAG)
-    retVal = mt6701.getAngleDegrees();
-
-  #elif defined(ANALOG_TRIG)
-    retVal = analogRead(AN_THROT_PIN);
-
-  #elif defined(TLE493D_MAG)
-    if (g_tleVariant == TLE493DVariant::W2B6 || g_tleVariant == TLE493DVariant::W2B6_A0) {
-      uint8_t data[7];
-      if (!TLE493D_ReadFrame(g_tleAddress, data, sizeof(data))) {
-        retVal = g_tleLastAngleValid ? (uint16_t)g_tleLastAngle : 0;
-      } else {
-        int16_t x = ((int16_t)data[0] << 4) | (data[4] >> 4);
-        if (x >= 2048) x -= 4096;
-
-        int16_t y = ((int16_t)data[1] << 4) | (data[4] & 0x0F);
-        if (y >= 2048) y -= 4096;
-
-        retVal = (uint16_t)TLE493D_ComputeAngle10(x, y);
-      }
-    } else if (g_tleVariant == TLE493DVariant::P3B6) {
-      uint8_t data[4];
-      if (!TLE493D_ReadFrame(g_tleAddress, data, sizeof(data))) {
-        retVal = g_tleLastAngleValid ? (uint16_t)g_tleLastAngle : 0;
-      } else {
-        int16_t x = ((int16_t)data[0] << 6) | (data[1] & 0x3F);  /* 14-bit signed */
-        if (x >= 8192) x -= 16384;
-
-        int16_t y = ((int16_t)data[2] << 6) | (data[3] & 0x3F);  /* 14-bit signed */
-        if (y >= 8192) y -= 16384;
-
-        retVal = (uint16_t)TLE493D_ComputeAngle10(x, y);
-      }
-    } else {
-      retVal = 0;
-    }
-    
-  #endif
-
-  return retVal;
+  return g_triggerSensorRead();
 }
 
 /**
@@ -617,6 +726,19 @@ void HAL_ResetTriggerSensorConfig() {
 /**
  * @brief Setup GPIO pins
  */
+/**
+ * @brief Read an analog input in raw ADC steps
+ * @details Uses the oversampled value from the continuous ADC sampler when it owns the pin,
+ *          otherwise a one-shot analogRead().
+ */
+static uint16_t HAL_ReadAnalogRaw(uint8_t pin) {
+  uint16_t raw;
+  if (adcSamplerGetRaw(pin, &raw)) {
+    return raw;
+  }
+  return (uint16_t)analogRead(pin);
+}
+
 void HAL_PinSetup() {
   pinMode(BUZZ_PIN, OUTPUT);
   pinMode(LED_BUILTIN, OUTPUT);
@@ -634,7 +756,7 @@ void HAL_PinSetup() {
  * @return Voltage applied to voltage divider [mV]
  */
 uint16_t HAL_ReadVoltageDivider(int analogInput, uint32_t rvfbl, uint32_t rvfbh) {
-  uint32_t adcRaw = analogRead(analogInput);
+  uint32_t adcRaw = HAL_ReadAnalogRaw((uint8_t)analogInput);
   
   /* Calculate voltage at ADC pin */
   uint32_t voltage = ((uint32_t)g_adcVoltageRange_mV * adcRaw) / ACD_RESOLUTION_STEPS;
@@ -697,60 +819,58 @@ uint16_t HAL_ConvertMotorCurrentAdcToMilliAmps(uint32_t adcRaw) {
  */
 uint16_t HAL_ReadMotorCurrent() {
   if (!HAL_HasMotorCurrentSense()) return 0;
-  return HAL_ConvertMotorCurrentAdcToMilliAmps((uint32_t)analogRead(HB_AN_PIN));
+  CurrentSample_type sample;
+  if (currentSamplerGetLatest(&sample)) {
+    return sample.average_mA;  /* PWM-synchronized, see current_sampler.cpp */
+  }
+  return HAL_ConvertMotorCurrentAdcToMilliAmps((uint32_t)HAL_ReadAnalogRaw(HB_AN_PIN));
 }
 
 uint16_t HAL_ReadExternalPot1Raw() {
-  return (uint16_t)analogRead(EXT_POT1_PIN);
+  return HAL_ReadAnalogRaw(EXT_POT1_PIN);
 }
 
 uint16_t HAL_ReadExternalPot2Raw() {
-  return (uint16_t)analogRead(EXT_POT2_PIN);
+  return HAL_ReadAnalogRaw(EXT_POT2_PIN);
 }
 
 /**
- * @brief Play a tone on the buzzer
+ * @brief Play a tone on the buzzer (returns immediately, see buzzer.h)
  * @param note Musical note to play
  * @param ms Duration in milliseconds
  */
 void sound(note_t note, int ms) {
-  ledcAttachChannel(BUZZ_PIN, 5000, 8, BUZZ_CHAN);
-  ledcWriteNote(BUZZ_PIN, note, 7);
-  delay(ms);
-  ledcDetach(BUZZ_PIN);
+  const BuzzerStep_type step = {note, (uint16_t)constrain(ms, 0, UINT16_MAX)};
+  buzzerPlay(&step, 1);
 }
 
 /**
  * @brief Play power-off sound (E -> C)
  */
-void offSound() { 
-  sound(NOTE_E, 60);
-  delay(60);
-  sound(NOTE_C, 60);  
+void offSound() {
+  static const BuzzerStep_type OFF_SOUND[] = {{NOTE_E, 60}, {BUZZER_REST, 60}, {NOTE_C, 60}};
+  buzzerPlay(OFF_SOUND, 3);
 }
 
 /**
  * @brief Play power-on sound (C -> E)
  */
-void onSound() { 
-  sound(NOTE_C, BOOT_SOUND_NOTE_MS);
-  sound(NOTE_E, BOOT_SOUND_NOTE_MS);
+void onSound() {
+  static const BuzzerStep_type ON_SOUND[] = {{NOTE_C, BOOT_SOUND_NOTE_MS}, {NOTE_E, BOOT_SOUND_NOTE_MS}};
+  buzzerPlay(ON_SOUND, 2);
 }
 
 /**
  * @brief Play calibration mode sound (C -> G -> A)
  */
-void calibSound() { 
-  sound(NOTE_C, 60);
-  delay(60);
-  sound(NOTE_G, 60);  
-  delay(60);
-  sound(NOTE_A, 60);  
+void calibSound() {
+  static const BuzzerStep_type CALIB_SOUND[] = {{NOTE_C, 60}, {BUZZER_REST, 60}, {NOTE_G, 60}, {BUZZER_REST, 60}, {NOTE_A, 60}};
+  buzzerPlay(CALIB_SOUND, 5);
 }
 
 /**
  * @brief Play key press sound
  */
-void keySound() { 
+void keySound() {
   sound(NOTE_D, KEY_SOUND_MS);
 }
@@ -17,6 +17,10 @@
 #define OLED_HEIGHT 64
 #define USE_BACKBUFFER  /* Comment out if not enough RAM for back buffer */
 
+/* USB serial: command port default rate; the TX ring lets TSTREAM frames drain without blocking */
+#define HAL_SERIAL_BAUD             115200UL
+#define HAL_SERIAL_TX_BUFFER_BYTES  2048U
+
 /* Voltage Divider and Shunt Resistors */
 #define RVIFBL 2200UL    /* [Ohm] VIN ADC resistor divider, lower resistor */
 #define RVIFBH 10000UL   /* [Ohm] VIN ADC resistor divider, upper resistor */
@@ -71,7 +75,13 @@
 #define THR_IN_PWM_CHAN   0     /* PWM channel for motor input */
 #define THR_INH_PWM_CHAN  1     /* PWM channel for motor inhibit */
 #define BUZZ_CHAN         6     /* PWM channel for buzzer */
-#define THR_PWM_RES_BIT   8     /* PWM resolution in bits */ 
+#define THR_PWM_RES_BIT   8     /* Lowest motor PWM resolution in bits */
+#define THR_PWM_RES_BIT_MAX 12  /* Highest motor PWM resolution, used whenever the frequency allows it */
+#define THR_PWM_SRC_CLK_HZ 80000000UL  /* LEDC source clock (APB): freq x 2^bits must not exceed it */
+/* arduino-esp32 3.x puts LEDC channel N in speed mode N / SOC_LEDC_CHANNEL_NUM on timer (N / 2) % 4:
+ * THR_IN_PWM_CHAN and THR_INH_PWM_CHAN share timer 0 of LEDC_HIGH_SPEED_MODE on the classic ESP32 */
+#define THR_PWM_LEDC_MODE  ((ledc_mode_t)(THR_IN_PWM_CHAN / SOC_LEDC_CHANNEL_NUM))
+#define THR_PWM_LEDC_TIMER ((ledc_timer_t)((THR_IN_PWM_CHAN / 2) % 4))
 
 /* Trigger Sensor Family Selection
  * Select exactly one sensor family at compile time.
@@ -128,6 +138,16 @@
   #endif
 #endif
 
+/* Trigger sensor I2C clock [Hz]. The sampler task hides bus time from the control
+ * loop, but a faster bus still shortens sample age. Boards with strong pull-ups
+ * can try 400000 (TLE493D) or 1000000 (Fast-mode Plus capable sensors). */
+#ifndef TLE493D_I2C_CLOCK_HZ
+#define TLE493D_I2C_CLOCK_HZ  100000L
+#endif
+#ifndef AS5600_I2C_CLOCK_HZ
+#define AS5600_I2C_CLOCK_HZ   400000L
+#endif
+
 /* Trigger Reversal Configuration */
 #if defined(AS5600_MAG) || defined(AS5600L_MAG)
   #define THROTTLE_REV  1  /* 1 = trigger inverted (full press = minimum ADC value) */
@@ -139,6 +159,47 @@
   #define THROTTLE_REV  0  /* 0 = trigger normal (full press = maximum ADC value) */
 #endif
 
+/* Trigger filter, applied by the control loop to every new sample:
+ *   TRIGGER_FILTER_ADAPTIVE  One-Euro filter (control_math.h): heavy smoothing at rest, cutoff
+ *                            rising with trigger speed so a stab reaches the PWM almost unfiltered
+ *   TRIGGER_FILTER_AVG2      Legacy 2-sample average (plus the 3:1 X/Y IIR on the TLE493D)
+ *   TRIGGER_FILTER_NONE      Raw samples
+ * Defaults are per sensor because speed is in raw counts per second and the trigger travel
+ * spans ~400 counts on the AS5600, ~300 (0.1 deg) on the TLE493D, ~30 whole degrees on the
+ * MT6701 and ~2000 on the analog pot. Override any of them with -D. */
+#define TRIGGER_FILTER_NONE      0
+#define TRIGGER_FILTER_AVG2      1
+#define TRIGGER_FILTER_ADAPTIVE  2
+#ifndef TRIGGER_FILTER_MODE
+#define TRIGGER_FILTER_MODE  TRIGGER_FILTER_ADAPTIVE
+#endif
+
+#if defined(AS5600_MAG) || defined(AS5600L_MAG)
+  #define TRIGGER_FILTER_DEF_MIN_CUTOFF_DHZ  50    /* [0.1 Hz] */
+  #define TRIGGER_FILTER_DEF_BETA            150   /* [0.1 Hz per 1000 raw/s] */
+#elif defined(MT6701_MAG)
+  #define TRIGGER_FILTER_DEF_MIN_CUTOFF_DHZ  80    /* Coarse 1 deg steps: little to smooth */
+  #define TRIGGER_FILTER_DEF_BETA            1500
+#elif defined(ANALOG_TRIG)
+  #define TRIGGER_FILTER_DEF_MIN_CUTOFF_DHZ  30    /* ADC noise: filter hardest at rest */
+  #define TRIGGER_FILTER_DEF_BETA            30
+#elif defined(TLE493D_MAG)
+  #define TRIGGER_FILTER_DEF_MIN_CUTOFF_DHZ  40    /* Replaces the X/Y IIR in HAL.cpp */
+  #define TRIGGER_FILTER_DEF_BETA            200
+#endif
+#ifndef TRIGGER_FILTER_MIN_CUTOFF_DHZ
+#define TRIGGER_FILTER_MIN_CUTOFF_DHZ    TRIGGER_FILTER_DEF_MIN_CUTOFF_DHZ
+#endif
+#ifndef TRIGGER_FILTER_BETA
+#define TRIGGER_FILTER_BETA              TRIGGER_FILTER_DEF_BETA
+#endif
+#ifndef TRIGGER_FILTER_MAX_CUTOFF_DHZ
+#define TRIGGER_FILTER_MAX_CUTOFF_DHZ    3000  /* [0.1 Hz] 300 Hz: ~0.5 ms lag when moving */
+#endif
+#ifndef TRIGGER_FILTER_SPEED_CUTOFF_DHZ
+#define TRIGGER_FILTER_SPEED_CUTOFF_DHZ  200   /* [0.1 Hz] Speed estimate low-pass */
+#endif
+
 /* Miscellaneous */
 #define KEY_SOUND_MS      50
 #define BUTTON_PRESSED    0
@@ -198,6 +259,11 @@ uint16_t HAL_GetTriggerSensorTypeOverride();
 bool     HAL_SetTriggerSensorTypeOverride(uint16_t type);
 void     HAL_ResetTriggerSensorConfig();
 void     HALanalogWrite(int pwmChan, int value);
+uint8_t  HAL_AttachMotorPwm(uint32_t freq_hz);
+bool     HAL_SetMotorPwmFrequency(uint32_t freq_hz);
+void     HAL_GetMotorPwmRetimeStats(uint32_t* retimes, uint32_t* reattaches, int32_t* lastError);
+uint8_t  HAL_GetMotorPwmResolution();
+uint32_t HAL_GetMotorPwmMaxDuty();
 void     HAL_PinSetup();
 
 /* Sound Functions */
@@ -0,0 +1,163 @@
+#include "active_tuning.h"
+#include <Arduino.h>
+#include <atomic>
+#include <string.h>
+#include "ext_pot.h"
+
+extern StoredVar_type g_storedVar;
+extern ESC_type g_escVar;
+extern uint16_t g_carSel;
+
+/* Double buffer: g_tuningPublishSeq selects the active copy (seq & 1), 0 = nothing published yet.
+ * Writers hold g_tuningWriteMux, fill the inactive copy and then bump the sequence; a reader that
+ * sees the same sequence before and after its copy cannot have observed a partial publish. */
+static ActiveTuning_type g_tuningBuffers[2];
+static std::atomic<uint32_t> g_tuningPublishSeq(0);
+static portMUX_TYPE g_tuningWriteMux = portMUX_INITIALIZER_UNLOCKED;
+static ActiveTuning_type g_tuningLastBuilt;   /* Writer side, under g_tuningWriteMux */
+static uint32_t g_tuningPublishes = 0;
+
+/* Control task only */
+static ActiveTuning_type g_tuningTick;
+static uint32_t g_tuningRetries = 0;
+static uint32_t g_tuningStale = 0;
+
+/* Call with g_tuningWriteMux held */
+static void activeTuningBuild(ActiveTuning_type* out) {
+  const CarParam_type* car = &g_storedVar.activeCar;
+  uint8_t carIndex = (car->carNumber < CAR_MAX_COUNT) ? (uint8_t)car->carNumber : 0;
+  memset(out, 0, sizeof(*out));
+  out->carIndex = carIndex;
+  out->extPotBrake = isExtPotBrakeTarget();
+  out->extPotSensi = isExtPotSensiTarget();
+  out->brake = car->brake;
+  out->minSpeed = car->minSpeed;
+  out->maxSpeed = car->maxSpeed;
+  out->antiSpin = car->antiSpin;
+  out->antiSpinMode = car->antiSpinMode;
+  out->fade = car->fade;
+  out->vertexInput = car->throttleCurveVertex.inputThrottle;
+  out->vertexSpeedDiff = car->throttleCurveVertex.curveSpeedDiff;
+  out->curveShape = car->throttleCurveShape;
+  out->brakeButtonReduction = car->brakeButtonReduction;
+  out->quickBrakeEnabled = car->quickBrakeEnabled;
+  out->quickBrakeThreshold = car->quickBrakeThreshold;
+  out->quickBrakeStrength = car->quickBrakeStrength;
+  brakeEnvelopePrepare(car, &out->brakeEnvelope);
+}
+
+/* Call with g_tuningWriteMux held. Publishes only if something changed. */
+static bool activeTuningPublishLocked() {
+  ActiveTuning_type candidate;
+  activeTuningBuild(&candidate);
+  uint32_t seq = g_tuningPublishSeq.load(std::memory_order_relaxed);
+  if (seq != 0 && memcmp(&candidate, &g_tuningLastBuilt, sizeof(candidate)) == 0) {
+    return false;
+  }
+  g_tuningLastBuilt = candidate;
+
+  uint32_t nextSeq = seq + 1U;
+  candidate.version = nextSeq;
+  g_tuningBuffers[nextSeq & 1U] = candidate;
+  g_tuningPublishSeq.store(nextSeq, std::memory_order_release);
+  g_tuningPublishes++;
+  return true;
+}
+
+/**
+ * @brief Publish the selected car's parameters if they changed since the last publish
+ * @details Call every Task1 loop, after g_carSel has been updated.
+ * @return true if a new snapshot was published
+ */
+bool activeTuningService() {
+  portENTER_CRITICAL(&g_tuningWriteMux);
+  bool published = activeTuningPublishLocked();
+  portEXIT_CRITICAL(&g_tuningWriteMux);
+  return published;
+}
+
+/**
+ * @brief Replace all stored settings and publish the result in one step
+ * @details For writers outside Task1 (web apply, serial APPLY/RESTORE, file restore):
+ *          the copy cannot interleave with a Task1 publish.
+ */
+void activeTuningReplaceStoredVar(const StoredVar_type* updated) {
+  if (updated == nullptr) {
+    return;
+  }
+  portENTER_CRITICAL(&g_tuningWriteMux);
+  g_storedVar = *updated;
+  activeTuningPublishLocked();
+  portEXIT_CRITICAL(&g_tuningWriteMux);
+}
+
+/* Seqlock read of the published copy; false if publishes kept racing the copy */
+static bool activeTuningReadPublished(ActiveTuning_type* out, uint32_t* outRetries) {
+  for (uint8_t attempt = 0; attempt < ACTIVE_TUNING_READ_RETRIES; attempt++) {
+    uint32_t seq = g_tuningPublishSeq.load(std::memory_order_acquire);
+    if (seq == 0) {
+      return false;
+    }
+    *out = g_tuningBuffers[seq & 1U];
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (g_tuningPublishSeq.load(std::memory_order_relaxed) == seq) {
+      return true;
+    }
+    if (outRetries != nullptr) {
+      (*outRetries)++;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Consistent copy of the last published snapshot (any task)
+ * @details The ext-pot fields are left at the stored values.
+ */
+void activeTuningGetPublished(ActiveTuning_type* out) {
+  if (out == nullptr) {
+    return;
+  }
+  if (!activeTuningReadPublished(out, nullptr)) {
+    portENTER_CRITICAL(&g_tuningWriteMux);
+    *out = g_tuningBuffers[g_tuningPublishSeq.load(std::memory_order_relaxed) & 1U];
+    portEXIT_CRITICAL(&g_tuningWriteMux);
+  }
+  out->effectiveBrake_pct = out->brake;
+  out->effectiveSensi_raw = out->minSpeed;
+}
+
+/**
+ * @brief Take this tick's snapshot and apply the ext-pot overrides (control task, once per tick)
+ * @details Never blocks: if publishes keep racing the copy, the previous tick's snapshot is kept.
+ * @return Snapshot valid until the next call
+ */
+const ActiveTuning_type* activeTuningAcquire() {
+  ActiveTuning_type next;
+  if (activeTuningReadPublished(&next, &g_tuningRetries)) {
+    g_tuningTick = next;
+  } else if (g_tuningPublishSeq.load(std::memory_order_relaxed) != 0) {
+    g_tuningStale++;
+  }
+
+  updateExtPotRuntimeValues(&g_tuningTick);
+  g_tuningTick.effectiveBrake_pct = g_tuningTick.extPotBrake ? g_escVar.effectiveBrake_pct : g_tuningTick.brake;
+  g_tuningTick.effectiveSensi_raw = g_tuningTick.extPotSensi ? g_escVar.effectiveSensi_raw : g_tuningTick.minSpeed;
+  return &g_tuningTick;
+}
+
+/**
+ * @brief Snapshot taken by the last activeTuningAcquire() (control task only)
+ */
+const ActiveTuning_type* activeTuningTick() {
+  return &g_tuningTick;
+}
+
+void activeTuningGetStats(ActiveTuningStats_type* outStats) {
+  if (outStats == nullptr) {
+    return;
+  }
+  outStats->publishes = g_tuningPublishes;
+  outStats->retries = g_tuningRetries;
+  outStats->stale = g_tuningStale;
+}
@@ -0,0 +1,59 @@
+#ifndef ACTIVE_TUNING_H_
+#define ACTIVE_TUNING_H_
+
+#include <stdint.h>
+#include "slot_ESC.h"
+#include "brake_envelope.h"
+
+/* Active tuning: the selected car's control parameters as one consistent block.
+ * Task1 menus, /api/apply, serial APPLY and restore all write g_storedVar on core 0 while the
+ * control task runs on core 1; reading carParam[g_carSel] field by field there could mix old
+ * and new values within one tick. Instead writers publish a copy (double buffer + sequence,
+ * same scheme as the throttle table) and Task2 takes one snapshot per tick:
+ *   - Task1 calls activeTuningService() every loop: menu edits are picked up there
+ *   - writers on other tasks replace g_storedVar through activeTuningReplaceStoredVar(),
+ *     which also publishes, so a half-copied g_storedVar is never built from
+ *   - Task2 calls activeTuningAcquire() once per tick; it also applies the ext-pot overrides */
+#define ACTIVE_TUNING_READ_RETRIES  4   /* Publishes racing one snapshot before the previous one is kept */
+
+/**
+ * @brief Control parameters of the selected car
+ */
+typedef struct {
+  uint32_t version;              /* Publish sequence the snapshot was taken from (0 = nothing published) */
+  uint8_t carIndex;
+  bool extPotBrake;              /* An ext pot overrides brake */
+  bool extPotSensi;              /* An ext pot overrides SENSI */
+  uint16_t brake;                /* [%] */
+  uint16_t minSpeed;             /* [0.5%] Stored SENSI */
+  uint16_t maxSpeed;             /* [%] */
+  uint16_t antiSpin;             /* [ms] */
+  uint16_t antiSpinMode;         /* ANTISPIN_MODE_* */
+  uint16_t fade;                 /* [%] */
+  uint16_t vertexInput;          /* throttleCurveVertex.inputThrottle */
+  uint16_t vertexSpeedDiff;      /* [%] throttleCurveVertex.curveSpeedDiff */
+  ThrottleCurveShape_type curveShape;  /* Multi-point curve (vertex curve if inactive) */
+  uint16_t brakeButtonReduction; /* [%] Alternate brake while the button is held */
+  uint16_t quickBrakeEnabled;    /* RELEASE_BRAKE_* */
+  uint16_t quickBrakeThreshold;  /* [%] Trigger travel of the release zone */
+  uint16_t quickBrakeStrength;   /* [%] */
+  BrakeEnvelope_type brakeEnvelope;  /* Shape of the brake at trigger release */
+  /* Filled by activeTuningAcquire() on the control task */
+  uint16_t effectiveBrake_pct;   /* [%] brake after the ext-pot override */
+  uint16_t effectiveSensi_raw;   /* [0.5%] minSpeed after the ext-pot override */
+} ActiveTuning_type;
+
+typedef struct {
+  uint32_t publishes;   /* Snapshots published */
+  uint32_t retries;     /* Control ticks that re-read because a publish raced them */
+  uint32_t stale;       /* Control ticks that kept the previous snapshot */
+} ActiveTuningStats_type;
+
+bool activeTuningService();
+void activeTuningReplaceStoredVar(const StoredVar_type* updated);
+void activeTuningGetPublished(ActiveTuning_type* out);
+const ActiveTuning_type* activeTuningAcquire();
+const ActiveTuning_type* activeTuningTick();
+void activeTuningGetStats(ActiveTuningStats_type* outStats);
+
+#endif  /* ACTIVE_TUNING_H_ */
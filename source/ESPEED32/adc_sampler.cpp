@@ -0,0 +1,160 @@
+#include "adc_sampler.h"
+#include <Arduino.h>
+#include "HAL.h"
+
+/* Candidate inputs; those that are not on ADC1 for this target are left to one-shot reads.
+ * Motor current is not scanned: current_sampler.cpp times its reads to the PWM on-phase. */
+static const uint8_t ADC_SAMPLER_CANDIDATE_PINS[] = {AN_VIN_DIV, EXT_POT1_PIN, EXT_POT2_PIN};
+#define ADC_SAMPLER_MAX_PINS  (sizeof(ADC_SAMPLER_CANDIDATE_PINS) / sizeof(ADC_SAMPLER_CANDIDATE_PINS[0]))
+
+static uint8_t g_adcPins[ADC_SAMPLER_MAX_PINS];
+static uint8_t g_adcPinCount = 0;
+static volatile uint16_t g_adcRaw[ADC_SAMPLER_MAX_PINS];  /* 16-bit aligned stores: torn reads impossible */
+static volatile uint32_t g_adcFrames = 0;
+static volatile uint32_t g_adcReadErrors = 0;
+static volatile bool g_adcRunning = false;
+static TaskHandle_t g_adcSamplerTask = NULL;
+
+static const uint32_t ADC_SAMPLER_FIRST_FRAME_TIMEOUT_MS = 50;
+
+static bool adcSamplerPinIsAdc1(uint8_t pin) {
+  int8_t channel = digitalPinToAnalogChannel(pin);
+  return channel >= 0 && channel < SOC_ADC_MAX_CHANNEL_NUM;  /* ADC2 channels are reported from SOC_ADC_MAX_CHANNEL_NUM up */
+}
+
+static int8_t adcSamplerSlotForPin(uint8_t pin) {
+  for (uint8_t i = 0; i < g_adcPinCount; i++) {
+    if (g_adcPins[i] == pin) return (int8_t)i;
+  }
+  return -1;
+}
+
+static void ARDUINO_ISR_ATTR adcSamplerFrameDoneISR() {
+  if (g_adcSamplerTask == NULL) {
+    return;
+  }
+  BaseType_t higherPriorityTaskWoken = pdFALSE;
+  vTaskNotifyGiveFromISR(g_adcSamplerTask, &higherPriorityTaskWoken);
+  portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+static void adcSamplerTaskcode(void *pvParameters) {
+  (void)pvParameters;
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    adc_continuous_result_t* result = NULL;
+    if (!analogContinuousRead(&result, 0) || result == NULL) {
+      g_adcReadErrors = g_adcReadErrors + 1U;
+      continue;
+    }
+    /* Results come back in the order the pins were configured */
+    for (uint8_t i = 0; i < g_adcPinCount; i++) {
+      int raw = result[i].avg_read_raw;
+      g_adcRaw[i] = (uint16_t)constrain(raw, 0, ACD_RESOLUTION_STEPS);
+    }
+    g_adcFrames = g_adcFrames + 1U;
+  }
+}
+
+/**
+ * @brief Start continuous-mode acquisition of the ADC1 analog inputs
+ * @details Blocks until the first frame is published (or gives up and leaves the pins on
+ *          one-shot reads). Not started on ANALOG_TRIG builds: the trigger pot is read one-shot every tick
+ *          and ADC1 cannot run one-shot and continuous conversions at the same time.
+ * @return true if continuous acquisition is running
+ */
+bool adcSamplerStart() {
+  if (g_adcRunning) {
+    return true;
+  }
+#if defined(ANALOG_TRIG)
+  return false;
+#else
+  g_adcPinCount = 0;
+  for (uint8_t i = 0; i < ADC_SAMPLER_MAX_PINS; i++) {
+    uint8_t pin = ADC_SAMPLER_CANDIDATE_PINS[i];
+    if (!adcSamplerPinIsAdc1(pin) || adcSamplerSlotForPin(pin) >= 0) {
+      continue;
+    }
+    g_adcPins[g_adcPinCount++] = pin;
+  }
+  if (g_adcPinCount == 0) {
+    return false;
+  }
+
+  if (g_adcSamplerTask == NULL) {
+    BaseType_t ok = xTaskCreatePinnedToCore(
+      adcSamplerTaskcode,
+      "AdcSampler",
+      ADC_SAMPLER_STACK_SIZE,
+      NULL,
+      ADC_SAMPLER_TASK_PRIORITY,
+      &g_adcSamplerTask,
+      ADC_SAMPLER_TASK_CORE);
+    if (ok != pdPASS) {
+      g_adcSamplerTask = NULL;
+      return false;
+    }
+  }
+
+  analogContinuousSetAtten(ADC_11db);  /* Same 0-3.3V range as the one-shot reads */
+  if (!analogContinuous(g_adcPins, g_adcPinCount, ADC_SAMPLER_OVERSAMPLE, ADC_SAMPLER_SAMPLE_HZ, &adcSamplerFrameDoneISR)) {
+    return false;
+  }
+  if (!analogContinuousStart()) {
+    analogContinuousDeinit();
+    return false;
+  }
+
+  /* Readers switch over only once real data is in the slots */
+  uint32_t waitStartMs = millis();
+  while (g_adcFrames == 0) {
+    if ((uint32_t)(millis() - waitStartMs) > ADC_SAMPLER_FIRST_FRAME_TIMEOUT_MS) {
+      analogContinuousStop();
+      analogContinuousDeinit();
+      return false;
+    }
+    vTaskDelay(1);
+  }
+  g_adcRunning = true;
+  return true;
+#endif
+}
+
+bool adcSamplerIsRunning() {
+  return g_adcRunning;
+}
+
+/**
+ * @brief Check whether a pin is owned by the continuous driver
+ * @note While this returns true the pin must not be passed to analogRead().
+ */
+bool adcSamplerCoversPin(uint8_t pin) {
+  return g_adcRunning && adcSamplerSlotForPin(pin) >= 0;
+}
+
+/**
+ * @brief Load the latest oversampled raw reading of a scanned pin
+ * @return false if the pin is not scanned (caller falls back to analogRead())
+ */
+bool adcSamplerGetRaw(uint8_t pin, uint16_t* outRaw) {
+  if (!g_adcRunning || outRaw == nullptr) {
+    return false;
+  }
+  int8_t slot = adcSamplerSlotForPin(pin);
+  if (slot < 0) {
+    return false;
+  }
+  *outRaw = g_adcRaw[slot];
+  return true;
+}
+
+void adcSamplerGetStats(AdcSamplerStats_type* outStats) {
+  if (outStats == nullptr) {
+    return;
+  }
+  outStats->frames = g_adcFrames;
+  outStats->readErrors = g_adcReadErrors;
+  outStats->pinCount = g_adcPinCount;
+  outStats->running = g_adcRunning;
+}
@@ -0,0 +1,33 @@
+#ifndef ADC_SAMPLER_H_
+#define ADC_SAMPLER_H_
+
+#include <stdint.h>
+
+/* Background ADC acquisition: ADC1 runs in continuous (DMA) mode and scans the analog
+ * inputs at a fixed rate. Each frame is averaged per pin by the driver and published
+ * here, so readers get an oversampled raw value without starting a conversion.
+ * Only ADC1 pins can be scanned; ADC2 inputs keep using one-shot analogRead(). */
+#define ADC_SAMPLER_TASK_PRIORITY  2       /* Above Task1/WiFiTask so frames are drained on time */
+#define ADC_SAMPLER_TASK_CORE      0
+#define ADC_SAMPLER_STACK_SIZE     3072
+#ifndef ADC_SAMPLER_SAMPLE_HZ
+#define ADC_SAMPLER_SAMPLE_HZ      20000UL /* [Hz] Total conversion rate across all scanned pins */
+#endif
+#ifndef ADC_SAMPLER_OVERSAMPLE
+#define ADC_SAMPLER_OVERSAMPLE     20      /* Conversions averaged per pin per published frame */
+#endif
+
+typedef struct {
+  uint32_t frames;        /* Frames published since start */
+  uint32_t readErrors;    /* Frame-done events where the driver returned no data */
+  uint8_t pinCount;       /* Pins scanned in continuous mode */
+  bool running;
+} AdcSamplerStats_type;
+
+bool adcSamplerStart();
+bool adcSamplerIsRunning();
+bool adcSamplerCoversPin(uint8_t pin);
+bool adcSamplerGetRaw(uint8_t pin, uint16_t* outRaw);
+void adcSamplerGetStats(AdcSamplerStats_type* outStats);
+
+#endif  /* ADC_SAMPLER_H_ */
@@ -1,11 +1,13 @@
 #include "app_init.h"
 #include <Arduino.h>
 #include "slot_ESC.h"
+#include "car_profiles.h"
 #include "ui_text_access.h"
 #include "menu_car.h"
 #include "settings_quick_brake_menu.h"
 #include "settings_menu_root.h"
 #include "diagnostics_lap_stats.h"
+#include "input_events.h"
 
 extern OBDISP g_obd;
 extern StoredVar_type g_storedVar;
@@ -15,7 +17,6 @@ extern uint16_t g_antiSpinDisplayMode;
 extern uint16_t g_encoderInvertEnabled;
 extern Menu_type g_mainMenu;
 extern Menu_type g_settingsMenu;
-extern Menu_type g_carMenu;
 extern uint16_t g_carSel;
 extern AiEsp32RotaryEncoder g_rotaryEncoder;
 extern uint8_t getMainMenuItemsCount();
@@ -55,35 +56,23 @@ void initDisplayAndEncoder()
   g_rotaryEncoder.setup(readEncoderISR);
   setUiEncoderBoundaries(1, getMainMenuItemsCount(), false); /* minValue, maxValue, circleValues true|false (when max go to min and vice versa) */
   g_rotaryEncoder.setAcceleration(MENU_ACCELERATION);        /* Larger number = more accelearation; 0 or 1 means disabled acceleration */
+  inputEventsBegin();                                        /* Button interrupts + event queue Task1 sleeps on */
 }
 
 
 /* Rotary Encoder ISR */
 void IRAM_ATTR readEncoderISR() {
   g_rotaryEncoder.readEncoder_ISR();
+  inputEventsEncoderISR();
 }
 
 
 /**
  * Initialize the stored variables with default values.
-   This is done for every CAR in the CarParam array.
+   Only CAR0 is in RAM; the other profiles have no blob yet and read as their defaults.
  */
 void initStoredVariables() {
-  for (int i = 0; i < CAR_MAX_COUNT; i++) {
-    g_storedVar.carParam[i].minSpeed = MIN_SPEED_DEFAULT;
-    g_storedVar.carParam[i].brake = BRAKE_DEFAULT;
-    g_storedVar.carParam[i].maxSpeed = MAX_SPEED_DEFAULT;
-    g_storedVar.carParam[i].throttleCurveVertex = { THROTTLE_CURVE_INPUT_THROTTLE_DEFAULT, THROTTLE_CURVE_SPEED_DIFF_DEFAULT };
-    g_storedVar.carParam[i].fade = FADE_DEFAULT;
-    g_storedVar.carParam[i].antiSpin = ANTISPIN_DEFAULT;
-    g_storedVar.carParam[i].freqPWM = PWM_FREQ_DEFAULT;
-    g_storedVar.carParam[i].carNumber = i;
-    g_storedVar.carParam[i].brakeButtonReduction = BRAKE_BUTTON_REDUCTION_DEFAULT;
-    g_storedVar.carParam[i].quickBrakeEnabled = QUICK_BRAKE_ENABLED_DEFAULT;
-    g_storedVar.carParam[i].quickBrakeThreshold = QUICK_BRAKE_THRESHOLD_DEFAULT;
-    g_storedVar.carParam[i].quickBrakeStrength = QUICK_BRAKE_STRENGTH_DEFAULT;
-    sprintf(g_storedVar.carParam[i].carName, "CAR%d", i);
-  }
+  carProfileDefaults(0, &g_storedVar.activeCar);
   g_storedVar.selectedCarNumber = 0;
   g_storedVar.minTrigger_raw = 0;
 #if defined(TLE493D_MAG)
@@ -134,24 +123,24 @@ void initMenuItems() {
   uint8_t lang = g_storedVar.language;
   /* Init menu items - using language-specific names */
 
-  sprintf(g_mainMenu.item[i].name, "%s", getMenuName(lang, 0));  /* BRAKE */
-  g_mainMenu.item[i].value = (void *)&g_storedVar.carParam[g_carSel].brake;
+  sprintf(g_mainMenu.item[i].name, "%s", uiText(UI_TEXT_MENU, lang, 0));  /* BRAKE */
+  g_mainMenu.item[i].value = (void *)&g_storedVar.activeCar.brake;
   g_mainMenu.item[i].type = VALUE_TYPE_INTEGER;
   sprintf(g_mainMenu.item[i].unit, "%%");
   g_mainMenu.item[i].maxValue = BRAKE_MAX_VALUE;
   g_mainMenu.item[i].minValue = 0;
   g_mainMenu.item[i].callback = ITEM_NO_CALLBACK;
 
-  sprintf(g_mainMenu.item[++i].name, "%s", getMenuName(lang, 1));  /* SENSI */
-  g_mainMenu.item[i].value = (void *)&g_storedVar.carParam[g_carSel].minSpeed;
+  sprintf(g_mainMenu.item[++i].name, "%s", uiText(UI_TEXT_MENU, lang, 1));  /* SENSI */
+  g_mainMenu.item[i].value = (void *)&g_storedVar.activeCar.minSpeed;
   g_mainMenu.item[i].type = VALUE_TYPE_INTEGER;
   sprintf(g_mainMenu.item[i].unit, "%%");
-  g_mainMenu.item[i].maxValue = min(MIN_SPEED_MAX_VALUE, (int)g_storedVar.carParam[g_carSel].maxSpeed * SENSI_SCALE);
+  g_mainMenu.item[i].maxValue = min(MIN_SPEED_MAX_VALUE, (int)g_storedVar.activeCar.maxSpeed * SENSI_SCALE);
   g_mainMenu.item[i].minValue = 0;
   g_mainMenu.item[i].callback = ITEM_NO_CALLBACK;
 
-  sprintf(g_mainMenu.item[++i].name, "%s", getMenuName(lang, 2));  /* ANTIS */
-  g_mainMenu.item[i].value = (void *)&g_storedVar.carParam[g_carSel].antiSpin;
+  sprintf(g_mainMenu.item[++i].name, "%s", uiText(UI_TEXT_MENU, lang, 2));  /* ANTIS */
+  g_mainMenu.item[i].value = (void *)&g_storedVar.activeCar.antiSpin;
   g_mainMenu.item[i].type = VALUE_TYPE_INTEGER;
   if (g_antiSpinDisplayMode == ANTISPIN_UI_MODE_PERCENT) {
     sprintf(g_mainMenu.item[i].unit, "%%");
@@ -164,24 +153,24 @@ void initMenuItems() {
   g_mainMenu.item[i].minValue = 0;
   g_mainMenu.item[i].callback = ITEM_NO_CALLBACK;
 
-  sprintf(g_mainMenu.item[++i].name, "%s", getMenuName(lang, 3));  /* CURVE */
-  g_mainMenu.item[i].value = (void *)&g_storedVar.carParam[g_carSel].throttleCurveVertex.curveSpeedDiff;
+  sprintf(g_mainMenu.item[++i].name, "%s", uiText(UI_TEXT_MENU, lang, 3));  /* CURVE */
+  g_mainMenu.item[i].value = (void *)&g_storedVar.activeCar.throttleCurveVertex.curveSpeedDiff;
   g_mainMenu.item[i].type = VALUE_TYPE_INTEGER;
   sprintf(g_mainMenu.item[i].unit, "%%");
   g_mainMenu.item[i].maxValue = THROTTLE_CURVE_SPEED_DIFF_MAX_VALUE;
   g_mainMenu.item[i].minValue = THROTTLE_CURVE_SPEED_DIFF_MIN_VALUE;
   g_mainMenu.item[i].callback = &showCurveSelection;
 
-  sprintf(g_mainMenu.item[++i].name, "%s", getMenuName(lang, 4));  /* FADE */
-  g_mainMenu.item[i].value = (void *)&g_storedVar.carParam[g_carSel].fade;
+  sprintf(g_mainMenu.item[++i].name, "%s", uiText(UI_TEXT_MENU, lang, 4));  /* FADE */
+  g_mainMenu.item[i].value = (void *)&g_storedVar.activeCar.fade;
   g_mainMenu.item[i].type = VALUE_TYPE_INTEGER;
   sprintf(g_mainMenu.item[i].unit, "%%");
   g_mainMenu.item[i].maxValue = FADE_MAX_VALUE;
   g_mainMenu.item[i].minValue = 0;
   g_mainMenu.item[i].callback = &showFadeSelection;
 
-  sprintf(g_mainMenu.item[++i].name, "%s", getMenuName(lang, 5));  /* PWM_F */
-  g_mainMenu.item[i].value = (void *)&g_storedVar.carParam[g_carSel].freqPWM;
+  sprintf(g_mainMenu.item[++i].name, "%s", uiText(UI_TEXT_MENU, lang, 5));  /* PWM_F */
+  g_mainMenu.item[i].value = (void *)&g_storedVar.activeCar.freqPWM;
   g_mainMenu.item[i].type = VALUE_TYPE_DECIMAL;
   sprintf(g_mainMenu.item[i].unit, "k");
   g_mainMenu.item[i].maxValue = FREQ_MAX_VALUE / 100;
@@ -189,7 +178,7 @@ void initMenuItems() {
   g_mainMenu.item[i].decimalPoint = 1;
   g_mainMenu.item[i].callback = ITEM_NO_CALLBACK;
 
-  sprintf(g_mainMenu.item[++i].name, "%s", getMenuName(lang, 6));  /* BRAKE+ submenu */
+  sprintf(g_mainMenu.item[++i].name, "%s", uiText(UI_TEXT_MENU, lang, 6));  /* BRAKE+ submenu */
   g_mainMenu.item[i].value = ITEM_NO_VALUE;
   g_mainMenu.item[i].type = VALUE_TYPE_INTEGER;
   sprintf(g_mainMenu.item[i].unit, "");
@@ -197,15 +186,15 @@ void initMenuItems() {
   g_mainMenu.item[i].minValue = 0;
   g_mainMenu.item[i].callback = &showAdvancedBrakeMenu;
 
-  sprintf(g_mainMenu.item[++i].name, "%s", getMenuName(lang, 7));  /* LIMIT */
-  g_mainMenu.item[i].value = (void *)&g_storedVar.carParam[g_carSel].maxSpeed;
+  sprintf(g_mainMenu.item[++i].name, "%s", uiText(UI_TEXT_MENU, lang, 7));  /* LIMIT */
+  g_mainMenu.item[i].value = (void *)&g_storedVar.activeCar.maxSpeed;
   g_mainMenu.item[i].type = VALUE_TYPE_INTEGER;
   sprintf(g_mainMenu.item[i].unit, "%%");
   g_mainMenu.item[i].maxValue = MAX_SPEED_DEFAULT;
-  g_mainMenu.item[i].minValue = max(5, (int)sensiToWholePctCeil(g_storedVar.carParam[g_carSel].minSpeed) + 5);
+  g_mainMenu.item[i].minValue = max(5, (int)sensiToWholePctCeil(g_storedVar.activeCar.minSpeed) + 5);
   g_mainMenu.item[i].callback = ITEM_NO_CALLBACK;
 
-  sprintf(g_mainMenu.item[++i].name, "%s", getMenuName(lang, 8));  /* SETTINGS */
+  sprintf(g_mainMenu.item[++i].name, "%s", uiText(UI_TEXT_MENU, lang, 8));  /* SETTINGS */
   g_mainMenu.item[i].value = ITEM_NO_VALUE;
   g_mainMenu.item[i].type = VALUE_TYPE_INTEGER;
   sprintf(g_mainMenu.item[i].unit, "");
@@ -214,7 +203,7 @@ void initMenuItems() {
   g_mainMenu.item[i].callback = &showSettingsMenu;
 
   if (g_statsEnabled) {
-    sprintf(g_mainMenu.item[++i].name, "%s", getMenuName(lang, 9));  /* STATS */
+    sprintf(g_mainMenu.item[++i].name, "%s", uiText(UI_TEXT_MENU, lang, 9));  /* STATS */
     g_mainMenu.item[i].value = ITEM_NO_VALUE;
     g_mainMenu.item[i].type = VALUE_TYPE_INTEGER;
     sprintf(g_mainMenu.item[i].unit, "");
@@ -224,7 +213,7 @@ void initMenuItems() {
   }
 
   if (g_storedVar.lockMenuEnabled) {
-    sprintf(g_mainMenu.item[++i].name, "%s", getMenuName(lang, 10));  /* LOCK */
+    sprintf(g_mainMenu.item[++i].name, "%s", uiText(UI_TEXT_MENU, lang, 10));  /* LOCK */
     g_mainMenu.item[i].value = ITEM_NO_VALUE;
     g_mainMenu.item[i].type = VALUE_TYPE_INTEGER;
     sprintf(g_mainMenu.item[i].unit, "");
@@ -233,19 +222,12 @@ void initMenuItems() {
     g_mainMenu.item[i].callback = &toggleSettingsLock;
   }
 
-  sprintf(g_mainMenu.item[++i].name, "%s", getMenuName(lang, 11));  /* CAR or BIL */
-  g_mainMenu.item[i].value = (void *)&g_storedVar.carParam[g_carSel].carName;
+  sprintf(g_mainMenu.item[++i].name, "%s", uiText(UI_TEXT_MENU, lang, 11));  /* CAR or BIL */
+  g_mainMenu.item[i].value = (void *)&g_storedVar.activeCar.carName;
   g_mainMenu.item[i].type = VALUE_TYPE_STRING;
   g_mainMenu.item[i].maxValue = CAR_MAX_COUNT - 1;  // so menu will scroll in the array (CAR_MAX_COUNT long)
   g_mainMenu.item[i].minValue = 0;
   g_mainMenu.item[i].callback = &showSelectRenameCar;
-
-  /* Init Car selection menu items */
-  for (uint8_t j = 0; j < CAR_MAX_COUNT; j++)
-  {
-    sprintf(g_carMenu.item[j].name, (const char *)g_storedVar.carParam[j].carName);
-    g_carMenu.item[j].value = (void *)&g_storedVar.carParam[j].carNumber;
-  }
 }
 
 
@@ -256,7 +238,7 @@ void initSettingsMenuItems() {
   int i = 0;
   uint8_t lang = g_storedVar.language;
 
-  sprintf(g_settingsMenu.item[i].name, "%s", getSettingsMenuName(lang, 0));  /* POWER - opens submenu */
+  sprintf(g_settingsMenu.item[i].name, "%s", uiText(UI_TEXT_SETTINGS_MENU, lang, 0));  /* POWER - opens submenu */
   g_settingsMenu.item[i].value = ITEM_NO_VALUE;
   g_settingsMenu.item[i].type = VALUE_TYPE_INTEGER;
   sprintf(g_settingsMenu.item[i].unit, "");
@@ -264,7 +246,7 @@ void initSettingsMenuItems() {
   g_settingsMenu.item[i].minValue = 0;
   g_settingsMenu.item[i].callback = ITEM_NO_CALLBACK;
 
-  sprintf(g_settingsMenu.item[++i].name, "%s", getSettingsMenuName(lang, 1));  /* DISPLAY - opens submenu */
+  sprintf(g_settingsMenu.item[++i].name, "%s", uiText(UI_TEXT_SETTINGS_MENU, lang, 1));  /* DISPLAY - opens submenu */
   g_settingsMenu.item[i].value = ITEM_NO_VALUE;
   g_settingsMenu.item[i].type = VALUE_TYPE_INTEGER;
   sprintf(g_settingsMenu.item[i].unit, "");
@@ -272,7 +254,7 @@ void initSettingsMenuItems() {
   g_settingsMenu.item[i].minValue = 0;
   g_settingsMenu.item[i].callback = ITEM_NO_CALLBACK;
 
-  sprintf(g_settingsMenu.item[++i].name, "%s", getSettingsMenuName(lang, 2));  /* SOUND - opens submenu */
+  sprintf(g_settingsMenu.item[++i].name, "%s", uiText(UI_TEXT_SETTINGS_MENU, lang, 2));  /* SOUND - opens submenu */
   g_settingsMenu.item[i].value = ITEM_NO_VALUE;
   g_settingsMenu.item[i].type = VALUE_TYPE_INTEGER;
   sprintf(g_settingsMenu.item[i].unit, "");
@@ -280,7 +262,7 @@ void initSettingsMenuItems() {
   g_settingsMenu.item[i].minValue = 0;
   g_settingsMenu.item[i].callback = ITEM_NO_CALLBACK;
 
-  sprintf(g_settingsMenu.item[++i].name, "%s", getSettingsMenuName(lang, 3));  /* HARDWARE */
+  sprintf(g_settingsMenu.item[++i].name, "%s", uiText(UI_TEXT_SETTINGS_MENU, lang, 3));  /* HARDWARE */
   g_settingsMenu.item[i].value = ITEM_NO_VALUE;
   g_settingsMenu.item[i].type = VALUE_TYPE_INTEGER;
   sprintf(g_settingsMenu.item[i].unit, "");
@@ -288,7 +270,7 @@ void initSettingsMenuItems() {
   g_settingsMenu.item[i].minValue = 0;
   g_settingsMenu.item[i].callback = ITEM_NO_CALLBACK;
 
-  sprintf(g_settingsMenu.item[++i].name, "%s", getSettingsMenuName(lang, 4));  /* STATS */
+  sprintf(g_settingsMenu.item[++i].name, "%s", uiText(UI_TEXT_SETTINGS_MENU, lang, 4));  /* STATS */
   g_settingsMenu.item[i].value = (void *)&g_statsEnabled;
   g_settingsMenu.item[i].type = VALUE_TYPE_STRING;
   sprintf(g_settingsMenu.item[i].unit, "");
@@ -296,7 +278,7 @@ void initSettingsMenuItems() {
   g_settingsMenu.item[i].minValue = 0;
   g_settingsMenu.item[i].callback = ITEM_NO_CALLBACK;
 
-  sprintf(g_settingsMenu.item[++i].name, "%s", getSettingsMenuName(lang, 5));  /* WIFI */
+  sprintf(g_settingsMenu.item[++i].name, "%s", uiText(UI_TEXT_SETTINGS_MENU, lang, 5));  /* WIFI */
   g_settingsMenu.item[i].value = ITEM_NO_VALUE;
   g_settingsMenu.item[i].type = VALUE_TYPE_STRING;
   sprintf(g_settingsMenu.item[i].unit, "");
@@ -304,7 +286,7 @@ void initSettingsMenuItems() {
   g_settingsMenu.item[i].minValue = 0;
   g_settingsMenu.item[i].callback = ITEM_NO_CALLBACK;
 
-  sprintf(g_settingsMenu.item[++i].name, "%s", getSettingsMenuName(lang, 6));  /* LOGGING */
+  sprintf(g_settingsMenu.item[++i].name, "%s", uiText(UI_TEXT_SETTINGS_MENU, lang, 6));  /* LOGGING */
   g_settingsMenu.item[i].value = ITEM_NO_VALUE;
   g_settingsMenu.item[i].type = VALUE_TYPE_STRING;
   sprintf(g_settingsMenu.item[i].unit, "");
@@ -312,7 +294,7 @@ void initSettingsMenuItems() {
   g_settingsMenu.item[i].minValue = 0;
   g_settingsMenu.item[i].callback = ITEM_NO_CALLBACK;
 
-  sprintf(g_settingsMenu.item[++i].name, "%s", getSettingsMenuName(lang, 7));  /* LOCK - opens submenu */
+  sprintf(g_settingsMenu.item[++i].name, "%s", uiText(UI_TEXT_SETTINGS_MENU, lang, 7));  /* LOCK - opens submenu */
   g_settingsMenu.item[i].value = ITEM_NO_VALUE;
   g_settingsMenu.item[i].type = VALUE_TYPE_INTEGER;
   sprintf(g_settingsMenu.item[i].unit, "");
@@ -320,7 +302,7 @@ void initSettingsMenuItems() {
   g_settingsMenu.item[i].minValue = 0;
   g_settingsMenu.item[i].callback = ITEM_NO_CALLBACK;
 
-  sprintf(g_settingsMenu.item[++i].name, "%s", getSettingsMenuName(lang, 8));  /* USB */
+  sprintf(g_settingsMenu.item[++i].name, "%s", uiText(UI_TEXT_SETTINGS_MENU, lang, 8));  /* USB */
   g_settingsMenu.item[i].value = ITEM_NO_VALUE;
   g_settingsMenu.item[i].type = VALUE_TYPE_INTEGER;
   sprintf(g_settingsMenu.item[i].unit, "");
@@ -328,7 +310,7 @@ void initSettingsMenuItems() {
   g_settingsMenu.item[i].minValue = 0;
   g_settingsMenu.item[i].callback = ITEM_NO_CALLBACK;
 
-  sprintf(g_settingsMenu.item[++i].name, "%s", getSettingsMenuName(lang, 9));  /* RESET */
+  sprintf(g_settingsMenu.item[++i].name, "%s", uiText(UI_TEXT_SETTINGS_MENU, lang, 9));  /* RESET */
   g_settingsMenu.item[i].value = ITEM_NO_VALUE;
   g_settingsMenu.item[i].type = VALUE_TYPE_INTEGER;
   sprintf(g_settingsMenu.item[i].unit, "");
@@ -336,7 +318,7 @@ void initSettingsMenuItems() {
   g_settingsMenu.item[i].minValue = 0;
   g_settingsMenu.item[i].callback = ITEM_NO_CALLBACK;
 
-  sprintf(g_settingsMenu.item[++i].name, "%s", getSettingsMenuName(lang, 10));  /* ABOUT/INFO */
+  sprintf(g_settingsMenu.item[++i].name, "%s", uiText(UI_TEXT_SETTINGS_MENU, lang, 10));  /* ABOUT/INFO */
   g_settingsMenu.item[i].value = ITEM_NO_VALUE;
   g_settingsMenu.item[i].type = VALUE_TYPE_INTEGER;
   sprintf(g_settingsMenu.item[i].unit, "");
@@ -344,7 +326,7 @@ void initSettingsMenuItems() {
   g_settingsMenu.item[i].minValue = 0;
   g_settingsMenu.item[i].callback = ITEM_NO_CALLBACK;
 
-  sprintf(g_settingsMenu.item[++i].name, "%s", getSettingsMenuName(lang, 11));  /* BACK */
+  sprintf(g_settingsMenu.item[++i].name, "%s", uiText(UI_TEXT_SETTINGS_MENU, lang, 11));  /* BACK */
   g_settingsMenu.item[i].value = ITEM_NO_VALUE;
   g_settingsMenu.item[i].type = VALUE_TYPE_STRING;
   sprintf(g_settingsMenu.item[i].unit, "");
@@ -357,7 +339,7 @@ void initDisplayMenuItems() {
   int i = 0;
   uint8_t lang = g_storedVar.language;
 
-  sprintf(g_settingsMenu.item[i].name, "%s", getDisplayMenuName(lang, 0));  /* VIEW */
+  sprintf(g_settingsMenu.item[i].name, "%s", uiText(UI_TEXT_DISPLAY_MENU, lang, 0));  /* VIEW */
   g_settingsMenu.item[i].value = (void *)&g_storedVar.raceViewMode;
   g_settingsMenu.item[i].type = VALUE_TYPE_STRING;
   sprintf(g_settingsMenu.item[i].unit, "");
@@ -365,7 +347,7 @@ void initDisplayMenuItems() {
   g_settingsMenu.item[i].minValue = RACE_VIEW_OFF;
   g_settingsMenu.item[i].callback = ITEM_NO_CALLBACK;
 
-  sprintf(g_settingsMenu.item[++i].name, "%s", getDisplayMenuName(lang, 1));  /* LANG */
+  sprintf(g_settingsMenu.item[++i].name, "%s", uiText(UI_TEXT_DISPLAY_MENU, lang, 1));  /* LANG */
   g_settingsMenu.item[i].value = (void *)&g_storedVar.language;
   g_settingsMenu.item[i].type = VALUE_TYPE_STRING;
   sprintf(g_settingsMenu.item[i].unit, "");
@@ -373,7 +355,7 @@ void initDisplayMenuItems() {
   g_settingsMenu.item[i].minValue = LANG_NOR;
   g_settingsMenu.item[i].callback = ITEM_NO_CALLBACK;
 
-  sprintf(g_settingsMenu.item[++i].name, "%s", getDisplayMenuName(lang, 2));  /* CASE */
+  sprintf(g_settingsMenu.item[++i].name, "%s", uiText(UI_TEXT_DISPLAY_MENU, lang, 2));  /* CASE */
   g_settingsMenu.item[i].value = (void *)&g_storedVar.textCase;
   g_settingsMenu.item[i].type = VALUE_TYPE_STRING;
   sprintf(g_settingsMenu.item[i].unit, "");
@@ -381,7 +363,7 @@ void initDisplayMenuItems() {
   g_settingsMenu.item[i].minValue = TEXT_CASE_UPPER;
   g_settingsMenu.item[i].callback = ITEM_NO_CALLBACK;
 
-  sprintf(g_settingsMenu.item[++i].name, "%s", getDisplayMenuName(lang, 3));  /* FSIZE */
+  sprintf(g_settingsMenu.item[++i].name, "%s", uiText(UI_TEXT_DISPLAY_MENU, lang, 3));  /* FSIZE */
   g_settingsMenu.item[i].value = (void *)&g_storedVar.listFontSize;
   g_settingsMenu.item[i].type = VALUE_TYPE_STRING;
   sprintf(g_settingsMenu.item[i].unit, "");
@@ -389,7 +371,7 @@ void initDisplayMenuItems() {
   g_settingsMenu.item[i].minValue = FONT_SIZE_LARGE;
   g_settingsMenu.item[i].callback = ITEM_NO_CALLBACK;
 
-  sprintf(g_settingsMenu.item[++i].name, "%s", getDisplayMenuName(lang, 4));  /* ANTISPIN - opens submenu */
+  sprintf(g_settingsMenu.item[++i].name, "%s", uiText(UI_TEXT_DISPLAY_MENU, lang, 4));  /* ANTISPIN - opens submenu */
   g_settingsMenu.item[i].value = ITEM_NO_VALUE;
   g_settingsMenu.item[i].type = VALUE_TYPE_INTEGER;
   sprintf(g_settingsMenu.item[i].unit, "");
@@ -397,7 +379,7 @@ void initDisplayMenuItems() {
   g_settingsMenu.item[i].minValue = 0;
   g_settingsMenu.item[i].callback = ITEM_NO_CALLBACK;
 
-  sprintf(g_settingsMenu.item[++i].name, "%s", getDisplayMenuName(lang, 5));  /* STATUS - opens submenu */
+  sprintf(g_settingsMenu.item[++i].name, "%s", uiText(UI_TEXT_DISPLAY_MENU, lang, 5));  /* STATUS - opens submenu */
   g_settingsMenu.item[i].value = ITEM_NO_VALUE;
   g_settingsMenu.item[i].type = VALUE_TYPE_INTEGER;
   sprintf(g_settingsMenu.item[i].unit, "");
@@ -405,7 +387,7 @@ void initDisplayMenuItems() {
   g_settingsMenu.item[i].minValue = 0;
   g_settingsMenu.item[i].callback = ITEM_NO_CALLBACK;
 
-  sprintf(g_settingsMenu.item[++i].name, "%s", getDisplayMenuName(lang, 6));  /* BACK */
+  sprintf(g_settingsMenu.item[++i].name, "%s", uiText(UI_TEXT_DISPLAY_MENU, lang, 6));  /* BACK */
   g_settingsMenu.item[i].value = ITEM_NO_VALUE;
   g_settingsMenu.item[i].type = VALUE_TYPE_STRING;
   sprintf(g_settingsMenu.item[i].unit, "");
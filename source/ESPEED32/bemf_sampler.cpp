@@ -0,0 +1,193 @@
+#include "bemf_sampler.h"
+#include <Arduino.h>
+#include <WiFi.h>
+#include <driver/gpio.h>
+#include <soc/gpio_periph.h>
+#include "HAL.h"
+
+static hw_timer_t* g_bemfSyncTimer = NULL;
+static TaskHandle_t g_bemfSamplerTask = NULL;
+static volatile uint32_t g_bemfPwmPeriod_us = 0;
+static volatile uint32_t g_bemfOffTime_us = 0;
+static volatile uint16_t g_bemfInhPermille = 0; /* INH high time: duty + drag */
+
+static volatile uint16_t g_bemfRaw_mV = 0;
+static volatile uint16_t g_bemfFiltered_mV = 0;
+static volatile uint32_t g_bemfSampleMs = 0;
+static volatile bool g_bemfSynced = false;
+static volatile bool g_bemfHasSample = false;
+static volatile bool g_bemfRadioOn = false;     /* ADC2 unavailable, sampling paused */
+static uint32_t g_bemfFilter_x16 = 0;         /* Task-owned EMA state, 1/16 mV */
+static uint32_t g_bemfSyncedCount = 0;
+static uint32_t g_bemfCoastCount = 0;
+static uint32_t g_bemfMissedCount = 0;
+static uint32_t g_bemfRadioBlockedCount = 0;
+
+static void bemfSamplerUpdateOffTime() {
+  uint32_t inhOn_us = (g_bemfPwmPeriod_us * g_bemfInhPermille) / 1000U;
+  g_bemfOffTime_us = (g_bemfPwmPeriod_us > inhOn_us) ? (g_bemfPwmPeriod_us - inhOn_us) : 0;
+}
+
+/* INH fell: the output floats until the period ends. Sample as late as the conversion allows. */
+static void IRAM_ATTR bemfSamplerEdgeISR(void* arg) {
+  (void)arg;
+  uint32_t offTime_us = g_bemfOffTime_us;
+  if (offTime_us < BEMF_SYNC_MIN_OFF_US) {
+    return;
+  }
+  gpio_intr_disable((gpio_num_t)HB_INH_PIN);
+  timerWrite(g_bemfSyncTimer, 0);
+  timerAlarm(g_bemfSyncTimer, offTime_us - BEMF_SYNC_LATENCY_US - BEMF_SYNC_CONVERSION_US, false, 0);
+}
+
+static void IRAM_ATTR bemfSamplerAlarmISR() {
+  BaseType_t higherPriorityTaskWoken = pdFALSE;
+  vTaskNotifyGiveFromISR(g_bemfSamplerTask, &higherPriorityTaskWoken);
+  portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+static void bemfSamplerPublish(uint16_t raw_mV, bool synced) {
+  uint32_t now = millis();
+  /* A gap longer than the stale limit means the old filter state says nothing about now */
+  if (!g_bemfHasSample || (uint32_t)(now - g_bemfSampleMs) > BEMF_STALE_MS) {
+    g_bemfFilter_x16 = (uint32_t)raw_mV << 4;
+  } else {
+    int32_t delta = ((int32_t)raw_mV << 4) - (int32_t)g_bemfFilter_x16;
+    g_bemfFilter_x16 = (uint32_t)((int32_t)g_bemfFilter_x16 + delta / (1 << BEMF_FILTER_SHIFT));
+  }
+  g_bemfRaw_mV = raw_mV;
+  g_bemfFiltered_mV = (uint16_t)(g_bemfFilter_x16 >> 4);
+  g_bemfSynced = synced;
+  g_bemfSampleMs = now;
+  g_bemfHasSample = true;
+  if (synced) {
+    g_bemfSyncedCount++;
+  } else {
+    g_bemfCoastCount++;
+  }
+}
+
+static void bemfSamplerTaskcode(void *pvParameters) {
+  (void)pvParameters;
+  for (;;) {
+    g_bemfRadioOn = (WiFi.getMode() != WIFI_OFF);
+    if (g_bemfRadioOn) {
+      g_bemfRadioBlockedCount++;
+      vTaskDelay(pdMS_TO_TICKS(BEMF_SYNC_TIMEOUT_MS));
+      continue;
+    }
+
+    ulTaskNotifyTake(pdTRUE, 0);  /* Drop an alarm left over from a timed-out cycle */
+    gpio_intr_enable((gpio_num_t)HB_INH_PIN);
+    bool synced = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(BEMF_SYNC_TIMEOUT_MS)) > 0;
+    if (!synced) {
+      gpio_intr_disable((gpio_num_t)HB_INH_PIN);
+    }
+    /* The alarm (if any) fired inside an off-window; free-running reads are only back-EMF
+       while the bridge is not driven at all */
+    if (synced || g_bemfInhPermille == 0) {
+      bemfSamplerPublish(HAL_ReadVoltageDivider(AN_MOT_BEMF, BEMF_RFBL, BEMF_RFBH), synced);
+    } else {
+      g_bemfMissedCount++;
+    }
+    vTaskDelay(1);  /* One sample per RTOS tick is plenty for a speed estimate */
+  }
+}
+
+/**
+ * @brief Route INH edges to the sampler and start the sampler task
+ * @details INH stays driven by LEDC; only its input buffer is enabled so the GPIO
+ *          interrupt sees the pad level.
+ * @return true if back-EMF sampling is running
+ */
+bool bemfSamplerStart() {
+  if (g_bemfSamplerTask != NULL) {
+    return true;
+  }
+
+  bemfSamplerSetPwmFrequency(ledcReadFreq(HB_INH_PIN));
+
+  g_bemfSyncTimer = timerBegin(BEMF_SYNC_TIMER_HZ);
+  if (g_bemfSyncTimer == NULL) {
+    return false;
+  }
+  timerAttachInterrupt(g_bemfSyncTimer, &bemfSamplerAlarmISR);
+
+  BaseType_t ok = xTaskCreatePinnedToCore(
+    bemfSamplerTaskcode,
+    "BemfSampler",
+    BEMF_SAMPLER_STACK_SIZE,
+    NULL,
+    BEMF_SAMPLER_TASK_PRIORITY,
+    &g_bemfSamplerTask,
+    BEMF_SAMPLER_TASK_CORE);
+  if (ok != pdPASS) {
+    g_bemfSamplerTask = NULL;
+    timerEnd(g_bemfSyncTimer);
+    g_bemfSyncTimer = NULL;
+    return false;
+  }
+
+  gpio_install_isr_service(0);  /* May already be installed by attachInterrupt(); that is fine */
+  gpio_set_intr_type((gpio_num_t)HB_INH_PIN, GPIO_INTR_NEGEDGE);
+  gpio_isr_handler_add((gpio_num_t)HB_INH_PIN, bemfSamplerEdgeISR, NULL);
+  return true;
+}
+
+/**
+ * @brief Track the motor PWM frequency
+ * @details Call after every frequency change. Any ledcAttachChannel() on HB_INH_PIN reconfigures the pad
+ *          as output-only, so the input buffer needed for the edge interrupt is re-enabled here too.
+ */
+void bemfSamplerSetPwmFrequency(uint32_t freq_hz) {
+  g_bemfPwmPeriod_us = (freq_hz > 0) ? (1000000UL / freq_hz) : 0;
+  bemfSamplerUpdateOffTime();
+  PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[HB_INH_PIN]);
+}
+
+/**
+ * @brief Track the INH duty in permille (called from HalfBridge_SetPwmDragPermille())
+ */
+void bemfSamplerSetDuty(uint16_t duty_permille, uint16_t drag_permille) {
+  uint16_t duty = (uint16_t)constrain(duty_permille, 0, 1000);
+  uint16_t drag = (uint16_t)constrain(drag_permille, 0, 1000);
+  g_bemfInhPermille = min((uint16_t)(duty + drag), (uint16_t)1000U);
+  bemfSamplerUpdateOffTime();
+}
+
+/**
+ * @brief Load the latest back-EMF estimate
+ * @return false if the sampler is not running or its last reading is older than BEMF_STALE_MS
+ */
+bool bemfSamplerGetLatest(BemfSample_type* outSample) {
+  if (outSample == nullptr || g_bemfSamplerTask == NULL || !g_bemfHasSample) {
+    return false;
+  }
+  outSample->raw_mV = g_bemfRaw_mV;
+  outSample->filtered_mV = g_bemfFiltered_mV;
+  outSample->timestamp_ms = g_bemfSampleMs;
+  outSample->synced = g_bemfSynced;
+  return (uint32_t)(millis() - outSample->timestamp_ms) <= BEMF_STALE_MS;
+}
+
+/**
+ * @brief True while samples can be taken at all (task running, ADC2 not held by WiFi)
+ * @details A running sampler may still report no estimate for a while when the duty
+ *          leaves no off-window; that is not "unavailable".
+ */
+bool bemfSamplerAvailable() {
+  return g_bemfSamplerTask != NULL && !g_bemfRadioOn;
+}
+
+void bemfSamplerGetStats(BemfSamplerStats_type* outStats) {
+  if (outStats == nullptr) {
+    return;
+  }
+  outStats->syncedSamples = g_bemfSyncedCount;
+  outStats->coastSamples = g_bemfCoastCount;
+  outStats->missedWindows = g_bemfMissedCount;
+  outStats->radioBlocked = g_bemfRadioBlockedCount;
+  outStats->pwmPeriod_us = g_bemfPwmPeriod_us;
+  outStats->offTime_us = g_bemfOffTime_us;
+  outStats->running = g_bemfSamplerTask != NULL;
+}
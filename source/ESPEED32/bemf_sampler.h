@@ -0,0 +1,71 @@
+#ifndef BEMF_SAMPLER_H_
+#define BEMF_SAMPLER_H_
+
+#include <stdint.h>
+
+/* PWM-synchronized motor back-EMF sampling on AN_MOT_BEMF.
+ * set_pwm_drag_permille() drives INH for duty + drag of every period; after its falling edge
+ * the bridge output floats until the next period, the motor current decays through the body
+ * diodes and the terminal voltage settles to the back-EMF. The falling edge of HB_INH_PIN
+ * arms a one-shot hardware timer that fires shortly before the period ends (longest settle
+ * time), the sampler task then reads the divider. With no drive at all the output floats
+ * permanently and a free-running read is used; without a long enough off-window (high duty
+ * or drag) no sample is taken and the estimate goes stale.
+ * AN_MOT_BEMF is an ADC2 pin: ADC2 is owned by the radio while WiFi is on, so sampling
+ * pauses during portal sessions. */
+#define BEMF_SAMPLER_TASK_PRIORITY     3       /* Same as CurSampler: both are short, edge-driven reads */
+#define BEMF_SAMPLER_TASK_CORE         0
+#define BEMF_SAMPLER_STACK_SIZE        3072
+#define BEMF_SYNC_TIMER_HZ             1000000UL  /* 1 MHz -> alarm value in µs */
+#ifndef BEMF_SYNC_LATENCY_US
+#define BEMF_SYNC_LATENCY_US           8U      /* [µs] Edge ISR + alarm ISR + task wake before the ADC samples */
+#endif
+#ifndef BEMF_SYNC_CONVERSION_US
+#define BEMF_SYNC_CONVERSION_US        12U     /* [µs] One-shot conversion, must end before INH rises again */
+#endif
+#ifndef BEMF_SYNC_SETTLE_US
+#define BEMF_SYNC_SETTLE_US            20U     /* [µs] Minimum time for the freewheel current to decay */
+#endif
+#define BEMF_SYNC_MIN_OFF_US           (BEMF_SYNC_SETTLE_US + BEMF_SYNC_LATENCY_US + BEMF_SYNC_CONVERSION_US)
+#define BEMF_SYNC_TIMEOUT_MS           5U      /* No off-window edge within this time -> coast read or no sample */
+#define BEMF_STALE_MS                  50U     /* Older estimates are ignored by readers */
+#ifndef BEMF_FILTER_SHIFT
+#define BEMF_FILTER_SHIFT              3       /* EMA weight 1/8 per sample (~8 ms at one sample per tick) */
+#endif
+
+/* Motor voltage divider on AN_MOT_BEMF; defaults to the same values as the VIN divider */
+#ifndef BEMF_RFBL
+#define BEMF_RFBL                      RVIFBL   /* [Ohm] Lower resistor */
+#endif
+#ifndef BEMF_RFBH
+#define BEMF_RFBH                      RVIFBH   /* [Ohm] Upper resistor */
+#endif
+
+/**
+ * @brief Latest back-EMF estimate
+ */
+typedef struct {
+  uint16_t raw_mV;        /* [mV] Last reading */
+  uint16_t filtered_mV;   /* [mV] EMA over the recent readings */
+  uint32_t timestamp_ms;  /* millis() of the last reading */
+  bool synced;            /* true = taken at the end of an off-window, false = coast read */
+} BemfSample_type;
+
+typedef struct {
+  uint32_t syncedSamples;
+  uint32_t coastSamples;
+  uint32_t missedWindows;   /* Timeouts while driving without a usable off-window */
+  uint32_t radioBlocked;    /* Reads skipped because WiFi owns ADC2 */
+  uint32_t pwmPeriod_us;
+  uint32_t offTime_us;
+  bool running;
+} BemfSamplerStats_type;
+
+bool bemfSamplerStart();
+void bemfSamplerSetPwmFrequency(uint32_t freq_hz);
+void bemfSamplerSetDuty(uint16_t duty_permille, uint16_t drag_permille);
+bool bemfSamplerGetLatest(BemfSample_type* outSample);
+bool bemfSamplerAvailable();
+void bemfSamplerGetStats(BemfSamplerStats_type* outStats);
+
+#endif  /* BEMF_SAMPLER_H_ */
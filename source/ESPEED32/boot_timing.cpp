@@ -0,0 +1,50 @@
+#include "boot_timing.h"
+#include <Arduino.h>
+#include <esp_system.h>
+#include <esp_timer.h>
+
+static const char* const BOOT_STAGE_NAMES[BOOT_STAGE_COUNT] = {"setup", "hw", "settings", "drive", "ui"};
+
+/* Each stage is written once (first mark wins) and may be marked from any task */
+static volatile uint32_t g_bootStage_us[BOOT_STAGE_COUNT] = {0};
+
+/**
+ * @brief Record the time a boot stage was reached (first call per stage only)
+ */
+void bootTimingMark(BootStage_enum stage) {
+  if (stage >= BOOT_STAGE_COUNT || g_bootStage_us[stage] != 0) {
+    return;
+  }
+  uint32_t now_us = (uint32_t)esp_timer_get_time();
+  g_bootStage_us[stage] = (now_us != 0) ? now_us : 1U;
+}
+
+void bootTimingGet(BootTiming_type* out) {
+  if (out == nullptr) {
+    return;
+  }
+  for (uint8_t i = 0; i < BOOT_STAGE_COUNT; i++) {
+    out->stage_us[i] = g_bootStage_us[i];
+  }
+  out->resetReason = (uint8_t)esp_reset_reason();
+}
+
+/**
+ * @brief Print the boot stages, e.g. "BOOT reset=15 setup=312us hw=48210us ... drive=61877us"
+ */
+void bootTimingLog() {
+  Serial.print("BOOT reset=");
+  Serial.print((unsigned)esp_reset_reason());
+  for (uint8_t i = 0; i < BOOT_STAGE_COUNT; i++) {
+    Serial.print(' ');
+    Serial.print(BOOT_STAGE_NAMES[i]);
+    Serial.print('=');
+    if (g_bootStage_us[i] == 0) {
+      Serial.print("--");
+    } else {
+      Serial.print((unsigned long)g_bootStage_us[i]);
+      Serial.print("us");
+    }
+  }
+  Serial.println();
+}
@@ -0,0 +1,31 @@
+#ifndef BOOT_TIMING_H_
+#define BOOT_TIMING_H_
+
+#include <stdint.h>
+
+/* Boot-to-drive timing.
+ * Boot is staged so the car drives as early as possible after a reset (e.g. a brown-out
+ * mid-race): setup() brings up the sensor (cached TLE493D variant/address first) and the
+ * half bridge, Task1 loads the stored settings and publishes the selected car, and the
+ * control task starts driving right then. The OLED, encoder, boot sound and
+ * WiFi auto-start follow; SPIFFS and the web server only come up with WiFi.
+ * Times are from esp_timer start (app start; the ROM/2nd-stage bootloader comes before it). */
+typedef enum {
+  BOOT_STAGE_SETUP,      /* setup() entered */
+  BOOT_STAGE_HW,         /* Trigger sensor, half bridge and PWM configured */
+  BOOT_STAGE_SETTINGS,   /* Stored settings loaded and the selected car published */
+  BOOT_STAGE_DRIVE,      /* First control tick driving the bridge from a fresh trigger sample */
+  BOOT_STAGE_UI,         /* OLED and encoder ready */
+  BOOT_STAGE_COUNT
+} BootStage_enum;
+
+typedef struct {
+  uint32_t stage_us[BOOT_STAGE_COUNT];  /* 0 = not reached (yet) */
+  uint8_t resetReason;                  /* esp_reset_reason_t of this boot */
+} BootTiming_type;
+
+void bootTimingMark(BootStage_enum stage);
+void bootTimingGet(BootTiming_type* out);
+void bootTimingLog();
+
+#endif  /* BOOT_TIMING_H_ */
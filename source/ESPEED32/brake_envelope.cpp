@@ -0,0 +1,55 @@
+#include "brake_envelope.h"
+#include <Arduino.h>
+
+/* (1 - e^(-3x)) / (1 - e^(-3)) at x = i / BRAKE_ENVELOPE_SEGMENTS, in BRAKE_ENVELOPE_SHAPE_ONE units */
+static const uint16_t BRAKE_ENVELOPE_SHAPE[BRAKE_ENVELOPE_SEGMENTS + 1] = {
+      0,  1579,  3086,  4524,  5896,  7205,  8454,  9646,
+  10784, 11869, 12905, 13893, 14836, 15736, 16594, 17414,
+  18195, 18941, 19653, 20332, 20980, 21599, 22189, 22752,
+  23289, 23802, 24291, 24758, 25203, 25628, 26034, 26421,
+  26790, 27143, 27479, 27800, 28106, 28398, 28677, 28943,
+  29196, 29439, 29670, 29890, 30101, 30301, 30493, 30676,
+  30850, 31017, 31175, 31327, 31472, 31610, 31741, 31867,
+  31987, 32101, 32210, 32315, 32414, 32509, 32599, 32686,
+  32768,
+};
+
+/**
+ * @brief Fill the envelope of a car (Task1, while building the active tuning)
+ * @details Only assigns members, so a zeroed destination keeps its padding for memcmp().
+ */
+void brakeEnvelopePrepare(const CarParam_type* car, BrakeEnvelope_type* out) {
+  uint16_t hold_ms = min(car->brakeBiteHold, (uint16_t)BRAKE_BITE_HOLD_MAX);
+  uint16_t ramp_ms = min(car->brakeRamp, (uint16_t)BRAKE_RAMP_MAX);
+  out->enabled = (hold_ms > 0) || (ramp_ms > 0);
+  out->bite_permille = min(car->brakeBite, (uint16_t)BRAKE_BITE_MAX) * 10U;
+  out->hold_us = (uint32_t)hold_ms * 1000U;
+  out->ramp_us = (uint32_t)ramp_ms * 1000U;
+  out->rampScale = (ramp_ms > 0) ? (BRAKE_ENVELOPE_SEGMENTS << 16) / out->ramp_us : 0U;
+}
+
+/**
+ * @brief Brake level at elapsed_us after the trigger reached 0 (control loop)
+ * @param target_permille [0.1%] Level the envelope settles at (the effective BRAKE)
+ * @return [0.1%] Drag level for this tick
+ */
+uint16_t brakeEnvelopeLevel(const BrakeEnvelope_type* env, uint16_t target_permille, uint32_t elapsed_us) {
+  if (!env->enabled) {
+    return target_permille;
+  }
+  if (elapsed_us < env->hold_us) {
+    return env->bite_permille;
+  }
+  uint32_t t_us = elapsed_us - env->hold_us;
+  if (t_us >= env->ramp_us) {
+    return target_permille;
+  }
+
+  /* t_us < ramp_us keeps pos below BRAKE_ENVELOPE_SEGMENTS << 16 */
+  uint32_t pos = t_us * env->rampScale;
+  uint32_t index = pos >> 16;
+  uint32_t shape = BRAKE_ENVELOPE_SHAPE[index] +
+                   (((uint32_t)(BRAKE_ENVELOPE_SHAPE[index + 1] - BRAKE_ENVELOPE_SHAPE[index]) * (pos & 0xFFFFU)) >> 16);
+  int32_t span = (int32_t)target_permille - (int32_t)env->bite_permille;
+  return (uint16_t)((int32_t)env->bite_permille + (span * (int32_t)shape) / (int32_t)BRAKE_ENVELOPE_SHAPE_ONE);
+}
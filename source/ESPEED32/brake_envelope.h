@@ -0,0 +1,33 @@
+#ifndef BRAKE_ENVELOPE_H_
+#define BRAKE_ENVELOPE_H_
+
+#include <stdint.h>
+#include "slot_ESC.h"
+
+/* Brake envelope: a time-shaped brake instead of one static BRAKE level at trigger release.
+ * When the trigger reaches 0 the brake starts at the car's BITE level, holds it for
+ * brakeBiteHold ms, then moves to the BRAKE level (after the ext-pot override) over
+ * brakeRamp ms along a fixed exponential (time constant brakeRamp / 3, normalised to finish
+ * exactly at brakeRamp). A bite above BRAKE stops hard and then eases off before the motor
+ * locks; a bite below it softens the first contact. Hold and ramp both 0 = static BRAKE.
+ * Task1 turns the car fields into a BrakeEnvelope_type inside the active tuning snapshot
+ * (including the per-car time scale), so the control loop only does a table lookup and two
+ * multiplies per tick. The alternate (button) brake is always static. */
+#define BRAKE_ENVELOPE_SEGMENTS   64U   /* Shape table intervals; the table has one more entry */
+#define BRAKE_ENVELOPE_SHAPE_ONE  32768U
+
+/**
+ * @brief Per-tick form of the car's envelope fields
+ */
+typedef struct {
+  bool enabled;              /* Hold or ramp set */
+  uint16_t bite_permille;    /* [0.1%] Level from the trigger release until the hold ends */
+  uint32_t hold_us;
+  uint32_t ramp_us;
+  uint32_t rampScale;        /* BRAKE_ENVELOPE_SEGMENTS in Q16 per µs of ramp */
+} BrakeEnvelope_type;
+
+void brakeEnvelopePrepare(const CarParam_type* car, BrakeEnvelope_type* out);
+uint16_t brakeEnvelopeLevel(const BrakeEnvelope_type* env, uint16_t target_permille, uint32_t elapsed_us);
+
+#endif  /* BRAKE_ENVELOPE_H_ */
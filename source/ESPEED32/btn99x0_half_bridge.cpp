@@ -111,12 +111,11 @@ void HalfBridge::set_pwm(uint8_t duty)
  */
 void HalfBridge::set_pwm_in_percentage(uint8_t duty_in_pct)
 {
-    uint8_t duty8bit;
+    uint32_t maxDuty = HAL_GetMotorPwmMaxDuty();
     if((duty_in_pct <= 100) & (duty_in_pct >= 0))
     {
-      duty8bit = duty_in_pct*255/100;
-      HALanalogWrite(THR_IN_PWM_CHAN, duty8bit);
-      HALanalogWrite(THR_INH_PWM_CHAN, 255);
+      HALanalogWrite(THR_IN_PWM_CHAN, (uint32_t)duty_in_pct * maxDuty / 100);
+      HALanalogWrite(THR_INH_PWM_CHAN, maxDuty);
     };
 }
 
@@ -128,12 +127,11 @@ void HalfBridge::set_pwm_in_percentage(uint8_t duty_in_pct)
  */
 void HalfBridge::set_pwm_inh_percentage(uint8_t duty_in_pct)
 {
-  uint8_t duty8bit;
+  uint32_t maxDuty = HAL_GetMotorPwmMaxDuty();
   if((duty_in_pct <= 100) & (duty_in_pct >= 0))
   {
-    duty8bit = duty_in_pct*255/100;
-    HALanalogWrite(THR_IN_PWM_CHAN, 255);
-    HALanalogWrite(THR_INH_PWM_CHAN, duty8bit);
+    HALanalogWrite(THR_IN_PWM_CHAN, maxDuty);
+    HALanalogWrite(THR_INH_PWM_CHAN, (uint32_t)duty_in_pct * maxDuty / 100);
   };
 }
 
@@ -147,22 +145,36 @@ void HalfBridge::set_pwm_inh_percentage(uint8_t duty_in_pct)
  */
 void HalfBridge::set_pwm_drag(uint8_t duty_in_pct, uint8_t drag_pct)
 {
-  uint16_t drag8bit,duty8bit,inh8bit;
-  
-  duty_in_pct = constrain(duty_in_pct,0,100); // limit in put parameters to 0-100[%]
-  drag_pct = constrain(drag_pct,0,100);
-  
-  duty8bit = ((uint16_t)duty_in_pct*255 )/100;
+  set_pwm_drag_permille((uint16_t)duty_in_pct * 10, (uint16_t)drag_pct * 10);
+}
+
+/**
+ * @brief       Same as set_pwm_drag() with duty and drag in permille
+ * @details     Converted to counts at the resolution the motor PWM channels are attached with
+ *              (HAL_AttachMotorPwm()), so sub-percent steps reach the output.
+ * @param[in]   duty_permille Duty cycle from 0 to 1000
+ * @param[in]   drag_permille Drag (low side on after the high side phase) from 0 to 1000
+ * @pre         None
+ */
+void HalfBridge::set_pwm_drag_permille(uint16_t duty_permille, uint16_t drag_permille)
+{
+  uint32_t maxDuty = HAL_GetMotorPwmMaxDuty();
+  uint32_t dutyCounts, dragCounts, inhCounts;
+
+  duty_permille = constrain(duty_permille, 0, 1000); // limit in put parameters to 0-1000[permille]
+  drag_permille = constrain(drag_permille, 0, 1000);
+
+  dutyCounts = ((uint32_t)duty_permille * maxDuty) / 1000;
 
-  drag8bit = ((uint16_t)drag_pct*255 )/100;
+  dragCounts = ((uint32_t)drag_permille * maxDuty) / 1000;
 
-  inh8bit = (duty8bit + drag8bit);          //HBridge enable has to last for the high side on phase+ drag (where Low side will be activated)
-  
-  inh8bit = constrain(inh8bit,0,255);
+  inhCounts = dutyCounts + dragCounts;      //HBridge enable has to last for the high side on phase+ drag (where Low side will be activated)
 
-  HALanalogWrite(THR_IN_PWM_CHAN, duty8bit);
+  inhCounts = min(inhCounts, maxDuty);
 
-  HALanalogWrite(THR_INH_PWM_CHAN, inh8bit);
+  HALanalogWrite(THR_IN_PWM_CHAN, dutyCounts);
+
+  HALanalogWrite(THR_INH_PWM_CHAN, inhCounts);
 
 }
 
@@ -305,6 +317,32 @@ double HalfBridge::get_temperature_in_kelvin()
     return chip_temperature;
 }
 
+/**
+ * @brief       Drives the temperature sense condition through the PWM channels
+ * @details     Same pin state as get_temperature_in_kelvin() (INH low, IN high) without
+ *              leaving PWM mode: the LEDC duty registers latch at the next period, so the
+ *              IS pin shows the temperature current one PWM period plus the settling time later.
+ *              The output floats meanwhile; the next set_pwm_drag*() call resumes driving.
+ * @pre         begin()
+ */
+void HalfBridge::set_pwm_temperature_sense()
+{
+    HALanalogWrite(THR_IN_PWM_CHAN, HAL_GetMotorPwmMaxDuty());
+    HALanalogWrite(THR_INH_PWM_CHAN, 0);
+}
+
+/**
+ * @brief       Gets the device temperature in kelvin from an IS reading taken elsewhere
+ * @details     For readings taken while set_pwm_temperature_sense() is in effect
+ * @param[in]   adc_raw Raw ADC value of the current sense input
+ * @return      Temperature in kelvin
+ * @pre         None
+ */
+double HalfBridge::get_temperature_in_kelvin_from_adc(uint16_t adc_raw)
+{
+    return calculate_current_at_sense_resistor_in_amps(adc_raw)/exp_const.ktis_amps_per_kelvin;
+}
+
 /**
  * @brief       Set the inhibit pin to the given value
  * @details     Convenience function to store the actual value
@@ -324,9 +362,20 @@ void HalfBridge::set_inhibit_pin(uint8_t value)
  * @pre         None
  */
 double HalfBridge::calculate_current_at_sense_resistor_in_amps()
+{
+    return calculate_current_at_sense_resistor_in_amps(analogRead(io_pins.analog));
+}
+
+/**
+ * @brief       Calculates the current at the sense resistor in amperes from a raw ADC value
+ * @param[in]   adc_raw Raw ADC value of the current sense input
+ * @return      Current in amperes
+ * @pre         None
+ */
+double HalfBridge::calculate_current_at_sense_resistor_in_amps(uint16_t adc_raw)
 {
     double adc_volts_per_step = (hw_conf.adc_voltage_range_volts/hw_conf.adc_resolution_steps);
-    double voltage_sense_resistor_volts = analogRead(io_pins.analog)*adc_volts_per_step;
+    double voltage_sense_resistor_volts = adc_raw*adc_volts_per_step;
 
     return voltage_sense_resistor_volts/hw_conf.sense_current_resistor_ohms;
 }
@@ -36,6 +36,7 @@ namespace btn99x0
             void set_pwm_in_percentage(uint8_t duty_in_pct);
             void set_pwm_inh_percentage(uint8_t duty_in_pct);
             void set_pwm_drag(uint8_t duty_in_pct,uint8_t drag_pct);
+            void set_pwm_drag_permille(uint16_t duty_permille, uint16_t drag_permille);
             
             uint16_t set_slew_rate(slew_rate_level_t sr_level);
             /* Experimental value setting */
@@ -46,6 +47,8 @@ namespace btn99x0
             /* Diagnosis */
             double get_load_current_in_amps();
             double get_temperature_in_kelvin();
+            void set_pwm_temperature_sense();
+            double get_temperature_in_kelvin_from_adc(uint16_t adc_raw);
             uint16_t get_diagnosis();
 
         private:
@@ -63,6 +66,7 @@ namespace btn99x0
             void set_inhibit_pin(uint8_t value);
 
             double calculate_current_at_sense_resistor_in_amps();
+            double calculate_current_at_sense_resistor_in_amps(uint16_t adc_raw);
             void calculate_sense_resistor_offset_current();
             ic_experimental_const_t get_typical_experimental_constants(ic_variant_t ic_variant);
 
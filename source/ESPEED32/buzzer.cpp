@@ -0,0 +1,92 @@
+#include "buzzer.h"
+#include <string.h>
+#include "HAL.h"
+
+typedef struct {
+  uint8_t count;
+  BuzzerStep_type steps[BUZZER_MAX_STEPS];
+} BuzzerPattern_type;
+
+static QueueHandle_t g_buzzQueue = NULL;   /* Length 1: the latest pattern wins */
+static TaskHandle_t g_buzzTask = NULL;
+
+static void buzzerOutput(note_t note) {
+  if (note == BUZZER_REST) {
+    ledcWrite(BUZZ_PIN, 0);
+  } else {
+    ledcWriteNote(BUZZ_PIN, note, BUZZER_OCTAVE);
+  }
+}
+
+static void buzzerTaskcode(void* pvParameters) {
+  (void)pvParameters;
+  BuzzerPattern_type pattern = {0, {}};
+  uint8_t next = 0;
+  for (;;) {
+    TickType_t wait = portMAX_DELAY;
+    if (next < pattern.count) {
+      const BuzzerStep_type& step = pattern.steps[next++];
+      buzzerOutput(step.note);
+      wait = max(pdMS_TO_TICKS(step.ms), (TickType_t)1);
+    } else {
+      buzzerOutput(BUZZER_REST);
+    }
+    if (xQueueReceive(g_buzzQueue, &pattern, wait) == pdTRUE) {
+      next = 0;   /* Pre-empt whatever was playing */
+    }
+  }
+}
+
+/**
+ * @brief Attach the buzzer channel and start the sequencer task
+ * @details Without the task, buzzerPlay() falls back to playing in the caller.
+ */
+bool buzzerBegin() {
+  if (g_buzzTask != NULL) {
+    return true;
+  }
+  ledcAttachChannel(BUZZ_PIN, 5000, 8, BUZZ_CHAN);
+  ledcWrite(BUZZ_PIN, 0);
+  g_buzzQueue = xQueueCreate(1, sizeof(BuzzerPattern_type));
+  if (g_buzzQueue == NULL) {
+    return false;
+  }
+  BaseType_t ok = xTaskCreatePinnedToCore(
+    buzzerTaskcode,
+    "Buzzer",
+    BUZZER_STACK_SIZE,
+    NULL,
+    BUZZER_TASK_PRIORITY,
+    &g_buzzTask,
+    BUZZER_TASK_CORE);
+  if (ok != pdPASS) {
+    g_buzzTask = NULL;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Play a pattern, replacing any cue still playing; returns immediately
+ * @param count Steps beyond BUZZER_MAX_STEPS are dropped
+ */
+void buzzerPlay(const BuzzerStep_type* steps, uint8_t count) {
+  BuzzerPattern_type pattern;
+  pattern.count = min(count, (uint8_t)BUZZER_MAX_STEPS);
+  if (pattern.count > 0) {
+    memcpy(pattern.steps, steps, pattern.count * sizeof(BuzzerStep_type));
+  }
+  if (g_buzzTask == NULL) {
+    for (uint8_t i = 0; i < pattern.count; i++) {
+      buzzerOutput(pattern.steps[i].note);
+      delay(pattern.steps[i].ms);
+    }
+    buzzerOutput(BUZZER_REST);
+    return;
+  }
+  xQueueOverwrite(g_buzzQueue, &pattern);
+}
+
+void buzzerStop() {
+  buzzerPlay(NULL, 0);
+}
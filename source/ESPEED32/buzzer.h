@@ -0,0 +1,29 @@
+#ifndef BUZZER_H_
+#define BUZZER_H_
+
+#include <Arduino.h>
+#include <stdint.h>
+
+/* Non-blocking buzzer sequencer.
+ * buzzerPlay() hands a note pattern to a small task and returns at once, so a beep no
+ * longer stops Task1 (and the WiFiTask time-sliced with it) for the length of the cue.
+ * The task times each step with its queue wait: a new pattern overwrites the pending one
+ * and pre-empts the cue that is playing. BUZZ_CHAN stays attached from buzzerBegin() on and
+ * is silenced with a zero duty between notes instead of being detached. */
+#define BUZZER_MAX_STEPS       8
+#define BUZZER_REST            NOTE_MAX   /* Silent step */
+#define BUZZER_OCTAVE          7
+#define BUZZER_TASK_PRIORITY   2          /* Above Task1/WiFiTask so note lengths hold */
+#define BUZZER_TASK_CORE       0
+#define BUZZER_STACK_SIZE      2048
+
+typedef struct {
+  note_t note;     /* BUZZER_REST for a pause */
+  uint16_t ms;
+} BuzzerStep_type;
+
+bool buzzerBegin();
+void buzzerPlay(const BuzzerStep_type* steps, uint8_t count);
+void buzzerStop();
+
+#endif  /* BUZZER_H_ */
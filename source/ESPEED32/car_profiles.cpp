@@ -0,0 +1,215 @@
+#include "car_profiles.h"
+#include <Arduino.h>
+#include <string.h>
+#include "settings_store.h"
+
+extern StoredVar_type g_storedVar;
+
+typedef struct {
+  uint16_t index;           /* CAR_PROFILE_NONE: free */
+  bool stored;              /* false: defaults, no blob in flash */
+  uint32_t lastUse;
+  CarParam_type car;
+} CarProfileSlot_type;
+
+static portMUX_TYPE g_profileMux = portMUX_INITIALIZER_UNLOCKED;
+static CarProfileSlot_type g_profileCache[CAR_PROFILE_CACHE_SLOTS];
+static bool g_profileCacheInit = false;
+static uint32_t g_profileUseClock = 0;
+static uint32_t g_profileWriteSeq = 0;    /* Bumped by every write: a slower reader must not cache over it */
+
+/* Task1 only */
+static CarParam_type g_profileLoaded;     /* Active profile as it was paged in */
+static bool g_profileLoadedValid = false;
+
+/* Call with g_profileMux held */
+static void carProfileCacheInitLocked() {
+  if (g_profileCacheInit) {
+    return;
+  }
+  for (uint8_t i = 0; i < CAR_PROFILE_CACHE_SLOTS; i++) {
+    g_profileCache[i].index = CAR_PROFILE_NONE;
+  }
+  g_profileCacheInit = true;
+}
+
+/* Call with g_profileMux held */
+static void carProfileCachePutLocked(uint16_t index, const CarParam_type* car, bool stored) {
+  carProfileCacheInitLocked();
+  CarProfileSlot_type* slot = &g_profileCache[0];
+  for (uint8_t i = 0; i < CAR_PROFILE_CACHE_SLOTS; i++) {
+    if (g_profileCache[i].index == index) {
+      slot = &g_profileCache[i];
+      break;
+    }
+    if (g_profileCache[i].index == CAR_PROFILE_NONE ||
+        (slot->index != CAR_PROFILE_NONE && g_profileCache[i].lastUse < slot->lastUse)) {
+      slot = &g_profileCache[i];
+    }
+  }
+  slot->index = index;
+  slot->stored = stored;
+  slot->lastUse = ++g_profileUseClock;
+  slot->car = *car;
+}
+
+void carProfileDefaults(uint16_t index, CarParam_type* out) {
+  memset(out, 0, sizeof(*out));
+  out->minSpeed = MIN_SPEED_DEFAULT;
+  out->brake = BRAKE_DEFAULT;
+  out->maxSpeed = MAX_SPEED_DEFAULT;
+  out->throttleCurveVertex = { THROTTLE_CURVE_INPUT_THROTTLE_DEFAULT, THROTTLE_CURVE_SPEED_DIFF_DEFAULT };
+  out->fade = FADE_DEFAULT;
+  out->antiSpin = ANTISPIN_DEFAULT;
+  out->freqPWM = PWM_FREQ_DEFAULT;
+  out->brakeButtonReduction = BRAKE_BUTTON_REDUCTION_DEFAULT;
+  out->quickBrakeEnabled = QUICK_BRAKE_ENABLED_DEFAULT;
+  out->quickBrakeThreshold = QUICK_BRAKE_THRESHOLD_DEFAULT;
+  out->quickBrakeStrength = QUICK_BRAKE_STRENGTH_DEFAULT;
+  out->antiSpinMode = ANTISPIN_MODE_DEFAULT;
+  out->brakeBite = BRAKE_BITE_DEFAULT;
+  out->brakeBiteHold = BRAKE_BITE_HOLD_DEFAULT;
+  out->brakeRamp = BRAKE_RAMP_DEFAULT;
+  /* "CAR10".."CAR99" fill all CAR_NAME_MAX_SIZE chars, as they always have; the zeroed
+     padding after carName terminates them */
+  char name[8];
+  snprintf(name, sizeof(name), (index < 100) ? "CAR%u" : "C%u", (unsigned)index);
+  memcpy(out->carName, name, min(strlen(name), (size_t)CAR_NAME_MAX_SIZE));
+  out->carNumber = index;
+}
+
+/**
+ * @brief Copy of a profile: active, cached, queued, in flash, or its defaults
+ * @return false if the profile was never saved (out holds its defaults)
+ */
+bool carProfileRead(uint16_t index, CarParam_type* out) {
+  if (index >= CAR_MAX_COUNT) {
+    carProfileDefaults(0, out);
+    return false;
+  }
+  if (index == g_storedVar.activeCar.carNumber) {
+    *out = g_storedVar.activeCar;
+    return true;
+  }
+
+  portENTER_CRITICAL(&g_profileMux);
+  carProfileCacheInitLocked();
+  for (uint8_t i = 0; i < CAR_PROFILE_CACHE_SLOTS; i++) {
+    if (g_profileCache[i].index == index) {
+      g_profileCache[i].lastUse = ++g_profileUseClock;
+      *out = g_profileCache[i].car;
+      bool stored = g_profileCache[i].stored;
+      portEXIT_CRITICAL(&g_profileMux);
+      return stored;
+    }
+  }
+  uint32_t seq = g_profileWriteSeq;
+  portEXIT_CRITICAL(&g_profileMux);
+
+  bool stored = settingsStoreReadCar(index, out);
+  if (!stored) {
+    carProfileDefaults(index, out);
+  }
+  out->carNumber = index;
+
+  portENTER_CRITICAL(&g_profileMux);
+  if (seq == g_profileWriteSeq) {
+    carProfileCachePutLocked(index, out, stored);
+  }
+  portEXIT_CRITICAL(&g_profileMux);
+  return stored;
+}
+
+/**
+ * @brief Store a profile; an inactive one is queued for flash right away
+ */
+void carProfileWrite(uint16_t index, const CarParam_type* in) {
+  if (index >= CAR_MAX_COUNT) {
+    return;
+  }
+  CarParam_type car = *in;
+  car.carNumber = index;
+  if (index == g_storedVar.activeCar.carNumber) {
+    g_storedVar.activeCar = car;
+    return;
+  }
+  portENTER_CRITICAL(&g_profileMux);
+  g_profileWriteSeq++;
+  carProfileCachePutLocked(index, &car, true);
+  portEXIT_CRITICAL(&g_profileMux);
+  settingsStoreRequestCar(index, &car);
+}
+
+/**
+ * @brief NUL-terminated name of a profile (names may fill all CAR_NAME_MAX_SIZE chars)
+ */
+void carProfileGetName(uint16_t index, char* out, size_t outSize) {
+  if (outSize == 0) {
+    return;
+  }
+  CarParam_type car;
+  carProfileRead(index, &car);
+  size_t len = strnlen(car.carName, CAR_NAME_MAX_SIZE);
+  if (len >= outSize) {
+    len = outSize - 1;
+  }
+  memcpy(out, car.carName, len);
+  out[len] = '\0';
+}
+
+/**
+ * @brief Page the selected profile into g_storedVar.activeCar (Task1)
+ * @return true if the active profile changed
+ */
+bool carProfileSelect(uint16_t index) {
+  if (index >= CAR_MAX_COUNT) {
+    index = 0;
+  }
+  CarParam_type* active = &g_storedVar.activeCar;
+  if (active->carNumber == index) {
+    if (!g_profileLoadedValid) {
+      g_profileLoaded = *active;
+      g_profileLoadedValid = true;
+    }
+    return false;
+  }
+
+  uint16_t previous = active->carNumber;
+  if (previous < CAR_MAX_COUNT) {
+    CarParam_type outgoing = *active;
+    bool edited = !g_profileLoadedValid || memcmp(&g_profileLoaded, &outgoing, sizeof(outgoing)) != 0;
+    portENTER_CRITICAL(&g_profileMux);
+    g_profileWriteSeq++;
+    carProfileCachePutLocked(previous, &outgoing, true);  /* Switching back is free */
+    portEXIT_CRITICAL(&g_profileMux);
+    if (edited) {
+      settingsStoreRequestCar(previous, &outgoing);
+    }
+  }
+
+  CarParam_type incoming;
+  carProfileRead(index, &incoming);  /* activeCar still holds previous, so this goes to cache/flash */
+  *active = incoming;
+  g_profileLoaded = incoming;
+  g_profileLoadedValid = true;
+  return true;
+}
+
+/**
+ * @brief Reset every profile to its defaults: all blobs are dropped, the active one is rewritten
+ *        by the next saveEEPROM()
+ */
+void carProfileResetAll() {
+  portENTER_CRITICAL(&g_profileMux);
+  carProfileCacheInitLocked();
+  for (uint8_t i = 0; i < CAR_PROFILE_CACHE_SLOTS; i++) {
+    g_profileCache[i].index = CAR_PROFILE_NONE;
+  }
+  g_profileWriteSeq++;
+  portEXIT_CRITICAL(&g_profileMux);
+  settingsStoreRequestCarErase();
+
+  uint16_t index = (g_storedVar.activeCar.carNumber < CAR_MAX_COUNT) ? g_storedVar.activeCar.carNumber : 0;
+  carProfileDefaults(index, &g_storedVar.activeCar);
+  g_profileLoadedValid = false;
+}
@@ -0,0 +1,33 @@
+#ifndef CAR_PROFILES_H_
+#define CAR_PROFILES_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "slot_ESC.h"
+
+/* Paged car profiles.
+ * Only the selected profile lives in RAM (g_storedVar.activeCar, carNumber = its index), so
+ * StoredVar_type no longer grows with CAR_MAX_COUNT. The others stay in their own NVS blob
+ * (settings_store.h) and are fetched when needed:
+ *   - carProfileRead() serves the active profile from g_storedVar, the others from an LRU
+ *     cache of CAR_PROFILE_CACHE_SLOTS copies, then from the store (queued writes first,
+ *     then flash). A profile that was never saved reads as carProfileDefaults()
+ *   - carProfileWrite() of an inactive profile updates the cache and queues that one blob.
+ *     The active one is written in place and goes out with the next saveEEPROM(); outside
+ *     Task1 publish it with activeTuningReplaceStoredVar() instead
+ *   - carProfileSelect() (Task1, when selectedCarNumber changes) queues the outgoing profile
+ *     if it was edited and pages the new one into g_storedVar.activeCar
+ * NVS is read outside the cache lock; not for use from Task2. */
+#ifndef CAR_PROFILE_CACHE_SLOTS
+#define CAR_PROFILE_CACHE_SLOTS  6U
+#endif
+#define CAR_PROFILE_NONE         0xFFFFU
+
+void carProfileDefaults(uint16_t index, CarParam_type* out);
+bool carProfileRead(uint16_t index, CarParam_type* out);
+void carProfileWrite(uint16_t index, const CarParam_type* in);
+void carProfileGetName(uint16_t index, char* out, size_t outSize);
+bool carProfileSelect(uint16_t index);
+void carProfileResetAll();
+
+#endif  /* CAR_PROFILES_H_ */
@@ -2,11 +2,44 @@
 #include "slot_ESC.h"
 #include "HAL.h"
 #include "telemetry_logging.h"
+#include "telemetry_frame.h"
+#include "telemetry_stream.h"
+#include "task_monitor.h"
+#include "live_push.h"
+#include "portal_transfer.h"
+#include "gzip_stream.h"
+#include "oled_screen_cache.h"
+#include "json_scan.h"
+#include "json_stream.h"
+#include "json_writer.h"
+#include "static_assets.h"
+#include "ota_pipeline.h"
+#include "task_control_loop.h"
+#include "perf_probe.h"
+#include "throttle_lut.h"
+#include "trigger_lut.h"
+#include "ext_pot.h"
+#include "active_tuning.h"
+#include "adc_sampler.h"
+#include "current_sampler.h"
+#include "thermal_model.h"
+#include "power_governor.h"
+#include "boot_timing.h"
+#include "settings_store.h"
+#include "car_profiles.h"
+#include "lap_engine.h"
+#include "race_link.h"
+#include "telemetry_session_log.h"
+#include "telemetry_pyramid.h"
+#include "trigger_replay.h"
+#include "scheduler_profile.h"
+#include "latency_bench.h"
 #include <FS.h>
 #include <SPIFFS.h>
 #include <Update.h>
 #include <esp_mac.h>
 #include <esp_random.h>
+#include <esp_rom_crc.h>
 #include <esp_wifi.h>
 #include <ESPmDNS.h>
 #include <Preferences.h>
@@ -28,7 +61,6 @@ extern void saveEEPROM(StoredVar_type toSave);
 
 /* Web server instance (heap-allocated only when active) */
 static WebServer* g_wifiServer = nullptr;
-static String g_uploadBuffer;
 static char g_wifiSuffix[5] = "";  /* MAC-based suffix, e.g. "A3B4" */
 static char g_wifiHostName[18] = "";
 static bool g_spiffsMounted = false;
@@ -43,6 +75,12 @@ static uint16_t g_wifiConfiguredMode = WIFI_CONFIG_AP;
 static uint8_t g_wifiActiveMode = WIFI_PORTAL_OFF;
 static bool g_wifiApFallbackActive = false;
 static wl_status_t g_wifiLastConnectStatus = WL_IDLE_STATUS;
+static volatile uint8_t g_wifiStaState = WIFI_STA_IDLE;
+static uint8_t g_wifiStaAttempt = 0;
+static uint32_t g_wifiStaAttemptAtMs = 0;
+static bool g_wifiStaEventsRegistered = false;
+static uint8_t g_wifiStaCachedBssid[6] = {0};
+static uint8_t g_wifiStaCachedChannel = 0;  /* 0: nothing cached */
 static char g_wifiClientSsid[WIFI_STA_SSID_MAX_LEN + 1] = "";
 static char g_wifiClientPassword[WIFI_STA_PASS_MAX_LEN + 1] = "";
 static const size_t UI_AUTH_USER_MAX_LEN = 31;
@@ -51,15 +89,20 @@ static char g_uiAuthUsername[UI_AUTH_USER_MAX_LEN + 1] = "espeed32";
 static char g_uiAuthPassword[UI_AUTH_PASS_MAX_LEN + 1] = "";
 static char g_wifiConnectedSsid[WIFI_STA_SSID_MAX_LEN + 1] = "";
 static uint8_t g_backupSecret[32] = {0};
+static uint8_t g_telemetryFrameBuf[TELEMETRY_FRAME_MAX_SIZE];  /* Binary live frame (HTTP + serial) */
+static char g_telemetryFrameBase64[((TELEMETRY_FRAME_MAX_SIZE + 2U) / 3U) * 4U + 1U];
 
 static const char* PREF_KEY_WIFI_MODE = "wifi_mode_v1";
 static const char* PREF_KEY_WIFI_STA_SSID = "wifi_sta_ssid";
 static const char* PREF_KEY_WIFI_STA_PASS = "wifi_sta_pass";
+static const char* PREF_KEY_WIFI_STA_BSSID = "wifi_sta_bssid";
+static const char* PREF_KEY_WIFI_STA_CHAN = "wifi_sta_chan";
 static const char* PREF_KEY_UI_AUTH_USER = "ui_auth_user";
 static const char* PREF_KEY_UI_AUTH_PASS = "ui_auth_pass";
 static const char* PREF_KEY_WIFI_BACKUP_SECRET = "wifi_bkp_sec";
 static const char* PREF_KEY_OTA_WIFI_BOOT = "ota_wifi_boot";
-static const uint32_t WIFI_STA_CONNECT_TIMEOUT_MS = 8000UL;
+static const uint32_t WIFI_STA_CONNECT_TIMEOUT_MS = 8000UL;  /* Per attempt */
+static const uint8_t WIFI_STA_CONNECT_ATTEMPTS = 2;            /* The first one uses the cached BSSID */
 static const size_t WIFI_BACKUP_SECRET_LEN = 32;
 static const size_t WIFI_BACKUP_SECRET_HEX_LEN = WIFI_BACKUP_SECRET_LEN * 2;
 static const size_t WIFI_BACKUP_NONCE_LEN = 12;
@@ -75,13 +118,14 @@ static bool readMacAddress(esp_mac_type_t type, uint8_t out[6]) {
 
 static void serviceUsbSerialCommands();
 static void appendJsonEscaped(String& out, const char* in);
-static String buildTelemetryStatusPayload(const char* message);
-static String buildTelemetryLivePayload(uint32_t afterSeq, size_t limit);
-static String buildTelemetryConfigSnapshotJson();
-static String buildInfoJson();
+static void sendInfoReply(bool toSerial);
+static void sendTelemetryStatusReply(const char* message, bool toSerial);
+static void sendTelemetryLiveReply(uint32_t afterSeq, size_t limit, bool toSerial);
+static void sendTelemetryConfigReply(bool toSerial);
+static String buildPerfJson();
 static void sendSerialLengthPrefixedPayload(const String& payload);
 static const char* getBackupReleaseModeName(uint16_t mode);
-static bool parseJsonStr(const String& json, const char* key, char* outStr, int maxLen);
+static bool parseJsonStr(const JsonScanObject_type& doc, const char* key, char* outStr, int maxLen);
 static void copyBoundedString(char* out, size_t outLen, const char* in);
 static bool otaRequestWantsRestart();
 static void clearOtaDeferredRestartState();
@@ -165,9 +209,13 @@ static bool readSpiffsRelease(char* out, size_t outLen) {
     SPIFFS.end();
   }
 
+  JsonScanObject_type manifestDoc;
   char release[16];
-  if (parseJsonStr(json, "spiffsRelease", release, sizeof(release)) ||
-      parseJsonStr(json, "release", release, sizeof(release))) {
+  if (!jsonScanObject(json.c_str(), json.length(), &manifestDoc)) {
+    return false;
+  }
+  if (parseJsonStr(manifestDoc, "spiffsRelease", release, sizeof(release)) ||
+      parseJsonStr(manifestDoc, "release", release, sizeof(release))) {
     copyBoundedString(out, outLen, release);
     return release[0] != '\0';
   }
@@ -246,6 +294,10 @@ static void loadWiFiNetworkSettingsIfNeeded() {
     String authPass = pref.getString(PREF_KEY_UI_AUTH_PASS, "");
     ssid.toCharArray(g_wifiClientSsid, sizeof(g_wifiClientSsid));
     pass.toCharArray(g_wifiClientPassword, sizeof(g_wifiClientPassword));
+    g_wifiStaCachedChannel = 0;
+    if (pref.getBytes(PREF_KEY_WIFI_STA_BSSID, g_wifiStaCachedBssid, sizeof(g_wifiStaCachedBssid)) == sizeof(g_wifiStaCachedBssid)) {
+      g_wifiStaCachedChannel = pref.getUChar(PREF_KEY_WIFI_STA_CHAN, 0);
+    }
     getDefaultUiAuthUsername(g_uiAuthUsername, sizeof(g_uiAuthUsername));
     authPass.toCharArray(g_uiAuthPassword, sizeof(g_uiAuthPassword));
     getLegacyUiAuthPassword4(legacyDefault4, sizeof(legacyDefault4));
@@ -266,6 +318,36 @@ static void loadWiFiNetworkSettingsIfNeeded() {
   g_wifiConfigLoaded = true;
 }
 
+static void writeWiFiPrefStringIfChanged(Preferences& pref, const char* key, const char* value) {
+  if (pref.isKey(key) && pref.getString(key, "") == value) {
+    return;
+  }
+  pref.putString(key, value);
+}
+
+/**
+ * @brief Persist the BSSID/channel of the last association, or drop them when nothing is cached
+ */
+static void writeWiFiStaCacheIfChanged(Preferences& pref) {
+  if (g_wifiStaCachedChannel == 0) {
+    if (pref.isKey(PREF_KEY_WIFI_STA_BSSID)) {
+      pref.remove(PREF_KEY_WIFI_STA_BSSID);
+    }
+    if (pref.isKey(PREF_KEY_WIFI_STA_CHAN)) {
+      pref.remove(PREF_KEY_WIFI_STA_CHAN);
+    }
+    return;
+  }
+  uint8_t storedBssid[6] = {0};
+  if (pref.getBytes(PREF_KEY_WIFI_STA_BSSID, storedBssid, sizeof(storedBssid)) != sizeof(storedBssid) ||
+      memcmp(storedBssid, g_wifiStaCachedBssid, sizeof(storedBssid)) != 0) {
+    pref.putBytes(PREF_KEY_WIFI_STA_BSSID, g_wifiStaCachedBssid, sizeof(g_wifiStaCachedBssid));
+  }
+  if (!pref.isKey(PREF_KEY_WIFI_STA_CHAN) || pref.getUChar(PREF_KEY_WIFI_STA_CHAN) != g_wifiStaCachedChannel) {
+    pref.putUChar(PREF_KEY_WIFI_STA_CHAN, g_wifiStaCachedChannel);
+  }
+}
+
 static void writeWiFiNetworkSettingsToPrefs() {
   loadWiFiNetworkSettingsIfNeeded();
 
@@ -273,11 +355,18 @@ static void writeWiFiNetworkSettingsToPrefs() {
   if (!pref.begin("stored_var", false)) {
     return;
   }
-  pref.putUChar(PREF_KEY_WIFI_MODE, (uint8_t)((g_wifiConfiguredMode == WIFI_CONFIG_HOME) ? WIFI_CONFIG_HOME : WIFI_CONFIG_AP));
-  pref.putString(PREF_KEY_WIFI_STA_SSID, g_wifiClientSsid);
-  pref.putString(PREF_KEY_WIFI_STA_PASS, g_wifiClientPassword);
-  pref.remove(PREF_KEY_UI_AUTH_USER);
-  pref.putString(PREF_KEY_UI_AUTH_PASS, g_uiAuthPassword);
+  /* Called on every settings save: only write what actually changed */
+  uint8_t mode = (uint8_t)((g_wifiConfiguredMode == WIFI_CONFIG_HOME) ? WIFI_CONFIG_HOME : WIFI_CONFIG_AP);
+  if (!pref.isKey(PREF_KEY_WIFI_MODE) || pref.getUChar(PREF_KEY_WIFI_MODE) != mode) {
+    pref.putUChar(PREF_KEY_WIFI_MODE, mode);
+  }
+  writeWiFiPrefStringIfChanged(pref, PREF_KEY_WIFI_STA_SSID, g_wifiClientSsid);
+  writeWiFiPrefStringIfChanged(pref, PREF_KEY_WIFI_STA_PASS, g_wifiClientPassword);
+  if (pref.isKey(PREF_KEY_UI_AUTH_USER)) {
+    pref.remove(PREF_KEY_UI_AUTH_USER);
+  }
+  writeWiFiPrefStringIfChanged(pref, PREF_KEY_UI_AUTH_PASS, g_uiAuthPassword);
+  writeWiFiStaCacheIfChanged(pref);
   pref.end();
 }
 
@@ -502,7 +591,7 @@ static bool encryptBackupWiFiPassword(const char* password, const char* backupCo
          encodeBase64(cipher, passwordLen, cipherB64, cipherB64Len);
 }
 
-static bool decryptBackupWiFiPasswordFromJson(const String& json, char* outPassword,
+static bool decryptBackupWiFiPasswordFromJson(const JsonScanObject_type& doc, char* outPassword,
                                               size_t outPasswordLen, String* errorMsg) {
   if (outPassword == nullptr || outPasswordLen == 0 || errorMsg == nullptr) {
     return false;
@@ -515,7 +604,7 @@ static bool decryptBackupWiFiPasswordFromJson(const String& json, char* outPassw
   char cipherB64[WIFI_BACKUP_PASS_B64_MAX_LEN + 1];
   getBackupControllerId(currentControllerId, sizeof(currentControllerId));
 
-  if (!parseJsonStr(json, "backupControllerId", backupControllerId, sizeof(backupControllerId)) ||
+  if (!parseJsonStr(doc, "backupControllerId", backupControllerId, sizeof(backupControllerId)) ||
       backupControllerId[0] == '\0') {
     *errorMsg = "Error: encrypted Client WiFi password is missing backupControllerId";
     return false;
@@ -524,9 +613,9 @@ static bool decryptBackupWiFiPasswordFromJson(const String& json, char* outPassw
     *errorMsg = "Error: encrypted Client WiFi password belongs to another controller";
     return false;
   }
-  if (!parseJsonStr(json, "wifiStaPasswordNonce", nonceB64, sizeof(nonceB64)) ||
-      !parseJsonStr(json, "wifiStaPasswordTag", tagB64, sizeof(tagB64)) ||
-      !parseJsonStr(json, "wifiStaPasswordEnc", cipherB64, sizeof(cipherB64))) {
+  if (!parseJsonStr(doc, "wifiStaPasswordNonce", nonceB64, sizeof(nonceB64)) ||
+      !parseJsonStr(doc, "wifiStaPasswordTag", tagB64, sizeof(tagB64)) ||
+      !parseJsonStr(doc, "wifiStaPasswordEnc", cipherB64, sizeof(cipherB64))) {
     *errorMsg = "Error: encrypted Client WiFi password is missing crypto fields";
     return false;
   }
@@ -576,7 +665,7 @@ static bool decryptBackupWiFiPasswordFromJson(const String& json, char* outPassw
   return true;
 }
 
-static bool decryptBackupUiAuthPasswordFromJson(const String& json, char* outPassword,
+static bool decryptBackupUiAuthPasswordFromJson(const JsonScanObject_type& doc, char* outPassword,
                                                 size_t outPasswordLen, String* errorMsg) {
   if (outPassword == nullptr || outPasswordLen == 0 || errorMsg == nullptr) {
     return false;
@@ -589,7 +678,7 @@ static bool decryptBackupUiAuthPasswordFromJson(const String& json, char* outPas
   char cipherB64[WIFI_BACKUP_PASS_B64_MAX_LEN + 1];
   getBackupControllerId(currentControllerId, sizeof(currentControllerId));
 
-  if (!parseJsonStr(json, "backupControllerId", backupControllerId, sizeof(backupControllerId)) ||
+  if (!parseJsonStr(doc, "backupControllerId", backupControllerId, sizeof(backupControllerId)) ||
       backupControllerId[0] == '\0') {
     *errorMsg = "Error: encrypted UI auth password is missing backupControllerId";
     return false;
@@ -598,9 +687,9 @@ static bool decryptBackupUiAuthPasswordFromJson(const String& json, char* outPas
     *errorMsg = "Error: encrypted UI auth password belongs to another controller";
     return false;
   }
-  if (!parseJsonStr(json, "uiAuthPasswordNonce", nonceB64, sizeof(nonceB64)) ||
-      !parseJsonStr(json, "uiAuthPasswordTag", tagB64, sizeof(tagB64)) ||
-      !parseJsonStr(json, "uiAuthPasswordEnc", cipherB64, sizeof(cipherB64))) {
+  if (!parseJsonStr(doc, "uiAuthPasswordNonce", nonceB64, sizeof(nonceB64)) ||
+      !parseJsonStr(doc, "uiAuthPasswordTag", tagB64, sizeof(tagB64)) ||
+      !parseJsonStr(doc, "uiAuthPasswordEnc", cipherB64, sizeof(cipherB64))) {
     *errorMsg = "Error: encrypted UI auth password is missing crypto fields";
     return false;
   }
@@ -773,171 +862,253 @@ a{color:#7ed6ff}
 
 
 /**
- * @brief Build JSON backup string from the provided configuration snapshot.
+ * @brief Response body producer; runs twice for serial replies (length pass + send pass)
+ */
+typedef void (*PortalJsonBody_fn)(JsonWriter_type* w, const void* arg);
+
+typedef struct {
+  size_t remaining;  /* Bytes still owed against the announced length */
+} SerialJsonSink_type;
+
+static void httpJsonSink(void* ctx, const char* data, size_t len) {
+  (void)ctx;
+  g_wifiServer->sendContent(data, len);
+}
+
+static void serialJsonSink(void* ctx, const char* data, size_t len) {
+  SerialJsonSink_type* sink = (SerialJsonSink_type*)ctx;
+  if (len > sink->remaining) {
+    len = sink->remaining;  /* Never overrun the length prefix, or the host loses framing */
+  }
+  Serial.write((const uint8_t*)data, len);
+  sink->remaining -= len;
+}
+
+static void stringJsonSink(void* ctx, const char* data, size_t len) {
+  ((String*)ctx)->concat(data, (unsigned int)len);
+}
+
+/**
+ * @brief Stream a JSON response with chunked transfer encoding
+ */
+static void sendHttpJson(int code, PortalJsonBody_fn body, const void* arg) {
+  JsonWriter_type w;
+  g_wifiServer->setContentLength(CONTENT_LENGTH_UNKNOWN);
+  g_wifiServer->send(code, "application/json", "");
+  jsonWriterBegin(&w, httpJsonSink, nullptr);
+  body(&w, arg);
+  jsonWriterEnd(&w);
+  g_wifiServer->sendContent("");
+}
+
+/**
+ * @brief Stream a JSON reply with the serial "<length>\n<payload>" framing
+ * @details The body runs once to count and once to send. If it comes out shorter the second
+ *          time (a setting changed in between) the rest is padded with spaces, which JSON allows.
+ */
+static void sendSerialJson(PortalJsonBody_fn body, const void* arg) {
+  JsonWriter_type w;
+  jsonWriterBegin(&w, nullptr, nullptr);
+  body(&w, arg);
+  size_t len = jsonWriterEnd(&w);
+
+  Serial.print(len);
+  Serial.print('\n');
+  SerialJsonSink_type sink = {len};
+  jsonWriterBegin(&w, serialJsonSink, &sink);
+  body(&w, arg);
+  jsonWriterEnd(&w);
+  while (sink.remaining > 0) {
+    Serial.write(' ');
+    sink.remaining--;
+  }
+  Serial.flush();
+}
+
+static void sendPortalJson(bool toSerial, PortalJsonBody_fn body, const void* arg) {
+  if (toSerial) {
+    sendSerialJson(body, arg);
+  } else {
+    sendHttpJson(200, body, arg);
+  }
+}
+
+/**
+ * @brief Write the JSON backup of the provided configuration snapshot.
  */
-static String buildJsonBackupFromConfig(const StoredVar_type& storedVar,
-                                        uint16_t antiSpinStepMs,
-                                        uint16_t antiSpinStepPct,
-                                        uint16_t antiSpinDisplayMode,
-                                        uint16_t encoderInvertEnabled,
-                                        uint16_t adcVoltageRange_mV,
-                                        uint16_t wifiConfiguredMode,
-                                        const char* wifiClientSsid,
-                                        const char* wifiClientPassword,
-                                        const char* uiAuthPassword) {
+static void writeJsonBackupFromConfig(JsonWriter_type* w,
+                                      const StoredVar_type& storedVar,
+                                      uint16_t antiSpinStepMs,
+                                      uint16_t antiSpinStepPct,
+                                      uint16_t antiSpinDisplayMode,
+                                      uint16_t encoderInvertEnabled,
+                                      uint16_t adcVoltageRange_mV,
+                                      uint16_t wifiConfiguredMode,
+                                      const char* wifiClientSsid,
+                                      const char* wifiClientPassword,
+                                      const char* uiAuthPassword) {
   (void)wifiClientPassword;
   (void)uiAuthPassword;
-  String json;
-  json.reserve(6000);
-  char buf[128];
   char backupControllerId[13];
 
   getBackupControllerId(backupControllerId, sizeof(backupControllerId));
-  json += "{\n";
-  json += "  \"schemaVersion\": 1,\n";
-  sprintf(buf, "  \"version\": %d,\n", STORED_VAR_VERSION);              json += buf;
-  sprintf(buf, "  \"selectedCarNumber\": %u,\n", storedVar.selectedCarNumber); json += buf;
-  sprintf(buf, "  \"minTrigger_raw\": %d,\n", storedVar.minTrigger_raw); json += buf;
-  sprintf(buf, "  \"maxTrigger_raw\": %d,\n", storedVar.maxTrigger_raw); json += buf;
-  sprintf(buf, "  \"viewMode\": %u,\n", storedVar.viewMode);           json += buf;
-  sprintf(buf, "  \"screensaverTimeout\": %u,\n", storedVar.screensaverTimeout); json += buf;
-  sprintf(buf, "  \"soundBoot\": %u,\n", storedVar.soundBoot);         json += buf;
-  sprintf(buf, "  \"soundRace\": %u,\n", storedVar.soundRace);         json += buf;
-  sprintf(buf, "  \"antiSpinStep\": %u,\n", antiSpinStepMs);           json += buf; /* legacy alias for ms-step */
-  sprintf(buf, "  \"antiSpinStepMs\": %u,\n", antiSpinStepMs);         json += buf;
-  sprintf(buf, "  \"antiSpinStepPct\": %u,\n", antiSpinStepPct);       json += buf;
-  sprintf(buf, "  \"antiSpinDisplayMode\": %u,\n", antiSpinDisplayMode); json += buf;
-  sprintf(buf, "  \"encoderInvert\": %u,\n", encoderInvertEnabled ? 1 : 0); json += buf;
-  sprintf(buf, "  \"adcVoltageRangeMv\": %u,\n", adcVoltageRange_mV);  json += buf;
-  sprintf(buf, "  \"gridCarSelectEnabled\": %u,\n", storedVar.gridCarSelectEnabled); json += buf;
-  sprintf(buf, "  \"raceViewMode\": %u,\n", storedVar.raceViewMode);   json += buf;
-  sprintf(buf, "  \"language\": %u,\n", storedVar.language);           json += buf;
-  sprintf(buf, "  \"textCase\": %u,\n", storedVar.textCase);           json += buf;
-  sprintf(buf, "  \"listFontSize\": %u,\n", storedVar.listFontSize);   json += buf;
-  sprintf(buf, "  \"startupDelay\": %u,\n", storedVar.startupDelay);   json += buf;
-  json += "  \"backupControllerId\": \"";
-  appendJsonEscaped(json, backupControllerId);
-  json += "\",\n";
-  json += "  \"screensaverLine1\": \"";
-  appendJsonEscaped(json, storedVar.screensaverLine1);
-  json += "\",\n";
-  json += "  \"screensaverLine2\": \"";
-  appendJsonEscaped(json, storedVar.screensaverLine2);
-  json += "\",\n";
-  sprintf(buf, "  \"wifiMode\": %u,\n", wifiConfiguredMode); json += buf;
-  json += "  \"wifiStaSsid\": \"";
-  appendJsonEscaped(json, wifiClientSsid);
-  json += "\",\n";
-  json += "  \"wifiStaPasswordStored\": 0,\n";
-  json += "  \"uiAuthPasswordStored\": 0,\n";
-
-  json += "  \"cars\": [\n";
-  for (int i = 0; i < CAR_MAX_COUNT; i++) {
-    const CarParam_type& c = storedVar.carParam[i];
-    json += "    {\n";
-    json += "      \"name\": \"";
-    appendJsonEscaped(json, c.carName);
-    json += "\",\n";
-    sprintf(buf, "      \"minSpeed\": %u.%u,\n", c.minSpeed / SENSI_SCALE, sensiFracDigit(c.minSpeed)); json += buf;
-    sprintf(buf, "      \"brake\": %u,\n", c.brake);                     json += buf;
-    sprintf(buf, "      \"maxSpeed\": %u,\n", c.maxSpeed);               json += buf;
-    sprintf(buf, "      \"curveInput\": %u,\n", c.throttleCurveVertex.inputThrottle); json += buf;
-    sprintf(buf, "      \"curveDiff\": %u,\n", c.throttleCurveVertex.curveSpeedDiff); json += buf;
-    sprintf(buf, "      \"fade\": %u,\n", c.fade);                       json += buf;
-    sprintf(buf, "      \"antiSpin\": %u,\n", c.antiSpin);               json += buf;
-    sprintf(buf, "      \"freqPWM\": %u,\n", c.freqPWM);                 json += buf;
-    sprintf(buf, "      \"altBrake\": %u,\n", c.brakeButtonReduction);  json += buf;
-    json += "      \"releaseMode\": \"";
-    json += getBackupReleaseModeName(c.quickBrakeEnabled);
-    json += "\",\n";
-    sprintf(buf, "      \"releaseZone\": %u,\n", c.quickBrakeThreshold); json += buf;
-    sprintf(buf, "      \"releaseLevel\": %u\n", c.quickBrakeStrength);  json += buf;
-    json += "    }";
-    if (i < CAR_MAX_COUNT - 1) json += ",";
-    json += "\n";
-  }
-  json += "  ]\n}\n";
-  return json;
+  jsonWriterRaw(w, "{\n");
+  jsonWriterRaw(w, "  \"schemaVersion\": 1,\n");
+  jsonWriterPrintf(w, "  \"version\": %d,\n", STORED_VAR_VERSION);
+  jsonWriterPrintf(w, "  \"selectedCarNumber\": %u,\n", storedVar.selectedCarNumber);
+  jsonWriterPrintf(w, "  \"minTrigger_raw\": %d,\n", storedVar.minTrigger_raw);
+  jsonWriterPrintf(w, "  \"maxTrigger_raw\": %d,\n", storedVar.maxTrigger_raw);
+  jsonWriterPrintf(w, "  \"viewMode\": %u,\n", storedVar.viewMode);
+  jsonWriterPrintf(w, "  \"screensaverTimeout\": %u,\n", storedVar.screensaverTimeout);
+  jsonWriterPrintf(w, "  \"soundBoot\": %u,\n", storedVar.soundBoot);
+  jsonWriterPrintf(w, "  \"soundRace\": %u,\n", storedVar.soundRace);
+  jsonWriterPrintf(w, "  \"antiSpinStep\": %u,\n", antiSpinStepMs); /* legacy alias for ms-step */
+  jsonWriterPrintf(w, "  \"antiSpinStepMs\": %u,\n", antiSpinStepMs);
+  jsonWriterPrintf(w, "  \"antiSpinStepPct\": %u,\n", antiSpinStepPct);
+  jsonWriterPrintf(w, "  \"antiSpinDisplayMode\": %u,\n", antiSpinDisplayMode);
+  jsonWriterPrintf(w, "  \"encoderInvert\": %u,\n", encoderInvertEnabled ? 1 : 0);
+  jsonWriterPrintf(w, "  \"adcVoltageRangeMv\": %u,\n", adcVoltageRange_mV);
+  jsonWriterPrintf(w, "  \"gridCarSelectEnabled\": %u,\n", storedVar.gridCarSelectEnabled);
+  jsonWriterPrintf(w, "  \"raceViewMode\": %u,\n", storedVar.raceViewMode);
+  jsonWriterPrintf(w, "  \"language\": %u,\n", storedVar.language);
+  jsonWriterPrintf(w, "  \"textCase\": %u,\n", storedVar.textCase);
+  jsonWriterPrintf(w, "  \"listFontSize\": %u,\n", storedVar.listFontSize);
+  jsonWriterPrintf(w, "  \"startupDelay\": %u,\n", storedVar.startupDelay);
+  jsonWriterRaw(w, "  \"backupControllerId\": \"");
+  jsonWriterEscaped(w, backupControllerId);
+  jsonWriterRaw(w, "\",\n");
+  jsonWriterRaw(w, "  \"screensaverLine1\": \"");
+  jsonWriterEscaped(w, storedVar.screensaverLine1);
+  jsonWriterRaw(w, "\",\n");
+  jsonWriterRaw(w, "  \"screensaverLine2\": \"");
+  jsonWriterEscaped(w, storedVar.screensaverLine2);
+  jsonWriterRaw(w, "\",\n");
+  jsonWriterPrintf(w, "  \"wifiMode\": %u,\n", wifiConfiguredMode);
+  jsonWriterRaw(w, "  \"wifiStaSsid\": \"");
+  jsonWriterEscaped(w, wifiClientSsid);
+  jsonWriterRaw(w, "\",\n");
+  jsonWriterRaw(w, "  \"wifiStaPasswordStored\": 0,\n");
+  jsonWriterRaw(w, "  \"uiAuthPasswordStored\": 0,\n");
+
+  /* Profiles past the last saved one are all defaults; leaving them out keeps a backup of a
+     few cars as small as it was with CAR_LEGACY_COUNT profiles */
+  CarParam_type c;
+  char curvePoints[THROTTLE_CURVE_TEXT_MAX];
+  int carCount = (storedVar.activeCar.carNumber < CAR_MAX_COUNT) ? storedVar.activeCar.carNumber + 1 : 1;
+  for (int i = carCount; i < CAR_MAX_COUNT; i++) {
+    if (carProfileRead(i, &c)) {
+      carCount = i + 1;
+    }
+  }
+  jsonWriterRaw(w, "  \"cars\": [\n");
+  for (int i = 0; i < carCount; i++) {
+    if (i == storedVar.activeCar.carNumber) {
+      c = storedVar.activeCar;
+    } else {
+      carProfileRead(i, &c);
+    }
+    jsonWriterRaw(w, "    {\n");
+    jsonWriterRaw(w, "      \"name\": \"");
+    jsonWriterEscaped(w, c.carName);
+    jsonWriterRaw(w, "\",\n");
+    jsonWriterPrintf(w, "      \"minSpeed\": %u.%u,\n", c.minSpeed / SENSI_SCALE, sensiFracDigit(c.minSpeed));
+    jsonWriterPrintf(w, "      \"brake\": %u,\n", c.brake);
+    jsonWriterPrintf(w, "      \"maxSpeed\": %u,\n", c.maxSpeed);
+    jsonWriterPrintf(w, "      \"curveInput\": %u,\n", c.throttleCurveVertex.inputThrottle);
+    jsonWriterPrintf(w, "      \"curveDiff\": %u,\n", c.throttleCurveVertex.curveSpeedDiff);
+    throttleCurveShapeFormat(&c.throttleCurveShape, curvePoints, sizeof(curvePoints));
+    jsonWriterPrintf(w, "      \"curveMode\": %u,\n", c.throttleCurveShape.mode);
+    jsonWriterPrintf(w, "      \"curvePoints\": \"%s\",\n", curvePoints);
+    jsonWriterPrintf(w, "      \"fade\": %u,\n", c.fade);
+    jsonWriterPrintf(w, "      \"antiSpin\": %u,\n", c.antiSpin);
+    jsonWriterPrintf(w, "      \"freqPWM\": %u,\n", c.freqPWM);
+    jsonWriterPrintf(w, "      \"altBrake\": %u,\n", c.brakeButtonReduction);
+    jsonWriterRaw(w, "      \"releaseMode\": \"");
+    jsonWriterRaw(w, getBackupReleaseModeName(c.quickBrakeEnabled));
+    jsonWriterRaw(w, "\",\n");
+    jsonWriterPrintf(w, "      \"releaseZone\": %u,\n", c.quickBrakeThreshold);
+    jsonWriterPrintf(w, "      \"releaseLevel\": %u,\n", c.quickBrakeStrength);
+    jsonWriterPrintf(w, "      \"antiSpinMode\": %u,\n", c.antiSpinMode);
+    jsonWriterPrintf(w, "      \"brakeBite\": %u,\n", c.brakeBite);
+    jsonWriterPrintf(w, "      \"brakeBiteHold\": %u,\n", c.brakeBiteHold);
+    jsonWriterPrintf(w, "      \"brakeRamp\": %u,\n", c.brakeRamp);
+    jsonWriterPrintf(w, "      \"motorResistance\": %u,\n", c.motorResistance);
+    jsonWriterPrintf(w, "      \"motorNoLoadCurrent\": %u,\n", c.motorNoLoadCurrent);
+    jsonWriterPrintf(w, "      \"freqPWMSweep\": %u\n", c.freqPWMSweep);
+    jsonWriterRaw(w, "    }");
+    jsonWriterRaw(w, (i < carCount - 1) ? ",\n" : "\n");
+  }
+  jsonWriterRaw(w, "  ]\n}\n");
 }
 
 /**
- * @brief Build JSON backup string from current runtime configuration.
+ * @brief Write the JSON backup of the current runtime configuration (PortalJsonBody_fn).
  */
-static String buildJsonBackup() {
+static void writeJsonBackup(JsonWriter_type* w, const void* arg) {
+  (void)arg;
   loadWiFiNetworkSettingsIfNeeded();
-  return buildJsonBackupFromConfig(g_storedVar,
-                                   g_antiSpinStepMs,
-                                   g_antiSpinStepPct,
-                                   g_antiSpinDisplayMode,
-                                   g_encoderInvertEnabled,
-                                   g_adcVoltageRange_mV,
-                                   g_wifiConfiguredMode,
-                                   g_wifiClientSsid,
-                                   g_wifiClientPassword,
-                                   g_uiAuthPassword);
+  writeJsonBackupFromConfig(w,
+                            g_storedVar,
+                            g_antiSpinStepMs,
+                            g_antiSpinStepPct,
+                            g_antiSpinDisplayMode,
+                            g_encoderInvertEnabled,
+                            g_adcVoltageRange_mV,
+                            g_wifiConfiguredMode,
+                            g_wifiClientSsid,
+                            g_wifiClientPassword,
+                            g_uiAuthPassword);
 }
 
 
 /**
- * @brief Parse an integer value from JSON by key name
+ * @brief Parse an integer value from a scanned JSON object by key name
  */
-static bool parseJsonInt(const String& json, const char* key, int32_t& outVal) {
-  String search = String("\"") + key + "\"";
-  int idx = json.indexOf(search);
-  if (idx < 0) return false;
-  int colon = json.indexOf(':', idx);
-  if (colon < 0) return false;
-  int start = colon + 1;
-  while (start < (int)json.length() && (json[start] == ' ' || json[start] == '\n' || json[start] == '\r')) start++;
-  int end = start;
-  while (end < (int)json.length() && (isDigit(json[end]) || json[end] == '-')) end++;
-  if (end == start) return false;
-  outVal = json.substring(start, end).toInt();
-  return true;
+static bool parseJsonInt(const JsonScanObject_type& doc, const char* key, int32_t& outVal) {
+  return jsonScanInt(&doc, key, &outVal);
+}
+
+/**
+ * @brief Parse a string value from a scanned JSON object by key name (truncated to maxLen - 1)
+ */
+static bool parseJsonStr(const JsonScanObject_type& doc, const char* key, char* outStr, int maxLen) {
+  if (maxLen <= 0) return false;
+  return jsonScanStr(&doc, key, outStr, (size_t)maxLen);
+}
+
+static bool jsonHasKey(const JsonScanObject_type& doc, const char* key) {
+  return jsonScanHas(&doc, key);
 }
 
-static bool parseJsonNumberToken(const String& json, const char* key, String& outToken) {
-  String search = String("\"") + key + "\"";
-  int idx = json.indexOf(search);
-  if (idx < 0) return false;
-  int colon = json.indexOf(':', idx);
-  if (colon < 0) return false;
-  int start = colon + 1;
-  while (start < (int)json.length() && (json[start] == ' ' || json[start] == '\n' || json[start] == '\r')) start++;
-  int end = start;
-  while (end < (int)json.length() && (isDigit(json[end]) || json[end] == '-' || json[end] == '.')) end++;
-  if (end == start) return false;
-  outToken = json.substring(start, end);
-  outToken.trim();
-  return outToken.length() > 0;
-}
-
-static bool parseJsonHalfPercent(const String& json, const char* key, uint16_t* outRaw) {
-  if (outRaw == nullptr) return false;
-  String token;
-  if (!parseJsonNumberToken(json, key, token)) return false;
-
-  int dot = token.indexOf('.');
+/**
+ * @brief Parse a SENSI-style value ("12", "12.5", "12.50") into half-percent steps
+ */
+static bool parseJsonHalfPercent(const JsonScanMember_type* m, uint16_t* outRaw) {
+  if (m == nullptr || outRaw == nullptr || m->type != JSON_SCAN_NUMBER) return false;
+
+  const char* p = m->value;
+  const char* end = p + m->valueLen;
   int32_t whole = 0;
   int32_t frac = 0;
 
-  if (dot < 0) {
-    whole = token.toInt();
-  } else {
-    String left = token.substring(0, dot);
-    String right = token.substring(dot + 1);
-    if (right.length() == 0) return false;
-    for (int i = 0; i < (int)right.length(); i++) {
-      if (!isDigit(right[i])) return false;
+  if (p < end && *p == '-') return false;
+  while (p < end && isDigit(*p)) {
+    whole = whole * 10 + (*p - '0');
+    if (whole > MIN_SPEED_MAX_VALUE) return false;
+    p++;
+  }
+  if (p < end && *p == '.') {
+    p++;
+    if (p >= end) return false;
+    for (const char* q = p; q < end; q++) {
+      if (!isDigit(*q)) return false;
     }
-    whole = left.toInt();
-    frac = right[0] - '0';
-    for (int i = 1; i < (int)right.length(); i++) {
-      if (right[i] != '0') return false;  /* allow only one non-zero decimal digit */
+    frac = *p++ - '0';
+    while (p < end) {
+      if (*p++ != '0') return false;  /* allow only one non-zero decimal digit */
     }
   }
-
-  if (whole < 0) return false;
+  if (p != end) return false;
   if (frac != 0 && frac != 5) return false;  /* only 0.0 or 0.5 */
 
   uint16_t raw = (uint16_t)(whole * SENSI_SCALE + (frac == 5 ? 1 : 0));
@@ -946,36 +1117,6 @@ static bool parseJsonHalfPercent(const String& json, const char* key, uint16_t*
   return true;
 }
 
-
-/**
- * @brief Parse a string value from JSON by key name
- */
-static bool parseJsonStr(const String& json, const char* key, char* outStr, int maxLen) {
-  String search = String("\"") + key + "\"";
-  int idx = json.indexOf(search);
-  if (idx < 0) return false;
-  int colon = json.indexOf(':', idx);
-  if (colon < 0) return false;
-  int qStart = json.indexOf('"', colon + 1);
-  if (qStart < 0) return false;
-  int qEnd = json.indexOf('"', qStart + 1);
-  if (qEnd < 0) return false;
-  int len = qEnd - qStart - 1;
-  if (len >= maxLen) len = maxLen - 1;
-  json.substring(qStart + 1, qStart + 1 + len).toCharArray(outStr, maxLen);
-  return true;
-}
-
-static bool jsonHasKey(const String& json, const char* key) {
-  String search = String("\"") + key + "\"";
-  return json.indexOf(search) >= 0;
-}
-
-static bool parseJsonIntAlias(const String& json, const char* primaryKey, const char* legacyKey, int32_t& outVal) {
-  if (jsonHasKey(json, primaryKey)) return parseJsonInt(json, primaryKey, outVal);
-  return parseJsonInt(json, legacyKey, outVal);
-}
-
 static const char* getBackupReleaseModeName(uint16_t mode) {
   switch (mode) {
     case RELEASE_BRAKE_QUICK: return "QUICK";
@@ -985,30 +1126,32 @@ static const char* getBackupReleaseModeName(uint16_t mode) {
   }
 }
 
-static bool parseJsonReleaseMode(const String& json, const char* key, uint16_t* outMode) {
-  if (outMode == nullptr) return false;
+static bool parseJsonReleaseMode(const JsonScanMember_type* m, uint16_t* outMode) {
+  if (m == nullptr || outMode == nullptr) return false;
 
   int32_t v = 0;
-  if (parseJsonInt(json, key, v)) {
+  if (jsonScanMemberInt(m, &v)) {
     if (v < RELEASE_BRAKE_OFF || v > RELEASE_BRAKE_DRAG) return false;
     *outMode = (uint16_t)v;
     return true;
   }
 
   char modeStr[16];
-  if (!parseJsonStr(json, key, modeStr, sizeof(modeStr))) return false;
+  if (!jsonScanMemberStr(m, modeStr, sizeof(modeStr))) return false;
 
-  String mode = modeStr;
-  mode.trim();
-  if (mode.equalsIgnoreCase("OFF")) {
+  const char* mode = modeStr;
+  while (*mode == ' ') mode++;
+  size_t len = strlen(mode);
+  while (len > 0 && mode[len - 1] == ' ') len--;
+  if (len == 3 && strncasecmp(mode, "OFF", 3) == 0) {
     *outMode = RELEASE_BRAKE_OFF;
     return true;
   }
-  if (mode.equalsIgnoreCase("QUICK") || mode.equalsIgnoreCase("QCK")) {
+  if ((len == 5 && strncasecmp(mode, "QUICK", 5) == 0) || (len == 3 && strncasecmp(mode, "QCK", 3) == 0)) {
     *outMode = RELEASE_BRAKE_QUICK;
     return true;
   }
-  if (mode.equalsIgnoreCase("DRAG") || mode.equalsIgnoreCase("DRG")) {
+  if ((len == 4 && strncasecmp(mode, "DRAG", 4) == 0) || (len == 3 && strncasecmp(mode, "DRG", 3) == 0)) {
     *outMode = RELEASE_BRAKE_DRAG;
     return true;
   }
@@ -1016,9 +1159,26 @@ static bool parseJsonReleaseMode(const String& json, const char* key, uint16_t*
   return false;
 }
 
-static bool parseJsonReleaseModeAlias(const String& json, const char* primaryKey, const char* legacyKey, uint16_t* outMode) {
-  if (jsonHasKey(json, primaryKey)) return parseJsonReleaseMode(json, primaryKey, outMode);
-  return parseJsonReleaseMode(json, legacyKey, outMode);
+/**
+ * @brief Apply "curveMode" and "curvePoints" (either may be missing) to a multi-point curve
+ * @return false (shape untouched) if a present value is invalid
+ */
+static bool parseJsonCurveShape(const JsonScanObject_type& doc, ThrottleCurveShape_type* shape) {
+  const JsonScanMember_type* modeMember = jsonScanFind(&doc, "curveMode");
+  const JsonScanMember_type* pointsMember = jsonScanFind(&doc, "curvePoints");
+  if (modeMember == nullptr && pointsMember == nullptr) return true;
+
+  int32_t mode = shape->mode;
+  if (modeMember != nullptr && !jsonScanMemberInt(modeMember, &mode)) return false;
+  if (mode < THROTTLE_CURVE_MODE_VERTEX || mode > THROTTLE_CURVE_MODE_SPLINE) return false;
+
+  char pointsText[THROTTLE_CURVE_TEXT_MAX];
+  if (pointsMember != nullptr) {
+    if (!jsonScanMemberStr(pointsMember, pointsText, sizeof(pointsText))) return false;
+  } else {
+    throttleCurveShapeFormat(shape, pointsText, sizeof(pointsText));
+  }
+  return throttleCurveShapeParse(pointsText, (uint8_t)mode, shape);
 }
 
 
@@ -1029,12 +1189,128 @@ static bool inRange(int32_t val, int32_t minVal, int32_t maxVal) {
   return val >= minVal && val <= maxVal;
 }
 
+/* How a car field is treated when a full backup is restored (a web patch accepts every
+ * field as optional but rejects invalid values) */
+#define CAR_FIELD_RESTORE_REQUIRED  0   /* Missing or invalid fails the restore */
+#define CAR_FIELD_RESTORE_OPTIONAL  1   /* Missing keeps the current value, invalid fails */
+#define CAR_FIELD_RESTORE_LENIENT   2   /* Missing or invalid keeps the current value */
+
+typedef struct {
+  const char* key;
+  const char* legacyKey;   /* Name used by older backups, or nullptr */
+  uint16_t offset;         /* uint16_t member of CarParam_type */
+  int32_t minVal;
+  int32_t maxVal;
+  uint8_t restoreRule;
+  bool patchable;          /* Accepted by /api/apply and APPLY */
+} CarIntField_type;
+
+/* Integer car fields in backup order. minSpeed (half percent), releaseMode (enum) and the
+ * name have their own parsers. */
+static constexpr CarIntField_type CAR_INT_FIELDS[] = {
+  {"brake",        nullptr,               offsetof(CarParam_type, brake),                              0, BRAKE_MAX_VALUE,                     CAR_FIELD_RESTORE_REQUIRED, true},
+  {"maxSpeed",     nullptr,               offsetof(CarParam_type, maxSpeed),                           5, 100,                                 CAR_FIELD_RESTORE_REQUIRED, true},
+  {"curveInput",   nullptr,               offsetof(CarParam_type, throttleCurveVertex.inputThrottle),  0, THROTTLE_NORMALIZED,                 CAR_FIELD_RESTORE_REQUIRED, false},
+  {"curveDiff",    nullptr,               offsetof(CarParam_type, throttleCurveVertex.curveSpeedDiff), THROTTLE_CURVE_SPEED_DIFF_MIN_VALUE, THROTTLE_CURVE_SPEED_DIFF_MAX_VALUE, CAR_FIELD_RESTORE_REQUIRED, true},
+  {"fade",         nullptr,               offsetof(CarParam_type, fade),                               0, FADE_MAX_VALUE,                      CAR_FIELD_RESTORE_LENIENT,  true},
+  {"antiSpin",     nullptr,               offsetof(CarParam_type, antiSpin),                           0, ANTISPIN_MAX_VALUE,                  CAR_FIELD_RESTORE_REQUIRED, true},
+  {"freqPWM",      nullptr,               offsetof(CarParam_type, freqPWM),                            FREQ_MIN_VALUE / 100, FREQ_MAX_VALUE / 100, CAR_FIELD_RESTORE_REQUIRED, true},
+  {"altBrake",     "brakeButton",         offsetof(CarParam_type, brakeButtonReduction),               0, 100,                                 CAR_FIELD_RESTORE_REQUIRED, true},
+  {"releaseZone",  "quickBrakeThreshold", offsetof(CarParam_type, quickBrakeThreshold),                0, QUICK_BRAKE_THRESHOLD_MAX,           CAR_FIELD_RESTORE_OPTIONAL, true},
+  {"releaseLevel", "quickBrakeStrength",  offsetof(CarParam_type, quickBrakeStrength),                 0, QUICK_BRAKE_STRENGTH_MAX,            CAR_FIELD_RESTORE_OPTIONAL, true},
+  {"antiSpinMode", nullptr,               offsetof(CarParam_type, antiSpinMode),                       ANTISPIN_MODE_RAMP, ANTISPIN_MODE_TRACTION, CAR_FIELD_RESTORE_OPTIONAL, true},
+  {"brakeBite",    nullptr,               offsetof(CarParam_type, brakeBite),                          0, BRAKE_BITE_MAX,                      CAR_FIELD_RESTORE_OPTIONAL, true},
+  {"brakeBiteHold", nullptr,              offsetof(CarParam_type, brakeBiteHold),                      0, BRAKE_BITE_HOLD_MAX,                 CAR_FIELD_RESTORE_OPTIONAL, true},
+  {"brakeRamp",    nullptr,               offsetof(CarParam_type, brakeRamp),                          0, BRAKE_RAMP_MAX,                      CAR_FIELD_RESTORE_OPTIONAL, true},
+  {"motorResistance", nullptr,            offsetof(CarParam_type, motorResistance),                    0, UINT16_MAX,                          CAR_FIELD_RESTORE_LENIENT,  false},
+  {"motorNoLoadCurrent", nullptr,         offsetof(CarParam_type, motorNoLoadCurrent),                 0, UINT16_MAX,                          CAR_FIELD_RESTORE_LENIENT,  false},
+  {"freqPWMSweep", nullptr,               offsetof(CarParam_type, freqPWMSweep),                       0, FREQ_MAX_VALUE / 100,                CAR_FIELD_RESTORE_LENIENT,  false},
+};
+#define CAR_INT_FIELD_COUNT  (sizeof(CAR_INT_FIELDS) / sizeof(CAR_INT_FIELDS[0]))
+
+static inline uint16_t* carIntFieldPtr(CarParam_type& car, const CarIntField_type& field) {
+  return (uint16_t*)((uint8_t*)&car + field.offset);
+}
+
+/**
+ * @brief Apply the integer fields of one scanned car object to a profile
+ * @param restore true for a full backup (restoreRule applies), false for a web patch
+ * @return Key of the first offending field, or nullptr if all fields were accepted
+ */
+static const char* applyCarIntFields(const JsonScanObject_type& carDoc, CarParam_type& car, bool restore) {
+  for (size_t i = 0; i < CAR_INT_FIELD_COUNT; i++) {
+    const CarIntField_type& field = CAR_INT_FIELDS[i];
+    if (!restore && !field.patchable) continue;
+    const JsonScanMember_type* m = jsonScanFindAlias(&carDoc, field.key, field.legacyKey);
+    int32_t v = 0;
+    bool valid = jsonScanMemberInt(m, &v) && inRange(v, field.minVal, field.maxVal);
+    if (valid) {
+      *carIntFieldPtr(car, field) = (uint16_t)v;
+      continue;
+    }
+    uint8_t rule = restore ? field.restoreRule : CAR_FIELD_RESTORE_OPTIONAL;
+    if (rule == CAR_FIELD_RESTORE_REQUIRED || (rule == CAR_FIELD_RESTORE_OPTIONAL && m != nullptr)) {
+      return field.key;
+    }
+  }
+  return nullptr;
+}
+
+
+/**
+ * @brief Parse one entry of the backup "cars" array over c (fields it lacks keep c's values)
+ */
+static bool parseBackupCar(const char* json, size_t len, int i, CarParam_type* c, String* errorMsg) {
+  JsonScanObject_type carDoc;
+  if (len == 0 || json[0] != '{' || !jsonScanObject(json, len, &carDoc)) {
+    *errorMsg = "Error: malformed car " + String(i); return false;
+  }
+
+  /* Name - use temp buffer to preserve names up to CAR_NAME_MAX_SIZE chars */
+  char tempName[16];
+  if (!parseJsonStr(carDoc, "name", tempName, sizeof(tempName))) {
+    *errorMsg = "Error: missing name in car " + String(i); return false;
+  }
+  memset(c->carName, 0, CAR_NAME_MAX_SIZE);
+  strncpy(c->carName, tempName, CAR_NAME_MAX_SIZE);
+  c->carNumber = i;
+
+  /* Numeric fields */
+  uint16_t minSpeedRaw = 0;
+  if (!parseJsonHalfPercent(jsonScanFind(&carDoc, "minSpeed"), &minSpeedRaw)) {
+    *errorMsg = "Error: invalid minSpeed in car " + String(i); return false;
+  }
+  c->minSpeed = minSpeedRaw;
+
+  const char* badField = applyCarIntFields(carDoc, *c, true);
+  if (badField != nullptr) {
+    *errorMsg = "Error: invalid " + String(badField) + " in car " + String(i); return false;
+  }
+
+  /* Release-brake mode — optional for backwards compatibility with older backups */
+  const JsonScanMember_type* releaseModeMember = jsonScanFindAlias(&carDoc, "releaseMode", "quickBrakeEnabled");
+  if (releaseModeMember != nullptr) {
+    uint16_t releaseMode = c->quickBrakeEnabled;
+    if (!parseJsonReleaseMode(releaseModeMember, &releaseMode)) {
+      *errorMsg = "Error: invalid releaseMode in car " + String(i); return false;
+    }
+    c->quickBrakeEnabled = releaseMode;
+  }
+
+  /* Multi-point curve — optional, older backups keep the vertex curve */
+  if (!parseJsonCurveShape(carDoc, &c->throttleCurveShape)) {
+    *errorMsg = "Error: invalid curvePoints in car " + String(i); return false;
+  }
+  return true;
+}
 
 /**
- * @brief Parse and validate uploaded JSON, populate temporary StoredVar
+ * @brief Parse and validate the settings part of a backup, populate temporary StoredVar
+ * @details body is the top level kept by the restore stream: the "cars" entries were parsed
+ *          on arrival (backupRestoreOnCar()) and only an empty "cars" array is left here.
  * @return true if valid, false with error message
  */
-static bool parseAndValidateJson(const String& json, StoredVar_type* sv, uint16_t* antiSpinStepMs,
+static bool parseAndValidateJson(const char* body, size_t bodyLen, StoredVar_type* sv, uint16_t* antiSpinStepMs,
                                  uint16_t* antiSpinStepPct, uint16_t* antiSpinDisplayMode,
                                  uint16_t* encoderInvertEnabled, uint16_t* adcVoltageRangeMv,
                                  uint16_t* wifiConfiguredMode, char* wifiClientSsid,
@@ -1043,19 +1319,25 @@ static bool parseAndValidateJson(const String& json, StoredVar_type* sv, uint16_
                                  size_t uiAuthUsernameLen, char* uiAuthPassword,
                                  size_t uiAuthPasswordLen, String* errorMsg,
                                  String* warningMsg = nullptr) {
+  JsonScanObject_type doc;
+  if (!jsonScanObject(body, bodyLen, &doc)) {
+    *errorMsg = "Error: malformed JSON";
+    return false;
+  }
+
   int32_t v;
   bool wifiPasswordStoredSpecified = false;
   bool wifiPasswordStored = false;
-  bool hasEncryptedWifiPassword = jsonHasKey(json, "wifiStaPasswordEnc") ||
-                                  jsonHasKey(json, "wifiStaPasswordNonce") ||
-                                  jsonHasKey(json, "wifiStaPasswordTag");
-  bool hasLegacyPlainWifiPassword = jsonHasKey(json, "wifiStaPassword");
+  bool hasEncryptedWifiPassword = jsonHasKey(doc, "wifiStaPasswordEnc") ||
+                                  jsonHasKey(doc, "wifiStaPasswordNonce") ||
+                                  jsonHasKey(doc, "wifiStaPasswordTag");
+  bool hasLegacyPlainWifiPassword = jsonHasKey(doc, "wifiStaPassword");
   bool uiAuthPasswordStoredSpecified = false;
   bool uiAuthPasswordStored = false;
-  bool hasEncryptedUiAuthPassword = jsonHasKey(json, "uiAuthPasswordEnc") ||
-                                    jsonHasKey(json, "uiAuthPasswordNonce") ||
-                                    jsonHasKey(json, "uiAuthPasswordTag");
-  bool hasLegacyPlainUiAuthPassword = jsonHasKey(json, "uiAuthPassword");
+  bool hasEncryptedUiAuthPassword = jsonHasKey(doc, "uiAuthPasswordEnc") ||
+                                    jsonHasKey(doc, "uiAuthPasswordNonce") ||
+                                    jsonHasKey(doc, "uiAuthPasswordTag");
+  bool hasLegacyPlainUiAuthPassword = jsonHasKey(doc, "uiAuthPassword");
   bool controllerLocalSettingsRestoreAllowed = true;
   char backupControllerId[13];
   char currentControllerId[13];
@@ -1063,7 +1345,7 @@ static bool parseAndValidateJson(const String& json, StoredVar_type* sv, uint16_
   if (warningMsg != nullptr) {
     *warningMsg = "";
   }
-  if (parseJsonStr(json, "backupControllerId", backupControllerId, sizeof(backupControllerId)) &&
+  if (parseJsonStr(doc, "backupControllerId", backupControllerId, sizeof(backupControllerId)) &&
       backupControllerId[0] != '\0') {
     getBackupControllerId(currentControllerId, sizeof(currentControllerId));
     if (strcmp(backupControllerId, currentControllerId) != 0) {
@@ -1117,86 +1399,86 @@ static bool parseAndValidateJson(const String& json, StoredVar_type* sv, uint16_
   }
 
   /* Version check - warn but allow cross-version restore for car profiles */
-  if (parseJsonInt(json, "version", v) && v != STORED_VAR_VERSION) {
+  if (parseJsonInt(doc, "version", v) && v != STORED_VAR_VERSION) {
     /* Different version: car profiles are restored, global settings use defaults for missing fields */
   }
 
   /* Parse global settings - use value if present and valid, otherwise keep default */
-  if (parseJsonInt(json, "selectedCarNumber", v) && inRange(v, 0, CAR_MAX_COUNT - 1))
+  if (parseJsonInt(doc, "selectedCarNumber", v) && inRange(v, 0, CAR_MAX_COUNT - 1))
     sv->selectedCarNumber = v;
-  if (parseJsonInt(json, "minTrigger_raw", v))
+  if (parseJsonInt(doc, "minTrigger_raw", v))
     sv->minTrigger_raw = (int16_t)v;
-  if (parseJsonInt(json, "maxTrigger_raw", v))
+  if (parseJsonInt(doc, "maxTrigger_raw", v))
     sv->maxTrigger_raw = (int16_t)v;
-  if (parseJsonInt(json, "viewMode", v) && inRange(v, 0, 1))
+  if (parseJsonInt(doc, "viewMode", v) && inRange(v, 0, 1))
     sv->viewMode = v;
-  if (parseJsonInt(json, "screensaverTimeout", v) && inRange(v, 0, SCREENSAVER_TIMEOUT_MAX))
+  if (parseJsonInt(doc, "screensaverTimeout", v) && inRange(v, 0, SCREENSAVER_TIMEOUT_MAX))
     sv->screensaverTimeout = v;
-  if (parseJsonInt(json, "soundBoot", v) && inRange(v, 0, 1))
+  if (parseJsonInt(doc, "soundBoot", v) && inRange(v, 0, 1))
     sv->soundBoot = v;
-  if (parseJsonInt(json, "soundRace", v) && inRange(v, 0, 1))
+  if (parseJsonInt(doc, "soundRace", v) && inRange(v, 0, 1))
     sv->soundRace = v;
   if (antiSpinStepMs != nullptr &&
-      parseJsonInt(json, "antiSpinStep", v) &&
+      parseJsonInt(doc, "antiSpinStep", v) &&
       inRange(v, ANTISPIN_STEP_MIN, ANTISPIN_STEP_MAX)) {
     *antiSpinStepMs = (uint16_t)v;
   }
   if (antiSpinStepMs != nullptr &&
-      parseJsonInt(json, "antiSpinStepMs", v) &&
+      parseJsonInt(doc, "antiSpinStepMs", v) &&
       inRange(v, ANTISPIN_STEP_MIN, ANTISPIN_STEP_MAX)) {
     *antiSpinStepMs = (uint16_t)v;
   }
   if (antiSpinStepPct != nullptr &&
-      parseJsonInt(json, "antiSpinStepPct", v) &&
+      parseJsonInt(doc, "antiSpinStepPct", v) &&
       inRange(v, ANTISPIN_STEP_PCT_MIN, ANTISPIN_STEP_PCT_MAX)) {
     *antiSpinStepPct = (uint16_t)v;
   }
   if (antiSpinDisplayMode != nullptr &&
-      parseJsonInt(json, "antiSpinDisplayMode", v) &&
+      parseJsonInt(doc, "antiSpinDisplayMode", v) &&
       inRange(v, ANTISPIN_UI_MODE_MS, ANTISPIN_UI_MODE_TEXT)) {
     *antiSpinDisplayMode = (uint16_t)v;
   }
   if (encoderInvertEnabled != nullptr &&
-      parseJsonInt(json, "encoderInvert", v) &&
+      parseJsonInt(doc, "encoderInvert", v) &&
       inRange(v, 0, 1)) {
     *encoderInvertEnabled = (uint16_t)v;
   }
   if (adcVoltageRangeMv != nullptr &&
-      parseJsonInt(json, "adcVoltageRangeMv", v) &&
+      parseJsonInt(doc, "adcVoltageRangeMv", v) &&
       inRange(v, ADC_VOLTAGE_RANGE_MIN_MVOLTS, ADC_VOLTAGE_RANGE_MAX_MVOLTS)) {
     *adcVoltageRangeMv = (uint16_t)v;
   }
-  if (parseJsonInt(json, "gridCarSelectEnabled", v) && inRange(v, 0, 1))
+  if (parseJsonInt(doc, "gridCarSelectEnabled", v) && inRange(v, 0, 1))
     sv->gridCarSelectEnabled = v;
-  if (parseJsonInt(json, "raceViewMode", v) && inRange(v, 0, 2))
+  if (parseJsonInt(doc, "raceViewMode", v) && inRange(v, 0, 2))
     sv->raceViewMode = v;
-  if (parseJsonInt(json, "language", v) && inRange(v, LANG_NOR, LANG_MAX))
+  if (parseJsonInt(doc, "language", v) && inRange(v, LANG_NOR, LANG_MAX))
     sv->language = v;
-  if (parseJsonInt(json, "textCase", v) && inRange(v, TEXT_CASE_UPPER, TEXT_CASE_PASCAL))
+  if (parseJsonInt(doc, "textCase", v) && inRange(v, TEXT_CASE_UPPER, TEXT_CASE_PASCAL))
     sv->textCase = v;
-  if (parseJsonInt(json, "listFontSize", v) && inRange(v, FONT_SIZE_LARGE, FONT_SIZE_SMALL))
+  if (parseJsonInt(doc, "listFontSize", v) && inRange(v, FONT_SIZE_LARGE, FONT_SIZE_SMALL))
     sv->listFontSize = v;
-  if (parseJsonInt(json, "startupDelay", v) && inRange(v, STARTUP_DELAY_MIN, STARTUP_DELAY_MAX))
+  if (parseJsonInt(doc, "startupDelay", v) && inRange(v, STARTUP_DELAY_MIN, STARTUP_DELAY_MAX))
     sv->startupDelay = v;
   if (controllerLocalSettingsRestoreAllowed &&
       wifiConfiguredMode != nullptr &&
-      parseJsonInt(json, "wifiMode", v) &&
+      parseJsonInt(doc, "wifiMode", v) &&
       inRange(v, WIFI_CONFIG_AP, WIFI_CONFIG_HOME)) {
     *wifiConfiguredMode = (uint16_t)v;
   }
 
   /* Parse screensaver text fields */
   char tempStr[SCREENSAVER_TEXT_MAX];
-  if (parseJsonStr(json, "screensaverLine1", tempStr, SCREENSAVER_TEXT_MAX))
+  if (parseJsonStr(doc, "screensaverLine1", tempStr, SCREENSAVER_TEXT_MAX))
     strncpy(sv->screensaverLine1, tempStr, SCREENSAVER_TEXT_MAX);
-  if (parseJsonStr(json, "screensaverLine2", tempStr, SCREENSAVER_TEXT_MAX))
+  if (parseJsonStr(doc, "screensaverLine2", tempStr, SCREENSAVER_TEXT_MAX))
     strncpy(sv->screensaverLine2, tempStr, SCREENSAVER_TEXT_MAX);
   if (controllerLocalSettingsRestoreAllowed &&
       wifiClientSsid != nullptr && wifiClientSsidLen > 0 &&
-      parseJsonStr(json, "wifiStaSsid", wifiClientSsid, (int)wifiClientSsidLen)) {
+      parseJsonStr(doc, "wifiStaSsid", wifiClientSsid, (int)wifiClientSsidLen)) {
     wifiClientSsid[wifiClientSsidLen - 1] = '\0';
   }
-  if (controllerLocalSettingsRestoreAllowed && parseJsonInt(json, "wifiStaPasswordStored", v)) {
+  if (controllerLocalSettingsRestoreAllowed && parseJsonInt(doc, "wifiStaPasswordStored", v)) {
     if (!inRange(v, 0, 1)) { *errorMsg = "Error: invalid wifiStaPasswordStored"; return false; }
     wifiPasswordStoredSpecified = true;
     wifiPasswordStored = (v != 0);
@@ -1209,7 +1491,7 @@ static bool parseAndValidateJson(const String& json, StoredVar_type* sv, uint16_
         *wifiConfiguredMode = g_wifiConfiguredMode;
       }
     } else if (hasEncryptedWifiPassword) {
-      if (!decryptBackupWiFiPasswordFromJson(json, wifiClientPassword, wifiClientPasswordLen, errorMsg)) {
+      if (!decryptBackupWiFiPasswordFromJson(doc, wifiClientPassword, wifiClientPasswordLen, errorMsg)) {
         if (warningMsg != nullptr && warningMsg->length() == 0) {
           *warningMsg = "WiFi/login settings skipped (could not decrypt Client WiFi password)";
         }
@@ -1222,7 +1504,7 @@ static bool parseAndValidateJson(const String& json, StoredVar_type* sv, uint16_
         /* WiFi restore succeeded, keep parsed values. */
       }
     } else if (hasLegacyPlainWifiPassword &&
-               parseJsonStr(json, "wifiStaPassword", wifiClientPassword, (int)wifiClientPasswordLen)) {
+               parseJsonStr(doc, "wifiStaPassword", wifiClientPassword, (int)wifiClientPasswordLen)) {
       wifiClientPassword[wifiClientPasswordLen - 1] = '\0';
     } else if (wifiPasswordStoredSpecified && wifiPasswordStored) {
       if (warningMsg != nullptr && warningMsg->length() == 0) {
@@ -1237,13 +1519,13 @@ static bool parseAndValidateJson(const String& json, StoredVar_type* sv, uint16_
   }
   if (controllerLocalSettingsRestoreAllowed &&
       uiAuthUsername != nullptr && uiAuthUsernameLen > 0 &&
-      parseJsonStr(json, "uiAuthUsername", uiAuthUsername, (int)uiAuthUsernameLen)) {
+      parseJsonStr(doc, "uiAuthUsername", uiAuthUsername, (int)uiAuthUsernameLen)) {
     uiAuthUsername[uiAuthUsernameLen - 1] = '\0';
     if (uiAuthUsername[0] == '\0') {
       getDefaultUiAuthUsername(uiAuthUsername, uiAuthUsernameLen);
     }
   }
-  if (controllerLocalSettingsRestoreAllowed && parseJsonInt(json, "uiAuthPasswordStored", v)) {
+  if (controllerLocalSettingsRestoreAllowed && parseJsonInt(doc, "uiAuthPasswordStored", v)) {
     if (!inRange(v, 0, 1)) { *errorMsg = "Error: invalid uiAuthPasswordStored"; return false; }
     uiAuthPasswordStoredSpecified = true;
     uiAuthPasswordStored = (v != 0);
@@ -1253,7 +1535,7 @@ static bool parseAndValidateJson(const String& json, StoredVar_type* sv, uint16_
       copyBoundedString(uiAuthUsername, uiAuthUsernameLen, g_uiAuthUsername);
       copyBoundedString(uiAuthPassword, uiAuthPasswordLen, g_uiAuthPassword);
     } else if (hasEncryptedUiAuthPassword) {
-      if (!decryptBackupUiAuthPasswordFromJson(json, uiAuthPassword, uiAuthPasswordLen, errorMsg)) {
+      if (!decryptBackupUiAuthPasswordFromJson(doc, uiAuthPassword, uiAuthPasswordLen, errorMsg)) {
         if (warningMsg != nullptr && warningMsg->length() == 0) {
           *warningMsg = "WiFi/login settings skipped (could not decrypt controller login)";
         }
@@ -1261,7 +1543,7 @@ static bool parseAndValidateJson(const String& json, StoredVar_type* sv, uint16_
         copyBoundedString(uiAuthPassword, uiAuthPasswordLen, g_uiAuthPassword);
       }
     } else if (hasLegacyPlainUiAuthPassword &&
-               parseJsonStr(json, "uiAuthPassword", uiAuthPassword, (int)uiAuthPasswordLen)) {
+               parseJsonStr(doc, "uiAuthPassword", uiAuthPassword, (int)uiAuthPasswordLen)) {
       uiAuthPassword[uiAuthPasswordLen - 1] = '\0';
       if (uiAuthPassword[0] == '\0') {
         getDefaultUiAuthPassword(uiAuthPassword, uiAuthPasswordLen);
@@ -1284,106 +1566,190 @@ static bool parseAndValidateJson(const String& json, StoredVar_type* sv, uint16_
     return false;
   }
 
-  /* Parse car profiles */
-  int carStart = json.indexOf("\"cars\"");
-  if (carStart < 0) { *errorMsg = "Error: missing cars array"; return false; }
+  /* Car profiles were staged while streaming; the array must still have been there */
+  const JsonScanMember_type* cars = jsonScanFind(&doc, "cars");
+  if (cars == nullptr) { *errorMsg = "Error: missing cars array"; return false; }
+  if (cars->type != JSON_SCAN_ARRAY) { *errorMsg = "Error: malformed cars array"; return false; }
 
-  int searchPos = json.indexOf('[', carStart);
-  if (searchPos < 0) { *errorMsg = "Error: malformed cars array"; return false; }
+  return true;
+}
 
-  for (int i = 0; i < CAR_MAX_COUNT; i++) {
-    /* Find next car object */
-    int objStart = json.indexOf('{', searchPos);
-    int objEnd = json.indexOf('}', objStart);
-    if (objStart < 0 || objEnd < 0) {
-      break;  /* fewer profiles in backup than CAR_MAX_COUNT — keep defaults for the rest */
-    }
-    String carJson = json.substring(objStart, objEnd + 1);
-    searchPos = objEnd + 1;
+/* Streaming backup restore (POST /restore and serial RESTORE).
+ * The upload goes through json_stream chunk by chunk, so the backup text is never held in
+ * RAM: every "cars" entry is parsed on arrival over the stored profile (missing fields keep
+ * their values) into a staging list of BACKUP_RESTORE_BLOCK_CARS-profile blocks, and the
+ * settings part stays in the splitter until parseAndValidateJson() checks it at the end.
+ * Nothing is applied unless the whole backup validated. One restore at a time. */
+#define BACKUP_RESTORE_MAX_BYTES   131072UL  /* Serial RESTORE length limit (CAR_MAX_COUNT profiles fit) */
+#define BACKUP_RESTORE_BLOCK_CARS  8U
 
-    CarParam_type& c = sv->carParam[i];
+typedef struct BackupRestoreBlock_type {
+  CarParam_type cars[BACKUP_RESTORE_BLOCK_CARS];
+  struct BackupRestoreBlock_type* next;
+} BackupRestoreBlock_type;
 
-    /* Name - use temp buffer to preserve names up to CAR_NAME_MAX_SIZE chars */
-    char tempName[16];
-    if (!parseJsonStr(carJson, "name", tempName, sizeof(tempName))) {
-      *errorMsg = "Error: missing name in car " + String(i); return false;
-    }
-    memset(c.carName, 0, CAR_NAME_MAX_SIZE);
-    strncpy(c.carName, tempName, CAR_NAME_MAX_SIZE);
-    c.carNumber = i;
+typedef struct {
+  JsonStream_type stream;
+  BackupRestoreBlock_type* firstBlock;
+  BackupRestoreBlock_type* lastBlock;
+  uint16_t carCount;          /* Staged profiles 0..carCount-1 */
+  bool active;
+  String errorMsg;            /* Why a car entry was rejected */
+} BackupRestore_type;
 
-    /* Numeric fields */
-    uint16_t minSpeedRaw = 0;
-    if (!parseJsonHalfPercent(carJson, "minSpeed", &minSpeedRaw)) {
-      *errorMsg = "Error: invalid minSpeed in car " + String(i); return false;
-    }
-    c.minSpeed = minSpeedRaw;
+static portMUX_TYPE g_restoreMux = portMUX_INITIALIZER_UNLOCKED;
+static BackupRestore_type g_restore;
 
-    if (!parseJsonInt(carJson, "brake", v) || !inRange(v, 0, BRAKE_MAX_VALUE)) {
-      *errorMsg = "Error: invalid brake in car " + String(i); return false;
-    }
-    c.brake = v;
+static void backupRestoreFreeBlocks() {
+  BackupRestoreBlock_type* block = g_restore.firstBlock;
+  while (block != nullptr) {
+    BackupRestoreBlock_type* next = block->next;
+    free(block);
+    block = next;
+  }
+  g_restore.firstBlock = nullptr;
+  g_restore.lastBlock = nullptr;
+  g_restore.carCount = 0;
+}
 
-    if (!parseJsonInt(carJson, "maxSpeed", v) || !inRange(v, 5, 100)) {
-      *errorMsg = "Error: invalid maxSpeed in car " + String(i); return false;
-    }
-    c.maxSpeed = v;
+static CarParam_type* backupRestoreStagedCar(uint16_t index) {
+  BackupRestoreBlock_type* block = g_restore.firstBlock;
+  for (uint16_t b = index / BACKUP_RESTORE_BLOCK_CARS; b > 0 && block != nullptr; b--) {
+    block = block->next;
+  }
+  return (block != nullptr) ? &block->cars[index % BACKUP_RESTORE_BLOCK_CARS] : nullptr;
+}
 
-    if (!parseJsonInt(carJson, "curveInput", v) || !inRange(v, 0, THROTTLE_NORMALIZED)) {
-      *errorMsg = "Error: invalid curveInput in car " + String(i); return false;
+/**
+ * @brief Stage one "cars" entry (JsonStreamElement_fn)
+ */
+static bool backupRestoreOnCar(void* ctx, uint16_t index, const char* json, size_t len) {
+  (void)ctx;
+  if (index >= CAR_MAX_COUNT) {
+    return true;  /* More profiles than this build holds: ignored as before */
+  }
+  if ((g_restore.carCount % BACKUP_RESTORE_BLOCK_CARS) == 0) {
+    BackupRestoreBlock_type* block = (BackupRestoreBlock_type*)malloc(sizeof(BackupRestoreBlock_type));
+    if (block == nullptr) {
+      g_restore.errorMsg = "Error: out of memory at car " + String(index);
+      return false;
     }
-    c.throttleCurveVertex.inputThrottle = v;
-
-    if (!parseJsonInt(carJson, "curveDiff", v) || !inRange(v, THROTTLE_CURVE_SPEED_DIFF_MIN_VALUE, THROTTLE_CURVE_SPEED_DIFF_MAX_VALUE)) {
-      *errorMsg = "Error: invalid curveDiff in car " + String(i); return false;
+    block->next = nullptr;
+    if (g_restore.lastBlock != nullptr) {
+      g_restore.lastBlock->next = block;
+    } else {
+      g_restore.firstBlock = block;
     }
-    c.throttleCurveVertex.curveSpeedDiff = v;
-
-    if (parseJsonInt(carJson, "fade", v) && inRange(v, 0, FADE_MAX_VALUE))
-      c.fade = v;
+    g_restore.lastBlock = block;
+  }
+  CarParam_type* car = &g_restore.lastBlock->cars[g_restore.carCount % BACKUP_RESTORE_BLOCK_CARS];
+  carProfileRead(index, car);
+  if (!parseBackupCar(json, len, index, car, &g_restore.errorMsg)) {
+    return false;
+  }
+  g_restore.carCount++;
+  return true;
+}
 
-    if (!parseJsonInt(carJson, "antiSpin", v) || !inRange(v, 0, ANTISPIN_MAX_VALUE)) {
-      *errorMsg = "Error: invalid antiSpin in car " + String(i); return false;
-    }
-    c.antiSpin = v;
+/**
+ * @brief Claim the restore stream
+ * @return false if another restore (web or serial) is running
+ */
+static bool backupRestoreBegin() {
+  portENTER_CRITICAL(&g_restoreMux);
+  bool busy = g_restore.active;
+  g_restore.active = true;
+  portEXIT_CRITICAL(&g_restoreMux);
+  if (busy) {
+    return false;
+  }
+  backupRestoreFreeBlocks();
+  g_restore.errorMsg = "";
+  jsonStreamBegin(&g_restore.stream, "cars", backupRestoreOnCar, nullptr);
+  return true;
+}
 
-    if (!parseJsonInt(carJson, "freqPWM", v) || !inRange(v, FREQ_MIN_VALUE / 100, FREQ_MAX_VALUE / 100)) {
-      *errorMsg = "Error: invalid freqPWM in car " + String(i); return false;
-    }
-    c.freqPWM = v;
+static void backupRestoreFeed(const char* data, size_t len) {
+  jsonStreamFeed(&g_restore.stream, data, len);
+}
 
-    if (!parseJsonIntAlias(carJson, "altBrake", "brakeButton", v) || !inRange(v, 0, 100)) {
-      *errorMsg = "Error: invalid altBrake in car " + String(i); return false;
-    }
-    c.brakeButtonReduction = v;
+static void backupRestoreRelease() {
+  backupRestoreFreeBlocks();
+  g_restore.errorMsg = "";
+  portENTER_CRITICAL(&g_restoreMux);
+  g_restore.active = false;
+  portEXIT_CRITICAL(&g_restoreMux);
+}
 
-    /* Release-brake fields — optional for backwards compatibility with older backups */
-    uint16_t releaseMode = c.quickBrakeEnabled;
-    if (parseJsonReleaseModeAlias(carJson, "releaseMode", "quickBrakeEnabled", &releaseMode)) {
-      c.quickBrakeEnabled = releaseMode;
-    } else if (jsonHasKey(carJson, "releaseMode") || jsonHasKey(carJson, "quickBrakeEnabled")) {
-      *errorMsg = "Error: invalid releaseMode in car " + String(i); return false;
+/**
+ * @brief Validate what was streamed and, if all of it is good, apply and save it
+ * @details Releases the stream either way. The caller restarts after a success.
+ */
+static bool backupRestoreFinish(String* errorMsg, String* warningMsg) {
+  if (g_restore.stream.bytes == 0) {
+    *errorMsg = "Error: no file uploaded";
+    backupRestoreRelease();
+    return false;
+  }
+  if (!jsonStreamEnd(&g_restore.stream)) {
+    if (g_restore.stream.error == JSON_STREAM_ERR_REJECTED) {
+      *errorMsg = g_restore.errorMsg;
+    } else {
+      *errorMsg = "Error: " + String(jsonStreamErrorText(g_restore.stream.error));
     }
+    backupRestoreRelease();
+    return false;
+  }
 
-    if (parseJsonIntAlias(carJson, "releaseZone", "quickBrakeThreshold", v)) {
-      if (!inRange(v, 0, QUICK_BRAKE_THRESHOLD_MAX)) {
-        *errorMsg = "Error: invalid releaseZone in car " + String(i); return false;
-      }
-      c.quickBrakeThreshold = v;
-    } else if (jsonHasKey(carJson, "releaseZone") || jsonHasKey(carJson, "quickBrakeThreshold")) {
-      *errorMsg = "Error: invalid releaseZone in car " + String(i); return false;
-    }
+  StoredVar_type tempVar;
+  uint16_t tempAntiSpinStep = g_antiSpinStepMs;
+  uint16_t tempAntiSpinStepPct = g_antiSpinStepPct;
+  uint16_t tempAntiSpinDisplayMode = g_antiSpinDisplayMode;
+  uint16_t tempEncoderInvert = g_encoderInvertEnabled ? 1 : 0;
+  uint16_t tempAdcVoltageRange = g_adcVoltageRange_mV;
+  uint16_t tempWiFiMode = getConfiguredWiFiMode();
+  char tempWiFiSsid[WIFI_STA_SSID_MAX_LEN + 1];
+  char tempWiFiPassword[WIFI_STA_PASS_MAX_LEN + 1];
+  char tempUiAuthUsername[UI_AUTH_USER_MAX_LEN + 1];
+  char tempUiAuthPassword[UI_AUTH_PASS_MAX_LEN + 1];
+  getConfiguredWiFiClientSsid(tempWiFiSsid, sizeof(tempWiFiSsid));
+  getConfiguredWiFiClientPassword(tempWiFiPassword, sizeof(tempWiFiPassword));
+  getCurrentUiAuthUsername(tempUiAuthUsername, sizeof(tempUiAuthUsername));
+  getCurrentUiAuthPassword(tempUiAuthPassword, sizeof(tempUiAuthPassword));
+  if (!parseAndValidateJson(g_restore.stream.head, g_restore.stream.headLen, &tempVar, &tempAntiSpinStep,
+                            &tempAntiSpinStepPct, &tempAntiSpinDisplayMode,
+                            &tempEncoderInvert, &tempAdcVoltageRange,
+                            &tempWiFiMode, tempWiFiSsid, sizeof(tempWiFiSsid),
+                            tempWiFiPassword, sizeof(tempWiFiPassword),
+                            tempUiAuthUsername, sizeof(tempUiAuthUsername),
+                            tempUiAuthPassword, sizeof(tempUiAuthPassword),
+                            errorMsg, warningMsg)) {
+    backupRestoreRelease();
+    return false;
+  }
 
-    if (parseJsonIntAlias(carJson, "releaseLevel", "quickBrakeStrength", v)) {
-      if (!inRange(v, 0, QUICK_BRAKE_STRENGTH_MAX)) {
-        *errorMsg = "Error: invalid releaseLevel in car " + String(i); return false;
-      }
-      c.quickBrakeStrength = v;
-    } else if (jsonHasKey(carJson, "releaseLevel") || jsonHasKey(carJson, "quickBrakeStrength")) {
-      *errorMsg = "Error: invalid releaseLevel in car " + String(i); return false;
+  /* Only the active profile is held in tempVar; the others are queued once it is published */
+  uint16_t activeIndex = tempVar.activeCar.carNumber;
+  if (activeIndex < g_restore.carCount) {
+    tempVar.activeCar = *backupRestoreStagedCar(activeIndex);
+  }
+  activeTuningReplaceStoredVar(&tempVar);
+  for (uint16_t i = 0; i < g_restore.carCount; i++) {
+    if (i != activeIndex) {
+      carProfileWrite(i, backupRestoreStagedCar(i));
     }
   }
-
+  g_antiSpinStepMs = tempAntiSpinStep;
+  g_antiSpinStepPct = tempAntiSpinStepPct;
+  g_antiSpinDisplayMode = tempAntiSpinDisplayMode;
+  g_encoderInvertEnabled = tempEncoderInvert ? 1 : 0;
+  applyAdcVoltageRangeMilliVolts(tempAdcVoltageRange);
+  setConfiguredWiFiMode(tempWiFiMode);
+  setConfiguredWiFiClientCredentials(tempWiFiSsid, tempWiFiPassword);
+  setCurrentUiAuthCredentials(tempUiAuthUsername, tempUiAuthPassword);
+  saveEEPROM(g_storedVar);
+  settingsStoreFlush();
+  backupRestoreRelease();
   return true;
 }
 
@@ -1406,167 +1772,182 @@ static void appendJsonEscaped(String& out, const char* in) {
   }
 }
 
-static void appendHalfPercentField(String& out, const char* key, uint16_t sensiRaw, bool withTrailingComma) {
-  char buf[48];
-  snprintf(buf, sizeof(buf), "\"%s\":%u.%u%s",
-           key,
-           sensiRaw / SENSI_SCALE,
-           sensiFracDigit(sensiRaw),
-           withTrailingComma ? "," : "");
-  out += buf;
+static void writeHalfPercentField(JsonWriter_type* w, const char* key, uint16_t sensiRaw, bool withTrailingComma) {
+  jsonWriterPrintf(w, "\"%s\":%u.%u%s",
+                   key,
+                   sensiRaw / SENSI_SCALE,
+                   sensiFracDigit(sensiRaw),
+                   withTrailingComma ? "," : "");
 }
 
-static void appendSchemaIntField(
-  String& out, bool& first, const char* id, const char* label,
+static void writeSchemaIntField(
+  JsonWriter_type* w, bool& first, const char* id, const char* label,
   int32_t minVal, int32_t maxVal, int32_t step, const char* unit = nullptr) {
-  if (!first) out += ",";
+  if (!first) jsonWriterRaw(w, ",");
   first = false;
-  char buf[256];
-  snprintf(buf, sizeof(buf),
-           "{\"id\":\"%s\",\"label\":\"%s\",\"type\":\"int\",\"min\":%ld,\"max\":%ld,\"step\":%ld",
-           id, label, (long)minVal, (long)maxVal, (long)step);
-  out += buf;
+  jsonWriterPrintf(w, "{\"id\":\"%s\",\"label\":\"%s\",\"type\":\"int\",\"min\":%ld,\"max\":%ld,\"step\":%ld",
+                   id, label, (long)minVal, (long)maxVal, (long)step);
   if (unit != nullptr && unit[0] != '\0') {
-    out += ",\"unit\":\"";
-    out += unit;
-    out += "\"";
+    jsonWriterRaw(w, ",\"unit\":\"");
+    jsonWriterRaw(w, unit);
+    jsonWriterRaw(w, "\"");
   }
-  out += "}";
+  jsonWriterRaw(w, "}");
 }
 
-static void appendSchemaNumberField(
-  String& out, bool& first, const char* id, const char* label,
+static void writeSchemaNumberField(
+  JsonWriter_type* w, bool& first, const char* id, const char* label,
   const char* minVal, const char* maxVal, const char* step, const char* unit = nullptr) {
-  if (!first) out += ",";
+  if (!first) jsonWriterRaw(w, ",");
   first = false;
-  out += "{\"id\":\"";
-  out += id;
-  out += "\",\"label\":\"";
-  out += label;
-  out += "\",\"type\":\"int\",\"min\":";
-  out += minVal;
-  out += ",\"max\":";
-  out += maxVal;
-  out += ",\"step\":";
-  out += step;
+  jsonWriterRaw(w, "{\"id\":\"");
+  jsonWriterRaw(w, id);
+  jsonWriterRaw(w, "\",\"label\":\"");
+  jsonWriterRaw(w, label);
+  jsonWriterRaw(w, "\",\"type\":\"int\",\"min\":");
+  jsonWriterRaw(w, minVal);
+  jsonWriterRaw(w, ",\"max\":");
+  jsonWriterRaw(w, maxVal);
+  jsonWriterRaw(w, ",\"step\":");
+  jsonWriterRaw(w, step);
   if (unit != nullptr && unit[0] != '\0') {
-    out += ",\"unit\":\"";
-    out += unit;
-    out += "\"";
+    jsonWriterRaw(w, ",\"unit\":\"");
+    jsonWriterRaw(w, unit);
+    jsonWriterRaw(w, "\"");
   }
-  out += "}";
+  jsonWriterRaw(w, "}");
 }
 
-static void appendSchemaStringField(
-  String& out, bool& first, const char* id, const char* label, int32_t maxLen, bool secret = false) {
-  if (!first) out += ",";
+static void writeSchemaStringField(
+  JsonWriter_type* w, bool& first, const char* id, const char* label, int32_t maxLen, bool secret = false) {
+  if (!first) jsonWriterRaw(w, ",");
   first = false;
-  char buf[200];
-  snprintf(buf, sizeof(buf),
-           "{\"id\":\"%s\",\"label\":\"%s\",\"type\":\"string\",\"maxLen\":%ld",
-           id, label, (long)maxLen);
-  out += buf;
+  jsonWriterPrintf(w, "{\"id\":\"%s\",\"label\":\"%s\",\"type\":\"string\",\"maxLen\":%ld",
+                   id, label, (long)maxLen);
   if (secret) {
-    out += ",\"secret\":true";
+    jsonWriterRaw(w, ",\"secret\":true");
   }
-  out += "}";
+  jsonWriterRaw(w, "}");
 }
 
-static void appendSchemaEnumField(
-  String& out, bool& first, const char* id, const char* label, const char* optionsJson) {
-  if (!first) out += ",";
+static void writeSchemaEnumField(
+  JsonWriter_type* w, bool& first, const char* id, const char* label, const char* optionsJson) {
+  if (!first) jsonWriterRaw(w, ",");
   first = false;
-  out += "{\"id\":\"";
-  out += id;
-  out += "\",\"label\":\"";
-  out += label;
-  out += "\",\"type\":\"enum\",\"options\":";
-  out += optionsJson;
-  out += "}";
+  jsonWriterRaw(w, "{\"id\":\"");
+  jsonWriterRaw(w, id);
+  jsonWriterRaw(w, "\",\"label\":\"");
+  jsonWriterRaw(w, label);
+  jsonWriterRaw(w, "\",\"type\":\"enum\",\"options\":");
+  jsonWriterRaw(w, optionsJson);
+  jsonWriterRaw(w, "}");
 }
 
-static String buildSchemaJson() {
+static void writeSchemaJson(JsonWriter_type* w, const void* arg) {
+  (void)arg;
   loadWiFiNetworkSettingsIfNeeded();
-  String json;
-  json.reserve(5500);
+  jsonWriterRaw(w, "{");
+  jsonWriterPrintf(w, "\"fwVersion\":\"%d.%d\",", SW_MAJOR_VERSION, SW_MINOR_VERSION);
+  jsonWriterPrintf(w, "\"carCount\":%d,", CAR_MAX_COUNT);
 
-  char buf[64];
-  json += "{";
-  snprintf(buf, sizeof(buf), "\"fwVersion\":\"%d.%d\",", SW_MAJOR_VERSION, SW_MINOR_VERSION);
-  json += buf;
-  snprintf(buf, sizeof(buf), "\"carCount\":%d,", CAR_MAX_COUNT);
-  json += buf;
-
-  json += "\"global\":[";
+  jsonWriterRaw(w, "\"global\":[");
   bool first = true;
-  appendSchemaIntField(json, first, "selectedCarNumber", "Active Car", 0, CAR_MAX_COUNT - 1, 1);
-  appendSchemaEnumField(json, first, "viewMode", "View Mode",
+  writeSchemaIntField(w, first, "selectedCarNumber", "Active Car", 0, CAR_MAX_COUNT - 1, 1);
+  writeSchemaEnumField(w, first, "viewMode", "View Mode",
                         "[{\"value\":0,\"label\":\"LIST\"},{\"value\":1,\"label\":\"GRID\"}]");
-  appendSchemaIntField(json, first, "screensaverTimeout", "Screensaver Timeout", 0, SCREENSAVER_TIMEOUT_MAX, 1, "s");
-  appendSchemaIntField(json, first, "powerSaveTimeout", "Sleep Timeout", 0, POWER_SAVE_TIMEOUT_MAX, 1, "min");
-  appendSchemaIntField(json, first, "deepSleepTimeout", "Deep Sleep Timeout", 0, DEEP_SLEEP_TIMEOUT_MAX, 1, "min");
-  appendSchemaEnumField(json, first, "soundBoot", "Boot Sound",
+  writeSchemaIntField(w, first, "screensaverTimeout", "Screensaver Timeout", 0, SCREENSAVER_TIMEOUT_MAX, 1, "s");
+  writeSchemaIntField(w, first, "powerSaveTimeout", "Sleep Timeout", 0, POWER_SAVE_TIMEOUT_MAX, 1, "min");
+  writeSchemaIntField(w, first, "deepSleepTimeout", "Deep Sleep Timeout", 0, DEEP_SLEEP_TIMEOUT_MAX, 1, "min");
+  writeSchemaEnumField(w, first, "soundBoot", "Boot Sound",
                         "[{\"value\":0,\"label\":\"OFF\"},{\"value\":1,\"label\":\"ON\"}]");
-  appendSchemaEnumField(json, first, "soundRace", "Race Sound",
+  writeSchemaEnumField(w, first, "soundRace", "Race Sound",
                         "[{\"value\":0,\"label\":\"OFF\"},{\"value\":1,\"label\":\"ON\"}]");
-  appendSchemaEnumField(json, first, "antiSpinDisplayMode", "ANTIS Display",
+  writeSchemaEnumField(w, first, "antiSpinDisplayMode", "ANTIS Display",
                         "[{\"value\":0,\"label\":\"MS\"},{\"value\":1,\"label\":\"%\"},{\"value\":2,\"label\":\"TEXT\"}]");
-  appendSchemaIntField(json, first, "antiSpinStepMs", "ANTIS Step (ms)", ANTISPIN_STEP_MIN, ANTISPIN_STEP_MAX, 1, "ms");
-  appendSchemaIntField(json, first, "antiSpinStepPct", "ANTIS Step (%)", ANTISPIN_STEP_PCT_MIN, ANTISPIN_STEP_PCT_MAX, 1, "%");
-  appendSchemaEnumField(json, first, "encoderInvert", "ENC INV",
+  writeSchemaIntField(w, first, "antiSpinStepMs", "ANTIS Step (ms)", ANTISPIN_STEP_MIN, ANTISPIN_STEP_MAX, 1, "ms");
+  writeSchemaIntField(w, first, "antiSpinStepPct", "ANTIS Step (%)", ANTISPIN_STEP_PCT_MIN, ANTISPIN_STEP_PCT_MAX, 1, "%");
+  writeSchemaEnumField(w, first, "encoderInvert", "ENC INV",
                         "[{\"value\":0,\"label\":\"OFF\"},{\"value\":1,\"label\":\"ON\"}]");
-  appendSchemaIntField(json, first, "adcVoltageRangeMv", "VIN CAL ADC", ADC_VOLTAGE_RANGE_MIN_MVOLTS, ADC_VOLTAGE_RANGE_MAX_MVOLTS, 1, "mV");
-  appendSchemaEnumField(json, first, "gridCarSelectEnabled", "Grid Car Select",
+  writeSchemaIntField(w, first, "adcVoltageRangeMv", "VIN CAL ADC", ADC_VOLTAGE_RANGE_MIN_MVOLTS, ADC_VOLTAGE_RANGE_MAX_MVOLTS, 1, "mV");
+  writeSchemaEnumField(w, first, "gridCarSelectEnabled", "Grid Car Select",
                         "[{\"value\":0,\"label\":\"OFF\"},{\"value\":1,\"label\":\"ON\"}]");
-  appendSchemaEnumField(json, first, "raceViewMode", "Race Mode",
+  writeSchemaEnumField(w, first, "raceViewMode", "Race Mode",
                         "[{\"value\":0,\"label\":\"OFF\"},{\"value\":1,\"label\":\"FULL\"},{\"value\":2,\"label\":\"SIMPLE\"}]");
-  appendSchemaEnumField(json, first, "language", "Language",
+  writeSchemaEnumField(w, first, "language", "Language",
                         "[{\"value\":0,\"label\":\"NOR\"},{\"value\":1,\"label\":\"ENG\"},{\"value\":2,\"label\":\"CS\"},{\"value\":3,\"label\":\"ACD\"},{\"value\":4,\"label\":\"ESP\"},{\"value\":5,\"label\":\"DEU\"},{\"value\":6,\"label\":\"ITA\"},{\"value\":7,\"label\":\"NLD\"},{\"value\":8,\"label\":\"POR\"}]");
-  appendSchemaEnumField(json, first, "textCase", "Text Case",
+  writeSchemaEnumField(w, first, "textCase", "Text Case",
                         "[{\"value\":0,\"label\":\"UPPER\"},{\"value\":1,\"label\":\"Pascal\"}]");
-  appendSchemaEnumField(json, first, "listFontSize", "Font Size",
+  writeSchemaEnumField(w, first, "listFontSize", "Font Size",
                         "[{\"value\":0,\"label\":\"LARGE\"},{\"value\":1,\"label\":\"small\"}]");
-  appendSchemaIntField(json, first, "startupDelay", "Startup Delay", STARTUP_DELAY_MIN, STARTUP_DELAY_MAX, 1, "x10ms");
-  appendSchemaEnumField(json, first, "wifiMode", "WiFi Mode",
+  writeSchemaIntField(w, first, "startupDelay", "Startup Delay", STARTUP_DELAY_MIN, STARTUP_DELAY_MAX, 1, "x10ms");
+  writeSchemaEnumField(w, first, "wifiMode", "WiFi Mode",
                         "[{\"value\":0,\"label\":\"AP\"},{\"value\":1,\"label\":\"CLIENT\"}]");
-  appendSchemaStringField(json, first, "wifiStaSsid", "Client WiFi SSID", WIFI_STA_SSID_MAX_LEN);
-  appendSchemaStringField(json, first, "wifiStaPassword", "Client WiFi Password", WIFI_STA_PASS_MAX_LEN, true);
-  appendSchemaEnumField(json, first, "wifiStaPasswordClear", "Clear Saved Client WiFi Password",
+  writeSchemaStringField(w, first, "wifiStaSsid", "Client WiFi SSID", WIFI_STA_SSID_MAX_LEN);
+  writeSchemaStringField(w, first, "wifiStaPassword", "Client WiFi Password", WIFI_STA_PASS_MAX_LEN, true);
+  writeSchemaEnumField(w, first, "wifiStaPasswordClear", "Clear Saved Client WiFi Password",
                         "[{\"value\":0,\"label\":\"KEEP\"},{\"value\":1,\"label\":\"CLEAR\"}]");
-  appendSchemaStringField(json, first, "uiAuthPassword", "Controller Login Password", UI_AUTH_PASS_MAX_LEN, true);
-  appendSchemaEnumField(json, first, "uiAuthResetDefault", "Reset Controller Login To Default",
+  writeSchemaStringField(w, first, "uiAuthPassword", "Controller Login Password", UI_AUTH_PASS_MAX_LEN, true);
+  writeSchemaEnumField(w, first, "uiAuthResetDefault", "Reset Controller Login To Default",
                         "[{\"value\":0,\"label\":\"KEEP\"},{\"value\":1,\"label\":\"RESET\"}]");
-  appendSchemaEnumField(json, first, "statusSlot0", "Status Slot 1",
-                        "[{\"value\":0,\"label\":\"BLANK\"},{\"value\":1,\"label\":\"OUTPUT\"},{\"value\":2,\"label\":\"THROTTLE\"},{\"value\":3,\"label\":\"CAR\"},{\"value\":4,\"label\":\"CURR\"},{\"value\":5,\"label\":\"VOLTAGE\"},{\"value\":7,\"label\":\"ACTIVE BRAKE\"}]");
-  appendSchemaEnumField(json, first, "statusSlot1", "Status Slot 2",
-                        "[{\"value\":0,\"label\":\"BLANK\"},{\"value\":1,\"label\":\"OUTPUT\"},{\"value\":2,\"label\":\"THROTTLE\"},{\"value\":3,\"label\":\"CAR\"},{\"value\":4,\"label\":\"CURR\"},{\"value\":5,\"label\":\"VOLTAGE\"},{\"value\":7,\"label\":\"ACTIVE BRAKE\"}]");
-  appendSchemaEnumField(json, first, "statusSlot2", "Status Slot 3",
-                        "[{\"value\":0,\"label\":\"BLANK\"},{\"value\":1,\"label\":\"OUTPUT\"},{\"value\":2,\"label\":\"THROTTLE\"},{\"value\":3,\"label\":\"CAR\"},{\"value\":4,\"label\":\"CURR\"},{\"value\":5,\"label\":\"VOLTAGE\"},{\"value\":7,\"label\":\"ACTIVE BRAKE\"}]");
-  appendSchemaEnumField(json, first, "statusSlot3", "Status Slot 4",
-                        "[{\"value\":0,\"label\":\"BLANK\"},{\"value\":1,\"label\":\"OUTPUT\"},{\"value\":2,\"label\":\"THROTTLE\"},{\"value\":3,\"label\":\"CAR\"},{\"value\":4,\"label\":\"CURR\"},{\"value\":5,\"label\":\"VOLTAGE\"},{\"value\":7,\"label\":\"ACTIVE BRAKE\"}]");
-  appendSchemaStringField(json, first, "screensaverLine1", "Screensaver Line 1", SCREENSAVER_TEXT_MAX - 1);
-  appendSchemaStringField(json, first, "screensaverLine2", "Screensaver Line 2", SCREENSAVER_TEXT_MAX - 1);
-  json += "],";
-
-  json += "\"car\":[";
+  writeSchemaEnumField(w, first, "statusSlot0", "Status Slot 1",
+                        "[{\"value\":0,\"label\":\"BLANK\"},{\"value\":1,\"label\":\"OUTPUT\"},{\"value\":2,\"label\":\"THROTTLE\"},{\"value\":3,\"label\":\"CAR\"},{\"value\":4,\"label\":\"CURR\"},{\"value\":5,\"label\":\"VOLTAGE\"},{\"value\":7,\"label\":\"ACTIVE BRAKE\"},{\"value\":8,\"label\":\"TEMP\"}]");
+  writeSchemaEnumField(w, first, "statusSlot1", "Status Slot 2",
+                        "[{\"value\":0,\"label\":\"BLANK\"},{\"value\":1,\"label\":\"OUTPUT\"},{\"value\":2,\"label\":\"THROTTLE\"},{\"value\":3,\"label\":\"CAR\"},{\"value\":4,\"label\":\"CURR\"},{\"value\":5,\"label\":\"VOLTAGE\"},{\"value\":7,\"label\":\"ACTIVE BRAKE\"},{\"value\":8,\"label\":\"TEMP\"}]");
+  writeSchemaEnumField(w, first, "statusSlot2", "Status Slot 3",
+                        "[{\"value\":0,\"label\":\"BLANK\"},{\"value\":1,\"label\":\"OUTPUT\"},{\"value\":2,\"label\":\"THROTTLE\"},{\"value\":3,\"label\":\"CAR\"},{\"value\":4,\"label\":\"CURR\"},{\"value\":5,\"label\":\"VOLTAGE\"},{\"value\":7,\"label\":\"ACTIVE BRAKE\"},{\"value\":8,\"label\":\"TEMP\"}]");
+  writeSchemaEnumField(w, first, "statusSlot3", "Status Slot 4",
+                        "[{\"value\":0,\"label\":\"BLANK\"},{\"value\":1,\"label\":\"OUTPUT\"},{\"value\":2,\"label\":\"THROTTLE\"},{\"value\":3,\"label\":\"CAR\"},{\"value\":4,\"label\":\"CURR\"},{\"value\":5,\"label\":\"VOLTAGE\"},{\"value\":7,\"label\":\"ACTIVE BRAKE\"},{\"value\":8,\"label\":\"TEMP\"}]");
+  writeSchemaStringField(w, first, "screensaverLine1", "Screensaver Line 1", SCREENSAVER_TEXT_MAX - 1);
+  writeSchemaStringField(w, first, "screensaverLine2", "Screensaver Line 2", SCREENSAVER_TEXT_MAX - 1);
+  jsonWriterRaw(w, "],");
+
+  jsonWriterRaw(w, "\"car\":[");
   first = true;
-  appendSchemaStringField(json, first, "carName", "Profile Name", CAR_NAME_MAX_SIZE - 1);
-  appendSchemaNumberField(json, first, "minSpeed", "SENSI", "0.0", "90.0", "0.5", "%");
-  appendSchemaIntField(json, first, "brake", "BRAKE", 0, BRAKE_MAX_VALUE, 1, "%");
-  appendSchemaIntField(json, first, "maxSpeed", "LIMIT", 5, 100, 1, "%");
-  appendSchemaIntField(json, first, "curveDiff", "CURVE", THROTTLE_CURVE_SPEED_DIFF_MIN_VALUE, THROTTLE_CURVE_SPEED_DIFF_MAX_VALUE, 1, "%");
-  appendSchemaIntField(json, first, "fade", "FADE", 0, FADE_MAX_VALUE, 1, "%");
-  appendSchemaIntField(json, first, "antiSpin", "ANTIS", 0, ANTISPIN_MAX_VALUE, 1, "ms");
-  appendSchemaIntField(json, first, "freqPWM", "PWM_F", FREQ_MIN_VALUE / 100, FREQ_MAX_VALUE / 100, 1, "x0.1kHz");
-  appendSchemaIntField(json, first, "brakeButton", "Alt.Brake", 0, 100, 1, "%");
-  appendSchemaEnumField(json, first, "quickBrakeEnabled", "Rel.Brake",
+  writeSchemaStringField(w, first, "carName", "Profile Name", CAR_NAME_MAX_SIZE - 1);
+  writeSchemaNumberField(w, first, "minSpeed", "SENSI", "0.0", "90.0", "0.5", "%");
+  writeSchemaIntField(w, first, "brake", "BRAKE", 0, BRAKE_MAX_VALUE, 1, "%");
+  writeSchemaIntField(w, first, "maxSpeed", "LIMIT", 5, 100, 1, "%");
+  writeSchemaIntField(w, first, "curveDiff", "CURVE", THROTTLE_CURVE_SPEED_DIFF_MIN_VALUE, THROTTLE_CURVE_SPEED_DIFF_MAX_VALUE, 1, "%");
+  writeSchemaEnumField(w, first, "curveMode", "CURVE Mode",
+                        "[{\"value\":0,\"label\":\"VERTEX\"},{\"value\":1,\"label\":\"LINEAR\"},{\"value\":2,\"label\":\"SPLINE\"}]");
+  writeSchemaStringField(w, first, "curvePoints", "CURVE Points (in%:out%,...)", THROTTLE_CURVE_TEXT_MAX - 1);
+  writeSchemaIntField(w, first, "fade", "FADE", 0, FADE_MAX_VALUE, 1, "%");
+  writeSchemaIntField(w, first, "antiSpin", "ANTIS", 0, ANTISPIN_MAX_VALUE, 1, "ms");
+  writeSchemaIntField(w, first, "freqPWM", "PWM_F", FREQ_MIN_VALUE / 100, FREQ_MAX_VALUE / 100, 1, "x0.1kHz");
+  writeSchemaIntField(w, first, "brakeButton", "Alt.Brake", 0, 100, 1, "%");
+  writeSchemaEnumField(w, first, "quickBrakeEnabled", "Rel.Brake",
                         "[{\"value\":0,\"label\":\"OFF\"},{\"value\":1,\"label\":\"QUICK\"},{\"value\":2,\"label\":\"DRAG\"}]");
-  appendSchemaIntField(json, first, "quickBrakeThreshold", "Rel.Brake Zone", 0, QUICK_BRAKE_THRESHOLD_MAX, 1, "%");
-  appendSchemaIntField(json, first, "quickBrakeStrength", "Rel.Brake Level", 0, QUICK_BRAKE_STRENGTH_MAX, 1, "%");
-  json += "]";
-  json += "}";
-  return json;
-}
+  writeSchemaIntField(w, first, "quickBrakeThreshold", "Rel.Brake Zone", 0, QUICK_BRAKE_THRESHOLD_MAX, 1, "%");
+  writeSchemaIntField(w, first, "quickBrakeStrength", "Rel.Brake Level", 0, QUICK_BRAKE_STRENGTH_MAX, 1, "%");
+  writeSchemaEnumField(w, first, "antiSpinMode", "ANTIS Mode",
+                        "[{\"value\":0,\"label\":\"RAMP\"},{\"value\":1,\"label\":\"TRACTION\"}]");
+  writeSchemaIntField(w, first, "brakeBite", "Brake Bite", 0, BRAKE_BITE_MAX, 1, "%");
+  writeSchemaIntField(w, first, "brakeBiteHold", "Brake Hold", 0, BRAKE_BITE_HOLD_MAX, BRAKE_ENVELOPE_MS_STEP, "ms");
+  writeSchemaIntField(w, first, "brakeRamp", "Brake Ramp", 0, BRAKE_RAMP_MAX, BRAKE_ENVELOPE_MS_STEP, "ms");
+  jsonWriterRaw(w, "]}");
+}
+
+/* Revisioned state for /api/state?since=<rev>&epoch=<epoch>.
+ * Every reply carries the latest revision handed out and a per-boot epoch. A client that
+ * sends them back gets 304 if neither the global block nor its car moved past that
+ * revision, otherwise only the blocks that did ("delta":1). Revisions are per block, so a
+ * changed block is resent whole. WiFiTask only (HTTP handlers and the serial pump). */
+static uint32_t g_stateEpoch = 0;
+static uint32_t g_stateRev = 0;
+static uint32_t g_stateGlobalRev = 0;
+static uint32_t g_stateGlobalHash = 0;
+static bool g_stateGlobalSeen = false;
+static uint32_t g_stateCarRev[CAR_MAX_COUNT];
+static uint32_t g_stateCarHash[CAR_MAX_COUNT];
+static uint32_t g_stateCarSeen[(CAR_MAX_COUNT + 31) / 32];
+
+typedef struct {
+  uint8_t carIndex;
+  bool delta;       /* Reply to ?since=: some blocks may be left out */
+  bool global;
+  bool carBlock;
+  CarParam_type car;
+} StateReply_type;
 
 static uint8_t getRequestedCarIndex() {
   if (g_wifiServer != nullptr && g_wifiServer->hasArg("car")) {
@@ -1576,79 +1957,205 @@ static uint8_t getRequestedCarIndex() {
   return (uint8_t)g_storedVar.selectedCarNumber;
 }
 
-static String buildStateJson(uint8_t carIndex) {
+static void writeStateGlobalBlock(JsonWriter_type* w) {
+  jsonWriterRaw(w, "{");
+  jsonWriterPrintf(w, "\"selectedCarNumber\":%u,", g_storedVar.selectedCarNumber);
+  jsonWriterPrintf(w, "\"viewMode\":%u,", g_storedVar.viewMode);
+  jsonWriterPrintf(w, "\"screensaverTimeout\":%u,", g_storedVar.screensaverTimeout);
+  jsonWriterPrintf(w, "\"powerSaveTimeout\":%u,", g_storedVar.powerSaveTimeout);
+  jsonWriterPrintf(w, "\"deepSleepTimeout\":%u,", g_storedVar.deepSleepTimeout);
+  jsonWriterPrintf(w, "\"soundBoot\":%u,", g_storedVar.soundBoot);
+  jsonWriterPrintf(w, "\"soundRace\":%u,", g_storedVar.soundRace);
+  jsonWriterPrintf(w, "\"antiSpinDisplayMode\":%u,", g_antiSpinDisplayMode);
+  jsonWriterPrintf(w, "\"antiSpinStepMs\":%u,", g_antiSpinStepMs);
+  jsonWriterPrintf(w, "\"antiSpinStepPct\":%u,", g_antiSpinStepPct);
+  jsonWriterPrintf(w, "\"encoderInvert\":%u,", g_encoderInvertEnabled ? 1 : 0);
+  jsonWriterPrintf(w, "\"adcVoltageRangeMv\":%u,", g_adcVoltageRange_mV);
+  jsonWriterPrintf(w, "\"gridCarSelectEnabled\":%u,", g_storedVar.gridCarSelectEnabled);
+  jsonWriterPrintf(w, "\"raceViewMode\":%u,", g_storedVar.raceViewMode);
+  jsonWriterPrintf(w, "\"language\":%u,", g_storedVar.language);
+  jsonWriterPrintf(w, "\"textCase\":%u,", g_storedVar.textCase);
+  jsonWriterPrintf(w, "\"listFontSize\":%u,", g_storedVar.listFontSize);
+  jsonWriterPrintf(w, "\"startupDelay\":%u,", g_storedVar.startupDelay);
+  jsonWriterPrintf(w, "\"wifiMode\":%u,", g_wifiConfiguredMode);
+  jsonWriterPrintf(w, "\"statusSlot0\":%u,", normalizeStatusSlotForUi(g_storedVar.statusSlot[0]));
+  jsonWriterPrintf(w, "\"statusSlot1\":%u,", normalizeStatusSlotForUi(g_storedVar.statusSlot[1]));
+  jsonWriterPrintf(w, "\"statusSlot2\":%u,", normalizeStatusSlotForUi(g_storedVar.statusSlot[2]));
+  jsonWriterPrintf(w, "\"statusSlot3\":%u,", normalizeStatusSlotForUi(g_storedVar.statusSlot[3]));
+  jsonWriterRaw(w, "\"screensaverLine1\":\"");
+  jsonWriterEscaped(w, g_storedVar.screensaverLine1);
+  jsonWriterRaw(w, "\",\"screensaverLine2\":\"");
+  jsonWriterEscaped(w, g_storedVar.screensaverLine2);
+  jsonWriterRaw(w, "\",\"wifiStaSsid\":\"");
+  jsonWriterEscaped(w, g_wifiClientSsid);
+  jsonWriterPrintf(w, "\",\"wifiStaPasswordSet\":%u,\"wifiStaPasswordClear\":0,\"uiAuthPasswordSet\":%u,\"uiAuthResetDefault\":0,\"uiAuthDefault\":%u}",
+                   g_wifiClientPassword[0] != '\0' ? 1U : 0U,
+                   g_uiAuthPassword[0] != '\0' ? 1U : 0U,
+                   areCurrentUiAuthCredentialsDefault() ? 1U : 0U);
+}
+
+static void writeStateCarBlock(JsonWriter_type* w, const CarParam_type& c) {
+  jsonWriterRaw(w, "{");
+  jsonWriterRaw(w, "\"carName\":\"");
+  jsonWriterEscaped(w, c.carName);
+  jsonWriterRaw(w, "\",");
+  writeHalfPercentField(w, "minSpeed", c.minSpeed, true);
+  jsonWriterPrintf(w, "\"brake\":%u,", c.brake);
+  jsonWriterPrintf(w, "\"maxSpeed\":%u,", c.maxSpeed);
+  jsonWriterPrintf(w, "\"curveDiff\":%u,", c.throttleCurveVertex.curveSpeedDiff);
+  char curvePoints[THROTTLE_CURVE_TEXT_MAX];
+  throttleCurveShapeFormat(&c.throttleCurveShape, curvePoints, sizeof(curvePoints));
+  jsonWriterPrintf(w, "\"curveMode\":%u,\"curvePoints\":\"%s\",", c.throttleCurveShape.mode, curvePoints);
+  jsonWriterPrintf(w, "\"fade\":%u,", c.fade);
+  jsonWriterPrintf(w, "\"antiSpin\":%u,", c.antiSpin);
+  jsonWriterPrintf(w, "\"freqPWM\":%u,", c.freqPWM);
+  jsonWriterPrintf(w, "\"brakeButton\":%u,", c.brakeButtonReduction);
+  jsonWriterPrintf(w, "\"quickBrakeEnabled\":%u,", c.quickBrakeEnabled);
+  jsonWriterPrintf(w, "\"quickBrakeThreshold\":%u,", c.quickBrakeThreshold);
+  jsonWriterPrintf(w, "\"quickBrakeStrength\":%u,", c.quickBrakeStrength);
+  jsonWriterPrintf(w, "\"antiSpinMode\":%u,", c.antiSpinMode);
+  jsonWriterPrintf(w, "\"brakeBite\":%u,", c.brakeBite);
+  jsonWriterPrintf(w, "\"brakeBiteHold\":%u,", c.brakeBiteHold);
+  jsonWriterPrintf(w, "\"brakeRamp\":%u", c.brakeRamp);
+  jsonWriterRaw(w, "}");
+}
+
+/* JsonWriterSink_fn; ctx is the running CRC-32 */
+static void crcJsonSink(void* ctx, const char* data, size_t len) {
+  uint32_t* crc = (uint32_t*)ctx;
+  *crc = esp_rom_crc32_le(*crc, (const uint8_t*)data, (uint32_t)len);
+}
+
+/**
+ * @brief Move a block to a new revision if its serialized text changed since it was last served
+ * @details Hashing the output instead of bumping at every writer also catches the menu
+ *          edits (Task1 writes g_storedVar in place), restores and anything added later.
+ *          A block seen for the first time gets a fresh revision too.
+ */
+static void stateRevisionTrack(uint32_t hash, uint32_t* lastHash, uint32_t* rev, bool* seen) {
+  if (*seen && *lastHash == hash) {
+    return;
+  }
+  *lastHash = hash;
+  *rev = ++g_stateRev;
+  *seen = true;
+}
+
+/**
+ * @brief Hash the global block and one car, bumping whichever changed (WiFiTask)
+ */
+static void stateRevisionRefresh(uint8_t carIndex, const CarParam_type& c) {
+  if (g_stateEpoch == 0) {
+    g_stateEpoch = esp_random() | 1U;
+  }
+  JsonWriter_type w;
+  uint32_t crc = 0;
+  jsonWriterBegin(&w, crcJsonSink, &crc);
+  writeStateGlobalBlock(&w);
+  jsonWriterEnd(&w);
+  stateRevisionTrack(crc, &g_stateGlobalHash, &g_stateGlobalRev, &g_stateGlobalSeen);
+
+  crc = 0;
+  jsonWriterBegin(&w, crcJsonSink, &crc);
+  writeStateCarBlock(&w, c);
+  jsonWriterEnd(&w);
+  bool seen = (g_stateCarSeen[carIndex / 32U] & (1UL << (carIndex % 32U))) != 0;
+  stateRevisionTrack(crc, &g_stateCarHash[carIndex], &g_stateCarRev[carIndex], &seen);
+  g_stateCarSeen[carIndex / 32U] |= (1UL << (carIndex % 32U));
+}
+
+/**
+ * @brief Capture one car and work out which blocks a reply needs
+ * @param since Revision the client already holds; 0 (or another boot's epoch) for everything
+ */
+static void prepareStateReply(StateReply_type* reply, uint8_t carIndex, uint32_t epoch, uint32_t since) {
   loadWiFiNetworkSettingsIfNeeded();
   if (carIndex >= CAR_MAX_COUNT) carIndex = (uint8_t)g_storedVar.selectedCarNumber;
-  const CarParam_type& c = g_storedVar.carParam[carIndex];
+  reply->carIndex = carIndex;
+  carProfileRead(carIndex, &reply->car);
+  stateRevisionRefresh(carIndex, reply->car);
 
-  String json;
-  json.reserve(2600);
-  char buf[160];
-
-  json += "{";
-  snprintf(buf, sizeof(buf), "\"selectedCarNumber\":%u,", g_storedVar.selectedCarNumber);
-  json += buf;
-  snprintf(buf, sizeof(buf), "\"carIndex\":%u,", carIndex);
-  json += buf;
-
-  json += "\"global\":{";
-  snprintf(buf, sizeof(buf), "\"selectedCarNumber\":%u,", g_storedVar.selectedCarNumber); json += buf;
-  snprintf(buf, sizeof(buf), "\"viewMode\":%u,", g_storedVar.viewMode); json += buf;
-  snprintf(buf, sizeof(buf), "\"screensaverTimeout\":%u,", g_storedVar.screensaverTimeout); json += buf;
-  snprintf(buf, sizeof(buf), "\"powerSaveTimeout\":%u,", g_storedVar.powerSaveTimeout); json += buf;
-  snprintf(buf, sizeof(buf), "\"deepSleepTimeout\":%u,", g_storedVar.deepSleepTimeout); json += buf;
-  snprintf(buf, sizeof(buf), "\"soundBoot\":%u,", g_storedVar.soundBoot); json += buf;
-  snprintf(buf, sizeof(buf), "\"soundRace\":%u,", g_storedVar.soundRace); json += buf;
-  snprintf(buf, sizeof(buf), "\"antiSpinDisplayMode\":%u,", g_antiSpinDisplayMode); json += buf;
-  snprintf(buf, sizeof(buf), "\"antiSpinStepMs\":%u,", g_antiSpinStepMs); json += buf;
-  snprintf(buf, sizeof(buf), "\"antiSpinStepPct\":%u,", g_antiSpinStepPct); json += buf;
-  snprintf(buf, sizeof(buf), "\"encoderInvert\":%u,", g_encoderInvertEnabled ? 1 : 0); json += buf;
-  snprintf(buf, sizeof(buf), "\"adcVoltageRangeMv\":%u,", g_adcVoltageRange_mV); json += buf;
-  snprintf(buf, sizeof(buf), "\"gridCarSelectEnabled\":%u,", g_storedVar.gridCarSelectEnabled); json += buf;
-  snprintf(buf, sizeof(buf), "\"raceViewMode\":%u,", g_storedVar.raceViewMode); json += buf;
-  snprintf(buf, sizeof(buf), "\"language\":%u,", g_storedVar.language); json += buf;
-  snprintf(buf, sizeof(buf), "\"textCase\":%u,", g_storedVar.textCase); json += buf;
-  snprintf(buf, sizeof(buf), "\"listFontSize\":%u,", g_storedVar.listFontSize); json += buf;
-  snprintf(buf, sizeof(buf), "\"startupDelay\":%u,", g_storedVar.startupDelay); json += buf;
-  snprintf(buf, sizeof(buf), "\"wifiMode\":%u,", g_wifiConfiguredMode); json += buf;
-  snprintf(buf, sizeof(buf), "\"statusSlot0\":%u,", normalizeStatusSlotForUi(g_storedVar.statusSlot[0])); json += buf;
-  snprintf(buf, sizeof(buf), "\"statusSlot1\":%u,", normalizeStatusSlotForUi(g_storedVar.statusSlot[1])); json += buf;
-  snprintf(buf, sizeof(buf), "\"statusSlot2\":%u,", normalizeStatusSlotForUi(g_storedVar.statusSlot[2])); json += buf;
-  snprintf(buf, sizeof(buf), "\"statusSlot3\":%u,", normalizeStatusSlotForUi(g_storedVar.statusSlot[3])); json += buf;
-  json += "\"screensaverLine1\":\"";
-  appendJsonEscaped(json, g_storedVar.screensaverLine1);
-  json += "\",\"screensaverLine2\":\"";
-  appendJsonEscaped(json, g_storedVar.screensaverLine2);
-  json += "\",\"wifiStaSsid\":\"";
-  appendJsonEscaped(json, g_wifiClientSsid);
-  snprintf(buf, sizeof(buf),
-           "\",\"wifiStaPasswordSet\":%u,\"wifiStaPasswordClear\":0,\"uiAuthPasswordSet\":%u,\"uiAuthResetDefault\":0,\"uiAuthDefault\":%u},",
-           g_wifiClientPassword[0] != '\0' ? 1U : 0U,
-           g_uiAuthPassword[0] != '\0' ? 1U : 0U,
-           areCurrentUiAuthCredentialsDefault() ? 1U : 0U);
-  json += buf;
-
-  json += "\"car\":{";
-  json += "\"carName\":\"";
-  appendJsonEscaped(json, c.carName);
-  json += "\",";
-  appendHalfPercentField(json, "minSpeed", c.minSpeed, true);
-  snprintf(buf, sizeof(buf), "\"brake\":%u,", c.brake); json += buf;
-  snprintf(buf, sizeof(buf), "\"maxSpeed\":%u,", c.maxSpeed); json += buf;
-  snprintf(buf, sizeof(buf), "\"curveDiff\":%u,", c.throttleCurveVertex.curveSpeedDiff); json += buf;
-  snprintf(buf, sizeof(buf), "\"fade\":%u,", c.fade); json += buf;
-  snprintf(buf, sizeof(buf), "\"antiSpin\":%u,", c.antiSpin); json += buf;
-  snprintf(buf, sizeof(buf), "\"freqPWM\":%u,", c.freqPWM); json += buf;
-  snprintf(buf, sizeof(buf), "\"brakeButton\":%u,", c.brakeButtonReduction); json += buf;
-  snprintf(buf, sizeof(buf), "\"quickBrakeEnabled\":%u,", c.quickBrakeEnabled); json += buf;
-  snprintf(buf, sizeof(buf), "\"quickBrakeThreshold\":%u,", c.quickBrakeThreshold); json += buf;
-  snprintf(buf, sizeof(buf), "\"quickBrakeStrength\":%u", c.quickBrakeStrength); json += buf;
-  json += "}";
-  json += "}";
-  return json;
+  bool delta = (since != 0 && epoch == g_stateEpoch && since <= g_stateRev);
+  reply->delta = delta;
+  reply->global = !delta || g_stateGlobalRev > since;
+  reply->carBlock = !delta || g_stateCarRev[carIndex] > since;
+}
+
+static void writeStateReply(JsonWriter_type* w, const StateReply_type* reply) {
+  jsonWriterRaw(w, "{");
+  jsonWriterPrintf(w, "\"rev\":%lu,\"epoch\":%lu,",
+                   (unsigned long)g_stateRev, (unsigned long)g_stateEpoch);
+  if (reply->delta) {
+    jsonWriterRaw(w, "\"delta\":1,");
+  }
+  jsonWriterPrintf(w, "\"selectedCarNumber\":%u,", g_storedVar.selectedCarNumber);
+  jsonWriterPrintf(w, "\"carIndex\":%u", reply->carIndex);
+  if (reply->global) {
+    jsonWriterRaw(w, ",\"global\":");
+    writeStateGlobalBlock(w);
+  }
+  if (reply->carBlock) {
+    jsonWriterRaw(w, ",\"car\":");
+    writeStateCarBlock(w, reply->car);
+  }
+  jsonWriterRaw(w, "}");
+}
+
+static void writeStateJson(JsonWriter_type* w, uint8_t carIndex) {
+  StateReply_type reply;
+  prepareStateReply(&reply, carIndex, 0, 0);
+  writeStateReply(w, &reply);
+}
+
+/* PortalJsonBody_fn adapter; arg points to a prepared StateReply_type */
+static void writeStateReplyBody(JsonWriter_type* w, const void* arg) {
+  writeStateReply(w, (const StateReply_type*)arg);
+}
+
+/**
+ * @brief Apply the tuning fields of a web patch (everything but the name) to a profile
+ * @details car is only modified once the whole patch validated.
+ */
+static bool applyCarPatch(const JsonScanObject_type& doc, CarParam_type& car, String* errorMsg) {
+  CarParam_type patched = car;
+  uint16_t minSpeedRaw = patched.minSpeed;
+
+  const JsonScanMember_type* minSpeedMember = jsonScanFind(&doc, "minSpeed");
+  if (minSpeedMember != nullptr && !parseJsonHalfPercent(minSpeedMember, &minSpeedRaw)) {
+    *errorMsg = "Error: invalid minSpeed"; return false;
+  }
+  const char* badField = applyCarIntFields(doc, patched, false);
+  if (badField != nullptr) {
+    *errorMsg = "Error: invalid " + String(badField); return false;
+  }
+  if (patched.maxSpeed < (uint16_t)(sensiToWholePctCeil(minSpeedRaw) + 5)) {
+    *errorMsg = "Error: maxSpeed must be at least minSpeed+5";
+    return false;
+  }
+  patched.minSpeed = minSpeedRaw;
+
+  const JsonScanMember_type* releaseModeMember = jsonScanFindAlias(&doc, "releaseMode", "quickBrakeEnabled");
+  if (releaseModeMember != nullptr) {
+    uint16_t releaseMode = patched.quickBrakeEnabled;
+    if (!parseJsonReleaseMode(releaseModeMember, &releaseMode)) {
+      *errorMsg = "Error: invalid releaseMode"; return false;
+    }
+    patched.quickBrakeEnabled = releaseMode;
+  }
+  if (!parseJsonCurveShape(doc, &patched.throttleCurveShape)) {
+    *errorMsg = "Error: invalid curvePoints"; return false;
+  }
+  car = patched;
+  return true;
 }
 
-static bool parseAndApplyWebPatch(const String& json, String* errorMsg, uint8_t* appliedCarIndex) {
+static bool parseAndApplyWebPatch(const char* body, size_t bodyLen, String* errorMsg, uint8_t* appliedCarIndex) {
+  JsonScanObject_type doc;
+  if (!jsonScanObject(body, bodyLen, &doc)) {
+    *errorMsg = "Error: malformed JSON";
+    return false;
+  }
+
   StoredVar_type updated = g_storedVar;
   loadWiFiNetworkSettingsIfNeeded();
   uint16_t wifiConfiguredMode = g_wifiConfiguredMode;
@@ -1671,7 +2178,7 @@ static bool parseAndApplyWebPatch(const String& json, String* errorMsg, uint8_t*
   bool uiAuthPasswordProvided = false;
   bool uiAuthResetDefaultRequested = false;
 
-  if (parseJsonInt(json, "carIndex", v)) {
+  if (parseJsonInt(doc, "carIndex", v)) {
     if (!inRange(v, 0, CAR_MAX_COUNT - 1)) {
       *errorMsg = "Error: invalid carIndex";
       return false;
@@ -1679,140 +2186,140 @@ static bool parseAndApplyWebPatch(const String& json, String* errorMsg, uint8_t*
     carIndex = (uint8_t)v;
   }
 
-  if (parseJsonInt(json, "selectedCarNumber", v)) {
+  if (parseJsonInt(doc, "selectedCarNumber", v)) {
     if (!inRange(v, 0, CAR_MAX_COUNT - 1)) { *errorMsg = "Error: invalid selectedCarNumber"; return false; }
     updated.selectedCarNumber = (uint16_t)v;
   }
-  if (parseJsonInt(json, "viewMode", v)) {
+  if (parseJsonInt(doc, "viewMode", v)) {
     if (!inRange(v, VIEW_MODE_LIST, VIEW_MODE_GRID)) { *errorMsg = "Error: invalid viewMode"; return false; }
     updated.viewMode = (uint16_t)v;
   }
-  if (parseJsonInt(json, "screensaverTimeout", v)) {
+  if (parseJsonInt(doc, "screensaverTimeout", v)) {
     if (!inRange(v, 0, SCREENSAVER_TIMEOUT_MAX)) { *errorMsg = "Error: invalid screensaverTimeout"; return false; }
     updated.screensaverTimeout = (uint16_t)v;
   }
-  if (parseJsonInt(json, "powerSaveTimeout", v)) {
+  if (parseJsonInt(doc, "powerSaveTimeout", v)) {
     if (!inRange(v, 0, POWER_SAVE_TIMEOUT_MAX)) { *errorMsg = "Error: invalid powerSaveTimeout"; return false; }
     updated.powerSaveTimeout = (uint16_t)v;
   }
-  if (parseJsonInt(json, "deepSleepTimeout", v)) {
+  if (parseJsonInt(doc, "deepSleepTimeout", v)) {
     if (!(v == 0 || inRange(v, DEEP_SLEEP_TIMEOUT_MIN, DEEP_SLEEP_TIMEOUT_MAX))) {
       *errorMsg = "Error: invalid deepSleepTimeout";
       return false;
     }
     updated.deepSleepTimeout = (uint16_t)v;
   }
-  if (parseJsonInt(json, "soundBoot", v)) {
+  if (parseJsonInt(doc, "soundBoot", v)) {
     if (!inRange(v, 0, 1)) { *errorMsg = "Error: invalid soundBoot"; return false; }
     updated.soundBoot = (uint16_t)v;
   }
-  if (parseJsonInt(json, "soundRace", v)) {
+  if (parseJsonInt(doc, "soundRace", v)) {
     if (!inRange(v, 0, 1)) { *errorMsg = "Error: invalid soundRace"; return false; }
     updated.soundRace = (uint16_t)v;
   }
-  if (parseJsonInt(json, "antiSpinDisplayMode", v)) {
+  if (parseJsonInt(doc, "antiSpinDisplayMode", v)) {
     if (!inRange(v, ANTISPIN_UI_MODE_MS, ANTISPIN_UI_MODE_TEXT)) { *errorMsg = "Error: invalid antiSpinDisplayMode"; return false; }
     g_antiSpinDisplayMode = (uint16_t)v;
   }
-  if (parseJsonInt(json, "antiSpinStep", v) || parseJsonInt(json, "antiSpinStepMs", v)) {
+  if (parseJsonInt(doc, "antiSpinStep", v) || parseJsonInt(doc, "antiSpinStepMs", v)) {
     if (!inRange(v, ANTISPIN_STEP_MIN, ANTISPIN_STEP_MAX)) { *errorMsg = "Error: invalid antiSpinStepMs"; return false; }
     g_antiSpinStepMs = (uint16_t)v;
   }
-  if (parseJsonInt(json, "antiSpinStepPct", v)) {
+  if (parseJsonInt(doc, "antiSpinStepPct", v)) {
     if (!inRange(v, ANTISPIN_STEP_PCT_MIN, ANTISPIN_STEP_PCT_MAX)) { *errorMsg = "Error: invalid antiSpinStepPct"; return false; }
     g_antiSpinStepPct = (uint16_t)v;
   }
-  if (parseJsonInt(json, "encoderInvert", v)) {
+  if (parseJsonInt(doc, "encoderInvert", v)) {
     if (!inRange(v, 0, 1)) { *errorMsg = "Error: invalid encoderInvert"; return false; }
     applyEncoderInvertSetting((uint16_t)v);
   }
-  if (parseJsonInt(json, "adcVoltageRangeMv", v)) {
+  if (parseJsonInt(doc, "adcVoltageRangeMv", v)) {
     if (!inRange(v, ADC_VOLTAGE_RANGE_MIN_MVOLTS, ADC_VOLTAGE_RANGE_MAX_MVOLTS)) {
       *errorMsg = "Error: invalid adcVoltageRangeMv";
       return false;
     }
     applyAdcVoltageRangeMilliVolts((uint16_t)v);
   }
-  if (parseJsonInt(json, "gridCarSelectEnabled", v)) {
+  if (parseJsonInt(doc, "gridCarSelectEnabled", v)) {
     if (!inRange(v, 0, 1)) { *errorMsg = "Error: invalid gridCarSelectEnabled"; return false; }
     updated.gridCarSelectEnabled = (uint16_t)v;
   }
-  if (parseJsonInt(json, "raceViewMode", v)) {
+  if (parseJsonInt(doc, "raceViewMode", v)) {
     if (!inRange(v, RACE_VIEW_OFF, RACE_VIEW_SIMPLE)) { *errorMsg = "Error: invalid raceViewMode"; return false; }
     updated.raceViewMode = (uint16_t)v;
   }
-  if (parseJsonInt(json, "language", v)) {
+  if (parseJsonInt(doc, "language", v)) {
     if (!inRange(v, LANG_NOR, LANG_MAX)) { *errorMsg = "Error: invalid language"; return false; }
     updated.language = (uint16_t)v;
   }
-  if (parseJsonInt(json, "textCase", v)) {
+  if (parseJsonInt(doc, "textCase", v)) {
     if (!inRange(v, TEXT_CASE_UPPER, TEXT_CASE_PASCAL)) { *errorMsg = "Error: invalid textCase"; return false; }
     updated.textCase = (uint16_t)v;
   }
-  if (parseJsonInt(json, "listFontSize", v)) {
+  if (parseJsonInt(doc, "listFontSize", v)) {
     if (!inRange(v, FONT_SIZE_LARGE, FONT_SIZE_SMALL)) { *errorMsg = "Error: invalid listFontSize"; return false; }
     updated.listFontSize = (uint16_t)v;
   }
-  if (parseJsonInt(json, "startupDelay", v)) {
+  if (parseJsonInt(doc, "startupDelay", v)) {
     if (!inRange(v, STARTUP_DELAY_MIN, STARTUP_DELAY_MAX)) { *errorMsg = "Error: invalid startupDelay"; return false; }
     updated.startupDelay = (uint16_t)v;
   }
-  if (parseJsonInt(json, "wifiMode", v)) {
+  if (parseJsonInt(doc, "wifiMode", v)) {
     if (!inRange(v, WIFI_CONFIG_AP, WIFI_CONFIG_HOME)) { *errorMsg = "Error: invalid wifiMode"; return false; }
     wifiConfiguredMode = (uint16_t)v;
   }
-  if (parseJsonStr(json, "uiAuthUsername", uiAuthUsername, sizeof(uiAuthUsername))) {
+  if (parseJsonStr(doc, "uiAuthUsername", uiAuthUsername, sizeof(uiAuthUsername))) {
     uiAuthUsername[sizeof(uiAuthUsername) - 1] = '\0';
     if (uiAuthUsername[0] == '\0') {
       getDefaultUiAuthUsername(uiAuthUsername, sizeof(uiAuthUsername));
     }
   }
-  if (parseJsonInt(json, "statusSlot0", v)) {
+  if (parseJsonInt(doc, "statusSlot0", v)) {
     if (v == STATUS_CURRENT_MA) v = STATUS_CURRENT;
-    if (!inRange(v, STATUS_BLANK, STATUS_ACTIVE_BRAKE)) { *errorMsg = "Error: invalid statusSlot0"; return false; }
+    if (!inRange(v, STATUS_BLANK, STATUS_TEMP)) { *errorMsg = "Error: invalid statusSlot0"; return false; }
     updated.statusSlot[0] = (uint16_t)v;
   }
-  if (parseJsonInt(json, "statusSlot1", v)) {
+  if (parseJsonInt(doc, "statusSlot1", v)) {
     if (v == STATUS_CURRENT_MA) v = STATUS_CURRENT;
-    if (!inRange(v, STATUS_BLANK, STATUS_ACTIVE_BRAKE)) { *errorMsg = "Error: invalid statusSlot1"; return false; }
+    if (!inRange(v, STATUS_BLANK, STATUS_TEMP)) { *errorMsg = "Error: invalid statusSlot1"; return false; }
     updated.statusSlot[1] = (uint16_t)v;
   }
-  if (parseJsonInt(json, "statusSlot2", v)) {
+  if (parseJsonInt(doc, "statusSlot2", v)) {
     if (v == STATUS_CURRENT_MA) v = STATUS_CURRENT;
-    if (!inRange(v, STATUS_BLANK, STATUS_ACTIVE_BRAKE)) { *errorMsg = "Error: invalid statusSlot2"; return false; }
+    if (!inRange(v, STATUS_BLANK, STATUS_TEMP)) { *errorMsg = "Error: invalid statusSlot2"; return false; }
     updated.statusSlot[2] = (uint16_t)v;
   }
-  if (parseJsonInt(json, "statusSlot3", v)) {
+  if (parseJsonInt(doc, "statusSlot3", v)) {
     if (v == STATUS_CURRENT_MA) v = STATUS_CURRENT;
-    if (!inRange(v, STATUS_BLANK, STATUS_ACTIVE_BRAKE)) { *errorMsg = "Error: invalid statusSlot3"; return false; }
+    if (!inRange(v, STATUS_BLANK, STATUS_TEMP)) { *errorMsg = "Error: invalid statusSlot3"; return false; }
     updated.statusSlot[3] = (uint16_t)v;
   }
 
   char tempStr[SCREENSAVER_TEXT_MAX];
-  if (parseJsonStr(json, "screensaverLine1", tempStr, SCREENSAVER_TEXT_MAX)) {
+  if (parseJsonStr(doc, "screensaverLine1", tempStr, SCREENSAVER_TEXT_MAX)) {
     strncpy(updated.screensaverLine1, tempStr, SCREENSAVER_TEXT_MAX);
     updated.screensaverLine1[SCREENSAVER_TEXT_MAX - 1] = '\0';
   }
-  if (parseJsonStr(json, "screensaverLine2", tempStr, SCREENSAVER_TEXT_MAX)) {
+  if (parseJsonStr(doc, "screensaverLine2", tempStr, SCREENSAVER_TEXT_MAX)) {
     strncpy(updated.screensaverLine2, tempStr, SCREENSAVER_TEXT_MAX);
     updated.screensaverLine2[SCREENSAVER_TEXT_MAX - 1] = '\0';
   }
-  if (parseJsonStr(json, "wifiStaSsid", wifiClientSsid, sizeof(wifiClientSsid))) {
+  if (parseJsonStr(doc, "wifiStaSsid", wifiClientSsid, sizeof(wifiClientSsid))) {
     wifiClientSsid[sizeof(wifiClientSsid) - 1] = '\0';
   }
-  if (parseJsonStr(json, "wifiStaPassword", requestedWiFiPassword, sizeof(requestedWiFiPassword))) {
+  if (parseJsonStr(doc, "wifiStaPassword", requestedWiFiPassword, sizeof(requestedWiFiPassword))) {
     requestedWiFiPassword[sizeof(requestedWiFiPassword) - 1] = '\0';
     wifiPasswordProvided = true;
   }
-  if (parseJsonInt(json, "wifiStaPasswordClear", v)) {
+  if (parseJsonInt(doc, "wifiStaPasswordClear", v)) {
     if (!inRange(v, 0, 1)) { *errorMsg = "Error: invalid wifiStaPasswordClear"; return false; }
     wifiPasswordClearRequested = (v != 0);
   }
-  if (parseJsonStr(json, "uiAuthPassword", requestedUiAuthPassword, sizeof(requestedUiAuthPassword))) {
+  if (parseJsonStr(doc, "uiAuthPassword", requestedUiAuthPassword, sizeof(requestedUiAuthPassword))) {
     requestedUiAuthPassword[sizeof(requestedUiAuthPassword) - 1] = '\0';
     uiAuthPasswordProvided = true;
   }
-  if (parseJsonInt(json, "uiAuthResetDefault", v)) {
+  if (parseJsonInt(doc, "uiAuthResetDefault", v)) {
     if (!inRange(v, 0, 1)) { *errorMsg = "Error: invalid uiAuthResetDefault"; return false; }
     uiAuthResetDefaultRequested = (v != 0);
   }
@@ -1842,84 +2349,27 @@ static bool parseAndApplyWebPatch(const String& json, String* errorMsg, uint8_t*
     return false;
   }
 
-  CarParam_type car = updated.carParam[carIndex];
-  uint16_t minSpeedRaw = car.minSpeed;
-  uint16_t maxSpeed = car.maxSpeed;
-
-  if (json.indexOf("\"minSpeed\"") >= 0) {
-    if (!parseJsonHalfPercent(json, "minSpeed", &minSpeedRaw)) { *errorMsg = "Error: invalid minSpeed"; return false; }
-  }
-  if (parseJsonInt(json, "maxSpeed", v)) {
-    if (!inRange(v, 5, 100)) { *errorMsg = "Error: invalid maxSpeed"; return false; }
-    maxSpeed = (uint16_t)v;
-  }
-  if (maxSpeed < (uint16_t)(sensiToWholePctCeil(minSpeedRaw) + 5)) {
-    *errorMsg = "Error: maxSpeed must be at least minSpeed+5";
+  CarParam_type car;
+  carProfileRead(carIndex, &car);
+  if (!applyCarPatch(doc, car, errorMsg)) {
     return false;
   }
-  car.minSpeed = minSpeedRaw;
-  car.maxSpeed = maxSpeed;
-
-  if (parseJsonInt(json, "brake", v)) {
-    if (!inRange(v, 0, BRAKE_MAX_VALUE)) { *errorMsg = "Error: invalid brake"; return false; }
-    car.brake = (uint16_t)v;
-  }
-  if (parseJsonInt(json, "curveDiff", v)) {
-    if (!inRange(v, THROTTLE_CURVE_SPEED_DIFF_MIN_VALUE, THROTTLE_CURVE_SPEED_DIFF_MAX_VALUE)) {
-      *errorMsg = "Error: invalid curveDiff"; return false;
-    }
-    car.throttleCurveVertex.curveSpeedDiff = (uint16_t)v;
-  }
-  if (parseJsonInt(json, "fade", v)) {
-    if (!inRange(v, 0, FADE_MAX_VALUE)) { *errorMsg = "Error: invalid fade"; return false; }
-    car.fade = (uint16_t)v;
-  }
-  if (parseJsonInt(json, "antiSpin", v)) {
-    if (!inRange(v, 0, ANTISPIN_MAX_VALUE)) { *errorMsg = "Error: invalid antiSpin"; return false; }
-    car.antiSpin = (uint16_t)v;
-  }
-  if (parseJsonInt(json, "freqPWM", v)) {
-    if (!inRange(v, FREQ_MIN_VALUE / 100, FREQ_MAX_VALUE / 100)) { *errorMsg = "Error: invalid freqPWM"; return false; }
-    car.freqPWM = (uint16_t)v;
-  }
-  if (jsonHasKey(json, "altBrake") || jsonHasKey(json, "brakeButton")) {
-    if (!parseJsonIntAlias(json, "altBrake", "brakeButton", v) || !inRange(v, 0, 100)) {
-      *errorMsg = "Error: invalid altBrake"; return false;
-    }
-    car.brakeButtonReduction = (uint16_t)v;
-  }
-  if (jsonHasKey(json, "releaseMode") || jsonHasKey(json, "quickBrakeEnabled")) {
-    uint16_t releaseMode = car.quickBrakeEnabled;
-    if (!parseJsonReleaseModeAlias(json, "releaseMode", "quickBrakeEnabled", &releaseMode)) {
-      *errorMsg = "Error: invalid releaseMode"; return false;
-    }
-    car.quickBrakeEnabled = releaseMode;
-  }
-  if (jsonHasKey(json, "releaseZone") || jsonHasKey(json, "quickBrakeThreshold")) {
-    if (!parseJsonIntAlias(json, "releaseZone", "quickBrakeThreshold", v) || !inRange(v, 0, QUICK_BRAKE_THRESHOLD_MAX)) {
-      *errorMsg = "Error: invalid releaseZone"; return false;
-    }
-    car.quickBrakeThreshold = (uint16_t)v;
-  }
-  if (jsonHasKey(json, "releaseLevel") || jsonHasKey(json, "quickBrakeStrength")) {
-    if (!parseJsonIntAlias(json, "releaseLevel", "quickBrakeStrength", v) || !inRange(v, 0, QUICK_BRAKE_STRENGTH_MAX)) {
-      *errorMsg = "Error: invalid releaseLevel"; return false;
-    }
-    car.quickBrakeStrength = (uint16_t)v;
-  }
 
   char tempName[CAR_NAME_MAX_SIZE];
-  if (parseJsonStr(json, "carName", tempName, CAR_NAME_MAX_SIZE)) {
+  if (parseJsonStr(doc, "carName", tempName, CAR_NAME_MAX_SIZE)) {
     memset(car.carName, 0, CAR_NAME_MAX_SIZE);
     strncpy(car.carName, tempName, CAR_NAME_MAX_SIZE - 1);
     car.carName[CAR_NAME_MAX_SIZE - 1] = '\0';
   }
 
-  updated.carParam[carIndex] = car;
-  g_storedVar = updated;
+  if (carIndex == updated.activeCar.carNumber) {
+    updated.activeCar = car;
+  } else {
+    carProfileWrite(carIndex, &car);  /* Queued for flash on its own */
+  }
+  activeTuningReplaceStoredVar(&updated);  /* Copy + publish without racing Task1 */
   g_wifiConfiguredMode = wifiConfiguredMode;
-  copyBoundedString(g_wifiClientSsid, sizeof(g_wifiClientSsid), wifiClientSsid);
-  copyBoundedString(g_wifiClientPassword, sizeof(g_wifiClientPassword), wifiClientPassword);
+  setConfiguredWiFiClientCredentials(wifiClientSsid, wifiClientPassword);
   setCurrentUiAuthCredentials(uiAuthUsername, uiAuthPassword);
 
   if (appliedCarIndex != nullptr) *appliedCarIndex = carIndex;
@@ -1928,8 +2378,6 @@ static bool parseAndApplyWebPatch(const String& json, String* errorMsg, uint8_t*
 
 
 /* OTA progress tracking */
-static size_t g_otaTotal = 0;
-static size_t g_otaWritten = 0;
 static bool g_otaInProgress = false;
 static bool g_otaTargetSpiffs = false;
 static bool g_otaSessionOk = false;
@@ -1939,6 +2387,18 @@ static bool g_otaRestartDeferredPending = false;
 static uint32_t g_otaRestartDeferredUntilMs = 0;
 static uint32_t g_otaLastUiUpdateMs = 0;
 static size_t g_otaLastUiShownKb = 0;
+
+/* OLED OTA screens are drawn by Task1 (serviceOtaDisplay); the upload handler only posts the phase */
+typedef enum {
+  OTA_UI_IDLE = 0,
+  OTA_UI_RUNNING,
+  OTA_UI_OK,
+  OTA_UI_FAIL,
+  OTA_UI_ABORT
+} OtaUiPhase_enum;
+static volatile uint8_t g_otaUiPhase = OTA_UI_IDLE;
+static volatile uint8_t g_otaUiSeq = 0;     /* Bumped on every phase change */
+static uint8_t g_otaUiShownSeq = 0;
 static const uint32_t OTA_DEFERRED_RESTART_GRACE_MS = 180000UL;
 
 static void clearOtaDeferredRestartState() {
@@ -2007,11 +2467,91 @@ static void sendSpiffsMismatch(const char* spiffsVer) {
   g_wifiServer->send(200, "text/html; charset=utf-8", page);
 }
 
-static bool streamFileFromSpiffs(const char* path, const char* contentType) {
-  if (!g_spiffsMounted) {
+/**
+ * @brief Reload the asset route table after SPIFFS was mounted or unmounted
+ */
+static void refreshStaticAssetRoutes() {
+  if (g_spiffsMounted) {
+    staticAssetsLoad(SPIFFS);
+  } else {
+    staticAssetsClear();
+  }
+}
+
+static bool requestEtagMatches(const char* etag) {
+  if (!g_wifiServer->hasHeader("If-None-Match")) {
     return false;
   }
+  /* The header may list several tags, quoted and possibly weak ("W/"): a substring hit on
+   * a 16-hex-digit content hash is as good as an exact match */
+  return strstr(g_wifiServer->header("If-None-Match").c_str(), etag) != nullptr;
+}
 
+/**
+ * @brief Serve a file listed in the asset manifest
+ * @details Versioned URLs (?v=<etag>, written by the build script) are immutable and cached
+ *          for a year. Plain URLs are cached but revalidated, which costs a 304 and no SPIFFS read.
+ */
+static bool streamStaticAsset(const StaticAsset_type* asset, const char* contentType) {
+  String version = g_wifiServer->arg("v");
+  bool versioned = version.length() > 0 && strcmp(version.c_str(), asset->etag) == 0;
+  const char* cacheControl = versioned ? "public, max-age=31536000, immutable" : "no-cache";
+  char etagHeader[STATIC_ASSET_ETAG_LEN + 3];
+  snprintf(etagHeader, sizeof(etagHeader), "\"%s\"", asset->etag);
+
+  if (requestEtagMatches(asset->etag)) {
+    g_wifiServer->sendHeader("ETag", etagHeader);
+    g_wifiServer->sendHeader("Cache-Control", cacheControl);
+    g_wifiServer->send(304);
+    return true;
+  }
+
+  char filePath[STATIC_ASSET_PATH_MAX];
+  if (!staticAssetFilePath(asset, filePath, sizeof(filePath))) {
+    return false;
+  }
+  File file = SPIFFS.open(filePath, FILE_READ);
+  if (!file) {
+    return false;
+  }
+  bool gzip = (asset->flags & STATIC_ASSET_FLAG_GZIP) != 0;
+
+  if (portalTransferHasFreeSlot()) {
+    char headers[128];
+    snprintf(headers, sizeof(headers), "ETag: %s\r\nCache-Control: %s\r\n%s",
+             etagHeader,
+             cacheControl,
+             gzip ? "Content-Encoding: gzip\r\n" : "");
+    return portalTransferStartFile(g_wifiServer->client(), file, contentType, headers);
+  }
+
+  g_wifiServer->sendHeader("ETag", etagHeader);
+  g_wifiServer->sendHeader("Cache-Control", cacheControl);
+  if (gzip) {
+    g_wifiServer->sendHeader("Content-Encoding", "gzip");
+  }
+  g_wifiServer->streamFile(file, contentType);
+  file.close();
+  return true;
+}
+
+/**
+ * @brief Serve a SPIFFS file (or its .gz twin) as a background transfer
+ * @details Files in the asset manifest are served straight from the route table. Only an
+ *          image without a manifest is probed for path and path.gz. Falls back to a blocking
+ *          WebServer::streamFile() only when every transfer slot is busy.
+ */
+static bool streamFileFromSpiffsWithHeaders(const char* path, const char* contentType, bool noStore) {
+  if (!g_spiffsMounted) {
+    return false;
+  }
+
+  if (staticAssetsCount() > 0) {
+    const StaticAsset_type* asset = staticAssetsFind(path);
+    return (asset != nullptr) && streamStaticAsset(asset, contentType);
+  }
+
+  bool gzip = false;
   File file = SPIFFS.open(path, FILE_READ);
   if (!file) {
     String gzPath = String(path) + ".gz";
@@ -2019,19 +2559,37 @@ static bool streamFileFromSpiffs(const char* path, const char* contentType) {
     if (!file) {
       return false;
     }
-    g_wifiServer->sendHeader("Content-Encoding", "gzip");
+    gzip = true;
+  }
+
+  if (portalTransferHasFreeSlot()) {
+    char headers[64];
+    snprintf(headers, sizeof(headers), "%s%s",
+             noStore ? "Cache-Control: no-store\r\n" : "",
+             gzip ? "Content-Encoding: gzip\r\n" : "");
+    return portalTransferStartFile(g_wifiServer->client(), file, contentType, headers);
   }
 
+  if (noStore) {
+    g_wifiServer->sendHeader("Cache-Control", "no-store");
+  }
+  if (gzip) {
+    g_wifiServer->sendHeader("Content-Encoding", "gzip");
+  }
   g_wifiServer->streamFile(file, contentType);
   file.close();
   return true;
 }
 
+static bool streamFileFromSpiffs(const char* path, const char* contentType) {
+  return streamFileFromSpiffsWithHeaders(path, contentType, false);
+}
+
 static bool streamHtmlFromSpiffs(const char* path) {
-  /* Prevent browsers from caching HTML pages so stale UI is never served
-   * after a SPIFFS update. Static assets (images, fonts) keep default caching. */
-  g_wifiServer->sendHeader("Cache-Control", "no-store");
-  return streamFileFromSpiffs(path, "text/html; charset=utf-8");
+  /* Without a manifest there is no ETag to revalidate against, so prevent browsers from
+   * caching HTML pages and serving a stale UI after a SPIFFS update. Static assets
+   * (images, fonts) keep default caching. */
+  return streamFileFromSpiffsWithHeaders(path, "text/html; charset=utf-8", true);
 }
 
 static void sendPublicUiFallback() {
@@ -2076,6 +2634,7 @@ static void sendDocsMissing(const char* requestedPath) {
 }
 
 static void handleSerialCommand(const String& cmd);
+static void handleSerialExportCommand(const String& cmd);
 
 /**
  * @brief Non-blocking USB serial command pump.
@@ -2112,26 +2671,375 @@ static void serviceUsbSerialCommands() {
   }
 }
 
+/**
+ * @brief Parse the optional "<afterSeq> <limit>" arguments of TLIVE/TLIVEB
+ * @details Leaves the defaults in place for missing fields; limit is clamped to 1..256.
+ */
+static void parseSerialTelemetryLiveArgs(const String& cmd, uint32_t* afterSeq, size_t* limit) {
+  int32_t firstSpace = cmd.indexOf(' ');
+  if (firstSpace > 0 && firstSpace < (int32_t)cmd.length() - 1) {
+    int32_t secondSpace = cmd.indexOf(' ', firstSpace + 1);
+    String afterStr;
+    String limitStr;
+    if (secondSpace > firstSpace) {
+      afterStr = cmd.substring(firstSpace + 1, secondSpace);
+      limitStr = cmd.substring(secondSpace + 1);
+    } else {
+      afterStr = cmd.substring(firstSpace + 1);
+    }
+    afterStr.trim();
+    limitStr.trim();
+    if (afterStr.length() > 0) {
+      *afterSeq = (uint32_t)afterStr.toInt();
+    }
+    if (limitStr.length() > 0) {
+      int32_t parsedLimit = limitStr.toInt();
+      if (parsedLimit > 0) {
+        *limit = (size_t)parsedLimit;
+      }
+    }
+  }
+  if (*limit < 1U) *limit = 1U;
+  if (*limit > 256U) *limit = 256U;
+}
+
+#define LAPS_HISTORY_PAGE_MAX 256U
+#define LAPS_SESSIONS_LISTED  LAP_LOG_MAX_SESSIONS
+
+/**
+ * @brief Everything a /api/laps or LAPS reply shows, captured once before writing
+ */
+typedef struct {
+  bool history;                  /* true: logged laps of one session, false: live summary */
+  uint32_t sessionId;
+  uint32_t from;
+  uint32_t count;
+  uint32_t total;
+  LapStats_type stats;
+  LapRecord_type recent[LAP_ENGINE_RECENT_LAPS];
+  uint8_t recentCount;
+  LapSessionInfo_type sessions[LAPS_SESSIONS_LISTED];
+  uint8_t sessionCount;
+} LapsReply_type;
+
+static void writeLapRecordJson(JsonWriter_type* w, const LapRecord_type* r) {
+  jsonWriterPrintf(w, "{\"lap\":%u,\"lapUs\":%lu,\"endMs\":%lu,\"car\":%u,\"sectorUs\":[",
+                   r->lapNumber, (unsigned long)r->lapUs, (unsigned long)r->endMs, r->carIndex);
+  for (uint8_t i = 0; i < r->sectorCount && i < LAP_ENGINE_MAX_SECTORS; i++) {
+    if (i > 0) jsonWriterChar(w, ',');
+    jsonWriterUInt(w, r->sectorUs[i]);
+  }
+  jsonWriterRaw(w, "]}");
+}
+
+/* PortalJsonBody_fn; arg is a LapsReply_type */
+static void writeLapsJson(JsonWriter_type* w, const void* arg) {
+  const LapsReply_type* reply = (const LapsReply_type*)arg;
+
+  if (reply->history) {
+    jsonWriterPrintf(w, "{\"sessionId\":%lu,\"total\":%lu,\"from\":%lu,\"laps\":[",
+                     (unsigned long)reply->sessionId, (unsigned long)reply->total, (unsigned long)reply->from);
+    /* Page through the file; count was fixed up front so both serial passes match */
+    LapRecord_type page[8];
+    uint32_t written = 0;
+    while (written < reply->count) {
+      size_t want = min((size_t)(reply->count - written), sizeof(page) / sizeof(page[0]));
+      size_t got = lapEngineReadLog(reply->sessionId, reply->from + written, page, want, nullptr);
+      for (size_t i = 0; i < got; i++) {
+        if (written + i > 0) jsonWriterChar(w, ',');
+        writeLapRecordJson(w, &page[i]);
+      }
+      if (got < want) break;
+      written += got;
+    }
+    jsonWriterRaw(w, "]}");
+    return;
+  }
+
+  const LapStats_type* s = &reply->stats;
+  jsonWriterPrintf(w, "{\"sessionId\":%lu,\"sectors\":%u,\"lapCount\":%lu,\"loggedLaps\":%lu,\"logOk\":%u,",
+                   (unsigned long)s->sessionId, s->sectorCount, (unsigned long)s->lapCount,
+                   (unsigned long)s->loggedLaps, s->logAvailable ? 1 : 0);
+  jsonWriterPrintf(w, "\"lastLapUs\":%lu,\"bestLapUs\":%lu,\"meanLapUs\":%lu,\"stddevLapUs\":%lu,",
+                   (unsigned long)s->lastLapUs, (unsigned long)s->bestLapUs,
+                   (unsigned long)s->meanLapUs, (unsigned long)s->stddevLapUs);
+  jsonWriterPrintf(w, "\"rollingLaps\":%u,\"rollingMeanUs\":%lu,\"rollingStddevUs\":%lu,",
+                   s->rollingCount, (unsigned long)s->rollingMeanUs, (unsigned long)s->rollingStddevUs);
+  jsonWriterPrintf(w, "\"theoreticalBestUs\":%lu,\"currentLapUs\":%lu,\"currentSector\":%u,\"bestSectorUs\":[",
+                   (unsigned long)s->theoreticalBestUs, (unsigned long)s->currentLapUs, s->currentSector);
+  for (uint8_t i = 0; i < s->sectorCount && i < LAP_ENGINE_MAX_SECTORS; i++) {
+    if (i > 0) jsonWriterChar(w, ',');
+    jsonWriterUInt(w, s->bestSectorUs[i]);
+  }
+  jsonWriterRaw(w, "],\"recent\":[");
+  for (uint8_t i = 0; i < reply->recentCount; i++) {
+    if (i > 0) jsonWriterChar(w, ',');
+    writeLapRecordJson(w, &reply->recent[i]);
+  }
+  jsonWriterRaw(w, "],\"sessions\":[");
+  for (uint8_t i = 0; i < reply->sessionCount; i++) {
+    if (i > 0) jsonWriterChar(w, ',');
+    jsonWriterPrintf(w, "{\"id\":%lu,\"laps\":%lu,\"sectors\":%u}",
+                     (unsigned long)reply->sessions[i].sessionId, (unsigned long)reply->sessions[i].lapCount,
+                     reply->sessions[i].sectorCount);
+  }
+  jsonWriterRaw(w, "]}");
+}
+
+/**
+ * @brief Capture a laps reply: live summary, or a page of a logged session when history is set
+ */
+static void captureLapsReply(LapsReply_type* reply, bool history, uint32_t sessionId, uint32_t from, uint32_t limit) {
+  memset(reply, 0, sizeof(*reply));
+  reply->history = history;
+  if (history) {
+    LapRecord_type probe;
+    reply->sessionId = sessionId;
+    reply->from = from;
+    lapEngineReadLog(sessionId, 0, &probe, 0, &reply->total);
+    uint32_t available = (from < reply->total) ? (reply->total - from) : 0;
+    reply->count = min(available, min(limit, (uint32_t)LAPS_HISTORY_PAGE_MAX));
+    return;
+  }
+  lapEngineGetStats(&reply->stats);
+  reply->recentCount = (uint8_t)lapEngineCopyRecent(reply->recent, LAP_ENGINE_RECENT_LAPS);
+  reply->sessionCount = lapEngineListSessions(reply->sessions, LAPS_SESSIONS_LISTED);
+}
+
+static void handleSerialLapsCommand(const String& cmd) {
+  String args = cmd.substring(4);
+  args.trim();
+  bool history = false;
+  uint32_t values[3] = {0, 0, LAPS_HISTORY_PAGE_MAX};
+  if (args == "NEW") {
+    lapEngineNewSession();
+  } else if (args.startsWith("SECTORS")) {
+    int32_t sectors = args.substring(7).toInt();
+    if (sectors < 1 || sectors > LAP_ENGINE_MAX_SECTORS || !lapEngineSetSectorCount((uint8_t)sectors)) {
+      Serial.println("ERR:invalid sector count");
+      return;
+    }
+  } else if (args.length() > 0) {
+    history = true;
+    uint8_t n = 0;
+    int32_t start = 0;
+    while (n < 3 && start < (int32_t)args.length()) {
+      int32_t sp = args.indexOf(' ', start);
+      String part = (sp < 0) ? args.substring(start) : args.substring(start, sp);
+      part.trim();
+      if (part.length() > 0) {
+        values[n++] = (uint32_t)part.toInt();
+      }
+      if (sp < 0) break;
+      start = sp + 1;
+    }
+  }
+
+  /* NEW/SECTORS are applied by WiFiTask; give it a moment so the reply shows the new session */
+  if (!history && args.length() > 0) {
+    delay(5);
+  }
+  LapsReply_type* reply = (LapsReply_type*)malloc(sizeof(LapsReply_type));
+  if (reply == nullptr) {
+    Serial.println("ERR:Out of memory");
+    return;
+  }
+  captureLapsReply(reply, history, values[0], values[1], values[2]);
+  sendSerialJson(writeLapsJson, reply);
+  free(reply);
+}
+
+static const char* raceLinkStateLabel(uint8_t state) {
+  switch (state) {
+    case RACE_LINK_WAIT_RADIO: return "WAIT_RADIO";
+    case RACE_LINK_SCANNING:   return "SCANNING";
+    case RACE_LINK_LINKED:     return "LINKED";
+    default:                   return "OFF";
+  }
+}
+
+/* PortalJsonBody_fn; arg is a RaceLinkStatus_type */
+static void writeRaceLinkJson(JsonWriter_type* w, const void* arg) {
+  const RaceLinkStatus_type* s = (const RaceLinkStatus_type*)arg;
+  jsonWriterPrintf(w, "{\"enabled\":%s,\"state\":\"%s\",\"lane\":%u,\"channel\":%u,\"radioShared\":%s,",
+                   s->enabled ? "true" : "false", raceLinkStateLabel(s->state), s->lane, s->channel,
+                   s->radioShared ? "true" : "false");
+  jsonWriterPrintf(w, "\"paired\":%s,\"pairing\":%s,\"base\":\"%02X:%02X:%02X:%02X:%02X:%02X\",\"raceId\":%u,",
+                   s->paired ? "true" : "false", s->pairing ? "true" : "false",
+                   s->baseMac[0], s->baseMac[1], s->baseMac[2], s->baseMac[3], s->baseMac[4], s->baseMac[5], s->raceId);
+  jsonWriterPrintf(w, "\"synced\":%s,\"offsetUs\":%lld,\"syncSpreadUs\":%lu,\"beacons\":%lu,",
+                   s->synced ? "true" : "false", (long long)s->offsetUs, (unsigned long)s->syncSpreadUs,
+                   (unsigned long)s->beacons);
+  jsonWriterPrintf(w, "\"lapsSent\":%lu,\"lapsFailed\":%lu,\"lapsDropped\":%lu,\"telemetrySent\":%lu}",
+                   (unsigned long)s->lapsSent, (unsigned long)s->lapsFailed, (unsigned long)s->lapsDropped,
+                   (unsigned long)s->telemetrySent);
+}
+
+static void handleSerialRaceCommand(const String& cmd) {
+  String args = cmd.substring(4);
+  args.trim();
+  if (args == "ON" || args.startsWith("ON ")) {
+    String lane = args.substring(2);
+    lane.trim();
+    if (lane.length() > 0 && !raceLinkSetLane((uint8_t)constrain(lane.toInt(), 0, 255))) {
+      Serial.println("ERR:invalid lane");
+      return;
+    }
+    raceLinkSetEnabled(true);
+  } else if (args == "OFF") {
+    raceLinkSetEnabled(false);
+  } else if (args == "PAIR") {
+    raceLinkPair();
+  } else if (args == "FORGET") {
+    raceLinkForget();
+  } else if (args.length() > 0) {
+    Serial.println("ERR:unknown RACE command");
+    return;
+  }
+
+  /* Requests are applied by WiFiTask; give it a moment so the reply shows them */
+  if (args.length() > 0) {
+    delay(5);
+  }
+  RaceLinkStatus_type status;
+  raceLinkGetStatus(&status);
+  sendSerialJson(writeRaceLinkJson, &status);
+}
+
+typedef struct {
+  uint8_t count;
+  LatencyBenchRun_type runs[LATENCY_BENCH_RUNS];
+} BenchReply_type;
+
+static const char* latencyBenchStateLabel(uint8_t state) {
+  switch (state) {
+    case LATENCY_BENCH_RUNNING: return "RUNNING";
+    case LATENCY_BENCH_DONE:    return "DONE";
+    case LATENCY_BENCH_ABORTED: return "ABORTED";
+    default:                    return "IDLE";
+  }
+}
+
+static void writeLatencyBenchHistJson(JsonWriter_type* w, const LatencyBenchHist_type* h) {
+  jsonWriterPrintf(w, "{\"count\":%u,\"timeouts\":%u,\"minUs\":%lu,\"meanUs\":%lu,\"p50Us\":%lu,\"p95Us\":%lu,\"maxUs\":%lu,\"bins\":[",
+                   h->count, h->timeouts, (unsigned long)(h->count ? h->min_us : 0),
+                   (unsigned long)(h->count ? h->sum_us / h->count : 0),
+                   (unsigned long)latencyBenchPercentile(h, 500), (unsigned long)latencyBenchPercentile(h, 950),
+                   (unsigned long)h->max_us);
+  for (uint8_t b = 0; b <= LATENCY_BENCH_BINS; b++) {
+    if (b > 0) jsonWriterChar(w, ',');
+    jsonWriterUInt(w, h->bins[b]);
+  }
+  jsonWriterRaw(w, "]}");
+}
+
+/* PortalJsonBody_fn; arg is a BenchReply_type, newest run first */
+static void writeLatencyBenchJson(JsonWriter_type* w, const void* arg) {
+  const BenchReply_type* reply = (const BenchReply_type*)arg;
+  jsonWriterPrintf(w, "{\"active\":%s,\"lowPct\":%u,\"highPct\":%u,\"binUs\":%u,\"runs\":[",
+                   latencyBenchActive() ? "true" : "false", (unsigned)LATENCY_BENCH_LOW_PCT,
+                   (unsigned)LATENCY_BENCH_HIGH_PCT, (unsigned)LATENCY_BENCH_BIN_US);
+  for (uint8_t i = 0; i < reply->count; i++) {
+    const LatencyBenchRun_type* run = &reply->runs[i];
+    const LatencyBenchConfig_type* c = &run->config;
+    if (i > 0) jsonWriterChar(w, ',');
+    jsonWriterPrintf(w, "{\"id\":%lu,\"state\":\"%s\",\"error\":\"%s\",\"steps\":%u,\"stepsDone\":%u,",
+                     (unsigned long)run->id, latencyBenchStateLabel(run->state), latencyBenchErrorText(run->error),
+                     run->steps, run->stepsDone);
+    jsonWriterPrintf(w, "\"elapsedMs\":%lu,\"edges\":%lu,\"lowRaw\":%d,\"highRaw\":%d,",
+                     (unsigned long)run->elapsed_ms, (unsigned long)run->edges, run->lowRaw, run->highRaw);
+    jsonWriterPrintf(w, "\"config\":{\"filter\":\"%s\",\"antiSpinMode\":\"%s\",\"antiSpinMs\":%u,\"car\":%u,",
+                     latencyBenchFilterLabel(c->filterMode),
+                     (c->antiSpinMode == ANTISPIN_MODE_TRACTION) ? "TRACTION" : "RAMP", c->antiSpin_ms, c->carIndex);
+    jsonWriterPrintf(w, "\"telemetry\":%s,\"telemetryIntervalUs\":%lu,\"controlPeriodUs\":%lu,\"pwmHz\":%u,\"cpuMhz\":%u,\"radio\":%s},",
+                     c->telemetryLogging ? "true" : "false", (unsigned long)c->telemetryInterval_us,
+                     (unsigned long)c->controlPeriod_us, c->pwmFreq_hz, c->cpuFreq_mhz, c->radioOn ? "true" : "false");
+    jsonWriterRaw(w, "\"rise\":");
+    writeLatencyBenchHistJson(w, &run->rise);
+    jsonWriterRaw(w, ",\"fall\":");
+    writeLatencyBenchHistJson(w, &run->fall);
+    jsonWriterChar(w, '}');
+  }
+  jsonWriterRaw(w, "]}");
+}
+
+static void handleSerialBenchCommand(const String& cmd) {
+  String args = cmd.substring(5);
+  args.trim();
+  if (args == "START" || args.startsWith("START ")) {
+    int32_t steps = args.substring(5).toInt();
+    uint8_t error = latencyBenchStart((uint16_t)constrain(steps, 0, (int32_t)LATENCY_BENCH_STEPS_MAX));
+    if (error != LATENCY_BENCH_OK) {
+      Serial.print("ERR:");
+      Serial.println(latencyBenchErrorText(error));
+      return;
+    }
+  } else if (args == "STOP") {
+    latencyBenchCancel();
+  } else if (args.length() > 0) {
+    Serial.println("ERR:unknown BENCH command");
+    return;
+  }
+
+  /* START/STOP are taken up by the control task on its next tick */
+  if (args.length() > 0) {
+    delay(5);
+  }
+  BenchReply_type* reply = (BenchReply_type*)malloc(sizeof(BenchReply_type));
+  if (reply == nullptr) {
+    Serial.println("ERR:Out of memory");
+    return;
+  }
+  reply->count = latencyBenchCopyRuns(reply->runs, LATENCY_BENCH_RUNS);
+  sendSerialJson(writeLatencyBenchJson, reply);
+  free(reply);
+}
+
 /**
  * @brief Handle a single USB serial backup/restore command.
  * Protocol:
  *   "VERSION"        → "<id>,v<major>.<minor>\n"  e.g. "F0A4,v4.4"
  *   "INFO"           → "<bytecount>\n<json>"
  *   "BACKUP"         → "<bytecount>\n<json>"
- *   "RESTORE\n<len>" → read len bytes, parse, save; reply "OK..." or "ERR:..."
+ *   "RESTORE\n<len>" → read len bytes (up to BACKUP_RESTORE_MAX_BYTES), parse as they arrive, save; reply "OK..." or "ERR:..."
  *   "SCHEMA"         → "<bytecount>\n<json>"
  *   "STATE [car]"    → "<bytecount>\n<json>"
  *   "APPLY\n<len>"   → read len bytes patch JSON; reply "OK\n<bytecount>\n<stateJson>" or "ERR:..."
  *   "SAVE"           → "OK - Saved to flash"
  *   "TSTATUS"        → "<bytecount>\n<json>"
  *   "TLIVE a l"      → "<bytecount>\n<json>" (afterSeq=a, limit=l)
- *   "TSTART"         → "<bytecount>\n<json>"
+ *   "TLIVEB a l"     → "<bytecount>\n<base64>" (binary live frame, see telemetry_frame.h)
+ *   "TEXPORT CSV|JSON [GZ] [s]" → "OK TEXPORT[ GZ]\n", then "<len>\n<bytes>" chunks and "0\n"
+ *                      (session export like /api/telemetry/export.*; GZ = gzip stream, s = logged session)
+ *   "TSTREAM [b [a]]"→ "OK TSTREAM <b>\n", then raw live frames pushed continuously at baud b
+ *                      from afterSeq a (see telemetry_stream.h); "TSTREAM STOP" ends it
+ *   "TSTART [us]"    → "<bytecount>\n<json>"  (optional sample interval in µs)
  *   "TSTOP"          → "<bytecount>\n<json>"
  *   "TCLEAR"         → "<bytecount>\n<json>"
  *   "TCONFIG"        → "<bytecount>\n<json>"
+ *   "PERF"           → "<bytecount>\n<json>" (per-stage control tick timing)
+ *   "PERF RESET"     → clear stage statistics, then same as "PERF"
+ *   "LAPS"           → "<bytecount>\n<json>" (lap engine summary, recent laps, logged sessions)
+ *   "LAPS s [f [l]]" → "<bytecount>\n<json>" (logged laps of session s from index f, limit l)
+ *   "LAPS NEW"       → start a new lap session, then same as "LAPS"
+ *   "LAPS SECTORS n" → set dead spots per lap (starts a new session), then same as "LAPS"
+ *   "RACE"           → "<bytecount>\n<json>" (ESP-NOW race link status, see race_link.h)
+ *   "RACE ON [lane]" / "RACE OFF" / "RACE PAIR" / "RACE FORGET" → change it, then same as "RACE"
+ *   "BENCH"          → "<bytecount>\n<json>" (trigger-to-PWM latency runs, newest first, see latency_bench.h)
+ *   "BENCH START [n]"/ "BENCH STOP" → start a run of n steps (motor runs: lift the car) or stop it,
+ *                      then same as "BENCH"
  * Shared by showUSBPortalScreen(); called when Serial.available() triggers.
  */
 static void handleSerialCommand(const String& cmd) {
+  if (telemetryStreamActive()) {
+    /* The WiFiTask owns the port until the stop reply: never answer inside a frame */
+    telemetryStreamKeepAlive();
+    if (cmd == "TSTREAM STOP") {
+      telemetryStreamStop();
+    }
+    return;
+  }
+
   if (cmd == "VERSION") {
     uint8_t idHi = 0;
     uint8_t idLo = 0;
@@ -2151,18 +3059,13 @@ static void handleSerialCommand(const String& cmd) {
     Serial.flush();
 
   } else if (cmd == "INFO") {
-    sendSerialLengthPrefixedPayload(buildInfoJson());
+    sendInfoReply(true);
 
   } else if (cmd == "BACKUP") {
-    String json = buildJsonBackup();
-    Serial.print(json.length());
-    Serial.print('\n');
-    Serial.print(json);
-    Serial.flush();
+    sendSerialJson(writeJsonBackup, nullptr);
 
   } else if (cmd == "SCHEMA") {
-    String json = buildSchemaJson();
-    sendSerialLengthPrefixedPayload(json);
+    sendSerialJson(writeSchemaJson, nullptr);
 
   } else if (cmd.startsWith("STATE")) {
     uint8_t carIndex = (uint8_t)g_storedVar.selectedCarNumber;
@@ -2175,64 +3078,107 @@ static void handleSerialCommand(const String& cmd) {
       }
       carIndex = (uint8_t)v;
     }
-    String json = buildStateJson(carIndex);
-    sendSerialLengthPrefixedPayload(json);
+    StateReply_type reply;
+    prepareStateReply(&reply, carIndex, 0, 0);
+    sendSerialJson(writeStateReplyBody, &reply);
 
   } else if (cmd == "TSTATUS") {
-    sendSerialLengthPrefixedPayload(buildTelemetryStatusPayload(""));
+    sendTelemetryStatusReply("", true);
 
-  } else if (cmd.startsWith("TLIVE")) {
+  } else if (cmd.startsWith("TLIVEB")) {
     uint32_t afterSeq = 0U;
-    size_t limit = 256U;
-    int32_t firstSpace = cmd.indexOf(' ');
-    if (firstSpace > 0 && firstSpace < (int32_t)cmd.length() - 1) {
-      int32_t secondSpace = cmd.indexOf(' ', firstSpace + 1);
-      String afterStr;
-      String limitStr;
-      if (secondSpace > firstSpace) {
-        afterStr = cmd.substring(firstSpace + 1, secondSpace);
-        limitStr = cmd.substring(secondSpace + 1);
-      } else {
-        afterStr = cmd.substring(firstSpace + 1);
-      }
-      afterStr.trim();
-      limitStr.trim();
-      if (afterStr.length() > 0) {
-        afterSeq = (uint32_t)afterStr.toInt();
-      }
-      if (limitStr.length() > 0) {
-        int32_t parsedLimit = limitStr.toInt();
-        if (parsedLimit > 0) {
-          limit = (size_t)parsedLimit;
-        }
+    size_t limit = TELEMETRY_FRAME_MAX_SAMPLES;
+    parseSerialTelemetryLiveArgs(cmd, &afterSeq, &limit);
+    size_t frameLen = telemetryEncodeLiveFrame(afterSeq, limit, g_telemetryFrameBuf, sizeof(g_telemetryFrameBuf), nullptr);
+    if (!encodeBase64(g_telemetryFrameBuf, frameLen, g_telemetryFrameBase64, sizeof(g_telemetryFrameBase64))) {
+      Serial.println("ERR:Telemetry frame encode failed");
+      return;
+    }
+    sendSerialLengthPrefixedPayload(String(g_telemetryFrameBase64));
+
+  } else if (cmd == "TSTREAM" || cmd.startsWith("TSTREAM ")) {
+    uint32_t baud = 0U;
+    uint32_t afterSeq = 0U;
+    bool hasAfterSeq = false;
+    if (cmd == "TSTREAM STOP") {
+      Serial.println("OK TSTREAM STOP");
+      return;
+    }
+    String args = cmd.substring(7);
+    args.trim();
+    if (args.length() > 0) {
+      int32_t sp = args.indexOf(' ');
+      baud = (uint32_t)args.substring(0, (sp > 0) ? sp : args.length()).toInt();
+      if (sp > 0) {
+        afterSeq = (uint32_t)args.substring(sp + 1).toInt();
+        hasAfterSeq = true;
       }
     }
-    if (limit < 1U) limit = 1U;
-    if (limit > 256U) limit = 256U;
-    sendSerialLengthPrefixedPayload(buildTelemetryLivePayload(afterSeq, limit));
+    if (baud != 0U && !telemetryStreamBaudSupported(baud)) {
+      Serial.println("ERR:unsupported baud");
+      return;
+    }
+    if (!hasAfterSeq) {
+      TelemetryStatus status;
+      telemetryGetStatus(&status);
+      afterSeq = status.latestSeq;  /* Live by default; "TSTREAM b 0" replays the whole ring first */
+    }
+    telemetryStreamStart(baud, afterSeq);
 
-  } else if (cmd == "TSTART") {
+  } else if (cmd.startsWith("TLIVE")) {
+    uint32_t afterSeq = 0U;
+    size_t limit = 256U;
+    parseSerialTelemetryLiveArgs(cmd, &afterSeq, &limit);
+    sendTelemetryLiveReply(afterSeq, limit, true);
+
+  } else if (cmd == "TSTART" || cmd.startsWith("TSTART ")) {
+    uint32_t sampleInterval_us = TELEMETRY_SAMPLE_INTERVAL_US_DEFAULT;
+    String intervalStr = cmd.substring(6);
+    intervalStr.trim();
+    if (intervalStr.length() > 0 && intervalStr.toInt() > 0) {
+      sampleInterval_us = (uint32_t)intervalStr.toInt();
+    }
     if (!telemetryStartLogging(&g_storedVar,
                                g_antiSpinStepMs,
                                g_encoderInvertEnabled,
                                g_adcVoltageRange_mV,
-                               (uint8_t)g_carSel)) {
+                               (uint8_t)g_carSel,
+                               sampleInterval_us)) {
       Serial.println("ERR:Telemetry start failed");
       return;
     }
-    sendSerialLengthPrefixedPayload(buildTelemetryStatusPayload("Telemetry logging started"));
+    sendTelemetryStatusReply("Telemetry logging started", true);
 
   } else if (cmd == "TSTOP") {
     telemetryStopLogging();
-    sendSerialLengthPrefixedPayload(buildTelemetryStatusPayload("Telemetry logging stopped"));
+    sendTelemetryStatusReply("Telemetry logging stopped", true);
 
   } else if (cmd == "TCLEAR") {
     telemetryStopLogging();
     telemetryClear();
-    sendSerialLengthPrefixedPayload(buildTelemetryStatusPayload("Telemetry buffer cleared"));
+    sendTelemetryStatusReply("Telemetry buffer cleared", true);
 
   } else if (cmd == "TCONFIG") {
-    sendSerialLengthPrefixedPayload(buildTelemetryConfigSnapshotJson());
+    sendTelemetryConfigReply(true);
+
+  } else if (cmd == "PERF" || cmd == "PERF RESET") {
+    if (cmd == "PERF RESET") {
+      perfProbeReset();
+      controlLoopResetStats();
+    }
+    sendSerialLengthPrefixedPayload(buildPerfJson());
+
+  } else if (cmd == "LAPS" || cmd.startsWith("LAPS ")) {
+    handleSerialLapsCommand(cmd);
+
+  } else if (cmd == "RACE" || cmd.startsWith("RACE ")) {
+    handleSerialRaceCommand(cmd);
+
+  } else if (cmd == "BENCH" || cmd.startsWith("BENCH ")) {
+    handleSerialBenchCommand(cmd);
+
+  } else if (cmd.startsWith("TEXPORT ")) {
+    handleSerialExportCommand(cmd);
 
   } else if (cmd == "APPLY") {
     uint16_t previousWiFiMode = g_wifiConfiguredMode;
@@ -2253,22 +3199,19 @@ static void handleSerialCommand(const String& cmd) {
     Serial.setTimeout(1000);
     if (got != len) { Serial.println("ERR:timeout"); return; }
     jsonBuf[len] = '\0';
-    String json(jsonBuf);
 
     String errorMsg;
     uint8_t carIndex = (uint8_t)g_storedVar.selectedCarNumber;
-    if (!parseAndApplyWebPatch(json, &errorMsg, &carIndex)) {
+    if (!parseAndApplyWebPatch(jsonBuf, (size_t)len, &errorMsg, &carIndex)) {
       Serial.println("ERR:" + errorMsg);
       return;
     }
     scheduleWiFiPortalRestartIfNeeded(previousWiFiMode, previousWiFiSsid, previousWiFiPassword);
 
-    String outState = buildStateJson(carIndex);
     Serial.println("OK");
-    Serial.print(outState.length());
-    Serial.print('\n');
-    Serial.print(outState);
-    Serial.flush();
+    StateReply_type reply;
+    prepareStateReply(&reply, carIndex, 0, 0);
+    sendSerialJson(writeStateReplyBody, &reply);
 
   } else if (cmd == "SAVE") {
     saveEEPROM(g_storedVar);
@@ -2278,52 +3221,36 @@ static void handleSerialCommand(const String& cmd) {
   } else if (cmd == "RESTORE") {
     String lenStr = Serial.readStringUntil('\n');
     int32_t len = lenStr.toInt();
-    if (len <= 0 || len > 8192) {
+    if (len <= 0 || (uint32_t)len > BACKUP_RESTORE_MAX_BYTES) {
       Serial.println("ERR:invalid length");
       return;
     }
-    /* Static buffer avoids heap fragmentation for large payloads */
-    static char jsonBuf[8193];
+    if (!backupRestoreBegin()) {
+      Serial.println("ERR:restore already running");
+      return;
+    }
+    /* Parsed as it arrives: the backup is never held in RAM as a whole */
+    char chunk[256];
+    int32_t remaining = len;
     Serial.setTimeout(15000);
-    int32_t got = (int32_t)Serial.readBytes(jsonBuf, (size_t)len);
+    while (remaining > 0) {
+      size_t want = (remaining < (int32_t)sizeof(chunk)) ? (size_t)remaining : sizeof(chunk);
+      size_t got = Serial.readBytes(chunk, want);
+      if (got != want) {
+        break;
+      }
+      backupRestoreFeed(chunk, got);
+      remaining -= (int32_t)got;
+    }
     Serial.setTimeout(1000);
-    if (got != len) { Serial.println("ERR:timeout"); return; }
-    jsonBuf[len] = '\0';
-    String json(jsonBuf);
-    StoredVar_type tempVar;
+    if (remaining > 0) {
+      backupRestoreRelease();
+      Serial.println("ERR:timeout");
+      return;
+    }
     String errorMsg;
     String warningMsg;
-    uint16_t tempAntiSpinStep = g_antiSpinStepMs;
-    uint16_t tempAntiSpinStepPct = g_antiSpinStepPct;
-    uint16_t tempAntiSpinDisplayMode = g_antiSpinDisplayMode;
-    uint16_t tempEncoderInvert = g_encoderInvertEnabled ? 1 : 0;
-    uint16_t tempAdcVoltageRange = g_adcVoltageRange_mV;
-    uint16_t tempWiFiMode = getConfiguredWiFiMode();
-    char tempWiFiSsid[WIFI_STA_SSID_MAX_LEN + 1];
-    char tempWiFiPassword[WIFI_STA_PASS_MAX_LEN + 1];
-    char tempUiAuthUsername[UI_AUTH_USER_MAX_LEN + 1];
-    char tempUiAuthPassword[UI_AUTH_PASS_MAX_LEN + 1];
-    getConfiguredWiFiClientSsid(tempWiFiSsid, sizeof(tempWiFiSsid));
-    getConfiguredWiFiClientPassword(tempWiFiPassword, sizeof(tempWiFiPassword));
-    getCurrentUiAuthUsername(tempUiAuthUsername, sizeof(tempUiAuthUsername));
-    getCurrentUiAuthPassword(tempUiAuthPassword, sizeof(tempUiAuthPassword));
-    if (parseAndValidateJson(json, &tempVar, &tempAntiSpinStep, &tempAntiSpinStepPct, &tempAntiSpinDisplayMode,
-                             &tempEncoderInvert, &tempAdcVoltageRange,
-                             &tempWiFiMode, tempWiFiSsid, sizeof(tempWiFiSsid),
-                             tempWiFiPassword, sizeof(tempWiFiPassword),
-                             tempUiAuthUsername, sizeof(tempUiAuthUsername),
-                             tempUiAuthPassword, sizeof(tempUiAuthPassword),
-                             &errorMsg, &warningMsg)) {
-      g_storedVar = tempVar;
-      g_antiSpinStepMs = tempAntiSpinStep;
-      g_antiSpinStepPct = tempAntiSpinStepPct;
-      g_antiSpinDisplayMode = tempAntiSpinDisplayMode;
-      g_encoderInvertEnabled = tempEncoderInvert ? 1 : 0;
-      applyAdcVoltageRangeMilliVolts(tempAdcVoltageRange);
-      setConfiguredWiFiMode(tempWiFiMode);
-      setConfiguredWiFiClientCredentials(tempWiFiSsid, tempWiFiPassword);
-      setCurrentUiAuthCredentials(tempUiAuthUsername, tempUiAuthPassword);
-      saveEEPROM(g_storedVar);
+    if (backupRestoreFinish(&errorMsg, &warningMsg)) {
       if (warningMsg.length() > 0) {
         Serial.println("OK - Settings restored (" + warningMsg + ")");
       } else {
@@ -2340,9 +3267,8 @@ static void handleSerialCommand(const String& cmd) {
 
 /* HTTP route handlers */
 
-static String buildInfoJson() {
-  loadWiFiNetworkSettingsIfNeeded();
-  buildWifiSuffixIfNeeded();
+/* Everything /api/info reports, captured once so the serial length pass and send pass agree */
+typedef struct {
   char ver[8];
   char dataVer[8];
   char host[24];
@@ -2354,109 +3280,466 @@ static String buildInfoJson() {
   char wifiMacStr[24];
   char btMacStr[24];
   char buildInfo[32];
+  ControlLoopStats_type loopStats;
+  ThermalStatus_type thermal;
+  PowerGovStats_type power;
+  uint8_t pwmResBits;
+  uint32_t pwmRetimes;
+  uint32_t pwmReattaches;
+  int32_t pwmRetimeError;
+  BootTiming_type boot;
+  TaskMonitorStats_type tasks;
+} PortalInfoSnapshot_type;
+
+static void captureInfoSnapshot(PortalInfoSnapshot_type* info) {
+  loadWiFiNetworkSettingsIfNeeded();
+  buildWifiSuffixIfNeeded();
   uint8_t wifiMac[6] = {0};
   uint8_t btMac[6] = {0};
   bool wifiOk = readMacAddress(ESP_MAC_WIFI_STA, wifiMac);
   bool btOk = readMacAddress(ESP_MAC_BT, btMac);
-  infoSsid[0] = '\0';
-  ipText[0] = '\0';
-  spiffsRelease[0] = '\0';
+  info->infoSsid[0] = '\0';
+  info->ipText[0] = '\0';
+  info->spiffsRelease[0] = '\0';
 
-  sprintf(ver, "%d.%d", SW_MAJOR_VERSION, SW_MINOR_VERSION);
-  sprintf(dataVer, "v%d", STORED_VAR_VERSION);
-  getWiFiPortalHostName(host, sizeof(host));
-  HAL_GetTriggerSensorInfo(sensorInfo, sizeof(sensorInfo));
+  sprintf(info->ver, "%d.%d", SW_MAJOR_VERSION, SW_MINOR_VERSION);
+  sprintf(info->dataVer, "v%d", STORED_VAR_VERSION);
+  getWiFiPortalHostName(info->host, sizeof(info->host));
+  HAL_GetTriggerSensorInfo(info->sensorInfo, sizeof(info->sensorInfo));
 
   if (g_wifiActiveMode == WIFI_PORTAL_HOME) {
-    copyBoundedString(infoSsid, sizeof(infoSsid),
+    copyBoundedString(info->infoSsid, sizeof(info->infoSsid),
                       g_wifiConnectedSsid[0] != '\0' ? g_wifiConnectedSsid : g_wifiClientSsid);
-    copyBoundedString(ipText, sizeof(ipText), WiFi.localIP().toString().c_str());
+    if (g_wifiStaState == WIFI_STA_CONNECTED) {
+      copyBoundedString(info->ipText, sizeof(info->ipText), WiFi.localIP().toString().c_str());
+    }
   } else if (g_wifiActiveMode == WIFI_PORTAL_AP) {
-    getWiFiPortalSsid(infoSsid, sizeof(infoSsid));
-    copyBoundedString(ipText, sizeof(ipText), WiFi.softAPIP().toString().c_str());
+    getWiFiPortalSsid(info->infoSsid, sizeof(info->infoSsid));
+    copyBoundedString(info->ipText, sizeof(info->ipText), WiFi.softAPIP().toString().c_str());
   } else if (g_wifiConfiguredMode == WIFI_CONFIG_HOME) {
-    copyBoundedString(infoSsid, sizeof(infoSsid), g_wifiClientSsid);
+    copyBoundedString(info->infoSsid, sizeof(info->infoSsid), g_wifiClientSsid);
   } else {
-    getWiFiPortalSsid(infoSsid, sizeof(infoSsid));
+    getWiFiPortalSsid(info->infoSsid, sizeof(info->infoSsid));
   }
 
   String chipModel = String(ESP.getChipModel());
-  snprintf(chipInfo, sizeof(chipInfo), "%s r%d c%d %uMB",
+  snprintf(info->chipInfo, sizeof(info->chipInfo), "%s r%d c%d %uMB",
            chipModel.c_str(),
            ESP.getChipRevision(),
            ESP.getChipCores(),
            (unsigned int)(ESP.getFlashChipSize() / (1024UL * 1024UL)));
   if (wifiOk) {
-    snprintf(wifiMacStr, sizeof(wifiMacStr), "%02X:%02X:%02X:%02X:%02X:%02X",
+    snprintf(info->wifiMacStr, sizeof(info->wifiMacStr), "%02X:%02X:%02X:%02X:%02X:%02X",
              wifiMac[0], wifiMac[1], wifiMac[2], wifiMac[3], wifiMac[4], wifiMac[5]);
   } else {
-    copyBoundedString(wifiMacStr, sizeof(wifiMacStr), "unavailable");
+    copyBoundedString(info->wifiMacStr, sizeof(info->wifiMacStr), "unavailable");
   }
   if (btOk) {
-    snprintf(btMacStr, sizeof(btMacStr), "%02X:%02X:%02X:%02X:%02X:%02X",
+    snprintf(info->btMacStr, sizeof(info->btMacStr), "%02X:%02X:%02X:%02X:%02X:%02X",
              btMac[0], btMac[1], btMac[2], btMac[3], btMac[4], btMac[5]);
   } else {
-    copyBoundedString(btMacStr, sizeof(btMacStr), "unavailable");
-  }
-  snprintf(buildInfo, sizeof(buildInfo), "%s %s", __DATE__, __TIME__);
-  readSpiffsRelease(spiffsRelease, sizeof(spiffsRelease));
+    copyBoundedString(info->btMacStr, sizeof(info->btMacStr), "unavailable");
+  }
+  snprintf(info->buildInfo, sizeof(info->buildInfo), "%s %s", __DATE__, __TIME__);
+  readSpiffsRelease(info->spiffsRelease, sizeof(info->spiffsRelease));
+  controlLoopGetStats(&info->loopStats);
+  thermalModelGetStatus(&info->thermal);
+  powerGovernorGetStats(&info->power);
+  info->pwmResBits = HAL_GetMotorPwmResolution();
+  HAL_GetMotorPwmRetimeStats(&info->pwmRetimes, &info->pwmReattaches, &info->pwmRetimeError);
+  bootTimingGet(&info->boot);
+  taskMonitorGetStats(&info->tasks);
+}
+
+/* Load figures are null until two samples exist or when the build has no run-time stats */
+static void writeTaskMonitorLoad(JsonWriter_type* w, uint16_t load_permille) {
+  if (load_permille == TASK_MONITOR_LOAD_UNKNOWN) {
+    jsonWriterRaw(w, "null");
+  } else {
+    jsonWriterUInt(w, load_permille);
+  }
+}
+
+/* Closes the preceding object and writes ,"heap":{...},"tasks":{...} */
+static void writeTaskMonitorJson(JsonWriter_type* w, const TaskMonitorStats_type* tasks) {
+  jsonWriterRaw(w, "},\"heap\":{\"freeBytes\":");
+  jsonWriterUInt(w, tasks->heapFree_bytes);
+  jsonWriterRaw(w, ",\"minFreeBytes\":");
+  jsonWriterUInt(w, tasks->heapMinFree_bytes);
+  jsonWriterRaw(w, ",\"largestBlock\":");
+  jsonWriterUInt(w, tasks->heapLargest_bytes);
+  jsonWriterRaw(w, ",\"minLargestBlock\":");
+  jsonWriterUInt(w, tasks->heapMinLargest_bytes);
+  jsonWriterRaw(w, ",\"fragPct\":");
+  jsonWriterUInt(w, tasks->heapFragmentation_pct);
+  jsonWriterRaw(w, "},\"tasks\":{\"runTimeStats\":");
+  jsonWriterUInt(w, tasks->runTimeStats ? 1 : 0);
+  jsonWriterRaw(w, ",\"periodMs\":");
+  jsonWriterUInt(w, tasks->period_ms);
+  jsonWriterRaw(w, ",\"samples\":");
+  jsonWriterUInt(w, tasks->samples);
+  jsonWriterRaw(w, ",\"coreLoadPermille\":[");
+  for (uint8_t core = 0; core < TASK_MONITOR_CORES; core++) {
+    if (core > 0) jsonWriterChar(w, ',');
+    writeTaskMonitorLoad(w, tasks->coreLoad_permille[core]);
+  }
+  jsonWriterRaw(w, "],\"list\":[");
+  for (uint8_t i = 0; i < tasks->taskCount; i++) {
+    const TaskMonitorTask_type& task = tasks->tasks[i];
+    if (i > 0) jsonWriterChar(w, ',');
+    jsonWriterRaw(w, "{\"name\":\"");
+    jsonWriterEscaped(w, task.name);
+    jsonWriterRaw(w, "\",\"core\":");
+    if (task.core == TASK_MONITOR_CORE_ANY) {
+      jsonWriterRaw(w, "null");
+    } else {
+      jsonWriterUInt(w, task.core);
+    }
+    jsonWriterRaw(w, ",\"prio\":");
+    jsonWriterUInt(w, task.priority);
+    jsonWriterRaw(w, ",\"loadPermille\":");
+    writeTaskMonitorLoad(w, task.load_permille);
+    jsonWriterRaw(w, ",\"stackFree\":");
+    jsonWriterUInt(w, task.stackFree_bytes);
+    jsonWriterChar(w, '}');
+  }
+  jsonWriterRaw(w, "]}");
+}
+
+/* PortalJsonBody_fn; arg is a PortalInfoSnapshot_type */
+static void writeInfoJson(JsonWriter_type* w, const void* arg) {
+  const PortalInfoSnapshot_type* info = (const PortalInfoSnapshot_type*)arg;
+  const ControlLoopStats_type& loopStats = info->loopStats;
+  jsonWriterRaw(w, "{\"deviceId\":\"");
+  jsonWriterRaw(w, g_wifiSuffix);
+  jsonWriterRaw(w, "\",\"version\":\"");
+  jsonWriterRaw(w, info->ver);
+  jsonWriterRaw(w, "\",\"dataVersion\":\"");
+  jsonWriterEscaped(w, info->dataVer);
+  jsonWriterRaw(w, "\",\"spiffsRelease\":\"");
+  jsonWriterEscaped(w, info->spiffsRelease);
+  jsonWriterRaw(w, "\",\"halSensor\":\"");
+  jsonWriterEscaped(w, info->sensorInfo);
+  jsonWriterRaw(w, "\",\"chip\":\"");
+  jsonWriterEscaped(w, info->chipInfo);
+  jsonWriterRaw(w, "\",\"wifiMac\":\"");
+  jsonWriterEscaped(w, info->wifiMacStr);
+  jsonWriterRaw(w, "\",\"btMac\":\"");
+  jsonWriterEscaped(w, info->btMacStr);
+  jsonWriterRaw(w, "\",\"build\":\"");
+  jsonWriterEscaped(w, info->buildInfo);
+  jsonWriterRaw(w, "\",\"docsPath\":\"");
+  jsonWriterRaw(w, getDefaultDocsPath());
+  jsonWriterRaw(w, "\",\"wifiMode\":");
+  jsonWriterUInt(w, g_wifiConfiguredMode);
+  jsonWriterRaw(w, ",\"portalMode\":");
+  jsonWriterUInt(w, getActiveWiFiPortalMode());
+  jsonWriterRaw(w, ",\"wifiFallback\":");
+  jsonWriterUInt(w, isWiFiPortalApFallbackActive() ? 1 : 0);
+  jsonWriterRaw(w, ",\"staState\":");
+  jsonWriterUInt(w, getWiFiHomeConnectState());
+  jsonWriterRaw(w, ",\"hostName\":\"");
+  jsonWriterEscaped(w, info->host);
+  jsonWriterRaw(w, "\",\"ssid\":\"");
+  jsonWriterEscaped(w, info->infoSsid);
+  jsonWriterRaw(w, "\",\"ipAddress\":\"");
+  jsonWriterEscaped(w, info->ipText);
+  jsonWriterRaw(w, "\",\"screensaverLine1\":\"");
+  jsonWriterEscaped(w, g_storedVar.screensaverLine1);
+  jsonWriterRaw(w, "\",\"screensaverLine2\":\"");
+  jsonWriterEscaped(w, g_storedVar.screensaverLine2);
+  jsonWriterRaw(w, "\",\"authDefault\":");
+  jsonWriterUInt(w, areCurrentUiAuthCredentialsDefault() ? 1 : 0);
+  jsonWriterRaw(w, ",\"controlLoop\":{\"periodUs\":");
+  jsonWriterUInt(w, loopStats.targetPeriod_us);
+  jsonWriterRaw(w, ",\"lastUs\":");
+  jsonWriterUInt(w, loopStats.lastPeriod_us);
+  jsonWriterRaw(w, ",\"minUs\":");
+  jsonWriterUInt(w, loopStats.minPeriod_us);
+  jsonWriterRaw(w, ",\"maxUs\":");
+  jsonWriterUInt(w, loopStats.maxPeriod_us);
+  jsonWriterRaw(w, ",\"jitterUs\":");
+  jsonWriterUInt(w, loopStats.maxJitter_us);
+  jsonWriterRaw(w, ",\"missed\":");
+  jsonWriterUInt(w, loopStats.missedDeadlines);
+  jsonWriterRaw(w, ",\"cycles\":");
+  jsonWriterUInt(w, loopStats.cycles);
+  jsonWriterRaw(w, ",\"idleCycles\":");
+  jsonWriterUInt(w, loopStats.idleCycles);
+  jsonWriterRaw(w, ",\"staleTrigger\":");
+  jsonWriterUInt(w, loopStats.staleTriggerTicks);
+  jsonWriterRaw(w, ",\"repeatTrigger\":");
+  jsonWriterUInt(w, loopStats.repeatTriggerTicks);
+  jsonWriterRaw(w, ",\"triggerFilter\":");
+  jsonWriterUInt(w, loopStats.filterMode);
+  jsonWriterRaw(w, ",\"filterCutoffDHz\":");
+  jsonWriterUInt(w, loopStats.filterCutoff_dHz);
+  jsonWriterRaw(w, ",\"filterLagUs\":");
+  jsonWriterUInt(w, loopStats.filterLag_us);
+  jsonWriterRaw(w, ",\"triggerToPwmUs\":");
+  jsonWriterUInt(w, loopStats.triggerToPwmLast_us);
+  jsonWriterRaw(w, ",\"triggerToPwmAvgUs\":");
+  jsonWriterUInt(w, loopStats.triggerToPwmAvg_us);
+  jsonWriterRaw(w, ",\"triggerToPwmMaxUs\":");
+  jsonWriterUInt(w, loopStats.triggerToPwmMax_us);
+  jsonWriterRaw(w, ",\"hwTimer\":");
+  jsonWriterUInt(w, loopStats.timerActive ? 1 : 0);
+  jsonWriterRaw(w, ",\"error\":");
+  jsonWriterRaw(w, loopStats.timerActive ? "null" : "\"hwTimerUnavailable\"");
+  jsonWriterRaw(w, ",\"deadlineArmed\":");
+  jsonWriterUInt(w, loopStats.deadlineArmed ? 1 : 0);
+  jsonWriterRaw(w, ",\"deadlineOverruns\":");
+  jsonWriterUInt(w, loopStats.deadlineOverruns);
+  jsonWriterRaw(w, ",\"lastOverrunMs\":");
+  jsonWriterUInt(w, loopStats.lastOverrunMs);
+  jsonWriterRaw(w, ",\"lastOverrunLateUs\":");
+  jsonWriterUInt(w, loopStats.lastOverrunLate_us);
+  const ThermalStatus_type& thermal = info->thermal;
+  jsonWriterRaw(w, "},\"thermal\":{\"tempSense\":");
+  jsonWriterUInt(w, thermal.tempSense ? 1 : 0);
+  jsonWriterRaw(w, ",\"chipTempC\":");
+  if (thermal.chipTemp_C == THERMAL_TEMP_UNKNOWN) {
+    jsonWriterRaw(w, "null");
+  } else {
+    jsonWriterInt(w, thermal.chipTemp_C);
+  }
+  jsonWriterRaw(w, ",\"tempAgeMs\":");
+  jsonWriterUInt(w, thermal.tempAge_ms);
+  jsonWriterRaw(w, ",\"loadPct\":");
+  jsonWriterUInt(w, thermal.load_pct);
+  jsonWriterRaw(w, ",\"limitPct\":");
+  jsonWriterUInt(w, thermal.limit_pct);
+  jsonWriterRaw(w, ",\"targetPct\":");
+  jsonWriterUInt(w, thermal.target_pct);
+  jsonWriterRaw(w, ",\"derating\":");
+  jsonWriterUInt(w, thermal.derating ? 1 : 0);
+  jsonWriterRaw(w, ",\"senseReads\":");
+  jsonWriterUInt(w, thermal.senseReads);
+  jsonWriterRaw(w, ",\"senseAborts\":");
+  jsonWriterUInt(w, thermal.senseAborts);
+  const PowerGovStats_type& power = info->power;
+  jsonWriterRaw(w, "},\"power\":{\"idle\":");
+  jsonWriterUInt(w, power.state == POWER_GOV_IDLE ? 1 : 0);
+  jsonWriterRaw(w, ",\"cpuMHz\":");
+  jsonWriterUInt(w, getCpuFrequencyMhz());
+  jsonWriterRaw(w, ",\"dfs\":");
+  jsonWriterUInt(w, power.pmActive ? 1 : 0);
+  jsonWriterRaw(w, ",\"lightSleep\":");
+  jsonWriterUInt(w, power.lightSleepAllowed ? 1 : 0);
+  jsonWriterRaw(w, ",\"idleEntries\":");
+  jsonWriterUInt(w, power.idleEntries);
+  jsonWriterRaw(w, ",\"idleMs\":");
+  jsonWriterUInt(w, power.idleTime_ms);
+  jsonWriterRaw(w, ",\"wakeUs\":");
+  jsonWriterUInt(w, power.lastWakeLatency_us);
+  jsonWriterRaw(w, ",\"maxWakeUs\":");
+  jsonWriterUInt(w, power.maxWakeLatency_us);
+  jsonWriterRaw(w, "},\"motorPwm\":{\"resBits\":");
+  jsonWriterUInt(w, info->pwmResBits);
+  jsonWriterRaw(w, ",\"retimes\":");
+  jsonWriterUInt(w, info->pwmRetimes);
+  jsonWriterRaw(w, ",\"reattaches\":");
+  jsonWriterUInt(w, info->pwmReattaches);
+  jsonWriterRaw(w, ",\"lastRetimeError\":");
+  jsonWriterInt(w, info->pwmRetimeError);
+  const BootTiming_type& boot = info->boot;
+  jsonWriterRaw(w, "},\"boot\":{\"resetReason\":");
+  jsonWriterUInt(w, boot.resetReason);
+  jsonWriterRaw(w, ",\"hwUs\":");
+  jsonWriterUInt(w, boot.stage_us[BOOT_STAGE_HW]);
+  jsonWriterRaw(w, ",\"settingsUs\":");
+  jsonWriterUInt(w, boot.stage_us[BOOT_STAGE_SETTINGS]);
+  jsonWriterRaw(w, ",\"driveUs\":");
+  jsonWriterUInt(w, boot.stage_us[BOOT_STAGE_DRIVE]);
+  jsonWriterRaw(w, ",\"uiUs\":");
+  jsonWriterUInt(w, boot.stage_us[BOOT_STAGE_UI]);
+  writeTaskMonitorJson(w, &info->tasks);
+  jsonWriterRaw(w, "}");
+}
+
+static void sendInfoReply(bool toSerial) {
+  PortalInfoSnapshot_type info;
+  captureInfoSnapshot(&info);
+  sendPortalJson(toSerial, writeInfoJson, &info);
+}
+
+static void handleInfo() {
+  sendInfoReply(false);
+}
+
+/**
+ * @brief Build control tick timing report (one entry per PerfStage_enum)
+ * @details Times are in nanoseconds; the budget is the control loop period.
+ */
+static String buildPerfJson() {
+  ControlLoopStats_type loopStats;
+  controlLoopGetStats(&loopStats);
 
   String json;
-  json.reserve(700);
-  json += "{\"deviceId\":\"";
-  json += g_wifiSuffix;
-  json += "\",\"version\":\"";
-  json += ver;
-  json += "\",\"dataVersion\":\"";
-  appendJsonEscaped(json, dataVer);
-  json += "\",\"spiffsRelease\":\"";
-  appendJsonEscaped(json, spiffsRelease);
-  json += "\",\"halSensor\":\"";
+  json.reserve(560 + PERF_STAGE_COUNT * 90);
+  json += "{\"enabled\":";
+  json += String(perfProbeIsEnabled() ? 1 : 0);
+  json += ",\"cpuMHz\":";
+  json += String(getCpuFrequencyMhz());
+  json += ",\"budgetNs\":";
+  json += String(loopStats.targetPeriod_us * 1000UL);
+  json += ",\"sensor\":\"";
+  char sensorInfo[40];
+  HAL_GetTriggerSensorInfo(sensorInfo, sizeof(sensorInfo));
   appendJsonEscaped(json, sensorInfo);
-  json += "\",\"chip\":\"";
-  appendJsonEscaped(json, chipInfo);
-  json += "\",\"wifiMac\":\"";
-  appendJsonEscaped(json, wifiMacStr);
-  json += "\",\"btMac\":\"";
-  appendJsonEscaped(json, btMacStr);
-  json += "\",\"build\":\"";
-  appendJsonEscaped(json, buildInfo);
-  json += "\",\"docsPath\":\"";
-  json += getDefaultDocsPath();
-  json += "\",\"wifiMode\":";
-  json += String(g_wifiConfiguredMode);
-  json += ",\"portalMode\":";
-  json += String(getActiveWiFiPortalMode());
-  json += ",\"wifiFallback\":";
-  json += String(isWiFiPortalApFallbackActive() ? 1 : 0);
-  json += ",\"hostName\":\"";
-  appendJsonEscaped(json, host);
-  json += "\",\"ssid\":\"";
-  appendJsonEscaped(json, infoSsid);
-  json += "\",\"ipAddress\":\"";
-  appendJsonEscaped(json, ipText);
-  json += "\",\"screensaverLine1\":\"";
-  appendJsonEscaped(json, g_storedVar.screensaverLine1);
-  json += "\",\"screensaverLine2\":\"";
-  appendJsonEscaped(json, g_storedVar.screensaverLine2);
-  json += "\",\"authDefault\":";
-  json += String(areCurrentUiAuthCredentialsDefault() ? 1 : 0);
-  json += "}";
-
+  ThrottleLutStats_type lutStats;
+  throttleLutGetStats(&lutStats);
+  json += "\",\"throttleLut\":{\"rebuilds\":";
+  json += String(lutStats.rebuilds);
+  json += ",\"fallbacks\":";
+  json += String(lutStats.fallbacks);
+  TriggerLutStats_type trigLutStats;
+  triggerLutGetStats(&trigLutStats);
+  json += "},\"triggerLut\":{\"rebuilds\":";
+  json += String(trigLutStats.rebuilds);
+  json += ",\"fallbacks\":";
+  json += String(trigLutStats.fallbacks);
+  json += ",\"entries\":";
+  json += String(trigLutStats.entries);
+  json += ",\"shift\":";
+  json += String(trigLutStats.shift);
+  json += ",\"linearized\":";
+  json += String(trigLutStats.linearized ? 1 : 0);
+  ExtPotStats_type extPotStats;
+  extPotGetStats(&extPotStats);
+  json += "},\"extPot\":{\"samples\":";
+  json += String(extPotStats.samples);
+  json += ",\"publishes\":";
+  json += String(extPotStats.publishes);
+  json += ",\"radioHeld\":";
+  json += String(extPotStats.radioHeld);
+  OledScreenCacheStats_type screenStats;
+  oledScreenCacheGetStats(&screenStats);
+  json += "},\"screenCache\":{\"hits\":";
+  json += String(screenStats.hits);
+  json += ",\"misses\":";
+  json += String(screenStats.misses);
+  ActiveTuningStats_type tuningStats;
+  activeTuningGetStats(&tuningStats);
+  json += "},\"activeTuning\":{\"publishes\":";
+  json += String(tuningStats.publishes);
+  json += ",\"retries\":";
+  json += String(tuningStats.retries);
+  json += ",\"stale\":";
+  json += String(tuningStats.stale);
+  AdcSamplerStats_type adcStats;
+  adcSamplerGetStats(&adcStats);
+  json += "},\"adc\":{\"continuous\":";
+  json += String(adcStats.running ? 1 : 0);
+  json += ",\"pins\":";
+  json += String(adcStats.pinCount);
+  json += ",\"frames\":";
+  json += String(adcStats.frames);
+  json += ",\"errors\":";
+  json += String(adcStats.readErrors);
+  CurrentSamplerStats_type currentStats;
+  currentSamplerGetStats(&currentStats);
+  json += "},\"currentSense\":{\"pwmSync\":";
+  json += String(currentStats.running ? 1 : 0);
+  json += ",\"synced\":";
+  json += String(currentStats.syncedSamples);
+  json += ",\"freeRun\":";
+  json += String(currentStats.freeRunSamples);
+  json += ",\"pwmPeriodUs\":";
+  json += String(currentStats.pwmPeriod_us);
+  json += "},\"stages\":[";
+  for (uint8_t stage = 0; stage < PERF_STAGE_COUNT; stage++) {
+    PerfStageStats_type stats;
+    perfProbeGetStageStats(stage, &stats);
+    if (stage > 0) json += ",";
+    json += "{\"name\":\"";
+    json += perfProbeStageName(stage);
+    json += "\",\"count\":";
+    json += String(stats.count);
+    json += ",\"minNs\":";
+    json += String(stats.min_ns);
+    json += ",\"avgNs\":";
+    json += String(stats.avg_ns);
+    json += ",\"maxNs\":";
+    json += String(stats.max_ns);
+    json += ",\"p99Ns\":";
+    json += String(stats.p99_ns);
+    json += "}";
+  }
+  json += "]}";
   return json;
 }
 
-static void handleInfo() {
-  g_wifiServer->send(200, "application/json", buildInfoJson());
+static void handlePerf() {
+  g_wifiServer->send(200, "application/json", buildPerfJson());
+}
+
+static void handlePerfReset() {
+  perfProbeReset();
+  controlLoopResetStats();
+  g_wifiServer->send(200, "application/json", buildPerfJson());
+}
+
+/**
+ * @brief Schema ETag: CRC-32 of the schema text, worked out on first use
+ * @details The schema is built from compile-time limits only, so the tag changes with the
+ *          firmware and browsers can revalidate it for a 304 instead of re-downloading.
+ */
+static const char* getSchemaEtag() {
+  static char etag[24] = "";
+  if (etag[0] == '\0') {
+    JsonWriter_type w;
+    uint32_t crc = 0;
+    jsonWriterBegin(&w, crcJsonSink, &crc);
+    writeSchemaJson(&w, nullptr);
+    jsonWriterEnd(&w);
+    snprintf(etag, sizeof(etag), "sc%d.%d-%08lx", SW_MAJOR_VERSION, SW_MINOR_VERSION, (unsigned long)crc);
+  }
+  return etag;
 }
 
 static void handleSchema() {
-  g_wifiServer->send(200, "application/json", buildSchemaJson());
+  const char* etag = getSchemaEtag();
+  char etagHeader[28];
+  snprintf(etagHeader, sizeof(etagHeader), "\"%s\"", etag);
+  g_wifiServer->sendHeader("ETag", etagHeader);
+  g_wifiServer->sendHeader("Cache-Control", "no-cache");
+  if (requestEtagMatches(etag)) {
+    g_wifiServer->send(304);
+    return;
+  }
+  sendHttpJson(200, writeSchemaJson, nullptr);
 }
 
 static void handleState() {
-  uint8_t carIndex = getRequestedCarIndex();
-  g_wifiServer->send(200, "application/json", buildStateJson(carIndex));
+  uint32_t since = 0;
+  uint32_t epoch = 0;
+  if (g_wifiServer->hasArg("since")) {
+    since = (uint32_t)strtoul(g_wifiServer->arg("since").c_str(), nullptr, 10);
+    epoch = (uint32_t)strtoul(g_wifiServer->arg("epoch").c_str(), nullptr, 10);
+  }
+  StateReply_type reply;
+  prepareStateReply(&reply, getRequestedCarIndex(), epoch, since);
+  if (reply.delta && !reply.global && !reply.carBlock) {
+    g_wifiServer->send(304);
+    return;
+  }
+  sendHttpJson(200, writeStateReplyBody, &reply);
+}
+
+typedef struct {
+  bool saved;
+  uint8_t carIndex;
+} ApplyReply_type;
+
+/* PortalJsonBody_fn; arg is an ApplyReply_type */
+static void writeApplyReply(JsonWriter_type* w, const void* arg) {
+  const ApplyReply_type* reply = (const ApplyReply_type*)arg;
+  jsonWriterRaw(w, "{\"ok\":true,\"saved\":");
+  jsonWriterUInt(w, reply->saved ? 1 : 0);
+  jsonWriterRaw(w, ",\"state\":");
+  writeStateJson(w, reply->carIndex);
+  jsonWriterChar(w, '}');
 }
 
 static void handleApply() {
@@ -2476,7 +3759,7 @@ static void handleApply() {
   copyBoundedString(previousWiFiSsid, sizeof(previousWiFiSsid), g_wifiClientSsid);
   copyBoundedString(previousWiFiPassword, sizeof(previousWiFiPassword), g_wifiClientPassword);
   uint8_t carIndex = g_storedVar.selectedCarNumber;
-  if (!parseAndApplyWebPatch(payload, &errorMsg, &carIndex)) {
+  if (!parseAndApplyWebPatch(payload.c_str(), payload.length(), &errorMsg, &carIndex)) {
     String out = "{\"ok\":false,\"error\":\"";
     appendJsonEscaped(out, errorMsg.c_str());
     out += "\"}";
@@ -2488,12 +3771,8 @@ static void handleApply() {
     saveEEPROM(g_storedVar);
   }
 
-  String out = "{\"ok\":true,\"saved\":";
-  out += String(saveAfter ? 1 : 0);
-  out += ",\"state\":";
-  out += buildStateJson(carIndex);
-  out += "}";
-  g_wifiServer->send(200, "application/json", out);
+  ApplyReply_type reply = {saveAfter, carIndex};
+  sendHttpJson(200, writeApplyReply, &reply);
   scheduleWiFiPortalRestartIfNeeded(previousWiFiMode, previousWiFiSsid, previousWiFiPassword);
 }
 
@@ -2538,6 +3817,68 @@ static size_t getTelemetryLiveLimit() {
   return (size_t)limit;
 }
 
+/**
+ * @brief GET /api/laps[?session=N&from=K&limit=L]
+ */
+static void handleLaps() {
+  LapsReply_type* reply = (LapsReply_type*)malloc(sizeof(LapsReply_type));
+  if (reply == nullptr) {
+    g_wifiServer->send(503, "application/json", "{\"ok\":false,\"error\":\"Out of memory\"}");
+    return;
+  }
+  bool history = g_wifiServer->hasArg("session");
+  captureLapsReply(reply, history, getTelemetryArgU32("session", 0U), getTelemetryArgU32("from", 0U),
+                   getTelemetryArgU32("limit", LAPS_HISTORY_PAGE_MAX));
+  sendHttpJson(200, writeLapsJson, reply);
+  free(reply);
+}
+
+/**
+ * @brief POST /api/laps/config?sectors=N (also starts a new session) or /api/laps/new
+ */
+static void handleLapsConfig() {
+  uint32_t sectors = getTelemetryArgU32("sectors", 0U);
+  if (sectors > LAP_ENGINE_MAX_SECTORS || !lapEngineSetSectorCount((uint8_t)sectors)) {
+    g_wifiServer->send(400, "application/json", "{\"ok\":false,\"error\":\"Invalid sector count\"}");
+    return;
+  }
+  g_wifiServer->send(200, "application/json", "{\"ok\":true}");
+}
+
+static void handleLapsNewSession() {
+  lapEngineNewSession();
+  g_wifiServer->send(200, "application/json", "{\"ok\":true}");
+}
+
+/**
+ * @brief GET /api/race: ESP-NOW race link status
+ */
+static void handleRaceLink() {
+  RaceLinkStatus_type status;
+  raceLinkGetStatus(&status);
+  sendHttpJson(200, writeRaceLinkJson, &status);
+}
+
+/**
+ * @brief POST /api/race/config?enabled=0|1&lane=N&pair=1&forget=1 (any subset)
+ */
+static void handleRaceLinkConfig() {
+  if (g_wifiServer->hasArg("lane") && !raceLinkSetLane((uint8_t)min(getTelemetryArgU32("lane", 0U), (uint32_t)255U))) {
+    g_wifiServer->send(400, "application/json", "{\"ok\":false,\"error\":\"Invalid lane\"}");
+    return;
+  }
+  if (g_wifiServer->hasArg("enabled")) {
+    raceLinkSetEnabled(getTelemetryArgU32("enabled", 0U) != 0U);
+  }
+  if (getTelemetryArgU32("forget", 0U) != 0U) {
+    raceLinkForget();
+  }
+  if (getTelemetryArgU32("pair", 0U) != 0U) {
+    raceLinkPair();
+  }
+  g_wifiServer->send(200, "application/json", "{\"ok\":true}");
+}
+
 static void formatHalfPercentValue(uint16_t raw, char* out, size_t outLen) {
   if (out == nullptr || outLen == 0) {
     return;
@@ -2553,260 +3894,397 @@ static const char* getTelemetryReleaseModeLabel(uint8_t mode) {
   }
 }
 
-static void appendTelemetryCarParamJson(String& json, const CarParam_type& car) {
-  char buf[256];
-  json += "{";
-  json += "\"name\":\"";
-  appendJsonEscaped(json, car.carName);
-  json += "\"";
-  snprintf(buf, sizeof(buf),
-           ",\"carNumber\":%u,\"minSpeedHalfPct\":%u,\"brake\":%u,\"maxSpeed\":%u,"
-           "\"curveInputPct\":%u,\"curveDiffPct\":%u,\"fade\":%u,\"antiSpin\":%u,"
-           "\"freqPwm100Hz\":%u,\"brakeButton\":%u,\"releaseMode\":%u,\"releaseZone\":%u,\"releaseLevel\":%u",
-           (unsigned int)car.carNumber,
-           (unsigned int)car.minSpeed,
-           (unsigned int)car.brake,
-           (unsigned int)car.maxSpeed,
-           (unsigned int)car.throttleCurveVertex.inputThrottle,
-           (unsigned int)car.throttleCurveVertex.curveSpeedDiff,
-           (unsigned int)car.fade,
-           (unsigned int)car.antiSpin,
-           (unsigned int)car.freqPWM,
-           (unsigned int)car.brakeButtonReduction,
-           (unsigned int)car.quickBrakeEnabled,
-           (unsigned int)car.quickBrakeThreshold,
-           (unsigned int)car.quickBrakeStrength);
-  json += buf;
-  json += "}";
-}
-
-static void appendTelemetryCarNamesJson(String& json, const StoredVar_type& storedVar) {
-  json += "[";
+static void writeTelemetryCarParamJson(JsonWriter_type* w, const CarParam_type& car) {
+  jsonWriterRaw(w, "{\"name\":");
+  jsonWriterString(w, car.carName);
+  jsonWriterPrintf(w, ",\"carNumber\":%u,\"minSpeedHalfPct\":%u,\"brake\":%u,\"maxSpeed\":%u,"
+                      "\"curveInputPct\":%u,\"curveDiffPct\":%u,\"fade\":%u,\"antiSpin\":%u",
+                   (unsigned int)car.carNumber,
+                   (unsigned int)car.minSpeed,
+                   (unsigned int)car.brake,
+                   (unsigned int)car.maxSpeed,
+                   (unsigned int)car.throttleCurveVertex.inputThrottle,
+                   (unsigned int)car.throttleCurveVertex.curveSpeedDiff,
+                   (unsigned int)car.fade,
+                   (unsigned int)car.antiSpin);
+  char curvePoints[THROTTLE_CURVE_TEXT_MAX];
+  throttleCurveShapeFormat(&car.throttleCurveShape, curvePoints, sizeof(curvePoints));
+  jsonWriterPrintf(w, ",\"curveMode\":%u,\"curvePoints\":\"%s\"", (unsigned int)car.throttleCurveShape.mode, curvePoints);
+  jsonWriterPrintf(w, ",\"freqPwm100Hz\":%u,\"brakeButton\":%u,\"releaseMode\":%u,\"releaseZone\":%u,\"releaseLevel\":%u,"
+                      "\"antiSpinMode\":%u,\"brakeBite\":%u,\"brakeBiteHold\":%u,\"brakeRamp\":%u,"
+                      "\"motorResistanceMohm\":%u,\"motorNoLoadMa\":%u,\"freqPwmSweep100Hz\":%u}",
+                   (unsigned int)car.freqPWM,
+                   (unsigned int)car.brakeButtonReduction,
+                   (unsigned int)car.quickBrakeEnabled,
+                   (unsigned int)car.quickBrakeThreshold,
+                   (unsigned int)car.quickBrakeStrength,
+                   (unsigned int)car.antiSpinMode,
+                   (unsigned int)car.brakeBite,
+                   (unsigned int)car.brakeBiteHold,
+                   (unsigned int)car.brakeRamp,
+                   (unsigned int)car.motorResistance,
+                   (unsigned int)car.motorNoLoadCurrent,
+                   (unsigned int)car.freqPWMSweep);
+}
+
+static void writeTelemetryCarNamesJson(JsonWriter_type* w) {
+  char name[CAR_NAME_MAX_SIZE + 1];
+  jsonWriterChar(w, '[');
   for (uint8_t i = 0; i < CAR_MAX_COUNT; i++) {
     if (i > 0) {
-      json += ",";
+      jsonWriterChar(w, ',');
     }
-    json += "\"";
-    appendJsonEscaped(json, storedVar.carParam[i].carName);
-    json += "\"";
+    carProfileGetName(i, name, sizeof(name));
+    jsonWriterString(w, name);
   }
-  json += "]";
+  jsonWriterChar(w, ']');
 }
 
-static String buildTelemetryConfigSummaryJsonFromSnapshot(const TelemetryConfigSnapshot& snapshot,
-                                                          uint8_t activeCarIndex) {
+static void writeTelemetryConfigSummaryJson(JsonWriter_type* w,
+                                            const TelemetryConfigSnapshot& snapshot,
+                                            uint8_t activeCarIndex) {
   if (activeCarIndex >= CAR_MAX_COUNT) {
     activeCarIndex = 0;
   }
 
-  String json;
-  json.reserve(960);
-  json += "{";
-  json += "\"selectedCarNumber\":";
-  json += String(activeCarIndex);
-  json += ",\"antiSpinStepMs\":";
-  json += String(snapshot.antiSpinStepMs);
-  json += ",\"encoderInvert\":";
-  json += String(snapshot.encoderInvertEnabled ? 1U : 0U);
-  json += ",\"adcVoltageRangeMv\":";
-  json += String(snapshot.adcVoltageRange_mV);
-  json += ",\"statusSlots\":[";
+  jsonWriterRaw(w, "{\"selectedCarNumber\":");
+  jsonWriterUInt(w, activeCarIndex);
+  jsonWriterRaw(w, ",\"antiSpinStepMs\":");
+  jsonWriterUInt(w, snapshot.antiSpinStepMs);
+  jsonWriterRaw(w, ",\"encoderInvert\":");
+  jsonWriterUInt(w, snapshot.encoderInvertEnabled ? 1U : 0U);
+  jsonWriterRaw(w, ",\"adcVoltageRangeMv\":");
+  jsonWriterUInt(w, snapshot.adcVoltageRange_mV);
+  jsonWriterRaw(w, ",\"statusSlots\":[");
   for (uint8_t i = 0; i < STATUS_SLOTS; i++) {
     if (i > 0) {
-      json += ",";
+      jsonWriterChar(w, ',');
     }
-    json += String(normalizeStatusSlotForUi(snapshot.storedVar.statusSlot[i]));
-  }
-  json += "],\"carNames\":";
-  appendTelemetryCarNamesJson(json, snapshot.storedVar);
-  json += ",\"activeCar\":";
-  appendTelemetryCarParamJson(json, snapshot.storedVar.carParam[activeCarIndex]);
-  json += "}";
-  return json;
-}
-
-static void appendTelemetryEventJson(String& json, const TelemetryEvent& event) {
-  json += "{";
-  json += "\"id\":";
-  json += String((unsigned long)event.id);
-  json += ",\"tMs\":";
-  json += String((unsigned long)event.t_ms);
-  json += ",\"sampleSeq\":";
-  json += String((unsigned long)event.sampleSeq);
-  json += ",\"type\":\"";
-  json += (event.type == TELEMETRY_EVENT_CAR_SELECT) ? "car_select" : "car_params";
-  json += "\",\"carIndex\":";
-  json += String((unsigned int)event.carIndex);
-  json += ",\"previousCarIndex\":";
-  json += String((unsigned int)event.previousCarIndex);
-  json += ",\"changedMask\":";
-  json += String((unsigned int)event.changedMask);
-  json += ",\"carParams\":";
-  appendTelemetryCarParamJson(json, event.carParam);
-  json += "}";
-}
-
-static void appendTelemetryStatusFields(String& json, const TelemetryStatus& status) {
-  char buf[320];
-  uint8_t sessionCarIndex = (status.sessionStartCarIndex < CAR_MAX_COUNT) ? status.sessionStartCarIndex : 0;
+    jsonWriterUInt(w, normalizeStatusSlotForUi(snapshot.storedVar.statusSlot[i]));
+  }
+  jsonWriterRaw(w, "],\"carNames\":");
+  writeTelemetryCarNamesJson(w);
+  jsonWriterRaw(w, ",\"activeCar\":");
+  writeTelemetryCarParamJson(w, snapshot.storedVar.activeCar);
+  jsonWriterChar(w, '}');
+}
+
+static void writeTelemetryEventJson(JsonWriter_type* w, const TelemetryEvent& event) {
+  jsonWriterPrintf(w, "{\"id\":%lu,\"tMs\":%lu,\"sampleSeq\":%lu,\"type\":\"%s\",\"carIndex\":%u,\"previousCarIndex\":%u,\"changedMask\":%u,\"carParams\":",
+                   (unsigned long)event.id,
+                   (unsigned long)event.t_ms,
+                   (unsigned long)event.sampleSeq,
+                   (event.type == TELEMETRY_EVENT_CAR_SELECT) ? "car_select"
+                     : (event.type == TELEMETRY_EVENT_DEADLINE) ? "deadline" : "car_params",
+                   (unsigned int)event.carIndex,
+                   (unsigned int)event.previousCarIndex,
+                   (unsigned int)event.changedMask);
+  writeTelemetryCarParamJson(w, event.carParam);
+  jsonWriterChar(w, '}');
+}
+
+/* Telemetry status plus the live controller values reported with it, captured once per reply */
+typedef struct {
+  TelemetryStatus status;
+  uint8_t sessionCarIndex;
+  uint8_t currentCarIndex;
+  uint8_t triggerPct;
+  uint8_t outputPct;
+  uint16_t outputPermille;
+  uint8_t pwmResBits;
+  uint8_t brakePct;
+  uint8_t releaseMode;
+  uint16_t sensiHalfPct;
+  uint16_t vinMv;
+  uint16_t currentMa;
+  uint16_t bemfMv;
+  int16_t speedHalfPct;   /* -1 without a back-EMF estimate */
+  uint8_t tractionTrimPct;
+  ThermalStatus_type thermal;
+  bool wifiActive;
+} TelemetryStatusView_type;
+
+static void captureTelemetryStatusView(const TelemetryStatus& status, TelemetryStatusView_type* view) {
   uint8_t currentCarIndex = (g_carSel < CAR_MAX_COUNT) ? (uint8_t)g_carSel : (uint8_t)g_storedVar.selectedCarNumber;
-  uint8_t triggerPct = (uint8_t)(((uint32_t)g_escVar.trigger_norm * 100U) / THROTTLE_NORMALIZED);
-  uint8_t outputPct = (uint8_t)constrain((int)g_escVar.outputSpeed_pct, 0, 100);
-  uint8_t brakePct = (uint8_t)constrain((int)g_escVar.effectiveBrake_pct, 0, 100);
+  view->status = status;
+  view->sessionCarIndex = (status.sessionStartCarIndex < CAR_MAX_COUNT) ? status.sessionStartCarIndex : 0;
+  view->currentCarIndex = currentCarIndex;
+  view->triggerPct = (uint8_t)(((uint32_t)g_escVar.trigger_norm * 100U) / THROTTLE_NORMALIZED);
+  view->outputPct = (uint8_t)constrain((int)g_escVar.outputSpeed_pct, 0, 100);
+  view->outputPermille = (uint16_t)constrain((int)g_escVar.outputSpeed_permille, 0, 1000);
+  view->pwmResBits = HAL_GetMotorPwmResolution();
+  view->brakePct = (uint8_t)constrain((int)g_escVar.effectiveBrake_pct, 0, 100);
   if (digitalRead(BUTT_PIN) == BUTTON_PRESSED && g_escVar.trigger_norm == 0) {
-    brakePct = (uint8_t)constrain((int)g_storedVar.carParam[currentCarIndex].brakeButtonReduction, 0, 100);
-  }
-
-  snprintf(buf, sizeof(buf),
-           ",\"loggingActive\":%u,\"hasData\":%u,\"wrapped\":%u,\"sampleRateMs\":%u,\"capacity\":%u,"
-           "\"storedCount\":%u,\"eventCount\":%u,\"eventCapacity\":%u,"
-           "\"sessionId\":%lu,\"sessionStartMs\":%lu,\"oldestSeq\":%lu,\"latestSeq\":%lu,"
-           "\"oldestEventId\":%lu,\"latestEventId\":%lu,"
-           "\"wifiActive\":%u,\"sessionStartCarIndex\":%u,\"currentCarIndex\":%u",
-           status.loggingActive ? 1U : 0U,
-           status.hasData ? 1U : 0U,
-           status.wrapped ? 1U : 0U,
-           status.sampleRateMs,
-           status.capacity,
-           status.storedCount,
-           status.eventCount,
-           status.eventCapacity,
-           (unsigned long)status.sessionId,
-           (unsigned long)status.sessionStartMs,
-           (unsigned long)status.oldestSeq,
-           (unsigned long)status.latestSeq,
-           (unsigned long)status.oldestEventId,
-           (unsigned long)status.latestEventId,
-           isWiFiPortalActive() ? 1U : 0U,
-           sessionCarIndex,
-           currentCarIndex);
-  json += buf;
-
-  json += ",\"sessionStartCarName\":\"";
-  appendJsonEscaped(json, g_storedVar.carParam[sessionCarIndex].carName);
-  json += "\",\"currentCarName\":\"";
-  appendJsonEscaped(json, g_storedVar.carParam[currentCarIndex].carName);
-  json += "\",\"current\":{";
-
-  snprintf(buf, sizeof(buf),
-           "\"triggerPct\":%u,\"outputPct\":%u,\"brakePct\":%u,\"sensiHalfPct\":%u,"
-           "\"vinMv\":%u,\"currentMa\":%u,\"releaseMode\":%u,\"currentSense\":%u",
-           triggerPct,
-           outputPct,
-           brakePct,
-           g_escVar.effectiveSensi_raw,
-           g_escVar.Vin_mV,
-           g_escVar.motorCurrent_mA,
-           g_storedVar.carParam[currentCarIndex].quickBrakeEnabled,
-           HAL_HasMotorCurrentSense() ? 1U : 0U);
-  json += buf;
-
-  json += ",\"statusSlots\":[";
+    view->brakePct = (uint8_t)constrain((int)g_storedVar.activeCar.brakeButtonReduction, 0, 100);
+  }
+  view->releaseMode = (uint8_t)g_storedVar.activeCar.quickBrakeEnabled;
+  view->sensiHalfPct = g_escVar.effectiveSensi_raw;
+  view->vinMv = g_escVar.Vin_mV;
+  view->currentMa = g_escVar.motorCurrent_mA;
+  view->bemfMv = g_escVar.motorSpeedValid ? g_escVar.bemf_mV : 0;
+  view->speedHalfPct = g_escVar.motorSpeedValid ? (int16_t)g_escVar.motorSpeed_halfPct : -1;
+  view->tractionTrimPct = g_escVar.tractionTrim_pct;
+  thermalModelGetStatus(&view->thermal);
+  view->wifiActive = isWiFiPortalActive();
+}
+
+static void writeTelemetryStatusFields(JsonWriter_type* w, const TelemetryStatusView_type& view) {
+  const TelemetryStatus& status = view.status;
+  jsonWriterPrintf(w, ",\"loggingActive\":%u,\"hasData\":%u,\"wrapped\":%u,\"sampleRateMs\":%u,\"sampleIntervalUs\":%lu,"
+                      "\"psram\":%u,\"capacity\":%lu,\"storedCount\":%lu,\"eventCount\":%u,\"eventCapacity\":%u",
+                   status.loggingActive ? 1U : 0U,
+                   status.hasData ? 1U : 0U,
+                   status.wrapped ? 1U : 0U,
+                   status.sampleRateMs,
+                   (unsigned long)status.sampleIntervalUs,
+                   status.psram ? 1U : 0U,
+                   (unsigned long)status.capacity,
+                   (unsigned long)status.storedCount,
+                   status.eventCount,
+                   status.eventCapacity);
+  jsonWriterPrintf(w, ",\"sessionId\":%lu,\"sessionStartMs\":%lu,\"oldestSeq\":%lu,\"latestSeq\":%lu,"
+                      "\"oldestEventId\":%lu,\"latestEventId\":%lu,"
+                      "\"wifiActive\":%u,\"sessionStartCarIndex\":%u,\"currentCarIndex\":%u",
+                   (unsigned long)status.sessionId,
+                   (unsigned long)status.sessionStartMs,
+                   (unsigned long)status.oldestSeq,
+                   (unsigned long)status.latestSeq,
+                   (unsigned long)status.oldestEventId,
+                   (unsigned long)status.latestEventId,
+                   view.wifiActive ? 1U : 0U,
+                   view.sessionCarIndex,
+                   view.currentCarIndex);
+
+  char carName[CAR_NAME_MAX_SIZE + 1];
+  jsonWriterRaw(w, ",\"sessionStartCarName\":");
+  carProfileGetName(view.sessionCarIndex, carName, sizeof(carName));
+  jsonWriterString(w, carName);
+  jsonWriterRaw(w, ",\"currentCarName\":");
+  carProfileGetName(view.currentCarIndex, carName, sizeof(carName));
+  jsonWriterString(w, carName);
+
+  jsonWriterPrintf(w, ",\"current\":{\"triggerPct\":%u,\"outputPct\":%u,\"brakePct\":%u,\"sensiHalfPct\":%u,"
+                      "\"vinMv\":%u,\"currentMa\":%u,\"releaseMode\":%u,\"currentSense\":%u,"
+                      "\"bemfMv\":%u,\"speedHalfPct\":%d,\"tractionTrimPct\":%u,\"outputPermille\":%u,\"pwmResBits\":%u",
+                   view.triggerPct,
+                   view.outputPct,
+                   view.brakePct,
+                   view.sensiHalfPct,
+                   view.vinMv,
+                   view.currentMa,
+                   view.releaseMode,
+                   HAL_HasMotorCurrentSense() ? 1U : 0U,
+                   view.bemfMv,
+                   (int)view.speedHalfPct,
+                   view.tractionTrimPct,
+                   view.outputPermille,
+                   view.pwmResBits);
+  jsonWriterRaw(w, ",\"chipTempC\":");
+  if (view.thermal.chipTemp_C == THERMAL_TEMP_UNKNOWN) {
+    jsonWriterRaw(w, "null");
+  } else {
+    jsonWriterInt(w, view.thermal.chipTemp_C);
+  }
+  jsonWriterPrintf(w, ",\"thermalLoadPct\":%u,\"thermalLimitPct\":%u",
+                   view.thermal.load_pct,
+                   view.thermal.limit_pct);
+
+  jsonWriterRaw(w, ",\"statusSlots\":[");
   for (uint8_t i = 0; i < STATUS_SLOTS; i++) {
-    if (i > 0) json += ",";
-    json += String(normalizeStatusSlotForUi(g_storedVar.statusSlot[i]));
+    if (i > 0) jsonWriterChar(w, ',');
+    jsonWriterUInt(w, normalizeStatusSlotForUi(g_storedVar.statusSlot[i]));
   }
-  json += "]}";
+  jsonWriterRaw(w, "]}");
 }
 
-static String buildTelemetryStatusPayload(const char* message) {
+typedef struct {
+  const char* message;
+  TelemetryStatusView_type view;
+} TelemetryStatusReply_type;
+
+static void captureTelemetryStatusReply(const char* message, TelemetryStatusReply_type* reply) {
   TelemetryStatus status;
   telemetryGetStatus(&status);
+  reply->message = message;
+  captureTelemetryStatusView(status, &reply->view);
+}
+
+/* PortalJsonBody_fn; arg is a TelemetryStatusReply_type */
+static void writeTelemetryStatusPayload(JsonWriter_type* w, const void* arg) {
+  const TelemetryStatusReply_type* reply = (const TelemetryStatusReply_type*)arg;
+  jsonWriterRaw(w, "{\"ok\":true");
+  if (reply->message != nullptr && reply->message[0] != '\0') {
+    jsonWriterRaw(w, ",\"message\":");
+    jsonWriterString(w, reply->message);
+  }
+  writeTelemetryStatusFields(w, reply->view);
+  jsonWriterChar(w, '}');
+}
+
+static void sendTelemetryStatusReply(const char* message, bool toSerial) {
+  TelemetryStatusReply_type reply;
+  captureTelemetryStatusReply(message, &reply);
+  sendPortalJson(toSerial, writeTelemetryStatusPayload, &reply);
+}
+
+/* The range of one live reply, fixed at capture so the serial length and send passes agree */
+typedef struct {
+  TelemetryStatusView_type view;
+  uint32_t sessionId;
+  uint32_t afterSeq;
+  uint32_t untilSeq;
+  uint32_t afterEventId;
+  uint32_t untilEventId;
+  size_t limit;
+  bool eventsTruncated;
+} TelemetryLiveReply_type;
+
+typedef struct {
+  JsonWriter_type* w;
+  size_t written;
+} TelemetryJsonVisit_type;
+
+#define TELEMETRY_LIVE_SAMPLES_MAX  256U
+#define TELEMETRY_LIVE_EVENTS_MAX   128U    /* Newest events in a live reply; older ones set eventTruncated */
+#define TELEMETRY_LIVE_BATCH        32U     /* Samples copied out per cursor read, written to the sink after it */
+
+/* One cursor read's worth of samples: the read only copies, so telemetryClear() never waits on the sink */
+typedef struct {
+  TelemetrySample samples[TELEMETRY_LIVE_BATCH];
+  size_t count;
+} TelemetryLiveBatch_type;
 
-  String json;
-  json.reserve(768);
-  json += "{\"ok\":true";
-  if (message != nullptr && message[0] != '\0') {
-    json += ",\"message\":\"";
-    appendJsonEscaped(json, message);
-    json += "\"";
-  }
-  appendTelemetryStatusFields(json, status);
-  json += "}";
-  return json;
-}
-
-static String buildTelemetryLivePayload(uint32_t afterSeq, size_t limit) {
-  static TelemetrySample samples[256];
-  static TelemetryEvent events[TELEMETRY_EVENT_BUFFER_CAPACITY];
+/**
+ * @brief Fix the samples after afterSeq and the newest events for one live reply
+ * @details Nothing is copied here: the payload writer reads the ring through a cursor.
+ */
+static void captureTelemetryLiveReply(uint32_t afterSeq, size_t limit, TelemetryLiveReply_type* reply) {
   TelemetryStatus status;
-  bool truncated = false;
-  bool hasMore = false;
-  bool eventsTruncated = false;
-  size_t copied = telemetryCopySamplesAfter(afterSeq, samples, limit, &truncated, &hasMore, &status);
-  size_t eventCopied = telemetryCopyEvents(events, TELEMETRY_EVENT_BUFFER_CAPACITY, &eventsTruncated, nullptr);
+  telemetryGetStatus(&status);
+  captureTelemetryStatusView(status, &reply->view);
+  reply->sessionId = status.sessionId;
+  reply->afterSeq = afterSeq;
+  reply->untilSeq = status.latestSeq;
+  reply->limit = (limit < TELEMETRY_LIVE_SAMPLES_MAX) ? limit : TELEMETRY_LIVE_SAMPLES_MAX;
+  reply->untilEventId = status.latestEventId;
+  reply->afterEventId = (status.eventCount > TELEMETRY_LIVE_EVENTS_MAX) ? status.latestEventId - TELEMETRY_LIVE_EVENTS_MAX : 0U;
+  reply->eventsTruncated = status.eventCount > TELEMETRY_LIVE_EVENTS_MAX;
+}
+
+/* TelemetryEventVisit_fn; ctx is a TelemetryJsonVisit_type */
+static bool writeTelemetryEventVisit(void* ctx, const TelemetryEvent* event) {
+  TelemetryJsonVisit_type* visit = (TelemetryJsonVisit_type*)ctx;
+  if (visit->written++ > 0) {
+    jsonWriterChar(visit->w, ',');
+  }
+  writeTelemetryEventJson(visit->w, *event);
+  return true;
+}
 
-  String json;
-  json.reserve(1600 + (copied * 92U) + (eventCopied * 180U));
-  json += "{\"ok\":true";
-  appendTelemetryStatusFields(json, status);
-  json += ",\"truncated\":";
-  json += truncated ? "true" : "false";
-  json += ",\"hasMore\":";
-  json += hasMore ? "true" : "false";
-  json += ",\"returned\":";
-  json += String((unsigned long)copied);
-  json += ",\"eventTruncated\":";
-  json += eventsTruncated ? "true" : "false";
-  json += ",\"events\":[";
-  for (size_t i = 0; i < eventCopied; i++) {
-    if (i > 0) {
-      json += ",";
-    }
-    appendTelemetryEventJson(json, events[i]);
-  }
-  json += "],\"samples\":[";
+/* TelemetrySampleVisit_fn; ctx is a TelemetryLiveBatch_type, read with maxSamples <= TELEMETRY_LIVE_BATCH */
+static bool collectTelemetryLiveSample(void* ctx, const TelemetrySample* sample) {
+  TelemetryLiveBatch_type* batch = (TelemetryLiveBatch_type*)ctx;
+  batch->samples[batch->count++] = *sample;
+  return true;
+}
 
-  for (size_t i = 0; i < copied; i++) {
-    const TelemetrySample& s = samples[i];
-    if (i > 0) {
-      json += ",";
-    }
-    json += "[";
-    json += String((unsigned long)s.seq);
-    json += ",";
-    json += String((unsigned long)s.t_ms);
-    json += ",";
-    json += String((unsigned int)s.trigger_pct);
-    json += ",";
-    json += String((unsigned int)s.output_pct);
-    json += ",";
-    json += String((unsigned int)s.vin_mV);
-    json += ",";
-    json += String((unsigned int)s.current_mA);
-    json += ",";
-    json += String((unsigned int)s.brake_pct);
-    json += ",";
-    json += String((unsigned int)s.sensi_halfPct);
-    json += ",";
-    json += String((unsigned int)s.carIndex);
-    json += ",";
-    json += String((unsigned int)s.releaseMode);
-    json += ",";
-    json += String((unsigned int)s.flags);
-    json += "]";
+static void writeTelemetryLiveSample(TelemetryJsonVisit_type* visit, const TelemetrySample* sample) {
+  const TelemetrySample& s = *sample;
+  jsonWriterPrintf(visit->w, "%s[%lu,%lu,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u]",
+                   (visit->written++ > 0) ? "," : "",
+                   (unsigned long)s.seq,
+                   (unsigned long)s.t_ms,
+                   (unsigned int)s.trigger_pct,
+                   (unsigned int)s.output_pct,
+                   (unsigned int)s.vin_mV,
+                   (unsigned int)s.current_mA,
+                   (unsigned int)s.brake_pct,
+                   (unsigned int)s.sensi_halfPct,
+                   (unsigned int)s.carIndex,
+                   (unsigned int)s.releaseMode,
+                   (unsigned int)s.flags,
+                   (unsigned int)s.tFrac_us,
+                   (unsigned int)s.speed_halfPct);
+}
+
+/* PortalJsonBody_fn; arg is a TelemetryLiveReply_type. The flags follow the arrays they describe. */
+static void writeTelemetryLivePayload(JsonWriter_type* w, const void* arg) {
+  const TelemetryLiveReply_type* reply = (const TelemetryLiveReply_type*)arg;
+  TelemetryCursor_type cursor;
+  TelemetryJsonVisit_type visit = {w, 0};
+  telemetryCursorBegin(&cursor, reply->sessionId, reply->afterSeq, reply->afterEventId);
+  jsonWriterRaw(w, "{\"ok\":true");
+  writeTelemetryStatusFields(w, reply->view);
+  jsonWriterRaw(w, ",\"events\":[");
+  if (reply->untilEventId != 0) {
+    telemetryCursorReadEvents(&cursor, reply->untilEventId, TELEMETRY_LIVE_EVENTS_MAX, writeTelemetryEventVisit, &visit);
+  }
+  jsonWriterRaw(w, "],\"eventTruncated\":");
+  jsonWriterBool(w, reply->eventsTruncated);
+
+  jsonWriterRaw(w, ",\"samples\":[");
+  visit.written = 0;
+  bool truncated = false;
+  if (reply->untilSeq != 0) {
+    TelemetryLiveBatch_type batch;
+    do {
+      size_t want = reply->limit - visit.written;
+      batch.count = 0;
+      telemetryCursorRead(&cursor, reply->untilSeq, (want < TELEMETRY_LIVE_BATCH) ? want : TELEMETRY_LIVE_BATCH,
+                          collectTelemetryLiveSample, &batch, nullptr);
+      truncated = truncated || cursor.truncated;
+      for (size_t i = 0; i < batch.count; i++) {
+        writeTelemetryLiveSample(&visit, &batch.samples[i]);
+      }
+    } while (batch.count > 0 && cursor.hasMore && visit.written < reply->limit);
   }
+  jsonWriterRaw(w, "],\"truncated\":");
+  jsonWriterBool(w, truncated);
+  jsonWriterRaw(w, ",\"hasMore\":");
+  jsonWriterBool(w, cursor.hasMore);
+  jsonWriterRaw(w, ",\"returned\":");
+  jsonWriterUInt(w, (uint32_t)visit.written);
+  jsonWriterChar(w, '}');
+}
 
-  json += "]}";
-  return json;
+static void sendTelemetryLiveReply(uint32_t afterSeq, size_t limit, bool toSerial) {
+  TelemetryLiveReply_type reply;
+  captureTelemetryLiveReply(afterSeq, limit, &reply);
+  sendPortalJson(toSerial, writeTelemetryLivePayload, &reply);
 }
 
-static String buildTelemetryConfigSnapshotJson() {
+typedef struct {
   TelemetryConfigSnapshot snapshot;
+  uint8_t activeCarIndex;
+} TelemetryConfigReply_type;
+
+static void captureTelemetryConfigReply(TelemetryConfigReply_type* reply) {
   TelemetryStatus status;
-  bool hasSnapshot = telemetryGetConfigSnapshot(&snapshot);
+  bool hasSnapshot = telemetryGetConfigSnapshot(&reply->snapshot);
   telemetryGetStatus(&status);
   if (!hasSnapshot) {
-    snapshot.storedVar = g_storedVar;
-    snapshot.antiSpinStepMs = g_antiSpinStepMs;
-    snapshot.encoderInvertEnabled = g_encoderInvertEnabled;
-    snapshot.adcVoltageRange_mV = g_adcVoltageRange_mV;
+    reply->snapshot.storedVar = g_storedVar;
+    reply->snapshot.antiSpinStepMs = g_antiSpinStepMs;
+    reply->snapshot.encoderInvertEnabled = g_encoderInvertEnabled;
+    reply->snapshot.adcVoltageRange_mV = g_adcVoltageRange_mV;
   }
   uint8_t activeCarIndex = status.hasData ? status.sessionStartCarIndex : (uint8_t)g_carSel;
   if (activeCarIndex >= CAR_MAX_COUNT) {
     activeCarIndex = (uint8_t)g_storedVar.selectedCarNumber;
   }
-  return buildTelemetryConfigSummaryJsonFromSnapshot(snapshot, activeCarIndex);
+  reply->activeCarIndex = activeCarIndex;
+}
+
+/* PortalJsonBody_fn; arg is a TelemetryConfigReply_type */
+static void writeTelemetryConfigReply(JsonWriter_type* w, const void* arg) {
+  const TelemetryConfigReply_type* reply = (const TelemetryConfigReply_type*)arg;
+  writeTelemetryConfigSummaryJson(w, reply->snapshot, reply->activeCarIndex);
+}
+
+static void sendTelemetryConfigReply(bool toSerial) {
+  TelemetryConfigReply_type reply;
+  captureTelemetryConfigReply(&reply);
+  sendPortalJson(toSerial, writeTelemetryConfigReply, &reply);
 }
 
 static void sendSerialLengthPrefixedPayload(const String& payload) {
@@ -2816,230 +4294,793 @@ static void sendSerialLengthPrefixedPayload(const String& payload) {
   Serial.flush();
 }
 
+static void handleLivePushToken() {
+  char token[LIVE_PUSH_TOKEN_LEN + 1];
+  if (!livePushIssueToken(token, sizeof(token))) {
+    g_wifiServer->send(503, "application/json", "{\"ok\":false,\"error\":\"Live push unavailable\"}");
+    return;
+  }
+  char json[96];
+  snprintf(json, sizeof(json), "{\"ok\":true,\"token\":\"%s\",\"port\":%u}", token, (unsigned int)LIVE_PUSH_PORT);
+  g_wifiServer->send(200, "application/json", json);
+}
+
 static void handleTelemetryStatus() {
-  g_wifiServer->send(200, "application/json", buildTelemetryStatusPayload(""));
+  sendTelemetryStatusReply("", false);
 }
 
 static void handleTelemetryStart() {
+  uint32_t sampleInterval_us = getTelemetryArgU32("intervalUs", TELEMETRY_SAMPLE_INTERVAL_US_DEFAULT);
   if (!telemetryStartLogging(&g_storedVar,
                              g_antiSpinStepMs,
                              g_encoderInvertEnabled,
                              g_adcVoltageRange_mV,
-                             (uint8_t)g_carSel)) {
+                             (uint8_t)g_carSel,
+                             sampleInterval_us)) {
     g_wifiServer->send(500, "application/json", "{\"ok\":false,\"error\":\"Telemetry start failed\"}");
     return;
   }
 
-  g_wifiServer->send(200, "application/json", buildTelemetryStatusPayload("Telemetry logging started"));
+  sendTelemetryStatusReply("Telemetry logging started", false);
 }
 
 static void handleTelemetryStop() {
   telemetryStopLogging();
-  g_wifiServer->send(200, "application/json", buildTelemetryStatusPayload("Telemetry logging stopped"));
+  sendTelemetryStatusReply("Telemetry logging stopped", false);
 }
 
 static void handleTelemetryClear() {
   telemetryStopLogging();
   telemetryClear();
-  g_wifiServer->send(200, "application/json", buildTelemetryStatusPayload("Telemetry buffer cleared"));
+  sendTelemetryStatusReply("Telemetry buffer cleared", false);
 }
 
 static void handleTelemetryLive() {
   uint32_t afterSeq = getTelemetryArgU32("after", 0U);
   size_t limit = getTelemetryLiveLimit();
-  g_wifiServer->send(200, "application/json", buildTelemetryLivePayload(afterSeq, limit));
+  sendTelemetryLiveReply(afterSeq, limit, false);
+}
+
+static void handleTelemetryLiveBinary() {
+  uint32_t afterSeq = getTelemetryArgU32("after", 0U);
+  size_t limit = getTelemetryLiveLimit();
+  size_t frameLen = telemetryEncodeLiveFrame(afterSeq, limit, g_telemetryFrameBuf, sizeof(g_telemetryFrameBuf), nullptr);
+  g_wifiServer->setContentLength(frameLen);
+  g_wifiServer->send(200, "application/octet-stream", "");
+  g_wifiServer->sendContent((const char*)g_telemetryFrameBuf, frameLen);
+}
+
+#define TELEMETRY_EXPORT_CSV   0U
+#define TELEMETRY_EXPORT_JSON  1U
+
+/* State of one export running as a background portal transfer.
+ * Samples come from the flash session log while it has them (reader != nullptr), then from
+ * the RAM ring (ramTail) for whatever has not been written out yet. */
+typedef struct {
+  uint8_t format;            /* TELEMETRY_EXPORT_* */
+  uint8_t phase;             /* 0 = preamble, 1 = samples, 2 = tail, 3 = done */
+  bool firstSample;
+  bool ramTail;              /* Continue from the RAM ring after the log */
+  bool hasPending;           /* pending was read from the log but did not fit yet */
+  TelemetryCursor_type ramCursor;  /* Position in the RAM ring, bound to the session exported */
+  TelemetryLogReader_type* reader;
+  GzipStream_type* gzip;     /* Compressor state, nullptr for a plain export */
+  TelemetrySample pending;
+  String preamble;           /* CSV header line or JSON head incl. events */
+  size_t preambleOffset;
+  char carNames[CAR_MAX_COUNT][CAR_NAME_MAX_SIZE];
+} TelemetryExportJob_type;
+
+static void releaseTelemetryExportJob(void* ctx) {
+  TelemetryExportJob_type* job = (TelemetryExportJob_type*)ctx;
+  if (job->reader != nullptr) {
+    telemetryLogReaderClose(job->reader);
+    delete job->reader;
+  }
+  delete job->gzip;
+  delete job;
+}
+
+static int formatTelemetryExportRow(const TelemetryExportJob_type* job, const TelemetrySample& s, char* row, size_t rowSize) {
+  if (job->format == TELEMETRY_EXPORT_CSV) {
+    char sensiBuf[12];
+    char speedBuf[12];
+    formatHalfPercentValue(s.sensi_halfPct, sensiBuf, sizeof(sensiBuf));
+    if (s.speed_halfPct == TELEMETRY_SPEED_UNKNOWN) {
+      speedBuf[0] = '\0';
+    } else {
+      formatHalfPercentValue(s.speed_halfPct, speedBuf, sizeof(speedBuf));
+    }
+    return snprintf(row, rowSize,
+                    "%lu,%lu,%u,%s,%u,%u,%u,%s,%u,%u,%s,%u,%u,%u,%u,%u,%s\n",
+                    (unsigned long)s.seq,
+                    (unsigned long)s.t_ms,
+                    (unsigned int)s.carIndex,
+                    job->carNames[(s.carIndex < CAR_MAX_COUNT) ? s.carIndex : 0],
+                    (unsigned int)s.trigger_pct,
+                    (unsigned int)s.output_pct,
+                    (unsigned int)s.brake_pct,
+                    sensiBuf,
+                    (unsigned int)s.vin_mV,
+                    (unsigned int)s.current_mA,
+                    getTelemetryReleaseModeLabel(s.releaseMode),
+                    (s.flags & TELEMETRY_FLAG_BRAKE_BUTTON) ? 1U : 0U,
+                    (s.flags & TELEMETRY_FLAG_TRIGGER_RELEASING) ? 1U : 0U,
+                    (s.flags & TELEMETRY_FLAG_IN_RELEASE_ZONE) ? 1U : 0U,
+                    (s.flags & TELEMETRY_FLAG_RELEASE_ACTIVE) ? 1U : 0U,
+                    (s.flags & TELEMETRY_FLAG_CURRENT_SENSE) ? 1U : 0U,
+                    speedBuf);
+  }
+  return snprintf(row, rowSize,
+                  "%s{\"seq\":%lu,\"tMs\":%lu,\"tFracUs\":%u,\"triggerPct\":%u,\"outputPct\":%u,\"vinMv\":%u,"
+                  "\"currentMa\":%u,\"brakePct\":%u,\"sensiHalfPct\":%u,\"carIndex\":%u,\"releaseMode\":%u,\"flags\":%u,"
+                  "\"speedHalfPct\":%d}",
+                  job->firstSample ? "" : ",",
+                  (unsigned long)s.seq,
+                  (unsigned long)s.t_ms,
+                  (unsigned int)s.tFrac_us,
+                  (unsigned int)s.trigger_pct,
+                  (unsigned int)s.output_pct,
+                  (unsigned int)s.vin_mV,
+                  (unsigned int)s.current_mA,
+                  (unsigned int)s.brake_pct,
+                  (unsigned int)s.sensi_halfPct,
+                  (unsigned int)s.carIndex,
+                  (unsigned int)s.releaseMode,
+                  (unsigned int)s.flags,
+                  (s.speed_halfPct == TELEMETRY_SPEED_UNKNOWN) ? -1 : (int)s.speed_halfPct);
+}
+
+typedef struct {
+  TelemetryExportJob_type* job;
+  uint8_t* buf;
+  size_t cap;
+  size_t used;
+} TelemetryExportFill_type;
+
+/* TelemetrySampleVisit_fn; ctx is a TelemetryExportFill_type. Stops at the first row that does not fit. */
+static bool appendTelemetryExportRow(void* ctx, const TelemetrySample* sample) {
+  TelemetryExportFill_type* fill = (TelemetryExportFill_type*)ctx;
+  char row[320];
+  int rowLen = formatTelemetryExportRow(fill->job, *sample, row, sizeof(row));
+  if (rowLen <= 0 || (size_t)rowLen > fill->cap - fill->used) {
+    return false;
+  }
+  memcpy(fill->buf + fill->used, row, (size_t)rowLen);
+  fill->used += (size_t)rowLen;
+  fill->job->firstSample = false;
+  return true;
+}
+
+/**
+ * @brief Produce the next piece of an export body (PortalTransferFill_fn)
+ * @details Only whole rows are emitted; a row that does not fit is re-read next call.
+ */
+static size_t fillTelemetryExport(void* ctx, uint8_t* buf, size_t cap) {
+  TelemetryExportJob_type* job = (TelemetryExportJob_type*)ctx;
+  size_t used = 0;
+
+  if (job->phase == 0) {
+    size_t remaining = job->preamble.length() - job->preambleOffset;
+    size_t n = (remaining < cap) ? remaining : cap;
+    memcpy(buf, job->preamble.c_str() + job->preambleOffset, n);
+    job->preambleOffset += n;
+    if (job->preambleOffset >= job->preamble.length()) {
+      job->preamble = String();
+      job->phase = 1;
+    }
+    return n;
+  }
+
+  if (job->phase == 1 && job->reader != nullptr) {
+    char row[320];
+    while (job->hasPending || telemetryLogReaderNextSample(job->reader, &job->pending)) {
+      job->hasPending = true;
+      int rowLen = formatTelemetryExportRow(job, job->pending, row, sizeof(row));
+      if (rowLen <= 0 || (size_t)rowLen > cap - used) {
+        return used;
+      }
+      memcpy(buf + used, row, (size_t)rowLen);
+      used += (size_t)rowLen;
+      job->ramCursor.afterSeq = job->pending.seq;
+      job->firstSample = false;
+      job->hasPending = false;
+    }
+    telemetryLogReaderClose(job->reader);
+    delete job->reader;
+    job->reader = nullptr;
+    if (!job->ramTail) {
+      job->phase = 2;
+    }
+    if (used > 0) {
+      return used;
+    }
+  }
+
+  if (job->phase == 1) {
+    /* Rows are formatted straight from the ring; a new session ends the cursor's read */
+    TelemetryExportFill_type fill = {job, buf, cap, used};
+    telemetryCursorRead(&job->ramCursor, 0, SIZE_MAX, appendTelemetryExportRow, &fill, nullptr);
+    used = fill.used;
+    if (!job->ramCursor.hasMore) {
+      job->phase = 2;
+    }
+    if (used > 0) {
+      return used;
+    }
+  }
+
+  if (job->phase == 2) {
+    job->phase = 3;
+    if (job->format == TELEMETRY_EXPORT_JSON) {
+      memcpy(buf, "]}", 2);
+      return 2;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Compressed body filler wrapped around fillTelemetryExport() (PortalTransferFill_fn)
+ */
+static size_t fillTelemetryExportGzip(void* ctx, uint8_t* buf, size_t cap) {
+  TelemetryExportJob_type* job = (TelemetryExportJob_type*)ctx;
+  return gzipStreamPump(job->gzip, fillTelemetryExport, job, buf, cap);
+}
+
+/**
+ * @brief Build an export job: the current session (requestedSession 0) or a session from the flash log
+ * @details The current session streams from its flash log (if it has one) and then from the
+ *          RAM ring for the samples not written out yet; nothing is copied up front. With
+ *          gzip the body filler is fillTelemetryExportGzip() instead of fillTelemetryExport().
+ * @return nullptr with outHttpCode/outError set when there is nothing to export
+ */
+static TelemetryExportJob_type* createTelemetryExportJob(uint8_t format, uint32_t requestedSession, bool gzip,
+                                                         int* outHttpCode, const char** outError) {
+  TelemetryStatus status;
+  telemetryGetStatus(&status);
+  uint32_t liveSession = telemetryLogSessionForRam(status.sessionId);
+  uint32_t flashSession = (requestedSession != 0) ? requestedSession : liveSession;
+  bool ramTail = (requestedSession == 0) || (requestedSession == liveSession);
+
+  static TelemetryLogHeader_type logHeader;
+  TelemetryLogReader_type* reader = nullptr;
+  if (flashSession != 0) {
+    reader = new TelemetryLogReader_type();
+    if (reader != nullptr && !telemetryLogReaderOpen(reader, flashSession, &logHeader)) {
+      delete reader;
+      reader = nullptr;
+    }
+    if (reader == nullptr && requestedSession != 0) {
+      *outHttpCode = 404;
+      *outError = "Telemetry session not found";
+      return nullptr;
+    }
+  }
+  if (reader == nullptr && !status.hasData) {
+    *outHttpCode = 404;
+    *outError = "No telemetry data available";
+    return nullptr;
+  }
+
+  static TelemetryConfigSnapshot snapshot;
+  uint8_t sessionStartCarIndex = status.sessionStartCarIndex;
+  uint32_t sampleIntervalUs = status.sampleIntervalUs;
+  uint32_t storedCount = status.storedCount;
+  uint32_t capacity = status.capacity;
+  uint32_t sessionId = status.sessionId;
+  if (reader != nullptr) {
+    snapshot = logHeader.config;
+    sessionStartCarIndex = logHeader.sessionStartCarIndex;
+    sampleIntervalUs = logHeader.sampleIntervalUs;
+    sessionId = logHeader.sessionId;
+    uint32_t lastLoggedSeq = 0;
+    storedCount = telemetryLogReaderCountSamples(reader, &lastLoggedSeq);
+    if (ramTail && status.latestSeq > lastLoggedSeq) {
+      uint32_t firstTailSeq = (status.oldestSeq > lastLoggedSeq) ? status.oldestSeq : lastLoggedSeq + 1U;
+      storedCount += status.latestSeq - firstTailSeq + 1U;
+    }
+    capacity = storedCount;
+  } else if (!telemetryGetConfigSnapshot(&snapshot)) {
+    snapshot.storedVar = g_storedVar;
+    snapshot.antiSpinStepMs = g_antiSpinStepMs;
+    snapshot.encoderInvertEnabled = g_encoderInvertEnabled;
+    snapshot.adcVoltageRange_mV = g_adcVoltageRange_mV;
+  }
+
+  TelemetryExportJob_type* job = new TelemetryExportJob_type();
+  GzipStream_type* gzipState = gzip ? new GzipStream_type() : nullptr;
+  if (job == nullptr || (gzip && gzipState == nullptr)) {
+    if (reader != nullptr) {
+      telemetryLogReaderClose(reader);
+      delete reader;
+    }
+    delete job;
+    delete gzipState;
+    *outHttpCode = 500;
+    *outError = "Out of memory";
+    return nullptr;
+  }
+  if (gzipState != nullptr) {
+    gzipStreamBegin(gzipState);
+  }
+  job->gzip = gzipState;
+  job->format = format;
+  job->phase = 0;
+  job->firstSample = true;
+  job->ramTail = ramTail;
+  job->hasPending = false;
+  telemetryCursorBegin(&job->ramCursor, status.sessionId, 0, 0);
+  job->reader = reader;
+  job->preambleOffset = 0;
+  for (uint8_t i = 0; i < CAR_MAX_COUNT; i++) {
+    carProfileGetName(i, job->carNames[i], sizeof(job->carNames[i]));
+  }
+
+  if (format == TELEMETRY_EXPORT_CSV) {
+    job->preamble = "seq,t_ms,car_index,car_name,trigger_pct,output_pct,brake_pct,sensi_pct,vin_mV,current_mA,release_mode,brake_button,trigger_releasing,in_release_zone,release_active,current_sense,speed_pct\n";
+  } else {
+    char versionBuf[8];
+    snprintf(versionBuf, sizeof(versionBuf), "%d.%d", SW_MAJOR_VERSION, SW_MINOR_VERSION);
+
+    bool eventsTruncated = false;
+    uint32_t lastEventId = 0;
+    bool ramEvents = (reader == nullptr) || ramTail;
+    if (reader == nullptr) {
+      lastEventId = (status.oldestEventId > 0U) ? (status.oldestEventId - 1U) : 0U;
+    }
+
+    /* The export job streams the preamble from its own String, so render straight into it */
+    JsonWriter_type w;
+    job->preamble.reserve(1800 + ((reader == nullptr) ? (size_t)status.eventCount * 180U : 0U));
+    jsonWriterBegin(&w, stringJsonSink, &job->preamble);
+    jsonWriterRaw(&w, "{\"ok\":true,\"format\":\"espeed32-telemetry-v1\",\"deviceId\":");
+    jsonWriterString(&w, g_wifiSuffix);
+    jsonWriterRaw(&w, ",\"firmware\":");
+    jsonWriterString(&w, versionBuf);
+    jsonWriterRaw(&w, ",\"source\":");
+    jsonWriterString(&w, (reader != nullptr) ? "flash" : "ram");
+    jsonWriterRaw(&w, ",\"loggingActive\":");
+    jsonWriterBool(&w, status.loggingActive && ramTail);
+    jsonWriterPrintf(&w, ",\"sampleRateMs\":%u,\"sampleIntervalUs\":%lu,\"capacity\":%lu,\"storedCount\":%lu,"
+                         "\"sessionId\":%lu,\"sessionStartMs\":%lu,\"sessionStartCarIndex\":%u,\"configAtStart\":",
+                     (unsigned int)((sampleIntervalUs + 999UL) / 1000UL),
+                     (unsigned long)sampleIntervalUs,
+                     (unsigned long)capacity,
+                     (unsigned long)storedCount,
+                     (unsigned long)sessionId,
+                     (unsigned long)((reader != nullptr && !ramTail) ? 0 : status.sessionStartMs),
+                     (unsigned int)sessionStartCarIndex);
+    writeTelemetryConfigSummaryJson(&w, snapshot, sessionStartCarIndex);
+    jsonWriterRaw(&w, ",\"events\":[");
+    size_t written = 0;
+    if (reader != nullptr) {
+      TelemetryEvent event;
+      while (telemetryLogReaderNextEvent(reader, &event)) {
+        if (written++ > 0) {
+          jsonWriterChar(&w, ',');
+        }
+        writeTelemetryEventJson(&w, event);
+        lastEventId = event.id;
+      }
+      telemetryLogReaderRewind(reader);
+    }
+    if (ramEvents) {
+      /* The ring expands records one at a time as the cursor visits them */
+      TelemetryJsonVisit_type visit = {&w, written};
+      job->ramCursor.afterEventId = lastEventId;
+      telemetryCursorReadEvents(&job->ramCursor, 0, SIZE_MAX, writeTelemetryEventVisit, &visit);
+      eventsTruncated = eventsTruncated || job->ramCursor.truncated;
+    }
+    jsonWriterRaw(&w, "],\"eventsTruncated\":");
+    jsonWriterBool(&w, eventsTruncated);
+    jsonWriterRaw(&w, ",\"samples\":[");
+    jsonWriterEnd(&w);
+  }
+  return job;
+}
+
+/**
+ * @brief Start an export over HTTP: ?session=N picks a logged session
+ * @details Compressed on the fly (Content-Encoding: gzip) when the client accepts gzip,
+ *          which every browser does; the download keeps its .csv/.json name.
+ */
+static void startTelemetryExport(uint8_t format) {
+  if (!portalTransferHasFreeSlot()) {
+    g_wifiServer->send(503, "application/json", "{\"ok\":false,\"error\":\"Portal busy, retry shortly\"}");
+    return;
+  }
+  bool gzip = (g_wifiServer->header("Accept-Encoding").indexOf("gzip") >= 0);
+  int httpCode = 500;
+  const char* error = "Export failed";
+  TelemetryExportJob_type* job = createTelemetryExportJob(format, getTelemetryArgU32("session", 0U), gzip, &httpCode, &error);
+  if (job == nullptr) {
+    String body = String("{\"ok\":false,\"error\":\"") + error + "\"}";
+    g_wifiServer->send(httpCode, "application/json", body);
+    return;
+  }
+
+  const char* contentType = (format == TELEMETRY_EXPORT_CSV) ? "text/csv; charset=utf-8" : "application/json; charset=utf-8";
+  String headers = (format == TELEMETRY_EXPORT_CSV)
+                     ? "Content-Disposition: attachment; filename=\"espeed32-telemetry.csv\"\r\n"
+                     : "Content-Disposition: attachment; filename=\"espeed32-telemetry.json\"\r\n";
+  headers += "Vary: Accept-Encoding\r\n";
+  if (gzip) {
+    headers += "Content-Encoding: gzip\r\n";
+  }
+  portalTransferStartChunked(g_wifiServer->client(), contentType, headers.c_str(),
+                             gzip ? fillTelemetryExportGzip : fillTelemetryExport, job, releaseTelemetryExportJob);
+}
+
+/**
+ * @brief Serial "TEXPORT CSV|JSON [GZ] [session]"
+ * @details Streams the same body as the HTTP export in "<len>\n<bytes>" chunks, "0\n" at the
+ *          end; with GZ the chunks carry a gzip stream instead of plain text.
+ */
+static void handleSerialExportCommand(const String& cmd) {
+  String args = cmd.substring(7);
+  args.trim();
+  uint8_t format;
+  if (args.startsWith("CSV")) {
+    format = TELEMETRY_EXPORT_CSV;
+  } else if (args.startsWith("JSON")) {
+    format = TELEMETRY_EXPORT_JSON;
+  } else {
+    Serial.println("ERR:format must be CSV or JSON");
+    return;
+  }
+  args = args.substring((format == TELEMETRY_EXPORT_CSV) ? 3 : 4);
+  args.trim();
+  bool gzip = args.startsWith("GZ");
+  if (gzip) {
+    args = args.substring(2);
+    args.trim();
+  }
+  uint32_t requestedSession = (args.length() > 0) ? (uint32_t)args.toInt() : 0U;
+
+  int httpCode = 500;
+  const char* error = "Export failed";
+  TelemetryExportJob_type* job = createTelemetryExportJob(format, requestedSession, gzip, &httpCode, &error);
+  if (job == nullptr) {
+    Serial.print("ERR:");
+    Serial.println(error);
+    return;
+  }
+  Serial.println(gzip ? "OK TEXPORT GZ" : "OK TEXPORT");
+  static uint8_t chunk[PORTAL_TRANSFER_CHUNK_SIZE];
+  size_t n;
+  while ((n = gzip ? fillTelemetryExportGzip(job, chunk, sizeof(chunk)) : fillTelemetryExport(job, chunk, sizeof(chunk))) > 0) {
+    Serial.print((unsigned long)n);
+    Serial.print('\n');
+    Serial.write(chunk, n);
+  }
+  Serial.print("0\n");
+  releaseTelemetryExportJob(job);
+}
+
+typedef struct {
+  TelemetryLogStatus_type status;
+  TelemetryLogSessionInfo_type sessions[TELEMETRY_LOG_MAX_SESSIONS];
+  uint8_t sessionCount;
+} TelemetrySessionsReply_type;
+
+/* PortalJsonBody_fn; arg is a TelemetrySessionsReply_type */
+static void writeTelemetrySessionsJson(JsonWriter_type* w, const void* arg) {
+  const TelemetrySessionsReply_type* reply = (const TelemetrySessionsReply_type*)arg;
+  const TelemetryLogStatus_type* s = &reply->status;
+  jsonWriterPrintf(w, "{\"ok\":true,\"recording\":%u,\"logOk\":%u,\"sessionId\":%lu,\"loggedSamples\":%lu,"
+                      "\"droppedSamples\":%lu,\"loggedEvents\":%lu,\"lastLoggedSeq\":%lu,\"sessions\":[",
+                   s->recording ? 1U : 0U,
+                   s->logAvailable ? 1U : 0U,
+                   (unsigned long)s->sessionId,
+                   (unsigned long)s->loggedSamples,
+                   (unsigned long)s->droppedSamples,
+                   (unsigned long)s->loggedEvents,
+                   (unsigned long)s->lastLoggedSeq);
+  for (uint8_t i = 0; i < reply->sessionCount; i++) {
+    if (i > 0) jsonWriterChar(w, ',');
+    jsonWriterPrintf(w, "{\"id\":%lu,\"bytes\":%lu,\"sampleIntervalUs\":%lu,\"startCarIndex\":%u}",
+                     (unsigned long)reply->sessions[i].sessionId, (unsigned long)reply->sessions[i].bytes,
+                     (unsigned long)reply->sessions[i].sampleIntervalUs, reply->sessions[i].sessionStartCarIndex);
+  }
+  jsonWriterRaw(w, "]}");
+}
+
+/**
+ * @brief GET /api/telemetry/sessions: recorder state and the sessions in the flash log
+ */
+static void handleTelemetrySessions() {
+  TelemetrySessionsReply_type reply;
+  telemetryLogGetStatus(&reply.status);
+  reply.sessionCount = telemetryLogListSessions(reply.sessions, TELEMETRY_LOG_MAX_SESSIONS);
+  sendHttpJson(200, writeTelemetrySessionsJson, &reply);
+}
+
+static const char* const TELEMETRY_QUERY_CHANNEL_KEYS[TELEMETRY_CH_COUNT] = {
+  "triggerPct", "outputPct", "brakePct", "vinMv", "currentMa"
+};
+
+typedef struct {
+  TelemetryQueryPlan_type plan;
+  JsonWriter_type* w;
+  uint32_t written;
+} TelemetryQueryReply_type;
+
+/* TelemetryQueryPoint_fn; ctx is a TelemetryQueryReply_type */
+static void writeTelemetryQueryPoint(void* ctx, const TelemetryQueryPoint_type* p) {
+  TelemetryQueryReply_type* reply = (TelemetryQueryReply_type*)ctx;
+  JsonWriter_type* w = reply->w;
+  if (reply->written++ > 0) jsonWriterChar(w, ',');
+  jsonWriterPrintf(w, "{\"seq\":%lu,\"tMs\":%lu,\"n\":%lu",
+                   (unsigned long)p->firstSeq, (unsigned long)p->t_ms, (unsigned long)p->count);
+  for (uint8_t ch = 0; ch < TELEMETRY_CH_COUNT; ch++) {
+    jsonWriterPrintf(w, ",\"%s\":[%u,%u,%u]", TELEMETRY_QUERY_CHANNEL_KEYS[ch], p->min[ch], p->avg[ch], p->max[ch]);
+  }
+  jsonWriterChar(w, '}');
+}
+
+/* PortalJsonBody_fn; arg is a TelemetryQueryReply_type */
+static void writeTelemetryQueryJson(JsonWriter_type* w, const void* arg) {
+  TelemetryQueryReply_type* reply = (TelemetryQueryReply_type*)arg;
+  const TelemetryQueryPlan_type* plan = &reply->plan;
+  jsonWriterPrintf(w, "{\"ok\":true,\"sessionId\":%lu,\"from\":%lu,\"to\":%lu,\"level\":%u,\"stride\":%lu,"
+                      "\"fields\":\"[min,avg,max]\",\"points\":[",
+                   (unsigned long)plan->sessionId, (unsigned long)plan->fromSeq, (unsigned long)plan->toSeq,
+                   plan->levelFactor, (unsigned long)plan->stride);
+  reply->w = w;
+  reply->written = 0;
+  telemetryPyramidRun(plan, writeTelemetryQueryPoint, reply);
+  jsonWriterRaw(w, "]}");
 }
 
-static void handleTelemetryExportCsv() {
-  TelemetryStatus status;
-  telemetryGetStatus(&status);
-  if (!status.hasData) {
+/**
+ * @brief GET /api/telemetry/query?from=SEQ&to=SEQ&points=N: min/avg/max per point from the decimation pyramid
+ */
+static void handleTelemetryQuery() {
+  TelemetryQueryReply_type reply;
+  if (!telemetryPyramidPlan(getTelemetryArgU32("from", 0U), getTelemetryArgU32("to", 0U),
+                            getTelemetryArgU32("points", TELEMETRY_QUERY_POINTS_DEFAULT), &reply.plan)) {
     g_wifiServer->send(404, "application/json", "{\"ok\":false,\"error\":\"No telemetry data available\"}");
     return;
   }
-
-  TelemetryConfigSnapshot snapshot;
-  bool hasSnapshot = telemetryGetConfigSnapshot(&snapshot);
-  if (!hasSnapshot) {
-    snapshot.storedVar = g_storedVar;
-    snapshot.antiSpinStepMs = g_antiSpinStepMs;
-    snapshot.encoderInvertEnabled = g_encoderInvertEnabled;
-    snapshot.adcVoltageRange_mV = g_adcVoltageRange_mV;
+  sendHttpJson(200, writeTelemetryQueryJson, &reply);
+}
+
+/* POST /api/replay state; heap allocated, the replay alone is ~5 KB */
+typedef struct {
+  TriggerReplay_type replay;
+  bool fromTelemetry;
+  bool truncated;          /* Trace longer than TRIGGER_REPLAY_MAX_SAMPLES */
+} ReplayReply_type;
+
+static void writeReplayPointsJson(JsonWriter_type* w, const char* key, const uint16_t* points, uint16_t count) {
+  jsonWriterPrintf(w, ",\"%s\":[", key);
+  for (uint16_t i = 0; i < count; i++) {
+    if (i > 0) jsonWriterChar(w, ',');
+    jsonWriterUInt(w, points[i]);
+  }
+  jsonWriterChar(w, ']');
+}
+
+/* PortalJsonBody_fn; arg is a ReplayReply_type */
+static void writeReplayJson(JsonWriter_type* w, const void* arg) {
+  const ReplayReply_type* reply = (const ReplayReply_type*)arg;
+  const TriggerReplay_type* r = &reply->replay;
+  jsonWriterPrintf(w, "{\"ok\":true,\"source\":\"%s\",\"samples\":%lu,\"truncated\":%s,\"durationMs\":%lu,\"bucketSamples\":%lu,\"points\":%u",
+                   reply->fromTelemetry ? "telemetry" : "upload",
+                   (unsigned long)r->samples,
+                   reply->truncated ? "true" : "false",
+                   (unsigned long)(r->now_us / 1000U),
+                   (unsigned long)r->bucketSamples,
+                   (unsigned int)r->pointCount);
+  uint16_t triggerPermille[TRIGGER_REPLAY_MAX_POINTS];
+  for (uint16_t i = 0; i < r->pointCount; i++) {
+    triggerPermille[i] = (uint16_t)(((uint32_t)r->trigger_norm[i] * 1000U) / THROTTLE_NORMALIZED);
+  }
+  writeReplayPointsJson(w, "triggerPermille", triggerPermille, r->pointCount);
+  jsonWriterRaw(w, ",\"candidates\":[");
+  for (uint8_t i = 0; i < r->candidateCount; i++) {
+    const TriggerReplayCandidate_type* c = &r->candidates[i];
+    uint32_t samples = max(r->samples, (uint32_t)1U);
+    if (i > 0) jsonWriterChar(w, ',');
+    jsonWriterRaw(w, "{\"car\":");
+    writeTelemetryCarParamJson(w, c->car);
+    jsonWriterPrintf(w, ",\"meanOutputPermille\":%lu,\"peakOutputPermille\":%u,\"meanBrakePermille\":%lu,"
+                        "\"antiSpinLimitedMs\":%lu,\"releaseActiveMs\":%lu,\"brakeMs\":%lu",
+                     (unsigned long)(c->outputSum_permille / samples),
+                     (unsigned int)c->peakOutput_permille,
+                     (unsigned long)(c->brakeSum_permille / samples),
+                     (unsigned long)(c->antiSpinLimited_us / 1000U),
+                     (unsigned long)(c->releaseActive_us / 1000U),
+                     (unsigned long)(c->brake_us / 1000U));
+    writeReplayPointsJson(w, "outputPermille", c->output_permille, r->pointCount);
+    writeReplayPointsJson(w, "brakePermille", c->brake_permille, r->pointCount);
+    jsonWriterChar(w, '}');
+  }
+  jsonWriterRaw(w, "]}");
+}
+
+/* Baseline profile plus the "candidates" patches over it */
+static bool parseReplayCandidates(const JsonScanObject_type& doc, CarParam_type* cars, uint8_t* outCount, String* errorMsg) {
+  int32_t v = 0;
+  uint8_t carIndex = g_storedVar.selectedCarNumber;
+  if (parseJsonInt(doc, "carIndex", v)) {
+    if (!inRange(v, 0, CAR_MAX_COUNT - 1)) { *errorMsg = "Error: invalid carIndex"; return false; }
+    carIndex = (uint8_t)v;
   }
+  carProfileRead(carIndex, &cars[0]);
+  uint8_t count = 1;
+
+  const JsonScanMember_type* list = jsonScanFind(&doc, "candidates");
+  if (list != nullptr) {
+    if (list->type != JSON_SCAN_ARRAY) { *errorMsg = "Error: candidates must be an array"; return false; }
+    size_t cursor = 0;
+    JsonScanMember_type entry;
+    while (jsonScanArrayNext(list, &cursor, &entry)) {
+      if (count >= TRIGGER_REPLAY_MAX_CANDIDATES) {
+        *errorMsg = "Error: at most " + String(TRIGGER_REPLAY_MAX_CANDIDATES - 1) + " candidates"; return false;
+      }
+      JsonScanObject_type patch;
+      if (entry.type != JSON_SCAN_OBJECT || !jsonScanObject(entry.value, entry.valueLen, &patch)) {
+        *errorMsg = "Error: malformed candidate " + String(count); return false;
+      }
+      cars[count] = cars[0];
+      if (!applyCarPatch(patch, cars[count], errorMsg)) {
+        *errorMsg += " in candidate " + String(count); return false;
+      }
+      count++;
+    }
+  }
+  *outCount = count;
+  return true;
+}
 
-  g_wifiServer->setContentLength(CONTENT_LENGTH_UNKNOWN);
-  g_wifiServer->sendHeader("Content-Disposition", "attachment; filename=\"espeed32-telemetry.csv\"");
-  g_wifiServer->send(200, "text/csv; charset=utf-8", "");
-
-  g_wifiServer->sendContent("seq,t_ms,car_index,car_name,trigger_pct,output_pct,brake_pct,sensi_pct,vin_mV,current_mA,release_mode,brake_button,trigger_releasing,in_release_zone,release_active,current_sense\n");
+/* Uploaded trace: "trigger" [%] per sample, optional parallel "button" (0/1), "dtUs" sample spacing */
+static bool runReplayUpload(const JsonScanObject_type& doc, const JsonScanMember_type* trigger,
+                            const CarParam_type* cars, uint8_t carCount, ReplayReply_type* reply, String* errorMsg) {
+  int32_t dt_us = ESC_PERIOD_US;
+  if (parseJsonInt(doc, "dtUs", dt_us) && !inRange(dt_us, 50, 1000000)) {
+    *errorMsg = "Error: invalid dtUs"; return false;
+  }
+  const JsonScanMember_type* button = jsonScanFind(&doc, "button");
+  if (trigger->type != JSON_SCAN_ARRAY || (button != nullptr && button->type != JSON_SCAN_ARRAY)) {
+    *errorMsg = "Error: trigger and button must be arrays"; return false;
+  }
 
-  static TelemetrySample batch[96];
-  uint32_t afterSeq = 0;
+  size_t cursor = 0;
+  uint32_t count = 0;
+  JsonScanMember_type elem;
+  while (jsonScanArrayNext(trigger, &cursor, &elem)) {
+    count++;
+  }
+  triggerReplayBegin(&reply->replay, cars, carCount, min(count, (uint32_t)TRIGGER_REPLAY_MAX_SAMPLES), true);
 
-  while (true) {
-    TelemetryStatus batchStatus;
-    bool truncated = false;
-    bool hasMore = false;
-    size_t copied = telemetryCopySamplesAfter(afterSeq, batch, 96U, &truncated, &hasMore, &batchStatus);
-    if (copied == 0) {
-      break;
+  cursor = 0;
+  size_t buttonCursor = 0;
+  uint32_t dt = 0;   /* The first sample starts the clock */
+  while (jsonScanArrayNext(trigger, &cursor, &elem)) {
+    int32_t pct = 0;
+    if (!jsonScanMemberInt(&elem, &pct) || !inRange(pct, 0, 100)) {
+      *errorMsg = "Error: invalid trigger sample " + String(reply->replay.samples); return false;
     }
-
-    String chunk;
-    chunk.reserve(copied * 96U);
-    for (size_t i = 0; i < copied; i++) {
-      const TelemetrySample& s = batch[i];
-      char sensiBuf[12];
-      char row[192];
-      formatHalfPercentValue(s.sensi_halfPct, sensiBuf, sizeof(sensiBuf));
-      snprintf(row, sizeof(row),
-               "%lu,%lu,%u,%s,%u,%u,%u,%s,%u,%u,%s,%u,%u,%u,%u,%u\n",
-               (unsigned long)s.seq,
-               (unsigned long)s.t_ms,
-               (unsigned int)s.carIndex,
-               snapshot.storedVar.carParam[s.carIndex].carName,
-               (unsigned int)s.trigger_pct,
-               (unsigned int)s.output_pct,
-               (unsigned int)s.brake_pct,
-               sensiBuf,
-               (unsigned int)s.vin_mV,
-               (unsigned int)s.current_mA,
-               getTelemetryReleaseModeLabel(s.releaseMode),
-               (s.flags & TELEMETRY_FLAG_BRAKE_BUTTON) ? 1U : 0U,
-               (s.flags & TELEMETRY_FLAG_TRIGGER_RELEASING) ? 1U : 0U,
-               (s.flags & TELEMETRY_FLAG_IN_RELEASE_ZONE) ? 1U : 0U,
-               (s.flags & TELEMETRY_FLAG_RELEASE_ACTIVE) ? 1U : 0U,
-               (s.flags & TELEMETRY_FLAG_CURRENT_SENSE) ? 1U : 0U);
-      chunk += row;
-      afterSeq = s.seq;
-    }
-
-    g_wifiServer->sendContent(chunk);
-    if (!hasMore) {
+    JsonScanMember_type pressed;
+    int32_t pressedVal = 0;
+    if (button != nullptr && jsonScanArrayNext(button, &buttonCursor, &pressed)) {
+      jsonScanMemberInt(&pressed, &pressedVal);
+    }
+    if (!triggerReplayFeed(&reply->replay, dt, (uint16_t)((pct * THROTTLE_NORMALIZED) / 100), pressedVal != 0)) {
+      reply->truncated = true;
       break;
     }
+    dt = (uint32_t)dt_us;
   }
+  return true;
+}
 
-  g_wifiServer->sendContent("");
+typedef struct {
+  ReplayReply_type* reply;
+  uint64_t prevT_us;
+  bool first;
+  bool full;
+} ReplayTelemetryFeed_type;
+
+/* TelemetrySampleVisit_fn; ctx is a ReplayTelemetryFeed_type */
+static bool feedReplayTelemetrySample(void* ctx, const TelemetrySample* sample) {
+  ReplayTelemetryFeed_type* feed = (ReplayTelemetryFeed_type*)ctx;
+  uint64_t t_us = (uint64_t)sample->t_ms * 1000U + sample->tFrac_us;
+  uint32_t dt = feed->first ? 0U : (uint32_t)(t_us - feed->prevT_us);
+  feed->first = false;
+  feed->prevT_us = t_us;
+  uint16_t triggerNorm = (uint16_t)(((uint32_t)sample->trigger_pct * THROTTLE_NORMALIZED) / 100U);
+  if (!triggerReplayFeed(&feed->reply->replay, dt, triggerNorm, (sample->flags & TELEMETRY_FLAG_BRAKE_BUTTON) != 0)) {
+    feed->full = true;
+    return false;
+  }
+  return true;
 }
 
-static void handleTelemetryExportJson() {
+/* Recorded trace: the telemetry ring after afterSeq, up to limit samples */
+static bool runReplayTelemetry(const CarParam_type* cars, uint8_t carCount, uint32_t afterSeq, uint32_t limit,
+                               ReplayReply_type* reply, String* errorMsg) {
   TelemetryStatus status;
   telemetryGetStatus(&status);
   if (!status.hasData) {
-    g_wifiServer->send(404, "application/json", "{\"ok\":false,\"error\":\"No telemetry data available\"}");
-    return;
-  }
-
-  TelemetryConfigSnapshot snapshot;
-  bool hasSnapshot = telemetryGetConfigSnapshot(&snapshot);
-  if (!hasSnapshot) {
-    snapshot.storedVar = g_storedVar;
-    snapshot.antiSpinStepMs = g_antiSpinStepMs;
-    snapshot.encoderInvertEnabled = g_encoderInvertEnabled;
-    snapshot.adcVoltageRange_mV = g_adcVoltageRange_mV;
+    *errorMsg = "Error: no telemetry data available"; return false;
   }
+  uint32_t firstSeq = max(afterSeq + 1U, status.oldestSeq);
+  uint32_t expected = (status.latestSeq >= firstSeq) ? (status.latestSeq - firstSeq + 1U) : 0U;
+  triggerReplayBegin(&reply->replay, cars, carCount, min(expected, limit), false);
 
-  char versionBuf[8];
-  snprintf(versionBuf, sizeof(versionBuf), "%d.%d", SW_MAJOR_VERSION, SW_MINOR_VERSION);
+  TelemetryCursor_type cursor;
+  ReplayTelemetryFeed_type feed = {reply, 0, true, false};
+  telemetryCursorBegin(&cursor, status.sessionId, afterSeq, 0);
+  telemetryCursorRead(&cursor, status.latestSeq, limit, feedReplayTelemetrySample, &feed, nullptr);
+  reply->truncated = feed.full || expected > limit;
+  return true;
+}
 
-  g_wifiServer->setContentLength(CONTENT_LENGTH_UNKNOWN);
-  g_wifiServer->sendHeader("Content-Disposition", "attachment; filename=\"espeed32-telemetry.json\"");
-  g_wifiServer->send(200, "application/json; charset=utf-8", "");
-
-  static TelemetryEvent events[TELEMETRY_EVENT_BUFFER_CAPACITY];
-  bool eventsTruncated = false;
-  size_t eventCount = telemetryCopyEvents(events, TELEMETRY_EVENT_BUFFER_CAPACITY, &eventsTruncated, nullptr);
-
-  String head;
-  head.reserve(1800 + (eventCount * 180U));
-  head += "{";
-  head += "\"ok\":true,\"format\":\"espeed32-telemetry-v1\",\"deviceId\":\"";
-  appendJsonEscaped(head, g_wifiSuffix);
-  head += "\",\"firmware\":\"";
-  appendJsonEscaped(head, versionBuf);
-  head += "\",\"loggingActive\":";
-  head += status.loggingActive ? "true" : "false";
-  head += ",\"sampleRateMs\":";
-  head += String(status.sampleRateMs);
-  head += ",\"capacity\":";
-  head += String(status.capacity);
-  head += ",\"storedCount\":";
-  head += String(status.storedCount);
-  head += ",\"sessionId\":";
-  head += String((unsigned long)status.sessionId);
-  head += ",\"sessionStartMs\":";
-  head += String((unsigned long)status.sessionStartMs);
-  head += ",\"sessionStartCarIndex\":";
-  head += String(status.sessionStartCarIndex);
-  head += ",\"configAtStart\":";
-  head += buildTelemetryConfigSummaryJsonFromSnapshot(snapshot, status.sessionStartCarIndex);
-  head += ",\"eventsTruncated\":";
-  head += eventsTruncated ? "true" : "false";
-  head += ",\"events\":[";
-  for (size_t i = 0; i < eventCount; i++) {
-    if (i > 0) {
-      head += ",";
-    }
-    appendTelemetryEventJson(head, events[i]);
+/**
+ * @brief POST /api/replay: replay a trigger trace against the selected car and up to
+ *        TRIGGER_REPLAY_MAX_CANDIDATES - 1 patched variants of it
+ * @details Body: {"carIndex":N, "candidates":[{<apply fields>},...], and either
+ *          "trigger":[pct,...], "button":[0|1,...], "dtUs":N for an uploaded trace, or
+ *          "afterSeq":N, "limit":N to replay the telemetry ring. The motor is never driven.
+ */
+static void handleReplay() {
+  String payload = g_wifiServer->arg("plain");
+  JsonScanObject_type doc;
+  if (payload.length() == 0 || !jsonScanObject(payload.c_str(), payload.length(), &doc)) {
+    g_wifiServer->send(400, "application/json", "{\"ok\":false,\"error\":\"Missing or malformed JSON body\"}");
+    return;
   }
-  head += "],\"samples\":[";
-  g_wifiServer->sendContent(head);
 
-  static TelemetrySample batch[64];
-  uint32_t afterSeq = 0;
-  bool first = true;
-
-  while (true) {
-    TelemetryStatus batchStatus;
-    bool truncated = false;
-    bool hasMore = false;
-    size_t copied = telemetryCopySamplesAfter(afterSeq, batch, 64U, &truncated, &hasMore, &batchStatus);
-    if (copied == 0) {
-      break;
-    }
+  ReplayReply_type* reply = (ReplayReply_type*)malloc(sizeof(ReplayReply_type));
+  CarParam_type* cars = (CarParam_type*)malloc(TRIGGER_REPLAY_MAX_CANDIDATES * sizeof(CarParam_type));
+  if (reply == nullptr || cars == nullptr) {
+    free(reply);
+    free(cars);
+    g_wifiServer->send(503, "application/json", "{\"ok\":false,\"error\":\"Out of memory\"}");
+    return;
+  }
+  memset(reply, 0, sizeof(*reply));
 
-    String chunk;
-    chunk.reserve(copied * 128U);
-    for (size_t i = 0; i < copied; i++) {
-      const TelemetrySample& s = batch[i];
-      if (!first) {
-        chunk += ",";
-      }
-      first = false;
-      chunk += "{\"seq\":";
-      chunk += String((unsigned long)s.seq);
-      chunk += ",\"tMs\":";
-      chunk += String((unsigned long)s.t_ms);
-      chunk += ",\"triggerPct\":";
-      chunk += String((unsigned int)s.trigger_pct);
-      chunk += ",\"outputPct\":";
-      chunk += String((unsigned int)s.output_pct);
-      chunk += ",\"vinMv\":";
-      chunk += String((unsigned int)s.vin_mV);
-      chunk += ",\"currentMa\":";
-      chunk += String((unsigned int)s.current_mA);
-      chunk += ",\"brakePct\":";
-      chunk += String((unsigned int)s.brake_pct);
-      chunk += ",\"sensiHalfPct\":";
-      chunk += String((unsigned int)s.sensi_halfPct);
-      chunk += ",\"carIndex\":";
-      chunk += String((unsigned int)s.carIndex);
-      chunk += ",\"releaseMode\":";
-      chunk += String((unsigned int)s.releaseMode);
-      chunk += ",\"flags\":";
-      chunk += String((unsigned int)s.flags);
-      chunk += "}";
-      afterSeq = s.seq;
-    }
-
-    g_wifiServer->sendContent(chunk);
-    if (!hasMore) {
-      break;
+  String errorMsg;
+  uint8_t carCount = 0;
+  bool ok = parseReplayCandidates(doc, cars, &carCount, &errorMsg);
+  if (ok) {
+    const JsonScanMember_type* trigger = jsonScanFind(&doc, "trigger");
+    if (trigger != nullptr) {
+      ok = runReplayUpload(doc, trigger, cars, carCount, reply, &errorMsg);
+    } else {
+      int32_t afterSeq = 0;
+      int32_t limit = TRIGGER_REPLAY_MAX_SAMPLES;
+      parseJsonInt(doc, "afterSeq", afterSeq);
+      parseJsonInt(doc, "limit", limit);
+      reply->fromTelemetry = true;
+      ok = runReplayTelemetry(cars, carCount, (uint32_t)max(afterSeq, (int32_t)0),
+                              (uint32_t)constrain(limit, (int32_t)1, (int32_t)TRIGGER_REPLAY_MAX_SAMPLES), reply, &errorMsg);
     }
   }
+  free(cars);
+  if (!ok) {
+    free(reply);
+    String out = "{\"ok\":false,\"error\":\"";
+    appendJsonEscaped(out, errorMsg.c_str());
+    out += "\"}";
+    g_wifiServer->send(400, "application/json", out);
+    return;
+  }
+  triggerReplayEnd(&reply->replay);
+  sendHttpJson(200, writeReplayJson, reply);
+  free(reply);
+}
+
+static void handleTelemetryExportCsv() {
+  startTelemetryExport(TELEMETRY_EXPORT_CSV);
+}
 
-  g_wifiServer->sendContent("]}");
+static void handleTelemetryExportJson() {
+  startTelemetryExport(TELEMETRY_EXPORT_JSON);
 }
 
 static void handleRoot() {
@@ -3068,8 +5109,7 @@ static void handleUi() {
 }
 
 static void handleBackup() {
-  String json = buildJsonBackup();
-  g_wifiServer->send(200, "application/json", json);
+  sendHttpJson(200, writeJsonBackup, nullptr);
 }
 
 static void handleDocsDefault() {
@@ -3146,57 +5186,51 @@ static void handleFaviconSvg() {
   }
 }
 
+/**
+ * @brief Serve any other file listed in the asset manifest (widget scripts, docs images)
+ */
+static void handleStaticAssetOrNotFound() {
+  const StaticAsset_type* asset = nullptr;
+  if (g_spiffsMounted && g_wifiServer->method() == HTTP_GET) {
+    asset = staticAssetsFind(g_wifiServer->uri().c_str());
+  }
+  if (asset == nullptr || !streamStaticAsset(asset, staticAssetContentType(asset->path))) {
+    g_wifiServer->send(404, "text/plain", "Not found: " + g_wifiServer->uri());
+  }
+}
+
+static bool g_restoreUploadClaimed = false;  /* This upload owns the restore stream */
+
 static void handleRestoreUpload() {
   HTTPUpload& upload = g_wifiServer->upload();
   if (upload.status == UPLOAD_FILE_START) {
-    g_uploadBuffer = "";
-    g_uploadBuffer.reserve(6144);
+    if (g_restoreUploadClaimed) {
+      backupRestoreRelease();  /* Previous upload never reached handleRestore() */
+    }
+    g_restoreUploadClaimed = backupRestoreBegin();
   } else if (upload.status == UPLOAD_FILE_WRITE) {
-    g_uploadBuffer += String((char*)upload.buf, upload.currentSize);
+    if (g_restoreUploadClaimed) {
+      backupRestoreFeed((const char*)upload.buf, upload.currentSize);
+    }
+  } else if (upload.status == UPLOAD_FILE_ABORTED) {
+    if (g_restoreUploadClaimed) {
+      backupRestoreRelease();
+      g_restoreUploadClaimed = false;
+    }
   }
 }
 
 static void handleRestore() {
-  if (g_uploadBuffer.length() == 0) {
-    g_wifiServer->send(400, "text/plain", "Error: no file uploaded");
+  if (!g_restoreUploadClaimed) {
+    g_wifiServer->send(400, "text/plain", g_restore.active ? "Error: restore already running"
+                                                           : "Error: no file uploaded");
     return;
   }
+  g_restoreUploadClaimed = false;
 
-  StoredVar_type tempVar;
   String errorMsg;
   String warningMsg;
-
-  uint16_t tempAntiSpinStep = g_antiSpinStepMs;
-  uint16_t tempAntiSpinStepPct = g_antiSpinStepPct;
-  uint16_t tempAntiSpinDisplayMode = g_antiSpinDisplayMode;
-  uint16_t tempEncoderInvert = g_encoderInvertEnabled ? 1 : 0;
-  uint16_t tempAdcVoltageRange = g_adcVoltageRange_mV;
-  uint16_t tempWiFiMode = getConfiguredWiFiMode();
-  char tempWiFiSsid[WIFI_STA_SSID_MAX_LEN + 1];
-  char tempWiFiPassword[WIFI_STA_PASS_MAX_LEN + 1];
-  char tempUiAuthUsername[UI_AUTH_USER_MAX_LEN + 1];
-  char tempUiAuthPassword[UI_AUTH_PASS_MAX_LEN + 1];
-  getConfiguredWiFiClientSsid(tempWiFiSsid, sizeof(tempWiFiSsid));
-  getConfiguredWiFiClientPassword(tempWiFiPassword, sizeof(tempWiFiPassword));
-  getCurrentUiAuthUsername(tempUiAuthUsername, sizeof(tempUiAuthUsername));
-  getCurrentUiAuthPassword(tempUiAuthPassword, sizeof(tempUiAuthPassword));
-  if (parseAndValidateJson(g_uploadBuffer, &tempVar, &tempAntiSpinStep, &tempAntiSpinStepPct, &tempAntiSpinDisplayMode,
-                           &tempEncoderInvert, &tempAdcVoltageRange,
-                           &tempWiFiMode, tempWiFiSsid, sizeof(tempWiFiSsid),
-                           tempWiFiPassword, sizeof(tempWiFiPassword),
-                           tempUiAuthUsername, sizeof(tempUiAuthUsername),
-                           tempUiAuthPassword, sizeof(tempUiAuthPassword),
-                           &errorMsg, &warningMsg)) {
-    g_storedVar = tempVar;
-    g_antiSpinStepMs = tempAntiSpinStep;
-    g_antiSpinStepPct = tempAntiSpinStepPct;
-    g_antiSpinDisplayMode = tempAntiSpinDisplayMode;
-    g_encoderInvertEnabled = tempEncoderInvert ? 1 : 0;
-    applyAdcVoltageRangeMilliVolts(tempAdcVoltageRange);
-    setConfiguredWiFiMode(tempWiFiMode);
-    setConfiguredWiFiClientCredentials(tempWiFiSsid, tempWiFiPassword);
-    setCurrentUiAuthCredentials(tempUiAuthUsername, tempUiAuthPassword);
-    saveEEPROM(g_storedVar);
+  if (backupRestoreFinish(&errorMsg, &warningMsg)) {
     String response = "OK - Settings restored!";
     if (warningMsg.length() > 0) {
       response += " ";
@@ -3205,47 +5239,126 @@ static void handleRestore() {
     }
     response += " Restarting...";
     g_wifiServer->send(200, "text/plain", response);
-    g_uploadBuffer = "";
     delay(1000);
     ESP.restart();
   } else {
     g_wifiServer->send(400, "text/plain", errorMsg);
   }
-  g_uploadBuffer = "";
 }
 
 
+static void postOtaUiPhase(uint8_t phase) {
+  g_otaUiPhase = phase;
+  g_otaUiSeq = (uint8_t)(g_otaUiSeq + 1U);
+}
+
+/**
+ * @brief Draw the OTA screens from Task1 context
+ * @details Progress is redrawn at most every 250 ms or 16 KB, as before, but I2C time no
+ *          longer comes out of the upload.
+ */
+static void serviceOtaDisplay() {
+  uint8_t seq = g_otaUiSeq;
+  uint8_t phase = g_otaUiPhase;
+  bool phaseChanged = (seq != g_otaUiShownSeq);
+  if (phase == OTA_UI_IDLE || (!phaseChanged && phase != OTA_UI_RUNNING)) {
+    return;
+  }
+  g_otaUiShownSeq = seq;
+
+  if (phase == OTA_UI_RUNNING) {
+    if (phaseChanged) {
+      obdFill(&g_obd, OBD_WHITE, 1);
+      if (g_otaTargetSpiffs) {
+        obdWriteString(&g_obd, 0, 8, 0, (char*)"SPIFFS Update", FONT_8x8, OBD_BLACK, 1);
+      } else {
+        obdWriteString(&g_obd, 0, 16, 0, (char*)"OTA Update", FONT_8x8, OBD_BLACK, 1);
+      }
+      obdWriteString(&g_obd, 0, 0, 3 * HEIGHT8x8, (char*)"Updating...", FONT_8x8, OBD_BLACK, 1);
+      obdWriteString(&g_obd, 0, 0, 6 * HEIGHT8x8, (char*)"Do not power off!", FONT_6x8, OBD_BLACK, 1);
+      g_otaLastUiUpdateMs = 0;
+      g_otaLastUiShownKb = 0;
+    }
+    OtaPipelineStatus_type status;
+    otaPipelineGetStatus(&status);
+    uint32_t now = millis();
+    size_t shownKb = status.written / 1024U;
+    if (g_otaLastUiUpdateMs == 0 ||
+        (uint32_t)(now - g_otaLastUiUpdateMs) >= 250U ||
+        shownKb >= (g_otaLastUiShownKb + 16U)) {
+      char msgStr[32];
+      snprintf(msgStr, sizeof(msgStr), "%u KB", (unsigned int)shownKb);
+      obdWriteString(&g_obd, 0, 0, 4 * HEIGHT8x8, msgStr, FONT_8x8, OBD_BLACK, 1);
+      g_otaLastUiUpdateMs = now;
+      g_otaLastUiShownKb = shownKb;
+    }
+    return;
+  }
+
+  obdFill(&g_obd, OBD_WHITE, 1);
+  if (phase == OTA_UI_OK) {
+    if (g_otaTargetSpiffs) {
+      obdWriteString(&g_obd, 0, 0, 24, (char*)"SPIFFS OK!", FONT_12x16, OBD_BLACK, 1);
+    } else {
+      obdWriteString(&g_obd, 0, 8, 24, (char*)"OTA OK!", FONT_12x16, OBD_BLACK, 1);
+    }
+  } else if (phase == OTA_UI_FAIL) {
+    if (g_otaTargetSpiffs) {
+      obdWriteString(&g_obd, 0, 0, 24, (char*)"SPIFFS FAIL!", FONT_12x16, OBD_BLACK, 1);
+    } else {
+      obdWriteString(&g_obd, 0, 0, 24, (char*)"OTA FAIL!", FONT_12x16, OBD_BLACK, 1);
+    }
+  } else {
+    obdWriteString(&g_obd, 0, 0, 24, (char*)"OTA ABORT!", FONT_12x16, OBD_BLACK, 1);
+  }
+}
+
+static int hexNibble(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+/**
+ * @brief Read the optional X-Binary-SHA256 header (64 hex digits)
+ */
+static bool parseOtaExpectedSha256(uint8_t out[32]) {
+  String hex = g_wifiServer->header("X-Binary-SHA256");
+  hex.trim();
+  if (hex.length() != 64) {
+    return false;
+  }
+  for (uint8_t i = 0; i < 32; i++) {
+    int hi = hexNibble(hex[i * 2]);
+    int lo = hexNibble(hex[i * 2 + 1]);
+    if (hi < 0 || lo < 0) {
+      return false;
+    }
+    out[i] = (uint8_t)((hi << 4) | lo);
+  }
+  return true;
+}
+
 /**
- * @brief Handle OTA upload - streams firmware (.bin) or SPIFFS image (.bin) directly to flash
+ * @brief Handle OTA upload - queues firmware/SPIFFS image chunks for the flash writer task
+ * @details The image may be plain or a block delta (firmware only), see ota_pipeline.h.
  */
 static void handleOtaUpload() {
   HTTPUpload& upload = g_wifiServer->upload();
-  char msgStr[32];
 
   if (upload.status == UPLOAD_FILE_START) {
     String uri = g_wifiServer->uri();
     g_otaTargetSpiffs = (uri == "/ota-spiffs");
-    g_otaTotal = upload.totalSize;  /* May be 0 if browser doesn't send content-length */
-    g_otaWritten = 0;
-    g_otaLastUiUpdateMs = 0;
-    g_otaLastUiShownKb = 0;
     g_otaInProgress = true;
     g_otaSessionOk = true;
     g_otaRestartRequested = otaRequestWantsRestart();
-
-    /* Show update in progress on OLED */
-    obdFill(&g_obd, OBD_WHITE, 1);
-    if (g_otaTargetSpiffs) {
-      obdWriteString(&g_obd, 0, 8, 0, (char*)"SPIFFS Update", FONT_8x8, OBD_BLACK, 1);
-    } else {
-      obdWriteString(&g_obd, 0, 16, 0, (char*)"OTA Update", FONT_8x8, OBD_BLACK, 1);
-    }
-    obdWriteString(&g_obd, 0, 0, 3 * HEIGHT8x8, (char*)"Updating...", FONT_8x8, OBD_BLACK, 1);
-    obdWriteString(&g_obd, 0, 0, 6 * HEIGHT8x8, (char*)"Do not power off!", FONT_6x8, OBD_BLACK, 1);
+    postOtaUiPhase(OTA_UI_RUNNING);
 
     if (g_otaTargetSpiffs && g_spiffsMounted) {
       SPIFFS.end();
       g_spiffsMounted = false;
+      refreshStaticAssetRoutes();
     }
 
     /* Boost WiFi TX power for the duration of the upload. In STA (home WiFi)
@@ -3254,10 +5367,7 @@ static void handleOtaUpload() {
     esp_wifi_get_max_tx_power(&g_otaPrevTxPower);
     esp_wifi_set_max_tx_power(84); /* 84 * 0.25 dBm = 21 dBm (maximum) */
 
-#if defined(U_SPIFFS)
-    int updateCommand = g_otaTargetSpiffs ? U_SPIFFS : U_FLASH;
-#else
-    int updateCommand = U_FLASH;
+#if !defined(U_SPIFFS)
     if (g_otaTargetSpiffs) {
       g_otaSessionOk = false;
       g_otaInProgress = false;
@@ -3271,7 +5381,9 @@ static void handleOtaUpload() {
      * or otherwise invalid. */
     long binarySizeSigned = g_wifiServer->header("X-Binary-Size").toInt();
     size_t binarySize = (binarySizeSigned > 0) ? static_cast<size_t>(binarySizeSigned) : 0;
-    if (!Update.begin(binarySize > 0 ? binarySize : UPDATE_SIZE_UNKNOWN, updateCommand)) {
+    uint8_t expectedSha[32];
+    bool haveSha = parseOtaExpectedSha256(expectedSha);
+    if (!otaPipelineBegin(g_otaTargetSpiffs, binarySize, haveSha ? expectedSha : nullptr)) {
       g_otaSessionOk = false;
       g_otaInProgress = false;
     }
@@ -3280,55 +5392,32 @@ static void handleOtaUpload() {
     if (!g_otaSessionOk) {
       return;
     }
-    if (Update.write(upload.buf, upload.currentSize) == upload.currentSize) {
-      g_otaWritten += upload.currentSize;
-      /* Throttle OLED writes during OTA to avoid wasting time on I2C updates. */
-      uint32_t now = millis();
-      size_t shownKb = g_otaWritten / 1024U;
-      if (g_otaLastUiUpdateMs == 0 ||
-          (uint32_t)(now - g_otaLastUiUpdateMs) >= 250U ||
-          shownKb >= (g_otaLastUiShownKb + 16U)) {
-        sprintf(msgStr, "%u KB", (unsigned int)shownKb);
-        obdWriteString(&g_obd, 0, 0, 4 * HEIGHT8x8, msgStr, FONT_8x8, OBD_BLACK, 1);
-        g_otaLastUiUpdateMs = now;
-        g_otaLastUiShownKb = shownKb;
-      }
-    } else {
+    if (!otaPipelineWrite(upload.buf, upload.currentSize)) {
       g_otaSessionOk = false;
     }
 
   } else if (upload.status == UPLOAD_FILE_END) {
     esp_wifi_set_max_tx_power(g_otaPrevTxPower);
-    bool otaOk = g_otaSessionOk && Update.end(true);
-    if (otaOk) {
-      obdFill(&g_obd, OBD_WHITE, 1);
-      if (g_otaTargetSpiffs) {
-        obdWriteString(&g_obd, 0, 0, 24, (char*)"SPIFFS OK!", FONT_12x16, OBD_BLACK, 1);
-      } else {
-        obdWriteString(&g_obd, 0, 8, 24, (char*)"OTA OK!", FONT_12x16, OBD_BLACK, 1);
-      }
-    } else {
-      obdFill(&g_obd, OBD_WHITE, 1);
-      if (g_otaTargetSpiffs) {
-        obdWriteString(&g_obd, 0, 0, 24, (char*)"SPIFFS FAIL!", FONT_12x16, OBD_BLACK, 1);
-      } else {
-        obdWriteString(&g_obd, 0, 0, 24, (char*)"OTA FAIL!", FONT_12x16, OBD_BLACK, 1);
-      }
+    bool otaOk = g_otaSessionOk && otaPipelineFinish(15000UL);
+    if (!otaOk) {
+      otaPipelineAbort();
     }
+    g_otaSessionOk = otaOk;
+    postOtaUiPhase(otaOk ? OTA_UI_OK : OTA_UI_FAIL);
     g_otaInProgress = false;
   } else if (upload.status == UPLOAD_FILE_ABORTED) {
     esp_wifi_set_max_tx_power(g_otaPrevTxPower);
-    Update.abort();
+    otaPipelineAbort();
     g_otaSessionOk = false;
     g_otaInProgress = false;
     if (g_otaTargetSpiffs) {
       if (!g_spiffsMounted) {
         g_spiffsMounted = SPIFFS.begin(false);
+        refreshStaticAssetRoutes();
       }
       clearOtaDeferredRestartState();
     }
-    obdFill(&g_obd, OBD_WHITE, 1);
-    obdWriteString(&g_obd, 0, 0, 24, (char*)"OTA ABORT!", FONT_12x16, OBD_BLACK, 1);
+    postOtaUiPhase(OTA_UI_ABORT);
   }
 }
 
@@ -3336,22 +5425,28 @@ static void handleOtaUpload() {
  * @brief Handle OTA completion response - called after upload finishes
  */
 static void handleOta() {
-  bool otaOk = g_otaSessionOk && !Update.hasError();
+  bool otaOk = g_otaSessionOk;
   if (!otaOk) {
     clearOtaDeferredRestartState();
     if (g_otaTargetSpiffs && !g_spiffsMounted) {
       g_spiffsMounted = SPIFFS.begin(false);
+      refreshStaticAssetRoutes();
     }
-    if (g_otaTargetSpiffs) {
-      g_wifiServer->send(400, "text/plain", "Error: SPIFFS update failed");
-    } else {
-      g_wifiServer->send(400, "text/plain", "Error: firmware update failed");
+    OtaPipelineStatus_type pipeline;
+    otaPipelineGetStatus(&pipeline);
+    String msg = g_otaTargetSpiffs ? "Error: SPIFFS update failed" : "Error: firmware update failed";
+    if (pipeline.error[0] != '\0') {
+      msg += " (";
+      msg += pipeline.error;
+      msg += ")";
     }
+    g_wifiServer->send(400, "text/plain", msg);
   } else {
     if (!g_otaRestartRequested) {
       if (g_otaTargetSpiffs) {
         if (!g_spiffsMounted) {
           g_spiffsMounted = SPIFFS.begin(false);
+          refreshStaticAssetRoutes();
         }
         g_wifiServer->send(200, "text/plain", "OK - SPIFFS updated! Restart deferred.");
       } else {
@@ -3367,6 +5462,7 @@ static void handleOta() {
       } else {
         g_wifiServer->send(200, "text/plain", "OK - Firmware updated! Restarting...");
       }
+      settingsStoreFlush();
       delay(1000);
       ESP.restart();
     }
@@ -3837,7 +5933,7 @@ static void drawWiFiQrMatrix(const uint8_t modules[WIFI_QR_SIZE][WIFI_QR_SIZE])
   const int originX = (OLED_WIDTH - totalPixels) / 2;
   const int originY = (OLED_HEIGHT - totalPixels) / 2;
 
-  obdFill(&g_obd, OBD_WHITE, 1);
+  oledFrameClear();
   for (int row = 0; row < WIFI_QR_SIZE; row++) {
     for (int col = 0; col < WIFI_QR_SIZE; col++) {
       if (!modules[row][col]) {
@@ -3846,7 +5942,7 @@ static void drawWiFiQrMatrix(const uint8_t modules[WIFI_QR_SIZE][WIFI_QR_SIZE])
       int x0 = originX + (WIFI_QR_QUIET_ZONE + col) * WIFI_QR_SCALE;
       int y0 = originY + (WIFI_QR_QUIET_ZONE + row) * WIFI_QR_SCALE;
       for (uint8_t dy = 0; dy < WIFI_QR_SCALE; dy++) {
-        obdDrawLine(&g_obd, x0, y0 + dy, x0 + WIFI_QR_SCALE - 1, y0 + dy, OBD_BLACK, 1);
+        obdDrawLine(&g_obd, x0, y0 + dy, x0 + WIFI_QR_SCALE - 1, y0 + dy, OBD_BLACK, OLED_FRAME_RENDER);
       }
     }
   }
@@ -3886,6 +5982,10 @@ bool isWiFiPortalApFallbackActive() {
   return g_wifiApFallbackActive;
 }
 
+uint8_t getWiFiHomeConnectState() {
+  return g_wifiStaState;
+}
+
 bool hasConfiguredWiFiClientCredentials() {
   return hasWiFiClientCredentials();
 }
@@ -3902,6 +6002,9 @@ void getConfiguredWiFiClientPassword(char* out, size_t outLen) {
 
 void setConfiguredWiFiClientCredentials(const char* ssid, const char* password) {
   loadWiFiNetworkSettingsIfNeeded();
+  if (ssid == nullptr || strcmp(ssid, g_wifiClientSsid) != 0) {
+    g_wifiStaCachedChannel = 0;  /* Cached BSSID belongs to the old network */
+  }
   copyBoundedString(g_wifiClientSsid, sizeof(g_wifiClientSsid), ssid);
   copyBoundedString(g_wifiClientPassword, sizeof(g_wifiClientPassword), password);
 }
@@ -3916,6 +6019,7 @@ void resetWiFiNetworkSettings() {
   g_wifiConfiguredMode = WIFI_CONFIG_AP;
   g_wifiClientSsid[0] = '\0';
   g_wifiClientPassword[0] = '\0';
+  g_wifiStaCachedChannel = 0;
   applyDefaultUiAuthCredentials();
   writeWiFiNetworkSettingsToPrefs();
 }
@@ -3942,17 +6046,29 @@ static void registerWebRoutes() {
   g_wifiServer->on("/controller/", HTTP_GET, handleUi);
   g_wifiServer->on("/controller/index.html", HTTP_GET, handleUi);
   g_wifiServer->on("/api/info", HTTP_GET, []() { if (!requireControllerAuth()) return; handleInfo(); });
+  g_wifiServer->on("/api/perf", HTTP_GET, []() { if (!requireControllerAuth()) return; handlePerf(); });
+  g_wifiServer->on("/api/perf/reset", HTTP_POST, []() { if (!requireControllerAuth()) return; handlePerfReset(); });
+  g_wifiServer->on("/api/laps", HTTP_GET, []() { if (!requireControllerAuth()) return; handleLaps(); });
+  g_wifiServer->on("/api/laps/config", HTTP_POST, []() { if (!requireControllerAuth()) return; handleLapsConfig(); });
+  g_wifiServer->on("/api/laps/new", HTTP_POST, []() { if (!requireControllerAuth()) return; handleLapsNewSession(); });
+  g_wifiServer->on("/api/race", HTTP_GET, []() { if (!requireControllerAuth()) return; handleRaceLink(); });
+  g_wifiServer->on("/api/race/config", HTTP_POST, []() { if (!requireControllerAuth()) return; handleRaceLinkConfig(); });
   g_wifiServer->on("/api/schema", HTTP_GET, []() { if (!requireControllerAuth()) return; handleSchema(); });
   g_wifiServer->on("/api/state", HTTP_GET, []() { if (!requireControllerAuth()) return; handleState(); });
   g_wifiServer->on("/api/apply", HTTP_POST, []() { if (!requireControllerAuth()) return; handleApply(); });
   g_wifiServer->on("/api/save", HTTP_POST, []() { if (!requireControllerAuth()) return; handleSave(); });
   g_wifiServer->on("/api/telemetry/status", HTTP_GET, []() { if (!requireControllerAuth()) return; handleTelemetryStatus(); });
+  g_wifiServer->on("/api/live/token", HTTP_POST, []() { if (!requireControllerAuth()) return; handleLivePushToken(); });
+  g_wifiServer->on("/api/telemetry/live.bin", HTTP_GET, []() { if (!requireControllerAuth()) return; handleTelemetryLiveBinary(); });
   g_wifiServer->on("/api/telemetry/live", HTTP_GET, []() { if (!requireControllerAuth()) return; handleTelemetryLive(); });
   g_wifiServer->on("/api/telemetry/start", HTTP_POST, []() { if (!requireControllerAuth()) return; handleTelemetryStart(); });
   g_wifiServer->on("/api/telemetry/stop", HTTP_POST, []() { if (!requireControllerAuth()) return; handleTelemetryStop(); });
   g_wifiServer->on("/api/telemetry/clear", HTTP_POST, []() { if (!requireControllerAuth()) return; handleTelemetryClear(); });
   g_wifiServer->on("/api/telemetry/export.csv", HTTP_GET, []() { if (!requireControllerAuth()) return; handleTelemetryExportCsv(); });
   g_wifiServer->on("/api/telemetry/export.json", HTTP_GET, []() { if (!requireControllerAuth()) return; handleTelemetryExportJson(); });
+  g_wifiServer->on("/api/telemetry/query", HTTP_GET, []() { if (!requireControllerAuth()) return; handleTelemetryQuery(); });
+  g_wifiServer->on("/api/replay", HTTP_POST, []() { if (!requireControllerAuth()) return; handleReplay(); });
+  g_wifiServer->on("/api/telemetry/sessions", HTTP_GET, []() { if (!requireControllerAuth()) return; handleTelemetrySessions(); });
   g_wifiServer->on("/backup", HTTP_GET, []() { if (!requireControllerAuth()) return; handleBackup(); });
   g_wifiServer->on("/docs", HTTP_GET, handleDocsDefault);
   g_wifiServer->on("/docs/", HTTP_GET, handleDocsDefault);
@@ -3981,6 +6097,7 @@ static void registerWebRoutes() {
   g_wifiServer->on("/docs/assets/curve_examples.png", HTTP_GET, handleDocsCurveAsset);
   g_wifiServer->on("/docs/assets/trig_cal.png", HTTP_GET, handleDocsTriggerAsset);
   g_wifiServer->on("/favicon.svg", HTTP_GET, handleFaviconSvg);
+  g_wifiServer->onNotFound(handleStaticAssetOrNotFound);
   g_wifiServer->on("/favicon.ico", HTTP_GET, []() {
     g_wifiServer->sendHeader("Location", "/favicon.svg");
     g_wifiServer->send(302, "text/plain", "");
@@ -3996,9 +6113,11 @@ static void registerWebRoutes() {
                    []() { if (!requireControllerAuth()) return; handleOtaUpload(); });
 
   /* Collect the binary size header sent by the UI so Update.begin() can
-   * allocate the exact partition space needed instead of UPDATE_SIZE_UNKNOWN. */
-  static const char* kOtaCollectHeaders[] = {"X-Binary-Size"};
-  g_wifiServer->collectHeaders(kOtaCollectHeaders, 1);
+   * allocate the exact partition space needed instead of UPDATE_SIZE_UNKNOWN,
+   * the optional image hash checked by the OTA writer, and the cache
+   * validator browsers send when revalidating assets. */
+  static const char* kCollectHeaders[] = {"X-Binary-Size", "X-Binary-SHA256", "If-None-Match", "Accept-Encoding"};
+  g_wifiServer->collectHeaders(kCollectHeaders, 4);
 }
 
 bool isWiFiPortalActive() {
@@ -4023,6 +6142,7 @@ static void stopWiFiTransportOnly() {
 
   WiFi.mode(WIFI_OFF);
   g_wifiActiveMode = WIFI_PORTAL_OFF;
+  g_wifiStaState = WIFI_STA_IDLE;
   g_wifiApFallbackActive = false;
   g_wifiConnectedSsid[0] = '\0';
 }
@@ -4041,75 +6161,169 @@ static bool startWiFiApTransport() {
   return true;
 }
 
-static bool startWiFiHomeTransportAttempt() {
+/* Written by the WiFi event task, consumed by serviceWiFiHomeConnect() (WiFiTask) */
+typedef struct {
+  bool gotIp;
+  bool disconnected;
+  uint8_t reason;           /* wifi_err_reason_t of the last disconnect */
+} WiFiStaEvents_type;
+
+static portMUX_TYPE g_wifiStaEventMux = portMUX_INITIALIZER_UNLOCKED;
+static WiFiStaEvents_type g_wifiStaEvents = {false, false, 0};
+
+static void onWiFiStaEvent(arduino_event_id_t event, arduino_event_info_t info) {
+  portENTER_CRITICAL(&g_wifiStaEventMux);
+  if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP) {
+    g_wifiStaEvents.gotIp = true;
+  } else if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) {
+    g_wifiStaEvents.disconnected = true;
+    g_wifiStaEvents.reason = info.wifi_sta_disconnected.reason;
+  }
+  portEXIT_CRITICAL(&g_wifiStaEventMux);
+}
+
+static WiFiStaEvents_type takeWiFiStaEvents() {
+  portENTER_CRITICAL(&g_wifiStaEventMux);
+  WiFiStaEvents_type events = g_wifiStaEvents;
+  g_wifiStaEvents.gotIp = false;
+  g_wifiStaEvents.disconnected = false;
+  portEXIT_CRITICAL(&g_wifiStaEventMux);
+  return events;
+}
+
+static bool isWiFiStaAuthFailure(uint8_t reason) {
+  return reason == WIFI_REASON_AUTH_FAIL ||
+         reason == WIFI_REASON_4WAY_HANDSHAKE_TIMEOUT ||
+         reason == WIFI_REASON_HANDSHAKE_TIMEOUT;
+}
+
+/**
+ * @brief Start one association attempt and return at once
+ * @details The first attempt goes straight to the cached BSSID/channel (no scan); a retry
+ *          scans all channels in case the router moved.
+ */
+static void startWiFiHomeConnectAttempt() {
+  if (g_wifiStaAttempt == 0 && g_wifiStaCachedChannel != 0) {
+    WiFi.begin(g_wifiClientSsid, g_wifiClientPassword, g_wifiStaCachedChannel, g_wifiStaCachedBssid, true);
+  } else {
+    WiFi.begin(g_wifiClientSsid, g_wifiClientPassword);
+  }
+  g_wifiStaAttempt++;
+  g_wifiStaAttemptAtMs = millis();
+}
+
+/**
+ * @brief Switch the radio to STA and start connecting; progress runs in serviceWiFiHomeConnect()
+ */
+static bool startWiFiHomeTransport() {
+  if (!hasWiFiClientCredentials()) {
+    return false;
+  }
+
+  buildWifiHostNameIfNeeded();
+  if (!g_wifiStaEventsRegistered) {
+    WiFi.onEvent(onWiFiStaEvent);
+    g_wifiStaEventsRegistered = true;
+  }
+
   WiFi.persistent(false);
-  WiFi.disconnect(true, false, 250);
+  WiFi.disconnect(true, false);
   WiFi.mode(WIFI_OFF);
-  delay(120);
 
   WiFi.mode(WIFI_STA);
   WiFi.setSleep(false);
   WiFi.setAutoReconnect(true);
   WiFi.setHostname(g_wifiHostName);
-  delay(50);
   /* Boost TX power before connecting — STA mode needs more power than AP mode
    * to reach a distant router. Reverts to default on WiFi.mode(WIFI_OFF). */
   esp_wifi_set_max_tx_power(84); /* 84 * 0.25 dBm = 21 dBm (maximum) */
 
-  obdFill(&g_obd, OBD_WHITE, 1);
-  obdWriteString(&g_obd, 0, centerX8x8("Connecting..."), 0, (char*)"Connecting...", FONT_8x8, OBD_BLACK, 1);
-  obdWriteString(&g_obd, 0, 0, 2 * HEIGHT8x8, (char*)"SSID:", FONT_6x8, OBD_BLACK, 1);
-  obdWriteString(&g_obd, 0, 0, 3 * HEIGHT8x8, (char*)g_wifiClientSsid, FONT_6x8, OBD_BLACK, 1);
+  takeWiFiStaEvents();
+  g_wifiLastConnectStatus = WL_IDLE_STATUS;
+  g_wifiStaAttempt = 0;
+  startWiFiHomeConnectAttempt();
+  g_wifiStaState = WIFI_STA_CONNECTING;
+  g_wifiActiveMode = WIFI_PORTAL_HOME;
+  return true;
+}
 
-  WiFi.begin(g_wifiClientSsid, g_wifiClientPassword);
+/**
+ * @brief Home WiFi connect state machine (WiFiTask, from serviceWiFiPortal())
+ * @details CONNECTING ends on GOT_IP, on an auth failure, on "no AP found" or after
+ *          WIFI_STA_CONNECT_TIMEOUT_MS. Anything but an auth failure retries once with a
+ *          full scan before the AP fallback starts. Once connected the driver's auto
+ *          reconnect takes over and the AP fallback is never forced.
+ */
+static void serviceWiFiHomeConnect() {
+  uint8_t state = g_wifiStaState;
+  if (state == WIFI_STA_IDLE || state == WIFI_STA_FAILED) {
+    return;
+  }
 
-  uint32_t startedAt = millis();
-  while ((millis() - startedAt) < WIFI_STA_CONNECT_TIMEOUT_MS) {
-    wl_status_t status = WiFi.status();
-    if (status == WL_CONNECTED) {
-      break;
+  WiFiStaEvents_type events = takeWiFiStaEvents();
+  if (events.gotIp) {
+    g_wifiLastConnectStatus = WL_CONNECTED;
+    g_wifiStaState = WIFI_STA_CONNECTED;
+    if (state != WIFI_STA_CONNECTING) {
+      return;
     }
-    if (status == WL_CONNECT_FAILED) {
-      break;
+    copyBoundedString(g_wifiConnectedSsid, sizeof(g_wifiConnectedSsid), WiFi.SSID().c_str());
+    if (!g_mdnsActive && MDNS.begin(g_wifiHostName)) {
+      g_mdnsActive = true;
+    }
+    const uint8_t* bssid = WiFi.BSSID();
+    uint8_t channel = (uint8_t)WiFi.channel();
+    if (bssid != nullptr && channel != 0 &&
+        (channel != g_wifiStaCachedChannel || memcmp(bssid, g_wifiStaCachedBssid, sizeof(g_wifiStaCachedBssid)) != 0)) {
+      memcpy(g_wifiStaCachedBssid, bssid, sizeof(g_wifiStaCachedBssid));
+      g_wifiStaCachedChannel = channel;
+      Preferences pref;
+      if (pref.begin("stored_var", false)) {
+        writeWiFiStaCacheIfChanged(pref);
+        pref.end();
+      }
     }
-    delay(100);
+    return;
   }
 
-  g_wifiLastConnectStatus = WiFi.status();
-  if (g_wifiLastConnectStatus != WL_CONNECTED) {
-    WiFi.disconnect(true, false, 250);
-    WiFi.mode(WIFI_OFF);
-    delay(120);
-    return false;
+  if (state == WIFI_STA_CONNECTED) {
+    if (events.disconnected) {
+      g_wifiLastConnectStatus = WL_CONNECTION_LOST;
+      g_wifiStaState = WIFI_STA_LOST;
+    }
+    return;
   }
-
-  copyBoundedString(g_wifiConnectedSsid, sizeof(g_wifiConnectedSsid), WiFi.SSID().c_str());
-  if (MDNS.begin(g_wifiHostName)) {
-    g_mdnsActive = true;
+  if (state == WIFI_STA_LOST) {
+    return;
   }
-  g_wifiActiveMode = WIFI_PORTAL_HOME;
-  return true;
-}
 
-static bool startWiFiHomeTransport() {
-  if (!hasWiFiClientCredentials()) {
-    return false;
+  /* Our own disconnect before a retry reports ASSOC_LEAVE: not a verdict on the attempt */
+  bool failedEvent = events.disconnected && events.reason != WIFI_REASON_ASSOC_LEAVE;
+  bool authFailed = failedEvent && isWiFiStaAuthFailure(events.reason);
+  bool noAp = failedEvent && events.reason == WIFI_REASON_NO_AP_FOUND;
+  bool timedOut = (millis() - g_wifiStaAttemptAtMs) >= WIFI_STA_CONNECT_TIMEOUT_MS;
+  if (!authFailed && !noAp && !timedOut) {
+    return;
   }
 
-  buildWifiHostNameIfNeeded();
-
-  for (uint8_t attempt = 0; attempt < 2; attempt++) {
-    if (startWiFiHomeTransportAttempt()) {
-      return true;
-    }
-    delay(200);
+  g_wifiLastConnectStatus = authFailed ? WL_CONNECT_FAILED : (noAp ? WL_NO_SSID_AVAIL : WL_DISCONNECTED);
+  if (!authFailed && g_wifiStaAttempt < WIFI_STA_CONNECT_ATTEMPTS) {
+    WiFi.disconnect(false, false);
+    startWiFiHomeConnectAttempt();
+    return;
   }
 
-  return false;
+  WiFi.disconnect(true, false);
+  WiFi.mode(WIFI_OFF);
+  g_wifiActiveMode = WIFI_PORTAL_OFF;
+  g_wifiStaState = WIFI_STA_FAILED;
+  g_wifiApFallbackActive = true;
+  startWiFiApTransport();  /* Leaves WIFI_PORTAL_OFF if the AP cannot start either */
 }
 
 static bool startWiFiServerOnly() {
   g_spiffsMounted = SPIFFS.begin(false);
+  refreshStaticAssetRoutes();
 
   g_wifiServer = new WebServer(80);
   if (g_wifiServer == nullptr) {
@@ -4117,12 +6331,14 @@ static bool startWiFiServerOnly() {
     if (g_spiffsMounted) {
       SPIFFS.end();
       g_spiffsMounted = false;
+      refreshStaticAssetRoutes();
     }
     return false;
   }
 
   registerWebRoutes();
   g_wifiServer->begin();
+  livePushStart();
   return true;
 }
 
@@ -4135,25 +6351,14 @@ bool startWiFiPortal() {
   g_wifiApFallbackActive = false;
   g_wifiConnectedSsid[0] = '\0';
 
+  /* Home mode only starts the association here; serviceWiFiHomeConnect() finishes it
+   * or falls back to AP in the background, so the caller never waits on the router. */
   bool networkReady = false;
   if (g_wifiConfiguredMode == WIFI_CONFIG_HOME && hasWiFiClientCredentials()) {
     networkReady = startWiFiHomeTransport();
   }
 
   if (!networkReady) {
-    g_wifiApFallbackActive = (g_wifiConfiguredMode == WIFI_CONFIG_HOME);
-    if (g_wifiApFallbackActive) {
-      const char* reason = (g_wifiLastConnectStatus == WL_CONNECT_FAILED)
-                             ? "Wrong password?"
-                             : "Router unreachable";
-      obdFill(&g_obd, OBD_WHITE, 1);
-      obdWriteString(&g_obd, 0, centerX8x8("WiFi failed"), 0, (char*)"WiFi failed", FONT_8x8, OBD_BLACK, 1);
-      obdWriteString(&g_obd, 0, 0, 2 * HEIGHT8x8, (char*)reason, FONT_6x8, OBD_BLACK, 1);
-      obdWriteString(&g_obd, 0, 0, 4 * HEIGHT8x8, (char*)"Switching to AP", FONT_6x8, OBD_BLACK, 1);
-      obdWriteString(&g_obd, 0, 0, 5 * HEIGHT8x8, (char*)"mode. Retrying", FONT_6x8, OBD_BLACK, 1);
-      obdWriteString(&g_obd, 0, 0, 6 * HEIGHT8x8, (char*)"later.", FONT_6x8, OBD_BLACK, 1);
-      delay(2500);
-    }
     networkReady = startWiFiApTransport();
   }
 
@@ -4166,13 +6371,20 @@ bool startWiFiPortal() {
 
 void serviceWiFiPortal() {
   if (g_wifiServer != nullptr) {
+    serviceWiFiHomeConnect();
     g_wifiServer->handleClient();
+    portalTransferService();
+    livePushService();
   }
 }
 
 void serviceConnectivityPortal() {
   /* serviceWiFiPortal() is handled by the dedicated WiFiTask in ESPEED32.ino */
-  serviceUsbSerialCommands();
+  static uint32_t lastSerialService_ms = 0;
+  if (schedProfilePortalDue(&lastSerialService_ms)) {
+    serviceUsbSerialCommands();  /* Throttled in RACE */
+  }
+  serviceOtaDisplay();
   isOtaDeferredRestartActive();
   if (g_wifiRestartPending && !isOtaInProgress() &&
       (int32_t)(millis() - g_wifiRestartAtMs) >= 0) {
@@ -4193,6 +6405,8 @@ void stopWiFiPortal() {
   g_wifiRestartAtMs = 0;
 
   telemetryStopLogging();
+  livePushStop();
+  portalTransferStopAll();
 
   if (g_wifiServer != nullptr) {
     g_wifiServer->stop();
@@ -4205,6 +6419,7 @@ void stopWiFiPortal() {
   if (g_spiffsMounted) {
     SPIFFS.end();
     g_spiffsMounted = false;
+    refreshStaticAssetRoutes();
   }
 }
 
@@ -4270,7 +6485,17 @@ static void drawWiFiPortalScreenPage(uint8_t pageIndex, const IPAddress& ip) {
     return;
   }
 
-  if (g_wifiActiveMode == WIFI_PORTAL_HOME) {
+  if (g_wifiActiveMode == WIFI_PORTAL_HOME && g_wifiStaState != WIFI_STA_CONNECTED) {
+    const char* title = (g_wifiStaState == WIFI_STA_LOST) ? "Reconnecting" : "Connecting...";
+    obdWriteString(&g_obd, 0, centerX8x8(title), 0, (char*)title, FONT_8x8, OBD_BLACK, 1);
+    obdWriteString(&g_obd, 0, 0, 2 * HEIGHT8x8, (char*)"SSID:", FONT_6x8, OBD_BLACK, 1);
+    obdWriteString(&g_obd, 0, 0, 3 * HEIGHT8x8, (char*)g_wifiClientSsid, FONT_6x8, OBD_BLACK, 1);
+    if (g_wifiStaState == WIFI_STA_CONNECTING) {
+      snprintf(line, sizeof(line), "Attempt %u/%u", (unsigned)g_wifiStaAttempt, (unsigned)WIFI_STA_CONNECT_ATTEMPTS);
+      obdWriteString(&g_obd, 0, 0, 5 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+    }
+    obdWriteString(&g_obd, 0, 0, 7 * HEIGHT8x8, (char*)"AP if it fails", FONT_6x8, OBD_BLACK, 1);
+  } else if (g_wifiActiveMode == WIFI_PORTAL_HOME) {
     const char* shownSsid = (g_wifiConnectedSsid[0] != '\0') ? g_wifiConnectedSsid : g_wifiClientSsid;
     const char* title = "Client 1/2";
     obdWriteString(&g_obd, 0, centerX8x8(title), 0, (char*)title, FONT_8x8, OBD_BLACK, 1);
@@ -4288,6 +6513,12 @@ static void drawWiFiPortalScreenPage(uint8_t pageIndex, const IPAddress& ip) {
     obdWriteString(&g_obd, 0, 0, 2 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
     snprintf(line, sizeof(line), "Pass: %s", WIFI_PASS);
     obdWriteString(&g_obd, 0, 0, 3 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+    if (g_wifiApFallbackActive) {
+      const char* reason = (g_wifiLastConnectStatus == WL_CONNECT_FAILED)
+                             ? "Wrong password?"
+                             : "Router unreachable";
+      obdWriteString(&g_obd, 0, 0, 4 * HEIGHT8x8, (char*)reason, FONT_6x8, OBD_BLACK, 1);
+    }
     obdWriteString(&g_obd, 0, 0, 6 * HEIGHT8x8, (char*)"Open in browser", FONT_6x8, OBD_BLACK, 1);
     snprintf(line, sizeof(line), "%s", ip.toString().c_str());
     obdWriteString(&g_obd, 0, 0, 7 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
@@ -4309,6 +6540,9 @@ void showWiFiPortalScreen() {
 
   IPAddress ip = getWiFiPortalIP();
   uint8_t pageIndex = 0;
+  uint8_t shownMode = g_wifiActiveMode;
+  uint8_t shownStaState = g_wifiStaState;
+  uint8_t shownAttempt = g_wifiStaAttempt;
   g_rotaryEncoder.setAcceleration(MENU_ACCELERATION);
   setUiEncoderBoundaries(0, 1, false);
   resetUiEncoder(pageIndex);
@@ -4317,6 +6551,17 @@ void showWiFiPortalScreen() {
   while (true) {
     serviceConnectivityPortal();
 
+    /* The home connect finishes (or falls back to AP) in WiFiTask while this screen is up */
+    if (shownMode != g_wifiActiveMode || shownStaState != g_wifiStaState || shownAttempt != g_wifiStaAttempt) {
+      shownMode = g_wifiActiveMode;
+      shownStaState = g_wifiStaState;
+      shownAttempt = g_wifiStaAttempt;
+      ip = getWiFiPortalIP();
+      if (pageIndex == 0) {
+        drawWiFiPortalScreenPage(pageIndex, ip);
+      }
+    }
+
     if (!isOtaInProgress()) {
       if (g_rotaryEncoder.encoderChanged()) {
         uint8_t nextPage = (uint8_t)readUiEncoder();
@@ -4373,12 +6618,21 @@ void showWiFiQrScreen() {
   }
 
   char ssid[20];
-  char payload[64];
-  uint8_t modules[WIFI_QR_SIZE][WIFI_QR_SIZE];
+  char payload[64] = "";
 
   getWiFiPortalSsid(ssid, sizeof(ssid));
-  if (!buildWiFiQrPayload(ssid, WIFI_PASS, payload) ||
-      !buildWiFiQrMatrix(payload, modules)) {
+  bool built = buildWiFiQrPayload(ssid, WIFI_PASS, payload);
+  /* The payload carries SSID and password: the encoded screen is reused while they stay the same */
+  uint32_t screenKey = oledScreenKeyAddString(oledScreenKeyBegin(OLED_SCREEN_WIFI_QR), payload);
+  if (built && !oledScreenCacheShow(screenKey)) {
+    uint8_t modules[WIFI_QR_SIZE][WIFI_QR_SIZE];
+    built = buildWiFiQrMatrix(payload, modules);
+    if (built) {
+      drawWiFiQrMatrix(modules);
+      oledScreenCachePresent(screenKey);
+    }
+  }
+  if (!built) {
     showDismissableMessageScreen("QR failed", "Could not build", "Press to exit");
     if (!wasAlreadyActive) {
       stopWiFiPortal();
@@ -4386,8 +6640,6 @@ void showWiFiQrScreen() {
     return;
   }
 
-  drawWiFiQrMatrix(modules);
-
   while (true) {
     serviceConnectivityPortal();
 
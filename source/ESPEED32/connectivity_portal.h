@@ -8,7 +8,7 @@
 #define WIFI_SSID           "ESPEED32"
 #define WIFI_PASS           "espeed32"
 #define WIFI_AP_CHANNEL     1
-#define WIFI_MAX_CONNECTIONS 1
+#define WIFI_MAX_CONNECTIONS 4   /* Driver phone + pit tablets; long transfers run in portal_transfer.cpp */
 #define WIFI_STA_SSID_MAX_LEN 32
 #define WIFI_STA_PASS_MAX_LEN 63
 
@@ -21,6 +21,15 @@
 #define WIFI_PORTAL_AP      1
 #define WIFI_PORTAL_HOME    2
 
+/* Client (home) WiFi bring-up, driven by WiFi.onEvent from serviceWiFiPortal().
+ * startWiFiPortal() only starts the association and returns; the portal reports
+ * WIFI_PORTAL_HOME while connecting and switches to the AP fallback by itself. */
+#define WIFI_STA_IDLE       0
+#define WIFI_STA_CONNECTING 1
+#define WIFI_STA_CONNECTED  2
+#define WIFI_STA_LOST       3   /* Was connected; the driver is reconnecting */
+#define WIFI_STA_FAILED     4   /* Gave up; AP fallback running */
+
 /* Function prototypes - called from settings menu */
 void showWiFiPortalScreen();
 void showWiFiQrScreen();
@@ -41,6 +50,7 @@ uint16_t getConfiguredWiFiMode();
 void setConfiguredWiFiMode(uint16_t mode);
 uint16_t getActiveWiFiPortalMode();
 bool isWiFiPortalApFallbackActive();
+uint8_t getWiFiHomeConnectState();
 bool hasConfiguredWiFiClientCredentials();
 void getConfiguredWiFiClientSsid(char* out, size_t outLen);
 void getConfiguredWiFiClientPassword(char* out, size_t outLen);
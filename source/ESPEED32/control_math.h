@@ -0,0 +1,259 @@
+#ifndef CONTROL_MATH_H_
+#define CONTROL_MATH_H_
+
+#include <stdint.h>
+
+/* Pure control-path math: TLE493D field angle, trigger filter and normalization, deadband and
+ * the anti-spin ramp.
+ * Depends on <stdint.h> only - no Arduino core, no globals, time passed in - so the
+ * same code can be compiled and exercised off-target. The firmware wrappers in
+ * ESPEED32.ino supply the stored settings, the tick snapshot and micros(). */
+
+#define ANTIS_SPEED_START_MIN 30  /* [%] Start anti-spin only for throttle requests above this threshold */
+#define ANTIS_SPEED_START_MAX 65  /* [%] Maximum anti-spin start threshold */
+
+/**
+ * @brief Arduino-ESP32 map(): same integer rounding, -1 for an empty input range
+ */
+static inline int32_t controlMathMap(int32_t x, int32_t inMin, int32_t inMax, int32_t outMin, int32_t outMax) {
+  const int32_t run = inMax - inMin;
+  if (run == 0) {
+    return -1;
+  }
+  return ((x - inMin) * (outMax - outMin)) / run + outMin;
+}
+
+/**
+ * @brief Clamp a raw reading to [minIn, maxIn] and scale it to [0, normalizedMax]
+ * @param isReversed The reading falls as the trigger is pressed
+ */
+static inline uint16_t controlMathNormalizeAndClamp(uint16_t raw, uint16_t minIn, uint16_t maxIn,
+                                                    uint16_t normalizedMax, bool isReversed) {
+  if (maxIn == minIn) {
+    return 0;  /* Avoid division by 0 */
+  }
+  if (raw < minIn) raw = minIn;
+  if (raw > maxIn) raw = maxIn;
+  int32_t travel = isReversed ? (int32_t)maxIn - (int32_t)raw : (int32_t)raw - (int32_t)minIn;
+  if (travel < 0) travel = -travel;
+  return (uint16_t)(((uint32_t)(uint16_t)travel * normalizedMax) / (uint32_t)((int32_t)maxIn - (int32_t)minIn));
+}
+
+/**
+ * @brief Apply a deadband at both ends of [minVal, maxVal] and rescale the rest to the full range
+ */
+static inline uint16_t controlMathAddDeadBand(uint16_t inputVal, uint16_t minVal, uint16_t maxVal, uint16_t deadBand) {
+  if (inputVal < minVal + deadBand) {
+    return 0;
+  }
+  if (inputVal > maxVal - deadBand) {
+    return maxVal;
+  }
+  return (uint16_t)controlMathMap(inputVal, deadBand, maxVal - deadBand, minVal, maxVal);
+}
+
+/**
+ * @brief Anti-spin ramp state, one per output
+ */
+typedef struct {
+  uint32_t lastOutput_x1000;  /* [0.001%] */
+  uint32_t prevCall_us;
+} AntiSpinRamp_type;
+
+/**
+ * @brief Anti-spin ramp inputs for one call
+ */
+typedef struct {
+  uint16_t antiSpin_ms;      /* Ramp time, 0 = off */
+  uint16_t antiSpinMax_ms;   /* Top of the antiSpin setting range */
+  uint16_t sensiRaw;         /* [1/sensiScale %] Effective SENSI */
+  uint16_t sensiScale;       /* SENSI units per percent */
+  uint16_t maxSpeed_pct;     /* [%] */
+} AntiSpinRampParams_type;
+
+/**
+ * @brief Ramp the requested duty up toward maxSpeed over antiSpin_ms; decelerations pass straight through
+ * @param requested_permille [0.1%] Requested output (0-1000)
+ * @param now_us Current time; the ramp step is the time since the previous call
+ * @return [0.1%] Output after the ramp
+ */
+static inline uint16_t controlMathAntiSpinRamp(AntiSpinRamp_type* state, uint16_t requested_permille,
+                                               const AntiSpinRampParams_type* params, uint32_t now_us) {
+  uint32_t deltaTime_us = now_us - state->prevCall_us;
+  state->prevCall_us = now_us;
+
+  /* Dynamic start threshold: high antiSpin (powerful motor/slippery track) starts the ramp lower */
+  uint16_t startPct = (uint16_t)controlMathMap(params->antiSpin_ms, 0, params->antiSpinMax_ms,
+                                               ANTIS_SPEED_START_MAX, ANTIS_SPEED_START_MIN);
+  uint16_t startRaw = startPct * params->sensiScale;
+  uint32_t sensiFloor_x1000 = (uint32_t)params->sensiRaw * (1000U / params->sensiScale);
+
+  if (params->antiSpin_ms == 0) {
+    state->lastOutput_x1000 = sensiFloor_x1000;
+    return requested_permille;
+  }
+  /* Low duty: too little current to spin the wheels */
+  if (requested_permille < startPct * 10U) {
+    state->lastOutput_x1000 = (uint32_t)requested_permille * 100U;
+    return requested_permille;
+  }
+  /* Deceleration (braking) is immediate */
+  if ((uint32_t)requested_permille * 100U <= state->lastOutput_x1000) {
+    state->lastOutput_x1000 = (uint32_t)requested_permille * 100U;
+    return requested_permille;
+  }
+
+  uint16_t minSpeedRaw = (params->sensiRaw > startRaw) ? params->sensiRaw : startRaw;
+  uint16_t maxSpeedRaw = params->maxSpeed_pct * params->sensiScale;
+  /* Span in SENSI units -> x1000-percent ramp units; deltaTime is in µs while antiSpin is in ms */
+  uint32_t maxDelta_x1000 = ((uint32_t)(uint16_t)(maxSpeedRaw - minSpeedRaw) * deltaTime_us) /
+                            ((uint32_t)params->antiSpin_ms * params->sensiScale);
+
+  uint32_t output_x1000;
+  if (state->lastOutput_x1000 < ((uint32_t)requested_permille * 100U - maxDelta_x1000)) {
+    output_x1000 = state->lastOutput_x1000 + maxDelta_x1000;
+  } else {
+    output_x1000 = (uint32_t)requested_permille * 100U;  /* Target reached */
+  }
+  /* The ramp starts from SENSI, not from zero */
+  if (output_x1000 < sensiFloor_x1000) {
+    output_x1000 = sensiFloor_x1000;
+  }
+  state->lastOutput_x1000 = output_x1000;
+  return (uint16_t)(output_x1000 / 100U);
+}
+
+/**
+ * @brief Adaptive (One-Euro) trigger filter state
+ * @details Position is kept in Q8 raw counts so slow drifts below one count still move the output.
+ */
+typedef struct {
+  int32_t x_q8;          /* [raw/256] Filtered position */
+  int32_t speed;         /* [raw/s] Low-passed trigger speed */
+  int16_t prevRaw;
+  uint32_t prevTime_us;
+  uint16_t cutoff_dHz;   /* [0.1 Hz] Cutoff used on the last step */
+  bool init;
+} TriggerFilter_type;
+
+/**
+ * @brief Adaptive trigger filter tuning
+ * @details cutoff = minCutoff + beta * |speed| / 1000, clamped to maxCutoff: a resting trigger is
+ *          smoothed hard, a moving one passes with a lag of 1 / (2*pi*cutoff).
+ */
+typedef struct {
+  uint16_t minCutoff_dHz;    /* [0.1 Hz] Cutoff with the trigger at rest */
+  uint16_t maxCutoff_dHz;    /* [0.1 Hz] Upper bound */
+  uint16_t beta;             /* [0.1 Hz per 1000 raw/s] Cutoff rise with trigger speed */
+  uint16_t speedCutoff_dHz;  /* [0.1 Hz] Low-pass on the speed estimate */
+} TriggerFilterParams_type;
+
+#define CONTROL_MATH_TAU_US_DHZ  1591549UL  /* 1e6 / (2*pi) in µs * 0.1 Hz */
+
+/**
+ * @brief First-order low-pass smoothing factor for one step
+ * @return [1/65536] dt / (dt + tau), tau = 1 / (2*pi*cutoff)
+ */
+static inline uint32_t controlMathLowPassAlphaQ16(uint32_t dt_us, uint16_t cutoff_dHz) {
+  if (cutoff_dHz == 0) {
+    return 0;
+  }
+  if (dt_us > 0xFFFFUL) dt_us = 0xFFFFUL;
+  uint32_t tau_us = CONTROL_MATH_TAU_US_DHZ / cutoff_dHz;
+  return (dt_us << 16) / (dt_us + tau_us);
+}
+
+/**
+ * @brief Time constant of the filter at its last cutoff, i.e. its lag on a steady trigger movement
+ */
+static inline uint32_t controlMathTriggerFilterLagUs(const TriggerFilter_type* state) {
+  return (state->cutoff_dHz > 0) ? CONTROL_MATH_TAU_US_DHZ / state->cutoff_dHz : 0;
+}
+
+static inline void controlMathTriggerFilterReset(TriggerFilter_type* state) {
+  state->init = false;
+}
+
+/**
+ * @brief Run one trigger sample through the adaptive filter
+ * @param raw Sensor reading
+ * @param time_us Timestamp of the reading; the step is the time since the previous sample
+ * @return Filtered reading, same units as raw
+ */
+static inline int16_t controlMathTriggerFilter(TriggerFilter_type* state, int16_t raw, uint32_t time_us,
+                                               const TriggerFilterParams_type* params) {
+  if (!state->init) {
+    state->x_q8 = (int32_t)raw << 8;
+    state->speed = 0;
+    state->prevRaw = raw;
+    state->prevTime_us = time_us;
+    state->cutoff_dHz = params->minCutoff_dHz;
+    state->init = true;
+    return raw;
+  }
+  uint32_t dt_us = time_us - state->prevTime_us;
+  if (dt_us == 0) {
+    return (int16_t)((state->x_q8 + 128) >> 8);  /* Same sample again */
+  }
+  state->prevTime_us = time_us;
+
+  int32_t rawSpeed = (int32_t)(((int64_t)((int32_t)raw - state->prevRaw) * 1000000LL) / (int64_t)dt_us);
+  state->prevRaw = raw;
+  int32_t speedAlpha = (int32_t)controlMathLowPassAlphaQ16(dt_us, params->speedCutoff_dHz);
+  state->speed += (int32_t)(((int64_t)(rawSpeed - state->speed) * speedAlpha) >> 16);
+
+  uint32_t absSpeed = (state->speed < 0) ? (uint32_t)(-state->speed) : (uint32_t)state->speed;
+  uint32_t cutoff = params->minCutoff_dHz + (uint32_t)(((uint64_t)params->beta * absSpeed) / 1000U);
+  if (cutoff > params->maxCutoff_dHz) cutoff = params->maxCutoff_dHz;
+  state->cutoff_dHz = (uint16_t)cutoff;
+
+  int32_t alpha = (int32_t)controlMathLowPassAlphaQ16(dt_us, state->cutoff_dHz);
+  state->x_q8 += (int32_t)(((int64_t)(((int32_t)raw << 8) - state->x_q8) * alpha) >> 16);
+  return (int16_t)((state->x_q8 + 128) >> 8);
+}
+
+/* atan(i/64) for i = 0..64 in 0.01 deg; first octant of controlMathAtan2Deg10() */
+static const uint16_t CONTROL_MATH_ATAN_TABLE_CDEG[65] = {
+     0,   90,  179,  268,  358,  447,  536,  624,
+   713,  800,  888,  975, 1062, 1148, 1234, 1319,
+  1404, 1488, 1571, 1653, 1735, 1817, 1897, 1977,
+  2056, 2134, 2211, 2287, 2363, 2438, 2511, 2584,
+  2657, 2728, 2798, 2867, 2936, 3003, 3070, 3136,
+  3201, 3264, 3327, 3390, 3451, 3511, 3571, 3629,
+  3687, 3744, 3800, 3855, 3909, 3963, 4016, 4067,
+  4119, 4169, 4218, 4267, 4315, 4363, 4409, 4455,
+  4500
+};
+
+/**
+ * @brief Integer atan2 in 0.1 deg (0..3599), TLE493D field angle
+ * @details Octant reduction to a ratio in [0,1] (Q16), then a 64-segment linearly
+ *          interpolated arctan table; the result is truncated to 0.1 deg like the previous
+ *          float path. Inputs must stay below 2^15 in magnitude. The accuracy over the
+ *          12-bit (W2B6) and 14-bit (P3B6) field ranges is checked by scripts/host_checks.sh.
+ */
+static inline int16_t controlMathAtan2Deg10(int32_t y, int32_t x) {
+  uint32_t ax = (x < 0) ? (uint32_t)(-x) : (uint32_t)x;
+  uint32_t ay = (y < 0) ? (uint32_t)(-y) : (uint32_t)y;
+  if (ax == 0 && ay == 0) return 0;
+
+  bool swapped = ay > ax;
+  uint32_t num = swapped ? ax : ay;
+  uint32_t den = swapped ? ay : ax;
+  uint32_t ratioQ16 = (num << 16) / den;          /* inputs are < 2^15, no overflow */
+  uint32_t seg = ratioQ16 >> 10;                  /* 0..64 */
+  uint32_t frac = ratioQ16 & 0x3FFU;
+  int32_t cdeg = CONTROL_MATH_ATAN_TABLE_CDEG[seg];
+  if (seg < 64) {
+    cdeg += ((int32_t)(CONTROL_MATH_ATAN_TABLE_CDEG[seg + 1] - CONTROL_MATH_ATAN_TABLE_CDEG[seg]) * (int32_t)frac) >> 10;
+  }
+
+  if (swapped) cdeg = 9000 - cdeg;                /* octant -> quadrant */
+  if (x < 0) cdeg = 18000 - cdeg;                 /* quadrant II / III */
+  if (y < 0) cdeg = 36000 - cdeg;                 /* lower half-plane */
+  if (cdeg >= 36000) cdeg -= 36000;
+
+  return (int16_t)(cdeg / 10);
+}
+
+#endif  /* CONTROL_MATH_H_ */
@@ -0,0 +1,255 @@
+#include "current_sampler.h"
+#include <Arduino.h>
+#include <atomic>
+#include <driver/gpio.h>
+#include <soc/gpio_periph.h>
+#include "HAL.h"
+
+static hw_timer_t* g_curSyncTimer = NULL;
+static TaskHandle_t g_curSamplerTask = NULL;
+static volatile uint32_t g_curPwmPeriod_us = 0;
+static volatile uint32_t g_curOnTime_us = 0;
+static volatile uint16_t g_curDutyPermille = 0;
+
+static volatile uint16_t g_curOnPhase_mA = 0;
+static volatile uint16_t g_curAverage_mA = 0;
+static volatile uint32_t g_curSampleMs = 0;
+static volatile bool g_curSynced = false;
+static volatile bool g_curHasSample = false;
+static uint32_t g_curSyncedCount = 0;
+static uint32_t g_curFreeRunCount = 0;
+
+/* Temperature sense handshake with the control task (see currentSamplerHoldForSense()) */
+static volatile bool g_curSenseHold = false;     /* IS carries the temperature current: publish nothing */
+static volatile bool g_curSenseRequest = false;
+static volatile uint16_t g_curSenseRaw = 0;
+static std::atomic<uint32_t> g_curSenseSeq(0);
+
+/* HB_IN_PIN edge interrupt lent out (see currentSamplerLendEdgeInterrupt()) */
+static volatile bool g_curEdgeLent = false;
+static volatile bool g_curEdgeLentAck = false;   /* Task is past its last touch of the pin interrupt */
+
+/* PWM period start: arm the mid-on alarm and ignore further edges until the task re-enables them */
+static void IRAM_ATTR currentSamplerEdgeISR(void* arg) {
+  (void)arg;
+  uint32_t onTime_us = g_curOnTime_us;
+  if (onTime_us < CURRENT_SYNC_MIN_ON_US) {
+    return;
+  }
+  gpio_intr_disable((gpio_num_t)HB_IN_PIN);
+  timerWrite(g_curSyncTimer, 0);
+  timerAlarm(g_curSyncTimer, (onTime_us / 2U) - CURRENT_SYNC_LATENCY_US, false, 0);
+}
+
+static void IRAM_ATTR currentSamplerAlarmISR() {
+  BaseType_t higherPriorityTaskWoken = pdFALSE;
+  vTaskNotifyGiveFromISR(g_curSamplerTask, &higherPriorityTaskWoken);
+  portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+static void currentSamplerPublish(uint16_t onPhase_mA, bool synced) {
+  uint16_t average_mA = synced ? (uint16_t)(((uint32_t)onPhase_mA * g_curDutyPermille) / 1000U) : onPhase_mA;
+  g_curOnPhase_mA = onPhase_mA;
+  g_curAverage_mA = average_mA;
+  g_curSynced = synced;
+  g_curSampleMs = millis();
+  g_curHasSample = true;
+  if (synced) {
+    g_curSyncedCount++;
+  } else {
+    g_curFreeRunCount++;
+  }
+}
+
+static void currentSamplerTaskcode(void *pvParameters) {
+  (void)pvParameters;
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, 0);  /* Drop an alarm left over from a timed-out cycle */
+    bool synced = false;
+    if (g_curEdgeLent) {
+      g_curEdgeLentAck = true;    /* Someone else owns the pin interrupt: free-running reads only */
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CURRENT_SYNC_TIMEOUT_MS));
+    } else {
+      g_curEdgeLentAck = false;
+      gpio_intr_enable((gpio_num_t)HB_IN_PIN);
+      synced = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CURRENT_SYNC_TIMEOUT_MS)) > 0;
+      if (!synced) {
+        gpio_intr_disable((gpio_num_t)HB_IN_PIN);
+      }
+    }
+    if (g_curSenseHold) {
+      if (g_curSenseRequest) {
+        g_curSenseRaw = analogRead(HB_AN_PIN);
+        g_curSenseRequest = false;
+        g_curSenseSeq.fetch_add(1, std::memory_order_release);
+      }
+      continue;
+    }
+    uint16_t raw = analogRead(HB_AN_PIN);
+    currentSamplerPublish(HAL_ConvertMotorCurrentAdcToMilliAmps(raw), synced);
+    vTaskDelay(1);  /* One sample per RTOS tick is plenty for lap detection and telemetry */
+  }
+}
+
+/**
+ * @brief Route PWM edges to the sampler and start the sampler task
+ * @details The PWM pin stays driven by LEDC; only its input buffer is enabled so the
+ *          GPIO interrupt sees the pad level.
+ * @return true if synchronized sampling is running
+ */
+bool currentSamplerStart() {
+  if (g_curSamplerTask != NULL) {
+    return true;
+  }
+  if (!HAL_HasMotorCurrentSense()) {
+    return false;
+  }
+
+  currentSamplerSetPwmFrequency(ledcReadFreq(HB_IN_PIN));
+
+  g_curSyncTimer = timerBegin(CURRENT_SYNC_TIMER_HZ);
+  if (g_curSyncTimer == NULL) {
+    return false;
+  }
+  timerAttachInterrupt(g_curSyncTimer, &currentSamplerAlarmISR);
+
+  BaseType_t ok = xTaskCreatePinnedToCore(
+    currentSamplerTaskcode,
+    "CurSampler",
+    CURRENT_SAMPLER_STACK_SIZE,
+    NULL,
+    CURRENT_SAMPLER_TASK_PRIORITY,
+    &g_curSamplerTask,
+    CURRENT_SAMPLER_TASK_CORE);
+  if (ok != pdPASS) {
+    g_curSamplerTask = NULL;
+    timerEnd(g_curSyncTimer);
+    g_curSyncTimer = NULL;
+    return false;
+  }
+
+  gpio_install_isr_service(0);  /* May already be installed by attachInterrupt(); that is fine */
+  gpio_set_intr_type((gpio_num_t)HB_IN_PIN, GPIO_INTR_POSEDGE);
+  gpio_isr_handler_add((gpio_num_t)HB_IN_PIN, currentSamplerEdgeISR, NULL);
+  return true;
+}
+
+/**
+ * @brief Hand the HB_IN_PIN edge interrupt to another user (the latency bench)
+ * @details Waits until the sampler task has stopped enabling and disabling the pin interrupt;
+ *          it reads free-running until currentSamplerReturnEdgeInterrupt(). Call from a task
+ *          that may block for a few ms.
+ * @return false if the sampler did not let go in time (the interrupt is not lent then)
+ */
+bool currentSamplerLendEdgeInterrupt() {
+  if (g_curSamplerTask == NULL) {
+    return true;
+  }
+  g_curEdgeLentAck = false;
+  g_curEdgeLent = true;
+  xTaskNotifyGive(g_curSamplerTask);
+  for (uint8_t i = 0; i < 4U * CURRENT_SYNC_TIMEOUT_MS && !g_curEdgeLentAck; i++) {
+    vTaskDelay(1);
+  }
+  if (!g_curEdgeLentAck) {
+    g_curEdgeLent = false;
+    return false;
+  }
+  gpio_intr_disable((gpio_num_t)HB_IN_PIN);
+  return true;
+}
+
+/**
+ * @brief Take the HB_IN_PIN edge interrupt back: rising edges into currentSamplerEdgeISR() again
+ * @details The borrower must have disabled the interrupt. Safe from the control task.
+ */
+void currentSamplerReturnEdgeInterrupt() {
+  if (g_curSamplerTask == NULL || !g_curEdgeLent) {
+    return;
+  }
+  gpio_intr_disable((gpio_num_t)HB_IN_PIN);
+  gpio_set_intr_type((gpio_num_t)HB_IN_PIN, GPIO_INTR_POSEDGE);
+  gpio_isr_handler_add((gpio_num_t)HB_IN_PIN, currentSamplerEdgeISR, NULL);
+  g_curEdgeLent = false;
+}
+
+/**
+ * @brief Track the motor PWM frequency
+ * @details Call after every frequency change. Any ledcAttachChannel() on HB_IN_PIN reconfigures the pad
+ *          as output-only, so the input buffer needed for the edge interrupt is re-enabled here too.
+ */
+void currentSamplerSetPwmFrequency(uint32_t freq_hz) {
+  g_curPwmPeriod_us = (freq_hz > 0) ? (1000000UL / freq_hz) : 0;
+  g_curOnTime_us = (g_curPwmPeriod_us * g_curDutyPermille) / 1000U;
+  PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[HB_IN_PIN]);
+}
+
+/**
+ * @brief Track the motor duty cycle in permille (called from HalfBridge_SetPwmDragPermille())
+ */
+void currentSamplerSetDuty(uint16_t duty_permille) {
+  uint16_t duty = (uint16_t)constrain(duty_permille, 0, 1000);
+  g_curDutyPermille = duty;
+  g_curOnTime_us = (g_curPwmPeriod_us * duty) / 1000U;
+}
+
+/**
+ * @brief Stop publishing current samples while the IS pin carries something else
+ * @details The control task holds the sampler for the duration of a temperature measurement
+ *          (HalfBridge_SetTemperatureSensePattern()); releasing the hold drops a pending read.
+ */
+void currentSamplerHoldForSense(bool hold) {
+  if (!hold) {
+    g_curSenseRequest = false;
+  }
+  g_curSenseHold = hold;
+}
+
+/**
+ * @brief Take one raw IS reading on the sampler task (only while held)
+ * @details The read happens within CURRENT_SYNC_TIMEOUT_MS; poll currentSamplerGetSenseRead().
+ */
+void currentSamplerRequestSenseRead() {
+  if (g_curSamplerTask == NULL || !g_curSenseHold) {
+    return;
+  }
+  g_curSenseRequest = true;
+  xTaskNotifyGive(g_curSamplerTask);
+}
+
+/**
+ * @brief Result of the last requested IS reading
+ * @return Read sequence; it changes when a new reading is in outRaw
+ */
+uint32_t currentSamplerGetSenseRead(uint16_t* outRaw) {
+  uint32_t seq = g_curSenseSeq.load(std::memory_order_acquire);
+  if (outRaw != nullptr) {
+    *outRaw = g_curSenseRaw;
+  }
+  return seq;
+}
+
+/**
+ * @brief Load the latest current sample
+ * @return false if the sampler is not running or its last sample is older than CURRENT_SYNC_STALE_MS
+ */
+bool currentSamplerGetLatest(CurrentSample_type* outSample) {
+  if (outSample == nullptr || g_curSamplerTask == NULL || !g_curHasSample) {
+    return false;
+  }
+  outSample->onPhase_mA = g_curOnPhase_mA;
+  outSample->average_mA = g_curAverage_mA;
+  outSample->timestamp_ms = g_curSampleMs;
+  outSample->synced = g_curSynced;
+  return (uint32_t)(millis() - outSample->timestamp_ms) <= CURRENT_SYNC_STALE_MS;
+}
+
+void currentSamplerGetStats(CurrentSamplerStats_type* outStats) {
+  if (outStats == nullptr) {
+    return;
+  }
+  outStats->syncedSamples = g_curSyncedCount;
+  outStats->freeRunSamples = g_curFreeRunCount;
+  outStats->pwmPeriod_us = g_curPwmPeriod_us;
+  outStats->running = g_curSamplerTask != NULL;
+}
@@ -0,0 +1,50 @@
+#ifndef CURRENT_SAMPLER_H_
+#define CURRENT_SAMPLER_H_
+
+#include <stdint.h>
+
+/* PWM-synchronized motor current sampling.
+ * The rising edge of the motor PWM (HB_IN_PIN) arms a one-shot hardware timer that fires
+ * at the middle of the on-phase; the sampler task then reads the current-sense input.
+ * With continuous motor current the mid-on sample equals the average current over the
+ * on-phase, so one sample per period gives a ripple-free value. */
+#define CURRENT_SAMPLER_TASK_PRIORITY  3       /* Above Task1/WiFiTask/AdcSampler on core 0 */
+#define CURRENT_SAMPLER_TASK_CORE      0
+#define CURRENT_SAMPLER_STACK_SIZE     3072
+#define CURRENT_SYNC_TIMER_HZ          1000000UL  /* 1 MHz -> alarm value in µs */
+#ifndef CURRENT_SYNC_LATENCY_US
+#define CURRENT_SYNC_LATENCY_US        8U      /* [µs] Edge ISR + alarm ISR + task wake before the ADC samples */
+#endif
+#define CURRENT_SYNC_MIN_ON_US         (2U * CURRENT_SYNC_LATENCY_US + 12U)  /* Shorter on-phases are not sampled synchronously */
+#define CURRENT_SYNC_TIMEOUT_MS        5U      /* No usable edge (0%/100% duty, short on-phase) -> free-running read */
+#define CURRENT_SYNC_STALE_MS          20U     /* Older samples are ignored by readers */
+
+/**
+ * @brief Latest motor current sample
+ */
+typedef struct {
+  uint16_t onPhase_mA;    /* [mA] Current during the on-phase (mid-on sample) */
+  uint16_t average_mA;    /* [mA] Average over one PWM period (on-phase current x duty) */
+  uint32_t timestamp_ms;  /* millis() of the sample */
+  bool synced;            /* true = taken at mid-on, false = free-running fallback read */
+} CurrentSample_type;
+
+typedef struct {
+  uint32_t syncedSamples;
+  uint32_t freeRunSamples;
+  uint32_t pwmPeriod_us;
+  bool running;
+} CurrentSamplerStats_type;
+
+bool currentSamplerStart();
+void currentSamplerSetPwmFrequency(uint32_t freq_hz);
+void currentSamplerSetDuty(uint16_t duty_permille);
+bool currentSamplerGetLatest(CurrentSample_type* outSample);
+void currentSamplerHoldForSense(bool hold);
+void currentSamplerRequestSenseRead();
+uint32_t currentSamplerGetSenseRead(uint16_t* outRaw);
+void currentSamplerGetStats(CurrentSamplerStats_type* outStats);
+bool currentSamplerLendEdgeInterrupt();
+void currentSamplerReturnEdgeInterrupt();
+
+#endif  /* CURRENT_SAMPLER_H_ */
@@ -3,6 +3,8 @@
 #include "HAL.h"
 #include "slot_ESC.h"
 #include "ui_render.h"
+#include "input_events.h"
+#include "lap_engine.h"
 
 extern StoredVar_type g_storedVar;
 extern ESC_type g_escVar;
@@ -71,7 +73,7 @@ void showLapStats() {
           obdFill(&g_obd, OBD_WHITE, 1);
           needFullRedraw = true;
         }
-        delay(10);
+        inputEventsWait(TASK1_IDLE_WAIT_MS);
         continue;
       }
     }
@@ -95,12 +97,7 @@ void showLapStats() {
       }
       if (!brakeLongHandled && (millis() - brakePressStartMs > BUTTON_LONG_PRESS_MS)) {
         brakeLongHandled = true;
-        g_escVar.lapCount = 0;
-        g_escVar.bestLapTime_ms = 0;
-        g_escVar.lapStartTime_ms = 0;
-        for (uint8_t i = 0; i < LAP_MAX_COUNT; i++) {
-          g_escVar.lapTimes[i] = 0;
-        }
+        lapEngineNewSession();  /* Logged laps stay in flash; the counters restart */
         resetUiEncoder(0);
         needFullRedraw = true;
       }
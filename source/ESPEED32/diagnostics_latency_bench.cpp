@@ -0,0 +1,215 @@
+#include "diagnostics_latency_bench.h"
+#include <Arduino.h>
+#include "HAL.h"
+#include "slot_ESC.h"
+#include "connectivity_portal.h"
+#include "input_events.h"
+#include "latency_bench.h"
+
+extern OBDISP g_obd;
+extern AiEsp32RotaryEncoder g_rotaryEncoder;
+
+#define LATENCY_BENCH_SCREEN_REFRESH_MS  200U
+#define LATENCY_BENCH_SCREEN_PAGES       4U    /* Summary, rise histogram, fall histogram, config */
+#define LATENCY_BENCH_HIST_TOP           9     /* Bar area rows [y] */
+#define LATENCY_BENCH_HIST_BOTTOM        54
+
+static void latencyBenchScreenTitle(const char* title) {
+  obdFill(&g_obd, OBD_WHITE, 1);
+  obdWriteString(&g_obd, 0, centerX8x8(title), 0, (char*)title, FONT_8x8, OBD_BLACK, 1);
+}
+
+/* Block until encoder button clicked or brake button pressed+released.
+ * Returns true if encoder button, false if brake. */
+static bool latencyBenchWaitButton() {
+  while (true) {
+    if (g_rotaryEncoder.isEncoderButtonClicked()) return true;
+    if (digitalRead(BUTT_PIN) == BUTTON_PRESSED) {
+      while (digitalRead(BUTT_PIN) == BUTTON_PRESSED) vTaskDelay(1);
+      return false;
+    }
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
+  }
+}
+
+static void latencyBenchShowError(const char* what, uint8_t error) {
+  latencyBenchScreenTitle("Latency");
+  obdWriteString(&g_obd, 0, 0, 2 * HEIGHT8x8, (char*)what, FONT_6x8, OBD_BLACK, 1);
+  obdWriteString(&g_obd, 0, 0, 3 * HEIGHT8x8, (char*)latencyBenchErrorText(error), FONT_6x8, OBD_BLACK, 1);
+  obdWriteString(&g_obd, 0, 0, 7 * HEIGHT8x8, (char*)"enc >   (back)", FONT_6x8, OBD_BLACK, 1);
+  latencyBenchWaitButton();
+}
+
+static void latencyBenchDrawProgress(const LatencyBenchRun_type* run) {
+  char line[22];
+  snprintf(line, sizeof(line), "Step %4u/%-4u %3lus ", (unsigned)run->stepsDone, (unsigned)run->steps,
+           (unsigned long)(run->elapsed_ms / 1000U));
+  obdWriteString(&g_obd, 0, 0, 2 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+  snprintf(line, sizeof(line), "Last %6luus       ", (unsigned long)run->lastLatency_us);
+  obdWriteString(&g_obd, 0, 0, 3 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+  snprintf(line, sizeof(line), "UP p50 %6luus     ", (unsigned long)latencyBenchPercentile(&run->rise, 500));
+  obdWriteString(&g_obd, 0, 0, 4 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+  snprintf(line, sizeof(line), "DN p50 %6luus     ", (unsigned long)latencyBenchPercentile(&run->fall, 500));
+  obdWriteString(&g_obd, 0, 0, 5 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+}
+
+static void latencyBenchDrawHistRow(uint8_t row, const char* label, const LatencyBenchHist_type* hist) {
+  char line[22];
+  if (hist->count == 0) {
+    snprintf(line, sizeof(line), "%s   --   --    --", label);
+  } else {
+    snprintf(line, sizeof(line), "%s %4lu %4lu %5lu", label, (unsigned long)(hist->sum_us / hist->count),
+             (unsigned long)latencyBenchPercentile(hist, 950), (unsigned long)hist->max_us);
+  }
+  obdWriteString(&g_obd, 0, 0, row * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+}
+
+static void latencyBenchDrawSummary(const LatencyBenchRun_type* run) {
+  char line[22];
+  latencyBenchScreenTitle("Latency us");
+  obdWriteString(&g_obd, 0, 0, 1 * HEIGHT8x8, (char*)"    avg  p95   max", FONT_6x8, OBD_BLACK, 1);
+  latencyBenchDrawHistRow(2, "UP", &run->rise);
+  latencyBenchDrawHistRow(3, "DN", &run->fall);
+  snprintf(line, sizeof(line), "min %lu / %lu", (unsigned long)(run->rise.count ? run->rise.min_us : 0),
+           (unsigned long)(run->fall.count ? run->fall.min_us : 0));
+  obdWriteString(&g_obd, 0, 0, 4 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+  snprintf(line, sizeof(line), "T/O %u/%u  n=%u", (unsigned)run->rise.timeouts, (unsigned)run->fall.timeouts,
+           (unsigned)run->stepsDone);
+  obdWriteString(&g_obd, 0, 0, 5 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+  obdWriteString(&g_obd, 0, 0, 7 * HEIGHT8x8, (char*)"turn=more  enc=back", FONT_6x8, OBD_BLACK, 1);
+}
+
+/* One 3 px bar per bin, scaled to the fullest bin; the last bar is the overflow bin */
+static void latencyBenchDrawHistogram(const char* title, const LatencyBenchHist_type* hist) {
+  latencyBenchScreenTitle(title);
+  uint16_t peak = 1;
+  for (uint8_t b = 0; b <= LATENCY_BENCH_BINS; b++) {
+    if (hist->bins[b] > peak) peak = hist->bins[b];
+  }
+  const int height = LATENCY_BENCH_HIST_BOTTOM - LATENCY_BENCH_HIST_TOP;
+  for (uint8_t b = 0; b <= LATENCY_BENCH_BINS; b++) {
+    int x = b * (OLED_WIDTH / (LATENCY_BENCH_BINS + 1U));
+    int h = ((int)hist->bins[b] * height + peak - 1) / peak;
+    for (int dx = 0; dx < 2 && h > 0; dx++) {
+      obdDrawLine(&g_obd, x + dx, LATENCY_BENCH_HIST_BOTTOM, x + dx, LATENCY_BENCH_HIST_BOTTOM - h, OBD_BLACK, 1);
+    }
+  }
+  char line[22];
+  snprintf(line, sizeof(line), "0  %lums/div  n=%u", (unsigned long)(10U * LATENCY_BENCH_BIN_US / 1000U),
+           (unsigned)hist->count);
+  obdWriteString(&g_obd, 0, 0, 7 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+}
+
+static void latencyBenchDrawConfig(const LatencyBenchRun_type* run) {
+  char line[22];
+  const LatencyBenchConfig_type* c = &run->config;
+  latencyBenchScreenTitle("Pipeline");
+  snprintf(line, sizeof(line), "Filter  %s", latencyBenchFilterLabel(c->filterMode));
+  obdWriteString(&g_obd, 0, 0, 1 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+  snprintf(line, sizeof(line), "AntiSp  %s %ums", (c->antiSpinMode == ANTISPIN_MODE_TRACTION) ? "TRACT" : "RAMP",
+           (unsigned)c->antiSpin_ms);
+  obdWriteString(&g_obd, 0, 0, 2 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+  if (c->telemetryLogging) {
+    snprintf(line, sizeof(line), "Telem   %luus", (unsigned long)c->telemetryInterval_us);
+  } else {
+    snprintf(line, sizeof(line), "Telem   off");
+  }
+  obdWriteString(&g_obd, 0, 0, 3 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+  snprintf(line, sizeof(line), "Ctrl    %luus", (unsigned long)c->controlPeriod_us);
+  obdWriteString(&g_obd, 0, 0, 4 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+  snprintf(line, sizeof(line), "PWM     %uHz", (unsigned)c->pwmFreq_hz);
+  obdWriteString(&g_obd, 0, 0, 5 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+  snprintf(line, sizeof(line), "CPU %uMHz  radio %s", (unsigned)c->cpuFreq_mhz, c->radioOn ? "on" : "off");
+  obdWriteString(&g_obd, 0, 0, 6 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+}
+
+static void latencyBenchDrawPage(uint8_t page, const LatencyBenchRun_type* run) {
+  switch (page) {
+    case 1:  latencyBenchDrawHistogram("Rise", &run->rise); break;
+    case 2:  latencyBenchDrawHistogram("Fall", &run->fall); break;
+    case 3:  latencyBenchDrawConfig(run); break;
+    default: latencyBenchDrawSummary(run); break;
+  }
+}
+
+/**
+ * @brief Trigger-to-PWM latency bench screen (Settings > Hardware > Bench)
+ * @details The control task steps the trigger and the edge capture times the output; this
+ *          screen starts a run, shows the progress and pages through the result. The same
+ *          runs are read by the serial BENCH command.
+ */
+void showLatencyBench() {
+  while (g_rotaryEncoder.isEncoderButtonClicked()) {}
+  while (digitalRead(BUTT_PIN) == BUTTON_PRESSED) vTaskDelay(1);
+
+  latencyBenchScreenTitle("Latency");
+  obdWriteString(&g_obd, 0, 0, 2 * HEIGHT8x8, (char*)"Lift the car: motor", FONT_6x8, OBD_BLACK, 1);
+  char line[22];
+  snprintf(line, sizeof(line), "steps %u%%<>%u%% ~%us", (unsigned)LATENCY_BENCH_LOW_PCT, (unsigned)LATENCY_BENCH_HIGH_PCT,
+           (unsigned)((LATENCY_BENCH_STEPS_DEFAULT * LATENCY_BENCH_SETTLE_MS) / 1000U));
+  obdWriteString(&g_obd, 0, 0, 3 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+  obdWriteString(&g_obd, 0, 0, 4 * HEIGHT8x8, (char*)"Trigger/brk = abort", FONT_6x8, OBD_BLACK, 1);
+  obdWriteString(&g_obd, 0, 0, 7 * HEIGHT8x8, (char*)"enc>start  brk>back", FONT_6x8, OBD_BLACK, 1);
+  if (!latencyBenchWaitButton()) {
+    obdFill(&g_obd, OBD_WHITE, 1);
+    return;
+  }
+
+  uint8_t error = latencyBenchStart(LATENCY_BENCH_STEPS_DEFAULT);
+  if (error != LATENCY_BENCH_OK) {
+    latencyBenchShowError("Cannot start:", error);
+    obdFill(&g_obd, OBD_WHITE, 1);
+    return;
+  }
+
+  /* Progress; the control task stops on its own on trigger or brake */
+  static LatencyBenchRun_type run;
+  latencyBenchScreenTitle("Latency");
+  obdWriteString(&g_obd, 0, 0, 7 * HEIGHT8x8, (char*)"enc = cancel", FONT_6x8, OBD_BLACK, 1);
+  uint32_t lastDraw_ms = 0;
+  do {
+    if (g_rotaryEncoder.isEncoderButtonClicked()) {
+      latencyBenchCancel();
+    }
+    if (latencyBenchCopyRuns(&run, 1) == 0) {
+      break;
+    }
+    if (millis() - lastDraw_ms >= LATENCY_BENCH_SCREEN_REFRESH_MS) {
+      lastDraw_ms = millis();
+      latencyBenchDrawProgress(&run);
+    }
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
+  } while (run.state == LATENCY_BENCH_RUNNING);
+  while (digitalRead(BUTT_PIN) == BUTTON_PRESSED) vTaskDelay(1);
+
+  if (run.state == LATENCY_BENCH_ABORTED && run.stepsDone == 0) {
+    latencyBenchShowError("Stopped:", run.error);
+    obdFill(&g_obd, OBD_WHITE, 1);
+    return;
+  }
+
+  /* A run stopped part way still shows what it measured */
+  g_rotaryEncoder.setAcceleration(MENU_ACCELERATION);
+  setUiEncoderBoundaries(0, LATENCY_BENCH_SCREEN_PAGES - 1, false);
+  resetUiEncoder(0);
+  uint8_t page = 0;
+  latencyBenchDrawPage(page, &run);
+  while (true) {
+    if (g_rotaryEncoder.encoderChanged()) {
+      uint8_t newPage = (uint8_t)readUiEncoder();
+      if (newPage != page) {
+        page = newPage;
+        latencyBenchDrawPage(page, &run);
+      }
+    }
+    if (g_rotaryEncoder.isEncoderButtonClicked()) {
+      break;
+    }
+    if (digitalRead(BUTT_PIN) == BUTTON_PRESSED) {
+      while (digitalRead(BUTT_PIN) == BUTTON_PRESSED) vTaskDelay(1);
+      break;
+    }
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
+  }
+  obdFill(&g_obd, OBD_WHITE, 1);
+}
@@ -0,0 +1,6 @@
+#ifndef DIAGNOSTICS_LATENCY_BENCH_H_
+#define DIAGNOSTICS_LATENCY_BENCH_H_
+
+void showLatencyBench();
+
+#endif  /* DIAGNOSTICS_LATENCY_BENCH_H_ */
@@ -0,0 +1,207 @@
+#include "diagnostics_motor_sweep.h"
+#include <Arduino.h>
+#include "HAL.h"
+#include "slot_ESC.h"
+#include "connectivity_portal.h"
+#include "input_events.h"
+#include "motor_sweep.h"
+
+extern OBDISP g_obd;
+extern AiEsp32RotaryEncoder g_rotaryEncoder;
+extern StoredVar_type g_storedVar;
+extern void saveEEPROM(StoredVar_type toSave);
+
+#define MOTOR_SWEEP_SCREEN_REFRESH_MS  100U
+
+static void motorSweepScreenTitle() {
+  obdFill(&g_obd, OBD_WHITE, 1);
+  obdWriteString(&g_obd, 0, centerX8x8("Motor Sweep"), 0, (char*)"Motor Sweep", FONT_8x8, OBD_BLACK, 1);
+}
+
+/* Block until encoder button clicked or brake button pressed+released.
+ * Returns true if encoder button, false if brake. */
+static bool motorSweepWaitButton() {
+  while (true) {
+    if (g_rotaryEncoder.isEncoderButtonClicked()) return true;
+    if (digitalRead(BUTT_PIN) == BUTTON_PRESSED) {
+      while (digitalRead(BUTT_PIN) == BUTTON_PRESSED) vTaskDelay(1);
+      return false;
+    }
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
+  }
+}
+
+static void motorSweepShowError(const char* what, uint8_t error) {
+  motorSweepScreenTitle();
+  obdWriteString(&g_obd, 0, 0, 2 * HEIGHT8x8, (char*)what, FONT_6x8, OBD_BLACK, 1);
+  obdWriteString(&g_obd, 0, 0, 3 * HEIGHT8x8, (char*)motorSweepErrorText(error), FONT_6x8, OBD_BLACK, 1);
+  obdWriteString(&g_obd, 0, 0, 7 * HEIGHT8x8, (char*)"enc >   (back)", FONT_6x8, OBD_BLACK, 1);
+  motorSweepWaitButton();
+}
+
+static void motorSweepDrawProgress(const MotorSweepStatus_type* status) {
+  char line[22];
+  if (status->freq_hz == 0) {
+    snprintf(line, sizeof(line), "Resting (temp)      ");
+  } else {
+    snprintf(line, sizeof(line), "%4uHz  duty %3u%%   ", (unsigned)status->freq_hz,
+             (unsigned)((status->duty_permille + 5U) / 10U));
+  }
+  obdWriteString(&g_obd, 0, 0, 2 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+  snprintf(line, sizeof(line), "Point %2u/%-2u  %3lus  ", (unsigned)status->pointCount,
+           (unsigned)MOTOR_SWEEP_MAX_POINTS, (unsigned long)(status->elapsed_ms / 1000U));
+  obdWriteString(&g_obd, 0, 0, 3 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+  if (status->pointCount > 0) {
+    const MotorSweepPoint_type* p = &status->points[status->pointCount - 1];
+    if (p->bemf_mV == MOTOR_SWEEP_BEMF_UNKNOWN) {
+      snprintf(line, sizeof(line), "%5umA  E    --   ", (unsigned)p->current_mA);
+    } else {
+      snprintf(line, sizeof(line), "%5umA  E %5umV ", (unsigned)p->current_mA, (unsigned)p->bemf_mV);
+    }
+    obdWriteString(&g_obd, 0, 0, 5 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+  }
+}
+
+static void motorSweepDrawSummary(const MotorSweepResult_type* result) {
+  char line[22];
+  motorSweepScreenTitle();
+  snprintf(line, sizeof(line), "R   %u.%02u Ohm", (unsigned)(result->res_mOhm / 1000U),
+           (unsigned)((result->res_mOhm % 1000U) / 10U));
+  obdWriteString(&g_obd, 0, 0, 2 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+  if (result->freeRunning) {
+    snprintf(line, sizeof(line), "I0  %u mA", (unsigned)result->noLoad_mA);
+  } else {
+    snprintf(line, sizeof(line), "I0  -- (blocked)");
+  }
+  obdWriteString(&g_obd, 0, 0, 3 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+  if (result->recommendedFreq_hz > 0) {
+    snprintf(line, sizeof(line), "Best %u.%ukHz (now %u.%u)",
+             (unsigned)(result->recommendedFreq_hz / 1000U), (unsigned)((result->recommendedFreq_hz % 1000U) / 100U),
+             (unsigned)(g_storedVar.activeCar.freqPWM / 10U), (unsigned)(g_storedVar.activeCar.freqPWM % 10U));
+  } else {
+    snprintf(line, sizeof(line), "Best --  (no pick)");
+  }
+  obdWriteString(&g_obd, 0, 0, 4 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+  obdWriteString(&g_obd, 0, 0, 5 * HEIGHT8x8, (char*)"turn = table", FONT_6x8, OBD_BLACK, 1);
+  obdWriteString(&g_obd, 0, 0, 7 * HEIGHT8x8,
+                 (result->recommendedFreq_hz > 0) ? (char*)"enc>apply  brk>keep" : (char*)"enc>save   brk>keep",
+                 FONT_6x8, OBD_BLACK, 1);
+}
+
+/* One row per frequency: speed per amp and temperature rise */
+static void motorSweepDrawTable(const MotorSweepResult_type* result) {
+  char line[22];
+  motorSweepScreenTitle();
+  obdWriteString(&g_obd, 0, 0, 1 * HEIGHT8x8, (char*)"kHz   mV/A   dT", FONT_6x8, OBD_BLACK, 1);
+  for (uint8_t f = 0; f < result->freqCount && f < 5U; f++) {  /* Rows 2..6 */
+    const MotorSweepFreqResult_type* fr = &result->freqs[f];
+    char rise[8];
+    if (fr->tempRise_C == MOTOR_SWEEP_TEMP_UNKNOWN) {
+      snprintf(rise, sizeof(rise), " --");
+    } else {
+      snprintf(rise, sizeof(rise), "%+3d", (int)fr->tempRise_C);
+    }
+    snprintf(line, sizeof(line), "%c%u.%u  %5u  %sC", (fr->freq_hz == result->recommendedFreq_hz) ? '>' : ' ',
+             (unsigned)(fr->freq_hz / 1000U), (unsigned)((fr->freq_hz % 1000U) / 100U),
+             (unsigned)fr->bemfPerAmp_mV, rise);
+    obdWriteString(&g_obd, 0, 0, (f + 2) * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+  }
+  obdWriteString(&g_obd, 0, 0, 7 * HEIGHT8x8, (char*)"turn = summary", FONT_6x8, OBD_BLACK, 1);
+}
+
+/**
+ * @brief Motor characterization sweep screen (Settings > Hardware > Motor)
+ * @details The control task drives the sweep; this screen starts it, shows the progress
+ *          and lets the user keep or apply the result. The figures are saved to the active
+ *          car either way; the encoder button also switches the car to the picked frequency.
+ */
+void showMotorSweep() {
+  while (g_rotaryEncoder.isEncoderButtonClicked()) {}
+  while (digitalRead(BUTT_PIN) == BUTTON_PRESSED) vTaskDelay(1);
+
+  motorSweepScreenTitle();
+  obdWriteString(&g_obd, 0, 0, 2 * HEIGHT8x8, (char*)"Lift the car, or", FONT_6x8, OBD_BLACK, 1);
+  obdWriteString(&g_obd, 0, 0, 3 * HEIGHT8x8, (char*)"hold it still. ~30 s", FONT_6x8, OBD_BLACK, 1);
+  obdWriteString(&g_obd, 0, 0, 4 * HEIGHT8x8, (char*)"Trigger/brk = abort", FONT_6x8, OBD_BLACK, 1);
+  obdWriteString(&g_obd, 0, 0, 7 * HEIGHT8x8, (char*)"enc>start  brk>back", FONT_6x8, OBD_BLACK, 1);
+  if (!motorSweepWaitButton()) {
+    obdFill(&g_obd, OBD_WHITE, 1);
+    return;
+  }
+
+  uint8_t error = motorSweepStart((uint32_t)g_storedVar.activeCar.freqPWM * 100U);
+  if (error != MOTOR_SWEEP_OK) {
+    motorSweepShowError("Cannot start:", error);
+    obdFill(&g_obd, OBD_WHITE, 1);
+    return;
+  }
+
+  /* Progress; the control task stops on its own on trigger, brake or heat */
+  static MotorSweepStatus_type status;
+  motorSweepScreenTitle();
+  obdWriteString(&g_obd, 0, 0, 7 * HEIGHT8x8, (char*)"enc = cancel", FONT_6x8, OBD_BLACK, 1);
+  uint32_t lastDraw_ms = 0;
+  do {
+    if (g_rotaryEncoder.isEncoderButtonClicked()) {
+      motorSweepCancel();
+    }
+    motorSweepGetStatus(&status);
+    if (millis() - lastDraw_ms >= MOTOR_SWEEP_SCREEN_REFRESH_MS) {
+      lastDraw_ms = millis();
+      motorSweepDrawProgress(&status);
+    }
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
+  } while (status.state == MOTOR_SWEEP_RUNNING);
+  while (digitalRead(BUTT_PIN) == BUTTON_PRESSED) vTaskDelay(1);
+
+  if (status.state == MOTOR_SWEEP_ABORTED) {
+    motorSweepShowError("Stopped:", status.error);
+    obdFill(&g_obd, OBD_WHITE, 1);
+    return;
+  }
+
+  static MotorSweepResult_type result;
+  motorSweepAnalyze(&status, &result);
+  if (!result.valid) {
+    motorSweepScreenTitle();
+    obdWriteString(&g_obd, 0, 0, 2 * HEIGHT8x8, (char*)"No usable points:", FONT_6x8, OBD_BLACK, 1);
+    obdWriteString(&g_obd, 0, 0, 3 * HEIGHT8x8, (char*)"motor not connected?", FONT_6x8, OBD_BLACK, 1);
+    obdWriteString(&g_obd, 0, 0, 7 * HEIGHT8x8, (char*)"enc >   (back)", FONT_6x8, OBD_BLACK, 1);
+    motorSweepWaitButton();
+    obdFill(&g_obd, OBD_WHITE, 1);
+    return;
+  }
+
+  g_rotaryEncoder.setAcceleration(MENU_ACCELERATION);
+  setUiEncoderBoundaries(0, 1, false);
+  resetUiEncoder(0);
+  uint8_t page = 0;
+  motorSweepDrawSummary(&result);
+  bool apply = false;
+  while (true) {
+    if (g_rotaryEncoder.encoderChanged()) {
+      uint8_t newPage = (uint8_t)readUiEncoder();
+      if (newPage != page) {
+        page = newPage;
+        if (page == 0) motorSweepDrawSummary(&result);
+        else motorSweepDrawTable(&result);
+      }
+    }
+    if (g_rotaryEncoder.isEncoderButtonClicked()) {
+      apply = true;
+      break;
+    }
+    if (digitalRead(BUTT_PIN) == BUTTON_PRESSED) {
+      while (digitalRead(BUTT_PIN) == BUTTON_PRESSED) vTaskDelay(1);
+      break;
+    }
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
+  }
+
+  motorSweepApplyToCar(&result, &g_storedVar.activeCar);
+  if (apply && result.recommendedFreq_hz > 0) {
+    g_storedVar.activeCar.freqPWM = result.recommendedFreq_hz / 100U;  /* Task1 hands it to the bridge */
+  }
+  saveEEPROM(g_storedVar);
+  obdFill(&g_obd, OBD_WHITE, 1);
+}
@@ -0,0 +1,6 @@
+#ifndef DIAGNOSTICS_MOTOR_SWEEP_H_
+#define DIAGNOSTICS_MOTOR_SWEEP_H_
+
+void showMotorSweep();
+
+#endif  /* DIAGNOSTICS_MOTOR_SWEEP_H_ */
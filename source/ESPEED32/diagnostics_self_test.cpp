@@ -3,6 +3,9 @@
 #include "HAL.h"
 #include "slot_ESC.h"
 #include "connectivity_portal.h"
+#include "trigger_sampler.h"
+#include "input_events.h"
+#include "buzzer.h"
 
 extern OBDISP g_obd;
 extern AiEsp32RotaryEncoder g_rotaryEncoder;
@@ -89,10 +92,9 @@ void showSelfTest() {
   obdWriteString(&g_obd, 0, 0, 3 * HEIGHT8x8, (char*)"Listen for tone.", FONT_6x8, OBD_BLACK, 1);
   obdWriteString(&g_obd, 0, 0, 5 * HEIGHT8x8, (char*)"Enc btn = heard it", FONT_6x8, OBD_BLACK, 1);
   obdWriteString(&g_obd, 0, 0, 6 * HEIGHT8x8, (char*)"Brk btn = nothing", FONT_6x8, OBD_BLACK, 1);
-  sound(NOTE_A, 250);
-  delay(80);
-  sound(NOTE_C, 200);
-  delay(100);
+  static const BuzzerStep_type BUZZER_TEST[] = {{NOTE_A, 250}, {BUZZER_REST, 80}, {NOTE_C, 200}};
+  buzzerPlay(BUZZER_TEST, 3);
+  delay(630);   /* Let the test tones finish before waiting for the answer */
   while (g_rotaryEncoder.isEncoderButtonClicked()) {}
   results[1] = selfTestWaitEnc();
   selfTestResult(results[1]);
@@ -112,7 +114,7 @@ void showSelfTest() {
     if (abs(pos) > abs(encPeak)) encPeak = pos;
     sprintf(line, "Clicks: %+d      ", pos);
     obdWriteString(&g_obd, 0, 0, 6 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
-    vTaskDelay(10);
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
   }
   results[2] = true;
   selfTestResult(true);
@@ -141,11 +143,15 @@ void showSelfTest() {
   selfTestStep(6, TOTAL, "Trigger");
   obdWriteString(&g_obd, 0, 0, 3 * HEIGHT8x8, (char*)"Pull trigger fully.", FONT_6x8, OBD_BLACK, 1);
   obdWriteString(&g_obd, 0, 0, 4 * HEIGHT8x8, (char*)"Hold 1s, release.", FONT_6x8, OBD_BLACK, 1);
-  int16_t trigBase = HAL_ReadTriggerRaw();
+  /* Sensor is owned by the trigger sampler task; read its published samples instead of the bus */
+  TriggerSample_type trigSample = {0, 0, 0};
+  triggerSamplerGetLatest(&trigSample);
+  int16_t trigBase = trigSample.raw;
   int16_t trigPeak = 0;
   uint32_t trigStart_ms = millis();
   while (millis() - trigStart_ms < 15000) {
-    int16_t raw = HAL_ReadTriggerRaw();
+    triggerSamplerGetLatest(&trigSample);
+    int16_t raw = trigSample.raw;
     int16_t delta = abs(raw - trigBase);
     if (delta > trigPeak) trigPeak = delta;
     uint8_t secLeft = (uint8_t)((15000 - (millis() - trigStart_ms)) / 1000);
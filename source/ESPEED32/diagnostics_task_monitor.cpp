@@ -0,0 +1,87 @@
+#include "diagnostics_task_monitor.h"
+#include <Arduino.h>
+#include "HAL.h"
+#include "slot_ESC.h"
+#include "connectivity_portal.h"
+#include "input_events.h"
+#include "task_monitor.h"
+
+extern OBDISP g_obd;
+extern AiEsp32RotaryEncoder g_rotaryEncoder;
+
+/* Load as "100%", " 45%" or "  --" (no run-time stats yet) */
+static void taskMonitorFormatLoad(char* out, size_t outSize, uint16_t load_permille) {
+  if (load_permille == TASK_MONITOR_LOAD_UNKNOWN) {
+    snprintf(out, outSize, "  --");
+  } else {
+    snprintf(out, outSize, "%3u%%", (unsigned)((load_permille + 5U) / 10U));
+  }
+}
+
+static void taskMonitorDrawTask(uint8_t row, const TaskMonitorStats_type* stats, const char* name) {
+  char line[22];
+  char load[8];
+  TaskMonitorTask_type task;
+  if (taskMonitorFindTask(stats, name, &task)) {
+    taskMonitorFormatLoad(load, sizeof(load), task.load_permille);
+    snprintf(line, sizeof(line), "%-8.8s %s %5luB", name, load, (unsigned long)task.stackFree_bytes);
+  } else {
+    snprintf(line, sizeof(line), "%-8.8s    -      - ", name);
+  }
+  obdWriteString(&g_obd, 0, 0, row * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+}
+
+static void taskMonitorDraw(const TaskMonitorStats_type* stats) {
+  char line[22];
+  char load0[8];
+  char load1[8];
+  taskMonitorFormatLoad(load0, sizeof(load0), stats->coreLoad_permille[0]);
+  taskMonitorFormatLoad(load1, sizeof(load1), stats->coreLoad_permille[1]);
+  snprintf(line, sizeof(line), "CPU0 %s  CPU1 %s", load0, load1);
+  obdWriteString(&g_obd, 0, 0, 1 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+  obdWriteString(&g_obd, 0, 0, 2 * HEIGHT8x8, (char*)"task     load  stack", FONT_6x8, OBD_BLACK, 1);
+  taskMonitorDrawTask(3, stats, "Task1");
+  taskMonitorDrawTask(4, stats, "Task2");
+  taskMonitorDrawTask(5, stats, "WiFiTask");
+  snprintf(line, sizeof(line), "Heap %3luk min %3luk ",
+           (unsigned long)(stats->heapFree_bytes / 1024U), (unsigned long)(stats->heapMinFree_bytes / 1024U));
+  obdWriteString(&g_obd, 0, 0, 6 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+  snprintf(line, sizeof(line), "Blk %3luk/%3luk F%2u%% ",
+           (unsigned long)(stats->heapLargest_bytes / 1024U), (unsigned long)(stats->heapMinLargest_bytes / 1024U),
+           (unsigned)stats->heapFragmentation_pct);
+  obdWriteString(&g_obd, 0, 0, 7 * HEIGHT8x8, line, FONT_6x8, OBD_BLACK, 1);
+}
+
+/**
+ * @brief Live task load, stack high-water and heap screen
+ * @details Redraws whenever the task monitor publishes a new snapshot (WiFiTask, once a second).
+ *          Encoder button or brake button returns.
+ */
+void showTaskMonitor() {
+  while (g_rotaryEncoder.isEncoderButtonClicked()) {}
+  while (digitalRead(BUTT_PIN) == BUTTON_PRESSED) vTaskDelay(1);
+
+  obdFill(&g_obd, OBD_WHITE, 1);
+  obdWriteString(&g_obd, 0, centerX8x8("Sys Mon"), 0, (char*)"Sys Mon", FONT_8x8, OBD_BLACK, 1);
+
+  uint32_t shownSamples = UINT32_MAX;
+  while (true) {
+    TaskMonitorStats_type stats;
+    taskMonitorGetStats(&stats);
+    if (stats.samples != shownSamples) {
+      shownSamples = stats.samples;
+      taskMonitorDraw(&stats);
+    }
+
+    if (g_rotaryEncoder.isEncoderButtonClicked()) {
+      break;
+    }
+    if (digitalRead(BUTT_PIN) == BUTTON_PRESSED) {
+      while (digitalRead(BUTT_PIN) == BUTTON_PRESSED) vTaskDelay(1);
+      break;
+    }
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
+  }
+
+  obdFill(&g_obd, OBD_WHITE, 1);
+}
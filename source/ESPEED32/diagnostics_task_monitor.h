@@ -0,0 +1,6 @@
+#ifndef DIAGNOSTICS_TASK_MONITOR_H_
+#define DIAGNOSTICS_TASK_MONITOR_H_
+
+void showTaskMonitor();
+
+#endif  /* DIAGNOSTICS_TASK_MONITOR_H_ */
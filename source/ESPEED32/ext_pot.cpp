@@ -1,7 +1,10 @@
 #include "ext_pot.h"
 #include <Arduino.h>
+#include <WiFi.h>
+#include <string.h>
 #include "slot_ESC.h"
 #include "HAL.h"
+#include "adc_sampler.h"
 
 extern StoredVar_type g_storedVar;
 extern ESC_type g_escVar;
@@ -12,8 +15,22 @@ uint16_t g_extPotTarget[EXT_POT_COUNT] = {
   EXT_POT2_TARGET_DEFAULT
 };
 
-static uint32_t g_extPotFilteredRaw[EXT_POT_COUNT] = {0, 0};
-static bool g_extPotFilterInit[EXT_POT_COUNT] = {false, false};
+typedef struct {
+  uint32_t filtered_x16;   /* [1/16 count] EMA of the raw reading */
+  int32_t accepted;        /* [count] Position after the backlash, valid only with hasPosition */
+  bool filterInit;
+  bool hasPosition;
+  bool radioHeld;          /* Last pass skipped the read (ADC2 with WiFi on) */
+} ExtPotChannel_type;
+
+/* Control task only, except g_extPotResetRequested which Task1 sets */
+static ExtPotChannel_type g_extPotChannels[EXT_POT_COUNT];
+static volatile bool g_extPotResetRequested = true;
+static uint32_t g_extPotLastSample_us = 0;
+static uint32_t g_extPotTuningVersion = 0;
+static uint16_t g_extPotAppliedTarget[EXT_POT_COUNT] = {EXT_POT_TARGET_OFF, EXT_POT_TARGET_OFF};
+static bool g_extPotDirty = true;
+static ExtPotStats_type g_extPotStats = {0, 0, 0};
 
 static uint16_t clampExtPotTarget(uint16_t target) {
   return constrain(target, EXT_POT_TARGET_MIN, EXT_POT_TARGET_MAX);
@@ -23,27 +40,60 @@ static uint16_t readExtPotRaw(uint8_t potIndex) {
   return (potIndex == 0) ? HAL_ReadExternalPot1Raw() : HAL_ReadExternalPot2Raw();
 }
 
-static uint16_t readExtPotFilteredRaw(uint8_t potIndex) {
-  if (potIndex >= EXT_POT_COUNT) return 0;
+static uint8_t extPotPin(uint8_t potIndex) {
+  return (potIndex == 0) ? EXT_POT1_PIN : EXT_POT2_PIN;
+}
+
+static bool extPotPinIsAdc2(uint8_t pin) {
+  return digitalPinToAnalogChannel(pin) >= SOC_ADC_MAX_CHANNEL_NUM;
+}
+
+/**
+ * @brief Read, filter and gate one pot
+ * @return true if the accepted position moved (or was seeded)
+ */
+static bool sampleExtPot(uint8_t potIndex, bool radioOn) {
+  ExtPotChannel_type* ch = &g_extPotChannels[potIndex];
+  uint8_t pin = extPotPin(potIndex);
+  if (radioOn && extPotPinIsAdc2(pin)) {
+    ch->radioHeld = true;
+    g_extPotStats.radioHeld++;
+    return false;
+  }
+  if (ch->radioHeld) {
+    ch->radioHeld = false;
+    ch->filterInit = false;  /* The knob may have moved meanwhile: re-seed, keep the backlash */
+  }
 
   uint16_t raw = readExtPotRaw(potIndex);
-  if (!g_extPotFilterInit[potIndex]) {
-    g_extPotFilteredRaw[potIndex] = raw;
-    g_extPotFilterInit[potIndex] = true;
+  if (adcSamplerCoversPin(pin) || !ch->filterInit) {
+    /* Oversampled by the ADC sampler already, or the first reading */
+    ch->filtered_x16 = (uint32_t)raw << 4;
+    ch->filterInit = true;
   } else {
-    g_extPotFilteredRaw[potIndex] = ((g_extPotFilteredRaw[potIndex] * 7UL) + raw) / 8UL;
+    ch->filtered_x16 = ch->filtered_x16 - (ch->filtered_x16 >> EXT_POT_FILTER_SHIFT) +
+                       (((uint32_t)raw << 4) >> EXT_POT_FILTER_SHIFT);
   }
-  return (uint16_t)g_extPotFilteredRaw[potIndex];
-}
 
-static uint16_t mapExtPotToBrakePct(uint16_t raw) {
-  return (uint16_t)map(raw, 0, ACD_RESOLUTION_STEPS, 0, BRAKE_MAX_VALUE);
+  int32_t pos = (int32_t)((ch->filtered_x16 + 8U) >> 4);
+  int32_t accepted = ch->accepted;
+  if (!ch->hasPosition) {
+    accepted = constrain(pos, EXT_POT_HYSTERESIS_RAW, ACD_RESOLUTION_STEPS - EXT_POT_HYSTERESIS_RAW);
+  } else if (pos > accepted + EXT_POT_HYSTERESIS_RAW) {
+    accepted = pos - EXT_POT_HYSTERESIS_RAW;
+  } else if (pos < accepted - EXT_POT_HYSTERESIS_RAW) {
+    accepted = pos + EXT_POT_HYSTERESIS_RAW;
+  }
+  bool moved = !ch->hasPosition || accepted != ch->accepted;
+  ch->accepted = accepted;
+  ch->hasPosition = true;
+  return moved;
 }
 
-static uint16_t mapExtPotToSensiRaw(uint16_t raw) {
-  uint16_t maxSensiRaw = min((uint16_t)MIN_SPEED_MAX_VALUE,
-                             (uint16_t)(g_storedVar.carParam[g_carSel].maxSpeed * SENSI_SCALE));
-  return (uint16_t)map(raw, 0, ACD_RESOLUTION_STEPS, 0, maxSensiRaw);
+/* Accepted positions span [HYSTERESIS, STEPS - HYSTERESIS]: map that range to the full output */
+static uint16_t mapExtPotPosition(int32_t accepted, uint16_t maxOut) {
+  return (uint16_t)constrain(map(accepted, EXT_POT_HYSTERESIS_RAW, ACD_RESOLUTION_STEPS - EXT_POT_HYSTERESIS_RAW, 0, maxOut),
+                             0, (long)maxOut);
 }
 
 uint16_t getExtPotTarget(uint8_t potIndex) {
@@ -108,32 +158,83 @@ bool isExtPotSensiTarget() {
   return false;
 }
 
+/**
+ * @brief Forget the pot positions (target change, reset); applied by the control task on its next tick
+ */
 void resetExtPotFilter() {
+  g_extPotResetRequested = true;
+}
+
+/**
+ * @brief Sample the pots when due and publish g_escVar.effectiveBrake_pct/effectiveSensi_raw on change (control task)
+ * @param tuning This tick's car parameters (see activeTuningAcquire())
+ */
+void updateExtPotRuntimeValues(const ActiveTuning_type* tuning) {
+  uint32_t now_us = micros();
+  bool sampleDue = (now_us - g_extPotLastSample_us) >= EXT_POT_SAMPLE_INTERVAL_US;
+  if (g_extPotResetRequested) {
+    g_extPotResetRequested = false;
+    memset(g_extPotChannels, 0, sizeof(g_extPotChannels));
+    g_extPotDirty = true;
+    sampleDue = true;
+  }
   for (uint8_t i = 0; i < EXT_POT_COUNT; i++) {
-    g_extPotFilterInit[i] = false;
-    g_extPotFilteredRaw[i] = 0;
+    if (g_extPotAppliedTarget[i] != g_extPotTarget[i]) {
+      g_extPotAppliedTarget[i] = g_extPotTarget[i];
+      g_extPotDirty = true;
+    }
+  }
+  if (tuning->version != g_extPotTuningVersion) {
+    g_extPotTuningVersion = tuning->version;
+    g_extPotDirty = true;  /* Stored brake/SENSI or maxSpeed (the SENSI pot's range) changed */
   }
-}
 
-void updateExtPotRuntimeValues() {
-  g_escVar.effectiveBrake_pct = g_storedVar.carParam[g_carSel].brake;
-  g_escVar.effectiveSensi_raw = g_storedVar.carParam[g_carSel].minSpeed;
+  if (sampleDue && isExtPotEnabled()) {
+    g_extPotLastSample_us = now_us;
+    g_extPotStats.samples++;
+    bool radioOn = (WiFi.getMode() != WIFI_OFF);
+    for (uint8_t i = 0; i < EXT_POT_COUNT; i++) {
+      if (g_extPotAppliedTarget[i] != EXT_POT_TARGET_OFF && sampleExtPot(i, radioOn)) {
+        g_extPotDirty = true;
+      }
+    }
+  }
+  if (!g_extPotDirty) {
+    return;
+  }
+  g_extPotDirty = false;
 
+  uint16_t brake = tuning->brake;
+  uint16_t sensi = tuning->minSpeed;
+  uint16_t maxSensiRaw = min((uint16_t)MIN_SPEED_MAX_VALUE, (uint16_t)(tuning->maxSpeed * SENSI_SCALE));
   for (uint8_t i = 0; i < EXT_POT_COUNT; i++) {
-    uint16_t filteredRaw = readExtPotFilteredRaw(i);
-    if (g_extPotTarget[i] == EXT_POT_TARGET_BRAKE) {
-      g_escVar.effectiveBrake_pct = constrain(mapExtPotToBrakePct(filteredRaw), 0, BRAKE_MAX_VALUE);
-    } else if (g_extPotTarget[i] == EXT_POT_TARGET_SENSI) {
-      g_escVar.effectiveSensi_raw = constrain(mapExtPotToSensiRaw(filteredRaw), 0,
-                                              min((uint16_t)MIN_SPEED_MAX_VALUE, (uint16_t)(g_storedVar.carParam[g_carSel].maxSpeed * SENSI_SCALE)));
+    const ExtPotChannel_type* ch = &g_extPotChannels[i];
+    if (!ch->hasPosition) {
+      continue;  /* No reading yet (ADC2 under WiFi): keep the stored setting */
     }
+    if (g_extPotAppliedTarget[i] == EXT_POT_TARGET_BRAKE) {
+      brake = mapExtPotPosition(ch->accepted, BRAKE_MAX_VALUE);
+    } else if (g_extPotAppliedTarget[i] == EXT_POT_TARGET_SENSI) {
+      sensi = mapExtPotPosition(ch->accepted, maxSensiRaw);
+    }
+  }
+  if (brake != g_escVar.effectiveBrake_pct || sensi != g_escVar.effectiveSensi_raw) {
+    g_escVar.effectiveBrake_pct = brake;
+    g_escVar.effectiveSensi_raw = sensi;
+    g_extPotStats.publishes++;
   }
 }
 
 uint16_t getEffectiveBrakePct() {
-  return isExtPotBrakeTarget() ? g_escVar.effectiveBrake_pct : g_storedVar.carParam[g_carSel].brake;
+  return isExtPotBrakeTarget() ? g_escVar.effectiveBrake_pct : g_storedVar.activeCar.brake;
 }
 
 uint16_t getEffectiveSensiRaw() {
-  return isExtPotSensiTarget() ? g_escVar.effectiveSensi_raw : g_storedVar.carParam[g_carSel].minSpeed;
+  return isExtPotSensiTarget() ? g_escVar.effectiveSensi_raw : g_storedVar.activeCar.minSpeed;
+}
+
+void extPotGetStats(ExtPotStats_type* outStats) {
+  if (outStats != nullptr) {
+    *outStats = g_extPotStats;
+  }
 }
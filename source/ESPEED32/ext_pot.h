@@ -2,6 +2,33 @@
 #define EXT_POT_H_
 
 #include <stdint.h>
+#include "active_tuning.h"
+
+/* External pots as a change-driven producer on the control task.
+ * A pot is sampled every EXT_POT_SAMPLE_INTERVAL_US (not every control tick), filtered, and
+ * passed through a backlash of EXT_POT_HYSTERESIS_RAW counts, so ADC noise never moves the
+ * accepted position. Effective brake/SENSI are re-mapped and written to g_escVar only when the
+ * accepted position or the car's tuning changed; dependants keyed on them (throttle table)
+ * therefore rebuild only on a real knob move. The backlash range is stretched back to the
+ * full output, so both ends stay reachable.
+ * ADC2 pots (EXT_POT2_PIN) cannot be read while WiFi owns ADC2: they hold their last accepted
+ * position (or the stored setting before the first reading) and re-seed when the radio is off. */
+#ifndef EXT_POT_SAMPLE_INTERVAL_US
+#define EXT_POT_SAMPLE_INTERVAL_US  2000U
+#endif
+#ifndef EXT_POT_HYSTERESIS_RAW
+#define EXT_POT_HYSTERESIS_RAW      16     /* [ADC counts] Backlash; below one SENSI step (~22 counts) */
+#endif
+#define EXT_POT_FILTER_SHIFT        2      /* EMA weight 1/4 per sample (~8 ms) for pots not oversampled by adc_sampler */
+
+/**
+ * @brief Producer counters
+ */
+typedef struct {
+  uint32_t samples;      /* Sampling passes */
+  uint32_t publishes;    /* Changes of the effective brake/SENSI */
+  uint32_t radioHeld;    /* ADC2 reads skipped because WiFi was on */
+} ExtPotStats_type;
 
 extern uint16_t g_extPotTarget[];
 
@@ -14,8 +41,9 @@ void setExtPotTarget(uint8_t potIndex, uint16_t target);
 void cycleExtPotTarget(uint8_t potIndex);
 void sanitizeExtPotTargets(int8_t preferredPotIndex);
 void resetExtPotFilter();
-void updateExtPotRuntimeValues();
+void updateExtPotRuntimeValues(const ActiveTuning_type* tuning);
 uint16_t getEffectiveBrakePct();
 uint16_t getEffectiveSensiRaw();
+void extPotGetStats(ExtPotStats_type* outStats);
 
 #endif  /* EXT_POT_H_ */
@@ -0,0 +1,267 @@
+#include "gzip_stream.h"
+#include <string.h>
+#include <esp_rom_crc.h>
+
+#define GZIP_MIN_MATCH      3U
+#define GZIP_MAX_MATCH      258U
+#define GZIP_BUF_SIZE       (2U * GZIP_STREAM_WINDOW)
+#define GZIP_STEP_MAX_BYTES 8U    /* One symbol: <= 31 bits plus the partial byte */
+#define GZIP_FINISH_BYTES   24U   /* EOB, final empty block, padding and the 8-byte trailer */
+
+static const uint16_t GZIP_LEN_BASE[29] = {
+  3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+  35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t GZIP_LEN_EXTRA[29] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+  3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const uint16_t GZIP_DIST_BASE[30] = {
+  1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+  257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const uint8_t GZIP_DIST_EXTRA[30] = {
+  0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+  7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+/**
+ * @brief Append bits LSB first (deflate bit order)
+ */
+static void gzipPutBits(GzipStream_type* z, uint32_t value, uint8_t count) {
+  z->bitBuf |= value << z->bitCount;
+  z->bitCount += count;
+  while (z->bitCount >= 8U) {
+    z->out[z->outLen++] = (uint8_t)z->bitBuf;
+    z->bitBuf >>= 8;
+    z->bitCount -= 8U;
+  }
+}
+
+/**
+ * @brief Append a Huffman code, which deflate stores MSB first
+ */
+static void gzipPutCode(GzipStream_type* z, uint32_t code, uint8_t count) {
+  uint32_t reversed = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    reversed = (reversed << 1) | ((code >> i) & 1U);
+  }
+  gzipPutBits(z, reversed, count);
+}
+
+/**
+ * @brief Fixed Huffman literal/length symbol (RFC 1951 3.2.6)
+ */
+static void gzipPutSymbol(GzipStream_type* z, uint16_t symbol) {
+  if (symbol < 144U) {
+    gzipPutCode(z, 0x30U + symbol, 8);
+  } else if (symbol < 256U) {
+    gzipPutCode(z, 0x190U + (symbol - 144U), 9);
+  } else if (symbol < 280U) {
+    gzipPutCode(z, symbol - 256U, 7);
+  } else {
+    gzipPutCode(z, 0xC0U + (symbol - 280U), 8);
+  }
+}
+
+static void gzipPutMatch(GzipStream_type* z, uint32_t length, uint32_t distance) {
+  uint8_t code = 28;
+  while (GZIP_LEN_BASE[code] > length) code--;
+  gzipPutSymbol(z, (uint16_t)(257U + code));
+  gzipPutBits(z, length - GZIP_LEN_BASE[code], GZIP_LEN_EXTRA[code]);
+
+  code = 29;
+  while (GZIP_DIST_BASE[code] > distance) code--;
+  gzipPutCode(z, code, 5);
+  gzipPutBits(z, distance - GZIP_DIST_BASE[code], GZIP_DIST_EXTRA[code]);
+}
+
+static inline uint32_t gzipHash(const uint8_t* p) {
+  uint32_t v = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16);
+  return (v * 2654435761U) >> (32U - GZIP_STREAM_HASH_BITS);
+}
+
+/**
+ * @brief Link buf[at] into its hash chain (needs 3 bytes from at)
+ * @return Previous chain head as position + 1, 0 = none
+ */
+static inline uint16_t gzipInsert(GzipStream_type* z, uint32_t at) {
+  uint32_t h = gzipHash(&z->buf[at]);
+  uint16_t previous = z->head[h];
+  z->prev[at] = previous;
+  z->head[h] = (uint16_t)(at + 1U);
+  return previous;
+}
+
+/**
+ * @brief Drop the oldest window of history so more input fits
+ */
+static void gzipSlide(GzipStream_type* z) {
+  memmove(z->buf, z->buf + GZIP_STREAM_WINDOW, z->fill - GZIP_STREAM_WINDOW);
+  z->fill -= GZIP_STREAM_WINDOW;
+  z->pos -= GZIP_STREAM_WINDOW;
+  for (uint32_t i = 0; i < (1U << GZIP_STREAM_HASH_BITS); i++) {
+    z->head[i] = (z->head[i] > GZIP_STREAM_WINDOW) ? (uint16_t)(z->head[i] - GZIP_STREAM_WINDOW) : 0;
+  }
+  for (uint32_t i = 0; i < GZIP_STREAM_WINDOW; i++) {
+    uint16_t p = z->prev[i + GZIP_STREAM_WINDOW];
+    z->prev[i] = (p > GZIP_STREAM_WINDOW) ? (uint16_t)(p - GZIP_STREAM_WINDOW) : 0;
+  }
+}
+
+/**
+ * @brief Encode buffered input while the output buffer has room
+ * @details Keeps GZIP_MAX_MATCH bytes of lookahead until the source has ended, so a match
+ *          is never cut short by a chunk boundary.
+ */
+static void gzipCompress(GzipStream_type* z) {
+  while (z->outLen + GZIP_STEP_MAX_BYTES <= GZIP_STREAM_OUT_SIZE) {
+    uint32_t avail = z->fill - z->pos;
+    if (avail == 0 || (avail < GZIP_MAX_MATCH && !z->finishing)) {
+      return;
+    }
+    uint32_t bestLen = 0;
+    uint32_t bestDist = 0;
+    if (avail >= GZIP_MIN_MATCH) {
+      uint32_t maxLen = (avail < GZIP_MAX_MATCH) ? avail : GZIP_MAX_MATCH;
+      uint16_t candidate = gzipInsert(z, z->pos);
+      for (uint32_t chain = 0; candidate != 0 && chain < GZIP_STREAM_CHAIN_MAX; chain++) {
+        uint32_t from = candidate - 1U;
+        const uint8_t* a = &z->buf[from];
+        const uint8_t* b = &z->buf[z->pos];
+        if (a[bestLen] == b[bestLen]) {
+          uint32_t len = 0;
+          while (len < maxLen && a[len] == b[len]) len++;
+          if (len > bestLen) {
+            bestLen = len;
+            bestDist = z->pos - from;
+            if (len == maxLen) break;
+          }
+        }
+        candidate = z->prev[from];
+      }
+    }
+    if (bestLen >= GZIP_MIN_MATCH) {
+      gzipPutMatch(z, bestLen, bestDist);
+      for (uint32_t i = 1; i < bestLen; i++) {
+        if (z->pos + i + GZIP_MIN_MATCH <= z->fill) {
+          gzipInsert(z, z->pos + i);
+        }
+      }
+      z->pos += bestLen;
+    } else {
+      gzipPutSymbol(z, z->buf[z->pos]);
+      z->pos++;
+    }
+  }
+}
+
+/**
+ * @brief Start a gzip member: header and the first (open) fixed-Huffman block
+ */
+void gzipStreamBegin(GzipStream_type* z) {
+  memset(z, 0, sizeof(*z));
+  static const uint8_t header[10] = {0x1F, 0x8B, 8, 0, 0, 0, 0, 0, 0, 0xFF};  /* deflate, no mtime, OS unknown */
+  memcpy(z->out, header, sizeof(header));
+  z->outLen = sizeof(header);
+  gzipPutBits(z, 0, 1);  /* BFINAL = 0: the final block is only known at the end */
+  gzipPutBits(z, 1, 2);  /* BTYPE = fixed Huffman */
+}
+
+/**
+ * @brief Feed plain text
+ * @return Bytes consumed; less than len when output must be read first
+ */
+size_t gzipStreamWrite(GzipStream_type* z, const uint8_t* data, size_t len) {
+  size_t used = 0;
+  gzipCompress(z);
+  while (used < len && !z->finishing) {
+    if (z->fill == GZIP_BUF_SIZE) {
+      if (z->pos < GZIP_STREAM_WINDOW) {
+        break;  /* Lookahead still queued behind a full output buffer */
+      }
+      gzipSlide(z);
+    }
+    size_t n = GZIP_BUF_SIZE - z->fill;
+    if (n > len - used) n = len - used;
+    memcpy(&z->buf[z->fill], data + used, n);
+    z->crc = esp_rom_crc32_le(z->crc, data + used, n);
+    z->plainBytes += (uint32_t)n;
+    z->fill += (uint32_t)n;
+    used += n;
+    gzipCompress(z);
+  }
+  return used;
+}
+
+/**
+ * @brief End of input: encode the lookahead, close the blocks and append the trailer
+ * @details Resumable: returns false while the output buffer is too full, call again after
+ *          gzipStreamRead().
+ * @return true once the whole member is in the output buffer
+ */
+bool gzipStreamFinish(GzipStream_type* z) {
+  if (z->trailerDone) {
+    return true;
+  }
+  z->finishing = true;
+  gzipCompress(z);
+  if (z->pos < z->fill || z->outLen + GZIP_FINISH_BYTES > GZIP_STREAM_OUT_SIZE) {
+    return false;
+  }
+  gzipPutSymbol(z, 256);   /* End of the open block */
+  gzipPutBits(z, 1, 1);    /* Empty final block */
+  gzipPutBits(z, 1, 2);
+  gzipPutSymbol(z, 256);
+  if (z->bitCount > 0) {
+    gzipPutBits(z, 0, (uint8_t)(8U - z->bitCount));
+  }
+  for (uint8_t i = 0; i < 4; i++) z->out[z->outLen++] = (uint8_t)(z->crc >> (8U * i));
+  for (uint8_t i = 0; i < 4; i++) z->out[z->outLen++] = (uint8_t)(z->plainBytes >> (8U * i));
+  z->trailerDone = true;
+  return true;
+}
+
+/**
+ * @brief Take compressed bytes out of the output buffer
+ */
+size_t gzipStreamRead(GzipStream_type* z, uint8_t* dst, size_t cap) {
+  size_t n = z->outLen - z->outRead;
+  if (n > cap) n = cap;
+  memcpy(dst, &z->out[z->outRead], n);
+  z->outRead += (uint16_t)n;
+  if (z->outRead == z->outLen) {
+    z->outLen = 0;
+    z->outRead = 0;
+  }
+  return n;
+}
+
+/**
+ * @brief Fill dst with compressed bytes, pulling plain text from source as needed
+ * @details Drop-in body filler around another one (see PortalTransferFill_fn).
+ * @return Bytes written, 0 once the member has been handed out completely
+ */
+size_t gzipStreamPump(GzipStream_type* z, GzipStreamSource_fn source, void* ctx, uint8_t* dst, size_t cap) {
+  size_t used = 0;
+  while (used < cap) {
+    used += gzipStreamRead(z, dst + used, cap - used);
+    if (used == cap || (z->trailerDone && z->outLen == 0)) {
+      break;
+    }
+    if (z->finishing) {
+      gzipStreamFinish(z);
+      continue;
+    }
+    if (z->inPos == z->inLen) {
+      z->inLen = (uint16_t)source(ctx, z->in, sizeof(z->in));
+      z->inPos = 0;
+      if (z->inLen == 0) {
+        gzipStreamFinish(z);
+        continue;
+      }
+    }
+    z->inPos += (uint16_t)gzipStreamWrite(z, &z->in[z->inPos], z->inLen - z->inPos);
+  }
+  return used;
+}
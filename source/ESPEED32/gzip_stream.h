@@ -0,0 +1,59 @@
+#ifndef GZIP_STREAM_H_
+#define GZIP_STREAM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Streaming gzip (RFC 1952 / deflate RFC 1951) for text exports, sized for ESP32 RAM.
+ * LZ77 over a GZIP_STREAM_WINDOW history with a short hash chain, written as one
+ * run of fixed-Huffman blocks (no code tables to build or send). Telemetry CSV/JSON rows
+ * repeat their field layout every ~100 bytes, so a small window already finds most of
+ * the redundancy; the state is ~15 KB, allocated only for a compressed export.
+ * gzipStreamPump() sits between a body producer and its sink: it pulls plain text from
+ * the source on demand and hands back compressed bytes, never holding the whole file. */
+#ifndef GZIP_STREAM_WINDOW
+#define GZIP_STREAM_WINDOW      2048U   /* Power of two; matches reach back up to twice this */
+#endif
+#ifndef GZIP_STREAM_HASH_BITS
+#define GZIP_STREAM_HASH_BITS   10U
+#endif
+#ifndef GZIP_STREAM_CHAIN_MAX
+#define GZIP_STREAM_CHAIN_MAX   8U      /* Candidates tried per position */
+#endif
+#define GZIP_STREAM_OUT_SIZE    512U    /* Compressed bytes staged between pump calls */
+#define GZIP_STREAM_IN_SIZE     512U    /* Plain bytes pulled from the source per call */
+
+/**
+ * @brief Plain text producer, same contract as PortalTransferFill_fn
+ * @return Bytes written to buf (<= cap), 0 when the body is complete
+ */
+typedef size_t (*GzipStreamSource_fn)(void* ctx, uint8_t* buf, size_t cap);
+
+typedef struct {
+  uint8_t buf[2U * GZIP_STREAM_WINDOW];          /* History + lookahead */
+  uint16_t head[1U << GZIP_STREAM_HASH_BITS];    /* Latest buf position + 1 per hash, 0 = none */
+  uint16_t prev[2U * GZIP_STREAM_WINDOW];        /* Previous position + 1 with the same hash */
+  uint32_t fill;                                 /* Bytes in buf */
+  uint32_t pos;                                  /* Next byte to encode */
+  uint32_t bitBuf;
+  uint8_t bitCount;
+  uint8_t out[GZIP_STREAM_OUT_SIZE];
+  uint16_t outLen;
+  uint16_t outRead;
+  uint8_t in[GZIP_STREAM_IN_SIZE];
+  uint16_t inLen;
+  uint16_t inPos;
+  uint32_t crc;                                  /* CRC-32 of the plain text so far */
+  uint32_t plainBytes;
+  bool finishing;                                /* Source ended: encode the lookahead too */
+  bool trailerDone;
+} GzipStream_type;
+
+void gzipStreamBegin(GzipStream_type* z);
+size_t gzipStreamWrite(GzipStream_type* z, const uint8_t* data, size_t len);
+bool gzipStreamFinish(GzipStream_type* z);
+size_t gzipStreamRead(GzipStream_type* z, uint8_t* dst, size_t cap);
+size_t gzipStreamPump(GzipStream_type* z, GzipStreamSource_fn source, void* ctx, uint8_t* dst, size_t cap);
+
+#endif  /* GZIP_STREAM_H_ */
@@ -2,6 +2,8 @@
 /*                                                   Includes                                                        */
 /*********************************************************************************************************************/
 #include "half_bridge.h"
+#include "current_sampler.h"
+#include "bemf_sampler.h"
 
 using namespace btn99x0;
 
@@ -29,6 +31,16 @@ hw_conf_t hwConf = {
 /* Half-bridge driver instance */
 HalfBridge halfBridge(icVariant, ioPins, hwConf);
 
+/* PWM frequency handoff: any task requests, the control task applies */
+static volatile uint32_t g_pwmFreqRequested_hz = 0;
+static uint32_t g_pwmFreqApplied_hz = 0;   /* Control task only */
+
+/* Output ownership: the control task (core 1) and the deadline monitor ISR (core 0) both drive
+ * the bridge, so every duty write and the sampler duty state it updates go through this lock.
+ * While the safe output is latched, control task writes are dropped until it is released. */
+static portMUX_TYPE g_outputMux = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool g_outputSafeLatched = false;
+
 /*********************************************************************************************************************/
 /*                                            Function Implementations                                              */
 /*********************************************************************************************************************/
@@ -50,7 +62,111 @@ void HalfBridge_Setup() {
  * @param drag_pct Drag brake percentage [0-100%]
  */
 void HalfBridge_SetPwmDrag(uint8_t duty_pct, uint8_t drag_pct) {
-  halfBridge.set_pwm_drag(duty_pct, drag_pct);
+  HalfBridge_SetPwmDragPermille((uint16_t)duty_pct * 10, (uint16_t)drag_pct * 10);
+}
+
+/* Bridge and sampler duty update; caller holds g_outputMux */
+static void HalfBridge_WriteOutputLocked(uint16_t duty_permille, uint16_t drag_permille) {
+  halfBridge.set_pwm_drag_permille(duty_permille, drag_permille);
+  currentSamplerSetDuty(duty_permille);
+  bemfSamplerSetDuty(duty_permille, drag_permille);
+}
+
+/**
+ * @brief Set PWM duty cycle with drag brake at full output resolution
+ * @details Task context. Dropped while the safe output is latched (HalfBridge_LatchSafeOutputFromISR()).
+ * @param duty_permille Motor duty cycle [0-1000 permille]
+ * @param drag_permille Drag brake [0-1000 permille]
+ * @return true if the output was written
+ */
+bool HalfBridge_SetPwmDragPermille(uint16_t duty_permille, uint16_t drag_permille) {
+  bool written = false;
+  portENTER_CRITICAL(&g_outputMux);
+  if (!g_outputSafeLatched) {
+    HalfBridge_WriteOutputLocked(duty_permille, drag_permille);
+    written = true;
+  }
+  portEXIT_CRITICAL(&g_outputMux);
+  return written;
+}
+
+/**
+ * @brief Force the safe output (no drive, drag only) and latch it against task writes
+ * @details Interrupt context (deadline monitor). The check against a task write in progress
+ *          and the write itself are one step under g_outputMux, so a task write can neither
+ *          interleave with it nor overwrite it afterwards.
+ * @param drag_permille Drag brake while latched [0-1000 permille]
+ */
+void HalfBridge_LatchSafeOutputFromISR(uint16_t drag_permille) {
+  portENTER_CRITICAL_ISR(&g_outputMux);
+  g_outputSafeLatched = true;
+  HalfBridge_WriteOutputLocked(0, drag_permille);
+  portEXIT_CRITICAL_ISR(&g_outputMux);
+}
+
+/**
+ * @brief Hand the output back to the control task (after an on-time cycle)
+ */
+void HalfBridge_ReleaseSafeOutput() {
+  portENTER_CRITICAL(&g_outputMux);
+  g_outputSafeLatched = false;
+  portEXIT_CRITICAL(&g_outputMux);
+}
+
+/**
+ * @return true while the safe output is latched
+ */
+bool HalfBridge_SafeOutputLatched() {
+  return g_outputSafeLatched;
+}
+
+/**
+ * @brief Ask for a new motor PWM frequency
+ * @details Safe from any task; the change is made by the control task on its next tick
+ *          (HalfBridge_ServicePwmFrequency()), never while it is writing the duty.
+ * @param freq_hz PWM frequency [Hz]
+ */
+void HalfBridge_RequestPwmFrequency(uint32_t freq_hz) {
+  g_pwmFreqRequested_hz = freq_hz;
+}
+
+/**
+ * @brief Apply a pending PWM frequency request (control task, once per tick)
+ * @details Retimes the shared LEDC timer in place, so IN and INH stay phase-aligned and the
+ *          switch lands on a period boundary, then updates the samplers' period.
+ * @return true if the frequency changed
+ */
+bool HalfBridge_ServicePwmFrequency() {
+  uint32_t freq_hz = g_pwmFreqRequested_hz;
+  if (freq_hz == 0 || freq_hz == g_pwmFreqApplied_hz) {
+    return false;
+  }
+  HAL_SetMotorPwmFrequency(freq_hz);
+  g_pwmFreqApplied_hz = freq_hz;
+  currentSamplerSetPwmFrequency(freq_hz);
+  bemfSamplerSetPwmFrequency(freq_hz);
+  return true;
+}
+
+/**
+ * @brief Switch the outputs to the BTN99x0 temperature sense condition (INH low, IN high)
+ * @details Control task only. Takes effect at the next PWM period; the bridge floats until the
+ *          next HalfBridge_SetPwmDragPermille(). Dropped while the safe output is latched.
+ */
+void HalfBridge_SetTemperatureSensePattern() {
+  portENTER_CRITICAL(&g_outputMux);
+  if (!g_outputSafeLatched) {
+    halfBridge.set_pwm_temperature_sense();
+  }
+  portEXIT_CRITICAL(&g_outputMux);
+}
+
+/**
+ * @brief Convert an IS reading taken under the temperature sense pattern
+ * @return [°C] Junction temperature
+ */
+int16_t HalfBridge_SenseRawToCelsius(uint16_t adcRaw) {
+  return (int16_t)lround(halfBridge.get_temperature_in_kelvin_from_adc(adcRaw) - 273.15);
 }
 
 /**
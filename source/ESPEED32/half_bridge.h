@@ -12,6 +12,14 @@
 /*********************************************************************************************************************/
 void HalfBridge_Setup();
 void HalfBridge_SetPwmDrag(uint8_t duty_pct, uint8_t drag_pct);
+bool HalfBridge_SetPwmDragPermille(uint16_t duty_permille, uint16_t drag_permille);
+void HalfBridge_LatchSafeOutputFromISR(uint16_t drag_permille);
+void HalfBridge_ReleaseSafeOutput();
+bool HalfBridge_SafeOutputLatched();
+void HalfBridge_SetTemperatureSensePattern();
+int16_t HalfBridge_SenseRawToCelsius(uint16_t adcRaw);
+void HalfBridge_RequestPwmFrequency(uint32_t freq_hz);
+bool HalfBridge_ServicePwmFrequency();
 void HalfBridge_Enable();
 void HalfBridge_TestMotor();
 uint16_t HalfBridge_GetDiagnosis();
@@ -0,0 +1,209 @@
+#include "input_events.h"
+#include "HAL.h"
+#include "slot_ESC.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+
+typedef struct {
+  uint8_t source;         /* InputSource_enum */
+  uint32_t timeMs;
+} InputRawEdge_type;
+
+typedef struct {
+  uint8_t pin;
+  bool pressed;           /* Debounced level */
+  bool settling;          /* Edges seen, waiting for INPUT_DEBOUNCE_MS of quiet */
+  bool longSent;
+  bool swallow;           /* Press began before a flush: report nothing until released */
+  uint32_t firstEdgeMs;
+  uint32_t lastEdgeMs;
+  uint32_t pressStartMs;
+} InputButton_type;
+
+static QueueHandle_t g_inputRawQueue = NULL;
+static volatile bool g_inputRawPending[INPUT_SOURCE_COUNT];
+static InputButton_type g_inputButtons[INPUT_SOURCE_COUNT];   /* Index 0 (encoder) unused */
+
+static InputEvent_type g_inputFifo[INPUT_EVENT_FIFO_LEN];
+static uint8_t g_inputFifoHead = 0;
+static uint8_t g_inputFifoCount = 0;
+
+/* One queued edge per source at a time: a bouncing contact or a fast spin costs a single
+ * queue slot until the consumer picks it up. */
+static void IRAM_ATTR inputPostFromISR(uint8_t source) {
+  if (g_inputRawQueue == NULL || g_inputRawPending[source]) return;
+  g_inputRawPending[source] = true;
+  InputRawEdge_type edge = { source, (uint32_t)millis() };   /* millis() is ISR safe on ESP32 */
+  BaseType_t woken = pdFALSE;
+  if (xQueueSendFromISR(g_inputRawQueue, &edge, &woken) != pdTRUE) {
+    g_inputRawPending[source] = false;
+  }
+  if (woken == pdTRUE) portYIELD_FROM_ISR();
+}
+
+void IRAM_ATTR inputEventsEncoderISR() {
+  inputPostFromISR(INPUT_SOURCE_ENCODER);
+}
+
+static void IRAM_ATTR inputEncButtonISR() {
+  inputPostFromISR(INPUT_SOURCE_ENC_BUTTON);
+}
+
+static void IRAM_ATTR inputBrakeButtonISR() {
+  inputPostFromISR(INPUT_SOURCE_BRAKE_BUTTON);
+}
+
+static void inputPush(uint8_t type, uint8_t source, uint32_t timeMs, uint32_t heldMs) {
+  if (g_inputFifoCount == INPUT_EVENT_FIFO_LEN) {
+    g_inputFifoHead = (g_inputFifoHead + 1) % INPUT_EVENT_FIFO_LEN;
+    g_inputFifoCount--;
+  }
+  InputEvent_type* ev = &g_inputFifo[(g_inputFifoHead + g_inputFifoCount) % INPUT_EVENT_FIFO_LEN];
+  ev->type = type;
+  ev->source = source;
+  ev->heldMs = (uint16_t)min(heldMs, (uint32_t)UINT16_MAX);
+  ev->timeMs = timeMs;
+  g_inputFifoCount++;
+}
+
+static void inputButtonResync(InputButton_type* b) {
+  b->pressed = (digitalRead(b->pin) == BUTTON_PRESSED);
+  b->settling = false;
+  b->longSent = false;
+  b->swallow = b->pressed;
+  b->pressStartMs = millis();
+}
+
+/**
+ * @brief Set up the raw edge queue and the button interrupts
+ * @note Call after the encoder has been set up (its ISR calls inputEventsEncoderISR()).
+ */
+void inputEventsBegin() {
+  if (g_inputRawQueue == NULL) {
+    g_inputRawQueue = xQueueCreate(INPUT_RAW_QUEUE_LEN, sizeof(InputRawEdge_type));
+  }
+  g_inputButtons[INPUT_SOURCE_ENC_BUTTON].pin = ENCODER_BUTTON_PIN;
+  g_inputButtons[INPUT_SOURCE_BRAKE_BUTTON].pin = BUTT_PIN;
+  inputButtonResync(&g_inputButtons[INPUT_SOURCE_ENC_BUTTON]);
+  inputButtonResync(&g_inputButtons[INPUT_SOURCE_BRAKE_BUTTON]);
+  attachInterrupt(digitalPinToInterrupt(ENCODER_BUTTON_PIN), inputEncButtonISR, CHANGE);
+  attachInterrupt(digitalPinToInterrupt(BUTT_PIN), inputBrakeButtonISR, CHANGE);
+}
+
+static void inputHandleRaw(const InputRawEdge_type* edge) {
+  uint32_t edgeMs = edge->timeMs;
+  g_inputRawPending[edge->source] = false;
+
+  if (edge->source == INPUT_SOURCE_ENCODER) {
+    inputPush(INPUT_EVENT_ENCODER, INPUT_SOURCE_ENCODER, edgeMs, 0);
+    return;
+  }
+  InputButton_type* b = &g_inputButtons[edge->source];
+  if (!b->settling) {
+    b->settling = true;
+    b->firstEdgeMs = edgeMs;
+  }
+  b->lastEdgeMs = millis();
+}
+
+/* Debounce settle and long-press checks; returns ms until the next deadline (or UINT32_MAX) */
+static uint32_t inputServiceButtons(uint32_t now) {
+  uint32_t next = UINT32_MAX;
+  for (uint8_t s = INPUT_SOURCE_ENC_BUTTON; s < INPUT_SOURCE_COUNT; s++) {
+    InputButton_type* b = &g_inputButtons[s];
+
+    if (b->settling) {
+      uint32_t quiet = now - b->lastEdgeMs;
+      if (quiet < INPUT_DEBOUNCE_MS) {
+        next = min(next, (uint32_t)(INPUT_DEBOUNCE_MS - quiet));
+      } else {
+        b->settling = false;
+        bool pressed = (digitalRead(b->pin) == BUTTON_PRESSED);
+        if (pressed && !b->pressed) {
+          b->pressed = true;
+          b->longSent = false;
+          b->swallow = false;
+          b->pressStartMs = b->firstEdgeMs;
+          inputPush(INPUT_EVENT_PRESS, s, b->firstEdgeMs, 0);
+        } else if (!pressed && b->pressed) {
+          uint32_t held = b->firstEdgeMs - b->pressStartMs;
+          b->pressed = false;
+          if (!b->swallow) {
+            inputPush(INPUT_EVENT_RELEASE, s, b->firstEdgeMs, held);
+            if (!b->longSent && held >= BUTTON_CLICK_MIN_MS) {
+              inputPush(INPUT_EVENT_CLICK, s, b->firstEdgeMs, held);
+            }
+          }
+          b->swallow = false;
+        }
+      }
+    }
+
+    if (b->pressed && !b->longSent && !b->swallow) {
+      uint32_t held = now - b->pressStartMs;
+      if (held >= BUTTON_LONG_PRESS_MS) {
+        b->longSent = true;
+        inputPush(INPUT_EVENT_LONG_PRESS, s, now, held);
+      } else {
+        next = min(next, (uint32_t)(BUTTON_LONG_PRESS_MS - held));
+      }
+    }
+  }
+  return next;
+}
+
+/**
+ * @brief Sleep until new input events are available or the timeout expires
+ * @details Wakes early for debounce and long-press deadlines, which it handles itself.
+ * @return true if at least one event was added while waiting
+ */
+bool inputEventsWait(uint32_t timeoutMs) {
+  if (g_inputRawQueue == NULL) {
+    vTaskDelay(pdMS_TO_TICKS(timeoutMs > 0 ? timeoutMs : 1));
+    return false;
+  }
+
+  uint8_t startCount = g_inputFifoCount;
+  uint32_t start = millis();
+  for (;;) {
+    uint32_t now = millis();
+    uint32_t deadline = inputServiceButtons(now);
+    if (g_inputFifoCount != startCount) return true;
+
+    uint32_t elapsed = now - start;
+    if (elapsed >= timeoutMs) return false;
+    uint32_t waitMs = min(timeoutMs - elapsed, deadline);
+
+    InputRawEdge_type edge;
+    if (xQueueReceive(g_inputRawQueue, &edge, pdMS_TO_TICKS(waitMs > 0 ? waitMs : 1)) == pdTRUE) {
+      do {
+        inputHandleRaw(&edge);
+      } while (xQueueReceive(g_inputRawQueue, &edge, 0) == pdTRUE);
+    }
+  }
+}
+
+bool inputEventsGet(InputEvent_type* out) {
+  if (out == NULL || g_inputFifoCount == 0) return false;
+  *out = g_inputFifo[g_inputFifoHead];
+  g_inputFifoHead = (g_inputFifoHead + 1) % INPUT_EVENT_FIFO_LEN;
+  g_inputFifoCount--;
+  return true;
+}
+
+/**
+ * @brief Drop pending events, e.g. input that a submenu already acted on
+ * @details A button held at this point reports nothing until it has been released.
+ */
+void inputEventsFlush() {
+  if (g_inputRawQueue != NULL) {
+    xQueueReset(g_inputRawQueue);
+  }
+  for (uint8_t s = 0; s < INPUT_SOURCE_COUNT; s++) {
+    g_inputRawPending[s] = false;
+  }
+  g_inputFifoHead = 0;
+  g_inputFifoCount = 0;
+  inputButtonResync(&g_inputButtons[INPUT_SOURCE_ENC_BUTTON]);
+  inputButtonResync(&g_inputButtons[INPUT_SOURCE_BRAKE_BUTTON]);
+}
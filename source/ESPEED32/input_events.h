@@ -0,0 +1,45 @@
+#ifndef INPUT_EVENTS_H_
+#define INPUT_EVENTS_H_
+
+#include <stdint.h>
+#include <Arduino.h>
+
+/* Interrupt-driven input events.
+ * The encoder ISR and CHANGE interrupts on the encoder and brake buttons post raw edges to a
+ * FreeRTOS queue; inputEventsWait() blocks Task1 on that queue, debounces the buttons and turns
+ * the edges into timestamped press/release/click/long-press events. Task1 therefore sleeps while
+ * nothing happens and wakes the moment the knob is turned or a button changes.
+ * The encoder position itself is still read with readUiEncoder(); ENCODER events only say that it moved. */
+#define INPUT_RAW_QUEUE_LEN     32
+#define INPUT_EVENT_FIFO_LEN    16      /* Cooked events kept for the consumer; oldest dropped on overflow */
+#define INPUT_DEBOUNCE_MS       15      /* [ms] A button level must be stable this long to count */
+
+typedef enum {
+  INPUT_SOURCE_ENCODER = 0,     /* Rotation */
+  INPUT_SOURCE_ENC_BUTTON,      /* Encoder push button (ENCODER_BUTTON_PIN) */
+  INPUT_SOURCE_BRAKE_BUTTON,    /* Brake button (BUTT_PIN) */
+  INPUT_SOURCE_COUNT
+} InputSource_enum;
+
+typedef enum {
+  INPUT_EVENT_ENCODER = 0,      /* Encoder moved since the last ENCODER event */
+  INPUT_EVENT_PRESS,
+  INPUT_EVENT_RELEASE,
+  INPUT_EVENT_CLICK,            /* Release after BUTTON_CLICK_MIN_MS..BUTTON_LONG_PRESS_MS */
+  INPUT_EVENT_LONG_PRESS        /* Held for BUTTON_LONG_PRESS_MS; the release then gives no CLICK */
+} InputEventType_enum;
+
+typedef struct {
+  uint8_t type;           /* InputEventType_enum */
+  uint8_t source;         /* InputSource_enum */
+  uint16_t heldMs;        /* RELEASE/CLICK: how long the button was down */
+  uint32_t timeMs;        /* millis() of the (first) edge */
+} InputEvent_type;
+
+void inputEventsBegin();
+void IRAM_ATTR inputEventsEncoderISR();
+bool inputEventsWait(uint32_t timeoutMs);
+bool inputEventsGet(InputEvent_type* out);
+void inputEventsFlush();
+
+#endif  /* INPUT_EVENTS_H_ */
@@ -0,0 +1,295 @@
+#include "json_scan.h"
+#include <string.h>
+
+static inline bool jsonScanIsSpace(char c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+static const char* jsonScanSkipSpace(const char* p, const char* end) {
+  while (p < end && jsonScanIsSpace(*p)) p++;
+  return p;
+}
+
+/* p is just past the opening quote; returns the closing quote or nullptr */
+static const char* jsonScanSkipString(const char* p, const char* end) {
+  while (p < end) {
+    if (*p == '\\') {
+      p += 2;
+      continue;
+    }
+    if (*p == '"') return p;
+    p++;
+  }
+  return nullptr;
+}
+
+/* p is on the opening bracket; returns just past the matching one. Bracket kinds are checked,
+ * member syntax inside is left to whoever scans the value later. */
+static const char* jsonScanSkipContainer(const char* p, const char* end) {
+  uint32_t arrayBits = 0;  /* Bit n set: nesting level n is an array */
+  uint8_t depth = 0;
+  while (p < end) {
+    char c = *p++;
+    if (c == '"') {
+      p = jsonScanSkipString(p, end);
+      if (p == nullptr) return nullptr;
+      p++;
+    } else if (c == '{' || c == '[') {
+      if (depth >= JSON_SCAN_MAX_DEPTH) return nullptr;
+      if (c == '[') {
+        arrayBits |= (1UL << depth);
+      } else {
+        arrayBits &= ~(1UL << depth);
+      }
+      depth++;
+    } else if (c == '}' || c == ']') {
+      if (depth == 0) return nullptr;
+      depth--;
+      bool isArray = ((arrayBits >> depth) & 1UL) != 0;
+      if (isArray != (c == ']')) return nullptr;
+      if (depth == 0) return p;
+    }
+  }
+  return nullptr;
+}
+
+/* Record one value starting at p (no leading whitespace); returns just past it */
+static const char* jsonScanValue(const char* p, const char* end, JsonScanMember_type* m) {
+  if (p >= end) return nullptr;
+  const char* start = p;
+  const char* next = nullptr;
+  char c = *p;
+
+  if (c == '"') {
+    const char* close = jsonScanSkipString(p + 1, end);
+    if (close == nullptr) return nullptr;
+    m->type = JSON_SCAN_STRING;
+    start = p + 1;
+    p = close;
+    next = close + 1;
+  } else if (c == '{' || c == '[') {
+    next = jsonScanSkipContainer(p, end);
+    if (next == nullptr) return nullptr;
+    m->type = (c == '{') ? JSON_SCAN_OBJECT : JSON_SCAN_ARRAY;
+    p = next;
+  } else if (c == '-' || (c >= '0' && c <= '9')) {
+    p++;
+    while (p < end && ((*p >= '0' && *p <= '9') || *p == '.' || *p == 'e' || *p == 'E' || *p == '+' || *p == '-')) p++;
+    m->type = JSON_SCAN_NUMBER;
+    next = p;
+  } else {
+    while (p < end && *p >= 'a' && *p <= 'z') p++;
+    size_t len = (size_t)(p - start);
+    if (!((len == 4 && memcmp(start, "true", 4) == 0) ||
+          (len == 5 && memcmp(start, "false", 5) == 0) ||
+          (len == 4 && memcmp(start, "null", 4) == 0))) {
+      return nullptr;
+    }
+    m->type = JSON_SCAN_LITERAL;
+    next = p;
+  }
+
+  size_t valueLen = (size_t)(p - start);
+  if (valueLen > JSON_SCAN_MAX_VALUE_LEN) return nullptr;
+  m->value = start;
+  m->valueLen = (uint16_t)valueLen;
+  return next;
+}
+
+/**
+ * @brief Index the members of a JSON object in one pass
+ * @details Trailing whitespace (and NUL padding) after the closing brace is accepted, nothing else.
+ * @return false if the text is not a well-formed object
+ */
+bool jsonScanObject(const char* json, size_t len, JsonScanObject_type* out) {
+  if (json == nullptr || out == nullptr) return false;
+  out->count = 0;
+  out->truncated = false;
+
+  const char* end = json + len;
+  const char* p = jsonScanSkipSpace(json, end);
+  if (p >= end || *p != '{') return false;
+  p = jsonScanSkipSpace(p + 1, end);
+  bool closed = (p < end && *p == '}');
+
+  while (!closed) {
+    if (p >= end || *p != '"') return false;
+    const char* key = p + 1;
+    const char* keyEnd = jsonScanSkipString(key, end);
+    if (keyEnd == nullptr || (size_t)(keyEnd - key) > 0xFFU) return false;
+    p = jsonScanSkipSpace(keyEnd + 1, end);
+    if (p >= end || *p != ':') return false;
+    p = jsonScanSkipSpace(p + 1, end);
+
+    JsonScanMember_type m;
+    p = jsonScanValue(p, end, &m);
+    if (p == nullptr) return false;
+    m.key = key;
+    m.keyLen = (uint8_t)(keyEnd - key);
+    if (out->count < JSON_SCAN_MAX_MEMBERS) {
+      out->members[out->count++] = m;
+    } else {
+      out->truncated = true;
+    }
+
+    p = jsonScanSkipSpace(p, end);
+    if (p < end && *p == ',') {
+      p = jsonScanSkipSpace(p + 1, end);
+    } else if (p < end && *p == '}') {
+      closed = true;
+    } else {
+      return false;
+    }
+  }
+
+  for (p++; p < end; p++) {
+    if (!jsonScanIsSpace(*p) && *p != '\0') return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Step through the elements of an array member
+ * @param cursor Start at 0; advanced past each element returned
+ * @return false at the end of the array (or on malformed content)
+ */
+bool jsonScanArrayNext(const JsonScanMember_type* array, size_t* cursor, JsonScanMember_type* outElem) {
+  if (array == nullptr || cursor == nullptr || outElem == nullptr || array->type != JSON_SCAN_ARRAY) return false;
+  const char* base = array->value;
+  const char* end = base + array->valueLen;
+  const char* p = base + *cursor;
+  if (p >= end) return false;
+
+  if (*cursor == 0) {
+    p = jsonScanSkipSpace(p + 1, end);  /* Past '[' */
+  } else {
+    p = jsonScanSkipSpace(p, end);
+    if (p >= end || *p != ',') {
+      *cursor = array->valueLen;
+      return false;
+    }
+    p = jsonScanSkipSpace(p + 1, end);
+  }
+  if (p >= end || *p == ']') {
+    *cursor = array->valueLen;
+    return false;
+  }
+
+  const char* next = jsonScanValue(p, end, outElem);
+  if (next == nullptr) {
+    *cursor = array->valueLen;
+    return false;
+  }
+  outElem->key = nullptr;
+  outElem->keyLen = 0;
+  *cursor = (size_t)(next - base);
+  return true;
+}
+
+const JsonScanMember_type* jsonScanFind(const JsonScanObject_type* obj, const char* key) {
+  if (obj == nullptr || key == nullptr) return nullptr;
+  size_t keyLen = strlen(key);
+  for (uint8_t i = 0; i < obj->count; i++) {
+    const JsonScanMember_type* m = &obj->members[i];
+    if (m->keyLen == keyLen && memcmp(m->key, key, keyLen) == 0) {
+      return m;
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Look up a renamed key: the current name wins, the old name is the fallback
+ */
+const JsonScanMember_type* jsonScanFindAlias(const JsonScanObject_type* obj, const char* primaryKey, const char* legacyKey) {
+  const JsonScanMember_type* m = jsonScanFind(obj, primaryKey);
+  if (m == nullptr && legacyKey != nullptr) {
+    m = jsonScanFind(obj, legacyKey);
+  }
+  return m;
+}
+
+bool jsonScanHas(const JsonScanObject_type* obj, const char* key) {
+  return jsonScanFind(obj, key) != nullptr;
+}
+
+/**
+ * @brief Read a number member as an integer (any fraction is dropped)
+ */
+bool jsonScanMemberInt(const JsonScanMember_type* m, int32_t* outVal) {
+  if (m == nullptr || outVal == nullptr || m->type != JSON_SCAN_NUMBER) return false;
+  const char* p = m->value;
+  const char* end = p + m->valueLen;
+  bool negative = false;
+  if (p < end && *p == '-') {
+    negative = true;
+    p++;
+  }
+  if (p >= end || *p < '0' || *p > '9') return false;
+  int64_t v = 0;
+  while (p < end && *p >= '0' && *p <= '9') {
+    if (v <= INT32_MAX) v = v * 10 + (*p - '0');
+    p++;
+  }
+  if (negative) v = -v;
+  if (v > INT32_MAX) v = INT32_MAX;
+  if (v < INT32_MIN) v = INT32_MIN;
+  *outVal = (int32_t)v;
+  return true;
+}
+
+static int jsonScanHexDigit(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+/**
+ * @brief Copy a string member with escapes decoded, truncated to outSize - 1
+ * @details \uXXXX outside ASCII becomes '?': every text field on the controller is ASCII.
+ */
+bool jsonScanMemberStr(const JsonScanMember_type* m, char* out, size_t outSize) {
+  if (m == nullptr || out == nullptr || outSize == 0 || m->type != JSON_SCAN_STRING) return false;
+  const char* p = m->value;
+  const char* end = p + m->valueLen;
+  size_t n = 0;
+  while (p < end && n + 1 < outSize) {
+    char c = *p++;
+    if (c == '\\' && p < end) {
+      char e = *p++;
+      switch (e) {
+        case 'n': c = '\n'; break;
+        case 'r': c = '\r'; break;
+        case 't': c = '\t'; break;
+        case 'b': c = '\b'; break;
+        case 'f': c = '\f'; break;
+        case 'u': {
+          uint16_t cp = 0;
+          uint8_t digits = 0;
+          while (digits < 4 && p < end) {
+            int h = jsonScanHexDigit(*p);
+            if (h < 0) break;
+            cp = (uint16_t)((cp << 4) | (uint16_t)h);
+            p++;
+            digits++;
+          }
+          c = (digits == 4 && cp > 0 && cp < 0x80) ? (char)cp : '?';
+          break;
+        }
+        default: c = e; break;  /* \" \\ \/ */
+      }
+    }
+    out[n++] = c;
+  }
+  out[n] = '\0';
+  return true;
+}
+
+bool jsonScanInt(const JsonScanObject_type* obj, const char* key, int32_t* outVal) {
+  return jsonScanMemberInt(jsonScanFind(obj, key), outVal);
+}
+
+bool jsonScanStr(const JsonScanObject_type* obj, const char* key, char* out, size_t outSize) {
+  return jsonScanMemberStr(jsonScanFind(obj, key), out, outSize);
+}
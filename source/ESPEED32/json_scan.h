@@ -0,0 +1,50 @@
+#ifndef JSON_SCAN_H_
+#define JSON_SCAN_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* In-place JSON object scanner for /api/apply, backup restore and the serial APPLY/RESTORE.
+ * jsonScanObject() walks one object once and records where each member's key and value sit
+ * in the caller's buffer; nested objects/arrays are skipped as a single value and can be
+ * scanned in turn (e.g. each entry of "cars"). Lookups then compare against that index
+ * instead of searching the whole document per key. Nothing is copied or allocated: the
+ * source buffer must outlive the index. First occurrence of a duplicate key wins. */
+#define JSON_SCAN_MAX_MEMBERS   64      /* Members indexed per object; further ones are skipped */
+#define JSON_SCAN_MAX_DEPTH     32      /* Nesting limit inside a skipped value */
+#define JSON_SCAN_MAX_VALUE_LEN 0xFFFFU
+
+typedef enum {
+  JSON_SCAN_STRING = 0,
+  JSON_SCAN_NUMBER,
+  JSON_SCAN_LITERAL,   /* true / false / null */
+  JSON_SCAN_OBJECT,
+  JSON_SCAN_ARRAY
+} JsonScanType_enum;
+
+typedef struct {
+  const char* key;       /* Not terminated; escapes are not decoded */
+  const char* value;     /* Strings: between the quotes (still escaped); others: the raw token incl. brackets */
+  uint16_t valueLen;
+  uint8_t keyLen;
+  uint8_t type;          /* JsonScanType_enum */
+} JsonScanMember_type;
+
+typedef struct {
+  JsonScanMember_type members[JSON_SCAN_MAX_MEMBERS];
+  uint8_t count;
+  bool truncated;        /* More members than JSON_SCAN_MAX_MEMBERS */
+} JsonScanObject_type;
+
+bool jsonScanObject(const char* json, size_t len, JsonScanObject_type* out);
+bool jsonScanArrayNext(const JsonScanMember_type* array, size_t* cursor, JsonScanMember_type* outElem);
+
+const JsonScanMember_type* jsonScanFind(const JsonScanObject_type* obj, const char* key);
+const JsonScanMember_type* jsonScanFindAlias(const JsonScanObject_type* obj, const char* primaryKey, const char* legacyKey);
+bool jsonScanHas(const JsonScanObject_type* obj, const char* key);
+bool jsonScanMemberInt(const JsonScanMember_type* m, int32_t* outVal);
+bool jsonScanMemberStr(const JsonScanMember_type* m, char* out, size_t outSize);
+bool jsonScanInt(const JsonScanObject_type* obj, const char* key, int32_t* outVal);
+bool jsonScanStr(const JsonScanObject_type* obj, const char* key, char* out, size_t outSize);
+
+#endif  /* JSON_SCAN_H_ */
@@ -0,0 +1,226 @@
+#include "json_stream.h"
+#include <string.h>
+
+static bool jsonStreamFail(JsonStream_type* s, uint8_t error) {
+  s->error = error;
+  return false;
+}
+
+static bool jsonStreamPutHead(JsonStream_type* s, char c) {
+  if (s->headLen >= JSON_STREAM_HEAD_MAX) {
+    return jsonStreamFail(s, JSON_STREAM_ERR_HEAD_FULL);
+  }
+  s->head[s->headLen++] = c;
+  return true;
+}
+
+static bool jsonStreamPutElem(JsonStream_type* s, char c) {
+  if (s->elemLen >= JSON_STREAM_ELEM_MAX) {
+    return jsonStreamFail(s, JSON_STREAM_ERR_ELEM_FULL);
+  }
+  s->elem[s->elemLen++] = c;
+  return true;
+}
+
+static bool jsonStreamDeliver(JsonStream_type* s) {
+  s->elem[s->elemLen] = '\0';
+  s->elemActive = false;
+  uint16_t index = s->elements++;
+  if (s->onElement != nullptr && !s->onElement(s->ctx, index, s->elem, s->elemLen)) {
+    return jsonStreamFail(s, JSON_STREAM_ERR_REJECTED);
+  }
+  return true;
+}
+
+/* Inside a string: copied as is, member names at depth 1 are also captured for the key match */
+static bool jsonStreamStringChar(JsonStream_type* s, char c) {
+  if (!(s->elemActive ? jsonStreamPutElem(s, c) : jsonStreamPutHead(s, c))) {
+    return false;
+  }
+  if (s->escape) {
+    s->escape = false;
+  } else if (c == '\\') {
+    s->escape = true;
+  } else if (c == '"') {
+    s->inString = false;
+    if (s->capturingKey) {
+      s->capturingKey = false;
+      size_t wantLen = strlen(s->arrayKey);
+      s->keyMatches = (s->keyLen < JSON_STREAM_KEY_MAX && s->keyLen == wantLen &&
+                       memcmp(s->key, s->arrayKey, wantLen) == 0);
+    }
+    return true;
+  }
+  if (s->capturingKey && s->keyLen < JSON_STREAM_KEY_MAX) {
+    s->key[s->keyLen++] = c;
+  }
+  return true;
+}
+
+/* Inside the split array: collect one element at a time, drop the separators */
+static bool jsonStreamArrayChar(JsonStream_type* s, char c) {
+  if (!s->elemActive) {
+    if (c == ',') {
+      return true;
+    }
+    if (c == ']') {
+      s->inArray = false;
+      s->depth = 1;
+      return jsonStreamPutHead(s, c);
+    }
+    s->elemActive = true;
+    s->elemLen = 0;
+    s->elemScalar = (c != '{' && c != '[');
+  } else if (s->elemScalar && s->depth == 2 && (c == ',' || c == ']')) {
+    if (!jsonStreamDeliver(s)) {
+      return false;
+    }
+    return jsonStreamArrayChar(s, c);
+  }
+
+  if (!jsonStreamPutElem(s, c)) {
+    return false;
+  }
+  if (c == '"') {
+    s->inString = true;
+  } else if (c == '{' || c == '[') {
+    if (s->depth >= JSON_STREAM_MAX_DEPTH) {
+      return jsonStreamFail(s, JSON_STREAM_ERR_DEPTH);
+    }
+    s->depth++;
+  } else if (c == '}' || c == ']') {
+    s->depth--;
+    if (s->depth == 2 && !s->elemScalar) {
+      return jsonStreamDeliver(s);
+    }
+  }
+  return true;
+}
+
+static bool jsonStreamChar(JsonStream_type* s, char c) {
+  if (s->inString) {
+    return jsonStreamStringChar(s, c);
+  }
+  if (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+    return true;
+  }
+  if (s->done) {
+    return jsonStreamFail(s, JSON_STREAM_ERR_SYNTAX);
+  }
+  if (s->depth == 0) {
+    if (c != '{') {
+      return jsonStreamFail(s, JSON_STREAM_ERR_SYNTAX);
+    }
+    s->depth = 1;
+    s->expectKey = true;
+    return jsonStreamPutHead(s, c);
+  }
+  if (s->inArray) {
+    return jsonStreamArrayChar(s, c);
+  }
+
+  bool splitHere = (s->depth == 1 && c == '[' && s->keyMatches && !s->arraySeen);
+  if (c != ':') {
+    s->keyMatches = false;
+  }
+  if (!jsonStreamPutHead(s, c)) {
+    return false;
+  }
+  switch (c) {
+    case '"':
+      s->inString = true;
+      if (s->depth == 1 && s->expectKey) {
+        s->capturingKey = true;
+        s->keyLen = 0;
+      }
+      break;
+    case ':':
+      if (s->depth == 1) s->expectKey = false;
+      break;
+    case ',':
+      if (s->depth == 1) s->expectKey = true;
+      break;
+    case '{':
+    case '[':
+      if (splitHere) {
+        s->inArray = true;
+        s->arraySeen = true;
+        s->depth = 2;
+        break;
+      }
+      if (s->depth >= JSON_STREAM_MAX_DEPTH) {
+        return jsonStreamFail(s, JSON_STREAM_ERR_DEPTH);
+      }
+      s->depth++;
+      break;
+    case '}':
+    case ']':
+      s->depth--;
+      if (s->depth == 0) {
+        if (c != '}') {
+          return jsonStreamFail(s, JSON_STREAM_ERR_SYNTAX);
+        }
+        s->done = true;
+      }
+      break;
+    default:
+      break;
+  }
+  return true;
+}
+
+/**
+ * @brief Reset the splitter; arrayKey must outlive the stream
+ */
+void jsonStreamBegin(JsonStream_type* s, const char* arrayKey, JsonStreamElement_fn onElement, void* ctx) {
+  memset(s, 0, offsetof(JsonStream_type, key));
+  s->arrayKey = (arrayKey != nullptr) ? arrayKey : "";
+  s->onElement = onElement;
+  s->ctx = ctx;
+  s->head[0] = '\0';
+  s->elem[0] = '\0';
+}
+
+/**
+ * @brief Feed the next piece of the document
+ * @return false once an error has occurred (see s->error)
+ */
+bool jsonStreamFeed(JsonStream_type* s, const char* data, size_t len) {
+  if (s->error != JSON_STREAM_OK) {
+    return false;
+  }
+  s->bytes += (uint32_t)len;
+  for (size_t i = 0; i < len; i++) {
+    if (!jsonStreamChar(s, data[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Finish the stream; on success head[] holds the NUL-terminated top-level object
+ */
+bool jsonStreamEnd(JsonStream_type* s) {
+  if (s->error != JSON_STREAM_OK) {
+    return false;
+  }
+  if (!s->done) {
+    return jsonStreamFail(s, JSON_STREAM_ERR_INCOMPLETE);
+  }
+  s->head[s->headLen] = '\0';
+  return true;
+}
+
+const char* jsonStreamErrorText(uint8_t error) {
+  switch (error) {
+    case JSON_STREAM_OK:             return "ok";
+    case JSON_STREAM_ERR_HEAD_FULL:  return "settings section too large";
+    case JSON_STREAM_ERR_ELEM_FULL:  return "entry too large";
+    case JSON_STREAM_ERR_DEPTH:      return "nested too deep";
+    case JSON_STREAM_ERR_REJECTED:   return "entry rejected";
+    case JSON_STREAM_ERR_INCOMPLETE: return "truncated JSON";
+    case JSON_STREAM_ERR_SYNTAX:
+    default:                         return "malformed JSON";
+  }
+}
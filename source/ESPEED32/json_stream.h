@@ -0,0 +1,74 @@
+#ifndef JSON_STREAM_H_
+#define JSON_STREAM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Incremental splitter for one large JSON object that arrives in pieces (backup restore).
+ * jsonStreamFeed() takes the text in chunks of any size and keeps only what is needed:
+ *   - the top-level object is copied into head[], minus whitespace outside strings, except
+ *     for the members of the one array named at jsonStreamBegin() ("cars"): that member is
+ *     kept as an empty "[]" so json_scan still sees it, and each of its elements is collected
+ *     in elem[] on its own and handed to the callback as soon as it is complete
+ *   - memory is the struct itself, whatever the total size: an element must fit
+ *     JSON_STREAM_ELEM_MAX and the rest of the document JSON_STREAM_HEAD_MAX
+ * Only the bracket structure and string quoting are checked here; member syntax is left to
+ * jsonScanObject() over head[] and each element. After the first error further input is
+ * ignored and the error stays. */
+#ifndef JSON_STREAM_HEAD_MAX
+#define JSON_STREAM_HEAD_MAX   1536U
+#endif
+#ifndef JSON_STREAM_ELEM_MAX
+#define JSON_STREAM_ELEM_MAX   768U
+#endif
+#define JSON_STREAM_KEY_MAX    24U      /* Longer keys never match the split array */
+#define JSON_STREAM_MAX_DEPTH  32U
+
+typedef enum {
+  JSON_STREAM_OK = 0,
+  JSON_STREAM_ERR_SYNTAX,        /* Not an object, unbalanced brackets or text after it */
+  JSON_STREAM_ERR_HEAD_FULL,
+  JSON_STREAM_ERR_ELEM_FULL,
+  JSON_STREAM_ERR_DEPTH,
+  JSON_STREAM_ERR_REJECTED,      /* The element callback returned false */
+  JSON_STREAM_ERR_INCOMPLETE     /* jsonStreamEnd() before the closing brace */
+} JsonStreamError_enum;
+
+/**
+ * @brief Called once per element of the split array, in order
+ * @return false to stop the stream (JSON_STREAM_ERR_REJECTED)
+ */
+typedef bool (*JsonStreamElement_fn)(void* ctx, uint16_t index, const char* json, size_t len);
+
+typedef struct {
+  const char* arrayKey;
+  JsonStreamElement_fn onElement;
+  void* ctx;
+  uint32_t bytes;                /* Fed so far */
+  uint16_t elements;             /* Delivered so far */
+  uint16_t headLen;
+  uint16_t elemLen;
+  uint8_t depth;
+  uint8_t keyLen;
+  uint8_t error;                 /* JsonStreamError_enum */
+  bool inString;
+  bool escape;
+  bool expectKey;                /* Next string at depth 1 is a member name */
+  bool capturingKey;
+  bool keyMatches;               /* Last member name at depth 1 was arrayKey */
+  bool inArray;                  /* Inside the split array */
+  bool elemActive;
+  bool elemScalar;               /* Current element is not an object/array */
+  bool arraySeen;
+  bool done;                     /* Top-level object closed */
+  char key[JSON_STREAM_KEY_MAX];
+  char head[JSON_STREAM_HEAD_MAX + 1];
+  char elem[JSON_STREAM_ELEM_MAX + 1];
+} JsonStream_type;
+
+void jsonStreamBegin(JsonStream_type* s, const char* arrayKey, JsonStreamElement_fn onElement, void* ctx);
+bool jsonStreamFeed(JsonStream_type* s, const char* data, size_t len);
+bool jsonStreamEnd(JsonStream_type* s);
+const char* jsonStreamErrorText(uint8_t error);
+
+#endif  /* JSON_STREAM_H_ */
@@ -0,0 +1,152 @@
+#include "json_writer.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+static void jsonWriterFlush(JsonWriter_type* w) {
+  if (w->used == 0) return;
+  if (w->sink != nullptr) {
+    w->sink(w->ctx, w->buf, w->used);
+  }
+  w->used = 0;
+}
+
+void jsonWriterBegin(JsonWriter_type* w, JsonWriterSink_fn sink, void* ctx) {
+  w->sink = sink;
+  w->ctx = ctx;
+  w->used = 0;
+  w->total = 0;
+}
+
+/**
+ * @brief Hand any buffered text to the sink
+ * @return Total length of the document
+ */
+size_t jsonWriterEnd(JsonWriter_type* w) {
+  jsonWriterFlush(w);
+  return w->total;
+}
+
+void jsonWriterRawLen(JsonWriter_type* w, const char* data, size_t len) {
+  w->total += len;
+  while (len > 0) {
+    size_t room = JSON_WRITER_CHUNK_SIZE - w->used;
+    size_t n = (len < room) ? len : room;
+    memcpy(w->buf + w->used, data, n);
+    w->used += n;
+    data += n;
+    len -= n;
+    if (w->used == JSON_WRITER_CHUNK_SIZE) {
+      jsonWriterFlush(w);
+    }
+  }
+}
+
+void jsonWriterRaw(JsonWriter_type* w, const char* text) {
+  if (text == nullptr) return;
+  jsonWriterRawLen(w, text, strlen(text));
+}
+
+void jsonWriterChar(JsonWriter_type* w, char c) {
+  if (w->used == JSON_WRITER_CHUNK_SIZE) {
+    jsonWriterFlush(w);
+  }
+  w->buf[w->used++] = c;
+  w->total++;
+}
+
+/**
+ * @brief Write string contents with JSON escaping (no surrounding quotes)
+ */
+void jsonWriterEscaped(JsonWriter_type* w, const char* text) {
+  if (text == nullptr) return;
+  const char* run = text;
+  for (; *text != '\0'; text++) {
+    char c = *text;
+    const char* esc = nullptr;
+    char ctrl[7];
+    if (c == '"') {
+      esc = "\\\"";
+    } else if (c == '\\') {
+      esc = "\\\\";
+    } else if (c == '\n') {
+      esc = "\\n";
+    } else if (c == '\r') {
+      esc = "\\r";
+    } else if (c == '\t') {
+      esc = "\\t";
+    } else if ((uint8_t)c < 0x20) {
+      snprintf(ctrl, sizeof(ctrl), "\\u%04x", (unsigned int)(uint8_t)c);
+      esc = ctrl;
+    } else {
+      continue;
+    }
+    jsonWriterRawLen(w, run, (size_t)(text - run));
+    jsonWriterRaw(w, esc);
+    run = text + 1;
+  }
+  jsonWriterRawLen(w, run, (size_t)(text - run));
+}
+
+void jsonWriterString(JsonWriter_type* w, const char* text) {
+  jsonWriterChar(w, '"');
+  jsonWriterEscaped(w, text);
+  jsonWriterChar(w, '"');
+}
+
+void jsonWriterUInt(JsonWriter_type* w, uint32_t value) {
+  char digits[10];
+  size_t n = 0;
+  do {
+    digits[n++] = (char)('0' + (value % 10U));
+    value /= 10U;
+  } while (value != 0U);
+  char out[10];
+  for (size_t i = 0; i < n; i++) {
+    out[i] = digits[n - 1 - i];
+  }
+  jsonWriterRawLen(w, out, n);
+}
+
+void jsonWriterInt(JsonWriter_type* w, int32_t value) {
+  if (value < 0) {
+    jsonWriterChar(w, '-');
+    jsonWriterUInt(w, (uint32_t)(-(int64_t)value));
+  } else {
+    jsonWriterUInt(w, (uint32_t)value);
+  }
+}
+
+void jsonWriterBool(JsonWriter_type* w, bool value) {
+  jsonWriterRaw(w, value ? "true" : "false");
+}
+
+/**
+ * @brief Formatted output; one call must not exceed JSON_WRITER_CHUNK_SIZE - 1 bytes
+ * @details Longer output is truncated, identically on the counting and the sending pass.
+ */
+void jsonWriterPrintf(JsonWriter_type* w, const char* fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  size_t room = JSON_WRITER_CHUNK_SIZE - w->used;
+  int n = vsnprintf(w->buf + w->used, room, fmt, args);
+  va_end(args);
+  if (n < 0) return;
+  if ((size_t)n < room) {
+    w->used += (size_t)n;
+    w->total += (size_t)n;
+    return;
+  }
+
+  /* Did not fit behind the buffered text: flush and format again at the start */
+  jsonWriterFlush(w);
+  va_start(args, fmt);
+  n = vsnprintf(w->buf, JSON_WRITER_CHUNK_SIZE, fmt, args);
+  va_end(args);
+  if (n < 0) return;
+  if ((size_t)n >= JSON_WRITER_CHUNK_SIZE) {
+    n = (int)(JSON_WRITER_CHUNK_SIZE - 1U);
+  }
+  w->used = (size_t)n;
+  w->total += (size_t)n;
+}
@@ -0,0 +1,38 @@
+#ifndef JSON_WRITER_H_
+#define JSON_WRITER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Streaming JSON output for portal and serial responses.
+ * Text is formatted into a fixed chunk buffer and handed to a sink whenever the buffer
+ * fills, so a response never exists in full in RAM. A writer without a sink only counts
+ * bytes: the serial protocol runs a body once that way to get the length prefix, then
+ * again for real, so body writers must produce the same text both times (capture live
+ * values before writing). */
+#define JSON_WRITER_CHUNK_SIZE  256U   /* Also the largest single jsonWriterPrintf() piece */
+
+typedef void (*JsonWriterSink_fn)(void* ctx, const char* data, size_t len);
+
+typedef struct {
+  JsonWriterSink_fn sink;   /* nullptr: count only */
+  void* ctx;
+  size_t used;
+  size_t total;             /* Bytes emitted so far, including the buffered ones */
+  char buf[JSON_WRITER_CHUNK_SIZE];
+} JsonWriter_type;
+
+void jsonWriterBegin(JsonWriter_type* w, JsonWriterSink_fn sink, void* ctx);
+size_t jsonWriterEnd(JsonWriter_type* w);
+
+void jsonWriterRaw(JsonWriter_type* w, const char* text);
+void jsonWriterRawLen(JsonWriter_type* w, const char* data, size_t len);
+void jsonWriterChar(JsonWriter_type* w, char c);
+void jsonWriterEscaped(JsonWriter_type* w, const char* text);
+void jsonWriterString(JsonWriter_type* w, const char* text);
+void jsonWriterUInt(JsonWriter_type* w, uint32_t value);
+void jsonWriterInt(JsonWriter_type* w, int32_t value);
+void jsonWriterBool(JsonWriter_type* w, bool value);
+void jsonWriterPrintf(JsonWriter_type* w, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+#endif  /* JSON_WRITER_H_ */
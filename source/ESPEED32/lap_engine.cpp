@@ -0,0 +1,562 @@
+#include "lap_engine.h"
+#include <Arduino.h>
+#include <FS.h>
+#include <SPIFFS.h>
+#include <Preferences.h>
+#include <math.h>
+#include <string.h>
+#include "slot_ESC.h"
+#include "connectivity_portal.h"
+
+extern ESC_type g_escVar;
+extern uint16_t g_carSel;
+
+#define LAP_PREF_NAMESPACE      "laps"
+#define LAP_PREF_NEXT_SESSION   "next_sess"
+#define LAP_PREF_SECTORS        "sectors"
+#define LAP_LOG_PATH_MAX        24
+#define LAP_LOG_SCAN_MAX        64      /* Session files looked at when pruning/listing */
+
+typedef struct {
+  uint32_t sessionId;
+  uint8_t sectorCount;
+  bool running;             /* A lap is in progress (the line has been crossed) */
+  bool fileCreated;         /* This session's log file exists */
+  uint8_t sector;
+  uint32_t lapStartUs;
+  uint32_t sectorStartUs;
+  uint32_t lastCrossingMs;
+  uint32_t sessionStartMs;
+  uint32_t lastFlushAttemptMs;
+  uint32_t sectorUs[LAP_ENGINE_MAX_SECTORS];
+  double meanUs;            /* Welford running mean / sum of squared deviations */
+  double m2;
+  uint32_t rolling[LAP_ENGINE_ROLLING_LAPS];
+  uint8_t rollingIdx;
+  uint64_t rollingSum;
+  uint64_t rollingSumSq;
+} LapEngineState_type;
+
+static QueueHandle_t g_lapQueue = NULL;
+static volatile uint32_t g_lapMinCrossingUs = LAP_MIN_TIME_MS * 1000UL;
+static volatile bool g_lapNewSessionRequested = false;
+static volatile uint8_t g_lapRequestedSectors = 0;     /* 0: no change pending */
+
+/* Written by lapEngineService(), read by anyone under g_lapMux */
+static portMUX_TYPE g_lapMux = portMUX_INITIALIZER_UNLOCKED;
+static LapStats_type g_lapStats;
+static LapRecord_type g_lapRecent[LAP_ENGINE_RECENT_LAPS];   /* Indexed by (lapNumber - 1) % size */
+static bool g_lapRunning = false;
+static uint32_t g_lapStartUs = 0;
+
+/* lapEngineService() only */
+static LapEngineState_type g_lap;
+static LapCrossing_fn g_lapCrossingListener = nullptr;
+
+static void lapLogPath(uint32_t sessionId, char* out, size_t outLen) {
+  snprintf(out, outLen, LAP_LOG_DIR "/s%05lu.lap", (unsigned long)sessionId);
+}
+
+/* micros() wraps every ~71 minutes; convert through the current time instead of dividing */
+static uint32_t lapUsToMs(uint32_t timestampUs) {
+  return millis() - (micros() - timestampUs) / 1000UL;
+}
+
+static void lapPublishProgress() {
+  portENTER_CRITICAL(&g_lapMux);
+  g_lapRunning = g_lap.running;
+  g_lapStartUs = g_lap.lapStartUs;
+  g_lapStats.currentSector = g_lap.sector;
+  portEXIT_CRITICAL(&g_lapMux);
+}
+
+/*********************************************************************************************************************/
+/*                                                   Flash log                                                       */
+/*********************************************************************************************************************/
+
+static bool lapLogParseName(const char* name, uint32_t* outId) {
+  const char* base = strrchr(name, '/');
+  base = (base != nullptr) ? base + 1 : name;
+  unsigned long id = 0;
+  char ext[5] = {0};
+  if (sscanf(base, "s%lu.%4s", &id, ext) != 2 || strcmp(ext, "lap") != 0) {
+    return false;
+  }
+  *outId = (uint32_t)id;
+  return true;
+}
+
+/**
+ * @brief Collect session ids present on SPIFFS, ascending
+ */
+static uint8_t lapLogScan(uint32_t* ids, uint8_t maxIds) {
+  uint8_t count = 0;
+  /* SPIFFS is flat: LAP_LOG_DIR is only a name prefix, so walk the root */
+  File dir = SPIFFS.open("/");
+  if (!dir) {
+    return 0;
+  }
+  File f = dir.openNextFile();
+  while (f && count < maxIds) {
+    uint32_t id;
+    if (strncmp(f.path(), LAP_LOG_DIR "/", sizeof(LAP_LOG_DIR)) == 0 && lapLogParseName(f.path(), &id)) {
+      uint8_t pos = count++;
+      while (pos > 0 && ids[pos - 1] > id) {
+        ids[pos] = ids[pos - 1];
+        pos--;
+      }
+      ids[pos] = id;
+    }
+    f.close();
+    f = dir.openNextFile();
+  }
+  dir.close();
+  return count;
+}
+
+/**
+ * @brief Delete the oldest sessions until one more fits the count and free-space limits
+ */
+static void lapLogPrune() {
+  uint32_t ids[LAP_LOG_SCAN_MAX];
+  uint8_t count = lapLogScan(ids, LAP_LOG_SCAN_MAX);
+  char path[LAP_LOG_PATH_MAX];
+  for (uint8_t i = 0; i < count; i++) {
+    bool tooMany = (count - i) >= LAP_LOG_MAX_SESSIONS;
+    bool tooFull = (SPIFFS.totalBytes() - SPIFFS.usedBytes()) < LAP_LOG_MIN_FREE_BYTES;
+    if (!tooMany && !tooFull) {
+      break;
+    }
+    lapLogPath(ids[i], path, sizeof(path));
+    SPIFFS.remove(path);
+  }
+}
+
+static bool lapLogCreate() {
+  lapLogPrune();
+  if ((SPIFFS.totalBytes() - SPIFFS.usedBytes()) < LAP_LOG_MIN_FREE_BYTES / 2) {
+    return false;     /* Filesystem is all UI assets: keep the laps in RAM only */
+  }
+  char path[LAP_LOG_PATH_MAX];
+  lapLogPath(g_lap.sessionId, path, sizeof(path));
+  File f = SPIFFS.open(path, FILE_WRITE);
+  if (!f) {
+    return false;
+  }
+  LapLogHeader_type header = {LAP_LOG_MAGIC, LAP_LOG_VERSION, g_lap.sectorCount,
+                              (uint16_t)sizeof(LapRecord_type), g_lap.sessionId};
+  bool ok = f.write((const uint8_t*)&header, sizeof(header)) == sizeof(header);
+  f.close();
+  if (!ok) {
+    return false;
+  }
+
+  Preferences pref;
+  if (pref.begin(LAP_PREF_NAMESPACE, false)) {
+    pref.putUInt(LAP_PREF_NEXT_SESSION, g_lap.sessionId + 1U);
+    pref.end();
+  }
+  g_lap.fileCreated = true;
+  return true;
+}
+
+/**
+ * @brief Append the laps not yet in the log
+ */
+static void lapLogFlush() {
+  g_lap.lastFlushAttemptMs = millis();
+
+  portENTER_CRITICAL(&g_lapMux);
+  uint32_t lapCount = g_lapStats.lapCount;
+  uint32_t logged = g_lapStats.loggedLaps;
+  portEXIT_CRITICAL(&g_lapMux);
+  if (logged >= lapCount) {
+    return;
+  }
+  /* Laps that already left the RAM ring cannot be logged any more */
+  if (lapCount - logged > LAP_ENGINE_RECENT_LAPS) {
+    logged = lapCount - LAP_ENGINE_RECENT_LAPS;
+  }
+
+  bool ok = SPIFFS.begin(false) && (g_lap.fileCreated || lapLogCreate());
+  if (ok) {
+    char path[LAP_LOG_PATH_MAX];
+    lapLogPath(g_lap.sessionId, path, sizeof(path));
+    File f = SPIFFS.open(path, FILE_APPEND);
+    ok = (bool)f;
+    while (ok && logged < lapCount) {
+      LapRecord_type record;
+      portENTER_CRITICAL(&g_lapMux);
+      record = g_lapRecent[logged % LAP_ENGINE_RECENT_LAPS];
+      portEXIT_CRITICAL(&g_lapMux);
+      ok = f.write((const uint8_t*)&record, sizeof(record)) == sizeof(record);
+      if (ok) {
+        logged++;
+      }
+    }
+    if (f) {
+      f.close();
+    }
+  }
+
+  portENTER_CRITICAL(&g_lapMux);
+  g_lapStats.loggedLaps = logged;
+  g_lapStats.logAvailable = ok;
+  portEXIT_CRITICAL(&g_lapMux);
+}
+
+/*********************************************************************************************************************/
+/*                                                    Timing                                                         */
+/*********************************************************************************************************************/
+
+static void lapStartSession() {
+  if (g_lap.fileCreated) {
+    g_lap.sessionId++;
+  }
+  uint32_t sessionId = g_lap.sessionId;
+  uint8_t sectors = g_lap.sectorCount;
+  memset(&g_lap, 0, sizeof(g_lap));
+  g_lap.sessionId = sessionId;
+  g_lap.sectorCount = sectors;
+  g_lapMinCrossingUs = ((sectors > 1) ? LAP_ENGINE_MIN_SECTOR_MS : LAP_MIN_TIME_MS) * 1000UL;
+
+  portENTER_CRITICAL(&g_lapMux);
+  bool logAvailable = g_lapStats.logAvailable;
+  memset(&g_lapStats, 0, sizeof(g_lapStats));
+  memset(g_lapRecent, 0, sizeof(g_lapRecent));
+  g_lapStats.sessionId = sessionId;
+  g_lapStats.sectorCount = sectors;
+  g_lapStats.logAvailable = logAvailable;
+  g_lapRunning = false;
+  g_lapStartUs = 0;
+  portEXIT_CRITICAL(&g_lapMux);
+
+  g_escVar.lapCount = 0;
+  g_escVar.bestLapTime_ms = 0;
+  g_escVar.lapStartTime_ms = 0;
+  for (uint8_t i = 0; i < LAP_MAX_COUNT; i++) {
+    g_escVar.lapTimes[i] = 0;
+  }
+}
+
+static void lapCompleteLap(uint32_t timestampUs) {
+  LapRecord_type record;
+  memset(&record, 0, sizeof(record));
+  record.lapUs = timestampUs - g_lap.lapStartUs;
+  memcpy(record.sectorUs, g_lap.sectorUs, sizeof(record.sectorUs));
+  record.endMs = lapUsToMs(timestampUs) - g_lap.sessionStartMs;
+  record.sectorCount = g_lap.sectorCount;
+  record.carIndex = (uint8_t)g_carSel;
+
+  /* Rolling window: O(1) per lap with exact integer sums */
+  uint64_t old = g_lap.rolling[g_lap.rollingIdx];   /* 0 until the window is full */
+  g_lap.rollingSum -= old;
+  g_lap.rollingSumSq -= old * old;
+  g_lap.rolling[g_lap.rollingIdx] = record.lapUs;
+  g_lap.rollingSum += record.lapUs;
+  g_lap.rollingSumSq += (uint64_t)record.lapUs * record.lapUs;
+  g_lap.rollingIdx = (g_lap.rollingIdx + 1) % LAP_ENGINE_ROLLING_LAPS;
+
+  portENTER_CRITICAL(&g_lapMux);
+  LapStats_type s = g_lapStats;
+  portEXIT_CRITICAL(&g_lapMux);
+
+  s.lapCount++;
+  record.lapNumber = (uint16_t)s.lapCount;
+  double delta = (double)record.lapUs - g_lap.meanUs;
+  g_lap.meanUs += delta / (double)s.lapCount;
+  g_lap.m2 += delta * ((double)record.lapUs - g_lap.meanUs);
+  s.meanLapUs = (uint32_t)g_lap.meanUs;
+  s.stddevLapUs = (s.lapCount > 1) ? (uint32_t)sqrt(g_lap.m2 / (double)(s.lapCount - 1)) : 0;
+
+  if (s.rollingCount < LAP_ENGINE_ROLLING_LAPS) s.rollingCount++;
+  double n = (double)s.rollingCount;
+  double sum = (double)g_lap.rollingSum;
+  s.rollingMeanUs = (uint32_t)(sum / n);
+  double var = (s.rollingCount > 1) ? ((double)g_lap.rollingSumSq - sum * sum / n) / (n - 1.0) : 0.0;
+  s.rollingStddevUs = (var > 0.0) ? (uint32_t)sqrt(var) : 0;
+
+  s.lastLapUs = record.lapUs;
+  if (s.bestLapUs == 0 || record.lapUs < s.bestLapUs) s.bestLapUs = record.lapUs;
+  uint32_t theoretical = 0;
+  for (uint8_t i = 0; i < g_lap.sectorCount; i++) {
+    if (s.bestSectorUs[i] == 0 || record.sectorUs[i] < s.bestSectorUs[i]) s.bestSectorUs[i] = record.sectorUs[i];
+    theoretical += s.bestSectorUs[i];
+  }
+  s.theoreticalBestUs = theoretical;
+
+  portENTER_CRITICAL(&g_lapMux);
+  s.loggedLaps = g_lapStats.loggedLaps;
+  s.logAvailable = g_lapStats.logAvailable;
+  g_lapStats = s;
+  g_lapRecent[(s.lapCount - 1U) % LAP_ENGINE_RECENT_LAPS] = record;
+  portEXIT_CRITICAL(&g_lapMux);
+
+  /* Screens keep using the millisecond view */
+  uint32_t lapMs = record.lapUs / 1000UL;
+  g_escVar.lapTimes[g_escVar.lapCount % LAP_MAX_COUNT] = lapMs;
+  if (g_escVar.lapCount == 0 || lapMs < g_escVar.bestLapTime_ms) g_escVar.bestLapTime_ms = lapMs;
+  g_escVar.lapCount++;
+}
+
+static void lapNotifyCrossing(uint32_t timestampUs, uint32_t lapUs, uint32_t sectorUs, uint8_t sector) {
+  if (g_lapCrossingListener == nullptr) {
+    return;
+  }
+  LapCrossing_type crossing;
+  portENTER_CRITICAL(&g_lapMux);
+  uint32_t lapCount = g_lapStats.lapCount;
+  portEXIT_CRITICAL(&g_lapMux);
+  crossing.timestampUs = timestampUs;
+  crossing.lapUs = lapUs;
+  crossing.sectorUs = sectorUs;
+  crossing.lapNumber = (uint16_t)(lapCount + 1U);
+  crossing.sector = sector;
+  crossing.sectorCount = g_lap.sectorCount;
+  crossing.carIndex = (uint8_t)g_carSel;
+  g_lapCrossingListener(&crossing);
+}
+
+static void lapHandleCrossing(uint32_t timestampUs) {
+  g_lap.lastCrossingMs = millis();
+  uint32_t lapUs = 0;
+  uint32_t sectorUs = 0;
+  uint8_t closed = 0;
+
+  if (!g_lap.running) {
+    /* Start/finish line */
+    if (g_lapStats.lapCount == 0 && !g_lap.fileCreated) {
+      g_lap.sessionStartMs = lapUsToMs(timestampUs);
+    }
+    g_lap.running = true;
+    g_lap.sector = 0;
+  } else {
+    closed = g_lap.sector;
+    sectorUs = timestampUs - g_lap.sectorStartUs;
+    g_lap.sectorUs[closed] = sectorUs;
+    g_lap.sector++;
+    if (g_lap.sector < g_lap.sectorCount) {
+      g_lap.sectorStartUs = timestampUs;
+      lapPublishProgress();
+      lapNotifyCrossing(timestampUs, 0, sectorUs, closed);
+      return;
+    }
+    lapUs = timestampUs - g_lap.lapStartUs;
+    lapCompleteLap(timestampUs);
+    g_lap.sector = 0;
+    memset(g_lap.sectorUs, 0, sizeof(g_lap.sectorUs));
+  }
+  g_lap.lapStartUs = timestampUs;
+  g_lap.sectorStartUs = timestampUs;
+  uint32_t startMs = lapUsToMs(timestampUs);
+  g_escVar.lapStartTime_ms = (startMs > 0) ? startMs : 1;
+  lapPublishProgress();
+  lapNotifyCrossing(timestampUs, lapUs, sectorUs, closed);
+}
+
+/*********************************************************************************************************************/
+/*                                                  Public API                                                       */
+/*********************************************************************************************************************/
+
+/**
+ * @brief Create the crossing queue and restore the sector count and session number
+ */
+void lapEngineBegin() {
+  if (g_lapQueue == NULL) {
+    g_lapQueue = xQueueCreate(LAP_ENGINE_QUEUE_LEN, sizeof(uint32_t));
+  }
+  uint8_t sectors = 1;
+  uint32_t nextSession = 1;
+  Preferences pref;
+  if (pref.begin(LAP_PREF_NAMESPACE, true)) {
+    sectors = pref.getUChar(LAP_PREF_SECTORS, 1);
+    nextSession = pref.getUInt(LAP_PREF_NEXT_SESSION, 1);
+    pref.end();
+  }
+  g_lap.fileCreated = false;
+  g_lap.sessionId = nextSession;
+  g_lap.sectorCount = constrain(sectors, 1, LAP_ENGINE_MAX_SECTORS);
+  lapStartSession();
+}
+
+/**
+ * @brief Post a dead-spot crossing (Task2)
+ */
+void lapEngineCrossing(uint32_t timestampUs) {
+  if (g_lapQueue != NULL) {
+    xQueueSend(g_lapQueue, &timestampUs, 0);
+  }
+}
+
+/**
+ * @brief Register the function lapEngineService() calls for every crossing (WiFiTask context)
+ */
+void lapEngineSetCrossingListener(LapCrossing_fn listener) {
+  g_lapCrossingListener = listener;
+}
+
+/**
+ * @brief Cooldown after a crossing before the next one may be detected
+ */
+uint32_t lapEngineMinCrossingUs() {
+  return g_lapMinCrossingUs;
+}
+
+/**
+ * @brief Drain crossings, update the statistics and write the flash log (WiFiTask)
+ */
+void lapEngineService() {
+  if (g_lapQueue == NULL) {
+    return;
+  }
+
+  uint8_t requestedSectors = g_lapRequestedSectors;
+  if (g_lapNewSessionRequested || requestedSectors != 0) {
+    g_lapNewSessionRequested = false;
+    g_lapRequestedSectors = 0;
+    if (!isOtaInProgress()) {
+      lapLogFlush();    /* Close the old session with every lap it has */
+    }
+    if (requestedSectors != 0 && requestedSectors != g_lap.sectorCount) {
+      g_lap.sectorCount = requestedSectors;
+      Preferences pref;
+      if (pref.begin(LAP_PREF_NAMESPACE, false)) {
+        pref.putUChar(LAP_PREF_SECTORS, requestedSectors);
+        pref.end();
+      }
+    }
+    lapStartSession();
+  }
+
+  uint32_t timestampUs;
+  while (xQueueReceive(g_lapQueue, &timestampUs, 0) == pdTRUE) {
+    lapHandleCrossing(timestampUs);
+  }
+
+  uint32_t nowMs = millis();
+  if (g_lap.running && (nowMs - g_lap.lastCrossingMs) >= LAP_ENGINE_STALE_MS) {
+    /* Crash or pit stop: the next crossing starts a fresh lap */
+    g_lap.running = false;
+    g_lap.sector = 0;
+    g_escVar.lapStartTime_ms = 0;
+    lapPublishProgress();
+  }
+
+  portENTER_CRITICAL(&g_lapMux);
+  uint32_t unlogged = g_lapStats.lapCount - g_lapStats.loggedLaps;
+  portEXIT_CRITICAL(&g_lapMux);
+  bool idle = (nowMs - g_lap.lastCrossingMs) >= LAP_LOG_FLUSH_IDLE_MS;
+  bool retryDue = (nowMs - g_lap.lastFlushAttemptMs) >= LAP_LOG_FLUSH_IDLE_MS;
+  if (unlogged > 0 && retryDue && (unlogged >= LAP_LOG_FLUSH_LAPS || idle) && !isOtaInProgress()) {
+    lapLogFlush();
+  }
+}
+
+/**
+ * @brief Finish the current session (its laps stay in the log) and start a new one
+ */
+void lapEngineNewSession() {
+  g_lapNewSessionRequested = true;
+}
+
+/**
+ * @brief Change the number of dead spots per lap; starts a new session
+ */
+bool lapEngineSetSectorCount(uint8_t sectors) {
+  if (sectors < 1 || sectors > LAP_ENGINE_MAX_SECTORS) {
+    return false;
+  }
+  g_lapRequestedSectors = sectors;
+  return true;
+}
+
+uint8_t lapEngineGetSectorCount() {
+  uint8_t requested = g_lapRequestedSectors;
+  if (requested != 0) {
+    return requested;
+  }
+  portENTER_CRITICAL(&g_lapMux);
+  uint8_t sectors = g_lapStats.sectorCount;
+  portEXIT_CRITICAL(&g_lapMux);
+  return sectors;
+}
+
+void lapEngineGetStats(LapStats_type* out) {
+  if (out == nullptr) return;
+  uint32_t nowUs = micros();
+  portENTER_CRITICAL(&g_lapMux);
+  *out = g_lapStats;
+  out->currentLapUs = g_lapRunning ? (nowUs - g_lapStartUs) : 0;
+  portEXIT_CRITICAL(&g_lapMux);
+}
+
+/**
+ * @brief Copy the most recent laps, oldest first
+ */
+size_t lapEngineCopyRecent(LapRecord_type* out, size_t maxRecords) {
+  if (out == nullptr || maxRecords == 0) return 0;
+  portENTER_CRITICAL(&g_lapMux);
+  uint32_t lapCount = g_lapStats.lapCount;
+  size_t count = min((size_t)min(lapCount, (uint32_t)LAP_ENGINE_RECENT_LAPS), maxRecords);
+  uint32_t first = lapCount - count;
+  for (size_t i = 0; i < count; i++) {
+    out[i] = g_lapRecent[(first + i) % LAP_ENGINE_RECENT_LAPS];
+  }
+  portEXIT_CRITICAL(&g_lapMux);
+  return count;
+}
+
+/**
+ * @brief List the sessions in the flash log, oldest first
+ */
+uint8_t lapEngineListSessions(LapSessionInfo_type* out, uint8_t maxSessions) {
+  if (out == nullptr || maxSessions == 0 || !SPIFFS.begin(false)) return 0;
+  uint32_t ids[LAP_LOG_SCAN_MAX];
+  uint8_t count = lapLogScan(ids, LAP_LOG_SCAN_MAX);
+  uint8_t first = (count > maxSessions) ? (uint8_t)(count - maxSessions) : 0;
+  uint8_t listed = 0;
+  char path[LAP_LOG_PATH_MAX];
+  for (uint8_t i = first; i < count; i++) {
+    lapLogPath(ids[i], path, sizeof(path));
+    File f = SPIFFS.open(path, FILE_READ);
+    LapLogHeader_type header;
+    if (!f) continue;
+    if (f.read((uint8_t*)&header, sizeof(header)) == sizeof(header) && header.magic == LAP_LOG_MAGIC &&
+        header.recordSize == sizeof(LapRecord_type)) {
+      out[listed].sessionId = header.sessionId;
+      out[listed].sectorCount = header.sectorCount;
+      out[listed].lapCount = (f.size() - sizeof(header)) / sizeof(LapRecord_type);
+      listed++;
+    }
+    f.close();
+  }
+  return listed;
+}
+
+/**
+ * @brief Read logged laps of a session starting at firstIndex (0-based)
+ * @param outTotal Laps in the session's log file
+ */
+size_t lapEngineReadLog(uint32_t sessionId, uint32_t firstIndex, LapRecord_type* out, size_t maxRecords,
+                        uint32_t* outTotal) {
+  if (outTotal != nullptr) *outTotal = 0;
+  if (out == nullptr || !SPIFFS.begin(false)) return 0;
+  char path[LAP_LOG_PATH_MAX];
+  lapLogPath(sessionId, path, sizeof(path));
+  File f = SPIFFS.open(path, FILE_READ);
+  if (!f) return 0;
+
+  LapLogHeader_type header;
+  size_t count = 0;
+  if (f.read((uint8_t*)&header, sizeof(header)) == sizeof(header) && header.magic == LAP_LOG_MAGIC &&
+      header.recordSize == sizeof(LapRecord_type)) {
+    uint32_t total = (f.size() - sizeof(header)) / sizeof(LapRecord_type);
+    if (outTotal != nullptr) *outTotal = total;
+    if (firstIndex < total && f.seek(sizeof(header) + firstIndex * sizeof(LapRecord_type))) {
+      count = min((size_t)(total - firstIndex), maxRecords);
+      count = f.read((uint8_t*)out, count * sizeof(LapRecord_type)) / sizeof(LapRecord_type);
+    }
+  }
+  f.close();
+  return count;
+}
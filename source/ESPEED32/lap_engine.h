@@ -0,0 +1,106 @@
+#ifndef LAP_ENGINE_H_
+#define LAP_ENGINE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Lap timing engine.
+ * Task2 only detects dead-spot crossings and posts their micros() timestamp
+ * (lapEngineCrossing); everything else runs in lapEngineService() on WiFiTask:
+ *   - with N sectors per lap every crossing closes a sector and every Nth one a lap;
+ *     the first crossing of a session (or after LAP_ENGINE_STALE_MS without one) is the line
+ *   - session best/mean/stddev and a rolling window over the last LAP_ENGINE_ROLLING_LAPS
+ *     laps are updated per lap, never recomputed
+ *   - laps are appended to /laps/sNNNNN.lap on SPIFFS in batches (every LAP_LOG_FLUSH_LAPS
+ *     laps or once the car has been idle for LAP_LOG_FLUSH_IDLE_MS), so the history
+ *     survives reboots; the oldest sessions are deleted to keep LAP_LOG_MIN_FREE_BYTES free.
+ * g_escVar.lapCount/lapTimes/bestLapTime_ms/lapStartTime_ms keep being filled for the
+ * screens. Log file: LapLogHeader_type followed by LapRecord_type entries.
+ * A SPIFFS firmware-UI update formats the partition and so drops the lap history. */
+#define LAP_ENGINE_MAX_SECTORS      4
+#define LAP_ENGINE_QUEUE_LEN        8
+#define LAP_ENGINE_RECENT_LAPS      32      /* Laps kept in RAM for /api/laps and the serial LAPS reply */
+#define LAP_ENGINE_ROLLING_LAPS     10
+#define LAP_ENGINE_MIN_SECTOR_MS    800     /* Crossing cooldown with more than one sector (LAP_MIN_TIME_MS otherwise) */
+#define LAP_ENGINE_STALE_MS         60000UL /* Car stopped: drop the lap in progress */
+
+#define LAP_LOG_DIR                 "/laps"
+#define LAP_LOG_MAGIC               0x4C323345UL  /* "E32L" */
+#define LAP_LOG_VERSION             1
+#define LAP_LOG_MAX_SESSIONS        24
+#define LAP_LOG_FLUSH_LAPS          8
+#define LAP_LOG_FLUSH_IDLE_MS       5000UL
+#define LAP_LOG_MIN_FREE_BYTES      65536UL
+
+typedef struct {
+  uint32_t magic;           /* LAP_LOG_MAGIC */
+  uint8_t version;
+  uint8_t sectorCount;
+  uint16_t recordSize;      /* sizeof(LapRecord_type) */
+  uint32_t sessionId;
+} LapLogHeader_type;
+
+typedef struct {
+  uint32_t lapUs;
+  uint32_t sectorUs[LAP_ENGINE_MAX_SECTORS];   /* Unused sectors are 0 */
+  uint32_t endMs;           /* [ms] Since the session started */
+  uint16_t lapNumber;       /* 1-based within the session */
+  uint8_t sectorCount;
+  uint8_t carIndex;
+} LapRecord_type;
+
+typedef struct {
+  uint32_t sessionId;
+  uint32_t lapCount;
+  uint32_t loggedLaps;      /* Laps already in the flash log */
+  uint32_t lastLapUs;
+  uint32_t bestLapUs;
+  uint32_t meanLapUs;
+  uint32_t stddevLapUs;     /* Consistency over the whole session */
+  uint32_t rollingMeanUs;
+  uint32_t rollingStddevUs;
+  uint32_t bestSectorUs[LAP_ENGINE_MAX_SECTORS];
+  uint32_t theoreticalBestUs; /* Sum of the best sectors, 0 until every sector has a time */
+  uint32_t currentLapUs;    /* Time into the lap in progress, 0 if none */
+  uint8_t rollingCount;
+  uint8_t sectorCount;
+  uint8_t currentSector;    /* Sector the car is in (0-based) */
+  bool logAvailable;        /* Last flash log write succeeded */
+} LapStats_type;
+
+typedef struct {
+  uint32_t sessionId;
+  uint32_t lapCount;
+  uint8_t sectorCount;
+} LapSessionInfo_type;
+
+/* One dead-spot crossing as seen by lapEngineService(), handed to the crossing listener */
+typedef struct {
+  uint32_t timestampUs;     /* micros() at detection (Task2) */
+  uint32_t lapUs;           /* Lap just completed, 0 if the crossing only closed a sector or was the line */
+  uint32_t sectorUs;        /* Sector just closed, 0 at the line */
+  uint16_t lapNumber;       /* Lap the car is now on (1-based), 0 if no lap is running */
+  uint8_t sector;           /* Sector the crossing closed (0-based) */
+  uint8_t sectorCount;
+  uint8_t carIndex;
+} LapCrossing_type;
+
+typedef void (*LapCrossing_fn)(const LapCrossing_type* crossing);
+
+void lapEngineBegin();
+void lapEngineService();
+void lapEngineCrossing(uint32_t timestampUs);
+uint32_t lapEngineMinCrossingUs();
+void lapEngineSetCrossingListener(LapCrossing_fn listener);
+
+void lapEngineNewSession();
+bool lapEngineSetSectorCount(uint8_t sectors);
+uint8_t lapEngineGetSectorCount();
+
+void lapEngineGetStats(LapStats_type* out);
+size_t lapEngineCopyRecent(LapRecord_type* out, size_t maxRecords);
+uint8_t lapEngineListSessions(LapSessionInfo_type* out, uint8_t maxSessions);
+size_t lapEngineReadLog(uint32_t sessionId, uint32_t firstIndex, LapRecord_type* out, size_t maxRecords,
+                        uint32_t* outTotal);
+
+#endif  /* LAP_ENGINE_H_ */
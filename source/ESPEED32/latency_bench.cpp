@@ -0,0 +1,504 @@
+#include "latency_bench.h"
+#include <Arduino.h>
+#include <WiFi.h>
+#include <string.h>
+#include <esp_random.h>
+#include <driver/gpio.h>
+#include <soc/gpio_periph.h>
+#include <soc/gpio_reg.h>
+#include "HAL.h"
+#include "trigger_lut.h"
+#include "active_tuning.h"
+#include "telemetry_logging.h"
+#include "motor_sweep.h"
+#include "current_sampler.h"
+
+extern StoredVar_type g_storedVar;
+
+static_assert(HB_IN_PIN < 32, "the edge ISR reads HB_IN_PIN from GPIO_IN_REG");
+static_assert(LATENCY_BENCH_LOW_PCT < LATENCY_BENCH_HIGH_PCT && LATENCY_BENCH_HIGH_PCT <= 100,
+              "LATENCY_BENCH_*_PCT out of range");
+
+#define LATENCY_BENCH_PRESS_PCT  10U   /* A real reading past this much travel aborts the run */
+
+typedef enum {
+  LATENCY_BENCH_PHASE_SETTLE,
+  LATENCY_BENCH_PHASE_ARMED
+} LatencyBenchPhase_enum;
+
+typedef enum {
+  LATENCY_BENCH_STEP_PENDING,
+  LATENCY_BENCH_STEP_DETECTED,
+  LATENCY_BENCH_STEP_TIMEOUT
+} LatencyBenchStep_enum;
+
+/* Edge capture state for the step being timed; ISR and control task, under g_benchCapMux.
+ * Times are the low 32 bits of esp_timer_get_time(), the clock behind micros(). */
+typedef struct {
+  uint32_t stepAt_us;
+  uint32_t threshold_us;        /* Width change that counts */
+  uint32_t lastRise_us;
+  uint32_t baseWidth_us;        /* Last complete pulse that started before the step */
+  uint32_t detect_us;
+  uint32_t edges;
+  bool haveRise;
+  bool levelHigh;               /* Pad level after the last edge */
+  bool baseValid;
+  bool detected;
+} LatencyBenchCapture_type;
+
+/* Published to Task1 / WiFiTask under g_benchMux */
+static portMUX_TYPE g_benchMux = portMUX_INITIALIZER_UNLOCKED;
+static LatencyBenchRun_type g_benchRuns[LATENCY_BENCH_RUNS];
+static uint8_t g_benchCurrent = 0;          /* Slot of the newest run */
+static uint32_t g_benchNextId = 1;
+static volatile bool g_benchStartRequested = false;
+static volatile bool g_benchCancelRequested = false;
+static bool g_benchCaptureInstalled = false;
+
+/* Injection: the control task sets up a step, the trigger sampler applies it, under g_benchInjectMux */
+static portMUX_TYPE g_benchInjectMux = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool g_injectActive = false;
+static volatile bool g_injectRealPress = false;
+static int16_t g_injectLevel = 0;
+static int16_t g_injectNext = 0;
+static uint32_t g_injectStepAt_us = 0;
+static bool g_injectStepPending = false;
+static int16_t g_benchMinRaw = 0;
+static int16_t g_benchMaxRaw = 0;
+
+static portMUX_TYPE g_benchCapMux = portMUX_INITIALIZER_UNLOCKED;
+static LatencyBenchCapture_type g_capture;
+
+/* Control task only */
+static bool g_benchRunning = false;
+static uint8_t g_benchPhase = LATENCY_BENCH_PHASE_SETTLE;
+static bool g_benchStepUp = true;
+static uint16_t g_benchSteps = 0;
+static uint16_t g_benchStepsDone = 0;
+static int16_t g_benchLowRaw = 0;
+static int16_t g_benchHighRaw = 0;
+static uint32_t g_benchPeriod_us = 0;       /* PWM period of the step being timed */
+static uint32_t g_benchStart_ms = 0;
+static uint32_t g_benchPhaseStart_ms = 0;
+
+/**
+ * @brief Both edges of HB_IN_PIN while a step is armed
+ * @details A pulse starting before the step refreshes the baseline width; the first one after
+ *          it that differs by more than the threshold is the output change. With no baseline
+ *          (the output was flat at 0 or 100%) any edge after the step is the change.
+ */
+static void IRAM_ATTR latencyBenchEdgeISR(void* arg) {
+  (void)arg;
+  uint32_t now_us = (uint32_t)esp_timer_get_time();
+  bool high = ((REG_READ(GPIO_IN_REG) >> HB_IN_PIN) & 1U) != 0;
+  portENTER_CRITICAL_ISR(&g_benchCapMux);
+  LatencyBenchCapture_type* c = &g_capture;
+  c->edges++;
+  if (!c->detected) {
+    bool afterStep = (int32_t)(now_us - c->stepAt_us) >= 0;
+    if (afterStep && !c->baseValid) {
+      c->detected = true;
+      c->detect_us = now_us;
+    } else if (high) {
+      c->lastRise_us = now_us;
+      c->haveRise = true;
+    } else if (c->haveRise) {
+      uint32_t width_us = now_us - c->lastRise_us;
+      if ((int32_t)(c->lastRise_us - c->stepAt_us) < 0) {
+        c->baseWidth_us = width_us;
+        c->baseValid = true;
+      } else {
+        uint32_t diff_us = (width_us > c->baseWidth_us) ? width_us - c->baseWidth_us : c->baseWidth_us - width_us;
+        if (diff_us > c->threshold_us) {
+          c->detected = true;
+          c->detect_us = c->lastRise_us;
+        }
+      }
+    }
+  }
+  c->levelHigh = high;
+  portEXIT_CRITICAL_ISR(&g_benchCapMux);
+}
+
+/**
+ * @brief Borrow the HB_IN_PIN interrupt from the current sampler for one run (Task1)
+ * @details The sampler reads free-running meanwhile; latencyBenchReleaseCapture() puts its
+ *          rising-edge handler back when the run ends.
+ */
+static bool latencyBenchInstallCapture() {
+  if (g_benchCaptureInstalled) {
+    return true;
+  }
+  esp_err_t err = gpio_install_isr_service(0);
+  if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {  /* Already installed by the back-EMF sampler is fine */
+    return false;
+  }
+  if (!currentSamplerLendEdgeInterrupt()) {
+    return false;
+  }
+  gpio_intr_disable((gpio_num_t)HB_IN_PIN);
+  gpio_set_intr_type((gpio_num_t)HB_IN_PIN, GPIO_INTR_ANYEDGE);
+  if (gpio_isr_handler_add((gpio_num_t)HB_IN_PIN, latencyBenchEdgeISR, NULL) != ESP_OK) {
+    currentSamplerReturnEdgeInterrupt();
+    return false;
+  }
+  gpio_intr_disable((gpio_num_t)HB_IN_PIN);
+  g_benchCaptureInstalled = true;
+  return true;
+}
+
+/* End of a run (control task): the pin interrupt goes back to the current sampler */
+static void latencyBenchReleaseCapture() {
+  gpio_intr_disable((gpio_num_t)HB_IN_PIN);
+  gpio_isr_handler_remove((gpio_num_t)HB_IN_PIN);
+  currentSamplerReturnEdgeInterrupt();
+  g_benchCaptureInstalled = false;
+}
+
+/* Raw reading at pct of the calibrated travel from the released end */
+static int16_t latencyBenchLevelRaw(uint32_t pct, int16_t minRaw, int16_t maxRaw) {
+  int32_t offset = (((int32_t)maxRaw - minRaw) * (int32_t)pct) / 100;
+  return (int16_t)(THROTTLE_REV ? (int32_t)maxRaw - offset : (int32_t)minRaw + offset);
+}
+
+/**
+ * @brief Ask the control task to start a run (Task1 or the serial handler)
+ * @param steps Steps to time, alternating up and down; 0 = LATENCY_BENCH_STEPS_DEFAULT
+ * @return LATENCY_BENCH_OK, or why it cannot run
+ */
+uint8_t latencyBenchStart(uint16_t steps) {
+  if (steps == 0) steps = LATENCY_BENCH_STEPS_DEFAULT;
+  if (steps > LATENCY_BENCH_STEPS_MAX) steps = LATENCY_BENCH_STEPS_MAX;
+
+  int16_t minRaw = g_storedVar.minTrigger_raw;
+  int16_t maxRaw = g_storedVar.maxTrigger_raw;
+  int16_t lowRaw = latencyBenchLevelRaw(LATENCY_BENCH_LOW_PCT, minRaw, maxRaw);
+  int16_t highRaw = latencyBenchLevelRaw(LATENCY_BENCH_HIGH_PCT, minRaw, maxRaw);
+  uint16_t lowNorm = triggerLutLookup(lowRaw, minRaw, maxRaw);
+  if (maxRaw <= minRaw || lowNorm == 0 || triggerLutLookup(highRaw, minRaw, maxRaw) <= lowNorm) {
+    return LATENCY_BENCH_ERR_NOT_CALIBRATED;
+  }
+  if (motorSweepActive() || latencyBenchActive()) {
+    return LATENCY_BENCH_ERR_BUSY;   /* A running bench owns the capture; leave it alone */
+  }
+  if (!latencyBenchInstallCapture()) {
+    return LATENCY_BENCH_ERR_NO_CAPTURE;
+  }
+
+  LatencyBenchConfig_type config;
+  memset(&config, 0, sizeof(config));
+  ActiveTuning_type tuning;
+  activeTuningGetPublished(&tuning);
+  TelemetryStatus telemetry;
+  telemetryGetStatus(&telemetry);
+  config.filterMode = TRIGGER_FILTER_MODE;
+  config.antiSpinMode = (uint8_t)tuning.antiSpinMode;
+  config.antiSpin_ms = tuning.antiSpin;
+  config.carIndex = tuning.carIndex;
+  config.telemetryLogging = telemetry.loggingActive;
+  config.telemetryInterval_us = telemetry.sampleIntervalUs;
+  config.radioOn = (WiFi.getMode() != WIFI_OFF);
+  config.pwmFreq_hz = (uint16_t)ledcReadFreq(HB_IN_PIN);
+  config.cpuFreq_mhz = (uint16_t)getCpuFrequencyMhz();
+
+  portENTER_CRITICAL(&g_benchMux);
+  LatencyBenchRun_type* current = &g_benchRuns[g_benchCurrent];
+  if (g_benchStartRequested || current->state == LATENCY_BENCH_RUNNING) {
+    portEXIT_CRITICAL(&g_benchMux);
+    return LATENCY_BENCH_ERR_BUSY;
+  }
+  if (current->id != 0) {
+    g_benchCurrent = (uint8_t)((g_benchCurrent + 1U) % LATENCY_BENCH_RUNS);
+  }
+  LatencyBenchRun_type* run = &g_benchRuns[g_benchCurrent];
+  memset(run, 0, sizeof(*run));
+  run->id = g_benchNextId++;
+  run->state = LATENCY_BENCH_RUNNING;
+  run->steps = steps;
+  run->lowRaw = lowRaw;
+  run->highRaw = highRaw;
+  run->config = config;
+  run->rise.min_us = UINT32_MAX;
+  run->fall.min_us = UINT32_MAX;
+  g_benchMinRaw = minRaw;
+  g_benchMaxRaw = maxRaw;
+  g_benchCancelRequested = false;
+  g_benchStartRequested = true;
+  portEXIT_CRITICAL(&g_benchMux);
+  return LATENCY_BENCH_OK;
+}
+
+/**
+ * @brief Stop a running bench; the control task hands the trigger back on its next tick
+ */
+void latencyBenchCancel() {
+  portENTER_CRITICAL(&g_benchMux);
+  if (g_benchStartRequested || g_benchRuns[g_benchCurrent].state == LATENCY_BENCH_RUNNING) {
+    g_benchCancelRequested = true;
+  }
+  portEXIT_CRITICAL(&g_benchMux);
+}
+
+bool latencyBenchActive() {
+  return g_benchRunning || g_benchStartRequested;
+}
+
+/**
+ * @brief Reading the trigger sampler publishes (sampler task, right after HAL_ReadTriggerRaw())
+ * @param raw Sensor reading, checked for a real press
+ * @param readStart_us micros() before the read: a step at or before it is what the sensor sees
+ */
+int16_t latencyBenchTriggerRaw(int16_t raw, uint32_t readStart_us) {
+  if (!g_injectActive) {
+    return raw;
+  }
+  if (triggerLutLookup(raw, g_benchMinRaw, g_benchMaxRaw) > (THROTTLE_NORMALIZED * LATENCY_BENCH_PRESS_PCT) / 100U) {
+    g_injectRealPress = true;
+  }
+  portENTER_CRITICAL(&g_benchInjectMux);
+  if (g_injectStepPending && (int32_t)(readStart_us - g_injectStepAt_us) >= 0) {
+    g_injectLevel = g_injectNext;
+    g_injectStepPending = false;
+  }
+  int16_t level = g_injectLevel;
+  bool active = g_injectActive;
+  portEXIT_CRITICAL(&g_benchInjectMux);
+  return active ? level : raw;
+}
+
+static void latencyBenchFinish(uint8_t state, uint8_t error, uint32_t now_ms) {
+  latencyBenchReleaseCapture();
+  g_benchRunning = false;
+  g_benchCancelRequested = false;
+  portENTER_CRITICAL(&g_benchInjectMux);
+  g_injectActive = false;
+  g_injectStepPending = false;
+  portEXIT_CRITICAL(&g_benchInjectMux);
+  portENTER_CRITICAL(&g_benchMux);
+  LatencyBenchRun_type* run = &g_benchRuns[g_benchCurrent];
+  run->state = state;
+  run->error = error;
+  run->elapsed_ms = now_ms - g_benchStart_ms;
+  portEXIT_CRITICAL(&g_benchMux);
+}
+
+/* Baseline for LATENCY_BENCH_LEAD_PERIODS, then the step at a random point of the control period */
+static void latencyBenchArmStep(uint32_t controlPeriod_us) {
+  uint32_t freq_hz = ledcReadFreq(HB_IN_PIN);
+  g_benchPeriod_us = (freq_hz > 0) ? (1000000UL / freq_hz) : (1000000UL / FREQ_MIN_VALUE);
+  PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[HB_IN_PIN]);  /* A PWM re-attach leaves the pad output-only */
+  uint32_t lead_us = g_benchPeriod_us * LATENCY_BENCH_LEAD_PERIODS +
+                     ((controlPeriod_us > 0) ? (esp_random() % controlPeriod_us) : 0);
+  uint32_t stepAt_us = (uint32_t)micros() + lead_us;
+
+  portENTER_CRITICAL(&g_benchCapMux);
+  memset(&g_capture, 0, sizeof(g_capture));
+  g_capture.stepAt_us = stepAt_us;
+  g_capture.threshold_us = (g_benchPeriod_us * LATENCY_BENCH_DETECT_PERMILLE) / 1000U;
+  g_capture.levelHigh = gpio_get_level((gpio_num_t)HB_IN_PIN) != 0;
+  portEXIT_CRITICAL(&g_benchCapMux);
+
+  portENTER_CRITICAL(&g_benchInjectMux);
+  g_injectNext = g_benchStepUp ? g_benchHighRaw : g_benchLowRaw;
+  g_injectStepAt_us = stepAt_us;
+  g_injectStepPending = true;
+  portEXIT_CRITICAL(&g_benchInjectMux);
+  gpio_intr_enable((gpio_num_t)HB_IN_PIN);
+}
+
+/**
+ * @brief Outcome of the armed step
+ * @details Catches what has no edge to interrupt on: a pulse held high past the baseline
+ *          (duty went to 100%) or a rising edge that never came (duty went to 0).
+ */
+static uint8_t latencyBenchPollStep(uint32_t* outLatency_us, uint32_t* outEdges) {
+  uint32_t now_us = (uint32_t)micros();
+  portENTER_CRITICAL(&g_benchCapMux);
+  LatencyBenchCapture_type* c = &g_capture;
+  if (!c->detected && c->baseValid && c->haveRise) {
+    uint32_t missedRise_us = c->lastRise_us + g_benchPeriod_us;
+    if (c->levelHigh && (int32_t)(c->lastRise_us - c->stepAt_us) >= 0 &&
+        now_us - c->lastRise_us > c->baseWidth_us + c->threshold_us) {
+      c->detected = true;
+      c->detect_us = c->lastRise_us;
+    } else if (!c->levelHigh && (int32_t)(missedRise_us - c->stepAt_us) >= 0 &&
+               now_us - c->lastRise_us > g_benchPeriod_us + c->threshold_us) {
+      c->detected = true;
+      c->detect_us = missedRise_us;
+    }
+  }
+  bool detected = c->detected;
+  uint32_t latency_us = (int32_t)(c->detect_us - c->stepAt_us) > 0 ? c->detect_us - c->stepAt_us : 0;
+  uint32_t stepAt_us = c->stepAt_us;
+  *outEdges = c->edges;
+  portEXIT_CRITICAL(&g_benchCapMux);
+
+  if (detected) {
+    *outLatency_us = latency_us;
+    return LATENCY_BENCH_STEP_DETECTED;
+  }
+  if ((int32_t)(now_us - stepAt_us) > (int32_t)LATENCY_BENCH_TIMEOUT_US) {
+    return LATENCY_BENCH_STEP_TIMEOUT;
+  }
+  return LATENCY_BENCH_STEP_PENDING;
+}
+
+static void latencyBenchRecord(LatencyBenchHist_type* hist, uint32_t latency_us) {
+  uint32_t bin = latency_us / LATENCY_BENCH_BIN_US;
+  if (bin > LATENCY_BENCH_BINS) bin = LATENCY_BENCH_BINS;
+  hist->bins[bin]++;
+  hist->count++;
+  hist->sum_us += latency_us;
+  if (latency_us < hist->min_us) hist->min_us = latency_us;
+  if (latency_us > hist->max_us) hist->max_us = latency_us;
+}
+
+/**
+ * @brief Bench sequencer (control task, every motor control cycle)
+ * @details Only moves the trigger: the duty is worked out by the normal pipeline.
+ * @param brakeButton Brake button held this cycle (aborts)
+ * @param controlPeriod_us Current control timer period, recorded and used to spread the step phase
+ */
+void latencyBenchControlTick(bool brakeButton, uint32_t controlPeriod_us) {
+  uint32_t now_ms = millis();
+  if (g_benchStartRequested) {
+    portENTER_CRITICAL(&g_benchMux);
+    LatencyBenchRun_type* run = &g_benchRuns[g_benchCurrent];
+    run->config.controlPeriod_us = controlPeriod_us;
+    g_benchSteps = run->steps;
+    g_benchLowRaw = run->lowRaw;
+    g_benchHighRaw = run->highRaw;
+    g_benchStartRequested = false;
+    portEXIT_CRITICAL(&g_benchMux);
+    g_benchRunning = true;
+    g_benchStepsDone = 0;
+    g_benchStepUp = true;
+    g_benchPhase = LATENCY_BENCH_PHASE_SETTLE;
+    g_benchStart_ms = now_ms;
+    g_benchPhaseStart_ms = now_ms;
+    portENTER_CRITICAL(&g_benchInjectMux);
+    g_injectLevel = g_benchLowRaw;
+    g_injectStepPending = false;
+    g_injectRealPress = false;
+    g_injectActive = true;
+    portEXIT_CRITICAL(&g_benchInjectMux);
+  }
+  if (!g_benchRunning) {
+    return;
+  }
+
+  if (g_benchCancelRequested) {
+    latencyBenchFinish(LATENCY_BENCH_ABORTED, LATENCY_BENCH_ERR_CANCELLED, now_ms);
+    return;
+  }
+  if (brakeButton || g_injectRealPress) {
+    latencyBenchFinish(LATENCY_BENCH_ABORTED, LATENCY_BENCH_ERR_INPUT, now_ms);
+    return;
+  }
+
+  if (g_benchPhase == LATENCY_BENCH_PHASE_SETTLE) {
+    if (now_ms - g_benchPhaseStart_ms < LATENCY_BENCH_SETTLE_MS) {
+      return;
+    }
+    if (g_benchStepsDone >= g_benchSteps) {
+      latencyBenchFinish(LATENCY_BENCH_DONE, LATENCY_BENCH_OK, now_ms);
+      return;
+    }
+    latencyBenchArmStep(controlPeriod_us);
+    g_benchPhase = LATENCY_BENCH_PHASE_ARMED;
+    return;
+  }
+
+  uint32_t latency_us = 0;
+  uint32_t edges = 0;
+  uint8_t outcome = latencyBenchPollStep(&latency_us, &edges);
+  if (outcome == LATENCY_BENCH_STEP_PENDING) {
+    return;
+  }
+  gpio_intr_disable((gpio_num_t)HB_IN_PIN);
+  g_benchStepsDone++;
+  portENTER_CRITICAL(&g_benchMux);
+  LatencyBenchRun_type* run = &g_benchRuns[g_benchCurrent];
+  LatencyBenchHist_type* hist = g_benchStepUp ? &run->rise : &run->fall;
+  if (outcome == LATENCY_BENCH_STEP_DETECTED) {
+    latencyBenchRecord(hist, latency_us);
+    run->lastLatency_us = latency_us;
+  } else {
+    hist->timeouts++;
+  }
+  run->stepsDone = g_benchStepsDone;
+  run->edges += edges;
+  run->elapsed_ms = now_ms - g_benchStart_ms;
+  portEXIT_CRITICAL(&g_benchMux);
+  g_benchStepUp = !g_benchStepUp;
+  g_benchPhase = LATENCY_BENCH_PHASE_SETTLE;
+  g_benchPhaseStart_ms = now_ms;
+}
+
+/**
+ * @brief Copy the kept runs, newest (or running) first
+ * @return Runs copied
+ */
+uint8_t latencyBenchCopyRuns(LatencyBenchRun_type* out, uint8_t maxRuns) {
+  if (out == nullptr) {
+    return 0;
+  }
+  uint8_t count = 0;
+  portENTER_CRITICAL(&g_benchMux);
+  for (uint8_t i = 0; i < LATENCY_BENCH_RUNS && count < maxRuns; i++) {
+    const LatencyBenchRun_type* run = &g_benchRuns[(g_benchCurrent + LATENCY_BENCH_RUNS - i) % LATENCY_BENCH_RUNS];
+    if (run->id == 0) {
+      break;
+    }
+    out[count++] = *run;
+  }
+  portEXIT_CRITICAL(&g_benchMux);
+  return count;
+}
+
+/**
+ * @brief Latency below which permille of the detected steps fall
+ * @return Upper edge of the bin holding that step, within [min, max]; 0 without steps
+ */
+uint32_t latencyBenchPercentile(const LatencyBenchHist_type* hist, uint16_t permille) {
+  if (hist == nullptr || hist->count == 0) {
+    return 0;
+  }
+  uint32_t target = ((uint32_t)hist->count * permille + 999U) / 1000U;
+  if (target == 0) target = 1;
+  uint32_t seen = 0;
+  for (uint32_t bin = 0; bin <= LATENCY_BENCH_BINS; bin++) {
+    seen += hist->bins[bin];
+    if (seen >= target) {
+      if (bin == LATENCY_BENCH_BINS) {
+        return hist->max_us;
+      }
+      uint32_t edge_us = (bin + 1U) * LATENCY_BENCH_BIN_US;
+      if (edge_us > hist->max_us) edge_us = hist->max_us;
+      if (edge_us < hist->min_us) edge_us = hist->min_us;
+      return edge_us;
+    }
+  }
+  return hist->max_us;
+}
+
+const char* latencyBenchErrorText(uint8_t error) {
+  switch (error) {
+    case LATENCY_BENCH_OK:                 return "OK";
+    case LATENCY_BENCH_ERR_NOT_CALIBRATED: return "calibrate trigger";
+    case LATENCY_BENCH_ERR_BUSY:           return "busy";
+    case LATENCY_BENCH_ERR_NO_CAPTURE:     return "no edge capture";
+    case LATENCY_BENCH_ERR_INPUT:          return "trigger/brake used";
+    case LATENCY_BENCH_ERR_CANCELLED:      return "cancelled";
+    default:                               return "error";
+  }
+}
+
+const char* latencyBenchFilterLabel(uint8_t filterMode) {
+  switch (filterMode) {
+    case TRIGGER_FILTER_ADAPTIVE: return "ADAPTIVE";
+    case TRIGGER_FILTER_AVG2:     return "AVG2";
+    default:                      return "NONE";
+  }
+}
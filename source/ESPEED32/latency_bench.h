@@ -0,0 +1,114 @@
+#ifndef LATENCY_BENCH_H_
+#define LATENCY_BENCH_H_
+
+#include <stdint.h>
+#include "slot_ESC.h"
+
+/* Trigger-to-PWM latency bench (control task + trigger sampler + GPIO capture).
+ * While a run is active the trigger sampler hands the control loop a synthetic reading
+ * instead of the sensor's: the trigger sits at LATENCY_BENCH_LOW_PCT or LATENCY_BENCH_HIGH_PCT
+ * of the calibrated travel and steps to the other level at a random point of the control
+ * period (a read that starts at or after the step time sees the new level, as it would for
+ * a real trigger moving then). Everything after HAL_ReadTriggerRaw() runs unchanged: filter,
+ * LUT, curve, anti-spin, release brake, telemetry capture and the LEDC duty write.
+ * HB_IN_PIN carries the duty, so a GPIO interrupt on both of its edges, enabled only around
+ * each step, times the pulses (the current sampler lends its rising-edge interrupt on the pin
+ * for the run and reads free-running until it gets it back): pulses starting before the step set the baseline width, and
+ * the first one after it whose width moves by more than LATENCY_BENCH_DETECT_PERMILLE of the
+ * PWM period marks the output change (its rising edge, i.e. the period in which the LEDC
+ * latched the new duty). A duty of 0 or 100% has no edges, so a missing or overlong pulse is
+ * caught by polling from the control tick. Steps alternate up (rise) and down (fall), each
+ * into its own histogram of LATENCY_BENCH_BIN_US bins. Every run records the pipeline
+ * configuration it ran with (filter, anti-spin, telemetry rate, control period, PWM
+ * frequency, CPU clock, radio), and the last LATENCY_BENCH_RUNS runs are kept so settings or
+ * firmware builds can be compared side by side.
+ * The motor is driven: lift the car. The brake button, a real trigger press or a cancel
+ * aborts at once and hands the trigger back. */
+#ifndef LATENCY_BENCH_STEPS_DEFAULT
+#define LATENCY_BENCH_STEPS_DEFAULT    100U
+#endif
+#define LATENCY_BENCH_STEPS_MAX        1000U
+#ifndef LATENCY_BENCH_LOW_PCT
+#define LATENCY_BENCH_LOW_PCT          30U     /* [%] Trigger travel of the two levels */
+#endif
+#ifndef LATENCY_BENCH_HIGH_PCT
+#define LATENCY_BENCH_HIGH_PCT         70U
+#endif
+#define LATENCY_BENCH_SETTLE_MS        200U    /* Hold between steps; output settles, ramps finish */
+#define LATENCY_BENCH_LEAD_PERIODS     4U      /* PWM periods of baseline captured before a step */
+#define LATENCY_BENCH_TIMEOUT_US       50000UL /* No output change this long after a step: timeout */
+#ifndef LATENCY_BENCH_DETECT_PERMILLE
+#define LATENCY_BENCH_DETECT_PERMILLE  50U     /* Pulse width change that counts, of the PWM period */
+#endif
+#define LATENCY_BENCH_BIN_US           100U
+#define LATENCY_BENCH_BINS             32U     /* Plus one overflow bin */
+#define LATENCY_BENCH_RUNS             4U
+
+typedef enum {
+  LATENCY_BENCH_IDLE,
+  LATENCY_BENCH_RUNNING,
+  LATENCY_BENCH_DONE,
+  LATENCY_BENCH_ABORTED
+} LatencyBenchState_enum;
+
+typedef enum {
+  LATENCY_BENCH_OK,
+  LATENCY_BENCH_ERR_NOT_CALIBRATED,   /* Trigger span too small for two distinct levels */
+  LATENCY_BENCH_ERR_BUSY,             /* A bench or motor sweep is running */
+  LATENCY_BENCH_ERR_NO_CAPTURE,       /* Edge interrupt could not be installed */
+  LATENCY_BENCH_ERR_INPUT,            /* Trigger or brake button */
+  LATENCY_BENCH_ERR_CANCELLED
+} LatencyBenchError_enum;
+
+/**
+ * @brief Pipeline configuration a run was measured with
+ */
+typedef struct {
+  uint8_t filterMode;             /* TRIGGER_FILTER_* (compile time) */
+  uint8_t antiSpinMode;           /* ANTISPIN_MODE_* */
+  uint16_t antiSpin_ms;
+  uint8_t carIndex;
+  bool telemetryLogging;
+  bool radioOn;                   /* WiFi or ESP-NOW up during the run */
+  uint32_t telemetryInterval_us;  /* Capture interval of the logger */
+  uint32_t controlPeriod_us;      /* Control timer period when the run started */
+  uint16_t pwmFreq_hz;
+  uint16_t cpuFreq_mhz;
+} LatencyBenchConfig_type;
+
+typedef struct {
+  uint16_t count;                 /* Steps with a detected output change */
+  uint16_t timeouts;
+  uint32_t min_us;                /* UINT32_MAX while count is 0 */
+  uint32_t max_us;
+  uint32_t sum_us;
+  uint16_t bins[LATENCY_BENCH_BINS + 1U];  /* Last bin: LATENCY_BENCH_BINS * BIN_US and above */
+} LatencyBenchHist_type;
+
+typedef struct {
+  uint32_t id;                    /* Increments per run since boot, 0 = empty slot */
+  uint8_t state;                  /* LatencyBenchState_enum */
+  uint8_t error;                  /* LatencyBenchError_enum, why it aborted */
+  uint16_t steps;                 /* Requested */
+  uint16_t stepsDone;
+  int16_t lowRaw;                 /* Injected readings */
+  int16_t highRaw;
+  uint32_t lastLatency_us;
+  uint32_t elapsed_ms;
+  uint32_t edges;                 /* Edge interrupts taken */
+  LatencyBenchConfig_type config;
+  LatencyBenchHist_type rise;     /* Low -> high trigger */
+  LatencyBenchHist_type fall;     /* High -> low trigger */
+} LatencyBenchRun_type;
+
+uint8_t latencyBenchStart(uint16_t steps);
+void latencyBenchCancel();
+bool latencyBenchActive();
+void latencyBenchControlTick(bool brakeButton, uint32_t controlPeriod_us);
+int16_t latencyBenchTriggerRaw(int16_t raw, uint32_t readStart_us);
+uint8_t latencyBenchCopyRuns(LatencyBenchRun_type* out, uint8_t maxRuns);
+uint32_t latencyBenchPercentile(const LatencyBenchHist_type* hist, uint16_t permille);
+const char* latencyBenchErrorText(uint8_t error);
+const char* latencyBenchFilterLabel(uint8_t filterMode);
+
+#endif  /* LATENCY_BENCH_H_ */
@@ -0,0 +1,442 @@
+#include "live_push.h"
+#include <Arduino.h>
+#include <WiFi.h>
+#include <string.h>
+#include <esp_random.h>
+#include <mbedtls/base64.h>
+#include <mbedtls/sha1.h>
+#include "slot_ESC.h"
+#include "telemetry_logging.h"
+#include "telemetry_frame.h"
+
+extern ESC_type g_escVar;
+
+#define LIVE_PUSH_REQ_MAX     640U   /* Upgrade request incl. browser headers */
+#define LIVE_PUSH_RX_MAX      64U    /* Client messages are "ack" / "after <seq>" */
+#define LIVE_PUSH_WS_GUID     "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+
+#define LIVE_PUSH_OP_TEXT     0x1U
+#define LIVE_PUSH_OP_BINARY   0x2U
+#define LIVE_PUSH_OP_CLOSE    0x8U
+#define LIVE_PUSH_OP_PING     0x9U
+#define LIVE_PUSH_OP_PONG     0xAU
+
+typedef enum {
+  LIVE_PUSH_SLOT_FREE,
+  LIVE_PUSH_SLOT_HANDSHAKE,
+  LIVE_PUSH_SLOT_OPEN
+} LivePushSlotState_enum;
+
+/* Fields compared to decide whether a runtime snapshot is worth sending.
+ * Vin and current are quantized so ADC noise alone does not trigger pushes. */
+typedef struct {
+  uint8_t outputPct;
+  uint8_t triggerPct;
+  uint8_t brakeKind;
+  uint8_t brakePct;
+  uint8_t triggerStale;
+  uint16_t vinStep;      /* Vin_mV / 100 */
+  uint16_t currentStep;  /* motorCurrent_mA / 50 */
+  uint16_t lapCount;
+  uint32_t bestLap_ms;
+} LivePushRuntimeKey_type;
+
+typedef struct {
+  WiFiClient client;
+  LivePushSlotState_enum state;
+  uint32_t openedMs;
+  char req[LIVE_PUSH_REQ_MAX + 1];
+  uint16_t reqLen;
+  uint8_t rx[LIVE_PUSH_RX_MAX + 14];
+  uint16_t rxLen;
+  bool hasAfterSeq;
+  uint32_t afterSeq;
+  uint32_t sessionId;
+  uint8_t unacked;
+  uint32_t lastAckMs;
+  uint32_t lastFrameMs;
+  uint32_t lastRuntimeMs;
+  bool runtimeSent;
+  LivePushRuntimeKey_type lastRuntime;
+} LivePushClient_type;
+
+static WiFiServer* g_livePushServer = nullptr;
+static LivePushClient_type g_livePushClients[LIVE_PUSH_MAX_CLIENTS];
+static char g_livePushTokens[LIVE_PUSH_MAX_CLIENTS][LIVE_PUSH_TOKEN_LEN + 1];
+static uint8_t g_livePushNextToken = 0;
+static uint8_t g_livePushTx[4 + TELEMETRY_FRAME_MAX_SIZE];  /* WebSocket header + payload in one write */
+
+static void livePushCloseSlot(LivePushClient_type* c) {
+  c->client.stop();
+  c->state = LIVE_PUSH_SLOT_FREE;
+  c->reqLen = 0;
+  c->rxLen = 0;
+}
+
+/**
+ * @brief Send one unmasked server frame (payload must already be at g_livePushTx + 4)
+ */
+static bool livePushSendFrame(LivePushClient_type* c, uint8_t opcode, size_t payloadLen) {
+  uint8_t* start;
+  if (payloadLen < 126U) {
+    start = g_livePushTx + 2;
+    start[0] = (uint8_t)(0x80U | opcode);
+    start[1] = (uint8_t)payloadLen;
+  } else {
+    start = g_livePushTx;
+    start[0] = (uint8_t)(0x80U | opcode);
+    start[1] = 126U;
+    start[2] = (uint8_t)(payloadLen >> 8);
+    start[3] = (uint8_t)payloadLen;
+  }
+  size_t total = (size_t)(g_livePushTx + 4 + payloadLen - start);
+  if (c->client.write(start, total) != total) {
+    livePushCloseSlot(c);
+    return false;
+  }
+  return true;
+}
+
+static bool livePushSendSmall(LivePushClient_type* c, uint8_t opcode, const uint8_t* payload, size_t len) {
+  if (len > 125U) {
+    len = 125U;
+  }
+  memcpy(g_livePushTx + 4, payload, len);
+  return livePushSendFrame(c, opcode, len);
+}
+
+static bool livePushConsumeToken(const char* token, size_t len) {
+  if (len != LIVE_PUSH_TOKEN_LEN) {
+    return false;
+  }
+  for (uint8_t i = 0; i < LIVE_PUSH_MAX_CLIENTS; i++) {
+    if (g_livePushTokens[i][0] != '\0' && memcmp(g_livePushTokens[i], token, LIVE_PUSH_TOKEN_LEN) == 0) {
+      g_livePushTokens[i][0] = '\0';
+      return true;
+    }
+  }
+  return false;
+}
+
+static const char* livePushFindHeader(const char* req, const char* name) {
+  size_t nameLen = strlen(name);
+  for (const char* line = strstr(req, "\r\n"); line != nullptr; line = strstr(line, "\r\n")) {
+    line += 2;
+    if (strncasecmp(line, name, nameLen) == 0 && line[nameLen] == ':') {
+      const char* value = line + nameLen + 1;
+      while (*value == ' ') value++;
+      return value;
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Validate the upgrade request and answer it
+ * @return true if the connection is now a WebSocket
+ */
+static bool livePushAcceptUpgrade(LivePushClient_type* c) {
+  static const char* forbidden = "HTTP/1.1 403 Forbidden\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+  const char* req = c->req;
+
+  const char* token = strstr(req, "token=");
+  const char* lineEnd = strstr(req, "\r\n");
+  bool tokenOk = false;
+  if (strncmp(req, "GET /live", 9) == 0 && token != nullptr && token < lineEnd) {
+    token += 6;
+    size_t tokenLen = strcspn(token, "& \r");
+    tokenOk = livePushConsumeToken(token, tokenLen);
+  }
+  const char* key = livePushFindHeader(req, "Sec-WebSocket-Key");
+  if (!tokenOk || key == nullptr) {
+    c->client.write((const uint8_t*)forbidden, strlen(forbidden));
+    return false;
+  }
+
+  char keyGuid[64 + sizeof(LIVE_PUSH_WS_GUID)];
+  size_t keyLen = strcspn(key, " \r");
+  if (keyLen > 64U) {
+    return false;
+  }
+  memcpy(keyGuid, key, keyLen);
+  memcpy(keyGuid + keyLen, LIVE_PUSH_WS_GUID, sizeof(LIVE_PUSH_WS_GUID));
+  unsigned char digest[20];
+  unsigned char accept[32];
+  size_t acceptLen = 0;
+  if (mbedtls_sha1((const unsigned char*)keyGuid, keyLen + sizeof(LIVE_PUSH_WS_GUID) - 1U, digest) != 0 ||
+      mbedtls_base64_encode(accept, sizeof(accept) - 1U, &acceptLen, digest, sizeof(digest)) != 0) {
+    return false;
+  }
+  accept[acceptLen] = '\0';
+
+  char resp[192];
+  int respLen = snprintf(resp, sizeof(resp),
+                         "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                         "Sec-WebSocket-Accept: %s\r\n\r\n",
+                         (const char*)accept);
+  return c->client.write((const uint8_t*)resp, (size_t)respLen) == (size_t)respLen;
+}
+
+static void livePushServiceHandshake(LivePushClient_type* c, uint32_t nowMs) {
+  while (c->client.available() > 0 && c->reqLen < LIVE_PUSH_REQ_MAX) {
+    c->req[c->reqLen++] = (char)c->client.read();
+  }
+  c->req[c->reqLen] = '\0';
+
+  if (strstr(c->req, "\r\n\r\n") != nullptr) {
+    if (!livePushAcceptUpgrade(c)) {
+      livePushCloseSlot(c);
+      return;
+    }
+    c->state = LIVE_PUSH_SLOT_OPEN;
+    c->hasAfterSeq = false;
+    c->unacked = 0;
+    c->lastAckMs = nowMs;
+    c->lastFrameMs = 0;
+    c->runtimeSent = false;
+    c->rxLen = 0;
+    return;
+  }
+  if (c->reqLen >= LIVE_PUSH_REQ_MAX || (uint32_t)(nowMs - c->openedMs) > LIVE_PUSH_HANDSHAKE_MS) {
+    livePushCloseSlot(c);
+  }
+}
+
+static void livePushHandleText(LivePushClient_type* c, const char* text, uint32_t nowMs) {
+  if (strcmp(text, "ack") == 0) {
+    if (c->unacked > 0) {
+      c->unacked--;
+    }
+    c->lastAckMs = nowMs;
+  } else if (strncmp(text, "after ", 6) == 0) {
+    TelemetryStatus status;
+    telemetryGetStatus(&status);
+    c->afterSeq = (uint32_t)strtoul(text + 6, nullptr, 10);
+    c->sessionId = status.sessionId;  /* The client synced its history over HTTP for this session */
+    c->hasAfterSeq = true;
+    c->lastAckMs = nowMs;
+  }
+}
+
+/**
+ * @brief Parse complete client frames out of the receive buffer
+ * @details Client frames are always masked. Anything larger than LIVE_PUSH_RX_MAX is not
+ *          part of this protocol and closes the connection.
+ */
+static void livePushServiceRx(LivePushClient_type* c, uint32_t nowMs) {
+  while (c->client.available() > 0 && c->rxLen < sizeof(c->rx)) {
+    int got = c->client.read(c->rx + c->rxLen, sizeof(c->rx) - c->rxLen);
+    if (got <= 0) break;
+    c->rxLen += (uint16_t)got;
+  }
+
+  while (c->state == LIVE_PUSH_SLOT_OPEN && c->rxLen >= 6U) {
+    uint8_t opcode = c->rx[0] & 0x0FU;
+    uint8_t len = c->rx[1] & 0x7FU;
+    if ((c->rx[1] & 0x80U) == 0 || len > LIVE_PUSH_RX_MAX) {
+      livePushCloseSlot(c);
+      return;
+    }
+    uint16_t frameLen = (uint16_t)(6U + len);
+    if (c->rxLen < frameLen) {
+      return;
+    }
+    uint8_t payload[LIVE_PUSH_RX_MAX + 1];
+    const uint8_t* mask = c->rx + 2;
+    for (uint8_t i = 0; i < len; i++) {
+      payload[i] = c->rx[6 + i] ^ mask[i & 3U];
+    }
+    payload[len] = '\0';
+    memmove(c->rx, c->rx + frameLen, c->rxLen - frameLen);
+    c->rxLen -= frameLen;
+
+    if (opcode == LIVE_PUSH_OP_TEXT) {
+      livePushHandleText(c, (const char*)payload, nowMs);
+    } else if (opcode == LIVE_PUSH_OP_PING) {
+      livePushSendSmall(c, LIVE_PUSH_OP_PONG, payload, len);
+    } else if (opcode == LIVE_PUSH_OP_CLOSE) {
+      livePushSendSmall(c, LIVE_PUSH_OP_CLOSE, payload, (len >= 2U) ? 2U : 0U);
+      livePushCloseSlot(c);
+      return;
+    }
+  }
+}
+
+static void livePushReadRuntimeKey(LivePushRuntimeKey_type* key) {
+  memset(key, 0, sizeof(*key));  /* Padding takes part in the memcmp() change check */
+  key->outputPct = (uint8_t)constrain((int)g_escVar.outputSpeed_pct, 0, 100);
+  key->triggerPct = (uint8_t)(((uint32_t)g_escVar.trigger_norm * 100U) / THROTTLE_NORMALIZED);
+  key->brakeKind = g_escVar.activeBrakeKind;
+  key->brakePct = g_escVar.activeBrake_pct;
+  key->triggerStale = g_escVar.triggerStale;
+  key->vinStep = g_escVar.Vin_mV / 100U;
+  key->currentStep = g_escVar.motorCurrent_mA / 50U;
+  key->lapCount = g_escVar.lapCount;
+  key->bestLap_ms = g_escVar.bestLapTime_ms;
+}
+
+static void livePushServiceRuntime(LivePushClient_type* c, uint32_t nowMs) {
+  LivePushRuntimeKey_type key;
+  livePushReadRuntimeKey(&key);
+  if (c->runtimeSent && memcmp(&key, &c->lastRuntime, sizeof(key)) == 0) {
+    return;
+  }
+  if (c->runtimeSent && (uint32_t)(nowMs - c->lastRuntimeMs) < LIVE_PUSH_RUNTIME_MIN_MS) {
+    return;
+  }
+
+  char* json = (char*)(g_livePushTx + 4);
+  int len = snprintf(json, TELEMETRY_FRAME_MAX_SIZE,
+                     "{\"type\":\"rt\",\"outputPct\":%u,\"triggerPct\":%u,\"brakeKind\":%u,\"brakePct\":%u,"
+                     "\"triggerStale\":%u,\"vinMv\":%u,\"currentMa\":%u,\"lapCount\":%u,\"bestLapMs\":%lu}",
+                     key.outputPct, key.triggerPct, key.brakeKind, key.brakePct, key.triggerStale,
+                     g_escVar.Vin_mV, g_escVar.motorCurrent_mA, key.lapCount, (unsigned long)key.bestLap_ms);
+  if (!livePushSendFrame(c, LIVE_PUSH_OP_TEXT, (size_t)len)) {
+    return;
+  }
+  memcpy(&c->lastRuntime, &key, sizeof(key));
+  c->runtimeSent = true;
+  c->lastRuntimeMs = nowMs;
+  c->unacked++;
+}
+
+static void livePushServiceTelemetry(LivePushClient_type* c, uint32_t nowMs) {
+  if (!c->hasAfterSeq || (uint32_t)(nowMs - c->lastFrameMs) < LIVE_PUSH_FRAME_MIN_MS) {
+    return;
+  }
+  TelemetryStatus status;
+  telemetryGetStatus(&status);
+  bool sessionChanged = status.sessionId != c->sessionId;
+  if (!sessionChanged && status.latestSeq <= c->afterSeq) {
+    return;
+  }
+
+  /* On a new session the client restarts its history, so send from the beginning */
+  uint32_t lastSeq = 0;
+  size_t frameLen = telemetryEncodeLiveFrame(sessionChanged ? 0U : c->afterSeq,
+                                             TELEMETRY_FRAME_MAX_SAMPLES,
+                                             g_livePushTx + 4,
+                                             TELEMETRY_FRAME_MAX_SIZE,
+                                             &lastSeq);
+  if (frameLen == 0 || !livePushSendFrame(c, LIVE_PUSH_OP_BINARY, frameLen)) {
+    return;
+  }
+  c->sessionId = status.sessionId;
+  c->afterSeq = lastSeq;
+  c->lastFrameMs = nowMs;
+  c->unacked++;
+}
+
+/**
+ * @brief Open the push listener (called when the HTTP portal starts)
+ */
+void livePushStart() {
+  if (g_livePushServer != nullptr) {
+    return;
+  }
+  g_livePushServer = new WiFiServer(LIVE_PUSH_PORT, LIVE_PUSH_MAX_CLIENTS);
+  if (g_livePushServer == nullptr) {
+    return;
+  }
+  g_livePushServer->setNoDelay(true);
+  g_livePushServer->begin();
+}
+
+void livePushStop() {
+  for (uint8_t i = 0; i < LIVE_PUSH_MAX_CLIENTS; i++) {
+    if (g_livePushClients[i].state != LIVE_PUSH_SLOT_FREE) {
+      livePushCloseSlot(&g_livePushClients[i]);
+    }
+    g_livePushTokens[i][0] = '\0';
+  }
+  if (g_livePushServer != nullptr) {
+    g_livePushServer->end();
+    delete g_livePushServer;
+    g_livePushServer = nullptr;
+  }
+}
+
+/**
+ * @brief Accept, read and push (called from WiFiTask)
+ */
+void livePushService() {
+  if (g_livePushServer == nullptr) {
+    return;
+  }
+  uint32_t nowMs = millis();
+
+  if (g_livePushServer->hasClient()) {
+    WiFiClient incoming = g_livePushServer->accept();
+    LivePushClient_type* slot = nullptr;
+    for (uint8_t i = 0; i < LIVE_PUSH_MAX_CLIENTS && slot == nullptr; i++) {
+      if (g_livePushClients[i].state == LIVE_PUSH_SLOT_FREE) {
+        slot = &g_livePushClients[i];
+      }
+    }
+    if (slot == nullptr) {
+      incoming.stop();
+    } else {
+      slot->client = incoming;
+      slot->client.setNoDelay(true);
+      slot->state = LIVE_PUSH_SLOT_HANDSHAKE;
+      slot->openedMs = nowMs;
+      slot->reqLen = 0;
+    }
+  }
+
+  for (uint8_t i = 0; i < LIVE_PUSH_MAX_CLIENTS; i++) {
+    LivePushClient_type* c = &g_livePushClients[i];
+    if (c->state == LIVE_PUSH_SLOT_FREE) {
+      continue;
+    }
+    if (!c->client.connected()) {
+      livePushCloseSlot(c);
+      continue;
+    }
+    if (c->state == LIVE_PUSH_SLOT_HANDSHAKE) {
+      livePushServiceHandshake(c, nowMs);
+      continue;
+    }
+
+    livePushServiceRx(c, nowMs);
+    if (c->state != LIVE_PUSH_SLOT_OPEN) {
+      continue;
+    }
+    if (c->unacked >= LIVE_PUSH_WINDOW) {
+      if ((uint32_t)(nowMs - c->lastAckMs) > LIVE_PUSH_ACK_TIMEOUT_MS) {
+        livePushCloseSlot(c);
+      }
+      continue;
+    }
+    livePushServiceRuntime(c, nowMs);
+    if (c->state == LIVE_PUSH_SLOT_OPEN && c->unacked < LIVE_PUSH_WINDOW) {
+      livePushServiceTelemetry(c, nowMs);
+    }
+  }
+}
+
+/**
+ * @brief Issue a single-use connect token (caller has already authenticated the user)
+ */
+bool livePushIssueToken(char* outToken, size_t outSize) {
+  if (outToken == nullptr || outSize < LIVE_PUSH_TOKEN_LEN + 1U || g_livePushServer == nullptr) {
+    return false;
+  }
+  char* token = g_livePushTokens[g_livePushNextToken];
+  g_livePushNextToken = (uint8_t)((g_livePushNextToken + 1U) % LIVE_PUSH_MAX_CLIENTS);
+  for (uint8_t i = 0; i < LIVE_PUSH_TOKEN_LEN; i += 8) {
+    snprintf(token + i, 9, "%08lx", (unsigned long)esp_random());
+  }
+  memcpy(outToken, token, LIVE_PUSH_TOKEN_LEN + 1U);
+  return true;
+}
+
+uint8_t livePushClientCount() {
+  uint8_t count = 0;
+  for (uint8_t i = 0; i < LIVE_PUSH_MAX_CLIENTS; i++) {
+    if (g_livePushClients[i].state == LIVE_PUSH_SLOT_OPEN) {
+      count++;
+    }
+  }
+  return count;
+}
@@ -0,0 +1,31 @@
+#ifndef LIVE_PUSH_H_
+#define LIVE_PUSH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* WebSocket push channel for the web UI (ws://<host>:LIVE_PUSH_PORT/live?token=...).
+ * Serviced from WiFiTask next to the HTTP server. Pushes
+ *   - binary telemetry frames (telemetry_frame.h) as new samples are captured, starting
+ *     after the seq the client announces with "after <seq>"
+ *   - a small JSON runtime snapshot ({"type":"rt",...}) when output/brake/Vin/current/laps change
+ * Backpressure: every pushed message must be answered with "ack"; a client with
+ * LIVE_PUSH_WINDOW unacknowledged messages gets nothing until it catches up, and is
+ * dropped after LIVE_PUSH_ACK_TIMEOUT_MS. A slow phone therefore never stalls WiFiTask.
+ * Tokens come from the authenticated /api/live/token endpoint and are single-use. */
+#define LIVE_PUSH_PORT              81
+#define LIVE_PUSH_MAX_CLIENTS       2
+#define LIVE_PUSH_WINDOW            2       /* Unacknowledged messages per client */
+#define LIVE_PUSH_ACK_TIMEOUT_MS    5000UL
+#define LIVE_PUSH_FRAME_MIN_MS      50UL    /* Batch samples for at least this long between frames */
+#define LIVE_PUSH_RUNTIME_MIN_MS    50UL    /* Rate limit for runtime snapshots */
+#define LIVE_PUSH_HANDSHAKE_MS      2000UL  /* Drop clients that do not finish the upgrade */
+#define LIVE_PUSH_TOKEN_LEN         16
+
+void livePushStart();
+void livePushStop();
+void livePushService();
+bool livePushIssueToken(char* outToken, size_t outSize);
+uint8_t livePushClientCount();
+
+#endif  /* LIVE_PUSH_H_ */
@@ -4,6 +4,9 @@
 #include "ui_strings.h"
 #include "ui_text_access.h"
 #include "settings_reset_menu.h"
+#include "input_events.h"
+#include "car_profiles.h"
+#include "throttle_lut.h"
 
 extern StoredVar_type g_storedVar;
 extern ESC_type g_escVar;
@@ -27,6 +30,46 @@ extern void showScreensaver();
 extern void initMenuItems();
 extern void saveEEPROM(StoredVar_type toSave);
 
+/**
+ * Print one line of a car list: the profile name, and its number on the right
+ * @details Names of the profiles that are not selected come from the profile cache or flash.
+ */
+static void drawCarListLine(uint8_t line, uint16_t carIndex, bool selected) {
+  char name[CAR_NAME_MAX_SIZE + 1];
+  carProfileGetName(carIndex, name, sizeof(name));
+  obdWriteString(&g_obd, 0, 0, line * HEIGHT12x16, name, FONT_12x16, selected ? OBD_WHITE : OBD_BLACK, 1);
+  sprintf(msgStr, "%2d", carIndex);
+  obdWriteString(&g_obd, 0, OLED_WIDTH - 24, line * HEIGHT12x16, msgStr, FONT_12x16, OBD_BLACK, 1);
+}
+
+/**
+ * Copy every setting except the name from one profile to another
+ */
+static void copyCarSettings(uint16_t sourceCar, uint16_t destCar) {
+  CarParam_type source;
+  CarParam_type dest;
+  carProfileRead(sourceCar, &source);
+  carProfileRead(destCar, &dest);
+  dest.minSpeed = source.minSpeed;
+  dest.brake = source.brake;
+  dest.maxSpeed = source.maxSpeed;
+  dest.throttleCurveVertex.inputThrottle = source.throttleCurveVertex.inputThrottle;
+  dest.throttleCurveVertex.curveSpeedDiff = source.throttleCurveVertex.curveSpeedDiff;
+  dest.fade = source.fade;
+  dest.antiSpin = source.antiSpin;
+  dest.freqPWM = source.freqPWM;
+  dest.brakeButtonReduction = source.brakeButtonReduction;
+  dest.quickBrakeEnabled = source.quickBrakeEnabled;
+  dest.quickBrakeThreshold = source.quickBrakeThreshold;
+  dest.quickBrakeStrength = source.quickBrakeStrength;
+  dest.antiSpinMode = source.antiSpinMode;
+  dest.brakeBite = source.brakeBite;
+  dest.brakeBiteHold = source.brakeBiteHold;
+  dest.brakeRamp = source.brakeRamp;
+  dest.throttleCurveShape = source.throttleCurveShape;
+  carProfileWrite(destCar, &dest);
+}
+
 void showCarSelection() {
   /* "Frame" indicates which items are currently displayed.
      It consist of a lower and upper bound: only the items within this boundaries are displayed.
@@ -72,7 +115,7 @@ void showCarSelection() {
         if (serviceIdlePowerTransitions(&lastInteraction, &screensaverActive)) {
           obdFill(&g_obd, OBD_WHITE, 1);
         }
-        delay(10);  /* Small delay to prevent watchdog timeout */
+        inputEventsWait(TASK1_IDLE_WAIT_MS);  /* Sleep until input (keeps the watchdog fed) */
         continue;  /* Don't draw menu while screensaver is active */
       }
     }
@@ -109,15 +152,7 @@ void showCarSelection() {
     /* Print car menu */
     for (uint8_t i = 0; i < g_carMenu.lines; i++)
     {
-      /* Print the item (car) name */
-      obdWriteString(&g_obd, 0, 0, i * HEIGHT12x16, g_carMenu.item[frameUpper + i].name, FONT_12x16, (g_storedVar.selectedCarNumber - frameUpper == i) ? OBD_WHITE : OBD_BLACK, 1);
-      if (g_carMenu.item[frameUpper + i].value != ITEM_NO_VALUE)
-      {
-        /* value is a generic pointer to void, so first cast to uint16_t pointer, then take the pointed value */
-        sprintf(msgStr, "%2d", *(uint16_t *)(g_carMenu.item[frameUpper + i].value));
-        /* Print the item value (car number) */
-        obdWriteString(&g_obd, 0, OLED_WIDTH - 24, i * HEIGHT12x16, msgStr, FONT_12x16, OBD_BLACK, 1);
-      }
+      drawCarListLine(i, frameUpper + i, g_storedVar.selectedCarNumber - frameUpper == i);
     }
 
     /* Print car selection label on the bottom of the screen */
@@ -132,6 +167,7 @@ void showCarSelection() {
 
     /* Long press = escape to main for race mode toggle */
     if (checkRaceModeEscape()) { requestEscapeToMain(); return; }
+    inputEventsWait(TASK1_IDLE_WAIT_MS);  /* Sleep until input or the next refresh */
   }
 
   /* Reset encoder and clear is done in caller routine */
@@ -184,7 +220,7 @@ void showCopyCarSettings() {
         if (serviceIdlePowerTransitions(&lastInteraction, &screensaverActive)) {
           obdFill(&g_obd, OBD_WHITE, 1);
         }
-        delay(10);  /* Small delay to prevent watchdog timeout */
+        inputEventsWait(TASK1_IDLE_WAIT_MS);  /* Sleep until input (keeps the watchdog fed) */
         continue;  /* Don't draw menu while screensaver is active */
       }
     }
@@ -220,14 +256,7 @@ void showCopyCarSettings() {
     /* Print car menu */
     for (uint8_t i = 0; i < g_carMenu.lines; i++)
     {
-      /* Print the item (car) name */
-      obdWriteString(&g_obd, 0, 0, i * HEIGHT12x16, g_carMenu.item[frameUpper + i].name, FONT_12x16, (sourceCar - frameUpper == i) ? OBD_WHITE : OBD_BLACK, 1);
-      if (g_carMenu.item[frameUpper + i].value != ITEM_NO_VALUE)
-      {
-        /* Print the item value (car number) */
-        sprintf(msgStr, "%2d", *(uint16_t *)(g_carMenu.item[frameUpper + i].value));
-        obdWriteString(&g_obd, 0, OLED_WIDTH - 24, i * HEIGHT12x16, msgStr, FONT_12x16, OBD_BLACK, 1);
-      }
+      drawCarListLine(i, frameUpper + i, sourceCar - frameUpper == i);
     }
 
     /* Print "COPY FROM:" on the bottom of the screen */
@@ -242,6 +271,7 @@ void showCopyCarSettings() {
 
     /* Long press = escape to main for race mode toggle */
     if (checkRaceModeEscape()) { requestEscapeToMain(); return; }
+    inputEventsWait(TASK1_IDLE_WAIT_MS);  /* Sleep until input or the next refresh */
   }
 
   /* Small delay to prevent double-click */
@@ -257,7 +287,7 @@ void showCopyCarSettings() {
   screensaverActive = false;
 
   /* Reset encoder for destination car selection (CAR_MAX_COUNT = ALL option) */
-  setUiEncoderBoundaries(0, CAR_MAX_COUNT, false);  /* 0-19 = cars, 20 = ALL */
+  setUiEncoderBoundaries(0, CAR_MAX_COUNT, false);  /* 0..CAR_MAX_COUNT-1 = cars, CAR_MAX_COUNT = ALL */
   resetUiEncoder(g_storedVar.selectedCarNumber);
   destCar = g_storedVar.selectedCarNumber;
 
@@ -289,7 +319,7 @@ void showCopyCarSettings() {
         if (serviceIdlePowerTransitions(&lastInteraction, &screensaverActive)) {
           obdFill(&g_obd, OBD_WHITE, 1);
         }
-        delay(10);  /* Small delay to prevent watchdog timeout */
+        inputEventsWait(TASK1_IDLE_WAIT_MS);  /* Sleep until input (keeps the watchdog fed) */
         continue;  /* Don't draw menu while screensaver is active */
       }
     }
@@ -332,14 +362,7 @@ void showCopyCarSettings() {
         /* Print "ALL" option */
         obdWriteString(&g_obd, 0, 0, i * HEIGHT12x16, (char *)STR_ALL[g_storedVar.language], FONT_12x16, isSelected ? OBD_WHITE : OBD_BLACK, 1);
       } else if (itemIndex < CAR_MAX_COUNT) {
-        /* Print the item (car) name */
-        obdWriteString(&g_obd, 0, 0, i * HEIGHT12x16, g_carMenu.item[itemIndex].name, FONT_12x16, isSelected ? OBD_WHITE : OBD_BLACK, 1);
-        if (g_carMenu.item[itemIndex].value != ITEM_NO_VALUE)
-        {
-          /* Print the item value (car number) */
-          sprintf(msgStr, "%2d", *(uint16_t *)(g_carMenu.item[itemIndex].value));
-          obdWriteString(&g_obd, 0, OLED_WIDTH - 24, i * HEIGHT12x16, msgStr, FONT_12x16, OBD_BLACK, 1);
-        }
+        drawCarListLine(i, itemIndex, isSelected);
       }
     }
 
@@ -355,25 +378,15 @@ void showCopyCarSettings() {
 
     /* Long press = escape to main for race mode toggle */
     if (checkRaceModeEscape()) { requestEscapeToMain(); return; }
+    inputEventsWait(TASK1_IDLE_WAIT_MS);  /* Sleep until input or the next refresh */
   }
 
   /* Copy car parameters */
   if (destCar == ALL_CARS_OPTION) {
-    /* Copy to ALL cars (except source car) */
+    /* Copy to ALL cars (except source car); written to flash in batches as the queue fills */
     for (uint16_t i = 0; i < CAR_MAX_COUNT; i++) {
       if (i != sourceCar) {
-        g_storedVar.carParam[i].minSpeed = g_storedVar.carParam[sourceCar].minSpeed;
-        g_storedVar.carParam[i].brake = g_storedVar.carParam[sourceCar].brake;
-        g_storedVar.carParam[i].maxSpeed = g_storedVar.carParam[sourceCar].maxSpeed;
-        g_storedVar.carParam[i].throttleCurveVertex.inputThrottle = g_storedVar.carParam[sourceCar].throttleCurveVertex.inputThrottle;
-        g_storedVar.carParam[i].throttleCurveVertex.curveSpeedDiff = g_storedVar.carParam[sourceCar].throttleCurveVertex.curveSpeedDiff;
-        g_storedVar.carParam[i].fade = g_storedVar.carParam[sourceCar].fade;
-        g_storedVar.carParam[i].antiSpin = g_storedVar.carParam[sourceCar].antiSpin;
-        g_storedVar.carParam[i].freqPWM = g_storedVar.carParam[sourceCar].freqPWM;
-        g_storedVar.carParam[i].brakeButtonReduction = g_storedVar.carParam[sourceCar].brakeButtonReduction;
-        g_storedVar.carParam[i].quickBrakeEnabled = g_storedVar.carParam[sourceCar].quickBrakeEnabled;
-        g_storedVar.carParam[i].quickBrakeThreshold = g_storedVar.carParam[sourceCar].quickBrakeThreshold;
-        g_storedVar.carParam[i].quickBrakeStrength = g_storedVar.carParam[sourceCar].quickBrakeStrength;
+        copyCarSettings(sourceCar, i);
       }
     }
     /* Show confirmation message */
@@ -382,18 +395,7 @@ void showCopyCarSettings() {
     delay(1000);
   } else if (sourceCar != destCar) {
     /* Copy to single car */
-    g_storedVar.carParam[destCar].minSpeed = g_storedVar.carParam[sourceCar].minSpeed;
-    g_storedVar.carParam[destCar].brake = g_storedVar.carParam[sourceCar].brake;
-    g_storedVar.carParam[destCar].maxSpeed = g_storedVar.carParam[sourceCar].maxSpeed;
-    g_storedVar.carParam[destCar].throttleCurveVertex.inputThrottle = g_storedVar.carParam[sourceCar].throttleCurveVertex.inputThrottle;
-    g_storedVar.carParam[destCar].throttleCurveVertex.curveSpeedDiff = g_storedVar.carParam[sourceCar].throttleCurveVertex.curveSpeedDiff;
-    g_storedVar.carParam[destCar].fade = g_storedVar.carParam[sourceCar].fade;
-    g_storedVar.carParam[destCar].antiSpin = g_storedVar.carParam[sourceCar].antiSpin;
-    g_storedVar.carParam[destCar].freqPWM = g_storedVar.carParam[sourceCar].freqPWM;
-    g_storedVar.carParam[destCar].brakeButtonReduction = g_storedVar.carParam[sourceCar].brakeButtonReduction;
-    g_storedVar.carParam[destCar].quickBrakeEnabled = g_storedVar.carParam[sourceCar].quickBrakeEnabled;
-    g_storedVar.carParam[destCar].quickBrakeThreshold = g_storedVar.carParam[sourceCar].quickBrakeThreshold;
-    g_storedVar.carParam[destCar].quickBrakeStrength = g_storedVar.carParam[sourceCar].quickBrakeStrength;
+    copyCarSettings(sourceCar, destCar);
 
     /* Show confirmation message */
     obdFill(&g_obd, OBD_WHITE, 1);
@@ -463,7 +465,7 @@ void showSelectRenameCar() {
         if (serviceIdlePowerTransitions(&lastInteraction, &screensaverActive)) {
           obdFill(&g_obd, OBD_WHITE, 1);
         }
-        delay(10);  /* Small delay to prevent watchdog timeout */
+        inputEventsWait(TASK1_IDLE_WAIT_MS);  /* Sleep until input (keeps the watchdog fed) */
         continue;  /* Don't draw menu while screensaver is active */
       }
     }
@@ -538,20 +540,20 @@ void showSelectRenameCar() {
       switch (optionIndex)
       {
         case CAR_OPTION_SELECT:
-          obdWriteString(&g_obd, 0, 0, yPos, (char *)getCarMenuOption(lang, 0), menuFont, isSelected ? OBD_WHITE : OBD_BLACK, 1);
+          obdWriteString(&g_obd, 0, 0, yPos, (char *)uiText(UI_TEXT_CAR_MENU, lang, 0), menuFont, isSelected ? OBD_WHITE : OBD_BLACK, 1);
           break;
 
         case CAR_OPTION_RENAME:
-          obdWriteString(&g_obd, 0, 0, yPos, (char *)getCarMenuOption(lang, 1), menuFont, isSelected ? OBD_WHITE : OBD_BLACK, 1);
+          obdWriteString(&g_obd, 0, 0, yPos, (char *)uiText(UI_TEXT_CAR_MENU, lang, 1), menuFont, isSelected ? OBD_WHITE : OBD_BLACK, 1);
           break;
 
         case CAR_OPTION_GRID_SEL:
         {
           /* Grid select option - show label and right-aligned ON/OFF value */
-          obdWriteString(&g_obd, 0, 0, yPos, (char *)getCarMenuOption(lang, 2), menuFont, isSelected ? OBD_WHITE : OBD_BLACK, 1);
+          obdWriteString(&g_obd, 0, 0, yPos, (char *)uiText(UI_TEXT_CAR_MENU, lang, 2), menuFont, isSelected ? OBD_WHITE : OBD_BLACK, 1);
           /* Show temp value when editing, stored value otherwise */
           uint16_t displayValue = isEditingRaceswp ? tempRaceswpValue : g_storedVar.gridCarSelectEnabled;
-          sprintf(msgStr, "%3s", getOnOffLabel(lang, displayValue ? 1 : 0));
+          sprintf(msgStr, "%3s", uiText(UI_TEXT_ON_OFF, lang, displayValue ? 1 : 0));
           /* Value is white when editing, follows selection otherwise */
           uint8_t valueColor = isEditingRaceswp ? OBD_WHITE : (isSelected ? OBD_WHITE : OBD_BLACK);
           obdWriteString(&g_obd, 0, OLED_WIDTH - 3 * charWidth, yPos, msgStr, menuFont, valueColor, 1);
@@ -559,17 +561,17 @@ void showSelectRenameCar() {
         }
 
         case CAR_OPTION_COPY:
-          obdWriteString(&g_obd, 0, 0, yPos, (char *)getCarMenuOption(lang, 3), menuFont, isSelected ? OBD_WHITE : OBD_BLACK, 1);
+          obdWriteString(&g_obd, 0, 0, yPos, (char *)uiText(UI_TEXT_CAR_MENU, lang, 3), menuFont, isSelected ? OBD_WHITE : OBD_BLACK, 1);
           break;
 
         case CAR_OPTION_RESET:
-          obdWriteString(&g_obd, 0, 0, yPos, (char *)getCarMenuOption(lang, 4), menuFont, isSelected ? OBD_WHITE : OBD_BLACK, 1);
+          obdWriteString(&g_obd, 0, 0, yPos, (char *)uiText(UI_TEXT_CAR_MENU, lang, 4), menuFont, isSelected ? OBD_WHITE : OBD_BLACK, 1);
           break;
 
         case CAR_OPTION_BACK:
         {
           /* Display BACK option using helper for text case support */
-          obdWriteString(&g_obd, 0, 0, yPos, (char *)getBackLabel(lang), menuFont, isSelected ? OBD_WHITE : OBD_BLACK, 1);
+          obdWriteString(&g_obd, 0, 0, yPos, (char *)uiText(UI_TEXT_BACK, lang, 0), menuFont, isSelected ? OBD_WHITE : OBD_BLACK, 1);
           break;
         }
       }
@@ -582,6 +584,7 @@ void showSelectRenameCar() {
 
     /* Long press = escape to main for race mode toggle */
     if (checkRaceModeEscape()) { requestEscapeToMain(); goto exitCarMenu; }
+    inputEventsWait(TASK1_IDLE_WAIT_MS);  /* Sleep until input or the next refresh */
   }
 
   /* Handle encoder click based on current state */
@@ -617,8 +620,8 @@ void showSelectRenameCar() {
         uint8_t yPos = optionScreenPos * lineHeight;
         uint16_t lang = g_storedVar.language;
 
-        obdWriteString(&g_obd, 0, 0, yPos, (char *)getCarMenuOption(lang, 2), menuFont, OBD_WHITE, 1);
-        sprintf(msgStr, "%3s", getOnOffLabel(lang, tempRaceswpValue ? 1 : 0));
+        obdWriteString(&g_obd, 0, 0, yPos, (char *)uiText(UI_TEXT_CAR_MENU, lang, 2), menuFont, OBD_WHITE, 1);
+        sprintf(msgStr, "%3s", uiText(UI_TEXT_ON_OFF, lang, tempRaceswpValue ? 1 : 0));
         obdWriteString(&g_obd, 0, OLED_WIDTH - 3 * charWidth, yPos, msgStr, menuFont, OBD_WHITE, 1);
       }
     }
@@ -705,7 +708,7 @@ void showRenameCar() {
   uint16_t mode = RENAME_CAR_SELECT_OPTION_MODE;  /* Initial mode. There are two mode:
                                                      - RENAME_CAR_SELECT_OPTION_MODE, when scrolling the encoder changes the selectedOption (pick which char to change, or the OK option)
                                                      - RENAME_CAR_SELECT_CHAR_MODE, when scrolling the encoder changes the selectedChar, that is the value of the selectedOption */
-  sprintf(tmpName, "%s", g_storedVar.carParam[g_storedVar.selectedCarNumber].carName); /* Store the current carName in the temporary name */
+  sprintf(tmpName, "%s", g_storedVar.activeCar.carName); /* Store the current carName in the temporary name */
 
   /* Clear screen */
   obdFill(&g_obd, OBD_WHITE, 1);
@@ -763,7 +766,7 @@ void showRenameCar() {
         if (serviceIdlePowerTransitions(&lastInteraction, &screensaverActive)) {
           obdFill(&g_obd, OBD_WHITE, 1);
         }
-        delay(10);  /* Small delay to prevent watchdog timeout */
+        inputEventsWait(TASK1_IDLE_WAIT_MS);  /* Sleep until input (keeps the watchdog fed) */
         continue;  /* Don't draw menu while screensaver is active */
       }
     }
@@ -829,7 +832,7 @@ void showRenameCar() {
       if (selectedOption == CAR_NAME_MAX_SIZE - 1)
       {
         /* Change the name of the Car */
-        sprintf(g_storedVar.carParam[g_storedVar.selectedCarNumber].carName, "%s", tmpName);
+        sprintf(g_storedVar.activeCar.carName, "%s", tmpName);
         /* Menu variables are initialized in main loop */
         return;
       }
@@ -860,6 +863,7 @@ void showRenameCar() {
 
     /* Long press = escape to main for race mode toggle */
     if (checkRaceModeEscape()) { requestEscapeToMain(); return; }
+    inputEventsWait(TASK1_IDLE_WAIT_MS);  /* Sleep until input or the next refresh */
   }
 }
 
@@ -884,13 +888,49 @@ static uint8_t graphXFromThrottleNorm(uint16_t throttleNorm) {
   return (uint8_t)(25U + min((uint16_t)100U, pct));
 }
 
-static void drawThrottleResponseGraph(uint16_t curveDiffValue, uint16_t fadePctValue, uint16_t triggerPct, const char* valueText) {
-  uint16_t minSpeedRaw = g_storedVar.carParam[g_carSel].minSpeed;
-  uint16_t maxSpeedRaw = g_storedVar.carParam[g_carSel].maxSpeed * SENSI_SCALE;
+static void drawGraphMarker(uint8_t x, uint8_t y, bool filled) {
+  for (int8_t dx = -1; dx <= 1; dx++) {
+    for (int8_t dy = -1; dy <= 1; dy++) {
+      if (filled || dx != 0 || dy != 0) {
+        obdSetPixel(&g_obd, x + dx, y + dy, OBD_BLACK, 1);
+      }
+    }
+  }
+}
+
+/* Multi-point curve: sampled from the same evaluator the throttle table is built from */
+static void drawThrottleCurveShape(uint16_t fadePctValue, uint16_t minSpeedRaw, uint16_t maxSpeedRaw, int8_t selectedPoint) {
+  const ThrottleCurveShape_type* shape = &g_storedVar.activeCar.throttleCurveShape;
+  ThrottleLutKey_type key;
+  throttleLutKeyFromCar(&g_storedVar.activeCar, &key);
+  key.fade = fadePctValue;
+  uint8_t prevY = 50;
+  for (uint8_t x = 25; x <= 125; x++) {
+    uint16_t throttleNorm = (uint16_t)(((uint32_t)(x - 25U) * THROTTLE_NORMALIZED) / 100U);
+    uint8_t y = graphYFromPercentX10(throttleCurveEvaluate(&key, throttleNorm));
+    if (x > 25) {
+      obdDrawLine(&g_obd, x - 1, prevY, x, y, OBD_BLACK, 1);
+    }
+    prevY = y;
+  }
+
+  uint16_t fadeThrottleNorm = fadePctToThrottleNorm(min((uint16_t)FADE_MAX_VALUE, fadePctValue));
+  for (uint8_t i = 0; i < shape->count && i < THROTTLE_CURVE_POINTS_MAX; i++) {
+    uint16_t inputNorm = (uint16_t)(((uint32_t)shape->points[i].input_pct * THROTTLE_NORMALIZED) / 100U);
+    uint8_t x = graphXFromThrottleNorm(curveVertexInputWithFade(fadeThrottleNorm, inputNorm));
+    uint8_t y = graphYFromSpeedRaw(calcThrottleCurveVertexSpeedRaw(minSpeedRaw, maxSpeedRaw, shape->points[i].output_pct));
+    drawGraphMarker(x, max(y, (uint8_t)1U), i == selectedPoint);
+  }
+}
+
+static void drawThrottleResponseGraph(uint16_t curveDiffValue, uint16_t fadePctValue, uint16_t triggerPct, const char* valueText,
+                                      int8_t selectedPoint = -1) {
+  uint16_t minSpeedRaw = g_storedVar.activeCar.minSpeed;
+  uint16_t maxSpeedRaw = g_storedVar.activeCar.maxSpeed * SENSI_SCALE;
   uint16_t minSpeedY = graphYFromPercentX10(sensiToPctX10(minSpeedRaw));
-  uint16_t maxSpeedY = graphYFromPercentX10((uint16_t)g_storedVar.carParam[g_carSel].maxSpeed * 10U);
+  uint16_t maxSpeedY = graphYFromPercentX10((uint16_t)g_storedVar.activeCar.maxSpeed * 10U);
   uint16_t fadeThrottleNorm = fadePctToThrottleNorm(min((uint16_t)FADE_MAX_VALUE, fadePctValue));
-  uint16_t curveVertexInputNorm = curveVertexInputWithFade(fadeThrottleNorm, g_storedVar.carParam[g_carSel].throttleCurveVertex.inputThrottle);
+  uint16_t curveVertexInputNorm = curveVertexInputWithFade(fadeThrottleNorm, g_storedVar.activeCar.throttleCurveVertex.inputThrottle);
   uint16_t curveVertexSpeedRaw = calcThrottleCurveVertexSpeedRaw(minSpeedRaw, maxSpeedRaw, curveDiffValue);
   uint8_t fadeX = graphXFromThrottleNorm(fadeThrottleNorm);
   uint8_t curveX = graphXFromThrottleNorm(curveVertexInputNorm);
@@ -912,8 +952,11 @@ static void drawThrottleResponseGraph(uint16_t curveDiffValue, uint16_t fadePctV
   obdSetPixel(&g_obd, 75, 52, OBD_BLACK, 1);
   obdSetPixel(&g_obd, 26, maxSpeedY, OBD_BLACK, 1);
   obdSetPixel(&g_obd, 27, maxSpeedY, OBD_BLACK, 1);
-  obdSetPixel(&g_obd, curveX, 51, OBD_BLACK, 1);
-  obdSetPixel(&g_obd, curveX, 52, OBD_BLACK, 1);
+  bool shapeActive = throttleCurveShapeActive(&g_storedVar.activeCar.throttleCurveShape);
+  if (!shapeActive) {
+    obdSetPixel(&g_obd, curveX, 51, OBD_BLACK, 1);
+    obdSetPixel(&g_obd, curveX, 52, OBD_BLACK, 1);
+  }
 
   if (fadePctValue > 0) {
     obdSetPixel(&g_obd, fadeX, 51, OBD_BLACK, 1);
@@ -923,38 +966,131 @@ static void drawThrottleResponseGraph(uint16_t curveDiffValue, uint16_t fadePctV
     }
   }
 
-  if (fadePctValue > 0) {
-    obdDrawLine(&g_obd, 25, 50, fadeX, minSpeedY, OBD_BLACK, 1);
-    if (curveX > fadeX) {
-      obdDrawLine(&g_obd, fadeX, minSpeedY, curveX, curveY, OBD_BLACK, 1);
-    }
+  if (shapeActive) {
+    drawThrottleCurveShape(fadePctValue, minSpeedRaw, maxSpeedRaw, selectedPoint);
   } else {
-    obdDrawLine(&g_obd, 25, minSpeedY, curveX, curveY, OBD_BLACK, 1);
+    if (fadePctValue > 0) {
+      obdDrawLine(&g_obd, 25, 50, fadeX, minSpeedY, OBD_BLACK, 1);
+      if (curveX > fadeX) {
+        obdDrawLine(&g_obd, fadeX, minSpeedY, curveX, curveY, OBD_BLACK, 1);
+      }
+    } else {
+      obdDrawLine(&g_obd, 25, minSpeedY, curveX, curveY, OBD_BLACK, 1);
+    }
+    obdDrawLine(&g_obd, curveX, curveY, 125, maxSpeedY, OBD_BLACK, 1);
   }
-  obdDrawLine(&g_obd, curveX, curveY, 125, maxSpeedY, OBD_BLACK, 1);
 
   obdWriteString(&g_obd, 0, OLED_WIDTH - 48, 34, (char *)valueText, FONT_12x16, OBD_BLACK, 1);
   snprintf(msgStr, sizeof(msgStr), "%3d%%", triggerPct);
   obdWriteString(&g_obd, 0, OLED_WIDTH - 32, 26, msgStr, FONT_8x8, OBD_BLACK, 1);
 }
 
+/* Encoder range for one point: between its neighbours, so the curve never falls */
+static void selectCurvePoint(const ThrottleCurveShape_type* shape, uint8_t index) {
+  uint8_t lower = (index > 0) ? shape->points[index - 1].output_pct : 0U;
+  uint8_t upper = (index + 1U < shape->count) ? shape->points[index + 1U].output_pct : 100U;
+  setUiEncoderBoundaries(lower, upper, false);
+  resetUiEncoder(shape->points[index].output_pct);
+}
+
+/**
+ * Multi-point variant of the CURVE screen. Turning moves the selected point up or down, a click
+ * selects the next point and the click on the last one saves. X positions, the point count and
+ * the LINEAR/SPLINE mode are set from the web UI.
+ */
+static void showCurvePointsSelection()
+{
+  ThrottleCurveShape_type* shape = &g_storedVar.activeCar.throttleCurveShape;
+  ThrottleCurveShape_type originalShape = *shape;
+  uint16_t prevTrigger = g_escVar.outputSpeed_pct;
+  uint8_t selected = 0;
+  bool pointsCanceled = false;
+  bool pointsDone = false;
+
+  g_rotaryEncoder.setAcceleration(SEL_ACCELERATION);
+  selectCurvePoint(shape, selected);
+  snprintf(msgStr, sizeof(msgStr), "%3u%%", (unsigned)shape->points[selected].output_pct);
+  drawThrottleResponseGraph(g_storedVar.activeCar.throttleCurveVertex.curveSpeedDiff,
+                            g_storedVar.activeCar.fade, prevTrigger, msgStr, (int8_t)selected);
+
+  while (!pointsDone && !pointsCanceled)
+  {
+    static bool brakeBtnInPoints = false;
+    static uint32_t lastBrakeBtnPointsTime = 0;
+    if (digitalRead(BUTT_PIN) == BUTTON_PRESSED) {
+      if (!brakeBtnInPoints && millis() - lastBrakeBtnPointsTime > BUTTON_SHORT_PRESS_DEBOUNCE_MS) {
+        brakeBtnInPoints = true;
+        lastBrakeBtnPointsTime = millis();
+        *shape = originalShape;
+        pointsCanceled = true;
+      }
+    } else {
+      brakeBtnInPoints = false;
+    }
+
+    bool redraw = false;
+    if (g_escVar.outputSpeed_pct != prevTrigger) {
+      prevTrigger = g_escVar.outputSpeed_pct;
+      redraw = true;
+    }
+    if (g_rotaryEncoder.isEncoderButtonClicked()) {
+      if (++selected >= shape->count) {
+        pointsDone = true;
+      } else {
+        selectCurvePoint(shape, selected);
+        redraw = true;
+      }
+    }
+    if (!pointsDone && !pointsCanceled && g_rotaryEncoder.encoderChanged()) {
+      shape->points[selected].output_pct = (uint8_t)readUiEncoder();
+      redraw = true;
+    }
+    if (redraw && !pointsDone && !pointsCanceled) {
+      snprintf(msgStr, sizeof(msgStr), "%3u%%", (unsigned)shape->points[selected].output_pct);
+      drawThrottleResponseGraph(g_storedVar.activeCar.throttleCurveVertex.curveSpeedDiff,
+                                g_storedVar.activeCar.fade, prevTrigger, msgStr, (int8_t)selected);
+    } else {
+      inputEventsWait(TASK1_IDLE_WAIT_MS);
+    }
+
+    if (checkRaceModeEscape()) { requestEscapeToMain(); break; }
+  }
+
+  g_rotaryEncoder.setAcceleration(MENU_ACCELERATION);
+  setUiEncoderBoundaries(1, getMainMenuItemsCount(), false);
+  resetUiEncoder(getMainMenuSelector());
+  g_escVar.encoderPos = getMainMenuSelector();
+
+  if (!pointsCanceled && !isEscapeToMainRequested()) {
+    saveEEPROM(g_storedVar);
+  }
+
+  obdFill(&g_obd, OBD_WHITE, 1);
+}
+
 /**
  * Show the Throttle Curve selection screen. Shwon when the CURVE item is selected.
  * Draws the throttle curve graph as the actual live response, including FADE when enabled.
  * The CURVE parameter and the current trigger value are also displayed.
+ * Cars with a multi-point curve edit their points instead (showCurvePointsSelection()).
  */
 void showCurveSelection()
 {
+  if (throttleCurveShapeActive(&g_storedVar.activeCar.throttleCurveShape)) {
+    showCurvePointsSelection();
+    return;
+  }
+
   uint16_t prevTrigger = g_escVar.outputSpeed_pct;
-  uint16_t originalCurveValue = g_storedVar.carParam[g_carSel].throttleCurveVertex.curveSpeedDiff;
+  uint16_t originalCurveValue = g_storedVar.activeCar.throttleCurveVertex.curveSpeedDiff;
   bool curveCanceled = false;
 
   g_rotaryEncoder.setAcceleration(SEL_ACCELERATION);
   setUiEncoderBoundaries(THROTTLE_CURVE_SPEED_DIFF_MIN_VALUE, THROTTLE_CURVE_SPEED_DIFF_MAX_VALUE, false);
-  resetUiEncoder(g_storedVar.carParam[g_carSel].throttleCurveVertex.curveSpeedDiff);
-  snprintf(msgStr, sizeof(msgStr), "%3d%%", g_storedVar.carParam[g_carSel].throttleCurveVertex.curveSpeedDiff);
-  drawThrottleResponseGraph(g_storedVar.carParam[g_carSel].throttleCurveVertex.curveSpeedDiff,
-                            g_storedVar.carParam[g_carSel].fade,
+  resetUiEncoder(g_storedVar.activeCar.throttleCurveVertex.curveSpeedDiff);
+  snprintf(msgStr, sizeof(msgStr), "%3d%%", g_storedVar.activeCar.throttleCurveVertex.curveSpeedDiff);
+  drawThrottleResponseGraph(g_storedVar.activeCar.throttleCurveVertex.curveSpeedDiff,
+                            g_storedVar.activeCar.fade,
                             prevTrigger,
                             msgStr);
 
@@ -969,7 +1105,7 @@ void showCurveSelection()
         brakeBtnInCurve = true;
         lastBrakeBtnCurveTime = millis();
         /* Cancel changes - restore original value */
-        g_storedVar.carParam[g_carSel].throttleCurveVertex.curveSpeedDiff = originalCurveValue;
+        g_storedVar.activeCar.throttleCurveVertex.curveSpeedDiff = originalCurveValue;
         curveCanceled = true;
       }
     } else {
@@ -980,9 +1116,9 @@ void showCurveSelection()
     if (g_escVar.outputSpeed_pct != prevTrigger)
     {
       prevTrigger = g_escVar.outputSpeed_pct;
-      snprintf(msgStr, sizeof(msgStr), "%3d%%", g_storedVar.carParam[g_carSel].throttleCurveVertex.curveSpeedDiff);
-      drawThrottleResponseGraph(g_storedVar.carParam[g_carSel].throttleCurveVertex.curveSpeedDiff,
-                                g_storedVar.carParam[g_carSel].fade,
+      snprintf(msgStr, sizeof(msgStr), "%3d%%", g_storedVar.activeCar.throttleCurveVertex.curveSpeedDiff);
+      drawThrottleResponseGraph(g_storedVar.activeCar.throttleCurveVertex.curveSpeedDiff,
+                                g_storedVar.activeCar.fade,
                                 prevTrigger,
                                 msgStr);
     }
@@ -990,17 +1126,17 @@ void showCurveSelection()
     /* Get encoder position if it was changed and redraw the graph */
     if (g_rotaryEncoder.encoderChanged())
     {
-      g_storedVar.carParam[g_carSel].throttleCurveVertex.curveSpeedDiff = readUiEncoder();
-      snprintf(msgStr, sizeof(msgStr), "%3d%%", g_storedVar.carParam[g_carSel].throttleCurveVertex.curveSpeedDiff);
-      drawThrottleResponseGraph(g_storedVar.carParam[g_carSel].throttleCurveVertex.curveSpeedDiff,
-                                g_storedVar.carParam[g_carSel].fade,
+      g_storedVar.activeCar.throttleCurveVertex.curveSpeedDiff = readUiEncoder();
+      snprintf(msgStr, sizeof(msgStr), "%3d%%", g_storedVar.activeCar.throttleCurveVertex.curveSpeedDiff);
+      drawThrottleResponseGraph(g_storedVar.activeCar.throttleCurveVertex.curveSpeedDiff,
+                                g_storedVar.activeCar.fade,
                                 prevTrigger,
                                 msgStr);
     }
     else
     {
       /* Service the watchdog, to prevent CPU reset */
-      vTaskDelay(10);
+      inputEventsWait(TASK1_IDLE_WAIT_MS);
     }
 
     /* Long press = escape to main for race mode toggle */
@@ -1029,15 +1165,15 @@ void showCurveSelection()
 void showFadeSelection()
 {
   uint16_t prevTrigger = g_escVar.outputSpeed_pct;
-  uint16_t originalFadeValue = g_storedVar.carParam[g_carSel].fade;
+  uint16_t originalFadeValue = g_storedVar.activeCar.fade;
   bool fadeCanceled = false;
 
   g_rotaryEncoder.setAcceleration(SEL_ACCELERATION);
   setUiEncoderBoundaries(0, FADE_MAX_VALUE, false);
-  resetUiEncoder(g_storedVar.carParam[g_carSel].fade);
-  snprintf(msgStr, sizeof(msgStr), "%3d%%", g_storedVar.carParam[g_carSel].fade);
-  drawThrottleResponseGraph(g_storedVar.carParam[g_carSel].throttleCurveVertex.curveSpeedDiff,
-                            g_storedVar.carParam[g_carSel].fade,
+  resetUiEncoder(g_storedVar.activeCar.fade);
+  snprintf(msgStr, sizeof(msgStr), "%3d%%", g_storedVar.activeCar.fade);
+  drawThrottleResponseGraph(g_storedVar.activeCar.throttleCurveVertex.curveSpeedDiff,
+                            g_storedVar.activeCar.fade,
                             prevTrigger,
                             msgStr);
 
@@ -1049,7 +1185,7 @@ void showFadeSelection()
       if (!brakeBtnInFade && millis() - lastBrakeBtnFadeTime > BUTTON_SHORT_PRESS_DEBOUNCE_MS) {
         brakeBtnInFade = true;
         lastBrakeBtnFadeTime = millis();
-        g_storedVar.carParam[g_carSel].fade = originalFadeValue;
+        g_storedVar.activeCar.fade = originalFadeValue;
         fadeCanceled = true;
       }
     } else {
@@ -1059,25 +1195,25 @@ void showFadeSelection()
     if (g_escVar.outputSpeed_pct != prevTrigger)
     {
       prevTrigger = g_escVar.outputSpeed_pct;
-      snprintf(msgStr, sizeof(msgStr), "%3d%%", g_storedVar.carParam[g_carSel].fade);
-      drawThrottleResponseGraph(g_storedVar.carParam[g_carSel].throttleCurveVertex.curveSpeedDiff,
-                                g_storedVar.carParam[g_carSel].fade,
+      snprintf(msgStr, sizeof(msgStr), "%3d%%", g_storedVar.activeCar.fade);
+      drawThrottleResponseGraph(g_storedVar.activeCar.throttleCurveVertex.curveSpeedDiff,
+                                g_storedVar.activeCar.fade,
                                 prevTrigger,
                                 msgStr);
     }
 
     if (g_rotaryEncoder.encoderChanged())
     {
-      g_storedVar.carParam[g_carSel].fade = readUiEncoder();
-      snprintf(msgStr, sizeof(msgStr), "%3d%%", g_storedVar.carParam[g_carSel].fade);
-      drawThrottleResponseGraph(g_storedVar.carParam[g_carSel].throttleCurveVertex.curveSpeedDiff,
-                                g_storedVar.carParam[g_carSel].fade,
+      g_storedVar.activeCar.fade = readUiEncoder();
+      snprintf(msgStr, sizeof(msgStr), "%3d%%", g_storedVar.activeCar.fade);
+      drawThrottleResponseGraph(g_storedVar.activeCar.throttleCurveVertex.curveSpeedDiff,
+                                g_storedVar.activeCar.fade,
                                 prevTrigger,
                                 msgStr);
     }
     else
     {
-      vTaskDelay(10);
+      inputEventsWait(TASK1_IDLE_WAIT_MS);
     }
 
     if (checkRaceModeEscape()) { requestEscapeToMain(); break; }
@@ -0,0 +1,390 @@
+#include "motor_sweep.h"
+#include <Arduino.h>
+#include <string.h>
+#include "HAL.h"
+#include "half_bridge.h"
+#include "bemf_sampler.h"
+#include "latency_bench.h"
+
+static_assert(MOTOR_SWEEP_DUTY_POINTS >= 2, "the sweep needs a bottom and a top duty point");
+static_assert(MOTOR_SWEEP_DUTY_MAX_PERMILLE > MOTOR_SWEEP_DUTY_MIN_PERMILLE && MOTOR_SWEEP_DUTY_MAX_PERMILLE <= 1000,
+              "MOTOR_SWEEP_DUTY_* out of range");
+
+typedef enum {
+  MOTOR_SWEEP_PHASE_REST,
+  MOTOR_SWEEP_PHASE_SETTLE,
+  MOTOR_SWEEP_PHASE_MEASURE
+} MotorSweepPhase_enum;
+
+/* Published to Task1 under g_sweepMux */
+static portMUX_TYPE g_sweepMux = portMUX_INITIALIZER_UNLOCKED;
+static MotorSweepStatus_type g_sweepStatus;
+static volatile bool g_sweepStartRequested = false;
+static volatile bool g_sweepCancelRequested = false;
+static volatile uint32_t g_sweepRestoreFreq_hz = 0;
+
+/* Control task only */
+static bool g_sweepRunning = false;
+static uint8_t g_sweepPhase = MOTOR_SWEEP_PHASE_REST;
+static uint8_t g_sweepFreqIndex = 0;
+static uint8_t g_sweepDutyIndex = 0;
+static uint32_t g_sweepStart_ms = 0;
+static uint32_t g_sweepPhaseStart_ms = 0;
+static uint32_t g_sweepSumVin = 0;
+static uint32_t g_sweepSumCurrent = 0;
+static uint32_t g_sweepSumBemf = 0;
+static uint16_t g_sweepSamples = 0;
+static uint16_t g_sweepBemfSamples = 0;
+
+static uint16_t motorSweepFreq(uint8_t index) {
+  return (uint16_t)(FREQ_MIN_VALUE + (uint32_t)index * MOTOR_SWEEP_FREQ_STEP_HZ);
+}
+
+static uint16_t motorSweepDuty(uint8_t index) {
+  return (uint16_t)(MOTOR_SWEEP_DUTY_MIN_PERMILLE +
+                    (uint32_t)(MOTOR_SWEEP_DUTY_MAX_PERMILLE - MOTOR_SWEEP_DUTY_MIN_PERMILLE) * index /
+                    (MOTOR_SWEEP_DUTY_POINTS - 1U));
+}
+
+/**
+ * @brief Ask the control task to start a sweep (Task1)
+ * @param restoreFreq_hz PWM frequency to go back to when the sweep ends
+ * @return MOTOR_SWEEP_OK, or why it cannot run
+ */
+uint8_t motorSweepStart(uint32_t restoreFreq_hz) {
+  if (!HAL_HasMotorCurrentSense()) {
+    return MOTOR_SWEEP_ERR_NO_CURRENT_SENSE;
+  }
+  if (!bemfSamplerAvailable()) {
+    return MOTOR_SWEEP_ERR_NO_BEMF;
+  }
+  if (latencyBenchActive()) {
+    return MOTOR_SWEEP_ERR_BUSY;
+  }
+  portENTER_CRITICAL(&g_sweepMux);
+  if (g_sweepStatus.state == MOTOR_SWEEP_RUNNING) {
+    portEXIT_CRITICAL(&g_sweepMux);
+    return MOTOR_SWEEP_ERR_BUSY;
+  }
+  memset(&g_sweepStatus, 0, sizeof(g_sweepStatus));
+  for (uint8_t i = 0; i < MOTOR_SWEEP_MAX_FREQS; i++) {
+    g_sweepStatus.tempBefore_C[i] = MOTOR_SWEEP_TEMP_UNKNOWN;
+    g_sweepStatus.tempAfter_C[i] = MOTOR_SWEEP_TEMP_UNKNOWN;
+  }
+  g_sweepStatus.state = MOTOR_SWEEP_RUNNING;
+  g_sweepRestoreFreq_hz = restoreFreq_hz;
+  g_sweepCancelRequested = false;
+  g_sweepStartRequested = true;
+  portEXIT_CRITICAL(&g_sweepMux);
+  return MOTOR_SWEEP_OK;
+}
+
+/**
+ * @brief Stop a running sweep; the control task hands the bridge back on its next tick
+ */
+void motorSweepCancel() {
+  portENTER_CRITICAL(&g_sweepMux);
+  if (g_sweepStatus.state == MOTOR_SWEEP_RUNNING) {
+    g_sweepCancelRequested = true;
+  }
+  portEXIT_CRITICAL(&g_sweepMux);
+}
+
+bool motorSweepActive() {
+  return g_sweepRunning || g_sweepStartRequested;
+}
+
+static void motorSweepFinish(uint8_t state, uint8_t error, uint32_t now_ms) {
+  g_sweepRunning = false;
+  g_sweepCancelRequested = false;
+  HalfBridge_RequestPwmFrequency(g_sweepRestoreFreq_hz);
+  portENTER_CRITICAL(&g_sweepMux);
+  g_sweepStatus.state = state;
+  g_sweepStatus.error = error;
+  g_sweepStatus.freq_hz = 0;
+  g_sweepStatus.duty_permille = 0;
+  g_sweepStatus.elapsed_ms = now_ms - g_sweepStart_ms;
+  g_sweepStatus.endMs = now_ms;
+  portEXIT_CRITICAL(&g_sweepMux);
+}
+
+/* End of a rest: the junction reading taken during it closes the last frequency and opens the next */
+static void motorSweepRecordRestTemp(int16_t chipTemp_C, uint32_t chipTempAge_ms) {
+  int16_t temp = (chipTemp_C != MOTOR_SWEEP_TEMP_UNKNOWN && chipTempAge_ms < MOTOR_SWEEP_REST_MS)
+                 ? chipTemp_C : (int16_t)MOTOR_SWEEP_TEMP_UNKNOWN;
+  portENTER_CRITICAL(&g_sweepMux);
+  if (g_sweepFreqIndex > 0) {
+    g_sweepStatus.tempAfter_C[g_sweepFreqIndex - 1] = temp;
+  }
+  if (g_sweepFreqIndex < MOTOR_SWEEP_MAX_FREQS) {
+    g_sweepStatus.tempBefore_C[g_sweepFreqIndex] = temp;
+  }
+  portEXIT_CRITICAL(&g_sweepMux);
+}
+
+static void motorSweepRecordPoint() {
+  MotorSweepPoint_type point;
+  uint16_t n = (g_sweepSamples > 0) ? g_sweepSamples : 1U;
+  point.freq_hz = motorSweepFreq(g_sweepFreqIndex);
+  point.duty_permille = motorSweepDuty(g_sweepDutyIndex);
+  point.vin_mV = (uint16_t)(g_sweepSumVin / n);
+  point.current_mA = (uint16_t)(g_sweepSumCurrent / n);
+  point.bemf_mV = (g_sweepBemfSamples > 0) ? (uint16_t)(g_sweepSumBemf / g_sweepBemfSamples)
+                                           : (uint16_t)MOTOR_SWEEP_BEMF_UNKNOWN;
+  portENTER_CRITICAL(&g_sweepMux);
+  if (g_sweepStatus.pointCount < MOTOR_SWEEP_MAX_POINTS) {
+    g_sweepStatus.points[g_sweepStatus.pointCount++] = point;
+  }
+  portEXIT_CRITICAL(&g_sweepMux);
+}
+
+/**
+ * @brief Run one control tick of the sweep (Task2, in place of the trigger output)
+ * @param userInput Trigger pulled or brake button pressed: aborts
+ * @param derating Thermal model is limiting the output: aborts
+ * @param bemf_mV MOTOR_SWEEP_BEMF_UNKNOWN without a fresh estimate
+ * @param chipTemp_C Latest junction reading (MOTOR_SWEEP_TEMP_UNKNOWN if none) and its age
+ * @return true if the sweep owns the bridge this tick (duty_permille/drag_permille set)
+ */
+bool motorSweepControlTick(bool userInput, bool derating, uint16_t vin_mV, uint16_t current_mA,
+                           uint16_t bemf_mV, int16_t chipTemp_C, uint32_t chipTempAge_ms,
+                           uint16_t* duty_permille, uint16_t* drag_permille) {
+  uint32_t now_ms = millis();
+  if (g_sweepStartRequested) {
+    g_sweepStartRequested = false;
+    g_sweepRunning = true;
+    g_sweepPhase = MOTOR_SWEEP_PHASE_REST;
+    g_sweepFreqIndex = 0;
+    g_sweepDutyIndex = 0;
+    g_sweepStart_ms = now_ms;
+    g_sweepPhaseStart_ms = now_ms;
+  }
+  if (!g_sweepRunning) {
+    return false;
+  }
+
+  uint8_t error = MOTOR_SWEEP_OK;
+  if (g_sweepCancelRequested) error = MOTOR_SWEEP_ERR_CANCELLED;
+  else if (userInput) error = MOTOR_SWEEP_ERR_INPUT;
+  else if (derating) error = MOTOR_SWEEP_ERR_THERMAL;
+  if (error != MOTOR_SWEEP_OK) {
+    motorSweepFinish(MOTOR_SWEEP_ABORTED, error, now_ms);
+    return false;
+  }
+
+  uint32_t inPhase_ms = now_ms - g_sweepPhaseStart_ms;
+  *drag_permille = 0;  /* Floating off-phase: the back-EMF sampler needs it */
+  switch (g_sweepPhase) {
+    case MOTOR_SWEEP_PHASE_REST:
+      *duty_permille = 0;
+      if (inPhase_ms < MOTOR_SWEEP_REST_MS) {
+        break;
+      }
+      motorSweepRecordRestTemp(chipTemp_C, chipTempAge_ms);
+      if (g_sweepFreqIndex >= MOTOR_SWEEP_MAX_FREQS) {
+        motorSweepFinish(MOTOR_SWEEP_DONE, MOTOR_SWEEP_OK, now_ms);
+        return false;
+      }
+      HalfBridge_RequestPwmFrequency(motorSweepFreq(g_sweepFreqIndex));  /* Applied from the next tick */
+      g_sweepDutyIndex = 0;
+      g_sweepPhase = MOTOR_SWEEP_PHASE_SETTLE;
+      g_sweepPhaseStart_ms = now_ms;
+      *duty_permille = motorSweepDuty(0);
+      break;
+
+    case MOTOR_SWEEP_PHASE_SETTLE:
+      *duty_permille = motorSweepDuty(g_sweepDutyIndex);
+      if (inPhase_ms >= MOTOR_SWEEP_SETTLE_MS) {
+        g_sweepPhase = MOTOR_SWEEP_PHASE_MEASURE;
+        g_sweepPhaseStart_ms = now_ms;
+        g_sweepSumVin = 0;
+        g_sweepSumCurrent = 0;
+        g_sweepSumBemf = 0;
+        g_sweepSamples = 0;
+        g_sweepBemfSamples = 0;
+      }
+      break;
+
+    case MOTOR_SWEEP_PHASE_MEASURE:
+    default:
+      *duty_permille = motorSweepDuty(g_sweepDutyIndex);
+      g_sweepSumVin += vin_mV;
+      g_sweepSumCurrent += current_mA;
+      g_sweepSamples++;
+      if (bemf_mV != MOTOR_SWEEP_BEMF_UNKNOWN) {
+        g_sweepSumBemf += bemf_mV;
+        g_sweepBemfSamples++;
+      }
+      if (inPhase_ms < MOTOR_SWEEP_MEASURE_MS) {
+        break;
+      }
+      motorSweepRecordPoint();
+      g_sweepPhaseStart_ms = now_ms;
+      if (++g_sweepDutyIndex < MOTOR_SWEEP_DUTY_POINTS) {
+        g_sweepPhase = MOTOR_SWEEP_PHASE_SETTLE;
+        *duty_permille = motorSweepDuty(g_sweepDutyIndex);
+      } else {
+        g_sweepFreqIndex++;
+        g_sweepPhase = MOTOR_SWEEP_PHASE_REST;
+        *duty_permille = 0;
+      }
+      break;
+  }
+
+  portENTER_CRITICAL(&g_sweepMux);
+  g_sweepStatus.freqCount = (g_sweepPhase == MOTOR_SWEEP_PHASE_REST) ? g_sweepFreqIndex : (uint8_t)(g_sweepFreqIndex + 1U);
+  g_sweepStatus.freq_hz = (g_sweepPhase == MOTOR_SWEEP_PHASE_REST) ? 0U : motorSweepFreq(g_sweepFreqIndex);
+  g_sweepStatus.duty_permille = *duty_permille;
+  g_sweepStatus.elapsed_ms = now_ms - g_sweepStart_ms;
+  portEXIT_CRITICAL(&g_sweepMux);
+  return true;
+}
+
+void motorSweepGetStatus(MotorSweepStatus_type* out) {
+  if (out == NULL) {
+    return;
+  }
+  portENTER_CRITICAL(&g_sweepMux);
+  *out = g_sweepStatus;
+  portEXIT_CRITICAL(&g_sweepMux);
+}
+
+/* Least-squares sums of one set of points: drop = R * I, and back-EMF against current */
+typedef struct {
+  uint64_t dropCurrent;   /* [mV*mA] */
+  uint64_t currentSq;     /* [mA^2] */
+  uint32_t bemf;          /* [mV] */
+  uint32_t current;       /* [mA] */
+  uint16_t points;
+} MotorSweepFit_type;
+
+static void motorSweepFitAdd(MotorSweepFit_type* fit, const MotorSweepPoint_type* p) {
+  if (p->current_mA < MOTOR_SWEEP_MIN_CURRENT_MA || p->bemf_mV == MOTOR_SWEEP_BEMF_UNKNOWN) {
+    return;
+  }
+  uint32_t applied_mV = (uint32_t)p->vin_mV * p->duty_permille / 1000U;
+  uint32_t drop_mV = (applied_mV > p->bemf_mV) ? (applied_mV - p->bemf_mV) : 0U;
+  fit->dropCurrent += (uint64_t)drop_mV * p->current_mA;
+  fit->currentSq += (uint64_t)p->current_mA * p->current_mA;
+  fit->bemf += p->bemf_mV;
+  fit->current += p->current_mA;
+  fit->points++;
+}
+
+static uint16_t motorSweepFitRes(const MotorSweepFit_type* fit) {
+  if (fit->currentSq == 0) {
+    return 0;
+  }
+  uint64_t res_mOhm = fit->dropCurrent * 1000U / fit->currentSq;
+  return (uint16_t)((res_mOhm > UINT16_MAX) ? UINT16_MAX : res_mOhm);
+}
+
+/**
+ * @brief Estimate the motor figures and pick a PWM frequency from a finished sweep (any task)
+ */
+void motorSweepAnalyze(const MotorSweepStatus_type* status, MotorSweepResult_type* out) {
+  memset(out, 0, sizeof(*out));
+  MotorSweepFit_type all = {0, 0, 0, 0, 0};
+  uint16_t topBemf_mV = 0;
+  uint8_t freqCount = (status->freqCount < MOTOR_SWEEP_MAX_FREQS) ? status->freqCount : (uint8_t)MOTOR_SWEEP_MAX_FREQS;
+
+  for (uint8_t f = 0; f < freqCount; f++) {
+    MotorSweepFreqResult_type* fr = &out->freqs[f];
+    MotorSweepFit_type fit = {0, 0, 0, 0, 0};
+    fr->freq_hz = motorSweepFreq(f);
+    for (uint16_t i = 0; i < status->pointCount; i++) {
+      const MotorSweepPoint_type* p = &status->points[i];
+      if (p->freq_hz != fr->freq_hz) {
+        continue;
+      }
+      motorSweepFitAdd(&fit, p);
+      motorSweepFitAdd(&all, p);
+      if (p->duty_permille == MOTOR_SWEEP_DUTY_MAX_PERMILLE && p->bemf_mV != MOTOR_SWEEP_BEMF_UNKNOWN &&
+          p->bemf_mV > topBemf_mV) {
+        topBemf_mV = p->bemf_mV;
+      }
+    }
+    fr->points = fit.points;
+    fr->res_mOhm = motorSweepFitRes(&fit);
+    fr->bemfPerAmp_mV = (fit.current > 0) ? (uint16_t)min((uint64_t)UINT16_MAX, (uint64_t)fit.bemf * 1000U / fit.current) : 0U;
+    bool tempKnown = status->tempBefore_C[f] != MOTOR_SWEEP_TEMP_UNKNOWN && status->tempAfter_C[f] != MOTOR_SWEEP_TEMP_UNKNOWN;
+    fr->tempRise_C = tempKnown ? (int16_t)(status->tempAfter_C[f] - status->tempBefore_C[f]) : (int16_t)MOTOR_SWEEP_TEMP_UNKNOWN;
+  }
+  out->freqCount = freqCount;
+  out->valid = all.points > 0;
+  out->res_mOhm = motorSweepFitRes(&all);
+  out->freeRunning = topBemf_mV >= MOTOR_SWEEP_SPIN_MIN_MV;
+  if (!out->valid) {
+    return;
+  }
+
+  /* Free motor: best speed per amp, ties within the tolerance go to the cooler frequency.
+     Blocked motor: torque per amp does not depend on the frequency, only the heating does. */
+  uint16_t bestScore = 0;
+  for (uint8_t f = 0; f < freqCount; f++) {
+    if (out->freqs[f].points > 0 && out->freqs[f].bemfPerAmp_mV > bestScore) {
+      bestScore = out->freqs[f].bemfPerAmp_mV;
+    }
+  }
+  int8_t pick = -1;
+  for (uint8_t f = 0; f < freqCount; f++) {
+    const MotorSweepFreqResult_type* fr = &out->freqs[f];
+    if (fr->points == 0) {
+      continue;
+    }
+    if (out->freeRunning && (uint32_t)fr->bemfPerAmp_mV * 100U < (uint32_t)bestScore * (100U - MOTOR_SWEEP_SCORE_TOL_PCT)) {
+      continue;
+    }
+    if (!out->freeRunning && fr->tempRise_C == MOTOR_SWEEP_TEMP_UNKNOWN) {
+      continue;
+    }
+    if (pick < 0) {
+      pick = (int8_t)f;
+      continue;
+    }
+    const MotorSweepFreqResult_type* best = &out->freqs[pick];
+    bool bothTemps = fr->tempRise_C != MOTOR_SWEEP_TEMP_UNKNOWN && best->tempRise_C != MOTOR_SWEEP_TEMP_UNKNOWN;
+    if (bothTemps ? (fr->tempRise_C < best->tempRise_C ||
+                     (fr->tempRise_C == best->tempRise_C && fr->bemfPerAmp_mV > best->bemfPerAmp_mV))
+                  : (fr->bemfPerAmp_mV > best->bemfPerAmp_mV)) {
+      pick = (int8_t)f;
+    }
+  }
+  if (pick < 0) {
+    return;
+  }
+  out->recommendedFreq_hz = out->freqs[pick].freq_hz;
+  if (out->freeRunning) {
+    for (uint16_t i = 0; i < status->pointCount; i++) {
+      const MotorSweepPoint_type* p = &status->points[i];
+      if (p->freq_hz == out->recommendedFreq_hz && p->duty_permille == MOTOR_SWEEP_DUTY_MAX_PERMILLE) {
+        out->noLoad_mA = p->current_mA;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Store the sweep figures in a car profile (the PWM frequency itself is left alone)
+ */
+void motorSweepApplyToCar(const MotorSweepResult_type* result, CarParam_type* car) {
+  if (!result->valid) {
+    return;
+  }
+  car->motorResistance = result->res_mOhm;
+  car->motorNoLoadCurrent = result->noLoad_mA;
+  car->freqPWMSweep = result->recommendedFreq_hz / 100U;
+}
+
+const char* motorSweepErrorText(uint8_t error) {
+  switch (error) {
+    case MOTOR_SWEEP_OK:                   return "ok";
+    case MOTOR_SWEEP_ERR_NO_CURRENT_SENSE: return "no current sense";
+    case MOTOR_SWEEP_ERR_NO_BEMF:          return "no back-EMF (WiFi on?)";
+    case MOTOR_SWEEP_ERR_BUSY:             return "already running";
+    case MOTOR_SWEEP_ERR_INPUT:            return "trigger or brake";
+    case MOTOR_SWEEP_ERR_THERMAL:          return "thermal limit";
+    case MOTOR_SWEEP_ERR_CANCELLED:
+    default:                               return "cancelled";
+  }
+}
@@ -0,0 +1,117 @@
+#ifndef MOTOR_SWEEP_H_
+#define MOTOR_SWEEP_H_
+
+#include <stdint.h>
+#include "slot_ESC.h"
+
+/* Motor characterization sweep (control task).
+ * With the car lifted (wheels free) or held still, the control task takes the bridge over
+ * from the trigger path and, for every PWM frequency from FREQ_MIN_VALUE to FREQ_MAX_VALUE in
+ * MOTOR_SWEEP_FREQ_STEP_HZ steps, drives MOTOR_SWEEP_DUTY_POINTS duty levels with no drag:
+ *   - each point settles for MOTOR_SWEEP_SETTLE_MS, then supply voltage, mean motor current
+ *     and back-EMF are averaged over MOTOR_SWEEP_MEASURE_MS
+ *   - a coast pause of MOTOR_SWEEP_REST_MS before the first and after every frequency lets
+ *     the thermal model take a junction reading (BTN99x0 builds), so each frequency gets a
+ *     temperature rise
+ * Pulling the trigger, pressing the brake button or thermal derating aborts at once and
+ * hands the bridge back; the car's own PWM frequency is restored at the end either way.
+ * motorSweepAnalyze() turns the points into (applied voltage - back-EMF) / current, least
+ * squares over all points, for the winding resistance. On a free-running motor the no-load
+ * current is what the top duty point draws, and each frequency is scored by back-EMF per
+ * amp (speed per amp, the torque-per-amp figure at a fixed load). Scores within
+ * MOTOR_SWEEP_SCORE_TOL_PCT of the best are split by the lower temperature rise. A blocked
+ * motor has no back-EMF, so only the temperature rise picks its frequency. The torque
+ * constant itself needs a speed reference and is not estimated.
+ * Needs motor current sense and a back-EMF reading (WiFi off: ADC2 belongs to the radio). */
+#ifndef MOTOR_SWEEP_FREQ_STEP_HZ
+#define MOTOR_SWEEP_FREQ_STEP_HZ       1000U
+#endif
+#define MOTOR_SWEEP_MAX_FREQS          ((FREQ_MAX_VALUE - FREQ_MIN_VALUE) / MOTOR_SWEEP_FREQ_STEP_HZ + 1U)
+#ifndef MOTOR_SWEEP_DUTY_POINTS
+#define MOTOR_SWEEP_DUTY_POINTS        5U
+#endif
+#ifndef MOTOR_SWEEP_DUTY_MIN_PERMILLE
+#define MOTOR_SWEEP_DUTY_MIN_PERMILLE  150U
+#endif
+#ifndef MOTOR_SWEEP_DUTY_MAX_PERMILLE
+#define MOTOR_SWEEP_DUTY_MAX_PERMILLE  550U    /* Top point; keeps a lifted car's wheels sane */
+#endif
+#define MOTOR_SWEEP_MAX_POINTS         (MOTOR_SWEEP_MAX_FREQS * MOTOR_SWEEP_DUTY_POINTS)
+#define MOTOR_SWEEP_SETTLE_MS          400U
+#define MOTOR_SWEEP_MEASURE_MS         200U
+#define MOTOR_SWEEP_REST_MS            2500U   /* Coast pause, long enough for one junction reading */
+#define MOTOR_SWEEP_MIN_CURRENT_MA     50U     /* Points below this are left out of the fit */
+#define MOTOR_SWEEP_SPIN_MIN_MV        300U    /* Top-point back-EMF above this: motor was free */
+#define MOTOR_SWEEP_SCORE_TOL_PCT      3U
+#define MOTOR_SWEEP_BEMF_UNKNOWN       0xFFFFU
+#define MOTOR_SWEEP_TEMP_UNKNOWN       INT16_MIN
+
+typedef enum {
+  MOTOR_SWEEP_IDLE,
+  MOTOR_SWEEP_RUNNING,
+  MOTOR_SWEEP_DONE,
+  MOTOR_SWEEP_ABORTED
+} MotorSweepState_enum;
+
+typedef enum {
+  MOTOR_SWEEP_OK,
+  MOTOR_SWEEP_ERR_NO_CURRENT_SENSE,
+  MOTOR_SWEEP_ERR_NO_BEMF,      /* Back-EMF sampler not running or WiFi on */
+  MOTOR_SWEEP_ERR_BUSY,
+  MOTOR_SWEEP_ERR_INPUT,        /* Trigger or brake button */
+  MOTOR_SWEEP_ERR_THERMAL,      /* Thermal model started derating */
+  MOTOR_SWEEP_ERR_CANCELLED
+} MotorSweepError_enum;
+
+typedef struct {
+  uint16_t freq_hz;
+  uint16_t duty_permille;
+  uint16_t vin_mV;              /* Means over the measuring window */
+  uint16_t current_mA;
+  uint16_t bemf_mV;             /* MOTOR_SWEEP_BEMF_UNKNOWN without a reading */
+} MotorSweepPoint_type;
+
+typedef struct {
+  uint8_t state;                /* MotorSweepState_enum */
+  uint8_t error;                /* MotorSweepError_enum, why it aborted */
+  uint8_t freqCount;            /* Frequencies started */
+  uint16_t pointCount;          /* Points measured */
+  uint16_t freq_hz;             /* Being driven now, 0 while resting */
+  uint16_t duty_permille;
+  uint32_t elapsed_ms;
+  uint32_t endMs;               /* millis() at DONE/ABORTED */
+  int16_t tempBefore_C[MOTOR_SWEEP_MAX_FREQS];  /* Junction at the rest before/after each frequency */
+  int16_t tempAfter_C[MOTOR_SWEEP_MAX_FREQS];
+  MotorSweepPoint_type points[MOTOR_SWEEP_MAX_POINTS];
+} MotorSweepStatus_type;
+
+typedef struct {
+  uint16_t freq_hz;
+  uint16_t points;              /* Points that made the fit */
+  uint16_t res_mOhm;            /* 0 = no points */
+  uint16_t bemfPerAmp_mV;       /* [mV/A] back-EMF over the current, over all points, 0 = blocked */
+  int16_t tempRise_C;           /* MOTOR_SWEEP_TEMP_UNKNOWN without both readings */
+} MotorSweepFreqResult_type;
+
+typedef struct {
+  bool valid;                   /* At least one point made the fit */
+  bool freeRunning;             /* Motor turned (lifted car) */
+  uint16_t res_mOhm;
+  uint16_t noLoad_mA;           /* Top duty at the recommended frequency, 0 if blocked */
+  uint16_t recommendedFreq_hz;  /* 0 = no pick */
+  uint8_t freqCount;
+  MotorSweepFreqResult_type freqs[MOTOR_SWEEP_MAX_FREQS];
+} MotorSweepResult_type;
+
+uint8_t motorSweepStart(uint32_t restoreFreq_hz);
+void motorSweepCancel();
+bool motorSweepActive();
+bool motorSweepControlTick(bool userInput, bool derating, uint16_t vin_mV, uint16_t current_mA,
+                           uint16_t bemf_mV, int16_t chipTemp_C, uint32_t chipTempAge_ms,
+                           uint16_t* duty_permille, uint16_t* drag_permille);
+void motorSweepGetStatus(MotorSweepStatus_type* out);
+void motorSweepAnalyze(const MotorSweepStatus_type* status, MotorSweepResult_type* out);
+void motorSweepApplyToCar(const MotorSweepResult_type* result, CarParam_type* car);
+const char* motorSweepErrorText(uint8_t error);
+
+#endif  /* MOTOR_SWEEP_H_ */
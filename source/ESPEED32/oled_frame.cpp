@@ -0,0 +1,130 @@
+#include "oled_frame.h"
+#include <Arduino.h>
+#include <string.h>
+
+extern OBDISP g_obd;
+
+#ifdef USE_BACKBUFFER
+static uint8_t g_oledShadow[OLED_FRAME_PAGES * OLED_WIDTH];
+static bool g_oledShadowValid = false;   /* Panel content unknown until the first full flush */
+#endif
+
+/**
+ * @brief Clear the screen for a retained frame (pushed by the next oledFrameFlush())
+ */
+void oledFrameClear() {
+  obdFill(&g_obd, OBD_WHITE, OLED_FRAME_RENDER);
+}
+
+/**
+ * @brief Forget what the panel shows; the next flush sends the whole back buffer
+ */
+void oledFrameInvalidate() {
+#ifdef USE_BACKBUFFER
+  g_oledShadowValid = false;
+#endif
+}
+
+/**
+ * @brief Send the parts of the back buffer that differ from the panel
+ * @details One window per run of changed columns in a page; runs closer than
+ *          OLED_FRAME_MERGE_GAP are merged since a new window costs more than a few bytes.
+ */
+void oledFrameFlush() {
+#ifdef USE_BACKBUFFER
+  const uint8_t* screen = g_obd.ucScreen;
+  if (screen == NULL) return;
+
+  for (uint8_t page = 0; page < OLED_FRAME_PAGES; page++) {
+    const uint8_t* src = &screen[page * OLED_WIDTH];
+    uint8_t* shadow = &g_oledShadow[page * OLED_WIDTH];
+    int x = 0;
+    while (x < OLED_WIDTH) {
+      if (g_oledShadowValid && src[x] == shadow[x]) {
+        x++;
+        continue;
+      }
+      int start = x;
+      int end = x + 1;   /* Exclusive */
+      int gap = 0;
+      for (x = end; x < OLED_WIDTH && gap < OLED_FRAME_MERGE_GAP; x++) {
+        if (!g_oledShadowValid || src[x] != shadow[x]) {
+          end = x + 1;
+          gap = 0;
+        } else {
+          gap++;
+        }
+      }
+      obdDumpWindow(&g_obd, &g_obd, start, page * 8, start, page * 8, end - start, 8);
+      memcpy(&shadow[start], &src[start], end - start);
+      x = end;
+    }
+  }
+  g_oledShadowValid = true;
+#endif
+}
+
+static void oledFontCell(uint8_t font, uint8_t* w, uint8_t* h) {
+  switch (font) {
+    case FONT_6x8:   *w = 6;  *h = 8;  break;
+    case FONT_8x8:   *w = 8;  *h = 8;  break;
+    case FONT_12x16: *w = 12; *h = 16; break;
+    case FONT_16x16: *w = 16; *h = 16; break;
+    case FONT_16x32:
+    default:         *w = 16; *h = 32; break;
+  }
+}
+
+#ifdef USE_BACKBUFFER
+/* FNV-1a over the back buffer bytes the field's text box touches */
+static uint32_t oledFieldPixelHash(const OledField_type* field) {
+  const uint8_t* screen = g_obd.ucScreen;
+  uint8_t cw, ch;
+  oledFontCell(field->font, &cw, &ch);
+  int x0 = max((int)field->x, 0);
+  int x1 = min((int)field->x + (int)strlen(field->text) * cw, OLED_WIDTH);
+  int p0 = max((int)field->y, 0) / 8;
+  int p1 = min(((int)field->y + ch - 1) / 8, OLED_FRAME_PAGES - 1);
+
+  uint32_t hash = 2166136261UL;
+  for (int p = p0; p <= p1; p++) {
+    for (int x = x0; x < x1; x++) {
+      hash = (hash ^ screen[p * OLED_WIDTH + x]) * 16777619UL;
+    }
+  }
+  return hash;
+}
+#endif
+
+void oledFieldInvalidate(OledField_type* field) {
+  if (field) field->valid = false;
+}
+
+/**
+ * @brief Draw a text field into the frame unless it already shows exactly this
+ * @return true if the text was (re)drawn
+ */
+bool oledFieldDraw(OledField_type* field, int x, int y, const char* text, uint8_t font, uint8_t color) {
+  if (!field || !text) return false;
+
+#ifdef USE_BACKBUFFER
+  if (field->valid && field->x == x && field->y == y && field->font == font && field->color == color &&
+      strncmp(field->text, text, sizeof(field->text)) == 0 &&
+      oledFieldPixelHash(field) == field->pixelHash) {
+    return false;
+  }
+#endif
+
+  strncpy(field->text, text, sizeof(field->text) - 1);
+  field->text[sizeof(field->text) - 1] = '\0';
+  field->x = (int16_t)x;
+  field->y = (int16_t)y;
+  field->font = font;
+  field->color = color;
+  obdWriteString(&g_obd, 0, x, y, (char*)text, font, color, OLED_FRAME_RENDER);
+#ifdef USE_BACKBUFFER
+  field->pixelHash = oledFieldPixelHash(field);
+  field->valid = true;
+#endif
+  return true;
+}
@@ -0,0 +1,42 @@
+#ifndef OLED_FRAME_H_
+#define OLED_FRAME_H_
+
+#include <stdint.h>
+#include <OneBitDisplay.h>
+#include "HAL.h"
+
+/* Retained-mode layer over the OneBitDisplay back buffer.
+ * Screens draw into the back buffer only (no I2C) and call oledFrameFlush() once per frame;
+ * the flush compares every 8-row page with a shadow of what the panel already shows and
+ * sends just the changed column runs. Fields skip even the back buffer draw while their
+ * formatted text, position and colour are unchanged and their pixels are still intact, so
+ * a screen cleared by other code (obdFill with render) is repainted without any extra bookkeeping.
+ * Without USE_BACKBUFFER everything degrades to the previous immediate drawing. */
+#define OLED_FRAME_PAGES        (OLED_HEIGHT / 8)
+#define OLED_FRAME_MERGE_GAP    8     /* Unchanged columns bridged inside one window instead of a new one */
+#define OLED_FIELD_TEXT_MAX     22    /* 128 px / 6 px font + terminator */
+
+/* bRender argument for obd* calls that are part of a retained frame */
+#ifdef USE_BACKBUFFER
+#define OLED_FRAME_RENDER       0
+#else
+#define OLED_FRAME_RENDER       1
+#endif
+
+typedef struct {
+  char text[OLED_FIELD_TEXT_MAX];
+  int16_t x;
+  int16_t y;
+  uint8_t font;
+  uint8_t color;
+  bool valid;
+  uint32_t pixelHash;     /* Back buffer bytes under the field right after it was drawn */
+} OledField_type;
+
+void oledFrameClear();
+void oledFrameFlush();
+void oledFrameInvalidate();
+void oledFieldInvalidate(OledField_type* field);
+bool oledFieldDraw(OledField_type* field, int x, int y, const char* text, uint8_t font, uint8_t color);
+
+#endif  /* OLED_FRAME_H_ */
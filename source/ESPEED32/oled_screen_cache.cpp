@@ -0,0 +1,106 @@
+#include "oled_screen_cache.h"
+#include <Arduino.h>
+#include <string.h>
+
+extern OBDISP g_obd;
+
+#define OLED_SCREEN_BYTES   (OLED_FRAME_PAGES * OLED_WIDTH)
+
+#ifdef USE_BACKBUFFER
+typedef struct {
+  uint32_t key;                         /* 0 = empty */
+  uint32_t lastUse;                     /* g_oledScreenUseCounter at the last hit or store */
+  uint8_t pixels[OLED_SCREEN_BYTES];
+} OledScreenSlot_type;
+
+static OledScreenSlot_type g_oledScreenSlots[OLED_SCREEN_CACHE_SLOTS];
+static uint32_t g_oledScreenUseCounter = 0;
+#endif
+static OledScreenCacheStats_type g_oledScreenStats = {0, 0};
+
+/**
+ * @brief Start a screen key (FNV-1a, seeded with the screen so equal inputs on two screens differ)
+ */
+uint32_t oledScreenKeyBegin(OledScreen_enum screen) {
+  uint32_t key = 2166136261UL;
+  return oledScreenKeyAdd(key, &screen, sizeof(screen));
+}
+
+uint32_t oledScreenKeyAdd(uint32_t key, const void* data, size_t len) {
+  const uint8_t* p = (const uint8_t*)data;
+  for (size_t i = 0; i < len; i++) {
+    key = (key ^ p[i]) * 16777619UL;
+  }
+  return key;
+}
+
+/**
+ * @brief Add a string including its terminator, so "ab"+"c" and "a"+"bc" differ
+ */
+uint32_t oledScreenKeyAddString(uint32_t key, const char* text) {
+  if (text == nullptr) text = "";
+  return oledScreenKeyAdd(key, text, strlen(text) + 1);
+}
+
+/* One full-screen send: the panel may have been drawn by code that bypasses the frame shadow */
+static void oledScreenSendAll() {
+  oledFrameInvalidate();
+  oledFrameFlush();
+}
+
+/**
+ * @brief Show a cached screen
+ * @return true if the key was cached and is now on the panel; false = draw it (into the
+ *         back buffer, OLED_FRAME_RENDER) and call oledScreenCachePresent()
+ */
+bool oledScreenCacheShow(uint32_t key) {
+#ifdef USE_BACKBUFFER
+  if (key != 0 && g_obd.ucScreen != NULL) {
+    for (uint8_t i = 0; i < OLED_SCREEN_CACHE_SLOTS; i++) {
+      OledScreenSlot_type* slot = &g_oledScreenSlots[i];
+      if (slot->key == key) {
+        memcpy(g_obd.ucScreen, slot->pixels, OLED_SCREEN_BYTES);
+        slot->lastUse = ++g_oledScreenUseCounter;
+        g_oledScreenStats.hits++;
+        oledScreenSendAll();
+        return true;
+      }
+    }
+  }
+#endif
+  g_oledScreenStats.misses++;
+  return false;
+}
+
+/**
+ * @brief Send the freshly drawn back buffer and keep a copy under key (replaces the least recently used)
+ */
+void oledScreenCachePresent(uint32_t key) {
+#ifdef USE_BACKBUFFER
+  if (key != 0 && g_obd.ucScreen != NULL) {
+    OledScreenSlot_type* victim = &g_oledScreenSlots[0];
+    for (uint8_t i = 0; i < OLED_SCREEN_CACHE_SLOTS; i++) {
+      OledScreenSlot_type* slot = &g_oledScreenSlots[i];
+      if (slot->key == key) {
+        victim = slot;
+        break;
+      }
+      if (slot->lastUse < victim->lastUse) {
+        victim = slot;   /* Empty slots have lastUse 0 and go first */
+      }
+    }
+    memcpy(victim->pixels, g_obd.ucScreen, OLED_SCREEN_BYTES);
+    victim->key = key;
+    victim->lastUse = ++g_oledScreenUseCounter;
+  }
+  oledScreenSendAll();
+#else
+  (void)key;
+#endif
+}
+
+void oledScreenCacheGetStats(OledScreenCacheStats_type* outStats) {
+  if (outStats != nullptr) {
+    *outStats = g_oledScreenStats;
+  }
+}
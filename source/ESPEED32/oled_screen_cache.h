@@ -0,0 +1,37 @@
+#ifndef OLED_SCREEN_CACHE_H_
+#define OLED_SCREEN_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "oled_frame.h"
+
+/* Rendered copies of static full screens (WiFi QR, screensaver, welcome, About pages).
+ * A screen is keyed by a hash of everything it is drawn from (SSID/password, text, page);
+ * a hit copies the stored framebuffer into the back buffer and sends it in one full flush,
+ * skipping the QR encoder and the glyph-by-glyph font rendering. Inputs that change give a
+ * new key, so nothing has to be invalidated: old screens simply age out (least recently used).
+ * RAM only, Task1 only. Without USE_BACKBUFFER nothing is cached and screens draw as before. */
+#ifndef OLED_SCREEN_CACHE_SLOTS
+#define OLED_SCREEN_CACHE_SLOTS   4     /* 1 KB each */
+#endif
+
+typedef enum {
+  OLED_SCREEN_WIFI_QR = 1,
+  OLED_SCREEN_SCREENSAVER,
+  OLED_SCREEN_WELCOME,
+  OLED_SCREEN_ABOUT
+} OledScreen_enum;
+
+typedef struct {
+  uint32_t hits;
+  uint32_t misses;
+} OledScreenCacheStats_type;
+
+uint32_t oledScreenKeyBegin(OledScreen_enum screen);
+uint32_t oledScreenKeyAdd(uint32_t key, const void* data, size_t len);
+uint32_t oledScreenKeyAddString(uint32_t key, const char* text);
+bool oledScreenCacheShow(uint32_t key);
+void oledScreenCachePresent(uint32_t key);
+void oledScreenCacheGetStats(OledScreenCacheStats_type* outStats);
+
+#endif  /* OLED_SCREEN_CACHE_H_ */
@@ -0,0 +1,471 @@
+#include "ota_pipeline.h"
+#include <Arduino.h>
+#include <Update.h>
+#include <esp_ota_ops.h>
+#include <esp_partition.h>
+#include <mbedtls/sha256.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <string.h>
+
+#define OTA_PIPELINE_CMD_DATA   0
+#define OTA_PIPELINE_CMD_END    1
+#define OTA_PIPELINE_CMD_ABORT  2
+
+typedef struct {
+  uint8_t cmd;
+  uint8_t index;
+  uint16_t len;
+} OtaPipelineMsg_type;
+
+typedef enum {
+  OTA_DELTA_PHASE_HEADER = 0,
+  OTA_DELTA_PHASE_OP,
+  OTA_DELTA_PHASE_LITERAL,
+  OTA_DELTA_PHASE_FILL
+} OtaDeltaPhase_enum;
+
+/* Writer-task state: set up by otaPipelineBegin() before the first message is queued,
+ * afterwards only touched by the writer task until it gives g_otaDoneSem */
+typedef struct {
+  bool targetSpiffs;
+  bool updateBegun;
+  bool formatKnown;
+  bool delta;
+  bool haveExpectedSha;
+  uint8_t expectedSha[32];
+  mbedtls_sha256_context sha;
+  size_t imageSize;
+  size_t offset;                /* Image bytes written so far */
+  uint8_t deltaPhase;           /* OtaDeltaPhase_enum */
+  uint8_t header[OTA_DELTA_HEADER_SIZE];
+  size_t headerLen;
+  size_t blockSize;
+  size_t literalRemaining;
+  const esp_partition_t* source;
+} OtaWriter_type;
+
+static QueueHandle_t g_otaFullQueue = NULL;
+static QueueHandle_t g_otaFreeQueue = NULL;
+static SemaphoreHandle_t g_otaDoneSem = NULL;
+static TaskHandle_t g_otaWriterTask = NULL;
+static uint8_t* g_otaBufs[OTA_PIPELINE_BUF_COUNT];
+static uint8_t* g_otaScratch = NULL;       /* Delta COPY/FILL block */
+static OtaWriter_type g_otaWriter;
+static volatile bool g_otaWriterBusy = false;
+static volatile bool g_otaAbortRequested = false;
+
+/* Network side fill state (upload handler only) */
+static bool g_otaHaveFill = false;
+static uint8_t g_otaFillIndex = 0;
+static size_t g_otaFillLen = 0;
+
+static OtaPipelineStatus_type g_otaStatus;
+static portMUX_TYPE g_otaMux = portMUX_INITIALIZER_UNLOCKED;
+
+static void otaPipelineFail(const char* error) {
+  portENTER_CRITICAL(&g_otaMux);
+  if (g_otaStatus.state != OTA_PIPELINE_FAILED) {
+    g_otaStatus.state = OTA_PIPELINE_FAILED;
+    strncpy(g_otaStatus.error, error, sizeof(g_otaStatus.error) - 1);
+    g_otaStatus.error[sizeof(g_otaStatus.error) - 1] = '\0';
+  }
+  portEXIT_CRITICAL(&g_otaMux);
+}
+
+static bool otaPipelineFailed() {
+  portENTER_CRITICAL(&g_otaMux);
+  bool failed = (g_otaStatus.state == OTA_PIPELINE_FAILED);
+  portEXIT_CRITICAL(&g_otaMux);
+  return failed;
+}
+
+static void otaPipelineFreeBuffers() {
+  for (uint8_t i = 0; i < OTA_PIPELINE_BUF_COUNT; i++) {
+    free(g_otaBufs[i]);
+    g_otaBufs[i] = NULL;
+  }
+  free(g_otaScratch);
+  g_otaScratch = NULL;
+}
+
+static bool otaWriterBeginUpdate(size_t size) {
+#if defined(U_SPIFFS)
+  int command = g_otaWriter.targetSpiffs ? U_SPIFFS : U_FLASH;
+#else
+  if (g_otaWriter.targetSpiffs) {
+    otaPipelineFail("SPIFFS update unsupported");
+    return false;
+  }
+  int command = U_FLASH;
+#endif
+  if (!Update.begin(size > 0 ? size : UPDATE_SIZE_UNKNOWN, command)) {
+    otaPipelineFail("Update begin failed");
+    return false;
+  }
+  g_otaWriter.updateBegun = true;
+  return true;
+}
+
+static bool otaWriterImage(const uint8_t* data, size_t len) {
+  if (Update.write((uint8_t*)data, len) != len) {
+    otaPipelineFail("Flash write failed");
+    return false;
+  }
+  mbedtls_sha256_update(&g_otaWriter.sha, data, len);
+  g_otaWriter.offset += len;
+  portENTER_CRITICAL(&g_otaMux);
+  g_otaStatus.written = (uint32_t)g_otaWriter.offset;
+  portEXIT_CRITICAL(&g_otaMux);
+  return true;
+}
+
+static uint32_t otaReadLe32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static bool otaDeltaParseHeader() {
+  const uint8_t* h = g_otaWriter.header;
+  uint8_t blockShift = h[5];
+  if (h[4] != OTA_DELTA_VERSION || blockShift < 8 || (1UL << blockShift) > OTA_PIPELINE_BUF_SIZE) {
+    otaPipelineFail("Bad delta header");
+    return false;
+  }
+  size_t targetSize = otaReadLe32(&h[8]);
+  if (g_otaWriter.haveExpectedSha && memcmp(g_otaWriter.expectedSha, &h[12], 32) != 0) {
+    otaPipelineFail("Delta hash mismatch");
+    return false;
+  }
+  memcpy(g_otaWriter.expectedSha, &h[12], 32);
+  g_otaWriter.haveExpectedSha = true;
+
+  g_otaWriter.source = esp_ota_get_running_partition();
+  g_otaScratch = (uint8_t*)malloc(OTA_PIPELINE_BUF_SIZE);
+  if (g_otaWriter.source == NULL || g_otaScratch == NULL || targetSize == 0) {
+    otaPipelineFail("Delta setup failed");
+    return false;
+  }
+  g_otaWriter.blockSize = (size_t)1U << blockShift;
+  g_otaWriter.imageSize = targetSize;
+  portENTER_CRITICAL(&g_otaMux);
+  g_otaStatus.imageSize = (uint32_t)targetSize;
+  portEXIT_CRITICAL(&g_otaMux);
+  return otaWriterBeginUpdate(targetSize);
+}
+
+static size_t otaDeltaBlockLen() {
+  size_t left = g_otaWriter.imageSize - g_otaWriter.offset;
+  return (left < g_otaWriter.blockSize) ? left : g_otaWriter.blockSize;
+}
+
+static bool otaDeltaFeed(const uint8_t* p, size_t n) {
+  while (n > 0) {
+    switch (g_otaWriter.deltaPhase) {
+      case OTA_DELTA_PHASE_HEADER: {
+        size_t take = OTA_DELTA_HEADER_SIZE - g_otaWriter.headerLen;
+        if (take > n) take = n;
+        memcpy(g_otaWriter.header + g_otaWriter.headerLen, p, take);
+        g_otaWriter.headerLen += take;
+        p += take;
+        n -= take;
+        if (g_otaWriter.headerLen == OTA_DELTA_HEADER_SIZE) {
+          if (!otaDeltaParseHeader()) return false;
+          g_otaWriter.deltaPhase = OTA_DELTA_PHASE_OP;
+        }
+        break;
+      }
+
+      case OTA_DELTA_PHASE_OP: {
+        uint8_t op = *p++;
+        n--;
+        size_t blockLen = otaDeltaBlockLen();
+        if (blockLen == 0) {
+          otaPipelineFail("Delta trailing data");
+          return false;
+        }
+        if (op == OTA_DELTA_OP_LITERAL) {
+          g_otaWriter.literalRemaining = blockLen;
+          g_otaWriter.deltaPhase = OTA_DELTA_PHASE_LITERAL;
+        } else if (op == OTA_DELTA_OP_COPY) {
+          if (g_otaWriter.offset + blockLen > g_otaWriter.source->size ||
+              esp_partition_read(g_otaWriter.source, g_otaWriter.offset, g_otaScratch, blockLen) != ESP_OK) {
+            otaPipelineFail("Delta source read failed");
+            return false;
+          }
+          if (!otaWriterImage(g_otaScratch, blockLen)) return false;
+          portENTER_CRITICAL(&g_otaMux);
+          g_otaStatus.copiedBlocks++;
+          portEXIT_CRITICAL(&g_otaMux);
+        } else if (op == OTA_DELTA_OP_FILL) {
+          g_otaWriter.deltaPhase = OTA_DELTA_PHASE_FILL;
+        } else {
+          otaPipelineFail("Bad delta record");
+          return false;
+        }
+        break;
+      }
+
+      case OTA_DELTA_PHASE_LITERAL: {
+        size_t take = (n < g_otaWriter.literalRemaining) ? n : g_otaWriter.literalRemaining;
+        if (!otaWriterImage(p, take)) return false;
+        p += take;
+        n -= take;
+        g_otaWriter.literalRemaining -= take;
+        if (g_otaWriter.literalRemaining == 0) {
+          g_otaWriter.deltaPhase = OTA_DELTA_PHASE_OP;
+        }
+        break;
+      }
+
+      case OTA_DELTA_PHASE_FILL: {
+        size_t blockLen = otaDeltaBlockLen();
+        memset(g_otaScratch, *p, blockLen);
+        p++;
+        n--;
+        if (!otaWriterImage(g_otaScratch, blockLen)) return false;
+        g_otaWriter.deltaPhase = OTA_DELTA_PHASE_OP;
+        break;
+      }
+
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+static bool otaWriterData(const uint8_t* data, size_t len) {
+  if (!g_otaWriter.formatKnown) {
+    /* The first buffer is a full ring buffer (or the whole upload), so the magic is in it.
+     * A plain app image starts with 0xE9, so it cannot be mistaken for the magic.
+     * SPIFFS images are always plain: a delta against the mounted FS would overwrite its source. */
+    g_otaWriter.delta = !g_otaWriter.targetSpiffs && len >= 4 && memcmp(data, OTA_DELTA_MAGIC, 4) == 0;
+    g_otaWriter.formatKnown = true;
+    portENTER_CRITICAL(&g_otaMux);
+    g_otaStatus.delta = g_otaWriter.delta;
+    portEXIT_CRITICAL(&g_otaMux);
+    if (!g_otaWriter.delta && !otaWriterBeginUpdate(g_otaWriter.imageSize)) {
+      return false;
+    }
+  }
+  return g_otaWriter.delta ? otaDeltaFeed(data, len) : otaWriterImage(data, len);
+}
+
+static void otaWriterEnd() {
+  if (otaPipelineFailed()) {
+    return;
+  }
+  if (!g_otaWriter.updateBegun) {
+    otaPipelineFail("Empty upload");
+    return;
+  }
+  if (g_otaWriter.delta &&
+      (g_otaWriter.deltaPhase != OTA_DELTA_PHASE_OP || g_otaWriter.offset != g_otaWriter.imageSize)) {
+    otaPipelineFail("Delta truncated");
+    return;
+  }
+  uint8_t digest[32];
+  mbedtls_sha256_finish(&g_otaWriter.sha, digest);
+  if (g_otaWriter.haveExpectedSha && memcmp(digest, g_otaWriter.expectedSha, sizeof(digest)) != 0) {
+    otaPipelineFail("SHA-256 mismatch");
+    return;
+  }
+  if (!Update.end(true)) {
+    otaPipelineFail("Update end failed");
+    return;
+  }
+  g_otaWriter.updateBegun = false;
+  portENTER_CRITICAL(&g_otaMux);
+  g_otaStatus.state = OTA_PIPELINE_DONE;
+  portEXIT_CRITICAL(&g_otaMux);
+}
+
+static void otaWriterTaskcode(void* pvParameters) {
+  (void)pvParameters;
+  OtaPipelineMsg_type msg;
+  for (;;) {
+    if (xQueueReceive(g_otaFullQueue, &msg, portMAX_DELAY) != pdTRUE) {
+      continue;
+    }
+    if (msg.cmd == OTA_PIPELINE_CMD_DATA) {
+      /* After a failure keep draining so the upload handler never waits on a full ring */
+      if (!g_otaAbortRequested && !otaPipelineFailed()) {
+        otaWriterData(g_otaBufs[msg.index], msg.len);
+      }
+      xQueueSend(g_otaFreeQueue, &msg.index, 0);
+      continue;
+    }
+
+    if (msg.cmd == OTA_PIPELINE_CMD_END && !g_otaAbortRequested) {
+      otaWriterEnd();
+    } else {
+      otaPipelineFail("Upload aborted");
+    }
+    if (g_otaWriter.updateBegun) {
+      Update.abort();
+      g_otaWriter.updateBegun = false;
+    }
+    mbedtls_sha256_free(&g_otaWriter.sha);
+    otaPipelineFreeBuffers();
+    g_otaWriterBusy = false;
+    xSemaphoreGive(g_otaDoneSem);
+  }
+}
+
+static bool otaPipelineCreateTask() {
+  if (g_otaWriterTask != NULL) {
+    return true;
+  }
+  g_otaFullQueue = xQueueCreate(OTA_PIPELINE_BUF_COUNT + 1, sizeof(OtaPipelineMsg_type));
+  g_otaFreeQueue = xQueueCreate(OTA_PIPELINE_BUF_COUNT, sizeof(uint8_t));
+  g_otaDoneSem = xSemaphoreCreateBinary();
+  if (g_otaFullQueue == NULL || g_otaFreeQueue == NULL || g_otaDoneSem == NULL) {
+    return false;
+  }
+  BaseType_t ok = xTaskCreatePinnedToCore(
+    otaWriterTaskcode,
+    "OtaWriter",
+    OTA_PIPELINE_STACK_SIZE,
+    NULL,
+    OTA_PIPELINE_TASK_PRIORITY,
+    &g_otaWriterTask,
+    OTA_PIPELINE_TASK_CORE);
+  if (ok != pdPASS) {
+    g_otaWriterTask = NULL;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Start an upload session
+ * @param imageSize Expected image size (plain uploads), 0 if unknown
+ * @param expectedSha256 SHA-256 of the resulting image to verify at the end, or nullptr
+ * @return false if a previous session is still draining or no memory is available
+ */
+bool otaPipelineBegin(bool targetSpiffs, size_t imageSize, const uint8_t* expectedSha256) {
+  if (g_otaWriterBusy || !otaPipelineCreateTask()) {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < OTA_PIPELINE_BUF_COUNT; i++) {
+    g_otaBufs[i] = (uint8_t*)malloc(OTA_PIPELINE_BUF_SIZE);
+    if (g_otaBufs[i] == NULL) {
+      otaPipelineFreeBuffers();
+      return false;
+    }
+  }
+
+  memset(&g_otaWriter, 0, sizeof(g_otaWriter));
+  g_otaWriter.targetSpiffs = targetSpiffs;
+  g_otaWriter.imageSize = imageSize;
+  if (expectedSha256 != nullptr) {
+    memcpy(g_otaWriter.expectedSha, expectedSha256, sizeof(g_otaWriter.expectedSha));
+    g_otaWriter.haveExpectedSha = true;
+  }
+  mbedtls_sha256_init(&g_otaWriter.sha);
+  mbedtls_sha256_starts(&g_otaWriter.sha, 0);
+
+  portENTER_CRITICAL(&g_otaMux);
+  memset(&g_otaStatus, 0, sizeof(g_otaStatus));
+  g_otaStatus.state = OTA_PIPELINE_RUNNING;
+  g_otaStatus.targetSpiffs = targetSpiffs;
+  g_otaStatus.imageSize = (uint32_t)imageSize;
+  portEXIT_CRITICAL(&g_otaMux);
+
+  xQueueReset(g_otaFullQueue);
+  xQueueReset(g_otaFreeQueue);
+  xSemaphoreTake(g_otaDoneSem, 0);
+  for (uint8_t i = 0; i < OTA_PIPELINE_BUF_COUNT; i++) {
+    xQueueSend(g_otaFreeQueue, &i, 0);
+  }
+  g_otaHaveFill = false;
+  g_otaFillLen = 0;
+  g_otaAbortRequested = false;
+  g_otaWriterBusy = true;
+  return true;
+}
+
+static void otaPipelinePost(uint8_t cmd, uint8_t index, size_t len) {
+  OtaPipelineMsg_type msg = {cmd, index, (uint16_t)len};
+  /* The full queue has room for every buffer plus one command, so this never waits */
+  xQueueSend(g_otaFullQueue, &msg, portMAX_DELAY);
+}
+
+/**
+ * @brief Queue upload bytes for the writer; waits only while every buffer is in flight
+ * @return false once the session has failed
+ */
+bool otaPipelineWrite(const uint8_t* data, size_t len) {
+  if (!g_otaWriterBusy || otaPipelineFailed()) {
+    return false;
+  }
+  while (len > 0) {
+    if (!g_otaHaveFill) {
+      if (xQueueReceive(g_otaFreeQueue, &g_otaFillIndex, pdMS_TO_TICKS(OTA_PIPELINE_WAIT_MS)) != pdTRUE) {
+        otaPipelineFail("Flash writer stalled");
+        return false;
+      }
+      g_otaHaveFill = true;
+      g_otaFillLen = 0;
+    }
+    size_t take = OTA_PIPELINE_BUF_SIZE - g_otaFillLen;
+    if (take > len) take = len;
+    memcpy(g_otaBufs[g_otaFillIndex] + g_otaFillLen, data, take);
+    g_otaFillLen += take;
+    data += take;
+    len -= take;
+    if (g_otaFillLen == OTA_PIPELINE_BUF_SIZE) {
+      otaPipelinePost(OTA_PIPELINE_CMD_DATA, g_otaFillIndex, g_otaFillLen);
+      g_otaHaveFill = false;
+    }
+    portENTER_CRITICAL(&g_otaMux);
+    g_otaStatus.received += (uint32_t)take;
+    portEXIT_CRITICAL(&g_otaMux);
+  }
+  return !otaPipelineFailed();
+}
+
+/**
+ * @brief Flush the last buffer, let the writer verify and finalize the image
+ * @return true if the image was written, verified and accepted by Update
+ */
+bool otaPipelineFinish(uint32_t timeoutMs) {
+  if (!g_otaWriterBusy) {
+    return false;
+  }
+  if (g_otaHaveFill && g_otaFillLen > 0) {
+    otaPipelinePost(OTA_PIPELINE_CMD_DATA, g_otaFillIndex, g_otaFillLen);
+  }
+  g_otaHaveFill = false;
+  otaPipelinePost(OTA_PIPELINE_CMD_END, 0, 0);
+  if (xSemaphoreTake(g_otaDoneSem, pdMS_TO_TICKS(timeoutMs)) != pdTRUE) {
+    /* The writer still owns the session; it cleans up when it gets to the END */
+    otaPipelineFail("Flash writer timeout");
+    return false;
+  }
+  OtaPipelineStatus_type status;
+  otaPipelineGetStatus(&status);
+  return status.state == OTA_PIPELINE_DONE;
+}
+
+/**
+ * @brief Drop the session (client disconnected); the writer aborts Update and frees the ring
+ */
+void otaPipelineAbort() {
+  if (!g_otaWriterBusy) {
+    return;
+  }
+  g_otaAbortRequested = true;
+  g_otaHaveFill = false;
+  otaPipelineFail("Upload aborted");
+  otaPipelinePost(OTA_PIPELINE_CMD_ABORT, 0, 0);
+}
+
+void otaPipelineGetStatus(OtaPipelineStatus_type* out) {
+  if (out == nullptr) return;
+  portENTER_CRITICAL(&g_otaMux);
+  *out = g_otaStatus;
+  portEXIT_CRITICAL(&g_otaMux);
+}
@@ -0,0 +1,59 @@
+#ifndef OTA_PIPELINE_H_
+#define OTA_PIPELINE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Double-buffered OTA writer.
+ * The upload handler copies HTTPUpload chunks into a small ring of RAM buffers and returns;
+ * a writer task on core 1 (below the control loop) drains them into Update and hashes the
+ * image on the fly. Network receive on core 0 and flash erase/write on core 1 then overlap
+ * instead of alternating in the WiFi task. All Update calls are made by the writer task.
+ *
+ * Firmware uploads may also be sent as a block delta against the running app:
+ *   header  "E32D", u8 version (1), u8 blockShift (12), u16 flags (0), u32 targetSize,
+ *           u8 sha256[32] of the target image            (44 bytes, little-endian)
+ *   then one record per block of (1 << blockShift) bytes, the last one possibly short:
+ *     0x00 LITERAL + the block bytes
+ *     0x01 COPY    - block unchanged, read from the running partition at the same offset
+ *     0x02 FILL    + u8 value, the whole block is that byte (0xFF padding)
+ * scripts/ota_delta.py builds and uploads such a file. */
+#define OTA_PIPELINE_BUF_SIZE        4096U
+#define OTA_PIPELINE_BUF_COUNT       4
+#define OTA_PIPELINE_TASK_PRIORITY   1       /* Below Task2: runs in the control loop's idle time */
+#define OTA_PIPELINE_TASK_CORE       1
+#define OTA_PIPELINE_STACK_SIZE      4096
+#define OTA_PIPELINE_WAIT_MS         5000UL  /* Longest wait for a free buffer before failing */
+
+#define OTA_DELTA_MAGIC              "E32D"
+#define OTA_DELTA_VERSION            1
+#define OTA_DELTA_HEADER_SIZE        44U
+#define OTA_DELTA_OP_LITERAL         0x00
+#define OTA_DELTA_OP_COPY            0x01
+#define OTA_DELTA_OP_FILL            0x02
+
+typedef enum {
+  OTA_PIPELINE_IDLE = 0,
+  OTA_PIPELINE_RUNNING,
+  OTA_PIPELINE_DONE,
+  OTA_PIPELINE_FAILED
+} OtaPipelineState_enum;
+
+typedef struct {
+  uint8_t state;            /* OtaPipelineState_enum */
+  bool targetSpiffs;
+  bool delta;
+  uint32_t received;        /* Upload bytes accepted from the network */
+  uint32_t written;         /* Image bytes handed to Update */
+  uint32_t imageSize;       /* Expected image size, 0 if unknown */
+  uint32_t copiedBlocks;    /* Delta blocks taken from the running app instead of the upload */
+  char error[32];
+} OtaPipelineStatus_type;
+
+bool otaPipelineBegin(bool targetSpiffs, size_t imageSize, const uint8_t* expectedSha256);
+bool otaPipelineWrite(const uint8_t* data, size_t len);
+bool otaPipelineFinish(uint32_t timeoutMs);
+void otaPipelineAbort();
+void otaPipelineGetStatus(OtaPipelineStatus_type* out);
+
+#endif  /* OTA_PIPELINE_H_ */
@@ -0,0 +1,158 @@
+#include "perf_probe.h"
+#include <Arduino.h>
+#include <string.h>
+
+/* Log-linear histogram: 16 exact buckets, then 8 sub-buckets per power of two up to 2^21 cycles (~8.7 ms @ 240 MHz) */
+#define PERF_HIST_LINEAR_BUCKETS  16U
+#define PERF_HIST_SUB_BITS        3U
+#define PERF_HIST_SUB_BUCKETS     (1U << PERF_HIST_SUB_BITS)
+#define PERF_HIST_MIN_MSB         4U
+#define PERF_HIST_MAX_MSB         21U
+#define PERF_HIST_BUCKETS         (PERF_HIST_LINEAR_BUCKETS + (PERF_HIST_MAX_MSB - PERF_HIST_MIN_MSB + 1U) * PERF_HIST_SUB_BUCKETS)
+
+typedef struct {
+  uint32_t count;
+  uint32_t minCycles;
+  uint32_t maxCycles;
+  uint64_t sumCycles;
+  uint32_t hist[PERF_HIST_BUCKETS];
+} PerfStageAccum_type;
+
+static const char* const PERF_STAGE_NAMES[PERF_STAGE_COUNT] = {
+  "trigger",
+  "sensorBus",
+  "normalize",
+  "extPot",
+  "analog",
+  "lap",
+  "curve",
+  "antiSpin",
+  "pwm",
+  "telemetry",
+  "total"
+};
+
+static portMUX_TYPE g_perfMux = portMUX_INITIALIZER_UNLOCKED;
+static PerfStageAccum_type g_perfStages[PERF_STAGE_COUNT];
+static bool g_perfInitialized = false;
+
+static void perfResetLocked() {
+  memset(g_perfStages, 0, sizeof(g_perfStages));
+  for (uint8_t i = 0; i < PERF_STAGE_COUNT; i++) {
+    g_perfStages[i].minCycles = UINT32_MAX;
+  }
+  g_perfInitialized = true;
+}
+
+static inline uint16_t perfBucketForCycles(uint32_t cycles) {
+  if (cycles < PERF_HIST_LINEAR_BUCKETS) {
+    return (uint16_t)cycles;
+  }
+  uint32_t msb = 31U - (uint32_t)__builtin_clz(cycles);
+  if (msb > PERF_HIST_MAX_MSB) {
+    return (uint16_t)(PERF_HIST_BUCKETS - 1U);
+  }
+  uint32_t sub = (cycles >> (msb - PERF_HIST_SUB_BITS)) & (PERF_HIST_SUB_BUCKETS - 1U);
+  return (uint16_t)(PERF_HIST_LINEAR_BUCKETS + (msb - PERF_HIST_MIN_MSB) * PERF_HIST_SUB_BUCKETS + sub);
+}
+
+static uint32_t perfBucketUpperCycles(uint16_t bucket) {
+  if (bucket < PERF_HIST_LINEAR_BUCKETS) {
+    return bucket;
+  }
+  uint32_t rel = bucket - PERF_HIST_LINEAR_BUCKETS;
+  uint32_t msb = PERF_HIST_MIN_MSB + rel / PERF_HIST_SUB_BUCKETS;
+  uint32_t sub = rel % PERF_HIST_SUB_BUCKETS;
+  return ((PERF_HIST_SUB_BUCKETS + sub + 1U) << (msb - PERF_HIST_SUB_BITS)) - 1U;
+}
+
+static uint32_t perfCyclesToNs(uint64_t cycles) {
+  uint32_t cpuMhz = getCpuFrequencyMhz();
+  if (cpuMhz == 0) {
+    return 0;
+  }
+  uint64_t ns = (cycles * 1000ULL) / cpuMhz;
+  return (ns > UINT32_MAX) ? UINT32_MAX : (uint32_t)ns;
+}
+
+#if PERF_PROBE_ENABLED
+void perfProbeEnd(uint8_t stage, uint32_t startCycles) {
+  if (stage >= PERF_STAGE_COUNT) {
+    return;
+  }
+  uint32_t cycles = ESP.getCycleCount() - startCycles;  /* Wrap-safe unsigned delta */
+  uint16_t bucket = perfBucketForCycles(cycles);
+
+  portENTER_CRITICAL(&g_perfMux);
+  if (!g_perfInitialized) {
+    perfResetLocked();
+  }
+  PerfStageAccum_type* acc = &g_perfStages[stage];
+  acc->count++;
+  acc->sumCycles += cycles;
+  if (cycles < acc->minCycles) acc->minCycles = cycles;
+  if (cycles > acc->maxCycles) acc->maxCycles = cycles;
+  acc->hist[bucket]++;
+  portEXIT_CRITICAL(&g_perfMux);
+}
+#endif
+
+bool perfProbeIsEnabled() {
+  return PERF_PROBE_ENABLED != 0;
+}
+
+const char* perfProbeStageName(uint8_t stage) {
+  return (stage < PERF_STAGE_COUNT) ? PERF_STAGE_NAMES[stage] : "";
+}
+
+/**
+ * @brief Summarize one stage
+ * @details The histogram is copied under the lock and scanned afterwards so
+ *          the control task is never held off for the percentile walk.
+ */
+void perfProbeGetStageStats(uint8_t stage, PerfStageStats_type* outStats) {
+  if (outStats == nullptr) {
+    return;
+  }
+  memset(outStats, 0, sizeof(*outStats));
+  if (stage >= PERF_STAGE_COUNT) {
+    return;
+  }
+
+  PerfStageAccum_type snapshot;
+  portENTER_CRITICAL(&g_perfMux);
+  if (!g_perfInitialized) {
+    perfResetLocked();
+  }
+  snapshot = g_perfStages[stage];
+  portEXIT_CRITICAL(&g_perfMux);
+
+  if (snapshot.count == 0) {
+    return;
+  }
+
+  uint32_t rank = (uint32_t)(((uint64_t)snapshot.count * 99U + 99U) / 100U);
+  uint32_t cumulative = 0;
+  uint16_t p99Bucket = PERF_HIST_BUCKETS - 1U;
+  for (uint16_t b = 0; b < PERF_HIST_BUCKETS; b++) {
+    cumulative += snapshot.hist[b];
+    if (cumulative >= rank) {
+      p99Bucket = b;
+      break;
+    }
+  }
+  uint32_t p99Cycles = perfBucketUpperCycles(p99Bucket);
+  if (p99Cycles > snapshot.maxCycles) p99Cycles = snapshot.maxCycles;
+
+  outStats->count = snapshot.count;
+  outStats->min_ns = perfCyclesToNs(snapshot.minCycles);
+  outStats->avg_ns = perfCyclesToNs(snapshot.sumCycles / snapshot.count);
+  outStats->max_ns = perfCyclesToNs(snapshot.maxCycles);
+  outStats->p99_ns = perfCyclesToNs(p99Cycles);
+}
+
+void perfProbeReset() {
+  portENTER_CRITICAL(&g_perfMux);
+  perfResetLocked();
+  portEXIT_CRITICAL(&g_perfMux);
+}
@@ -0,0 +1,57 @@
+#ifndef PERF_PROBE_H_
+#define PERF_PROBE_H_
+
+#include <stdint.h>
+#include <Arduino.h>
+
+/* Build flag: set PERF_PROBE_ENABLED=0 to compile the control-loop probes out entirely */
+#ifndef PERF_PROBE_ENABLED
+#define PERF_PROBE_ENABLED 1
+#endif
+
+/**
+ * @brief Instrumented stages of one control tick
+ * @note Order defines the /api/perf and PERF output order.
+ */
+typedef enum {
+  PERF_STAGE_TRIGGER_READ,   /* Trigger sampler slot load + 2-tap average */
+  PERF_STAGE_SENSOR_BUS,     /* HAL_ReadTriggerRaw() in the sampler task (wall time incl. bus wait) */
+  PERF_STAGE_NORMALIZE,      /* triggerLutLookup() */
+  PERF_STAGE_EXT_POT,        /* activeTuningAcquire(): snapshot + ext pots */
+  PERF_STAGE_ANALOG,         /* Vin divider + motor current ADC reads */
+  PERF_STAGE_LAP,            /* Vin filter + lap detection state machine */
+  PERF_STAGE_CURVE,          /* throttleCurve2() (table lookup) */
+  PERF_STAGE_ANTISPIN,       /* throttleAntiSpin3() */
+  PERF_STAGE_PWM,            /* HalfBridge_SetPwmDrag() */
+  PERF_STAGE_TELEMETRY,      /* telemetryCaptureSample() */
+  PERF_STAGE_TOTAL,          /* Whole control tick */
+  PERF_STAGE_COUNT
+} PerfStage_enum;
+
+/**
+ * @brief Per-stage timing summary (nanoseconds, converted from CPU cycles)
+ */
+typedef struct {
+  uint32_t count;   /* Samples recorded since reset */
+  uint32_t min_ns;
+  uint32_t avg_ns;
+  uint32_t max_ns;
+  uint32_t p99_ns;  /* Upper edge of the histogram bucket holding the 99th percentile */
+} PerfStageStats_type;
+
+#if PERF_PROBE_ENABLED
+static inline uint32_t perfProbeStart() {
+  return ESP.getCycleCount();
+}
+void perfProbeEnd(uint8_t stage, uint32_t startCycles);
+#else
+static inline uint32_t perfProbeStart() { return 0; }
+static inline void perfProbeEnd(uint8_t stage, uint32_t startCycles) { (void)stage; (void)startCycles; }
+#endif
+
+bool perfProbeIsEnabled();
+const char* perfProbeStageName(uint8_t stage);
+void perfProbeGetStageStats(uint8_t stage, PerfStageStats_type* outStats);
+void perfProbeReset();
+
+#endif  /* PERF_PROBE_H_ */
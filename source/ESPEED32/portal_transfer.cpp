@@ -0,0 +1,211 @@
+#include "portal_transfer.h"
+#include <Arduino.h>
+#include <string.h>
+#include <lwip/sockets.h>
+
+typedef struct {
+  bool active;
+  bool chunked;
+  WiFiClient client;
+  File file;
+  PortalTransferFill_fn fill;
+  PortalTransferRelease_fn release;
+  void* ctx;
+  uint32_t lastProgressMs;
+} PortalTransfer_type;
+
+static PortalTransfer_type g_portalTransfers[PORTAL_TRANSFER_MAX_JOBS];
+static uint8_t g_portalTransferBuf[PORTAL_TRANSFER_CHUNK_SIZE + 12U];  /* Chunk-size line + CRLF around the data */
+
+static PortalTransfer_type* portalTransferFreeSlot() {
+  for (uint8_t i = 0; i < PORTAL_TRANSFER_MAX_JOBS; i++) {
+    if (!g_portalTransfers[i].active) {
+      return &g_portalTransfers[i];
+    }
+  }
+  return nullptr;
+}
+
+static void portalTransferFinish(PortalTransfer_type* job) {
+  if (job->file) {
+    job->file.close();
+  }
+  if (job->release != nullptr) {
+    job->release(job->ctx);
+  }
+  job->client.stop();
+  job->client = WiFiClient();
+  job->file = File();
+  job->fill = nullptr;
+  job->release = nullptr;
+  job->ctx = nullptr;
+  job->active = false;
+}
+
+static bool portalTransferWriteHeaders(WiFiClient& client, const char* contentType, const char* extraHeaders, int32_t contentLength) {
+  char head[256];
+  int len;
+  if (contentLength >= 0) {
+    len = snprintf(head, sizeof(head),
+                   "HTTP/1.1 200 OK\r\nContent-Type: %s\r\nContent-Length: %ld\r\n%sConnection: close\r\n\r\n",
+                   contentType, (long)contentLength, (extraHeaders != nullptr) ? extraHeaders : "");
+  } else {
+    len = snprintf(head, sizeof(head),
+                   "HTTP/1.1 200 OK\r\nContent-Type: %s\r\nTransfer-Encoding: chunked\r\n%sConnection: close\r\n\r\n",
+                   contentType, (extraHeaders != nullptr) ? extraHeaders : "");
+  }
+  if (len <= 0 || len >= (int)sizeof(head)) {
+    return false;
+  }
+  return client.write((const uint8_t*)head, (size_t)len) == (size_t)len;
+}
+
+/* True if the socket send buffer has room, without waiting */
+static bool portalTransferCanWrite(WiFiClient& client) {
+  int fd = client.fd();
+  if (fd < 0) {
+    return false;
+  }
+  fd_set writeSet;
+  FD_ZERO(&writeSet);
+  FD_SET(fd, &writeSet);
+  struct timeval tv = {0, 0};
+  return select(fd + 1, nullptr, &writeSet, nullptr, &tv) > 0;
+}
+
+/**
+ * @brief Stream a SPIFFS file with Content-Length
+ * @param extraHeaders Complete header lines ("Name: value\r\n..."), or nullptr
+ * @return false if no slot is free (the caller serves the file synchronously instead)
+ */
+bool portalTransferStartFile(WiFiClient client, File file, const char* contentType, const char* extraHeaders) {
+  PortalTransfer_type* job = portalTransferFreeSlot();
+  if (job == nullptr || !file) {
+    return false;
+  }
+  if (!portalTransferWriteHeaders(client, contentType, extraHeaders, (int32_t)file.size())) {
+    file.close();
+    client.stop();
+    return true;  /* Client is gone; nothing left to serve */
+  }
+  job->client = client;
+  job->file = file;
+  job->chunked = false;
+  job->fill = nullptr;
+  job->release = nullptr;
+  job->ctx = nullptr;
+  job->lastProgressMs = millis();
+  job->active = true;
+  return true;
+}
+
+/**
+ * @brief Stream a generated body with chunked transfer encoding
+ * @details Ownership of ctx passes to the transfer: release(ctx) is called when it ends,
+ *          including when this returns false.
+ */
+bool portalTransferStartChunked(WiFiClient client,
+                                const char* contentType,
+                                const char* extraHeaders,
+                                PortalTransferFill_fn fill,
+                                void* ctx,
+                                PortalTransferRelease_fn release) {
+  PortalTransfer_type* job = portalTransferFreeSlot();
+  if (job == nullptr || fill == nullptr) {
+    if (release != nullptr) {
+      release(ctx);
+    }
+    return false;
+  }
+  job->client = client;
+  job->file = File();
+  job->chunked = true;
+  job->fill = fill;
+  job->release = release;
+  job->ctx = ctx;
+  job->lastProgressMs = millis();
+  job->active = true;
+  if (!portalTransferWriteHeaders(job->client, contentType, extraHeaders, -1)) {
+    portalTransferFinish(job);
+  }
+  return true;
+}
+
+bool portalTransferHasFreeSlot() {
+  return portalTransferFreeSlot() != nullptr;
+}
+
+static void portalTransferServiceJob(PortalTransfer_type* job, uint32_t nowMs) {
+  if (!job->client.connected()) {
+    portalTransferFinish(job);
+    return;
+  }
+  if (!portalTransferCanWrite(job->client)) {
+    if ((uint32_t)(nowMs - job->lastProgressMs) > PORTAL_TRANSFER_STALL_MS) {
+      portalTransferFinish(job);
+    }
+    return;
+  }
+
+  size_t len = 0;
+  uint8_t* out = g_portalTransferBuf;
+  if (!job->chunked) {
+    len = job->file.read(g_portalTransferBuf, PORTAL_TRANSFER_CHUNK_SIZE);
+    if (len == 0) {
+      portalTransferFinish(job);
+      return;
+    }
+  } else {
+    /* Leave room for the "XXX\r\n" prefix and trailing CRLF around the chunk data */
+    size_t dataLen = job->fill(job->ctx, g_portalTransferBuf + 8, PORTAL_TRANSFER_CHUNK_SIZE);
+    if (dataLen == 0) {
+      static const char terminator[] = "0\r\n\r\n";
+      job->client.write((const uint8_t*)terminator, sizeof(terminator) - 1U);
+      portalTransferFinish(job);
+      return;
+    }
+    char prefix[8];
+    int prefixLen = snprintf(prefix, sizeof(prefix), "%X\r\n", (unsigned int)dataLen);
+    out = g_portalTransferBuf + 8 - prefixLen;
+    memcpy(out, prefix, (size_t)prefixLen);
+    g_portalTransferBuf[8 + dataLen] = '\r';
+    g_portalTransferBuf[8 + dataLen + 1] = '\n';
+    len = (size_t)prefixLen + dataLen + 2U;
+  }
+
+  if (job->client.write(out, len) != len) {
+    portalTransferFinish(job);
+    return;
+  }
+  job->lastProgressMs = nowMs;
+}
+
+/**
+ * @brief Advance every active transfer by at most one chunk (called from WiFiTask)
+ */
+void portalTransferService() {
+  uint32_t nowMs = millis();
+  for (uint8_t i = 0; i < PORTAL_TRANSFER_MAX_JOBS; i++) {
+    if (g_portalTransfers[i].active) {
+      portalTransferServiceJob(&g_portalTransfers[i], nowMs);
+    }
+  }
+}
+
+void portalTransferStopAll() {
+  for (uint8_t i = 0; i < PORTAL_TRANSFER_MAX_JOBS; i++) {
+    if (g_portalTransfers[i].active) {
+      portalTransferFinish(&g_portalTransfers[i]);
+    }
+  }
+}
+
+uint8_t portalTransferActiveCount() {
+  uint8_t count = 0;
+  for (uint8_t i = 0; i < PORTAL_TRANSFER_MAX_JOBS; i++) {
+    if (g_portalTransfers[i].active) {
+      count++;
+    }
+  }
+  return count;
+}
@@ -0,0 +1,39 @@
+#ifndef PORTAL_TRANSFER_H_
+#define PORTAL_TRANSFER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <WiFi.h>
+#include <FS.h>
+
+/* Background HTTP response bodies for the portal.
+ * A route handler writes nothing through WebServer; instead it hands the connection to a
+ * transfer slot, which sends the status line + headers and then the body one chunk per
+ * portalTransferService() call, only while the socket can take data. The handler returns
+ * at once, so WebServer goes on to the next request while docs pages and exports stream.
+ * The WebServer drops its copy of the client without closing it (NetworkClient shares
+ * the socket), which is what keeps the detached connection alive. */
+#define PORTAL_TRANSFER_MAX_JOBS     4
+#define PORTAL_TRANSFER_CHUNK_SIZE   1024U   /* Bytes handed to the socket per service call */
+#define PORTAL_TRANSFER_STALL_MS     10000UL /* Drop a client that has not taken data for this long */
+
+/**
+ * @brief Body producer for chunked responses
+ * @return Bytes written to buf (<= cap), 0 when the body is complete
+ */
+typedef size_t (*PortalTransferFill_fn)(void* ctx, uint8_t* buf, size_t cap);
+typedef void (*PortalTransferRelease_fn)(void* ctx);
+
+bool portalTransferStartFile(WiFiClient client, File file, const char* contentType, const char* extraHeaders);
+bool portalTransferStartChunked(WiFiClient client,
+                                const char* contentType,
+                                const char* extraHeaders,
+                                PortalTransferFill_fn fill,
+                                void* ctx,
+                                PortalTransferRelease_fn release);
+bool portalTransferHasFreeSlot();
+void portalTransferService();
+void portalTransferStopAll();
+uint8_t portalTransferActiveCount();
+
+#endif  /* PORTAL_TRANSFER_H_ */
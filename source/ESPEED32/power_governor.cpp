@@ -0,0 +1,198 @@
+#include "power_governor.h"
+#include <Arduino.h>
+#include <WiFi.h>
+#include "HAL.h"
+#include "slot_ESC.h"
+#include "connectivity_portal.h"
+#include "telemetry_logging.h"
+#include "motor_sweep.h"
+#if CONFIG_PM_ENABLE
+#include <esp_pm.h>
+#endif
+
+extern ESC_type g_escVar;
+extern uint32_t g_lastEncoderInteraction;
+
+/* Control task only, except where noted */
+static PowerGovState_enum g_govState = POWER_GOV_FULL;
+static uint32_t g_govLastActiveMs = 0;
+static uint32_t g_govLastEncoderStamp = 0;
+static uint32_t g_govIdleSinceMs = 0;
+static bool g_govPmActive = false;          /* Written once by powerGovernorInit(), read by Task1 */
+static bool g_govLightSleepConfigured = false;
+static bool g_govLightSleepBlocked = true;  /* NO_LIGHT_SLEEP lock held */
+#if CONFIG_PM_ENABLE
+static esp_pm_lock_handle_t g_govCpuLock = NULL;
+static esp_pm_lock_handle_t g_govSleepLock = NULL;
+#endif
+
+static portMUX_TYPE g_govStatsMux = portMUX_INITIALIZER_UNLOCKED;
+static PowerGovStats_type g_govStats = {POWER_GOV_FULL, false, false, 0, 0, 0, 0};
+
+/**
+ * @brief Set up DFS and take the full-clock lock (control task, before the loop starts)
+ * @details Without CONFIG_PM_ENABLE, or if esp_pm refuses the configuration, the governor
+ *          falls back to setCpuFrequencyMhz() and never light-sleeps.
+ */
+void powerGovernorInit() {
+#if POWER_GOV_ENABLED && CONFIG_PM_ENABLE
+  if (esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "ctl_clk", &g_govCpuLock) != ESP_OK ||
+      esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "ctl_sleep", &g_govSleepLock) != ESP_OK) {
+    return;
+  }
+  /* Hold both before DFS is live so the clock never dips while the loop is running */
+  esp_pm_lock_acquire(g_govCpuLock);
+  esp_pm_lock_acquire(g_govSleepLock);
+
+  esp_pm_config_t pmConfig = {};
+  pmConfig.max_freq_mhz = POWER_GOV_MAX_CPU_MHZ;
+  pmConfig.min_freq_mhz = POWER_GOV_MIN_CPU_MHZ;
+#if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+  pmConfig.light_sleep_enable = true;
+#else
+  pmConfig.light_sleep_enable = false;
+#endif
+  if (esp_pm_configure(&pmConfig) != ESP_OK) {
+    esp_pm_lock_release(g_govSleepLock);
+    esp_pm_lock_release(g_govCpuLock);
+    esp_pm_lock_delete(g_govSleepLock);
+    esp_pm_lock_delete(g_govCpuLock);
+    g_govSleepLock = NULL;
+    g_govCpuLock = NULL;
+    return;
+  }
+  g_govPmActive = true;
+  g_govLightSleepConfigured = pmConfig.light_sleep_enable;
+#endif
+  g_govLastActiveMs = millis();
+  g_govLastEncoderStamp = g_lastEncoderInteraction;
+
+  portENTER_CRITICAL(&g_govStatsMux);
+  g_govStats.pmActive = g_govPmActive;
+  portEXIT_CRITICAL(&g_govStatsMux);
+}
+
+static void powerGovernorSetFullClock(bool full) {
+#if CONFIG_PM_ENABLE
+  if (g_govPmActive) {
+    /* Acquire switches the clock before it returns */
+    if (full) {
+      esp_pm_lock_acquire(g_govCpuLock);
+    } else {
+      esp_pm_lock_release(g_govCpuLock);
+    }
+    return;
+  }
+#endif
+  setCpuFrequencyMhz(full ? POWER_GOV_MAX_CPU_MHZ : POWER_GOV_MIN_CPU_MHZ);
+}
+
+/* Light sleep stops LEDC: only allow it while the outputs are constant levels anyway */
+static void powerGovernorBlockLightSleep(bool block) {
+  if (!g_govLightSleepConfigured || block == g_govLightSleepBlocked) {
+    return;
+  }
+#if CONFIG_PM_ENABLE
+  if (block) {
+    esp_pm_lock_acquire(g_govSleepLock);
+  } else {
+    esp_pm_lock_release(g_govSleepLock);
+  }
+#endif
+  g_govLightSleepBlocked = block;
+}
+
+/* Anything that needs the full control rate or keeps the chip busy anyway */
+static bool powerGovernorInputActive(bool triggerFresh) {
+  if (!triggerFresh || g_escVar.trigger_norm > 0) {
+    return true;
+  }
+  if (digitalRead(BUTT_PIN) == BUTTON_PRESSED || digitalRead(ENCODER_BUTTON_PIN) == BUTTON_PRESSED) {
+    return true;
+  }
+  uint32_t encoderStamp = g_lastEncoderInteraction;
+  if (encoderStamp != g_govLastEncoderStamp) {
+    g_govLastEncoderStamp = encoderStamp;
+    return true;
+  }
+  return WiFi.getMode() != WIFI_OFF || isOtaInProgress() || telemetryIsLoggingActive() || motorSweepActive();
+}
+
+/**
+ * @brief Run the governor for one control tick
+ * @details Call right after the trigger has been normalized and before any output is computed:
+ *          on input the full clock is back before this returns.
+ * @param triggerFresh The trigger sample of this tick is fresh
+ * @return true while the clock is down (idle)
+ */
+bool powerGovernorTick(bool triggerFresh) {
+#if POWER_GOV_ENABLED
+  uint32_t nowMs = millis();
+  bool active = powerGovernorInputActive(triggerFresh);
+  if (active) {
+    g_govLastActiveMs = nowMs;
+  }
+
+  if (g_govState == POWER_GOV_IDLE) {
+    if (active) {
+      uint32_t wakeStart_us = micros();
+      powerGovernorBlockLightSleep(true);
+      powerGovernorSetFullClock(true);
+      uint32_t latency_us = micros() - wakeStart_us;
+      g_govState = POWER_GOV_FULL;
+
+      portENTER_CRITICAL(&g_govStatsMux);
+      g_govStats.state = POWER_GOV_FULL;
+      g_govStats.lightSleepAllowed = false;
+      g_govStats.idleTime_ms += nowMs - g_govIdleSinceMs;
+      g_govStats.lastWakeLatency_us = latency_us;
+      if (latency_us > g_govStats.maxWakeLatency_us) g_govStats.maxWakeLatency_us = latency_us;
+      portEXIT_CRITICAL(&g_govStatsMux);
+      return false;
+    }
+    /* Output state of the previous tick; the brake may still be fading in */
+    bool outputsStatic = g_escVar.outputSpeed_permille == 0 &&
+                         (g_escVar.activeBrake_pct == 0 || g_escVar.activeBrake_pct == 100);
+    powerGovernorBlockLightSleep(!outputsStatic);
+    portENTER_CRITICAL(&g_govStatsMux);
+    g_govStats.lightSleepAllowed = !g_govLightSleepBlocked;
+    portEXIT_CRITICAL(&g_govStatsMux);
+    return true;
+  }
+
+  if (!active && (nowMs - g_govLastActiveMs) >= POWER_GOV_IDLE_MS) {
+    powerGovernorSetFullClock(false);
+    g_govState = POWER_GOV_IDLE;
+    g_govIdleSinceMs = nowMs;
+    portENTER_CRITICAL(&g_govStatsMux);
+    g_govStats.state = POWER_GOV_IDLE;
+    g_govStats.idleEntries++;
+    portEXIT_CRITICAL(&g_govStatsMux);
+    return true;
+  }
+  return false;
+#else
+  (void)triggerFresh;
+  return false;
+#endif
+}
+
+/**
+ * @brief True if the CPU clock is under DFS control
+ * @details Callers must not use setCpuFrequencyMhz() then; it would fight the PM locks.
+ */
+bool powerGovernorOwnsCpuClock() {
+  return g_govPmActive;
+}
+
+void powerGovernorGetStats(PowerGovStats_type* outStats) {
+  if (outStats == nullptr) {
+    return;
+  }
+  portENTER_CRITICAL(&g_govStatsMux);
+  *outStats = g_govStats;
+  if (g_govStats.state == POWER_GOV_IDLE) {
+    outStats->idleTime_ms += millis() - g_govIdleSinceMs;
+  }
+  portEXIT_CRITICAL(&g_govStatsMux);
+}
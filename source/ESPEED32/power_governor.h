@@ -0,0 +1,48 @@
+#ifndef POWER_GOVERNOR_H_
+#define POWER_GOVERNOR_H_
+
+#include <stdint.h>
+
+/* Idle power governor (control task).
+ * While the car is parked on the grid - trigger at rest, no button or encoder input,
+ * WiFi off, no logging or OTA - for POWER_GOV_IDLE_MS, the control task:
+ *   - releases its CPU clock lock so DFS drops the clock to POWER_GOV_MIN_CPU_MHZ
+ *     (setCpuFrequencyMhz() fallback on builds without CONFIG_PM_ENABLE)
+ *   - allows auto light-sleep while the bridge outputs are static (no PWM running); only
+ *     takes effect on builds with tickless idle (CONFIG_FREERTOS_USE_TICKLESS_IDLE), and
+ *     only where the gaps between control ticks exceed the sleep entry threshold
+ * The control tick stays at ESC_PERIOD_US throughout and still polls the trigger, the brake
+ * button and the encoder activity stamp, so input is seen within one control period. The
+ * first tick that sees input takes the clock back before it computes any output, so that
+ * tick and all later ones run at full clock.
+ * The minimum clock keeps APB at 80 MHz, so LEDC and timer rates do not change. */
+#ifndef POWER_GOV_ENABLED
+#define POWER_GOV_ENABLED          1
+#endif
+#ifndef POWER_GOV_IDLE_MS
+#define POWER_GOV_IDLE_MS          10000UL  /* Quiet time before the clock drops */
+#endif
+#define POWER_GOV_MIN_CPU_MHZ      80       /* Lowest clock with APB still at 80 MHz */
+#define POWER_GOV_MAX_CPU_MHZ      240
+
+typedef enum {
+  POWER_GOV_FULL,   /* Full clock, ESC_PERIOD_US tick */
+  POWER_GOV_IDLE    /* Reduced clock, same ESC_PERIOD_US tick */
+} PowerGovState_enum;
+
+typedef struct {
+  uint8_t state;                /* PowerGovState_enum */
+  bool pmActive;                /* DFS configured through esp_pm (else setCpuFrequencyMhz fallback) */
+  bool lightSleepAllowed;       /* Auto light-sleep configured and currently not blocked */
+  uint32_t idleEntries;
+  uint32_t idleTime_ms;         /* Total time spent idle, including the current stretch */
+  uint32_t lastWakeLatency_us;  /* Input seen -> full clock restored, last wake */
+  uint32_t maxWakeLatency_us;
+} PowerGovStats_type;
+
+void powerGovernorInit();
+bool powerGovernorTick(bool triggerFresh);
+bool powerGovernorOwnsCpuClock();
+void powerGovernorGetStats(PowerGovStats_type* outStats);
+
+#endif  /* POWER_GOVERNOR_H_ */
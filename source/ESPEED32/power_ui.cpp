@@ -2,6 +2,9 @@
 #include <Arduino.h>
 #include "slot_ESC.h"
 #include "connectivity_portal.h"
+#include "settings_store.h"
+#include "power_governor.h"
+#include "sleep_wake.h"
 
 extern TaskHandle_t Task2;
 extern StoredVar_type g_storedVar;
@@ -137,8 +140,10 @@ void showPowerSave(uint32_t inactivityStartMs) {
   HalfBridge_SetPwmDrag(0, 0);
   /* Display off */
   obdPower(&g_obd, 0);
-  /* Reduce CPU frequency to save power */
-  setCpuFrequencyMhz(80);
+  /* Reduce CPU frequency to save power (DFS does it on its own once Task2 is idle) */
+  if (!powerGovernorOwnsCpuClock()) {
+    setCpuFrequencyMhz(80);
+  }
   /* Suspend motor control task */
   vTaskSuspend(Task2);
 
@@ -154,7 +159,9 @@ void showPowerSave(uint32_t inactivityStartMs) {
   }
 
   /* Wake up: restore CPU, resume motor task, display on */
-  setCpuFrequencyMhz(240);
+  if (!powerGovernorOwnsCpuClock()) {
+    setCpuFrequencyMhz(240);
+  }
   vTaskResume(Task2);
   obdPower(&g_obd, 1);
   obdFill(&g_obd, OBD_WHITE, 1);
@@ -183,6 +190,9 @@ void showDeepSleep() {
   HalfBridge_SetPwmDrag(0, 0);
   obdPower(&g_obd, 0);
 
-  /* Enter deep sleep - wakes only on power cycle */
+  settingsStoreFlush();  /* RAM (and a pending save) does not survive deep sleep */
+
+  /* Enter deep sleep - wakes on a button press (settings kept in RTC memory) or power cycle */
+  sleepWakeArm(&g_storedVar);
   esp_deep_sleep_start();
 }
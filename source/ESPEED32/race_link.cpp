@@ -0,0 +1,662 @@
+#include "race_link.h"
+#include <Arduino.h>
+#include <WiFi.h>
+#include <esp_now.h>
+#include <esp_wifi.h>
+#include <esp_timer.h>
+#include <esp_idf_version.h>
+#include <Preferences.h>
+#include <string.h>
+#include "slot_ESC.h"
+#include "HAL.h"
+#include "connectivity_portal.h"
+#include "lap_engine.h"
+
+extern StoredVar_type g_storedVar;
+extern ESC_type g_escVar;
+extern uint16_t g_carSel;
+
+#define RACE_LINK_PREF_NAMESPACE   "rlink"
+#define RACE_LINK_PREF_ENABLED     "en"
+#define RACE_LINK_PREF_LANE        "lane"
+#define RACE_LINK_PREF_CHANNEL     "chan"
+#define RACE_LINK_PREF_BASE        "base"
+#define RACE_LINK_SEND_TIMEOUT_MS  50U      /* Send callback overdue: count the packet as lost */
+#define RACE_LINK_RESYNC_US        100000LL /* Offset jump this large: base rebooted, restart the filter */
+#define RACE_LINK_LANE_NONE        0xFFU
+
+typedef struct {
+  uint8_t mac[6];
+  uint8_t len;
+  int64_t rx_us;            /* Local esp_timer when the packet arrived */
+  RaceLinkBeacon_type beacon;
+} RaceLinkRx_type;
+
+typedef struct {
+  bool enabled;
+  bool espNowUp;
+  bool ownRadio;            /* The link switched WiFi on and may hop channels */
+  bool paired;
+  bool pairing;
+  bool pairAnnounce;        /* Send RaceLinkPair_type to the new base */
+  bool synced;
+  uint8_t state;            /* RaceLinkState_enum */
+  uint8_t lane;
+  uint8_t channel;
+  uint8_t storedChannel;
+  uint8_t portalMode;       /* Portal transport when ESP-NOW was set up */
+  wifi_mode_t mode;         /* WiFi mode when ESP-NOW was set up */
+  uint8_t baseMac[6];       /* Paired base, or the base the link follows */
+  bool haveBase;
+  uint16_t raceId;
+  uint32_t radioOffSinceMs;
+  uint32_t lastBeaconMs;
+  uint32_t hopMs;
+  uint32_t lastTelemetryMs;
+  int64_t offsets[RACE_LINK_SYNC_WINDOW];
+  uint8_t offsetCount;
+  uint8_t offsetIdx;
+  int64_t offsetUs;
+  uint32_t spreadUs;
+  uint16_t lapSeq;
+  uint16_t telemetrySeq;
+  uint16_t pairSeq;
+  /* Lap packet being delivered */
+  bool lapInFlight;
+  uint8_t lapAttempts;
+  RaceLinkLap_type lapPacket;
+  uint32_t sendStartMs;
+  uint32_t beacons;
+  uint32_t lapsSent;
+  uint32_t lapsFailed;
+  uint32_t lapsDropped;
+  uint32_t telemetrySent;
+} RaceLinkEngine_type;
+
+static const uint8_t RACE_LINK_BROADCAST[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+static QueueHandle_t g_raceRxQueue = NULL;
+
+/* Send callback (WiFi driver task) → raceLinkService() */
+static volatile bool g_raceSendBusy = false;
+static volatile bool g_raceSendOk = false;
+
+/* Requests from any task, applied by raceLinkService() */
+static volatile int8_t g_raceEnableRequest = -1;        /* -1: none, 0: off, 1: on */
+static volatile uint8_t g_raceLaneRequest = RACE_LINK_LANE_NONE;
+static volatile bool g_racePairRequested = false;
+static volatile bool g_raceForgetRequested = false;
+
+/* Written by raceLinkService(), read by anyone under g_raceMux */
+static portMUX_TYPE g_raceMux = portMUX_INITIALIZER_UNLOCKED;
+static RaceLinkStatus_type g_raceStatus;
+
+/* WiFiTask only (lap listener and raceLinkService()) */
+static RaceLinkEngine_type g_race;
+static LapCrossing_type g_raceLaps[RACE_LINK_LAP_QUEUE_LEN];
+static uint8_t g_raceLapHead = 0;
+static uint8_t g_raceLapCount = 0;
+
+/*********************************************************************************************************************/
+/*                                                  ESP-NOW glue                                                     */
+/*********************************************************************************************************************/
+
+static void raceLinkOnReceive(const esp_now_recv_info_t* info, const uint8_t* data, int len) {
+  int64_t rx_us = esp_timer_get_time();
+  if (info == nullptr || data == nullptr || len < (int)sizeof(RaceLinkBeacon_type) || g_raceRxQueue == NULL) {
+    return;
+  }
+  const RaceLinkHeader_type* header = (const RaceLinkHeader_type*)data;
+  if (header->magic != RACE_LINK_MAGIC || header->type != RACE_LINK_PKT_BEACON) {
+    return;   /* Other controllers' lap/telemetry broadcasts */
+  }
+  RaceLinkRx_type rx;
+  memcpy(rx.mac, info->src_addr, sizeof(rx.mac));
+  rx.len = (uint8_t)min(len, (int)sizeof(rx.beacon));
+  rx.rx_us = rx_us;
+  memcpy(&rx.beacon, data, sizeof(rx.beacon));
+  xQueueSend(g_raceRxQueue, &rx, 0);
+}
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 5, 0)
+static void raceLinkOnSent(const wifi_tx_info_t* info, esp_now_send_status_t status) {
+  (void)info;
+#else
+static void raceLinkOnSent(const uint8_t* mac, esp_now_send_status_t status) {
+  (void)mac;
+#endif
+  g_raceSendOk = (status == ESP_NOW_SEND_SUCCESS);
+  g_raceSendBusy = false;
+}
+
+static bool raceLinkAddPeer(const uint8_t* mac) {
+  if (esp_now_is_peer_exist(mac)) {
+    return true;
+  }
+  esp_now_peer_info_t peer;
+  memset(&peer, 0, sizeof(peer));
+  memcpy(peer.peer_addr, mac, sizeof(peer.peer_addr));
+  peer.channel = 0;   /* Whatever channel the radio is on */
+  peer.ifidx = (g_race.mode == WIFI_AP) ? WIFI_IF_AP : WIFI_IF_STA;
+  peer.encrypt = false;
+  return esp_now_add_peer(&peer) == ESP_OK;
+}
+
+static void raceLinkEspNowDown() {
+  if (g_race.espNowUp) {
+    esp_now_deinit();
+    g_race.espNowUp = false;
+  }
+  g_raceSendBusy = false;
+  g_race.lapInFlight = false;   /* Re-sent from the queue once the radio is back */
+}
+
+static void raceLinkSetChannel(uint8_t channel) {
+  g_race.channel = channel;
+  if (g_race.ownRadio) {
+    esp_wifi_set_channel(channel, WIFI_SECOND_CHAN_NONE);
+  }
+}
+
+static void raceLinkResetSync() {
+  g_race.synced = false;
+  g_race.offsetCount = 0;
+  g_race.offsetIdx = 0;
+  g_race.spreadUs = 0;
+}
+
+/**
+ * @brief Bring ESP-NOW up on whatever WiFi mode is active, switching the radio on if nobody uses it
+ * @details The portal switches WiFi modes from Task1; a change of mode or portal transport tears
+ *          ESP-NOW down so it is set up again on the new interface. The link only takes an idle
+ *          radio after RACE_LINK_RADIO_SETTLE_MS, so it never races a portal start.
+ */
+static bool raceLinkRadioService(uint32_t nowMs) {
+  wifi_mode_t mode = WiFi.getMode();
+  uint8_t portalMode = (uint8_t)getActiveWiFiPortalMode();
+
+  if (g_race.espNowUp && (mode != g_race.mode || portalMode != g_race.portalMode)) {
+    raceLinkEspNowDown();
+    g_race.ownRadio = false;
+    g_race.state = RACE_LINK_WAIT_RADIO;
+  }
+  if (g_race.espNowUp) {
+    return true;
+  }
+
+  if (mode == WIFI_OFF) {
+    if (g_race.radioOffSinceMs == 0) {
+      g_race.radioOffSinceMs = max(nowMs, (uint32_t)1);
+      return false;
+    }
+    if ((nowMs - g_race.radioOffSinceMs) < RACE_LINK_RADIO_SETTLE_MS || portalMode != WIFI_PORTAL_OFF) {
+      return false;
+    }
+    WiFi.mode(WIFI_STA);
+    WiFi.disconnect();
+    mode = WIFI_STA;
+    g_race.ownRadio = true;
+  } else {
+    g_race.ownRadio = false;
+  }
+  g_race.radioOffSinceMs = 0;
+
+  if (esp_now_init() != ESP_OK) {
+    return false;
+  }
+  esp_now_register_recv_cb(raceLinkOnReceive);
+  esp_now_register_send_cb(raceLinkOnSent);
+  g_race.espNowUp = true;
+  g_race.mode = mode;
+  g_race.portalMode = portalMode;
+  raceLinkAddPeer(RACE_LINK_BROADCAST);
+  if (g_race.paired) {
+    raceLinkAddPeer(g_race.baseMac);
+  }
+
+  if (g_race.ownRadio) {
+    raceLinkSetChannel(g_race.storedChannel);
+  } else {
+    g_race.channel = (uint8_t)WiFi.channel();
+  }
+  g_race.state = RACE_LINK_SCANNING;
+  g_race.hopMs = nowMs;
+  raceLinkResetSync();
+  return true;
+}
+
+/*********************************************************************************************************************/
+/*                                                Beacons and sync                                                   */
+/*********************************************************************************************************************/
+
+static void raceLinkSavePairing() {
+  Preferences pref;
+  if (pref.begin(RACE_LINK_PREF_NAMESPACE, false)) {
+    if (g_race.paired) {
+      pref.putBytes(RACE_LINK_PREF_BASE, g_race.baseMac, sizeof(g_race.baseMac));
+      pref.putUChar(RACE_LINK_PREF_CHANNEL, g_race.storedChannel);
+    } else {
+      pref.remove(RACE_LINK_PREF_BASE);
+    }
+    pref.end();
+  }
+}
+
+/**
+ * @brief Fold one beacon offset into the filter
+ * @details Delivery delay only ever makes a beacon look late, so the largest offset in the
+ *          window is the least delayed one; the spread tells how much the window disagrees.
+ */
+static void raceLinkAddOffset(int64_t offsetUs) {
+  if (g_race.offsetCount > 0) {
+    int64_t jump = offsetUs - g_race.offsetUs;
+    if (jump > RACE_LINK_RESYNC_US || jump < -RACE_LINK_RESYNC_US) {
+      raceLinkResetSync();
+    }
+  }
+  g_race.offsets[g_race.offsetIdx] = offsetUs;
+  g_race.offsetIdx = (uint8_t)((g_race.offsetIdx + 1U) % RACE_LINK_SYNC_WINDOW);
+  if (g_race.offsetCount < RACE_LINK_SYNC_WINDOW) {
+    g_race.offsetCount++;
+  }
+
+  int64_t hi = g_race.offsets[0];
+  int64_t lo = g_race.offsets[0];
+  for (uint8_t i = 1; i < g_race.offsetCount; i++) {
+    if (g_race.offsets[i] > hi) hi = g_race.offsets[i];
+    if (g_race.offsets[i] < lo) lo = g_race.offsets[i];
+  }
+  g_race.offsetUs = hi;
+  g_race.spreadUs = (uint32_t)(hi - lo);
+  g_race.synced = g_race.offsetCount >= (RACE_LINK_SYNC_WINDOW / 2U);
+}
+
+static void raceLinkHandleBeacon(const RaceLinkRx_type* rx, uint32_t nowMs) {
+  const RaceLinkBeacon_type* b = &rx->beacon;
+  if (rx->len < sizeof(RaceLinkBeacon_type) || b->header.version != RACE_LINK_VERSION) {
+    return;
+  }
+
+  if (g_race.pairing && (b->flags & RACE_LINK_BEACON_PAIRING) != 0U) {
+    memcpy(g_race.baseMac, rx->mac, sizeof(g_race.baseMac));
+    g_race.haveBase = true;
+    g_race.paired = true;
+    g_race.pairing = false;
+    g_race.pairAnnounce = true;
+    if (b->channel >= RACE_LINK_CHANNEL_MIN && b->channel <= RACE_LINK_CHANNEL_MAX) {
+      g_race.storedChannel = b->channel;
+    }
+    raceLinkAddPeer(g_race.baseMac);
+    raceLinkSavePairing();
+    raceLinkResetSync();
+  }
+
+  if (g_race.haveBase && memcmp(rx->mac, g_race.baseMac, sizeof(g_race.baseMac)) != 0) {
+    return;   /* Another race network */
+  }
+  if (!g_race.haveBase) {
+    memcpy(g_race.baseMac, rx->mac, sizeof(g_race.baseMac));   /* Follow the first base heard */
+    g_race.haveBase = true;
+  }
+
+  g_race.beacons++;
+  g_race.lastBeaconMs = nowMs;
+  g_race.state = RACE_LINK_LINKED;
+  g_race.raceId = b->raceId;
+  raceLinkAddOffset((int64_t)b->baseTime_us + RACE_LINK_RX_LATENCY_US - rx->rx_us);
+
+  if (g_race.ownRadio && b->channel != g_race.channel &&
+      b->channel >= RACE_LINK_CHANNEL_MIN && b->channel <= RACE_LINK_CHANNEL_MAX) {
+    raceLinkSetChannel(b->channel);
+    if (g_race.paired && g_race.storedChannel != b->channel) {
+      g_race.storedChannel = b->channel;
+      raceLinkSavePairing();
+    }
+  }
+}
+
+static void raceLinkChannelService(uint32_t nowMs) {
+  if (g_race.state == RACE_LINK_LINKED && (nowMs - g_race.lastBeaconMs) > RACE_LINK_BEACON_TIMEOUT_MS) {
+    g_race.state = RACE_LINK_SCANNING;
+    g_race.hopMs = nowMs;
+    if (!g_race.paired) {
+      g_race.haveBase = false;
+    }
+    raceLinkResetSync();
+  }
+  if (g_race.state != RACE_LINK_SCANNING) {
+    return;
+  }
+  if (!g_race.ownRadio) {
+    g_race.channel = (uint8_t)WiFi.channel();
+    return;
+  }
+  if ((nowMs - g_race.hopMs) >= RACE_LINK_SCAN_DWELL_MS) {
+    g_race.hopMs = nowMs;
+    uint8_t next = (uint8_t)(g_race.channel + 1U);
+    raceLinkSetChannel((next > RACE_LINK_CHANNEL_MAX) ? RACE_LINK_CHANNEL_MIN : next);
+  }
+}
+
+/*********************************************************************************************************************/
+/*                                                    Sending                                                        */
+/*********************************************************************************************************************/
+
+/* micros() is the low half of esp_timer; widen through the current time */
+static int64_t raceLinkLocalUs(uint32_t timestampUs) {
+  int64_t now = esp_timer_get_time();
+  return now - (int64_t)(uint32_t)((uint32_t)now - timestampUs);
+}
+
+static uint64_t raceLinkToBaseUs(int64_t localUs, uint8_t* flags) {
+  if (g_race.synced) {
+    *flags |= RACE_LINK_FLAG_SYNCED;
+    return (uint64_t)(localUs + g_race.offsetUs);
+  }
+  return (uint64_t)localUs;
+}
+
+static void raceLinkFillHeader(RaceLinkHeader_type* header, uint8_t type, uint16_t seq) {
+  header->magic = RACE_LINK_MAGIC;
+  header->version = RACE_LINK_VERSION;
+  header->type = type;
+  header->lane = g_race.lane;
+  header->seq = seq;
+}
+
+static bool raceLinkSend(const void* packet, size_t len, uint32_t nowMs) {
+  const uint8_t* dest = g_race.paired ? g_race.baseMac : RACE_LINK_BROADCAST;
+  g_raceSendOk = false;
+  g_raceSendBusy = true;
+  g_race.sendStartMs = nowMs;
+  if (esp_now_send(dest, (const uint8_t*)packet, len) != ESP_OK) {
+    g_raceSendBusy = false;
+    return false;
+  }
+  return true;
+}
+
+/* LapCrossing_fn: lapEngineService(), same task as raceLinkService() */
+static void raceLinkOnCrossing(const LapCrossing_type* crossing) {
+  if (!g_race.enabled) {
+    return;
+  }
+  if (g_raceLapCount == RACE_LINK_LAP_QUEUE_LEN) {
+    g_raceLapHead = (uint8_t)((g_raceLapHead + 1U) % RACE_LINK_LAP_QUEUE_LEN);   /* Drop the oldest */
+    g_raceLapCount--;
+    g_race.lapsDropped++;
+  }
+  g_raceLaps[(g_raceLapHead + g_raceLapCount) % RACE_LINK_LAP_QUEUE_LEN] = *crossing;
+  g_raceLapCount++;
+}
+
+static void raceLinkBuildLap(const LapCrossing_type* c) {
+  RaceLinkLap_type* p = &g_race.lapPacket;
+  memset(p, 0, sizeof(*p));
+  raceLinkFillHeader(&p->header, RACE_LINK_PKT_LAP, ++g_race.lapSeq);
+  p->flags = g_race.paired ? RACE_LINK_FLAG_PAIRED : 0U;
+  p->crossing_us = raceLinkToBaseUs(raceLinkLocalUs(c->timestampUs), &p->flags);
+  p->lapUs = c->lapUs;
+  p->sectorUs = c->sectorUs;
+  p->lapNumber = c->lapNumber;
+  p->syncSpread_us = (uint16_t)min(g_race.spreadUs, (uint32_t)0xFFFFU);
+  p->sector = c->sector;
+  p->sectorCount = c->sectorCount;
+  p->carIndex = c->carIndex;
+}
+
+/**
+ * @brief Deliver queued laps one at a time
+ * @details Unicast relies on the MAC ack: a failed send is repeated up to RACE_LINK_LAP_RETRIES
+ *          times. Broadcast has no ack, so every lap simply goes out RACE_LINK_LAP_REPEAT times.
+ */
+static bool raceLinkLapService(uint32_t nowMs) {
+  if (!g_race.lapInFlight) {
+    if (g_raceLapCount == 0) {
+      return false;
+    }
+    raceLinkBuildLap(&g_raceLaps[g_raceLapHead]);
+    g_race.lapInFlight = true;
+    g_race.lapAttempts = 0;
+  } else {
+    bool delivered = g_race.paired ? g_raceSendOk : (g_race.lapAttempts >= RACE_LINK_LAP_REPEAT);
+    bool exhausted = g_race.paired && g_race.lapAttempts > RACE_LINK_LAP_RETRIES;
+    if (delivered || exhausted) {
+      if (delivered) {
+        g_race.lapsSent++;
+      } else {
+        g_race.lapsFailed++;
+      }
+      g_race.lapInFlight = false;
+      g_raceLapHead = (uint8_t)((g_raceLapHead + 1U) % RACE_LINK_LAP_QUEUE_LEN);
+      g_raceLapCount--;
+      return true;
+    }
+  }
+  g_race.lapAttempts++;
+  raceLinkSend(&g_race.lapPacket, sizeof(g_race.lapPacket), nowMs);   /* A failed call counts as an attempt */
+  return true;
+}
+
+static void raceLinkSendPair(uint32_t nowMs) {
+  RaceLinkPair_type p;
+  memset(&p, 0, sizeof(p));
+  raceLinkFillHeader(&p.header, RACE_LINK_PKT_PAIR, ++g_race.pairSeq);
+  p.carIndex = (uint8_t)g_carSel;
+  p.sectorCount = lapEngineGetSectorCount();
+  strncpy(p.name, g_storedVar.activeCar.carName, sizeof(p.name));
+  if (raceLinkSend(&p, sizeof(p), nowMs)) {
+    g_race.pairAnnounce = false;
+  }
+}
+
+static void raceLinkSendTelemetry(uint32_t nowMs) {
+  RaceLinkTelemetry_type p;
+  LapStats_type stats;
+  lapEngineGetStats(&stats);
+  memset(&p, 0, sizeof(p));
+  raceLinkFillHeader(&p.header, RACE_LINK_PKT_TELEMETRY, ++g_race.telemetrySeq);
+  p.flags = g_race.paired ? RACE_LINK_FLAG_PAIRED : 0U;
+  p.t_us = raceLinkToBaseUs(esp_timer_get_time(), &p.flags);
+  p.currentLapUs = stats.currentLapUs;
+  p.vin_mV = g_escVar.Vin_mV;
+  p.current_mA = g_escVar.motorCurrent_mA;
+  p.trigger_pct = (uint8_t)(((uint32_t)g_escVar.trigger_norm * 100U) / THROTTLE_NORMALIZED);
+  p.output_pct = (uint8_t)constrain((int)g_escVar.outputSpeed_pct, 0, 100);
+  p.speed_halfPct = g_escVar.motorSpeedValid ? g_escVar.motorSpeed_halfPct : 0xFFU;
+  p.carIndex = (uint8_t)g_carSel;
+  if (raceLinkSend(&p, sizeof(p), nowMs)) {
+    g_race.telemetrySent++;
+  }
+  g_race.lastTelemetryMs = nowMs;
+}
+
+/*********************************************************************************************************************/
+/*                                                  Public API                                                       */
+/*********************************************************************************************************************/
+
+static void raceLinkPublishStatus() {
+  RaceLinkStatus_type s;
+  memset(&s, 0, sizeof(s));
+  s.state = g_race.state;
+  s.lane = g_race.lane;
+  s.channel = g_race.channel;
+  s.enabled = g_race.enabled;
+  s.paired = g_race.paired;
+  s.pairing = g_race.pairing;
+  s.synced = g_race.synced;
+  s.radioShared = g_race.espNowUp && !g_race.ownRadio;
+  memcpy(s.baseMac, g_race.baseMac, sizeof(s.baseMac));
+  s.raceId = g_race.raceId;
+  s.offsetUs = g_race.offsetUs;
+  s.syncSpreadUs = g_race.spreadUs;
+  s.beacons = g_race.beacons;
+  s.lapsSent = g_race.lapsSent;
+  s.lapsFailed = g_race.lapsFailed;
+  s.lapsDropped = g_race.lapsDropped;
+  s.telemetrySent = g_race.telemetrySent;
+  portENTER_CRITICAL(&g_raceMux);
+  g_raceStatus = s;
+  portEXIT_CRITICAL(&g_raceMux);
+}
+
+/**
+ * @brief Restore lane, pairing and the enabled flag; hook into the lap engine
+ * @details Call after lapEngineBegin().
+ */
+void raceLinkBegin() {
+  if (g_raceRxQueue == NULL) {
+    g_raceRxQueue = xQueueCreate(RACE_LINK_RX_QUEUE_LEN, sizeof(RaceLinkRx_type));
+  }
+  memset(&g_race, 0, sizeof(g_race));
+  g_race.storedChannel = WIFI_AP_CHANNEL;
+  Preferences pref;
+  if (pref.begin(RACE_LINK_PREF_NAMESPACE, true)) {
+    g_race.enabled = pref.getBool(RACE_LINK_PREF_ENABLED, false);
+    g_race.lane = pref.getUChar(RACE_LINK_PREF_LANE, 0);
+    g_race.storedChannel = pref.getUChar(RACE_LINK_PREF_CHANNEL, WIFI_AP_CHANNEL);
+    g_race.paired = pref.getBytes(RACE_LINK_PREF_BASE, g_race.baseMac, sizeof(g_race.baseMac)) == sizeof(g_race.baseMac);
+    pref.end();
+  }
+  if (g_race.storedChannel < RACE_LINK_CHANNEL_MIN || g_race.storedChannel > RACE_LINK_CHANNEL_MAX) {
+    g_race.storedChannel = WIFI_AP_CHANNEL;
+  }
+  g_race.haveBase = g_race.paired;
+  g_race.channel = g_race.storedChannel;
+  g_race.state = g_race.enabled ? RACE_LINK_WAIT_RADIO : RACE_LINK_OFF;
+  lapEngineSetCrossingListener(raceLinkOnCrossing);
+  raceLinkPublishStatus();
+}
+
+/**
+ * @brief Apply requests, follow the base and send queued packets (WiFiTask)
+ */
+void raceLinkService() {
+  if (g_raceRxQueue == NULL) {
+    return;
+  }
+
+  int8_t enableRequest = g_raceEnableRequest;
+  uint8_t laneRequest = g_raceLaneRequest;
+  if (enableRequest >= 0 || laneRequest != RACE_LINK_LANE_NONE) {
+    g_raceEnableRequest = -1;
+    g_raceLaneRequest = RACE_LINK_LANE_NONE;
+    if (enableRequest >= 0) {
+      g_race.enabled = (enableRequest > 0);
+    }
+    if (laneRequest != RACE_LINK_LANE_NONE) {
+      g_race.lane = laneRequest;
+    }
+    Preferences pref;
+    if (pref.begin(RACE_LINK_PREF_NAMESPACE, false)) {
+      pref.putBool(RACE_LINK_PREF_ENABLED, g_race.enabled);
+      pref.putUChar(RACE_LINK_PREF_LANE, g_race.lane);
+      pref.end();
+    }
+    if (!g_race.enabled) {
+      bool ownRadio = g_race.ownRadio;
+      raceLinkEspNowDown();
+      if (ownRadio && getActiveWiFiPortalMode() == WIFI_PORTAL_OFF) {
+        WiFi.mode(WIFI_OFF);
+      }
+      g_race.ownRadio = false;
+      g_race.pairing = false;
+      g_race.radioOffSinceMs = 0;
+      g_raceLapCount = 0;
+      g_race.state = RACE_LINK_OFF;
+    } else if (g_race.state == RACE_LINK_OFF) {
+      g_race.state = RACE_LINK_WAIT_RADIO;
+    }
+  }
+  if (g_raceForgetRequested) {
+    g_raceForgetRequested = false;
+    if (g_race.paired && g_race.espNowUp) {
+      esp_now_del_peer(g_race.baseMac);
+    }
+    g_race.paired = false;
+    g_race.haveBase = false;
+    raceLinkSavePairing();
+  }
+  if (g_racePairRequested) {
+    g_racePairRequested = false;
+    if (g_race.enabled) {
+      if (g_race.paired && g_race.espNowUp) {
+        esp_now_del_peer(g_race.baseMac);
+      }
+      g_race.paired = false;
+      g_race.haveBase = false;
+      g_race.pairing = true;
+    }
+  }
+
+  if (!g_race.enabled) {
+    RaceLinkRx_type rx;
+    while (xQueueReceive(g_raceRxQueue, &rx, 0) == pdTRUE) {
+    }
+    raceLinkPublishStatus();
+    return;
+  }
+
+  uint32_t nowMs = millis();
+  if (!raceLinkRadioService(nowMs)) {
+    g_race.state = RACE_LINK_WAIT_RADIO;
+    raceLinkPublishStatus();
+    return;
+  }
+
+  RaceLinkRx_type rx;
+  while (xQueueReceive(g_raceRxQueue, &rx, 0) == pdTRUE) {
+    raceLinkHandleBeacon(&rx, nowMs);
+  }
+  raceLinkChannelService(nowMs);
+
+  if (g_raceSendBusy && (nowMs - g_race.sendStartMs) > RACE_LINK_SEND_TIMEOUT_MS) {
+    g_raceSendBusy = false;   /* Callback never came */
+    g_raceSendOk = false;
+  }
+  if (g_race.state == RACE_LINK_LINKED && !g_raceSendBusy) {
+    if (g_race.pairAnnounce) {
+      raceLinkSendPair(nowMs);
+    } else if (!raceLinkLapService(nowMs) && (nowMs - g_race.lastTelemetryMs) >= RACE_LINK_TELEMETRY_MS) {
+      raceLinkSendTelemetry(nowMs);
+    }
+  }
+  raceLinkPublishStatus();
+}
+
+/**
+ * @brief Switch the race link on or off (persisted)
+ */
+bool raceLinkSetEnabled(bool enabled) {
+  g_raceEnableRequest = enabled ? 1 : 0;
+  return true;
+}
+
+/**
+ * @brief Lane number reported to the base (persisted); 0 = unassigned
+ */
+bool raceLinkSetLane(uint8_t lane) {
+  if (lane > RACE_LINK_LANE_MAX) {
+    return false;
+  }
+  g_raceLaneRequest = lane;
+  return true;
+}
+
+/**
+ * @brief Drop the current base and pair with the next one that accepts pairing
+ */
+void raceLinkPair() {
+  g_racePairRequested = true;
+}
+
+void raceLinkForget() {
+  g_raceForgetRequested = true;
+}
+
+void raceLinkGetStatus(RaceLinkStatus_type* out) {
+  if (out == nullptr) return;
+  portENTER_CRITICAL(&g_raceMux);
+  *out = g_raceStatus;
+  portEXIT_CRITICAL(&g_raceMux);
+}
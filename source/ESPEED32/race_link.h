@@ -0,0 +1,138 @@
+#ifndef RACE_LINK_H_
+#define RACE_LINK_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* ESP-NOW race network: lap crossings and decimated telemetry to a base station.
+ * Every controller runs its own AP for the portal, so race control cannot watch several
+ * lanes over HTTP. With the race link enabled, raceLinkService() (WiFiTask) instead talks
+ * ESP-NOW to a base controller, without router, association or connection limit:
+ *   - the base broadcasts a RaceLinkBeacon_type every ~100 ms carrying its esp_timer clock.
+ *     The controller keeps the largest (base - local) offset of the last
+ *     RACE_LINK_SYNC_WINDOW beacons (the least delayed one), so crossings are reported in
+ *     the base's timebase, aligned across lanes to the beacon jitter (well under 1 ms)
+ *   - every dead-spot crossing is sent as a RaceLinkLap_type; to the paired base as unicast
+ *     (MAC-level ack, resent up to RACE_LINK_LAP_RETRIES times), otherwise as
+ *     RACE_LINK_LAP_REPEAT broadcasts with the same seq for the base to drop duplicates
+ *   - a RaceLinkTelemetry_type snapshot goes out every RACE_LINK_TELEMETRY_MS
+ *   - channel: a controller that owns the radio (portal off) hops 1..13, starting with the
+ *     stored channel, until it hears a beacon, and follows the channel a beacon announces.
+ *     While the portal runs the radio stays on the portal's channel (WIFI_AP_CHANNEL in
+ *     AP mode), so a base meant to coexist with portals should use that channel
+ *   - pairing: raceLinkPair() latches onto the next beacon that has
+ *     RACE_LINK_BEACON_PAIRING set and stores that base and its channel; a paired controller
+ *     ignores every other base. Lane and pairing persist in Preferences ("rlink")
+ * The radio stays on while the link is enabled, so ADC2 readings (back-EMF) pause as they
+ * do with the portal. All packets start with RaceLinkHeader_type, little-endian, packed. */
+#define RACE_LINK_MAGIC                0xE3U
+#define RACE_LINK_VERSION              1U
+#define RACE_LINK_CHANNEL_MIN          1U
+#define RACE_LINK_CHANNEL_MAX          13U
+#define RACE_LINK_LANE_MAX             16U
+#define RACE_LINK_SCAN_DWELL_MS        250U     /* Per channel while looking for a base */
+#define RACE_LINK_BEACON_TIMEOUT_MS    2000U    /* No beacon: base lost, scan again */
+#define RACE_LINK_RADIO_SETTLE_MS      1000U    /* Radio off this long before the link takes it */
+#define RACE_LINK_SYNC_WINDOW          8U
+#define RACE_LINK_RX_LATENCY_US        120      /* Typical beacon air + stack time, added to the offset */
+#define RACE_LINK_TELEMETRY_MS         100U
+#define RACE_LINK_LAP_QUEUE_LEN        8U
+#define RACE_LINK_LAP_RETRIES          3U
+#define RACE_LINK_LAP_REPEAT           3U
+#define RACE_LINK_RX_QUEUE_LEN         4U
+
+#define RACE_LINK_PKT_BEACON           0x01U    /* Base → all */
+#define RACE_LINK_PKT_PAIR             0x02U    /* Controller → base, once after pairing */
+#define RACE_LINK_PKT_LAP              0x03U
+#define RACE_LINK_PKT_TELEMETRY        0x04U
+
+#define RACE_LINK_BEACON_PAIRING       0x01U    /* Base accepts new controllers */
+
+#define RACE_LINK_FLAG_SYNCED          0x01U    /* Times are in the base timebase */
+#define RACE_LINK_FLAG_PAIRED          0x02U
+
+typedef struct __attribute__((packed)) {
+  uint8_t magic;            /* RACE_LINK_MAGIC */
+  uint8_t version;
+  uint8_t type;             /* RACE_LINK_PKT_* */
+  uint8_t lane;             /* 0 on base packets */
+  uint16_t seq;             /* Per sender and type */
+} RaceLinkHeader_type;
+
+typedef struct __attribute__((packed)) {
+  RaceLinkHeader_type header;
+  uint64_t baseTime_us;     /* Base esp_timer at transmission */
+  uint16_t raceId;
+  uint8_t channel;          /* Channel the race runs on; controllers follow it */
+  uint8_t flags;            /* RACE_LINK_BEACON_* */
+} RaceLinkBeacon_type;
+
+typedef struct __attribute__((packed)) {
+  RaceLinkHeader_type header;
+  uint8_t carIndex;
+  uint8_t sectorCount;
+  char name[8];             /* Current car name, NUL padded */
+} RaceLinkPair_type;
+
+typedef struct __attribute__((packed)) {
+  RaceLinkHeader_type header;
+  uint64_t crossing_us;     /* Base timebase if RACE_LINK_FLAG_SYNCED, local esp_timer otherwise */
+  uint32_t lapUs;           /* 0: the crossing closed a sector only, or was the line */
+  uint32_t sectorUs;
+  uint16_t lapNumber;       /* Lap now running */
+  uint16_t syncSpread_us;   /* Offset spread over the sync window, clamped */
+  uint8_t sector;
+  uint8_t sectorCount;
+  uint8_t carIndex;
+  uint8_t flags;            /* RACE_LINK_FLAG_* */
+} RaceLinkLap_type;
+
+typedef struct __attribute__((packed)) {
+  RaceLinkHeader_type header;
+  uint64_t t_us;            /* Same timebase rules as RaceLinkLap_type */
+  uint32_t currentLapUs;
+  uint16_t vin_mV;
+  uint16_t current_mA;
+  uint8_t trigger_pct;
+  uint8_t output_pct;
+  uint8_t speed_halfPct;    /* 0xFF: no back-EMF estimate */
+  uint8_t carIndex;
+  uint8_t flags;            /* RACE_LINK_FLAG_* */
+} RaceLinkTelemetry_type;
+
+typedef enum {
+  RACE_LINK_OFF,
+  RACE_LINK_WAIT_RADIO,     /* Enabled; WiFi is being switched by the portal */
+  RACE_LINK_SCANNING,
+  RACE_LINK_LINKED          /* Beacons arriving */
+} RaceLinkState_enum;
+
+typedef struct {
+  uint8_t state;            /* RaceLinkState_enum */
+  uint8_t lane;
+  uint8_t channel;
+  bool enabled;
+  bool paired;
+  bool pairing;
+  bool synced;
+  bool radioShared;         /* Portal owns the radio: no channel hopping */
+  uint8_t baseMac[6];
+  uint16_t raceId;
+  int64_t offsetUs;         /* base = local + offset */
+  uint32_t syncSpreadUs;
+  uint32_t beacons;
+  uint32_t lapsSent;
+  uint32_t lapsFailed;
+  uint32_t lapsDropped;     /* Queue full */
+  uint32_t telemetrySent;
+} RaceLinkStatus_type;
+
+void raceLinkBegin();
+void raceLinkService();
+bool raceLinkSetEnabled(bool enabled);
+bool raceLinkSetLane(uint8_t lane);
+void raceLinkPair();
+void raceLinkForget();
+void raceLinkGetStatus(RaceLinkStatus_type* out);
+
+#endif  /* RACE_LINK_H_ */
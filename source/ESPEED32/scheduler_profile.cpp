@@ -0,0 +1,52 @@
+#include "scheduler_profile.h"
+#include "slot_ESC.h"
+#include "connectivity_portal.h"
+
+static TaskHandle_t g_schedWiFiTask = NULL;
+static volatile uint8_t g_schedProfile = SCHED_PROFILE_TUNING;  /* Written by Task1 only */
+
+void schedProfileBegin(TaskHandle_t wifiTask) {
+  g_schedWiFiTask = wifiTask;
+  g_schedProfile = SCHED_PROFILE_TUNING;
+}
+
+/**
+ * @brief Switch profile when the race view is entered or left (Task1)
+ * @param raceView State machine RUNNING with the grid (race) view on screen
+ */
+void schedProfileService(bool raceView) {
+  uint8_t wanted = (raceView && !isOtaInProgress()) ? SCHED_PROFILE_RACE : SCHED_PROFILE_TUNING;
+  if (wanted == g_schedProfile) {
+    return;
+  }
+  g_schedProfile = wanted;
+  if (g_schedWiFiTask != NULL) {
+    vTaskPrioritySet(g_schedWiFiTask, (wanted == SCHED_PROFILE_RACE)
+                     ? SCHED_RACE_WIFI_TASK_PRIORITY : SCHED_TUNING_WIFI_TASK_PRIORITY);
+  }
+}
+
+uint8_t schedProfileGet() {
+  return g_schedProfile;
+}
+
+/**
+ * @brief Whether a throttled background service should run on this pass
+ * @param lastServiceMs The caller's own last-run stamp, updated when this returns true
+ * @details Always true in TUNING.
+ */
+bool schedProfilePortalDue(uint32_t* lastServiceMs) {
+  uint32_t now_ms = millis();
+  if (g_schedProfile == SCHED_PROFILE_RACE && (now_ms - *lastServiceMs) < SCHED_RACE_PORTAL_PERIOD_MS) {
+    return false;
+  }
+  *lastServiceMs = now_ms;
+  return true;
+}
+
+/**
+ * @brief Longest Task1 sleep between main screen passes without input
+ */
+uint32_t schedProfileUiWaitMs() {
+  return (g_schedProfile == SCHED_PROFILE_RACE) ? SCHED_RACE_UI_WAIT_MS : TASK1_IDLE_WAIT_MS;
+}
@@ -0,0 +1,40 @@
+#ifndef SCHEDULER_PROFILE_H_
+#define SCHEDULER_PROFILE_H_
+
+#include <Arduino.h>
+#include <stdint.h>
+
+/* Scheduler profile: RACE during a heat, TUNING the rest of the time.
+ * schedProfileService() (Task1, every pass) picks RACE while the state machine is RUNNING
+ * in grid (race) view and no OTA is running, TUNING otherwise. While RACE is active:
+ *   - WiFiTask runs above Task1 (SCHED_RACE_WIFI_TASK_PRIORITY), so the lap engine and the
+ *     telemetry services it hosts are no longer time-sliced with screen redraws
+ *   - the web server, live push and the USB serial command parser are serviced every
+ *     SCHED_RACE_PORTAL_PERIOD_MS instead of on every pass. Clients stay connected but
+ *     get answers more slowly
+ *   - Task1 sleeps up to SCHED_RACE_UI_WAIT_MS between passes without input, so the race
+ *     screen refreshes less often. Input still wakes it at once
+ * Task2 (control) and the trigger sampler already own core 1 at the top app priorities,
+ * so they are the same in both profiles. Switching back to TUNING restores everything.
+ * mDNS is answered by the IDF's own task on request and is left running. */
+#ifndef SCHED_RACE_PORTAL_PERIOD_MS
+#define SCHED_RACE_PORTAL_PERIOD_MS      50U
+#endif
+#ifndef SCHED_RACE_UI_WAIT_MS
+#define SCHED_RACE_UI_WAIT_MS            40U   /* vs TASK1_IDLE_WAIT_MS in TUNING */
+#endif
+#define SCHED_RACE_WIFI_TASK_PRIORITY    2     /* Above Task1 */
+#define SCHED_TUNING_WIFI_TASK_PRIORITY  1     /* Same as Task1, time-sliced */
+
+typedef enum {
+  SCHED_PROFILE_TUNING,
+  SCHED_PROFILE_RACE
+} SchedProfile_enum;
+
+void schedProfileBegin(TaskHandle_t wifiTask);
+void schedProfileService(bool raceView);
+uint8_t schedProfileGet();
+bool schedProfilePortalDue(uint32_t* lastServiceMs);
+uint32_t schedProfileUiWaitMs();
+
+#endif  /* SCHEDULER_PROFILE_H_ */
@@ -3,6 +3,9 @@
 #include <esp_mac.h>
 #include "slot_ESC.h"
 #include "connectivity_portal.h"
+#include "input_events.h"
+#include "buzzer.h"
+#include "oled_screen_cache.h"
 
 extern StoredVar_type g_storedVar;
 extern ESC_type g_escVar;
@@ -116,32 +119,45 @@ void showAboutScreen() {
   setUiEncoderBoundaries(0, maxPage, false);
   resetUiEncoder(0);
 
+  /* Pages are cached by their text, so flipping back and forth or waking from the screensaver is one blit */
   auto drawAbout = [&]() {
-    obdFill(&g_obd, OBD_WHITE, 1);
-    obdWriteString(&g_obd, 0, centerX8x8("About"), 0, (char*)"About", FONT_8x8, OBD_BLACK, 1);
+    uint16_t pageStart = page * ABOUT_VISIBLE_LINES;
+    uint32_t screenKey = oledScreenKeyBegin(OLED_SCREEN_ABOUT);
+    screenKey = oledScreenKeyAdd(screenKey, &page, sizeof(page));
+    screenKey = oledScreenKeyAdd(screenKey, &maxPage, sizeof(maxPage));
+    for (uint16_t idx = pageStart; idx < pageStart + ABOUT_VISIBLE_LINES && idx < lineCount; idx++) {
+      screenKey = oledScreenKeyAddString(screenKey, lines[idx]);
+    }
+    if (oledScreenCacheShow(screenKey)) {
+      return;
+    }
+
+    oledFrameClear();
+    obdWriteString(&g_obd, 0, centerX8x8("About"), 0, (char*)"About", FONT_8x8, OBD_BLACK, OLED_FRAME_RENDER);
 
     if (maxPage > 0) {
       snprintf(line, sizeof(line), "%u/%u", (unsigned int)(page + 1), (unsigned int)(maxPage + 1));
       int sx = OLED_WIDTH - ((int)strlen(line) * 6);
       if (sx < 0) sx = 0;
-      obdWriteString(&g_obd, 0, sx, 0, line, FONT_6x8, OBD_BLACK, 1);
+      obdWriteString(&g_obd, 0, sx, 0, line, FONT_6x8, OBD_BLACK, OLED_FRAME_RENDER);
     }
 
-    uint16_t pageStart = page * ABOUT_VISIBLE_LINES;
     for (uint8_t i = 0; i < ABOUT_VISIBLE_LINES; i++) {
       uint16_t idx = pageStart + i;
       if (idx >= lineCount) break;
-      obdWriteString(&g_obd, 0, 0, (i + 1) * HEIGHT8x8, lines[idx], FONT_6x8, OBD_BLACK, 1);
+      obdWriteString(&g_obd, 0, 0, (i + 1) * HEIGHT8x8, lines[idx], FONT_6x8, OBD_BLACK, OLED_FRAME_RENDER);
     }
+    oledScreenCachePresent(screenKey);
   };
 
   drawAbout();
 
   /* Easter egg */
   delay(400);
-  sound(NOTE_A, 100); delay(80);
-  sound(NOTE_A, 350); delay(80);
-  sound(NOTE_A, 100);
+  static const BuzzerStep_type EASTER_EGG[] = {
+    {NOTE_A, 100}, {BUZZER_REST, 80}, {NOTE_A, 350}, {BUZZER_REST, 80}, {NOTE_A, 100}
+  };
+  buzzerPlay(EASTER_EGG, 5);
 
   bool aboutBtnHeld = false;
   uint32_t lastInteraction = millis();
@@ -167,7 +183,7 @@ void showAboutScreen() {
         if (serviceIdlePowerTransitions(&lastInteraction, &screensaverActive)) {
           drawAbout();
         }
-        delay(10);
+        inputEventsWait(TASK1_IDLE_WAIT_MS);
         continue;
       }
     }
@@ -176,7 +192,7 @@ void showAboutScreen() {
       if (serviceIdlePowerTransitions(&lastInteraction, &screensaverActive)) {
         drawAbout();
       }
-      delay(10);
+      inputEventsWait(TASK1_IDLE_WAIT_MS);
       continue;
     }
 
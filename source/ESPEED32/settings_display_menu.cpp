@@ -4,6 +4,7 @@
 #include "ui_strings.h"
 #include "ui_text_access.h"
 #include "settings_display_submenus.h"
+#include "input_events.h"
 
 extern StoredVar_type g_storedVar;
 extern ESC_type g_escVar;
@@ -82,7 +83,7 @@ void showDisplaySettings() {
         if (serviceIdlePowerTransitions(&lastInteraction, &ssActive)) {
           obdFill(&g_obd, OBD_WHITE, 1);
         }
-        delay(10);
+        inputEventsWait(TASK1_IDLE_WAIT_MS);
         continue;
       }
     }
@@ -91,7 +92,7 @@ void showDisplaySettings() {
       if (serviceIdlePowerTransitions(&lastInteraction, &ssActive)) {
         obdFill(&g_obd, OBD_WHITE, 1);
       }
-      delay(10);
+      inputEventsWait(TASK1_IDLE_WAIT_MS);
       continue;
     }
 
@@ -254,7 +255,7 @@ void showDisplaySettings() {
       if (itemIdx >= DISPLAY_ITEMS_COUNT) break;
 
       bool isSelected = (sel - frameUpper == i && menuState == ITEM_SELECTION);
-      obdWriteString(&g_obd, 0, 0, i * lineHeight, (char*)getDisplayMenuName(lang, itemIdx),
+      obdWriteString(&g_obd, 0, 0, i * lineHeight, (char*)uiText(UI_TEXT_DISPLAY_MENU, lang, itemIdx),
                      menuFont, isSelected ? OBD_WHITE : OBD_BLACK, 1);
 
       if (g_settingsMenu.item[itemIdx].value != ITEM_NO_VALUE) {
@@ -262,16 +263,16 @@ void showDisplaySettings() {
         uint16_t value = *(uint16_t *)(g_settingsMenu.item[itemIdx].value);
 
         if (itemIdx == 0) {  /* VIEW */
-          sprintf(msgStr, "%6s", getViewModeLabel(g_storedVar.language, value));
+          sprintf(msgStr, "%6s", uiText(UI_TEXT_VIEW_MODE, g_storedVar.language, value));
         } else if (itemIdx == 1) {  /* LANG */
           uint16_t dispLang = (isEditingLanguage && isValueSel) ? tempLanguage : value;
           sprintf(msgStr, "%3s", LANG_LABELS[dispLang]);
         } else if (itemIdx == 2) {  /* CASE */
           uint16_t dispTC = (isEditingTextCase && isValueSel) ? tempTextCase : value;
-          sprintf(msgStr, "%6s", TEXT_CASE_LABELS[g_storedVar.language][dispTC]);
+          sprintf(msgStr, "%6s", uiTextUpper(UI_TEXT_TEXT_CASE, g_storedVar.language, dispTC));
         } else if (itemIdx == 3) {  /* FSIZE */
           uint16_t dispFS = (isEditingFontSize && isValueSel) ? tempFontSize : value;
-          sprintf(msgStr, "%5s", FONT_SIZE_LABELS[g_storedVar.language][dispFS]);
+          sprintf(msgStr, "%5s", uiTextUpper(UI_TEXT_FONT_SIZE, g_storedVar.language, dispFS));
         } else if (g_settingsMenu.item[itemIdx].unit[0] != '\0') {
           snprintf(msgStr, sizeof(msgStr), "%2d %s", value, g_settingsMenu.item[itemIdx].unit);
         } else {
@@ -287,6 +288,6 @@ void showDisplaySettings() {
     /* Long press = escape to main for race mode toggle */
     if (checkRaceModeEscape()) { requestEscapeToMain(); break; }
 
-    vTaskDelay(10);
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
   }
 }
@@ -2,6 +2,7 @@
 #include <Arduino.h>
 #include "slot_ESC.h"
 #include "ui_text_access.h"
+#include "input_events.h"
 
 extern StoredVar_type g_storedVar;
 extern ESC_type g_escVar;
@@ -57,7 +58,8 @@ static const uint8_t STATUS_SLOT_SELECTABLE_VALUES[] = {
   STATUS_CAR,
   STATUS_CURRENT,
   STATUS_VOLTAGE,
-  STATUS_ACTIVE_BRAKE
+  STATUS_ACTIVE_BRAKE,
+  STATUS_TEMP
 };
 
 static uint8_t getStatusSlotOptionIndex(uint16_t slotValue) {
@@ -131,7 +133,7 @@ static void editScreensaverText(char* text, const char* title) {
           obdWriteString(&g_obd, 0, (OLED_WIDTH - titleW) / 2, 0, (char *)title, FONT_8x8, OBD_WHITE, 1);
           obdWriteString(&g_obd, 0, OLED_WIDTH - 24, 48, (char *)"OK", FONT_12x16, OBD_BLACK, 1);
         }
-        delay(10);
+        inputEventsWait(TASK1_IDLE_WAIT_MS);
         continue;
       }
     }
@@ -205,7 +207,7 @@ static void editScreensaverText(char* text, const char* title) {
       }
     }
 
-    delay(10);
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
   }
 }
 
@@ -271,7 +273,7 @@ void showScreensaverSettings() {
           obdFill(&g_obd, OBD_WHITE, 1);
           prevSel = 0xFF;  /* Force redraw after waking from power-save */
         }
-        delay(10);
+        inputEventsWait(TASK1_IDLE_WAIT_MS);
         continue;
       }
     }
@@ -281,7 +283,7 @@ void showScreensaverSettings() {
         obdFill(&g_obd, OBD_WHITE, 1);
         prevSel = 0xFF;
       }
-      delay(10);
+      inputEventsWait(TASK1_IDLE_WAIT_MS);
       continue;
     }
 
@@ -330,7 +332,7 @@ void showScreensaverSettings() {
 
         /* Item name */
         char rowLabel[16];
-        const char* rawLabel = (idx == 4) ? getBackLabel(lang) : ssNames[idx];
+        const char* rawLabel = (idx == 4) ? uiText(UI_TEXT_BACK, lang, 0) : ssNames[idx];
         formatConfiguredMenuLabel(rawLabel, rowLabel, sizeof(rowLabel));
         obdWriteString(&g_obd, 0, 0, yPx, rowLabel, FONT_8x8,
                        (isSelected || isEditingThis) ? OBD_WHITE : OBD_BLACK, 1);
@@ -347,7 +349,7 @@ void showScreensaverSettings() {
         } else if (idx == 3) {
           /* TIME: show current timeout, right-justified (4 chars × 6px = 24px from right) */
           if (g_storedVar.screensaverTimeout == 0) {
-            sprintf(msgStr, "%4s", getOnOffLabel(lang, 0));
+            sprintf(msgStr, "%4s", uiText(UI_TEXT_ON_OFF, lang, 0));
           } else {
             sprintf(msgStr, "%3ds", g_storedVar.screensaverTimeout);
           }
@@ -408,7 +410,7 @@ void showScreensaverSettings() {
     /* Long press = escape to main for race mode toggle */
     if (checkRaceModeEscape()) { requestEscapeToMain(); break; }
 
-    vTaskDelay(10);
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
   }
 
   saveEEPROM(g_storedVar);
@@ -502,7 +504,7 @@ void showAntiSpinSettings() {
           obdFill(&g_obd, OBD_WHITE, 1);
           needRedraw = true;
         }
-        delay(10);
+        inputEventsWait(TASK1_IDLE_WAIT_MS);
         continue;
       }
     }
@@ -512,7 +514,7 @@ void showAntiSpinSettings() {
         obdFill(&g_obd, OBD_WHITE, 1);
         needRedraw = true;
       }
-      delay(10);
+      inputEventsWait(TASK1_IDLE_WAIT_MS);
       continue;
     }
 
@@ -632,7 +634,7 @@ void showAntiSpinSettings() {
       }
 
       bool sBack = (!editing && sel == backItem);
-      obdWriteString(&g_obd, 0, 0, backItem * lineH, (char*)getBackLabel(g_storedVar.language), menuFont, sBack ? OBD_WHITE : OBD_BLACK, 1);
+      obdWriteString(&g_obd, 0, 0, backItem * lineH, (char*)uiText(UI_TEXT_BACK, g_storedVar.language, 0), menuFont, sBack ? OBD_WHITE : OBD_BLACK, 1);
 
       if (shownMode == ANTISPIN_UI_MODE_TEXT) {
         snprintf(msgStr, sizeof(msgStr), "%s/%s/%s/%s",
@@ -648,7 +650,7 @@ void showAntiSpinSettings() {
     }
 
     if (checkRaceModeEscape()) { requestEscapeToMain(); break; }
-    vTaskDelay(10);
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
   }
 
   obdFill(&g_obd, OBD_WHITE, 1);
@@ -665,7 +667,7 @@ void showStatusSettings() {
   /* ST_ITEMS: 4 slots + BACK */
   const uint8_t ST_ITEMS = STATUS_SLOTS + 1;
   /* Highest normalized slot id used for labels/lookups; legacy STATUS_CURRENT_MA is normalized away. */
-  const uint8_t ST_SLOT_MAX = STATUS_ACTIVE_BRAKE;
+  const uint8_t ST_SLOT_MAX = STATUS_TEMP;
   const uint8_t ST_SLOT_OPTION_MAX = (uint8_t)((sizeof(STATUS_SLOT_SELECTABLE_VALUES) / sizeof(STATUS_SLOT_SELECTABLE_VALUES[0])) - 1U);
   const uint8_t ST_LABEL_CHARS = 5;
   const uint8_t ST_LABEL_PIXELS = ST_LABEL_CHARS * 6;
@@ -688,15 +690,15 @@ void showStatusSettings() {
 
   /* Content type labels shown right-justified in menu. */
   const char* slotLabelsByLang[9][ST_SLOT_MAX + 1] = {
-    {"---", "OUT%", "GASS", "BIL", "AMPE", "VOLT", "AMPE", "BREMS"},
-    {"---", "OUT%", "THRO", "CAR", "CURR", "VOLT", "CURR", "BRAKE"},
-    {"---", "OUT%", "THRO", "CAR", "CURR", "VOLT", "CURR", "BRAKE"},
-    {"---", "OUT%", "THRO", "CAR", "CURR", "VOLT", "CURR", "BRAKE"},
-    {"---", "OUT%", "GAS", "AUTO", "AMP", "VOLT", "AMP", "FRENO"},
-    {"---", "OUT%", "GAS", "AUTO", "AMP", "VOLT", "AMP", "BREMS"},
-    {"---", "OUT%", "GAS", "AUTO", "AMP", "VOLT", "AMP", "FRENO"},
-    {"---", "OUT%", "GAS", "AUTO", "AMP", "VOLT", "AMP", "REM"},
-    {"---", "OUT%", "GAS", "AUTO", "CORR", "VOLT", "CORR", "FREIO"}
+    {"---", "OUT%", "GASS", "BIL", "AMPE", "VOLT", "AMPE", "BREMS", "TEMP"},
+    {"---", "OUT%", "THRO", "CAR", "CURR", "VOLT", "CURR", "BRAKE", "TEMP"},
+    {"---", "OUT%", "THRO", "CAR", "CURR", "VOLT", "CURR", "BRAKE", "TEMP"},
+    {"---", "OUT%", "THRO", "CAR", "CURR", "VOLT", "CURR", "BRAKE", "TEMP"},
+    {"---", "OUT%", "GAS", "AUTO", "AMP", "VOLT", "AMP", "FRENO", "TEMP"},
+    {"---", "OUT%", "GAS", "AUTO", "AMP", "VOLT", "AMP", "BREMS", "TEMP"},
+    {"---", "OUT%", "GAS", "AUTO", "AMP", "VOLT", "AMP", "FRENO", "TEMP"},
+    {"---", "OUT%", "GAS", "AUTO", "AMP", "VOLT", "AMP", "REM", "TEMP"},
+    {"---", "OUT%", "GAS", "AUTO", "CORR", "VOLT", "CORR", "FREIO", "TEMP"}
   };
   const char** slotLabels = slotLabelsByLang[lang];
 
@@ -737,7 +739,7 @@ void showStatusSettings() {
           prevSel     = 0xFF;
           forceRedraw = true;
         }
-        delay(10);
+        inputEventsWait(TASK1_IDLE_WAIT_MS);
         continue;
       }
     }
@@ -845,7 +847,7 @@ void showStatusSettings() {
     /* Long press = escape to main for race mode toggle */
     if (checkRaceModeEscape()) { requestEscapeToMain(); break; }
 
-    vTaskDelay(10);
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
   }
 
   saveEEPROM(g_storedVar);
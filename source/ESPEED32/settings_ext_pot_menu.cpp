@@ -4,6 +4,7 @@
 #include "ui_text_access.h"
 #include "connectivity_portal.h"
 #include "ext_pot.h"
+#include "input_events.h"
 
 extern StoredVar_type g_storedVar;
 extern ESC_type g_escVar;
@@ -22,11 +23,11 @@ extern void saveEEPROM(StoredVar_type toSave);
 static const char* getExtPotTargetLabel(uint8_t lang, uint16_t target) {
   switch (target) {
     case EXT_POT_TARGET_BRAKE:
-      return getRaceLabel(lang, 0);
+      return uiText(UI_TEXT_RACE, lang, 0);
     case EXT_POT_TARGET_SENSI:
-      return getRaceLabel(lang, 1);
+      return uiText(UI_TEXT_RACE, lang, 1);
     default:
-      return getOnOffLabel(lang, 0);
+      return uiText(UI_TEXT_ON_OFF, lang, 0);
   }
 }
 
@@ -124,7 +125,7 @@ void showExtPotSettings() {
           obdFill(&g_obd, OBD_WHITE, 1);
           needRedraw = true;
         }
-        delay(10);
+        inputEventsWait(TASK1_IDLE_WAIT_MS);
         continue;
       }
     }
@@ -134,7 +135,7 @@ void showExtPotSettings() {
         obdFill(&g_obd, OBD_WHITE, 1);
         needRedraw = true;
       }
-      delay(10);
+      inputEventsWait(TASK1_IDLE_WAIT_MS);
       continue;
     }
 
@@ -179,7 +180,7 @@ void showExtPotSettings() {
       uint8_t lang = g_storedVar.language;
       for (uint8_t i = 0; i < NUM_ITEMS; i++) {
         bool isSelected = (sel == i);
-        const char* label = (i == ITEM_BACK) ? getBackLabel(lang) : getExtPotItemLabel(lang, i);
+        const char* label = (i == ITEM_BACK) ? uiText(UI_TEXT_BACK, lang, 0) : getExtPotItemLabel(lang, i);
         obdWriteString(&g_obd, 0, 0, i * lineH, (char*)label,
                        menuFont, isSelected ? OBD_WHITE : OBD_BLACK, 1);
 
@@ -190,7 +191,7 @@ void showExtPotSettings() {
       }
     }
 
-    vTaskDelay(10);
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
   }
 
   obdFill(&g_obd, OBD_WHITE, 1);
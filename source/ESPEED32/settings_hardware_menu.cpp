@@ -5,6 +5,10 @@
 #include "HAL.h"
 #include "settings_ext_pot_menu.h"
 #include "diagnostics_self_test.h"
+#include "diagnostics_task_monitor.h"
+#include "diagnostics_motor_sweep.h"
+#include "diagnostics_latency_bench.h"
+#include "input_events.h"
 
 extern StoredVar_type g_storedVar;
 extern uint16_t g_encoderInvertEnabled;
@@ -23,27 +27,27 @@ extern void showScreensaver();
 extern void saveEEPROM(StoredVar_type toSave);
 
 static const char* HARDWARE_MENU_LABELS[9][HARDWARE_ITEMS_COUNT] = {
-  {"ENC.INVERT", "EKST.POT.", "TRIGGER", "TEST", "TILBAKE"},
-  {"ENC.INVERT", "EXT.POT.", "TRIGGER", "TEST", "BACK"},
-  {"ENC.INVERT", "EXT.POT.", "TRIGGER", "TEST", "BACK"},
-  {"ENC.INVERT", "EXT.POT.", "TRIGGER", "TEST", "BACK"},
-  {"ENC.INVERT", "POT.EXT.", "TRIGGER", "TEST", "ATRAS"},
-  {"ENC.INVERT", "EXT.POT.", "TRIGGER", "TEST", "ZURUCK"},
-  {"ENC.INVERT", "POT.EST.", "TRIGGER", "TEST", "INDIETRO"},
-  {"ENC.INVERT", "EXT.POT.", "TRIGGER", "TEST", "TERUG"},
-  {"ENC.INVERT", "POT.EXT.", "TRIGGER", "TESTE", "VOLTAR"}
+  {"ENC.INVERT", "EKST.POT.", "TRIGGER", "TEST", "BENCH", "MOTOR", "SYS.MON", "TILBAKE"},
+  {"ENC.INVERT", "EXT.POT.", "TRIGGER", "TEST", "BENCH", "MOTOR", "SYS.MON", "BACK"},
+  {"ENC.INVERT", "EXT.POT.", "TRIGGER", "TEST", "BENCH", "MOTOR", "SYS.MON", "BACK"},
+  {"ENC.INVERT", "EXT.POT.", "TRIGGER", "TEST", "BENCH", "MOTOR", "SYS.MON", "BACK"},
+  {"ENC.INVERT", "POT.EXT.", "TRIGGER", "TEST", "BENCH", "MOTOR", "SYS.MON", "ATRAS"},
+  {"ENC.INVERT", "EXT.POT.", "TRIGGER", "TEST", "BENCH", "MOTOR", "SYS.MON", "ZURUCK"},
+  {"ENC.INVERT", "POT.EST.", "TRIGGER", "TEST", "BENCH", "MOTOR", "SYS.MON", "INDIETRO"},
+  {"ENC.INVERT", "EXT.POT.", "TRIGGER", "TEST", "BENCH", "MOTOR", "SYS.MON", "TERUG"},
+  {"ENC.INVERT", "POT.EXT.", "TRIGGER", "TESTE", "BENCH", "MOTOR", "SYS.MON", "VOLTAR"}
 };
 
 static const char* HARDWARE_MENU_LABELS_PASCAL[9][HARDWARE_ITEMS_COUNT] = {
-  {"Enc.Invert", "Ekst.Pot.", "Trigger", "Test", "Tilbake"},
-  {"Enc.Invert", "Ext.Pot.", "Trigger", "Test", "Back"},
-  {"Enc.Invert", "Ext.Pot.", "Trigger", "Test", "Back"},
-  {"Enc.Invert", "Ext.Pot.", "Trigger", "Test", "Back"},
-  {"Enc.Invert", "Pot.Ext.", "Trigger", "Test", "Atras"},
-  {"Enc.Invert", "Ext.Pot.", "Trigger", "Test", "Zuruck"},
-  {"Enc.Invert", "Pot.Est.", "Trigger", "Test", "Indietro"},
-  {"Enc.Invert", "Ext.Pot.", "Trigger", "Test", "Terug"},
-  {"Enc.Invert", "Pot.Ext.", "Trigger", "Teste", "Voltar"}
+  {"Enc.Invert", "Ekst.Pot.", "Trigger", "Test", "Bench", "Motor", "Sys.Mon", "Tilbake"},
+  {"Enc.Invert", "Ext.Pot.", "Trigger", "Test", "Bench", "Motor", "Sys.Mon", "Back"},
+  {"Enc.Invert", "Ext.Pot.", "Trigger", "Test", "Bench", "Motor", "Sys.Mon", "Back"},
+  {"Enc.Invert", "Ext.Pot.", "Trigger", "Test", "Bench", "Motor", "Sys.Mon", "Back"},
+  {"Enc.Invert", "Pot.Ext.", "Trigger", "Test", "Bench", "Motor", "Sys.Mon", "Atras"},
+  {"Enc.Invert", "Ext.Pot.", "Trigger", "Test", "Bench", "Motor", "Sys.Mon", "Zuruck"},
+  {"Enc.Invert", "Pot.Est.", "Trigger", "Test", "Bench", "Motor", "Sys.Mon", "Indietro"},
+  {"Enc.Invert", "Ext.Pot.", "Trigger", "Test", "Bench", "Motor", "Sys.Mon", "Terug"},
+  {"Enc.Invert", "Pot.Ext.", "Trigger", "Teste", "Bench", "Motor", "Sys.Mon", "Voltar"}
 };
 
 static const char* SENSOR_MENU_LABELS[9][4] = {
@@ -193,7 +197,7 @@ static void showTriggerSensorSettings() {
           obdFill(&g_obd, OBD_WHITE, 1);
           needRedraw = true;
         }
-        delay(10);
+        inputEventsWait(TASK1_IDLE_WAIT_MS);
         continue;
       }
     }
@@ -203,7 +207,7 @@ static void showTriggerSensorSettings() {
         obdFill(&g_obd, OBD_WHITE, 1);
         needRedraw = true;
       }
-      delay(10);
+      inputEventsWait(TASK1_IDLE_WAIT_MS);
       continue;
     }
 
@@ -255,7 +259,7 @@ static void showTriggerSensorSettings() {
       for (uint8_t i = 0; i < numItems; i++) {
         bool isSelected = (sel == i);
         const char* label = (i == itemBack)
-          ? getBackLabel(lang)
+          ? uiText(UI_TEXT_BACK, lang, 0)
           : getSensorMenuLabel(lang, i);
         obdWriteString(&g_obd, 0, 0, i * lineH, (char*)label,
                        menuFont, isSelected ? OBD_WHITE : OBD_BLACK, 1);
@@ -271,7 +275,7 @@ static void showTriggerSensorSettings() {
       }
     }
 
-    vTaskDelay(10);
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
   }
 
   obdFill(&g_obd, OBD_WHITE, 1);
@@ -284,7 +288,10 @@ void showHardwareSettings() {
   const uint8_t itemExtPot = 1;
   const uint8_t itemTrigger = 2;
   const uint8_t itemTest = 3;
-  const uint8_t itemBack = 4;
+  const uint8_t itemBench = 4;
+  const uint8_t itemMotor = 5;
+  const uint8_t itemSysMon = 6;
+  const uint8_t itemBack = 7;
 
   obdFill(&g_obd, OBD_WHITE, 1);
   g_rotaryEncoder.setAcceleration(MENU_ACCELERATION);
@@ -329,7 +336,7 @@ void showHardwareSettings() {
           obdFill(&g_obd, OBD_WHITE, 1);
           needRedraw = true;
         }
-        delay(10);
+        inputEventsWait(TASK1_IDLE_WAIT_MS);
         continue;
       }
     }
@@ -339,7 +346,7 @@ void showHardwareSettings() {
         obdFill(&g_obd, OBD_WHITE, 1);
         needRedraw = true;
       }
-      delay(10);
+      inputEventsWait(TASK1_IDLE_WAIT_MS);
       continue;
     }
 
@@ -372,6 +379,18 @@ void showHardwareSettings() {
         if (isEscapeToMainRequested()) break;
         resumeAfterChild();
         continue;
+      } else if (sel == itemBench) {
+        showLatencyBench();
+        resumeAfterChild();
+        continue;
+      } else if (sel == itemMotor) {
+        showMotorSweep();
+        resumeAfterChild();
+        continue;
+      } else if (sel == itemSysMon) {
+        showTaskMonitor();
+        resumeAfterChild();
+        continue;
       }
       delay(200);
     }
@@ -400,14 +419,14 @@ void showHardwareSettings() {
       for (uint8_t i = 0; i < HARDWARE_ITEMS_COUNT; i++) {
         bool isSelected = (sel == i);
         const char* label = (i == itemBack)
-          ? getBackLabel(lang)
+          ? uiText(UI_TEXT_BACK, lang, 0)
           : getHardwareMenuLabel(lang, i);
         obdWriteString(&g_obd, 0, 0, i * lineH, (char*)label,
                        menuFont, isSelected ? OBD_WHITE : OBD_BLACK, 1);
 
         const char* value = nullptr;
         if (i == itemEncInv) {
-          value = getOnOffLabel(lang, g_encoderInvertEnabled ? 1 : 0);
+          value = uiText(UI_TEXT_ON_OFF, lang, g_encoderInvertEnabled ? 1 : 0);
         } else if (i == itemTrigger) {
           value = familyBuf;
         }
@@ -418,7 +437,7 @@ void showHardwareSettings() {
       }
     }
 
-    vTaskDelay(10);
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
   }
 
   obdFill(&g_obd, OBD_WHITE, 1);
@@ -2,6 +2,7 @@
 #include <Arduino.h>
 #include "slot_ESC.h"
 #include "ui_text_access.h"
+#include "input_events.h"
 
 extern StoredVar_type g_storedVar;
 extern ESC_type g_escVar;
@@ -71,7 +72,7 @@ void showLockSettings() {
           obdFill(&g_obd, OBD_WHITE, 1);
           needRedraw = true;
         }
-        delay(10);
+        inputEventsWait(TASK1_IDLE_WAIT_MS);
         continue;
       }
     }
@@ -81,7 +82,7 @@ void showLockSettings() {
         obdFill(&g_obd, OBD_WHITE, 1);
         needRedraw = true;
       }
-      delay(10);
+      inputEventsWait(TASK1_IDLE_WAIT_MS);
       continue;
     }
 
@@ -157,39 +158,39 @@ void showLockSettings() {
 
       /* Row 0: MENU ITEM — on/off */
       bool s0 = (!editingShortcut && sel == ITEM_MENU);
-      obdWriteString(&g_obd, 0, 0, 0 * lineH, (char*)getLockMenuName(lang, ITEM_MENU),
+      obdWriteString(&g_obd, 0, 0, 0 * lineH, (char*)uiText(UI_TEXT_LOCK_MENU, lang, ITEM_MENU),
                      menuFont, s0 ? OBD_WHITE : OBD_BLACK, 1);
-      sprintf(msgStr, "%3s", getOnOffLabel(lang, g_storedVar.lockMenuEnabled ? 1 : 0));
+      sprintf(msgStr, "%3s", uiText(UI_TEXT_ON_OFF, lang, g_storedVar.lockMenuEnabled ? 1 : 0));
       uint8_t vx = OLED_WIDTH - (uint8_t)(strlen(msgStr) * WIDTH8x8);
       obdWriteString(&g_obd, 0, vx, 0 * lineH, msgStr,
                      menuFont, s0 ? OBD_WHITE : OBD_BLACK, 1);
 
       /* Row 1: SHORTCUT — OFF / 1s–10s (index = seconds) */
       bool s1 = (!editingShortcut && sel == ITEM_SHORT);
-      obdWriteString(&g_obd, 0, 0, 1 * lineH, (char*)getLockMenuName(lang, ITEM_SHORT),
+      obdWriteString(&g_obd, 0, 0, 1 * lineH, (char*)uiText(UI_TEXT_LOCK_MENU, lang, ITEM_SHORT),
                      menuFont, (s1 || editingShortcut) ? OBD_WHITE : OBD_BLACK, 1);
       uint8_t shownIdx = editingShortcut ? tmpShortcutIdx : (uint8_t)g_storedVar.lockShortcutIdx;
-      sprintf(msgStr, "%4s", getLockShortcutLabel(lang, shownIdx));
+      sprintf(msgStr, "%4s", uiText(UI_TEXT_LOCK_SHORTCUT, lang, shownIdx));
       uint8_t sx = OLED_WIDTH - (uint8_t)(strlen(msgStr) * WIDTH8x8);
       obdWriteString(&g_obd, 0, sx, 1 * lineH, msgStr,
                      menuFont, (s1 || editingShortcut) ? OBD_WHITE : OBD_BLACK, 1);
 
       /* Row 2: CONFIRM — on/off */
       bool s2 = (!editingShortcut && sel == ITEM_CONFIRM);
-      obdWriteString(&g_obd, 0, 0, 2 * lineH, (char*)getLockMenuName(lang, ITEM_CONFIRM),
+      obdWriteString(&g_obd, 0, 0, 2 * lineH, (char*)uiText(UI_TEXT_LOCK_MENU, lang, ITEM_CONFIRM),
                      menuFont, s2 ? OBD_WHITE : OBD_BLACK, 1);
-      sprintf(msgStr, "%3s", getOnOffLabel(lang, g_storedVar.lockConfirmEnabled ? 1 : 0));
+      sprintf(msgStr, "%3s", uiText(UI_TEXT_ON_OFF, lang, g_storedVar.lockConfirmEnabled ? 1 : 0));
       uint8_t cx = OLED_WIDTH - (uint8_t)(strlen(msgStr) * WIDTH8x8);
       obdWriteString(&g_obd, 0, cx, 2 * lineH, msgStr,
                      menuFont, s2 ? OBD_WHITE : OBD_BLACK, 1);
 
       /* Row 3: BACK */
       bool s3 = (!editingShortcut && sel == ITEM_BACK);
-      obdWriteString(&g_obd, 0, 0, 3 * lineH, (char*)getBackLabel(lang),
+      obdWriteString(&g_obd, 0, 0, 3 * lineH, (char*)uiText(UI_TEXT_BACK, lang, 0),
                      menuFont, s3 ? OBD_WHITE : OBD_BLACK, 1);
     }
 
-    vTaskDelay(10);
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
   }
 
   obdFill(&g_obd, OBD_WHITE, 1);
@@ -11,6 +11,7 @@
 #include "settings_reset_menu.h"
 #include "settings_about_screen.h"
 #include "ui_render.h"
+#include "input_events.h"
 
 extern StoredVar_type g_storedVar;
 extern uint16_t g_antiSpinStepMs;
@@ -90,7 +91,7 @@ void showSettingsMenu() {
         if (serviceIdlePowerTransitions(&lastSettingsInteraction, &settingsScreensaverActive)) {
           obdFill(&g_obd, OBD_WHITE, 1);
         }
-        delay(10);
+        inputEventsWait(TASK1_IDLE_WAIT_MS);
         continue;
       }
     }
@@ -260,7 +261,7 @@ void showSettingsMenu() {
         bool isValueSelected = (settingsSelector - frameUpper == i && settingsMenuState == VALUE_SELECTION);
         uint16_t value = *(uint16_t *)(g_settingsMenu.item[itemIndex].value);
         if (g_settingsMenu.item[itemIndex].type == VALUE_TYPE_STRING) {
-          snprintf(msgStr, sizeof(msgStr), "%3s", getOnOffLabel(g_storedVar.language, value ? 1 : 0));
+          snprintf(msgStr, sizeof(msgStr), "%3s", uiText(UI_TEXT_ON_OFF, g_storedVar.language, value ? 1 : 0));
         } else if (g_settingsMenu.item[itemIndex].unit[0] != '\0') {
           snprintf(msgStr, sizeof(msgStr), "%2d%s", value, g_settingsMenu.item[itemIndex].unit);
         } else {
@@ -272,7 +273,7 @@ void showSettingsMenu() {
       }
     }
 
-    vTaskDelay(10);
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
   }
 
   setInSettingsMenu(false);
@@ -4,6 +4,7 @@
 #include "ui_text_access.h"
 #include "settings_display_submenus.h"
 #include "settings_power_sleep_submenus.h"
+#include "input_events.h"
 
 extern StoredVar_type g_storedVar;
 extern ESC_type g_escVar;
@@ -83,7 +84,7 @@ static void showVinCalibrationScreen() {
         obdFill(&g_obd, OBD_WHITE, 1);
         needRedraw = true;
       }
-      delay(10);
+      inputEventsWait(TASK1_IDLE_WAIT_MS);
       continue;
     }
 
@@ -132,7 +133,7 @@ static void showVinCalibrationScreen() {
     if (needRedraw) {
       char voltageStr[12];
       char lineBuf[17];
-      const char* title = getPowerMenuName(lang, 4);
+      const char* title = uiText(UI_TEXT_POWER_MENU, lang, 4);
 
       obdFill(&g_obd, OBD_WHITE, 1);
 
@@ -159,7 +160,7 @@ static void showVinCalibrationScreen() {
 
     if (checkRaceModeEscape()) { requestEscapeToMain(); break; }
 
-    vTaskDelay(10);
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
   }
 }
 
@@ -220,7 +221,7 @@ void showPowerSettings() {
           obdFill(&g_obd, OBD_WHITE, 1);
           needRedraw = true;
         }
-        delay(10);
+        inputEventsWait(TASK1_IDLE_WAIT_MS);
         continue;
       }
     }
@@ -230,7 +231,7 @@ void showPowerSettings() {
         obdFill(&g_obd, OBD_WHITE, 1);
         needRedraw = true;
       }
-      delay(10);
+      inputEventsWait(TASK1_IDLE_WAIT_MS);
       continue;
     }
 
@@ -315,13 +316,13 @@ void showPowerSettings() {
       obdFill(&g_obd, OBD_WHITE, 1);
       for (uint8_t i = 0; i < NUM; i++) {
         bool isHighlighted = editing ? (i == 3) : (sel == i);
-        obdWriteString(&g_obd, 0, 0, i * lineH, (char*)getPowerMenuName(lang, i),
+        obdWriteString(&g_obd, 0, 0, i * lineH, (char*)uiText(UI_TEXT_POWER_MENU, lang, i),
                        menuFont, isHighlighted ? OBD_WHITE : OBD_BLACK, 1);
         /* Show startup delay value on the right for item 3 */
         if (i == 3) {
           char valStr[7];
           uint16_t disp = editing ? tmpDelay : g_storedVar.startupDelay;
-          if (disp == 0) snprintf(valStr, sizeof(valStr), "   %s", getOnOffLabel(lang, 0));
+          if (disp == 0) snprintf(valStr, sizeof(valStr), "   %s", uiText(UI_TEXT_ON_OFF, lang, 0));
           else           snprintf(valStr, sizeof(valStr), "%3dms", disp * 10);
           uint8_t vx = OLED_WIDTH - (uint8_t)(strlen(valStr) * WIDTH8x8);
           obdWriteString(&g_obd, 0, vx, i * lineH, valStr, menuFont,
@@ -334,6 +335,6 @@ void showPowerSettings() {
     /* Long press = escape to main for race mode toggle */
     if (checkRaceModeEscape()) { requestEscapeToMain(); break; }
 
-    vTaskDelay(10);
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
   }
 }
@@ -2,6 +2,7 @@
 #include <Arduino.h>
 #include "slot_ESC.h"
 #include "ui_text_access.h"
+#include "input_events.h"
 
 extern StoredVar_type g_storedVar;
 extern ESC_type g_escVar;
@@ -98,7 +99,7 @@ void showSleepSettings() {
           obdFill(&g_obd, OBD_WHITE, 1);
           needRedraw = true;
         }
-        delay(10);
+        inputEventsWait(TASK1_IDLE_WAIT_MS);
         continue;
       }
     }
@@ -108,7 +109,7 @@ void showSleepSettings() {
         obdFill(&g_obd, OBD_WHITE, 1);
         needRedraw = true;
       }
-      delay(10);
+      inputEventsWait(TASK1_IDLE_WAIT_MS);
       continue;
     }
 
@@ -186,14 +187,14 @@ void showSleepSettings() {
       obdWriteString(&g_obd, 0, 0, lineH, rowLabel, menuFont, s1 ? OBD_WHITE : OBD_BLACK, 1);
       char valStr[8];
       uint16_t disp = editing ? tmpTimeout : g_storedVar.powerSaveTimeout;
-      if (disp == 0) snprintf(valStr, sizeof(valStr), "  %s", getOnOffLabel(lang, 0));
+      if (disp == 0) snprintf(valStr, sizeof(valStr), "  %s", uiText(UI_TEXT_ON_OFF, lang, 0));
       else           snprintf(valStr, sizeof(valStr), "%2dmin", disp);
       uint8_t vx = OLED_WIDTH - (uint8_t)(strlen(valStr) * charWidth);
       obdWriteString(&g_obd, 0, vx, lineH, valStr, menuFont, (s1 || editing) ? OBD_WHITE : OBD_BLACK, 1);
 
       /* Row 2: BACK */
       bool s2 = (!editing && sel == ITEM_BACK);
-      obdWriteString(&g_obd, 0, 0, 2 * lineH, (char*)getBackLabel(lang), menuFont, s2 ? OBD_WHITE : OBD_BLACK, 1);
+      obdWriteString(&g_obd, 0, 0, 2 * lineH, (char*)uiText(UI_TEXT_BACK, lang, 0), menuFont, s2 ? OBD_WHITE : OBD_BLACK, 1);
 
       needRedraw = false;
     }
@@ -201,7 +202,7 @@ void showSleepSettings() {
     /* Long press = escape to main for race mode toggle */
     if (checkRaceModeEscape()) { requestEscapeToMain(); break; }
 
-    vTaskDelay(10);
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
   }
 }
 
@@ -253,7 +254,7 @@ void showDeepSleepSettings() {
           obdFill(&g_obd, OBD_WHITE, 1);
           needRedraw = true;
         }
-        delay(10);
+        inputEventsWait(TASK1_IDLE_WAIT_MS);
         continue;
       }
     }
@@ -263,7 +264,7 @@ void showDeepSleepSettings() {
         obdFill(&g_obd, OBD_WHITE, 1);
         needRedraw = true;
       }
-      delay(10);
+      inputEventsWait(TASK1_IDLE_WAIT_MS);
       continue;
     }
 
@@ -333,14 +334,14 @@ void showDeepSleepSettings() {
       obdWriteString(&g_obd, 0, 0, HEIGHT8x8, rowLabel, FONT_8x8, s1 ? OBD_WHITE : OBD_BLACK, 1);
       char valStr[8];
       uint16_t disp = editing ? tmpTimeout : g_storedVar.deepSleepTimeout;
-      if (disp == 0) snprintf(valStr, sizeof(valStr), "  %s", getOnOffLabel(lang, 0));
+      if (disp == 0) snprintf(valStr, sizeof(valStr), "  %s", uiText(UI_TEXT_ON_OFF, lang, 0));
       else           snprintf(valStr, sizeof(valStr), "%2dmin", disp);
       uint8_t vx = OLED_WIDTH - (uint8_t)(strlen(valStr) * WIDTH8x8);
       obdWriteString(&g_obd, 0, vx, HEIGHT8x8, valStr, FONT_8x8, (s1 || editing) ? OBD_WHITE : OBD_BLACK, 1);
 
       /* Row 2: BACK */
       bool s2 = (!editing && sel == ITEM_BACK);
-      obdWriteString(&g_obd, 0, 0, 2 * HEIGHT8x8, (char*)getBackLabel(lang), FONT_8x8, s2 ? OBD_WHITE : OBD_BLACK, 1);
+      obdWriteString(&g_obd, 0, 0, 2 * HEIGHT8x8, (char*)uiText(UI_TEXT_BACK, lang, 0), FONT_8x8, s2 ? OBD_WHITE : OBD_BLACK, 1);
 
       needRedraw = false;
     }
@@ -348,6 +349,6 @@ void showDeepSleepSettings() {
     /* Long press = escape to main for race mode toggle */
     if (checkRaceModeEscape()) { requestEscapeToMain(); break; }
 
-    vTaskDelay(10);
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
   }
 }
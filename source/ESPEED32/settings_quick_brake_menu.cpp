@@ -2,6 +2,7 @@
 #include <Arduino.h>
 #include "slot_ESC.h"
 #include "ui_text_access.h"
+#include "input_events.h"
 
 extern StoredVar_type g_storedVar;
 extern ESC_type g_escVar;
@@ -24,17 +25,22 @@ enum AdvancedBrakeRowType : uint8_t {
   AB_ROW_MODE = 1,
   AB_ROW_ZONE = 2,
   AB_ROW_LEVEL = 3,
-  AB_ROW_BACK = 4
+  AB_ROW_BITE = 4,
+  AB_ROW_HOLD = 5,
+  AB_ROW_RAMP = 6,
+  AB_ROW_BACK = 7
 };
 
-static uint8_t getAdvancedBrakeMenuItemCount(uint16_t mode) {
+/* Rows shown by the release-brake mode before the brake envelope rows */
+static uint8_t getReleaseBrakeRowCount(uint16_t mode) {
   if (mode == RELEASE_BRAKE_OFF) {
-    return 3;
-  }
-  if (mode == RELEASE_BRAKE_DRAG) {
-    return 4;
+    return 0;
   }
-  return 5;
+  return (mode == RELEASE_BRAKE_DRAG) ? 1 : 2;
+}
+
+static uint8_t getAdvancedBrakeMenuItemCount(uint16_t mode) {
+  return 2 + getReleaseBrakeRowCount(mode) + 4;   /* Button, mode, release rows, bite/hold/ramp, BACK */
 }
 
 static AdvancedBrakeRowType getAdvancedBrakeRowType(uint16_t mode, uint8_t visibleIndex) {
@@ -44,19 +50,35 @@ static AdvancedBrakeRowType getAdvancedBrakeRowType(uint16_t mode, uint8_t visib
   if (visibleIndex == 2) {
     return AB_ROW_MODE;
   }
-  if (mode == RELEASE_BRAKE_OFF) {
-    return AB_ROW_BACK;
-  }
-  if (mode == RELEASE_BRAKE_DRAG) {
-    return (visibleIndex == 3) ? AB_ROW_LEVEL : AB_ROW_BACK;
+  uint8_t releaseRows = getReleaseBrakeRowCount(mode);
+  if (visibleIndex <= 2 + releaseRows) {
+    return (mode == RELEASE_BRAKE_QUICK && visibleIndex == 3) ? AB_ROW_ZONE : AB_ROW_LEVEL;
   }
-  if (visibleIndex == 3) {
-    return AB_ROW_ZONE;
+  switch (visibleIndex - 2 - releaseRows) {
+    case 1:  return AB_ROW_BITE;
+    case 2:  return AB_ROW_HOLD;
+    case 3:  return AB_ROW_RAMP;
+    default: return AB_ROW_BACK;
   }
-  if (visibleIndex == 4) {
-    return AB_ROW_LEVEL;
+}
+
+/* Hold and ramp are edited in BRAKE_ENVELOPE_MS_STEP steps */
+static uint16_t getAdvancedBrakeEditStep(AdvancedBrakeRowType rowType) {
+  return (rowType == AB_ROW_HOLD || rowType == AB_ROW_RAMP) ? BRAKE_ENVELOPE_MS_STEP : 1;
+}
+
+static uint16_t* getAdvancedBrakeValue(AdvancedBrakeRowType rowType) {
+  CarParam_type& car = g_storedVar.activeCar;
+  switch (rowType) {
+    case AB_ROW_BUTTON: return &car.brakeButtonReduction;
+    case AB_ROW_MODE:   return &car.quickBrakeEnabled;
+    case AB_ROW_ZONE:   return &car.quickBrakeThreshold;
+    case AB_ROW_LEVEL:  return &car.quickBrakeStrength;
+    case AB_ROW_BITE:   return &car.brakeBite;
+    case AB_ROW_HOLD:   return &car.brakeBiteHold;
+    case AB_ROW_RAMP:   return &car.brakeRamp;
+    default:            return nullptr;
   }
-  return AB_ROW_BACK;
 }
 
 static const char* getAdvancedBrakeRowLabel(uint8_t lang, uint16_t mode, AdvancedBrakeRowType rowType) {
@@ -65,6 +87,9 @@ static const char* getAdvancedBrakeRowLabel(uint8_t lang, uint16_t mode, Advance
   static const char* ZONE_LABELS[9]   = {"Sone", "Zone", "Zone", "Zone", "Zona", "Zone", "Zona", "Zone", "Zona"};
   static const char* QUICK_LABELS[9]  = {"Quick", "Quick", "Quick", "Quick", "Quick", "Quick", "Quick", "Quick", "Quick"};
   static const char* DRAG_LABELS[9]   = {"Drag", "Drag", "Drag", "Drag", "Drag", "Drag", "Drag", "Drag", "Drag"};
+  static const char* BITE_LABELS[9]   = {"Bite", "Bite", "Bite", "Bite", "Bite", "Bite", "Bite", "Bite", "Bite"};
+  static const char* HOLD_LABELS[9]   = {"Hold", "Hold", "Hold", "Hold", "Hold", "Hold", "Hold", "Hold", "Hold"};
+  static const char* RAMP_LABELS[9]   = {"Ramp", "Ramp", "Ramp", "Ramp", "Ramp", "Ramp", "Ramp", "Ramp", "Ramp"};
 
   switch (rowType) {
     case AB_ROW_BUTTON:
@@ -75,9 +100,15 @@ static const char* getAdvancedBrakeRowLabel(uint8_t lang, uint16_t mode, Advance
       return ZONE_LABELS[lang];
     case AB_ROW_LEVEL:
       return (mode == RELEASE_BRAKE_DRAG) ? DRAG_LABELS[lang] : QUICK_LABELS[lang];
+    case AB_ROW_BITE:
+      return BITE_LABELS[lang];
+    case AB_ROW_HOLD:
+      return HOLD_LABELS[lang];
+    case AB_ROW_RAMP:
+      return RAMP_LABELS[lang];
     case AB_ROW_BACK:
     default:
-      return getBackLabel(lang);
+      return uiText(UI_TEXT_BACK, lang, 0);
   }
 }
 
@@ -103,16 +134,18 @@ static const char* getReleaseBrakeMenuModeValue(uint8_t lang, uint16_t mode) {
 /**
  * Advanced Brake submenu.
  * Opened by clicking BRAKE+ in the main menu.
- * Items: Alt.Brake, Rel.Brake mode, optional QUICK zone + level, DRAG level, BACK.
+ * Items: Alt.Brake, Rel.Brake mode, optional QUICK zone + level, DRAG level,
+ * brake envelope Bite/Hold/Ramp, BACK.
  * QUICK cuts output to brake inside the configured zone. DRAG keeps output active
  * and blends in drag while the trigger is moving toward release, with no zone.
+ * The envelope shapes the brake at full release (see brake_envelope.h).
  */
 void showAdvancedBrakeMenu() {
   uint8_t lang = g_storedVar.language;
 
   obdFill(&g_obd, OBD_WHITE, 1);
   g_rotaryEncoder.setAcceleration(MENU_ACCELERATION);
-  setUiEncoderBoundaries(1, getAdvancedBrakeMenuItemCount(g_storedVar.carParam[g_carSel].quickBrakeEnabled), false);
+  setUiEncoderBoundaries(1, getAdvancedBrakeMenuItemCount(g_storedVar.activeCar.quickBrakeEnabled), false);
   resetUiEncoder(1);
 
   uint8_t sel          = 1;
@@ -130,7 +163,7 @@ void showAdvancedBrakeMenu() {
   static uint32_t lastBrakeQB = 0;
 
   auto currentMode = [&]() -> uint16_t {
-    return g_storedVar.carParam[g_carSel].quickBrakeEnabled;
+    return g_storedVar.activeCar.quickBrakeEnabled;
   };
 
   auto refreshSelectionBounds = [&]() {
@@ -164,7 +197,7 @@ void showAdvancedBrakeMenu() {
           prevSel     = 0xFF;
           forceRedraw = true;
         }
-        delay(10);
+        inputEventsWait(TASK1_IDLE_WAIT_MS);
         continue;
       }
     }
@@ -176,10 +209,8 @@ void showAdvancedBrakeMenu() {
         lastBrakeQB = millis();
         if (state == VALUE_SELECTION) {
           /* Cancel: restore original value */
-          if (editRowType == AB_ROW_BUTTON) g_storedVar.carParam[g_carSel].brakeButtonReduction = origValue;
-          else if (editRowType == AB_ROW_MODE) g_storedVar.carParam[g_carSel].quickBrakeEnabled = origValue;
-          else if (editRowType == AB_ROW_ZONE) g_storedVar.carParam[g_carSel].quickBrakeThreshold = origValue;
-          else if (editRowType == AB_ROW_LEVEL) g_storedVar.carParam[g_carSel].quickBrakeStrength = origValue;
+          uint16_t* value = getAdvancedBrakeValue(editRowType);
+          if (value != nullptr) *value = origValue;
           state = ITEM_SELECTION;
           g_rotaryEncoder.setAcceleration(MENU_ACCELERATION);
           refreshSelectionBounds();
@@ -204,10 +235,8 @@ void showAdvancedBrakeMenu() {
         forceRedraw = true;
       } else {
         /* Live update while editing */
-        if (editRowType == AB_ROW_BUTTON) g_storedVar.carParam[g_carSel].brakeButtonReduction = ep;
-        else if (editRowType == AB_ROW_MODE) g_storedVar.carParam[g_carSel].quickBrakeEnabled = ep;
-        else if (editRowType == AB_ROW_ZONE) g_storedVar.carParam[g_carSel].quickBrakeThreshold = ep;
-        else if (editRowType == AB_ROW_LEVEL) g_storedVar.carParam[g_carSel].quickBrakeStrength = ep;
+        uint16_t* value = getAdvancedBrakeValue(editRowType);
+        if (value != nullptr) *value = ep * getAdvancedBrakeEditStep(editRowType);
         forceRedraw = true;
       }
     }
@@ -224,15 +253,19 @@ void showAdvancedBrakeMenu() {
         }
         /* Enter value edit */
         uint16_t minV = 0, maxV = 1, curV = 0;
-        if (rowType == AB_ROW_BUTTON) { curV = g_storedVar.carParam[g_carSel].brakeButtonReduction; minV = 0; maxV = 100; }
-        else if (rowType == AB_ROW_MODE) { curV = g_storedVar.carParam[g_carSel].quickBrakeEnabled; minV = RELEASE_BRAKE_OFF; maxV = RELEASE_BRAKE_DRAG; }
-        else if (rowType == AB_ROW_ZONE) { curV = g_storedVar.carParam[g_carSel].quickBrakeThreshold; minV = 0; maxV = QUICK_BRAKE_THRESHOLD_MAX; }
-        else if (rowType == AB_ROW_LEVEL) { curV = g_storedVar.carParam[g_carSel].quickBrakeStrength; minV = 0; maxV = QUICK_BRAKE_STRENGTH_MAX; }
+        if (rowType == AB_ROW_BUTTON) { curV = g_storedVar.activeCar.brakeButtonReduction; minV = 0; maxV = 100; }
+        else if (rowType == AB_ROW_MODE) { curV = g_storedVar.activeCar.quickBrakeEnabled; minV = RELEASE_BRAKE_OFF; maxV = RELEASE_BRAKE_DRAG; }
+        else if (rowType == AB_ROW_ZONE) { curV = g_storedVar.activeCar.quickBrakeThreshold; minV = 0; maxV = QUICK_BRAKE_THRESHOLD_MAX; }
+        else if (rowType == AB_ROW_LEVEL) { curV = g_storedVar.activeCar.quickBrakeStrength; minV = 0; maxV = QUICK_BRAKE_STRENGTH_MAX; }
+        else if (rowType == AB_ROW_BITE) { curV = g_storedVar.activeCar.brakeBite; minV = 0; maxV = BRAKE_BITE_MAX; }
+        else if (rowType == AB_ROW_HOLD) { curV = g_storedVar.activeCar.brakeBiteHold; minV = 0; maxV = BRAKE_BITE_HOLD_MAX; }
+        else if (rowType == AB_ROW_RAMP) { curV = g_storedVar.activeCar.brakeRamp; minV = 0; maxV = BRAKE_RAMP_MAX; }
         origValue = curV;
         editRowType = rowType;
+        uint16_t step = getAdvancedBrakeEditStep(rowType);
         g_rotaryEncoder.setAcceleration(SEL_ACCELERATION);
-        setUiEncoderBoundaries(minV, maxV, false);
-        resetUiEncoder(curV);
+        setUiEncoderBoundaries(minV / step, maxV / step, false);
+        resetUiEncoder(min(curV, maxV) / step);
         state       = VALUE_SELECTION;
         obdFill(&g_obd, OBD_WHITE, 1);
         prevSel     = 0xFF;
@@ -270,13 +303,19 @@ void showAdvancedBrakeMenu() {
         /* Value right-justified */
         char vbuf[12];
         if (rowType == AB_ROW_BUTTON) {
-          snprintf(vbuf, sizeof(vbuf), "%3d%%", g_storedVar.carParam[g_carSel].brakeButtonReduction);
+          snprintf(vbuf, sizeof(vbuf), "%3d%%", g_storedVar.activeCar.brakeButtonReduction);
         } else if (rowType == AB_ROW_MODE) {
           snprintf(vbuf, sizeof(vbuf), "%s", getReleaseBrakeMenuModeValue(lang, mode));
         } else if (rowType == AB_ROW_ZONE) {
-          snprintf(vbuf, sizeof(vbuf), "%3d%%", g_storedVar.carParam[g_carSel].quickBrakeThreshold);
+          snprintf(vbuf, sizeof(vbuf), "%3d%%", g_storedVar.activeCar.quickBrakeThreshold);
         } else if (rowType == AB_ROW_LEVEL) {
-          snprintf(vbuf, sizeof(vbuf), "%3d%%", g_storedVar.carParam[g_carSel].quickBrakeStrength);
+          snprintf(vbuf, sizeof(vbuf), "%3d%%", g_storedVar.activeCar.quickBrakeStrength);
+        } else if (rowType == AB_ROW_BITE) {
+          snprintf(vbuf, sizeof(vbuf), "%3d%%", g_storedVar.activeCar.brakeBite);
+        } else if (rowType == AB_ROW_HOLD) {
+          snprintf(vbuf, sizeof(vbuf), "%dms", g_storedVar.activeCar.brakeBiteHold);
+        } else if (rowType == AB_ROW_RAMP) {
+          snprintf(vbuf, sizeof(vbuf), "%dms", g_storedVar.activeCar.brakeRamp);
         } else {
           vbuf[0] = '\0';
         }
@@ -291,7 +330,7 @@ void showAdvancedBrakeMenu() {
     /* Long press = escape to main for race mode toggle */
     if (checkRaceModeEscape()) { requestEscapeToMain(); break; }
 
-    vTaskDelay(10);
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
   }
 
   saveEEPROM(g_storedVar);
@@ -4,6 +4,10 @@
 #include "HAL.h"
 #include "ext_pot.h"
 #include "connectivity_portal.h"
+#include "input_events.h"
+#include "settings_store.h"
+#include "car_profiles.h"
+#include "trigger_lut.h"
 
 extern StoredVar_type g_storedVar;
 extern uint16_t g_statsEnabled;
@@ -158,7 +162,7 @@ static bool resetConfirm(const char* label) {
         if (serviceIdlePowerTransitions(&lastInteraction, &screensaverActive)) {
           drawFirstConfirm();
         }
-        delay(10);
+        inputEventsWait(TASK1_IDLE_WAIT_MS);
         continue;
       }
     }
@@ -167,7 +171,7 @@ static bool resetConfirm(const char* label) {
       if (serviceIdlePowerTransitions(&lastInteraction, &screensaverActive)) {
         drawFirstConfirm();
       }
-      delay(10);
+      inputEventsWait(TASK1_IDLE_WAIT_MS);
       continue;
     }
 
@@ -182,7 +186,7 @@ static bool resetConfirm(const char* label) {
       lastInteraction = millis();
       break;
     }
-    delay(10);
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
   }
   delay(200);
 
@@ -211,7 +215,7 @@ static bool resetConfirm(const char* label) {
         if (serviceIdlePowerTransitions(&lastInteraction, &screensaverActive)) {
           drawSecondConfirm();
         }
-        delay(10);
+        inputEventsWait(TASK1_IDLE_WAIT_MS);
         continue;
       }
     }
@@ -220,7 +224,7 @@ static bool resetConfirm(const char* label) {
       if (serviceIdlePowerTransitions(&lastInteraction, &screensaverActive)) {
         drawSecondConfirm();
       }
-      delay(10);
+      inputEventsWait(TASK1_IDLE_WAIT_MS);
       continue;
     }
 
@@ -235,7 +239,7 @@ static bool resetConfirm(const char* label) {
       lastInteraction = millis();
       break;
     }
-    delay(10);
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
   }
   delay(200);
   return true;
@@ -243,21 +247,7 @@ static bool resetConfirm(const char* label) {
 
 /** Reset all car profiles to factory defaults. */
 static void doResetCar() {
-  for (uint8_t i = 0; i < CAR_MAX_COUNT; i++) {
-    g_storedVar.carParam[i].minSpeed   = MIN_SPEED_DEFAULT;
-    g_storedVar.carParam[i].brake      = BRAKE_DEFAULT;
-    g_storedVar.carParam[i].antiSpin   = ANTISPIN_DEFAULT;
-    g_storedVar.carParam[i].maxSpeed   = MAX_SPEED_DEFAULT;
-    g_storedVar.carParam[i].throttleCurveVertex.inputThrottle = THROTTLE_CURVE_INPUT_THROTTLE_DEFAULT;
-    g_storedVar.carParam[i].throttleCurveVertex.curveSpeedDiff = THROTTLE_CURVE_SPEED_DIFF_DEFAULT;
-    g_storedVar.carParam[i].fade                 = FADE_DEFAULT;
-    g_storedVar.carParam[i].freqPWM              = PWM_FREQ_DEFAULT;
-    g_storedVar.carParam[i].brakeButtonReduction = BRAKE_BUTTON_REDUCTION_DEFAULT;
-    g_storedVar.carParam[i].quickBrakeEnabled    = QUICK_BRAKE_ENABLED_DEFAULT;
-    g_storedVar.carParam[i].quickBrakeThreshold  = QUICK_BRAKE_THRESHOLD_DEFAULT;
-    g_storedVar.carParam[i].quickBrakeStrength   = QUICK_BRAKE_STRENGTH_DEFAULT;
-    sprintf(g_storedVar.carParam[i].carName, "CAR%d", i);
-  }
+  carProfileResetAll();
 }
 
 /** Reset all settings (non-car, non-calibration) to factory defaults. */
@@ -297,6 +287,7 @@ static void doResetCalibration() {
 #else
   g_storedVar.maxTrigger_raw = ACD_RESOLUTION_STEPS;
 #endif
+  triggerLutSetPoints(nullptr);
 }
 
 bool showResetConfirmDialog(const char* label) {
@@ -364,7 +355,7 @@ void showResetSubmenu() {
           obdFill(&g_obd, OBD_WHITE, 1);
           forceRedraw = true;
         }
-        delay(10);
+        inputEventsWait(TASK1_IDLE_WAIT_MS);
         continue;
       }
     }
@@ -374,7 +365,7 @@ void showResetSubmenu() {
         obdFill(&g_obd, OBD_WHITE, 1);
         forceRedraw = true;
       }
-      delay(10);
+      inputEventsWait(TASK1_IDLE_WAIT_MS);
       continue;
     }
 
@@ -434,6 +425,7 @@ void showResetSubmenu() {
           g_pref.begin("stored_var", false);
           g_pref.putBool("force_calib", true);
           g_pref.end();
+          settingsStoreFlush();
           ESP.restart();
         }
       }
@@ -462,7 +454,7 @@ void showResetSubmenu() {
     /* Long press = escape to main for race mode toggle */
     if (checkRaceModeEscape()) { requestEscapeToMain(); break; }
 
-    vTaskDelay(10);
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
   }
 
   obdFill(&g_obd, OBD_WHITE, 1);
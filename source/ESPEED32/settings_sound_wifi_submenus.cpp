@@ -4,6 +4,7 @@
 #include "ui_text_access.h"
 #include "connectivity_portal.h"
 #include "telemetry_logging.h"
+#include "input_events.h"
 
 extern StoredVar_type g_storedVar;
 extern ESC_type g_escVar;
@@ -60,7 +61,8 @@ static bool startTelemetryLoggingNow() {
                              g_antiSpinStepMs,
                              g_encoderInvertEnabled,
                              g_adcVoltageRange_mV,
-                             (uint8_t)g_carSel)) {
+                             (uint8_t)g_carSel,
+                             TELEMETRY_SAMPLE_INTERVAL_US_DEFAULT)) {
     showTelemetryLoggingStartFailed();
     return false;
   }
@@ -114,7 +116,7 @@ void showSoundSettings() {
           obdFill(&g_obd, OBD_WHITE, 1);
           needRedraw = true;
         }
-        delay(10);
+        inputEventsWait(TASK1_IDLE_WAIT_MS);
         continue;
       }
     }
@@ -124,7 +126,7 @@ void showSoundSettings() {
         obdFill(&g_obd, OBD_WHITE, 1);
         needRedraw = true;
       }
-      delay(10);
+      inputEventsWait(TASK1_IDLE_WAIT_MS);
       continue;
     }
 
@@ -175,12 +177,12 @@ void showSoundSettings() {
       uint8_t lang = g_storedVar.language;
       for (uint8_t i = 0; i < SND_ITEMS; i++) {
         bool isSelected = (sel == i + 1);
-        obdWriteString(&g_obd, 0, 0, i * lineH, (char*)getSoundMenuName(lang, i),
+        obdWriteString(&g_obd, 0, 0, i * lineH, (char*)uiText(UI_TEXT_SOUND_MENU, lang, i),
                        menuFont, isSelected ? OBD_WHITE : OBD_BLACK, 1);
         /* Show ON/OFF value on right for BOOT (i=0) and RACE (i=1) */
         if (i < 2) {
           uint16_t state = (i == 0) ? g_storedVar.soundBoot : g_storedVar.soundRace;
-          sprintf(msgStr, "%3s", getOnOffLabel(lang, state));
+          sprintf(msgStr, "%3s", uiText(UI_TEXT_ON_OFF, lang, state));
           uint8_t vx = OLED_WIDTH - (uint8_t)(strlen(msgStr) * WIDTH8x8);
           obdWriteString(&g_obd, 0, vx, i * lineH, msgStr,
                          menuFont, isSelected ? OBD_WHITE : OBD_BLACK, 1);
@@ -188,7 +190,7 @@ void showSoundSettings() {
       }
     }
 
-    vTaskDelay(10);
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
   }
 
   obdFill(&g_obd, OBD_WHITE, 1);
@@ -307,7 +309,7 @@ void showWiFiSettings() {
           obdFill(&g_obd, OBD_WHITE, 1);
           needRedraw = true;
         }
-        delay(10);
+        inputEventsWait(TASK1_IDLE_WAIT_MS);
         continue;
       }
     }
@@ -317,7 +319,7 @@ void showWiFiSettings() {
         obdFill(&g_obd, OBD_WHITE, 1);
         needRedraw = true;
       }
-      delay(10);
+      inputEventsWait(TASK1_IDLE_WAIT_MS);
       continue;
     }
 
@@ -449,13 +451,13 @@ void showWiFiSettings() {
       obdWriteString(&g_obd, 0, mx, timerRow * lineH, minutesStr, menuFont, (s3 || editing) ? OBD_WHITE : OBD_BLACK, 1);
 
       bool s4 = (!editing && sel == itemBack);
-      obdWriteString(&g_obd, 0, 0, backRow * lineH, (char*)getBackLabel(lang), menuFont, s4 ? OBD_WHITE : OBD_BLACK, 1);
+      obdWriteString(&g_obd, 0, 0, backRow * lineH, (char*)uiText(UI_TEXT_BACK, lang, 0), menuFont, s4 ? OBD_WHITE : OBD_BLACK, 1);
 
       needRedraw = false;
     }
 
     if (checkRaceModeEscape()) { requestEscapeToMain(); break; }
-    vTaskDelay(10);
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
   }
 
   obdFill(&g_obd, OBD_WHITE, 1);
@@ -517,7 +519,7 @@ void showLoggingSettings() {
           obdFill(&g_obd, OBD_WHITE, 1);
           needRedraw = true;
         }
-        delay(10);
+        inputEventsWait(TASK1_IDLE_WAIT_MS);
         continue;
       }
     }
@@ -527,7 +529,7 @@ void showLoggingSettings() {
         obdFill(&g_obd, OBD_WHITE, 1);
         needRedraw = true;
       }
-      delay(10);
+      inputEventsWait(TASK1_IDLE_WAIT_MS);
       continue;
     }
 
@@ -606,7 +608,7 @@ void showLoggingSettings() {
       bool s0 = (!editing && sel == ITEM_ACTIVE);
       const char* actionStr = telemetryIsLoggingActive() ? lblStopNow[lang] : lblStartNow[lang];
       obdWriteString(&g_obd, 0, 0, 0 * lineH, (char*)actionStr, menuFont, s0 ? OBD_WHITE : OBD_BLACK, 1);
-      sprintf(msgStr, "%3s", getOnOffLabel(lang, telemetryIsLoggingActive() ? 1 : 0));
+      sprintf(msgStr, "%3s", uiText(UI_TEXT_ON_OFF, lang, telemetryIsLoggingActive() ? 1 : 0));
       uint8_t ax = OLED_WIDTH - (uint8_t)(strlen(msgStr) * WIDTH8x8);
       obdWriteString(&g_obd, 0, ax, 0 * lineH, msgStr, menuFont, s0 ? OBD_WHITE : OBD_BLACK, 1);
 
@@ -619,13 +621,13 @@ void showLoggingSettings() {
       obdWriteString(&g_obd, 0, mx, 1 * lineH, minutesStr, menuFont, (s1 || editing) ? OBD_WHITE : OBD_BLACK, 1);
 
       bool s2 = (!editing && sel == ITEM_BACK);
-      obdWriteString(&g_obd, 0, 0, 2 * lineH, (char*)getBackLabel(lang), menuFont, s2 ? OBD_WHITE : OBD_BLACK, 1);
+      obdWriteString(&g_obd, 0, 0, 2 * lineH, (char*)uiText(UI_TEXT_BACK, lang, 0), menuFont, s2 ? OBD_WHITE : OBD_BLACK, 1);
 
       needRedraw = false;
     }
 
     if (checkRaceModeEscape()) { requestEscapeToMain(); break; }
-    vTaskDelay(10);
+    inputEventsWait(TASK1_IDLE_WAIT_MS);
   }
 
   obdFill(&g_obd, OBD_WHITE, 1);
@@ -0,0 +1,499 @@
+#include "settings_store.h"
+#include <Arduino.h>
+#include "car_profiles.h"
+#include <stddef.h>
+#include <string.h>
+
+#define SETTINGS_STORE_GLOBALS_OFFSET   offsetof(StoredVar_type, selectedCarNumber)
+#define SETTINGS_STORE_GLOBALS_SIZE     (sizeof(StoredVar_type) - SETTINGS_STORE_GLOBALS_OFFSET)
+#define SETTINGS_STORE_CAR_MIN_SIZE     offsetof(CarParam_type, brakeBite)   /* Profiles saved before the brake envelope */
+#define SETTINGS_STORE_LEGACY_SIZE      (CAR_LEGACY_COUNT * SETTINGS_STORE_CAR_MIN_SIZE + SETTINGS_STORE_GLOBALS_SIZE)
+#define SETTINGS_STORE_CAR_NONE         0xFFFFU   /* Shadow car index after an erase: forces a rewrite */
+
+static_assert(CAR_MAX_COUNT >= CAR_LEGACY_COUNT && CAR_MAX_COUNT <= 255, "car index is sent as uint8_t");
+
+typedef struct {
+  uint16_t index;
+  CarParam_type car;
+} SettingsStoreCar_type;
+
+/* Latest request, handed over under g_storeMux */
+static StoredVar_type g_storePending;
+static SettingsExtras_type g_storePendingExtras;
+static bool g_storePendingVars = false;     /* g_storePending holds a snapshot */
+static bool g_storePendingErase = false;    /* Drop every car blob before writing the queue */
+static SettingsStoreCar_type g_storePendingCars[SETTINGS_STORE_CAR_QUEUE_LEN];
+static uint8_t g_storePendingCarCount = 0;
+static volatile bool g_storeDirty = false;
+static volatile bool g_storeBusy = false;
+static volatile bool g_storeFlushRequested = false;
+static volatile uint32_t g_storeFirstRequestMs = 0;
+static volatile uint32_t g_storeLastRequestMs = 0;
+static portMUX_TYPE g_storeMux = portMUX_INITIALIZER_UNLOCKED;
+
+/* Owned by whoever commits (the store task once it runs) */
+static StoredVar_type g_storeWork;
+static SettingsExtras_type g_storeWorkExtras;
+static bool g_storeWorkVars = false;
+static bool g_storeWorkErase = false;       /* Readers look at the work queue while g_storeBusy */
+static SettingsStoreCar_type g_storeWorkCars[SETTINGS_STORE_CAR_QUEUE_LEN];
+static uint8_t g_storeWorkCarCount = 0;
+static StoredVar_type g_storeShadow;        /* What the active car and globals blobs in flash hold */
+static bool g_storeShadowValid = false;     /* false: next commit writes both blobs and the marker */
+
+static TaskHandle_t g_storeTask = NULL;
+
+static void settingsStoreCarKey(uint16_t index, char* key, size_t keyLen) {
+  snprintf(key, keyLen, SETTINGS_STORE_CAR_KEY_FMT, (unsigned)index);
+}
+
+/* A blob from an older, shorter CarParam_type keeps the defaults of the fields it lacks */
+static bool settingsStoreGetCar(Preferences& pref, uint16_t index, CarParam_type* out) {
+  char key[16];
+  settingsStoreCarKey(index, key, sizeof(key));
+  if (!pref.isKey(key)) {
+    return false;
+  }
+  size_t len = pref.getBytesLength(key);
+  if (len < SETTINGS_STORE_CAR_MIN_SIZE || len > sizeof(CarParam_type)) {
+    return false;
+  }
+  CarParam_type car;
+  carProfileDefaults(index, &car);
+  if (pref.getBytes(key, &car, len) != len) {
+    return false;
+  }
+  *out = car;
+  return true;
+}
+
+/* A paged-out profile is queued whether or not it changed, so compare with flash first */
+static bool settingsStorePutCar(Preferences& pref, uint16_t index, const CarParam_type* car) {
+  CarParam_type stored;
+  if (settingsStoreGetCar(pref, index, &stored) && memcmp(&stored, car, sizeof(stored)) == 0) {
+    return true;
+  }
+  char key[16];
+  settingsStoreCarKey(index, key, sizeof(key));
+  return pref.putBytes(key, car, sizeof(CarParam_type)) == sizeof(CarParam_type);
+}
+
+static bool settingsStoreEraseCars(Preferences& pref) {
+  bool ok = true;
+  char key[16];
+  for (uint16_t i = 0; i < CAR_MAX_COUNT; i++) {
+    settingsStoreCarKey(i, key, sizeof(key));
+    if (pref.isKey(key)) {
+      ok &= pref.remove(key);
+    }
+  }
+  return ok;
+}
+
+static bool settingsStorePutUChar(Preferences& pref, const char* key, uint8_t value) {
+  if (pref.isKey(key) && pref.getUChar(key) == value) {
+    return true;
+  }
+  return pref.putUChar(key, value) == sizeof(value);
+}
+
+static bool settingsStorePutUShort(Preferences& pref, const char* key, uint16_t value) {
+  if (pref.isKey(key) && pref.getUShort(key) == value) {
+    return true;
+  }
+  return pref.putUShort(key, value) == sizeof(value);
+}
+
+static bool settingsStorePutBytes(Preferences& pref, const char* key, const void* value, size_t len) {
+  uint8_t stored[32];
+  if (len <= sizeof(stored) && pref.getBytesLength(key) == len &&
+      pref.getBytes(key, stored, len) == len && memcmp(stored, value, len) == 0) {
+    return true;
+  }
+  return pref.putBytes(key, value, len) == len;
+}
+
+static bool settingsStoreWriteExtras(Preferences& pref, const SettingsExtras_type* extras) {
+  bool ok = true;
+  ok &= settingsStorePutUChar(pref, PREF_KEY_STATS_ENABLED, extras->statsEnabled);
+  ok &= settingsStorePutUShort(pref, PREF_KEY_ANTIS_STEP, extras->antiSpinStepMs);
+  ok &= settingsStorePutUShort(pref, PREF_KEY_ANTIS_STEP_PCT, extras->antiSpinStepPct);
+  ok &= settingsStorePutUChar(pref, PREF_KEY_ANTIS_MODE, extras->antiSpinDisplayMode);
+  ok &= settingsStorePutUChar(pref, PREF_KEY_ENC_INVERT, extras->encoderInvert);
+  ok &= settingsStorePutUShort(pref, PREF_KEY_ADC_RANGE, extras->adcVoltageRange_mV);
+  ok &= settingsStorePutUChar(pref, PREF_KEY_EXT_POT1_TARGET, extras->extPotTarget[0]);
+  ok &= settingsStorePutUChar(pref, PREF_KEY_EXT_POT2_TARGET, extras->extPotTarget[1]);
+  ok &= settingsStorePutBytes(pref, PREF_KEY_TRIGGER_LIN, extras->triggerLinPoints, sizeof(extras->triggerLinPoints));
+  return ok;
+}
+
+/* Call with g_storeMux held */
+static void settingsStoreMarkDirtyLocked(uint32_t now) {
+  if (!g_storeDirty) {
+    g_storeFirstRequestMs = now;
+  }
+  g_storeLastRequestMs = now;
+  g_storeDirty = true;
+}
+
+/* Call with g_storeMux held */
+static bool settingsStoreQueueCarLocked(uint16_t index, const CarParam_type* car) {
+  for (uint8_t i = 0; i < g_storePendingCarCount; i++) {
+    if (g_storePendingCars[i].index == index) {
+      g_storePendingCars[i].car = *car;
+      return true;
+    }
+  }
+  if (g_storePendingCarCount >= SETTINGS_STORE_CAR_QUEUE_LEN) {
+    return false;
+  }
+  g_storePendingCars[g_storePendingCarCount].index = index;
+  g_storePendingCars[g_storePendingCarCount].car = *car;
+  g_storePendingCarCount++;
+  return true;
+}
+
+/**
+ * @brief Put cars that failed to write back in the queue, unless re-requested meanwhile
+ */
+static void settingsStoreRequeueCars(const bool* failed) {
+  portENTER_CRITICAL(&g_storeMux);
+  for (uint8_t i = 0; i < g_storeWorkCarCount; i++) {
+    if (!failed[i]) {
+      continue;
+    }
+    bool newer = g_storePendingErase;
+    for (uint8_t j = 0; j < g_storePendingCarCount && !newer; j++) {
+      newer = (g_storePendingCars[j].index == g_storeWorkCars[i].index);
+    }
+    if (!newer && settingsStoreQueueCarLocked(g_storeWorkCars[i].index, &g_storeWorkCars[i].car)) {
+      g_storeDirty = true;  /* Retried with the next request */
+    }
+  }
+  portEXIT_CRITICAL(&g_storeMux);
+}
+
+/**
+ * @brief Write the pending requests: erase, queued cars, changed blobs, the layout marker last
+ */
+static void settingsStoreCommit() {
+  portENTER_CRITICAL(&g_storeMux);
+  if (!g_storeDirty) {
+    portEXIT_CRITICAL(&g_storeMux);
+    return;
+  }
+  g_storeWorkVars = g_storePendingVars;
+  if (g_storeWorkVars) {
+    memcpy(&g_storeWork, &g_storePending, sizeof(g_storeWork));
+    g_storeWorkExtras = g_storePendingExtras;
+  }
+  g_storeWorkErase = g_storePendingErase;
+  g_storeWorkCarCount = g_storePendingCarCount;
+  memcpy(g_storeWorkCars, g_storePendingCars, g_storeWorkCarCount * sizeof(SettingsStoreCar_type));
+  g_storePendingVars = false;
+  g_storePendingErase = false;
+  g_storePendingCarCount = 0;
+  g_storeDirty = false;
+  g_storeBusy = true;
+  portEXIT_CRITICAL(&g_storeMux);
+
+  bool carFailed[SETTINGS_STORE_CAR_QUEUE_LEN];
+  bool anyCarFailed = false;
+  Preferences pref;
+  bool ok = pref.begin("stored_var", false);
+  if (ok) {
+    if (g_storeWorkErase) {
+      settingsStoreEraseCars(pref);  /* Best effort: a blob left behind only keeps its old values */
+      g_storeShadow.activeCar.carNumber = SETTINGS_STORE_CAR_NONE;
+    }
+    for (uint8_t i = 0; i < g_storeWorkCarCount; i++) {
+      carFailed[i] = !settingsStorePutCar(pref, g_storeWorkCars[i].index, &g_storeWorkCars[i].car);
+      anyCarFailed |= carFailed[i];
+    }
+    if (g_storeWorkVars) {
+      const bool full = !g_storeShadowValid;
+      if (full || memcmp(&g_storeWork.activeCar, &g_storeShadow.activeCar, sizeof(CarParam_type)) != 0) {
+        ok &= settingsStorePutCar(pref, g_storeWork.activeCar.carNumber, &g_storeWork.activeCar);
+      }
+      const uint8_t* globals = (const uint8_t*)&g_storeWork + SETTINGS_STORE_GLOBALS_OFFSET;
+      if (full || memcmp(globals, (const uint8_t*)&g_storeShadow + SETTINGS_STORE_GLOBALS_OFFSET,
+                         SETTINGS_STORE_GLOBALS_SIZE) != 0) {
+        ok &= pref.putBytes(SETTINGS_STORE_GLOBALS_KEY, globals, SETTINGS_STORE_GLOBALS_SIZE) == SETTINGS_STORE_GLOBALS_SIZE;
+      }
+      /* Only a complete globals blob may switch the loader away from the legacy blob */
+      if (full && ok) {
+        ok = pref.putUChar(SETTINGS_STORE_LAYOUT_KEY, SETTINGS_STORE_LAYOUT) == 1;
+      }
+      ok &= settingsStoreWriteExtras(pref, &g_storeWorkExtras);
+    }
+    pref.end();
+  } else {
+    for (uint8_t i = 0; i < g_storeWorkCarCount; i++) {
+      carFailed[i] = true;
+    }
+    anyCarFailed = (g_storeWorkCarCount > 0);
+  }
+
+  if (g_storeWorkVars) {
+    if (ok) {
+      memcpy(&g_storeShadow, &g_storeWork, sizeof(g_storeShadow));
+    }
+    g_storeShadowValid = ok;
+  }
+  if (anyCarFailed) {
+    settingsStoreRequeueCars(carFailed);
+  }
+
+  portENTER_CRITICAL(&g_storeMux);
+  g_storeBusy = false;
+  portEXIT_CRITICAL(&g_storeMux);
+}
+
+static void settingsStoreKick() {
+  if (g_storeTask == NULL) {
+    settingsStoreCommit();
+    return;
+  }
+  xTaskNotifyGive(g_storeTask);
+}
+
+static void settingsStoreTaskcode(void* pvParameters) {
+  (void)pvParameters;
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    /* Coalesce: wait for a quiet window, but never hold an edit longer than 10 windows */
+    for (;;) {
+      uint32_t now = millis();
+      uint32_t quietMs = now - g_storeLastRequestMs;
+      if (g_storeFlushRequested || !g_storeDirty || quietMs >= SETTINGS_STORE_COALESCE_MS ||
+          now - g_storeFirstRequestMs >= 10UL * SETTINGS_STORE_COALESCE_MS) {
+        break;
+      }
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(SETTINGS_STORE_COALESCE_MS - quietMs));
+    }
+    g_storeFlushRequested = false;
+    settingsStoreCommit();
+  }
+}
+
+/**
+ * @brief Start the store task; without it every request is committed by the caller
+ */
+bool settingsStoreBegin() {
+  if (g_storeTask != NULL) {
+    return true;
+  }
+  BaseType_t ok = xTaskCreatePinnedToCore(
+    settingsStoreTaskcode,
+    "SettingsStore",
+    SETTINGS_STORE_STACK_SIZE,
+    NULL,
+    SETTINGS_STORE_TASK_PRIORITY,
+    &g_storeTask,
+    SETTINGS_STORE_TASK_CORE);
+  if (ok != pdPASS) {
+    g_storeTask = NULL;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief True if the namespace holds saved settings in either layout
+ */
+bool settingsStoreIsPresent(Preferences& pref) {
+  return pref.isKey(SETTINGS_STORE_LEGACY_KEY) ||
+         pref.getUChar(SETTINGS_STORE_LAYOUT_KEY, 0) == SETTINGS_STORE_LAYOUT;
+}
+
+/* The selected profile; one that was never saved starts from its defaults */
+static void settingsStoreLoadActiveCar(Preferences& pref, StoredVar_type* out) {
+  if (out->selectedCarNumber >= CAR_MAX_COUNT) {
+    out->selectedCarNumber = 0;
+  }
+  if (!settingsStoreGetCar(pref, out->selectedCarNumber, &out->activeCar)) {
+    carProfileDefaults(out->selectedCarNumber, &out->activeCar);
+  }
+  out->activeCar.carNumber = out->selectedCarNumber;
+}
+
+static bool settingsStoreLoadBlobs(Preferences& pref, StoredVar_type* out) {
+  if (pref.getUChar(SETTINGS_STORE_LAYOUT_KEY, 0) != SETTINGS_STORE_LAYOUT ||
+      pref.getBytesLength(SETTINGS_STORE_GLOBALS_KEY) != SETTINGS_STORE_GLOBALS_SIZE) {
+    return false;
+  }
+  if (pref.getBytes(SETTINGS_STORE_GLOBALS_KEY, (uint8_t*)out + SETTINGS_STORE_GLOBALS_OFFSET,
+                    SETTINGS_STORE_GLOBALS_SIZE) != SETTINGS_STORE_GLOBALS_SIZE) {
+    return false;
+  }
+  settingsStoreLoadActiveCar(pref, out);
+  return true;
+}
+
+/**
+ * @brief Split the legacy whole-struct blob into per-car blobs, globals and the marker
+ * @details Done in one go at boot, so a profile edited later can never be overwritten by a
+ *          second migration. Rewriting identical blobs after a power cut is harmless.
+ */
+static bool settingsStoreMigrateLegacy(Preferences& pref, StoredVar_type* out) {
+  if (pref.getBytesLength(SETTINGS_STORE_LEGACY_KEY) != SETTINGS_STORE_LEGACY_SIZE) {
+    return false;
+  }
+  uint8_t* legacy = (uint8_t*)malloc(SETTINGS_STORE_LEGACY_SIZE);
+  if (legacy == NULL) {
+    return false;
+  }
+  bool ok = pref.getBytes(SETTINGS_STORE_LEGACY_KEY, legacy, SETTINGS_STORE_LEGACY_SIZE) == SETTINGS_STORE_LEGACY_SIZE;
+  if (ok) {
+    for (uint16_t i = 0; i < CAR_LEGACY_COUNT; i++) {
+      CarParam_type car;
+      carProfileDefaults(i, &car);
+      memcpy(&car, legacy + i * SETTINGS_STORE_CAR_MIN_SIZE, SETTINGS_STORE_CAR_MIN_SIZE);
+      ok &= settingsStorePutCar(pref, i, &car);
+    }
+    const uint8_t* globals = legacy + CAR_LEGACY_COUNT * SETTINGS_STORE_CAR_MIN_SIZE;
+    memcpy((uint8_t*)out + SETTINGS_STORE_GLOBALS_OFFSET, globals, SETTINGS_STORE_GLOBALS_SIZE);
+    ok = ok && pref.putBytes(SETTINGS_STORE_GLOBALS_KEY, globals, SETTINGS_STORE_GLOBALS_SIZE) == SETTINGS_STORE_GLOBALS_SIZE;
+    ok = ok && pref.putUChar(SETTINGS_STORE_LAYOUT_KEY, SETTINGS_STORE_LAYOUT) == 1;
+  }
+  free(legacy);
+  if (ok) {
+    settingsStoreLoadActiveCar(pref, out);
+  }
+  return ok;
+}
+
+/**
+ * @brief Load StoredVar_type (globals + the selected profile) from an open "stored_var" namespace
+ * @details Prefers the per-key blobs; a legacy whole-struct blob is migrated first.
+ */
+bool settingsStoreLoad(Preferences& pref, StoredVar_type* out) {
+  if (settingsStoreLoadBlobs(pref, out) || settingsStoreMigrateLegacy(pref, out)) {
+    memcpy(&g_storeShadow, out, sizeof(g_storeShadow));
+    g_storeShadowValid = true;
+    return true;
+  }
+  g_storeShadowValid = false;
+  return false;
+}
+
+/**
+ * @brief Snapshot settings for the next commit and return immediately
+ */
+void settingsStoreRequest(const StoredVar_type* vars, const SettingsExtras_type* extras) {
+  uint32_t now = millis();
+  portENTER_CRITICAL(&g_storeMux);
+  memcpy(&g_storePending, vars, sizeof(g_storePending));
+  g_storePendingExtras = *extras;
+  g_storePendingVars = true;
+  settingsStoreMarkDirtyLocked(now);
+  portEXIT_CRITICAL(&g_storeMux);
+  settingsStoreKick();
+}
+
+/**
+ * @brief Queue one inactive car profile for the next commit
+ * @details A full queue is committed first, so copying to many profiles writes them in
+ *          batches of SETTINGS_STORE_CAR_QUEUE_LEN.
+ */
+void settingsStoreRequestCar(uint16_t index, const CarParam_type* car) {
+  if (index >= CAR_MAX_COUNT) {
+    return;
+  }
+  for (;;) {
+    uint32_t now = millis();
+    portENTER_CRITICAL(&g_storeMux);
+    bool queued = settingsStoreQueueCarLocked(index, car);
+    if (queued) {
+      settingsStoreMarkDirtyLocked(now);
+    }
+    portEXIT_CRITICAL(&g_storeMux);
+    if (queued) {
+      break;
+    }
+    settingsStoreFlush();
+  }
+  settingsStoreKick();
+}
+
+/**
+ * @brief Drop every car blob (reset to defaults); cars queued afterwards are kept
+ */
+void settingsStoreRequestCarErase() {
+  uint32_t now = millis();
+  portENTER_CRITICAL(&g_storeMux);
+  g_storePendingCarCount = 0;
+  g_storePendingErase = true;
+  settingsStoreMarkDirtyLocked(now);
+  portEXIT_CRITICAL(&g_storeMux);
+  settingsStoreKick();
+}
+
+/**
+ * @brief Latest saved or queued copy of a car profile
+ * @return false if the profile was never saved (or is being erased): use its defaults
+ */
+bool settingsStoreReadCar(uint16_t index, CarParam_type* out) {
+  bool found = false;
+  bool erased = false;
+  portENTER_CRITICAL(&g_storeMux);
+  for (uint8_t i = 0; i < g_storePendingCarCount && !found; i++) {
+    if (g_storePendingCars[i].index == index) {
+      *out = g_storePendingCars[i].car;
+      found = true;
+    }
+  }
+  if (!found) {
+    erased = g_storePendingErase;
+  }
+  if (!found && !erased && g_storeBusy) {
+    for (uint8_t i = 0; i < g_storeWorkCarCount && !found; i++) {
+      if (g_storeWorkCars[i].index == index) {
+        *out = g_storeWorkCars[i].car;
+        found = true;
+      }
+    }
+    erased = !found && g_storeWorkErase;
+  }
+  portEXIT_CRITICAL(&g_storeMux);
+  if (found || erased) {
+    return found;
+  }
+
+  Preferences pref;
+  if (!pref.begin("stored_var", true)) {
+    return false;
+  }
+  bool ok = settingsStoreGetCar(pref, index, out);
+  pref.end();
+  return ok;
+}
+
+bool settingsStorePending() {
+  portENTER_CRITICAL(&g_storeMux);
+  bool pending = g_storeDirty || g_storeBusy;
+  portEXIT_CRITICAL(&g_storeMux);
+  return pending;
+}
+
+/**
+ * @brief Commit now and wait for it (before restart or deep sleep)
+ * @return false if the commit did not finish within timeoutMs
+ */
+bool settingsStoreFlush(uint32_t timeoutMs) {
+  if (g_storeTask == NULL) {
+    settingsStoreCommit();
+    return !settingsStorePending();
+  }
+  g_storeFlushRequested = true;
+  xTaskNotifyGive(g_storeTask);
+  uint32_t start = millis();
+  while (settingsStorePending()) {
+    if (millis() - start >= timeoutMs) {
+      return false;
+    }
+    vTaskDelay(pdMS_TO_TICKS(5));
+  }
+  return true;
+}
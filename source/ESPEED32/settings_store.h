@@ -0,0 +1,70 @@
+#ifndef SETTINGS_STORE_H_
+#define SETTINGS_STORE_H_
+
+#include <stdint.h>
+#include <Preferences.h>
+#include "slot_ESC.h"
+#include "trigger_lut.h"
+
+/* Deferred persistence of the "stored_var" namespace.
+ * saveEEPROM() only snapshots the settings and returns; a low-priority task waits until
+ * no new request has arrived for SETTINGS_STORE_COALESCE_MS (a burst of encoder edits
+ * becomes one commit) and then writes just the parts that differ from what is in flash:
+ *   sv_car00..sv_carNN   one blob per car profile. RAM holds only the selected one
+ *                        (StoredVar_type.activeCar); the others are queued one at a time
+ *                        with settingsStoreRequestCar() (car_profiles.h). A profile that
+ *                        was never saved has no blob and reads as its defaults
+ *   sv_glob              StoredVar_type from selectedCarNumber to the end
+ *   PREF_KEY_* extras    the separate keys below, each compared with its stored value
+ * Every NVS blob write is atomic on its own. The layout marker is written only after the
+ * globals blob exists, so until then the loader keeps using the legacy whole-struct
+ * "user_param" blob (CAR_LEGACY_COUNT profiles) and a power cut mid-migration loses nothing.
+ * Code that restarts or sleeps right after saving must call settingsStoreFlush() first. */
+#define SETTINGS_STORE_COALESCE_MS      300UL
+#define SETTINGS_STORE_TASK_PRIORITY    0       /* Idle priority: writes only when UI and WiFi tasks sleep */
+#define SETTINGS_STORE_TASK_CORE        0       /* Keeps the flash cache stalls away from Task2's timing */
+#define SETTINGS_STORE_STACK_SIZE       4096
+#define SETTINGS_STORE_FLUSH_MS         2000UL  /* Default wait in settingsStoreFlush() */
+#define SETTINGS_STORE_CAR_QUEUE_LEN    8       /* Inactive profiles waiting for a commit */
+
+#define SETTINGS_STORE_LAYOUT_KEY       "sv_layout"
+#define SETTINGS_STORE_LAYOUT           2
+#define SETTINGS_STORE_CAR_KEY_FMT      "sv_car%02u"
+#define SETTINGS_STORE_GLOBALS_KEY      "sv_glob"
+#define SETTINGS_STORE_LEGACY_KEY       "user_param"
+
+#define PREF_KEY_STATS_ENABLED          "stats_en_v1"    /* persistent STATS visibility toggle */
+#define PREF_KEY_ANTIS_STEP             "antis_step_v1"  /* persistent ANTIS encoder step */
+#define PREF_KEY_ANTIS_STEP_PCT         "antis_pct_v1"   /* persistent ANTIS percent-step */
+#define PREF_KEY_ANTIS_MODE             "antis_mode_v1"  /* persistent ANTIS display/edit mode */
+#define PREF_KEY_ENC_INVERT             "enc_inv_v1"     /* persistent encoder inversion toggle */
+#define PREF_KEY_ADC_RANGE              "adc_rng_mv_v1"  /* persistent ADC voltage calibration */
+#define PREF_KEY_EXT_POT1_TARGET        "ext_pot1_tgt"
+#define PREF_KEY_EXT_POT2_TARGET        "ext_pot2_tgt"
+#define PREF_KEY_TRIGGER_LIN            "trig_lin_v1"    /* trigger linearization points (bytes) */
+
+/**
+ * @brief Settings kept in their own keys next to StoredVar_type
+ */
+typedef struct {
+  uint8_t statsEnabled;
+  uint16_t antiSpinStepMs;
+  uint16_t antiSpinStepPct;
+  uint8_t antiSpinDisplayMode;
+  uint8_t encoderInvert;
+  uint16_t adcVoltageRange_mV;
+  uint8_t extPotTarget[2];
+  int16_t triggerLinPoints[TRIGGER_LIN_POINTS];
+} SettingsExtras_type;
+
+bool settingsStoreBegin();
+bool settingsStoreIsPresent(Preferences& pref);
+bool settingsStoreLoad(Preferences& pref, StoredVar_type* out);
+void settingsStoreRequest(const StoredVar_type* vars, const SettingsExtras_type* extras);
+void settingsStoreRequestCar(uint16_t index, const CarParam_type* car);
+void settingsStoreRequestCarErase();
+bool settingsStoreReadCar(uint16_t index, CarParam_type* out);
+bool settingsStoreFlush(uint32_t timeoutMs = SETTINGS_STORE_FLUSH_MS);
+bool settingsStorePending();
+
+#endif  /* SETTINGS_STORE_H_ */
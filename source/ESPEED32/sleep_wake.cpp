@@ -0,0 +1,146 @@
+#include "sleep_wake.h"
+#include <Arduino.h>
+#include <esp_sleep.h>
+#include <esp_rom_crc.h>
+#include <driver/rtc_io.h>
+#include "HAL.h"
+
+#if defined(CONFIG_IDF_TARGET_ESP32) && (defined(CONFIG_ULP_COPROC_TYPE_FSM) || defined(CONFIG_ESP32_ULP_COPROC_ENABLED))
+  #define SLEEP_WAKE_HAS_ULP 1
+  #if __has_include(<ulp.h>)
+    #include <ulp.h>
+  #else
+    #include <esp32/ulp.h>
+  #endif
+  #include <soc/rtc_io_reg.h>
+#else
+  #define SLEEP_WAKE_HAS_ULP 0
+#endif
+
+#define SLEEP_WAKE_MAGIC  (0x534C0000UL | ((uint32_t)SW_MAJOR_VERSION << 12) | \
+                           ((uint32_t)SW_MINOR_VERSION << 8) | (uint32_t)STORED_VAR_VERSION)
+
+typedef struct {
+  uint32_t magic;                 /* SLEEP_WAKE_MAGIC of the firmware that went to sleep */
+  uint32_t crc;                   /* Over storedVar */
+  StoredVar_type storedVar;
+} SleepWakeSnapshot_type;
+
+/* Survives deep sleep only; garbage after a power cycle, hence magic and CRC */
+RTC_DATA_ATTR static SleepWakeSnapshot_type g_sleepSnapshot;
+
+static const gpio_num_t SLEEP_WAKE_PINS[] = {(gpio_num_t)ENCODER_BUTTON_PIN, (gpio_num_t)BUTT_PIN};
+#define SLEEP_WAKE_PIN_COUNT  (sizeof(SLEEP_WAKE_PINS) / sizeof(SLEEP_WAKE_PINS[0]))
+
+static bool g_fastWake = false;   /* Latched by sleepWakeBootBegin() */
+
+static uint32_t sleepWakeCrc(const StoredVar_type* vars) {
+  return esp_rom_crc32_le(0, (const uint8_t*)vars, sizeof(*vars));
+}
+
+/**
+ * @brief Buttons as RTC inputs with their pull-ups, so they read while the GPIO matrix is off
+ */
+static bool sleepWakeHoldPins() {
+  for (size_t i = 0; i < SLEEP_WAKE_PIN_COUNT; i++) {
+    gpio_num_t pin = SLEEP_WAKE_PINS[i];
+    if (!rtc_gpio_is_valid_gpio(pin) ||
+        rtc_gpio_init(pin) != ESP_OK ||
+        rtc_gpio_set_direction(pin, RTC_GPIO_MODE_INPUT_ONLY) != ESP_OK) {
+      return false;
+    }
+    rtc_gpio_pulldown_dis(pin);
+    rtc_gpio_pullup_en(pin);
+  }
+  return true;
+}
+
+#if SLEEP_WAKE_HAS_ULP
+/**
+ * @brief Load and start the button watch
+ * @details Each pass reads both inputs (active low) and halts until the next period; the
+ *          first pass that sees one pressed wakes the SoC and stops the ULP timer.
+ */
+static bool sleepWakeStartUlp() {
+  const uint32_t encBit = RTC_GPIO_IN_NEXT_S + (uint32_t)rtc_io_number_get(SLEEP_WAKE_PINS[0]);
+  const uint32_t brakeBit = RTC_GPIO_IN_NEXT_S + (uint32_t)rtc_io_number_get(SLEEP_WAKE_PINS[1]);
+  const ulp_insn_t program[] = {
+    I_RD_REG(RTC_GPIO_IN_REG, encBit, encBit),
+    M_BL(1, 1),                   /* Encoder button low: pressed */
+    I_RD_REG(RTC_GPIO_IN_REG, brakeBit, brakeBit),
+    M_BL(1, 1),                   /* Brake button low: pressed */
+    I_HALT(),
+    M_LABEL(1),
+    I_WAKE(),
+    I_END(),
+    I_HALT()
+  };
+  size_t size = sizeof(program) / sizeof(ulp_insn_t);
+  if (ulp_process_macros_and_load(0, program, &size) != ESP_OK) {
+    return false;
+  }
+  if (ulp_set_wakeup_period(0, SLEEP_WAKE_ULP_PERIOD_US) != ESP_OK) {
+    return false;
+  }
+  if (esp_sleep_enable_ulp_wakeup() != ESP_OK) {
+    return false;
+  }
+  return ulp_run(0) == ESP_OK;
+}
+#endif
+
+/**
+ * @brief Save the settings to RTC memory and arm the wake watch (right before deep sleep)
+ */
+void sleepWakeArm(const StoredVar_type* vars) {
+  memcpy(&g_sleepSnapshot.storedVar, vars, sizeof(g_sleepSnapshot.storedVar));
+  g_sleepSnapshot.crc = sleepWakeCrc(&g_sleepSnapshot.storedVar);
+  g_sleepSnapshot.magic = SLEEP_WAKE_MAGIC;
+
+  if (!sleepWakeHoldPins()) {
+    return;  /* Power cycle only, as before */
+  }
+  esp_sleep_pd_config(ESP_PD_DOMAIN_RTC_PERIPH, ESP_PD_OPTION_ON);  /* RTC pull-ups */
+#if SLEEP_WAKE_HAS_ULP
+  if (sleepWakeStartUlp()) {
+    return;
+  }
+#endif
+  esp_sleep_enable_ext0_wakeup(SLEEP_WAKE_PINS[0], BUTTON_PRESSED);
+}
+
+/**
+ * @brief Latch the wake cause and release the RTC pins; call first thing in setup()
+ */
+void sleepWakeBootBegin() {
+  esp_sleep_wakeup_cause_t cause = esp_sleep_get_wakeup_cause();
+  g_fastWake = (cause == ESP_SLEEP_WAKEUP_ULP || cause == ESP_SLEEP_WAKEUP_EXT0);
+  if (cause == ESP_SLEEP_WAKEUP_UNDEFINED) {
+    return;  /* Power-on or reset: pins were never handed to the RTC */
+  }
+  for (size_t i = 0; i < SLEEP_WAKE_PIN_COUNT; i++) {
+    if (rtc_gpio_is_valid_gpio(SLEEP_WAKE_PINS[i])) {
+      rtc_gpio_deinit(SLEEP_WAKE_PINS[i]);
+    }
+  }
+}
+
+bool sleepWakeIsFastWake() {
+  return g_fastWake;
+}
+
+/**
+ * @brief Copy the settings saved before sleep, once, on a wake from the watch
+ * @return false on a normal boot, or if the RTC copy is missing, stale or corrupt
+ */
+bool sleepWakeRestoreSettings(StoredVar_type* out) {
+  bool valid = g_fastWake && g_sleepSnapshot.magic == SLEEP_WAKE_MAGIC &&
+               g_sleepSnapshot.crc == sleepWakeCrc(&g_sleepSnapshot.storedVar);
+  g_sleepSnapshot.magic = 0;
+  if (!valid) {
+    g_fastWake = false;
+    return false;
+  }
+  memcpy(out, &g_sleepSnapshot.storedVar, sizeof(*out));
+  return true;
+}
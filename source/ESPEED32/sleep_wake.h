@@ -0,0 +1,29 @@
+#ifndef SLEEP_WAKE_H_
+#define SLEEP_WAKE_H_
+
+#include <stdint.h>
+#include "slot_ESC.h"
+
+/* Deep sleep wake watch and fast resume.
+ * sleepWakeArm() runs right before esp_deep_sleep_start():
+ *   - copies the stored settings into RTC slow memory (magic, firmware/struct version, CRC)
+ *   - loads a small ULP program that polls the encoder button and the brake button every
+ *     SLEEP_WAKE_ULP_PERIOD_US and wakes the main cores as soon as either reads pressed;
+ *     the main cores stay powered down until then. Builds without the ULP (or a failed
+ *     load) fall back to an ext0 wake on the encoder button
+ * On the next boot sleepWakeBootBegin() latches the wake cause and hands the pins back to
+ * the GPIO matrix. On a wake from this watch, sleepWakeRestoreSettings() returns the RTC
+ * copy so INIT can give Task2 the car before NVS is even opened, and WELCOME skips the
+ * startup delay.
+ * The trigger itself cannot be watched: the sensor sits on I2C pins the ULP cannot reach,
+ * and the encoder A/B lines are not RTC GPIOs. A power cycle still boots the normal way. */
+#ifndef SLEEP_WAKE_ULP_PERIOD_US
+#define SLEEP_WAKE_ULP_PERIOD_US   20000UL   /* Button poll period while asleep */
+#endif
+
+void sleepWakeArm(const StoredVar_type* vars);
+void sleepWakeBootBegin();
+bool sleepWakeIsFastWake();
+bool sleepWakeRestoreSettings(StoredVar_type* out);
+
+#endif  /* SLEEP_WAKE_H_ */
@@ -20,14 +20,14 @@
 #define SW_MINOR_VERSION 8
 
 /* Stored Variable Version */
-#define STORED_VAR_VERSION 22 /* Increment when StoredVar_type structure changes */
+#define STORED_VAR_VERSION 23 /* Increment when StoredVar_type structure changes */
 
 /* Menu Configuration */
 #define MENU_ITEMS_COUNT    12    /* Number of possible items in main menu (including optional STATS, LOCK and CAR) */
 #define SETTINGS_ITEMS_COUNT 12   /* Number of items in settings menu (including BACK) */
 #define POWER_ITEMS_COUNT    6    /* Number of items in power submenu (SCRSV, SLEEP, D-SLEEP, STARTUP, VIN CAL., BACK) */
 #define DISPLAY_ITEMS_COUNT  7    /* Number of items in display submenu (VIEW, LANG, CASE, FSIZE, ANTISPIN, STATUS, BACK) */
-#define HARDWARE_ITEMS_COUNT 5    /* Number of items in hardware submenu (ENC INV, EXT POT, TRIGGER, TEST, BACK) */
+#define HARDWARE_ITEMS_COUNT 8    /* Number of items in hardware submenu (ENC INV, EXT POT, TRIGGER, TEST, BENCH, MOTOR, SYS MON, BACK) */
 #define POWER_SAVE_TIMEOUT_DEFAULT 5    /* [min] Default auto power save delay (0=manual only) */
 #define POWER_SAVE_TIMEOUT_MAX     10   /* [min] Maximum auto power save delay */
 #define DEEP_SLEEP_TIMEOUT_DEFAULT 10   /* [min] Default auto deep sleep delay (0=manual only) */
@@ -80,6 +80,10 @@
 #define QUICK_BRAKE_ENABLED_DEFAULT     0    /* Quick brake off by default */
 #define QUICK_BRAKE_THRESHOLD_DEFAULT   10   /* [%] Trigger position where quick brake engages */
 #define QUICK_BRAKE_STRENGTH_DEFAULT    60   /* [%] Brake force in quick brake zone */
+#define ANTISPIN_MODE_DEFAULT           ANTISPIN_MODE_RAMP
+#define BRAKE_BITE_DEFAULT              100  /* [%] Envelope start level */
+#define BRAKE_BITE_HOLD_DEFAULT         0    /* [ms] Hold and ramp 0 = static brake envelope off */
+#define BRAKE_RAMP_DEFAULT              0    /* [ms] */
 
 /* Parameter Limits */
 #define MIN_SPEED_MAX_VALUE       180   /* [0.5%] 90.0% max sensitivity */
@@ -88,6 +92,11 @@
 #define BRAKE_MAX_VALUE           100   /* [%] Maximum brake strength */
 #define THROTTLE_CURVE_SPEED_DIFF_MAX_VALUE  90   /* [%] Throttle curve max */
 #define THROTTLE_CURVE_SPEED_DIFF_MIN_VALUE  10   /* [%] Throttle curve min */
+#define THROTTLE_CURVE_POINTS_MAX  6    /* Control points of a multi-point curve, between SENSI and LIMIT */
+#define THROTTLE_CURVE_TEXT_MAX    (THROTTLE_CURVE_POINTS_MAX * 8)  /* "x:y,x:y,..." incl. terminator */
+#define THROTTLE_CURVE_MODE_VERTEX 0    /* Single vertex (curveSpeedDiff), broken line */
+#define THROTTLE_CURVE_MODE_LINEAR 1    /* Broken line through the control points */
+#define THROTTLE_CURVE_MODE_SPLINE 2    /* Monotone cubic through the control points */
 #define FADE_MAX_VALUE            30    /* [%] Maximum trigger travel used for fade-in to SENSI */
 #define ANTISPIN_MAX_VALUE        999   /* [ms] Maximum anti-spin time */
 #define ANTISPIN_STEP_MIN           1   /* [ms] Minimum ANTIS encoder step */
@@ -97,9 +106,15 @@
 #define FREQ_MIN_VALUE            1000  /* [Hz] Minimum PWM frequency */
 #define QUICK_BRAKE_THRESHOLD_MAX 50    /* [%] Maximum quick brake threshold */
 #define QUICK_BRAKE_STRENGTH_MAX  100   /* [%] Maximum quick brake strength */
+#define BRAKE_BITE_MAX            100   /* [%] Maximum brake envelope bite */
+#define BRAKE_BITE_HOLD_MAX       500   /* [ms] Maximum brake envelope hold */
+#define BRAKE_RAMP_MAX            1000  /* [ms] Maximum brake envelope ramp */
+#define BRAKE_ENVELOPE_MS_STEP    10    /* [ms] Menu step for hold and ramp */
 #define RELEASE_BRAKE_OFF          0    /* Release brake disabled */
 #define RELEASE_BRAKE_QUICK        1    /* Release brake uses full quick-brake cut */
 #define RELEASE_BRAKE_DRAG         2    /* Release brake blends output with drag while releasing */
+#define ANTISPIN_MODE_RAMP         0    /* ANTIS ramps every launch over antiSpin ms (open loop) */
+#define ANTISPIN_MODE_TRACTION     1    /* ANTIS trims duty only while back-EMF shows wheel spin */
 #define MAX_UINT16                32767 /* Maximum 16-bit unsigned value */
 
 /* ANTIS UI/edit display modes */
@@ -201,7 +216,11 @@ static inline const char* antiSpinTextLevelToLabel(uint16_t level) {
 #define WIDTH12x16      12
 
 /* Timing Constants */
-#define ESC_PERIOD_US   500     /* ESC control loop period [µs] */
+#ifndef ESC_PERIOD_US
+#define ESC_PERIOD_US   500     /* ESC control loop period [µs] (override with -DESC_PERIOD_US=...) */
+#endif
+#define ESC_PERIOD_MIN_US 100   /* Fastest supported control loop period [µs] (10 kHz) */
+#define ESC_PERIOD_MAX_US 5000  /* Slowest supported control loop period [µs] (200 Hz) */
 #define SCREENSAVER_TIMEOUT_DEFAULT  60  /* [s] Default screensaver timeout */
 #define SCREENSAVER_TIMEOUT_MIN      1   /* [s] Minimum screensaver timeout (0 = OFF) */
 #define SCREENSAVER_TIMEOUT_MAX      240 /* [s] Maximum screensaver timeout */
@@ -213,10 +232,10 @@ static inline const char* antiSpinTextLevelToLabel(uint16_t level) {
 
 /* Button Press Timing */
 #define BUTTON_LONG_PRESS_MS        1000  /* [ms] Duration to trigger long press (view mode toggle) */
-#define BUTTON_DEBOUNCE_AFTER_LONG_MS   200  /* [ms] Require release plus short debounce after a long press */
 #define BUTTON_CLICK_MIN_MS           30  /* [ms] Minimum hold time to treat a press/release as a real click */
 #define BUTTON_SHORT_PRESS_DEBOUNCE_MS  200  /* [ms] Minimum time between button presses */
 #define BUTTON_LOCK_HOLD_MS            5000  /* [ms] Brake hold duration to toggle settings lock */
+#define TASK1_IDLE_WAIT_MS               10  /* [ms] Longest Task1 sleep between UI passes without input */
 
 /* Sound Configuration */
 #define SOUND_BOOT_DEFAULT  1  /* Boot sounds on by default (startup, calib, on, off) */
@@ -252,7 +271,10 @@ void applyAdcVoltageRangeMilliVolts(uint16_t range_mV);
 #define FONT_SIZE_DEFAULT   FONT_SIZE_LARGE
 
 /* Car Configuration */
-#define CAR_MAX_COUNT       20  /* Maximum number of car profiles */
+#ifndef CAR_MAX_COUNT
+#define CAR_MAX_COUNT       100 /* Number of car profiles; only the selected one is kept in RAM (car_profiles.h) */
+#endif
+#define CAR_LEGACY_COUNT    20  /* Profiles in the pre-paging whole-struct "user_param" blob */
 #define CAR_NAME_MAX_SIZE   5   /* Car name length (4 chars + null terminator) */
 #define SCREENSAVER_TEXT_MAX 22  /* Screensaver text max length (21 chars + null, fits FONT_6x8 line) */
 #define SCREENSAVER_LINE1_DEFAULT "ESPEED32"   /* Default screensaver line 1 */
@@ -285,10 +307,11 @@ void applyAdcVoltageRangeMilliVolts(uint16_t range_mV);
 #define STATUS_VOLTAGE  5   /* Input voltage (5 chars, e.g. " 3.7V") */
 #define STATUS_CURRENT_MA  6   /* Legacy stored value; normalized to STATUS_CURRENT */
 #define STATUS_ACTIVE_BRAKE 7   /* Active brake type/value (5 chars, e.g. "Q060%") */
+#define STATUS_TEMP     8   /* Bridge junction temperature (5 chars, e.g. " 87C ", "112C*" while derating) */
 
 static inline uint16_t normalizeStatusSlotValue(uint16_t slotValue) {
   if (slotValue == STATUS_CURRENT_MA) return STATUS_CURRENT;
-  return (slotValue <= STATUS_ACTIVE_BRAKE) ? slotValue : STATUS_BLANK;
+  return (slotValue <= STATUS_TEMP) ? slotValue : STATUS_BLANK;
 }
 /* Default slot assignments: OUTPUT | CAR | VOLTAGE | blank */
 #define STATUS_SLOT0_DEFAULT STATUS_OUTPUT
@@ -361,6 +384,24 @@ typedef struct {
   uint16_t curveSpeedDiff;     /* Y coordinate as percentage of min-max speed difference */
 } ThrottleCurveVertex_type;
 
+/**
+ * @brief Multi-point throttle curve
+ * @details Used instead of the vertex when mode is LINEAR or SPLINE and count > 0.
+ *          The curve runs from SENSI at the end of FADE through the points to LIMIT at full
+ *          trigger. X is the share of the trigger travel after FADE (strictly increasing,
+ *          1-99%), Y the share of the SENSI-LIMIT range (non-decreasing, 0-100%).
+ */
+typedef struct {
+  uint8_t input_pct;           /* [%] X */
+  uint8_t output_pct;          /* [%] Y */
+} ThrottleCurvePoint_type;
+
+typedef struct {
+  uint8_t mode;                /* THROTTLE_CURVE_MODE_* */
+  uint8_t count;               /* Points in use (0 = vertex curve) */
+  ThrottleCurvePoint_type points[THROTTLE_CURVE_POINTS_MAX];
+} ThrottleCurveShape_type;
+
 /**
  * @brief Car profile parameters
  * @details Contains all ESC behavior settings for a specific car/track configuration
@@ -373,12 +414,21 @@ typedef struct {
   uint16_t fade;                            /* [%] Initial trigger zone that ramps from 0 to SENSI */
   uint16_t antiSpin;                        /* [ms] Anti-spin ramp time (0-999ms) */
   char carName[CAR_NAME_MAX_SIZE];          /* Car profile name (4 chars + null) */
-  uint16_t carNumber;                       /* Profile index in array */
+  uint16_t carNumber;                       /* Profile index (0..CAR_MAX_COUNT-1) */
   uint16_t freqPWM;                         /* [100*Hz] Motor PWM frequency */
   uint16_t brakeButtonReduction;            /* [%] Alternate brake value when button pressed (0-100%) */
   uint16_t quickBrakeEnabled;              /* Release brake mode: OFF / QUICK / DRAG */
   uint16_t quickBrakeThreshold;            /* [%] Release-brake zone near trigger release */
   uint16_t quickBrakeStrength;             /* [%] Release-brake level (quick or drag) */
+  uint16_t antiSpinMode;                   /* ANTISPIN_MODE_RAMP / ANTISPIN_MODE_TRACTION */
+  /* Fields below were added after the first per-car blobs; shorter blobs load with defaults */
+  uint16_t brakeBite;                      /* [%] Brake envelope level right after release */
+  uint16_t brakeBiteHold;                  /* [ms] Time the bite level is held */
+  uint16_t brakeRamp;                      /* [ms] Time from the bite level to brake */
+  uint16_t motorResistance;                /* [mOhm] Measured by the motor sweep, 0 = not measured */
+  uint16_t motorNoLoadCurrent;             /* [mA] Free-running current at the top sweep point, 0 = unknown */
+  uint16_t freqPWMSweep;                   /* [100*Hz] PWM frequency the motor sweep picked, 0 = none */
+  ThrottleCurveShape_type throttleCurveShape;  /* Multi-point curve, all zero = vertex curve */
 } CarParam_type;
 
 /**
@@ -386,7 +436,7 @@ typedef struct {
  * @details Parameters saved to flash memory (Preferences library)
  */
 typedef struct {
-  CarParam_type carParam[CAR_MAX_COUNT];    /* Array of car profiles */
+  CarParam_type activeCar;                  /* Selected profile, paged in by carProfileSelect() */
   uint16_t selectedCarNumber;               /* Currently active car profile */
   int16_t minTrigger_raw;                   /* Calibrated minimum trigger value */
   int16_t maxTrigger_raw;                   /* Calibrated maximum trigger value */
@@ -416,16 +466,24 @@ typedef struct {
  * @details Real-time state variables updated during operation
  */
 typedef struct {
-  uint16_t outputSpeed_pct;   /* [%] Current motor duty cycle (0-100%) */
+  uint16_t outputSpeed_pct;   /* [%] Current motor duty cycle (0-100%), rounded from outputSpeed_permille */
+  uint16_t outputSpeed_permille; /* [0.1%] Current motor duty cycle as sent to the half bridge (0-1000) */
   int16_t trigger_raw;        /* Raw trigger sensor reading */
   uint16_t trigger_norm;      /* Normalized trigger value (0-THROTTLE_NORMALIZED) */
   uint16_t encoderPos;        /* Current rotary encoder position */
   uint16_t Vin_mV;            /* [mV] Input voltage */
   uint16_t motorCurrent_mA;   /* [mA] Motor current */
+  uint16_t bemf_mV;           /* [mV] Filtered motor back-EMF (valid while motorSpeedValid) */
+  uint8_t motorSpeed_halfPct; /* [0.5%] Rotor speed estimate: back-EMF as a share of Vin (200 = no-load top speed) */
+  uint8_t motorSpeedValid;    /* 1 = fresh back-EMF estimate, 0 = none (WiFi on, no off-window) */
+  uint8_t tractionTrim_pct;   /* [%] Duty currently removed by traction control */
+  int16_t chipTemp_C;         /* [°C] Half-bridge junction temperature, THERMAL_TEMP_UNKNOWN if never read */
+  uint8_t thermalLimit_pct;   /* [%] Share of maxSpeed allowed by the thermal model (100 = no derating) */
   uint16_t effectiveBrake_pct; /* [%] Active brake value after external overrides */
   uint16_t effectiveSensi_raw; /* [0.5%] Active SENSI value after external overrides */
   uint8_t activeBrakeKind;     /* ACTIVE_BRAKE_* runtime state */
   uint8_t activeBrake_pct;     /* [%] Brake value currently being applied */
+  uint8_t triggerStale;        /* 1 = no fresh trigger sample, safe brake applied */
   /* Lap detection */
   uint16_t lapCount;                    /* Total laps completed */
   uint32_t lapTimes[LAP_MAX_COUNT];     /* Circular buffer: last 20 lap times [ms] */
@@ -482,6 +540,10 @@ static inline uint16_t curveVertexInputWithFade(uint16_t fadeThrottleNorm, uint1
                      (uint32_t)THROTTLE_NORMALIZED));
 }
 
+static inline bool throttleCurveShapeActive(const ThrottleCurveShape_type* shape) {
+  return shape->mode != THROTTLE_CURVE_MODE_VERTEX && shape->count > 0;
+}
+
 static inline uint16_t sensiToWholePctCeil(uint16_t sensiRaw) {
   return (sensiRaw + (SENSI_SCALE - 1)) / SENSI_SCALE;
 }
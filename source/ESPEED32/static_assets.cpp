@@ -0,0 +1,113 @@
+#include "static_assets.h"
+#include "json_scan.h"
+#include <Arduino.h>
+#include <string.h>
+
+static StaticAsset_type g_staticAssets[STATIC_ASSET_MAX_ROUTES];
+static uint8_t g_staticAssetCount = 0;
+
+static bool staticAssetParseEntry(const JsonScanMember_type* elem, StaticAsset_type* out) {
+  JsonScanObject_type entry;
+  if (elem->type != JSON_SCAN_OBJECT || !jsonScanObject(elem->value, elem->valueLen, &entry)) {
+    return false;
+  }
+  int32_t gzip = 0;
+  int32_t size = 0;
+  if (!jsonScanStr(&entry, "path", out->path, sizeof(out->path)) ||
+      !jsonScanStr(&entry, "etag", out->etag, sizeof(out->etag)) ||
+      !jsonScanInt(&entry, "gzip", &gzip) ||
+      !jsonScanInt(&entry, "size", &size)) {
+    return false;
+  }
+  if (out->path[0] != '/' || out->etag[0] == '\0' || size < 0) {
+    return false;
+  }
+  out->flags = (gzip != 0) ? STATIC_ASSET_FLAG_GZIP : 0U;
+  out->size = (uint32_t)size;
+  /* The stored name must fit too: path + ".gz" */
+  return (gzip == 0) || (strlen(out->path) + 3U < sizeof(out->path));
+}
+
+/**
+ * @brief Rebuild the route table from the manifest on a mounted filesystem
+ * @return false (and an empty table) if the manifest is missing or malformed
+ */
+bool staticAssetsLoad(fs::FS& fs) {
+  g_staticAssetCount = 0;
+
+  File manifest = fs.open(STATIC_ASSET_MANIFEST_PATH, FILE_READ);
+  if (!manifest) {
+    return false;
+  }
+  String json = manifest.readString();
+  manifest.close();
+
+  /* Temporary: the scan index is only needed while loading */
+  JsonScanObject_type* doc = (JsonScanObject_type*)malloc(sizeof(JsonScanObject_type));
+  if (doc == nullptr) {
+    return false;
+  }
+  bool ok = jsonScanObject(json.c_str(), json.length(), doc);
+  const JsonScanMember_type* assets = ok ? jsonScanFind(doc, "assets") : nullptr;
+  if (assets == nullptr || assets->type != JSON_SCAN_ARRAY) {
+    free(doc);
+    return false;
+  }
+
+  size_t cursor = 0;
+  JsonScanMember_type elem;
+  uint8_t count = 0;
+  while (jsonScanArrayNext(assets, &cursor, &elem)) {
+    if (count >= STATIC_ASSET_MAX_ROUTES || !staticAssetParseEntry(&elem, &g_staticAssets[count])) {
+      ok = false;
+      break;
+    }
+    count++;
+  }
+  free(doc);
+
+  /* All or nothing: a partial table would answer "missing" for files that exist */
+  g_staticAssetCount = ok ? count : 0;
+  return ok;
+}
+
+void staticAssetsClear() {
+  g_staticAssetCount = 0;
+}
+
+uint8_t staticAssetsCount() {
+  return g_staticAssetCount;
+}
+
+const StaticAsset_type* staticAssetsFind(const char* path) {
+  if (path == nullptr) return nullptr;
+  for (uint8_t i = 0; i < g_staticAssetCount; i++) {
+    if (strcmp(g_staticAssets[i].path, path) == 0) {
+      return &g_staticAssets[i];
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Name of the file that holds the asset on SPIFFS
+ */
+bool staticAssetFilePath(const StaticAsset_type* asset, char* out, size_t outLen) {
+  if (asset == nullptr || out == nullptr || outLen == 0) return false;
+  int n = snprintf(out, outLen, "%s%s", asset->path, (asset->flags & STATIC_ASSET_FLAG_GZIP) ? ".gz" : "");
+  return n > 0 && (size_t)n < outLen;
+}
+
+const char* staticAssetContentType(const char* path) {
+  const char* ext = (path != nullptr) ? strrchr(path, '.') : nullptr;
+  if (ext == nullptr) return "application/octet-stream";
+  if (strcmp(ext, ".html") == 0) return "text/html; charset=utf-8";
+  if (strcmp(ext, ".css") == 0) return "text/css; charset=utf-8";
+  if (strcmp(ext, ".js") == 0) return "application/javascript; charset=utf-8";
+  if (strcmp(ext, ".svg") == 0) return "image/svg+xml";
+  if (strcmp(ext, ".png") == 0) return "image/png";
+  if (strcmp(ext, ".json") == 0) return "application/json";
+  if (strcmp(ext, ".ico") == 0) return "image/x-icon";
+  if (strcmp(ext, ".txt") == 0) return "text/plain; charset=utf-8";
+  return "application/octet-stream";
+}
@@ -0,0 +1,35 @@
+#ifndef STATIC_ASSETS_H_
+#define STATIC_ASSETS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <FS.h>
+
+/* In-RAM route table for the SPIFFS UI/docs files.
+ * scripts/build_spiffs_assets.py stages the data folder with each text asset stored
+ * gzip-only and writes /assets.json listing every file, its ETag and whether it is
+ * compressed. staticAssetsLoad() reads that manifest once per mount; afterwards a request
+ * resolves to the exact file to open, or to "missing", without probing SPIFFS. An image
+ * built without the manifest leaves the table empty and the portal probes as before. */
+#define STATIC_ASSET_MANIFEST_PATH  "/assets.json"
+#define STATIC_ASSET_MAX_ROUTES     48      /* Keep in sync with MAX_ROUTES in the build script */
+#define STATIC_ASSET_PATH_MAX       48      /* Including the ".gz" suffix and terminator */
+#define STATIC_ASSET_ETAG_LEN       16
+
+#define STATIC_ASSET_FLAG_GZIP      0x01U
+
+typedef struct {
+  char path[STATIC_ASSET_PATH_MAX];        /* Request path, e.g. "/docs/en/index.html" */
+  char etag[STATIC_ASSET_ETAG_LEN + 1];    /* Content hash, unquoted */
+  uint8_t flags;
+  uint32_t size;                            /* Stored (possibly compressed) size */
+} StaticAsset_type;
+
+bool staticAssetsLoad(fs::FS& fs);
+void staticAssetsClear();
+uint8_t staticAssetsCount();
+const StaticAsset_type* staticAssetsFind(const char* path);
+bool staticAssetFilePath(const StaticAsset_type* asset, char* out, size_t outLen);
+const char* staticAssetContentType(const char* path);
+
+#endif  /* STATIC_ASSETS_H_ */
@@ -2,212 +2,627 @@
 #include <Arduino.h>
 #include "HAL.h"
 #include "slot_ESC.h"
-#include "ext_pot.h"
+#include "active_tuning.h"
 #include "telemetry_logging.h"
+#include "perf_probe.h"
+#include "trigger_sampler.h"
+#include "adc_sampler.h"
+#include "current_sampler.h"
+#include "bemf_sampler.h"
+#include "traction_control.h"
+#include "thermal_model.h"
+#include "power_governor.h"
+#include "boot_timing.h"
+#include "lap_engine.h"
+#include "control_math.h"
+#include "half_bridge.h"
+#include "motor_sweep.h"
+#include "latency_bench.h"
+#include "trigger_lut.h"
 
 extern StateMachine_enum g_currState;
 extern StoredVar_type g_storedVar;
 extern ESC_type g_escVar;
-extern uint16_t g_carSel;
 extern uint32_t g_lastEncoderInteraction;
 
-extern uint16_t normalizeAndClamp(uint16_t raw, uint16_t minIn, uint16_t maxIn, uint16_t normalizedMax, bool isReversed);
-extern uint16_t addDeadBand(uint16_t inputVal, uint16_t minVal, uint16_t maxVal, uint16_t deadBand);
 extern uint16_t throttleCurve2(uint16_t inputThrottleNorm);
 extern uint16_t throttleAntiSpin3(uint16_t requestedSpeed);
 
-void Task2code(void *pvParameters) {
-  static unsigned long prevCallTime_uS = 0;
-  static unsigned long currTrigger_raw = 0, prevTrigger_raw = 0;
+/* Control loop scheduler: a hardware timer ticks at ESC_PERIOD_US and wakes Task2 via task notification */
+#define CONTROL_LOOP_TIMER_HZ          1000000UL   /* 1 MHz timer base -> alarm value in µs */
+#define CONTROL_LOOP_WAIT_TIMEOUT_TICKS  2         /* Fallback wake-up if no timer tick arrives [RTOS ticks] */
+/* Without the timer the loop can only run on that fallback (~2 ms instead of ESC_PERIOD_US):
+ * reported as an error at boot and in /api/info, with every skipped period counted as missed */
 
-  HalfBridge_Enable();
+static_assert(ESC_PERIOD_US >= ESC_PERIOD_MIN_US && ESC_PERIOD_US <= ESC_PERIOD_MAX_US,
+              "ESC_PERIOD_US out of supported range");
 
-  for (;;) {
-    unsigned long currCallTime_uS = micros();
-    unsigned long deltaTime_uS = currCallTime_uS - prevCallTime_uS;
-    
-    /* Execute every ESC_PERIOD_US microseconds */
-    if (deltaTime_uS > ESC_PERIOD_US) {
-      prevCallTime_uS = currCallTime_uS;
-
-      /* Read and filter trigger input */
-      prevTrigger_raw = currTrigger_raw;
-      currTrigger_raw = HAL_ReadTriggerRaw();
-      g_escVar.trigger_raw = (prevTrigger_raw + currTrigger_raw) / 2;  /* Simple moving average filter */
-      
-      /* Normalize and apply deadband */
-      g_escVar.trigger_norm = normalizeAndClamp(g_escVar.trigger_raw, g_storedVar.minTrigger_raw, 
-                                                g_storedVar.maxTrigger_raw, THROTTLE_NORMALIZED, THROTTLE_REV);
-      g_escVar.trigger_norm = addDeadBand(g_escVar.trigger_norm, 0, THROTTLE_NORMALIZED, THROTTLE_DEADBAND_NORM);
-      updateExtPotRuntimeValues();
-      
-      /* Lap detection requires motor-load sensing.
-         Builds without current sense keep lap timing disabled. */
-      {
-        static uint8_t lapState = 0;  /* 0=TRACKING, 1=GAP, 2=COOLDOWN */
-        static uint32_t gapStartMs = 0;
-        static uint32_t lapRegisteredMs = 0;
-        static uint32_t driveCurrentEma_mA = 0;
-
-        uint32_t vinMv = HAL_ReadVoltageDivider(AN_VIN_DIV, RVIFBL, RVIFBH);
-        bool hasCurrentSense = HAL_HasMotorCurrentSense();
-        uint16_t motorCurrent_mA = hasCurrentSense ? HAL_ReadMotorCurrent() : 0;
-        g_escVar.motorCurrent_mA = motorCurrent_mA;
-
-        /* Update display voltage with 8-sample moving average to filter ADC noise */
-        static uint32_t vinFilter[8] = {0};
-        static uint8_t vinFilterIdx = 0;
-        vinFilter[vinFilterIdx] = vinMv;
-        vinFilterIdx = (vinFilterIdx + 1) % 8;
-        uint32_t vinSum = 0;
-        for (uint8_t f = 0; f < 8; f++) vinSum += vinFilter[f];
-        g_escVar.Vin_mV = (uint16_t)(vinSum / 8);
-
-        uint32_t throttlePct = ((uint32_t)g_escVar.trigger_norm * 100U) / THROTTLE_NORMALIZED;
-        bool throttleActive = (throttlePct >= LAP_TRIGGER_ACTIVE_PCT);
-        bool inDeadSpot = false;
-        bool deadSpotRecovered = false;
-
-        if (hasCurrentSense) {
-          if (throttleActive && motorCurrent_mA >= LAP_CURRENT_GAP_MIN_MA) {
-            if (driveCurrentEma_mA == 0) driveCurrentEma_mA = motorCurrent_mA;
-            else driveCurrentEma_mA = (driveCurrentEma_mA * 7U + motorCurrent_mA) / 8U;
-          } else if (driveCurrentEma_mA > 0) {
-            driveCurrentEma_mA = (driveCurrentEma_mA * 7U) / 8U;
-          }
+static TaskHandle_t g_controlTaskHandle = NULL;
+static hw_timer_t* g_controlTimer = NULL;
+static portMUX_TYPE g_controlStatsMux = portMUX_INITIALIZER_UNLOCKED;
+static ControlLoopStats_type g_controlStats = {ESC_PERIOD_US, 0, UINT32_MAX, 0, 0, 0, 0, 0, 0, 0,
+                                               0, 0, 0, 0, 0, TRIGGER_FILTER_MODE, false,
+                                               false, 0, 0, 0};
+static int64_t g_controlPrevWake_us = 0;
+static bool g_controlGovIdle = false;       /* Power governor has the clock down (this tick) */
+static uint32_t g_bemfSampleMs = 0;          /* Timestamp behind g_escVar.motorSpeed_halfPct */
+static TriggerFilter_type g_triggerFilter = {0, 0, 0, 0, 0, false};
+static const TriggerFilterParams_type g_triggerFilterParams = {
+  TRIGGER_FILTER_MIN_CUTOFF_DHZ, TRIGGER_FILTER_MAX_CUTOFF_DHZ, TRIGGER_FILTER_BETA, TRIGGER_FILTER_SPEED_CUTOFF_DHZ
+};
 
-          uint32_t currentGapThreshold = driveCurrentEma_mA / 6U;      /* ~17% of running baseline */
-          uint32_t currentRecoverThreshold = driveCurrentEma_mA / 3U;  /* ~33% of running baseline */
-          if (currentGapThreshold < LAP_CURRENT_GAP_MIN_MA) currentGapThreshold = LAP_CURRENT_GAP_MIN_MA;
-          if (currentRecoverThreshold < LAP_CURRENT_RECOVER_MIN_MA) currentRecoverThreshold = LAP_CURRENT_RECOVER_MIN_MA;
+/* Deadline monitor; g_deadlineKick_us is the low 32 bits of esp_timer_get_time() at the end
+ * of the last cycle, 0 while not armed. Its timer is the last of the ESP32's four general
+ * purpose timers (control loop, current sync, back-EMF sync, deadline): a further timerBegin()
+ * user fails, and so does this one if another is added first. */
+static hw_timer_t* g_deadlineTimer = NULL;
+static volatile uint32_t g_deadlineKick_us = 0;
+static volatile bool g_deadlineTripped = false;
 
-          bool currentDetectArmed = throttleActive && (driveCurrentEma_mA >= LAP_CURRENT_BASE_MIN_MA);
-          inDeadSpot = currentDetectArmed && (motorCurrent_mA <= currentGapThreshold);
-          deadSpotRecovered = (motorCurrent_mA >= currentRecoverThreshold);
-        } else {
-          driveCurrentEma_mA = 0;
-          lapState = 0;
-        }
+static void IRAM_ATTR controlLoopTimerISR() {
+  BaseType_t higherPriorityTaskWoken = pdFALSE;
+  vTaskNotifyGiveFromISR(g_controlTaskHandle, &higherPriorityTaskWoken);
+  portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
 
-        uint32_t nowMs = millis();
-
-        switch (lapState) {
-          case 0: /* TRACKING */
-            if (inDeadSpot) {
-              gapStartMs = nowMs;
-              lapState = 1;
-            }
-            break;
-          case 1: /* GAP */
-            if (deadSpotRecovered) {
-              if ((nowMs - gapStartMs) <= LAP_GAP_MAX_MS) {
-                /* Valid dead spot crossing */
-                if (g_escVar.lapStartTime_ms > 0) {
-                  uint32_t lapTime = nowMs - g_escVar.lapStartTime_ms;
-                  uint8_t idx = g_escVar.lapCount % LAP_MAX_COUNT;
-                  g_escVar.lapTimes[idx] = lapTime;
-                  if (g_escVar.lapCount == 0 || lapTime < g_escVar.bestLapTime_ms)
-                    g_escVar.bestLapTime_ms = lapTime;
-                  g_escVar.lapCount++;
-                }
-                g_escVar.lapStartTime_ms = nowMs;
-                lapRegisteredMs = nowMs;
-                lapState = 2;
-              } else {
-                lapState = 0; /* Too long = crash/stop */
-              }
-            } else if ((nowMs - gapStartMs) > LAP_GAP_MAX_MS) {
-              lapState = 0; /* Still in gap and too long - abort */
-            }
-            break;
-          case 2: /* COOLDOWN */
-            if ((nowMs - lapRegisteredMs) >= LAP_MIN_TIME_MS) {
-              lapState = 0;
-            }
-            break;
-        }
+/**
+ * @brief Deadline monitor tick
+ * @details The safe output goes through the half-bridge output lock and stays latched until
+ *          Task2 completes an on-time cycle, so a late Task2 write cannot replace it. The LEDC
+ *          writes behind it are in flash: like the other timer callbacks this one is held off
+ *          while the cache is disabled, then runs and sees the stall.
+ */
+static void IRAM_ATTR controlLoopDeadlineISR() {
+  uint32_t kick_us = g_deadlineKick_us;
+  if (kick_us == 0 || g_deadlineTripped) {
+    return;
+  }
+  uint32_t late_us = (uint32_t)esp_timer_get_time() - kick_us;
+  if (late_us <= CONTROL_DEADLINE_PERIODS * ESC_PERIOD_US) {
+    return;
+  }
+  g_deadlineTripped = true;
+  HalfBridge_LatchSafeOutputFromISR(CONTROL_DEADLINE_SAFE_DRAG_PERMILLE);
+  portENTER_CRITICAL_ISR(&g_controlStatsMux);
+  g_controlStats.deadlineOverruns++;
+  g_controlStats.lastOverrunMs = millis();
+  g_controlStats.lastOverrunLate_us = late_us;
+  portEXIT_CRITICAL_ISR(&g_controlStatsMux);
+}
+
+/**
+ * @brief Start the deadline monitor timer
+ * @details Call from a core 0 task (Task1): the interrupt is allocated on the calling core,
+ *          so it still runs while core 1 is stuck. Stays disarmed until Task2's first cycle.
+ */
+void controlLoopDeadlineBegin() {
+  if (g_deadlineTimer != NULL) {
+    return;
+  }
+  g_deadlineTimer = timerBegin(CONTROL_LOOP_TIMER_HZ);
+  if (g_deadlineTimer == NULL) {
+    return;
+  }
+  timerAttachInterrupt(g_deadlineTimer, &controlLoopDeadlineISR);
+  timerAlarm(g_deadlineTimer, ESC_PERIOD_US, true, 0);
+}
+
+/* Hand a tripped monitor's safe output back to Task2; the kick is updated first so the ISR
+ * does not trip again on the old one */
+static void controlLoopDeadlineRelease() {
+  if (g_deadlineTripped) {
+    g_deadlineTripped = false;
+    HalfBridge_ReleaseSafeOutput();
+  }
+}
+
+/**
+ * @brief Mark a completed cycle (Task2, end of every cycle)
+ */
+static void controlLoopDeadlineKick(bool armed) {
+  if (!armed || g_deadlineTimer == NULL) {
+    g_deadlineKick_us = 0;
+    controlLoopDeadlineRelease();
+    return;
+  }
+  uint32_t now_us = (uint32_t)esp_timer_get_time();
+  g_deadlineKick_us = (now_us != 0) ? now_us : 1U;
+  controlLoopDeadlineRelease();
+}
+
+/**
+ * @brief Log deadline overruns as telemetry events (Task1)
+ */
+void controlLoopServiceDeadlineEvents(uint8_t carIndex, const CarParam_type* activeCarParam) {
+  static uint32_t reported = 0;
+  portENTER_CRITICAL(&g_controlStatsMux);
+  uint32_t overruns = g_controlStats.deadlineOverruns;
+  portEXIT_CRITICAL(&g_controlStatsMux);
+  if (overruns == reported) {
+    return;
+  }
+  uint32_t fresh = overruns - reported;
+  reported = overruns;
+  telemetryRecordDeadlineEvent(carIndex, activeCarParam, (uint16_t)((fresh > 0xFFFFU) ? 0xFFFFU : fresh));
+}
+
+/**
+ * @brief Start the control loop hardware timer
+ * @details Must be called from Task2 so the timer interrupt is allocated on the control core.
+ * @return true if the timer is running
+ */
+static bool controlLoopStartTimer() {
+  g_controlTaskHandle = xTaskGetCurrentTaskHandle();
+  g_controlTimer = timerBegin(CONTROL_LOOP_TIMER_HZ);
+  if (g_controlTimer == NULL) {
+    return false;
+  }
+  timerAttachInterrupt(g_controlTimer, &controlLoopTimerISR);
+  timerAlarm(g_controlTimer, ESC_PERIOD_US, true, 0);
+  return true;
+}
+
+/**
+ * @brief Record period/jitter/deadline statistics for one wake-up
+ * @param pendingTicks Notification count returned by ulTaskNotifyTake (0 = wait timed out)
+ * @param timerActive false = tick fallback, missed periods are taken from the elapsed time
+ */
+static void controlLoopUpdateStats(uint32_t pendingTicks, bool timerActive) {
+  int64_t now_us = esp_timer_get_time();
+  uint32_t period_us = (g_controlPrevWake_us > 0) ? (uint32_t)(now_us - g_controlPrevWake_us) : ESC_PERIOD_US;
+  g_controlPrevWake_us = now_us;
+  uint32_t jitter_us = (period_us > ESC_PERIOD_US) ? (period_us - ESC_PERIOD_US) : (ESC_PERIOD_US - period_us);
+  /* More than one pending tick means the previous cycle overran; a timeout means no tick arrived at all */
+  uint32_t missed = (pendingTicks > 1) ? (pendingTicks - 1) : ((pendingTicks == 0) ? 1 : 0);
+  if (!timerActive) {
+    /* No ticks to count: every whole target period beyond the first went unserved */
+    uint32_t elapsedPeriods = (period_us + ESC_PERIOD_US / 2U) / ESC_PERIOD_US;
+    missed = (elapsedPeriods > 1U) ? (elapsedPeriods - 1U) : 0U;
+  }
+
+  portENTER_CRITICAL(&g_controlStatsMux);
+  g_controlStats.lastPeriod_us = period_us;
+  if (period_us < g_controlStats.minPeriod_us) g_controlStats.minPeriod_us = period_us;
+  if (period_us > g_controlStats.maxPeriod_us) g_controlStats.maxPeriod_us = period_us;
+  if (jitter_us > g_controlStats.maxJitter_us) g_controlStats.maxJitter_us = jitter_us;
+  g_controlStats.missedDeadlines += missed;
+  g_controlStats.cycles++;
+  if (g_controlGovIdle) g_controlStats.idleCycles++;
+  portEXIT_CRITICAL(&g_controlStatsMux);
+}
+
+void controlLoopGetStats(ControlLoopStats_type* out) {
+  if (out == NULL) {
+    return;
+  }
+  portENTER_CRITICAL(&g_controlStatsMux);
+  *out = g_controlStats;
+  portEXIT_CRITICAL(&g_controlStatsMux);
+  if (out->cycles == 0) {
+    out->minPeriod_us = 0;
+  }
+  out->deadlineArmed = out->timerActive && g_deadlineTimer != NULL;
+}
+
+void controlLoopResetStats() {
+  portENTER_CRITICAL(&g_controlStatsMux);
+  g_controlStats.lastPeriod_us = 0;
+  g_controlStats.minPeriod_us = UINT32_MAX;
+  g_controlStats.maxPeriod_us = 0;
+  g_controlStats.maxJitter_us = 0;
+  g_controlStats.missedDeadlines = 0;
+  g_controlStats.cycles = 0;
+  g_controlStats.idleCycles = 0;
+  g_controlStats.staleTriggerTicks = 0;
+  g_controlStats.repeatTriggerTicks = 0;
+  g_controlStats.triggerToPwmLast_us = 0;
+  g_controlStats.triggerToPwmAvg_us = 0;
+  g_controlStats.triggerToPwmMax_us = 0;
+  portEXIT_CRITICAL(&g_controlStatsMux);
+}
+
+/**
+ * @brief Smooth a new trigger sample per TRIGGER_FILTER_MODE
+ * @details Runs only on new samples, once each; the adaptive filter steps on the sampler's
+ *          timestamps, so a repeated sample would count as zero motion and drag its cutoff.
+ */
+static uint16_t controlLoopFilterTrigger(const TriggerSample_type* sample) {
+#if TRIGGER_FILTER_MODE == TRIGGER_FILTER_ADAPTIVE
+  int16_t filtered = controlMathTriggerFilter(&g_triggerFilter, sample->raw, sample->timestamp_us,
+                                              &g_triggerFilterParams);
+  return (uint16_t)((filtered < 0) ? 0 : filtered);
+#elif TRIGGER_FILTER_MODE == TRIGGER_FILTER_AVG2
+  static uint16_t prevTrigger_raw = 0;
+  static bool primed = false;
+  uint16_t currTrigger_raw = (uint16_t)sample->raw;
+  if (!primed) {
+    prevTrigger_raw = currTrigger_raw;
+    primed = true;
+  }
+  uint16_t filtered = (uint16_t)(((uint32_t)prevTrigger_raw + currTrigger_raw) / 2);  /* Simple moving average filter */
+  prevTrigger_raw = currTrigger_raw;
+  return filtered;
+#else
+  return (uint16_t)sample->raw;
+#endif
+}
+
+/**
+ * @brief Record the trigger-to-PWM latency of a cycle that wrote a duty from a new sample
+ */
+static void controlLoopRecordLatency(uint32_t sampleTime_us) {
+  uint32_t latency_us = (uint32_t)micros() - sampleTime_us;
+  uint32_t lag_us = 0;
+#if TRIGGER_FILTER_MODE == TRIGGER_FILTER_ADAPTIVE
+  lag_us = controlMathTriggerFilterLagUs(&g_triggerFilter);
+#elif TRIGGER_FILTER_MODE == TRIGGER_FILTER_AVG2
+  lag_us = ESC_PERIOD_US / 2;  /* Two-tap average: half a sample period */
+#endif
+  portENTER_CRITICAL(&g_controlStatsMux);
+  g_controlStats.triggerToPwmLast_us = latency_us;
+  if (g_controlStats.triggerToPwmAvg_us == 0) {
+    g_controlStats.triggerToPwmAvg_us = latency_us;
+  } else {
+    g_controlStats.triggerToPwmAvg_us = (g_controlStats.triggerToPwmAvg_us * 7U + latency_us) / 8U;
+  }
+  if (latency_us > g_controlStats.triggerToPwmMax_us) g_controlStats.triggerToPwmMax_us = latency_us;
+  g_controlStats.filterLag_us = lag_us;
+  g_controlStats.filterCutoff_dHz = g_triggerFilter.cutoff_dHz;
+  portEXIT_CRITICAL(&g_controlStatsMux);
+}
+
+/**
+ * @brief One control cycle: trigger read, lap detection, motor output and telemetry capture
+ */
+static void runControlCycle() {
+  uint32_t cycleStart = perfProbeStart();
+
+  /* Load the latest sample published by the trigger sampler task (never touches the I2C bus) */
+  uint32_t stageStart = perfProbeStart();
+  static uint32_t triggerLastSeq = 0;
+  TriggerSample_type triggerSample;
+  TriggerSampleStatus_enum triggerStatus = triggerSamplerGetFresh(&triggerSample, TRIGGER_SAMPLE_STALE_US,
+                                                                  &triggerLastSeq);
+  bool triggerFresh = (triggerStatus != TRIGGER_SAMPLE_STALE);
+  bool triggerNew = (triggerStatus == TRIGGER_SAMPLE_NEW);
+  if (triggerNew) {
+    g_escVar.trigger_raw = controlLoopFilterTrigger(&triggerSample);
+  } else if (triggerFresh) {
+    /* Read still in flight: keep the last filtered value */
+    portENTER_CRITICAL(&g_controlStatsMux);
+    g_controlStats.repeatTriggerTicks++;
+    portEXIT_CRITICAL(&g_controlStatsMux);
+  } else {
+    portENTER_CRITICAL(&g_controlStatsMux);
+    g_controlStats.staleTriggerTicks++;
+    portEXIT_CRITICAL(&g_controlStatsMux);
+  }
+  g_escVar.triggerStale = triggerFresh ? 0 : 1;
+  perfProbeEnd(PERF_STAGE_TRIGGER_READ, stageStart);
+  
+  /* Normalize, linearize and apply deadband: one table load */
+  stageStart = perfProbeStart();
+  g_escVar.trigger_norm = triggerLutLookup(g_escVar.trigger_raw, g_storedVar.minTrigger_raw,
+                                           g_storedVar.maxTrigger_raw);
+  if (!triggerFresh) {
+    /* Sensor stalled or bus fault: treat as released trigger so the normal brake path engages */
+    g_escVar.trigger_norm = 0;
+  }
+  perfProbeEnd(PERF_STAGE_NORMALIZE, stageStart);
+
+  /* Idle governor: on input the full clock is restored here, before any output is computed */
+  g_controlGovIdle = powerGovernorTick(triggerFresh);
+
+  /* One consistent copy of the car parameters for the whole tick, ext-pot overrides applied */
+  stageStart = perfProbeStart();
+  const ActiveTuning_type* tuning = activeTuningAcquire();
+  perfProbeEnd(PERF_STAGE_EXT_POT, stageStart);
+  
+  /* Lap detection requires motor-load sensing.
+     Builds without current sense keep lap timing disabled. */
+  {
+    static uint8_t lapState = 0;  /* 0=TRACKING, 1=GAP, 2=COOLDOWN */
+    static uint32_t gapStartUs = 0;
+    static uint32_t lapRegisteredUs = 0;
+    static uint32_t driveCurrentEma_mA = 0;
+
+    stageStart = perfProbeStart();
+    uint32_t vinMv = HAL_ReadVoltageDivider(AN_VIN_DIV, RVIFBL, RVIFBH);
+    bool hasCurrentSense = HAL_HasMotorCurrentSense();
+    uint16_t motorCurrent_mA = 0;   /* Average over the PWM period (display/telemetry) */
+    uint16_t lapCurrent_mA = 0;     /* Compared against the dead-spot thresholds */
+    if (hasCurrentSense) {
+      CurrentSample_type currentSample;
+      if (currentSamplerGetLatest(&currentSample)) {
+        /* Mid-on sample: motor current without PWM ripple, so a dead spot shows up on the next sample */
+        motorCurrent_mA = currentSample.average_mA;
+        lapCurrent_mA = currentSample.onPhase_mA;
+      } else {
+        motorCurrent_mA = HAL_ReadMotorCurrent();
+        lapCurrent_mA = motorCurrent_mA;
       }
+    }
+    g_escVar.motorCurrent_mA = motorCurrent_mA;
+    perfProbeEnd(PERF_STAGE_ANALOG, stageStart);
 
-      /* Apply motor control (skip if in calibration or init state) */
-      if (!(g_currState == CALIBRATION || g_currState == INIT)) {
-        static uint16_t prevTriggerNorm = 0;
-        bool triggerReleasing = g_escVar.trigger_norm < prevTriggerNorm;
-        uint16_t releaseBrakeMode = g_storedVar.carParam[g_carSel].quickBrakeEnabled;
-        uint16_t releaseZone_norm = (uint32_t)g_storedVar.carParam[g_carSel].quickBrakeThreshold
-                                    * THROTTLE_NORMALIZED / 100;
-        bool inReleaseZone = (releaseZone_norm > 0) && (g_escVar.trigger_norm < releaseZone_norm);
-        bool brakeButtonPressed = (digitalRead(BUTT_PIN) == BUTTON_PRESSED);
-        bool releaseActive = false;
-        uint8_t activeBrakeKind = ACTIVE_BRAKE_NONE;
-        uint8_t appliedBrakePct = 0;
-
-        if (g_escVar.trigger_norm == 0) {
-          /* Apply brake when trigger is released */
-          /* Check if brake button is pressed - use alternate brake value */
-          uint16_t effectiveBrake = getEffectiveBrakePct();
-          if (brakeButtonPressed) {
-            /* Use brakeButtonReduction as alternate brake value (not a reduction) */
-            effectiveBrake = g_storedVar.carParam[g_carSel].brakeButtonReduction;
-            activeBrakeKind = ACTIVE_BRAKE_ALT;
-          } else {
-            activeBrakeKind = ACTIVE_BRAKE_BASE;
-          }
-          HalfBridge_SetPwmDrag(0, effectiveBrake);
-          g_escVar.outputSpeed_pct = 0;
-          appliedBrakePct = (uint8_t)constrain((int)effectiveBrake, 0, 100);
-          throttleAntiSpin3(0);  /* Keep anti-spin timer updated */
-        } else {
-          bool applyQuickBrake = (releaseBrakeMode == RELEASE_BRAKE_QUICK) && inReleaseZone;
-          bool applyDragBrake = (releaseBrakeMode == RELEASE_BRAKE_DRAG) && triggerReleasing;
-          releaseActive = applyQuickBrake || applyDragBrake;
-
-          if (applyQuickBrake) {
-            /* QUICK mode: cut output and apply brake in the release zone */
-            HalfBridge_SetPwmDrag(0, g_storedVar.carParam[g_carSel].quickBrakeStrength);
-            g_escVar.outputSpeed_pct = 0;
-            activeBrakeKind = ACTIVE_BRAKE_QUICK;
-            appliedBrakePct = (uint8_t)constrain((int)g_storedVar.carParam[g_carSel].quickBrakeStrength, 0, 100);
-            throttleAntiSpin3(0);  /* Keep anti-spin timer updated */
+    stageStart = perfProbeStart();
+
+    if (adcSamplerCoversPin(AN_VIN_DIV)) {
+      /* Already averaged over ADC_SAMPLER_OVERSAMPLE conversions by the ADC sampler */
+      g_escVar.Vin_mV = (uint16_t)vinMv;
+    } else {
+      /* Update display voltage with 8-sample moving average to filter ADC noise */
+      static uint32_t vinFilter[8] = {0};
+      static uint8_t vinFilterIdx = 0;
+      vinFilter[vinFilterIdx] = vinMv;
+      vinFilterIdx = (vinFilterIdx + 1) % 8;
+      uint32_t vinSum = 0;
+      for (uint8_t f = 0; f < 8; f++) vinSum += vinFilter[f];
+      g_escVar.Vin_mV = (uint16_t)(vinSum / 8);
+    }
+
+    /* Back-EMF relative to the supply: 100% is the no-load speed at full duty, whatever the motor */
+    BemfSample_type bemfSample;
+    if (bemfSamplerGetLatest(&bemfSample) && g_escVar.Vin_mV > 0) {
+      g_bemfSampleMs = bemfSample.timestamp_ms;
+      uint32_t speedHalfPct = ((uint32_t)bemfSample.filtered_mV * 200U) / g_escVar.Vin_mV;
+      g_escVar.bemf_mV = bemfSample.filtered_mV;
+      g_escVar.motorSpeed_halfPct = (uint8_t)min(speedHalfPct, (uint32_t)200U);
+      g_escVar.motorSpeedValid = 1;
+    } else {
+      g_escVar.motorSpeedValid = 0;
+    }
+
+    uint32_t throttlePct = ((uint32_t)g_escVar.trigger_norm * 100U) / THROTTLE_NORMALIZED;
+    bool throttleActive = (throttlePct >= LAP_TRIGGER_ACTIVE_PCT);
+    bool inDeadSpot = false;
+    bool deadSpotRecovered = false;
+
+    if (hasCurrentSense) {
+      if (throttleActive && lapCurrent_mA >= LAP_CURRENT_GAP_MIN_MA) {
+        if (driveCurrentEma_mA == 0) driveCurrentEma_mA = lapCurrent_mA;
+        else driveCurrentEma_mA = (driveCurrentEma_mA * 7U + lapCurrent_mA) / 8U;
+      } else if (driveCurrentEma_mA > 0) {
+        driveCurrentEma_mA = (driveCurrentEma_mA * 7U) / 8U;
+      }
+
+      uint32_t currentGapThreshold = driveCurrentEma_mA / 6U;      /* ~17% of running baseline */
+      uint32_t currentRecoverThreshold = driveCurrentEma_mA / 3U;  /* ~33% of running baseline */
+      if (currentGapThreshold < LAP_CURRENT_GAP_MIN_MA) currentGapThreshold = LAP_CURRENT_GAP_MIN_MA;
+      if (currentRecoverThreshold < LAP_CURRENT_RECOVER_MIN_MA) currentRecoverThreshold = LAP_CURRENT_RECOVER_MIN_MA;
+
+      bool currentDetectArmed = throttleActive && (driveCurrentEma_mA >= LAP_CURRENT_BASE_MIN_MA);
+      inDeadSpot = currentDetectArmed && (lapCurrent_mA <= currentGapThreshold);
+      deadSpotRecovered = (lapCurrent_mA >= currentRecoverThreshold);
+    } else {
+      driveCurrentEma_mA = 0;
+      lapState = 0;
+    }
+
+    uint32_t nowUs = micros();
+
+    switch (lapState) {
+      case 0: /* TRACKING */
+        if (inDeadSpot) {
+          gapStartUs = nowUs;
+          lapState = 1;
+        }
+        break;
+      case 1: /* GAP */
+        if (deadSpotRecovered) {
+          if ((nowUs - gapStartUs) <= LAP_GAP_MAX_MS * 1000UL) {
+            /* Valid dead spot crossing, timed at the gap start; lap_engine turns it into sectors and laps */
+            lapEngineCrossing(gapStartUs);
+            lapRegisteredUs = nowUs;
+            lapState = 2;
           } else {
-            /* Apply throttle curve and anti-spin */
-            g_escVar.outputSpeed_pct = throttleCurve2(g_escVar.trigger_norm);
-            g_escVar.outputSpeed_pct = throttleAntiSpin3(g_escVar.outputSpeed_pct);
-            uint16_t dragPct = applyDragBrake ? g_storedVar.carParam[g_carSel].quickBrakeStrength : 0;
-            HalfBridge_SetPwmDrag(g_escVar.outputSpeed_pct, dragPct);
-            activeBrakeKind = applyDragBrake ? ACTIVE_BRAKE_DRAG : ACTIVE_BRAKE_NONE;
-            appliedBrakePct = (uint8_t)constrain((int)dragPct, 0, 100);
+            lapState = 0; /* Too long = crash/stop */
           }
-          /* Update last interaction time to prevent screensaver while driving */
-          g_lastEncoderInteraction = millis();
+        } else if ((nowUs - gapStartUs) > LAP_GAP_MAX_MS * 1000UL) {
+          lapState = 0; /* Still in gap and too long - abort */
         }
+        break;
+      case 2: /* COOLDOWN */
+        if ((nowUs - lapRegisteredUs) >= lapEngineMinCrossingUs()) {
+          lapState = 0;
+        }
+        break;
+    }
+    perfProbeEnd(PERF_STAGE_LAP, stageStart);
+  }
+
+  /* PWM frequency changes from the UI are applied here, between duty writes */
+  HalfBridge_ServicePwmFrequency();
+
+  /* Apply motor control (skip if in calibration or init state) */
+  if (!(g_currState == CALIBRATION || g_currState == INIT)) {
+    static uint16_t prevTriggerNorm = 0;
+    static uint32_t brakeStartUs = 0;
+    static bool brakeEnvelopeDone = true;   /* Settled at BRAKE: no clock reads until the next release */
+    if (triggerFresh) {
+      bootTimingMark(BOOT_STAGE_DRIVE);
+    }
+    bool triggerReleasing = g_escVar.trigger_norm < prevTriggerNorm;
+    uint16_t releaseBrakeMode = tuning->quickBrakeEnabled;
+    uint16_t releaseZone_norm = (uint32_t)tuning->quickBrakeThreshold
+                                * THROTTLE_NORMALIZED / 100;
+    bool inReleaseZone = (releaseZone_norm > 0) && (g_escVar.trigger_norm < releaseZone_norm);
+    bool brakeButtonPressed = (digitalRead(BUTT_PIN) == BUTTON_PRESSED);
+    bool releaseActive = false;
+    uint8_t activeBrakeKind = ACTIVE_BRAKE_NONE;
+    uint8_t appliedBrakePct = 0;
+    uint16_t pwmDuty_permille = 0;
+    uint16_t pwmDrag_permille = 0;
+
+    if (g_escVar.trigger_norm == 0) {
+      /* Apply brake when trigger is released */
+      /* Check if brake button is pressed - use alternate brake value */
+      uint16_t effectiveBrake = tuning->effectiveBrake_pct;
+      if (prevTriggerNorm != 0) {
+        brakeStartUs = micros();
+        brakeEnvelopeDone = !tuning->brakeEnvelope.enabled;
+      }
+      if (brakeButtonPressed) {
+        /* Use brakeButtonReduction as alternate brake value (not a reduction) */
+        effectiveBrake = tuning->brakeButtonReduction;
+        activeBrakeKind = ACTIVE_BRAKE_ALT;
+      } else {
+        activeBrakeKind = ACTIVE_BRAKE_BASE;
+      }
+      pwmDrag_permille = effectiveBrake * 10U;
+      if (!brakeButtonPressed && !brakeEnvelopeDone) {
+        /* Bite, hold, then ramp to BRAKE; the alternate brake stays static */
+        uint32_t elapsedUs = micros() - brakeStartUs;
+        pwmDrag_permille = brakeEnvelopeLevel(&tuning->brakeEnvelope, pwmDrag_permille, elapsedUs);
+        brakeEnvelopeDone = elapsedUs >= tuning->brakeEnvelope.hold_us + tuning->brakeEnvelope.ramp_us;
+      }
+      g_escVar.outputSpeed_permille = 0;
+      appliedBrakePct = (uint8_t)constrain((int)((pwmDrag_permille + 5U) / 10U), 0, 100);
+      throttleAntiSpin3(0);  /* Keep anti-spin timer updated */
+      tractionControlReset();
+    } else {
+      bool applyQuickBrake = (releaseBrakeMode == RELEASE_BRAKE_QUICK) && inReleaseZone;
+      bool applyDragBrake = (releaseBrakeMode == RELEASE_BRAKE_DRAG) && triggerReleasing;
+      releaseActive = applyQuickBrake || applyDragBrake;
 
-        g_escVar.activeBrakeKind = activeBrakeKind;
-        g_escVar.activeBrake_pct = appliedBrakePct;
-
-        uint8_t triggerPct = (uint8_t)(((uint32_t)g_escVar.trigger_norm * 100U) / THROTTLE_NORMALIZED);
-        uint8_t outputPct = (uint8_t)constrain((int)g_escVar.outputSpeed_pct, 0, 100);
-        uint8_t telemetryFlags = 0;
-        if (brakeButtonPressed) telemetryFlags |= TELEMETRY_FLAG_BRAKE_BUTTON;
-        if (triggerReleasing) telemetryFlags |= TELEMETRY_FLAG_TRIGGER_RELEASING;
-        if (inReleaseZone) telemetryFlags |= TELEMETRY_FLAG_IN_RELEASE_ZONE;
-        if (releaseActive) telemetryFlags |= TELEMETRY_FLAG_RELEASE_ACTIVE;
-        if (HAL_HasMotorCurrentSense()) telemetryFlags |= TELEMETRY_FLAG_CURRENT_SENSE;
-
-        telemetryCaptureSample((uint8_t)g_carSel,
-                               &g_storedVar.carParam[g_carSel],
-                               triggerPct,
-                               outputPct,
-                               g_escVar.Vin_mV,
-                               g_escVar.motorCurrent_mA,
-                               appliedBrakePct,
-                               g_escVar.effectiveSensi_raw,
-                               (uint8_t)releaseBrakeMode,
-                               telemetryFlags);
-        prevTriggerNorm = g_escVar.trigger_norm;
+      if (applyQuickBrake) {
+        /* QUICK mode: cut output and apply brake in the release zone */
+        pwmDrag_permille = tuning->quickBrakeStrength * 10U;
+        g_escVar.outputSpeed_permille = 0;
+        activeBrakeKind = ACTIVE_BRAKE_QUICK;
+        appliedBrakePct = (uint8_t)constrain((int)tuning->quickBrakeStrength, 0, 100);
+        throttleAntiSpin3(0);  /* Keep anti-spin timer updated */
+        tractionControlReset();
       } else {
-        g_escVar.activeBrakeKind = ACTIVE_BRAKE_NONE;
-        g_escVar.activeBrake_pct = 0;
+        /* Apply throttle curve and anti-spin */
+        stageStart = perfProbeStart();
+        g_escVar.outputSpeed_permille = throttleCurve2(g_escVar.trigger_norm);
+        perfProbeEnd(PERF_STAGE_CURVE, stageStart);
+        stageStart = perfProbeStart();
+        if (tuning->antiSpinMode == ANTISPIN_MODE_TRACTION && bemfSamplerAvailable()) {
+          throttleAntiSpin3(0);  /* Keep anti-spin timer updated for a fallback to the ramp */
+          g_escVar.outputSpeed_permille = tractionControlApply(g_escVar.outputSpeed_permille,
+                                                               tuning->effectiveSensi_raw * (1000U / (100U * SENSI_SCALE)),
+                                                               tuning->antiSpin,
+                                                               g_escVar.motorSpeedValid != 0,
+                                                               g_escVar.motorSpeed_halfPct,
+                                                               g_bemfSampleMs,
+                                                               g_escVar.motorCurrent_mA);
+        } else {
+          /* RAMP mode, or no back-EMF at all (WiFi owns ADC2): open-loop ramp */
+          tractionControlReset();
+          g_escVar.outputSpeed_permille = throttleAntiSpin3(g_escVar.outputSpeed_permille);
+        }
+        perfProbeEnd(PERF_STAGE_ANTISPIN, stageStart);
+        g_escVar.outputSpeed_permille = thermalModelLimitPermille(g_escVar.outputSpeed_permille, tuning->maxSpeed);
+        uint16_t dragPct = applyDragBrake ? tuning->quickBrakeStrength : 0;
+        pwmDuty_permille = g_escVar.outputSpeed_permille;
+        pwmDrag_permille = dragPct * 10U;
+        activeBrakeKind = applyDragBrake ? ACTIVE_BRAKE_DRAG : ACTIVE_BRAKE_NONE;
+        appliedBrakePct = (uint8_t)constrain((int)dragPct, 0, 100);
+      }
+      /* Update last interaction time to prevent screensaver while driving */
+      g_lastEncoderInteraction = millis();
+    }
+
+    /* A motor sweep from the hardware menu owns the bridge until the trigger or brake button is touched */
+    if (motorSweepActive()) {
+      ThermalStatus_type sweepThermal;
+      thermalModelGetStatus(&sweepThermal);
+      if (motorSweepControlTick(g_escVar.trigger_norm > 0 || brakeButtonPressed, sweepThermal.derating,
+                                g_escVar.Vin_mV, g_escVar.motorCurrent_mA,
+                                g_escVar.motorSpeedValid ? g_escVar.bemf_mV : (uint16_t)MOTOR_SWEEP_BEMF_UNKNOWN,
+                                sweepThermal.chipTemp_C, sweepThermal.tempAge_ms,
+                                &pwmDuty_permille, &pwmDrag_permille)) {
+        g_escVar.outputSpeed_permille = pwmDuty_permille;
+        activeBrakeKind = ACTIVE_BRAKE_NONE;
+        appliedBrakePct = 0;
+      }
+    }
+
+    /* A latency bench steps the trigger through the sampler; here it is only paced and aborted */
+    if (latencyBenchActive()) {
+      latencyBenchControlTick(brakeButtonPressed, ESC_PERIOD_US);
+    }
+
+    g_escVar.outputSpeed_pct = (g_escVar.outputSpeed_permille + 5U) / 10U;
+
+    stageStart = perfProbeStart();
+    /* A junction temperature reading owns the bridge for a few ticks while the output rests */
+    if (HalfBridge_SafeOutputLatched()) {
+      /* This cycle ran past the deadline: keep the monitor's safe output until an on-time one */
+    } else if (!thermalModelControlTick(pwmDuty_permille, g_escVar.motorCurrent_mA,
+                                        g_escVar.trigger_norm == 0 && pwmDuty_permille == 0)) {
+      /* The write is dropped if the monitor trips between the check above and here */
+      /* A repeated sample was already measured when it was new */
+      if (HalfBridge_SetPwmDragPermille(pwmDuty_permille, pwmDrag_permille) && triggerNew) {
+        controlLoopRecordLatency(triggerSample.timestamp_us);
       }
     }
+    perfProbeEnd(PERF_STAGE_PWM, stageStart);
+
+    g_escVar.activeBrakeKind = activeBrakeKind;
+    g_escVar.tractionTrim_pct = tractionControlGetTrimPct();
+    ThermalStatus_type thermal;
+    thermalModelGetStatus(&thermal);
+    g_escVar.chipTemp_C = thermal.chipTemp_C;
+    g_escVar.thermalLimit_pct = thermal.limit_pct;
+    g_escVar.activeBrake_pct = appliedBrakePct;
+
+    uint8_t triggerPct = (uint8_t)(((uint32_t)g_escVar.trigger_norm * 100U) / THROTTLE_NORMALIZED);
+    uint8_t outputPct = (uint8_t)constrain((int)g_escVar.outputSpeed_pct, 0, 100);
+    uint8_t telemetryFlags = 0;
+    if (brakeButtonPressed) telemetryFlags |= TELEMETRY_FLAG_BRAKE_BUTTON;
+    if (triggerReleasing) telemetryFlags |= TELEMETRY_FLAG_TRIGGER_RELEASING;
+    if (inReleaseZone) telemetryFlags |= TELEMETRY_FLAG_IN_RELEASE_ZONE;
+    if (releaseActive) telemetryFlags |= TELEMETRY_FLAG_RELEASE_ACTIVE;
+    if (HAL_HasMotorCurrentSense()) telemetryFlags |= TELEMETRY_FLAG_CURRENT_SENSE;
+    if (!triggerFresh) telemetryFlags |= TELEMETRY_FLAG_TRIGGER_STALE;
+
+    stageStart = perfProbeStart();
+    telemetryCaptureSample(tuning->carIndex,
+                           triggerPct,
+                           outputPct,
+                           g_escVar.Vin_mV,
+                           g_escVar.motorCurrent_mA,
+                           appliedBrakePct,
+                           g_escVar.effectiveSensi_raw,
+                           (uint8_t)releaseBrakeMode,
+                           telemetryFlags,
+                           g_escVar.motorSpeedValid ? g_escVar.motorSpeed_halfPct : (uint8_t)TELEMETRY_SPEED_UNKNOWN);
+    perfProbeEnd(PERF_STAGE_TELEMETRY, stageStart);
+    prevTriggerNorm = g_escVar.trigger_norm;
+  } else {
+    g_escVar.activeBrakeKind = ACTIVE_BRAKE_NONE;
+    g_escVar.activeBrake_pct = 0;
+  }
+  perfProbeEnd(PERF_STAGE_TOTAL, cycleStart);
+
+  /* Start the next sensor read now so it completes while Task2 is idle */
+  triggerSamplerKick();
+}
+
+void Task2code(void *pvParameters) {
+  HalfBridge_Enable();
+  triggerSamplerStart();
+  adcSamplerStart();
+  currentSamplerStart();
+  bemfSamplerStart();
+  powerGovernorInit();
+
+  bool timerActive = controlLoopStartTimer();
+  portENTER_CRITICAL(&g_controlStatsMux);
+  g_controlStats.timerActive = timerActive;
+  portEXIT_CRITICAL(&g_controlStatsMux);
+  if (!timerActive) {
+    Serial.println("Error! Control loop timer unavailable, running on the RTOS tick fallback!");
+  }
+
+  for (;;) {
+    /* Block until the next timer tick; core 1 is free between cycles */
+    uint32_t pendingTicks = ulTaskNotifyTake(pdTRUE, CONTROL_LOOP_WAIT_TIMEOUT_TICKS);
+    controlLoopUpdateStats(pendingTicks, timerActive);
+    runControlCycle();
+    controlLoopDeadlineKick(timerActive);
   }
 }
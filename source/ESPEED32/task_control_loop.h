@@ -1,6 +1,64 @@
 #ifndef TASK_CONTROL_LOOP_H_
 #define TASK_CONTROL_LOOP_H_
 
+#include <stdint.h>
+#include "slot_ESC.h"
+
+/* Deadline monitor: a second hardware timer, its interrupt on core 0, checks every
+ * ESC_PERIOD_US that Task2 completed a control cycle within CONTROL_DEADLINE_PERIODS
+ * periods. If not (stuck I2C transfer, long critical section, flash write stalling the
+ * cache) the ISR drives the bridge straight to the safe output, duty 0 with
+ * CONTROL_DEADLINE_SAFE_DRAG_PERMILLE (1000 = full brake, 0 = coast). The overrun is
+ * counted and time-stamped, and Task1 turns it into a telemetry event. The late cycle does
+ * not write its duty; the next on-time cycle takes over again.
+ * Not armed while the loop runs on the RTOS tick fallback.
+ * Flash writes made while driving trip the monitor too: the session-log drain to SPIFFS,
+ * lap-history saves and NVS commits disable the cache for the length of a page write or
+ * sector erase (up to tens of ms), and Task2 stalls on its next flash-resident instruction.
+ * That is an expected stall, not a hung loop, so the default safe output is coast: the car
+ * rolls through it instead of locking the wheels mid-corner. Raise the drag only on builds
+ * that never touch flash with the trigger pulled. */
+#ifndef CONTROL_DEADLINE_PERIODS
+#define CONTROL_DEADLINE_PERIODS            4U
+#endif
+#ifndef CONTROL_DEADLINE_SAFE_DRAG_PERMILLE
+#define CONTROL_DEADLINE_SAFE_DRAG_PERMILLE 0U
+#endif
+
+/**
+ * @brief Control loop scheduler statistics
+ * @details Measured by Task2 on every hardware-timer wake-up.
+ *          Jitter is the largest deviation of a measured period from the target period.
+ */
+typedef struct {
+  uint32_t targetPeriod_us;   /* [µs] Configured timer period (ESC_PERIOD_US) */
+  uint32_t lastPeriod_us;     /* [µs] Most recent measured period */
+  uint32_t minPeriod_us;      /* [µs] Shortest measured period since reset */
+  uint32_t maxPeriod_us;      /* [µs] Longest measured period since reset */
+  uint32_t maxJitter_us;      /* [µs] Largest |measured - target| since reset */
+  uint32_t missedDeadlines;   /* Timer ticks that fired while the previous cycle was still running,
+                                 or target periods skipped on the tick fallback */
+  uint32_t cycles;            /* Control cycles executed since reset */
+  uint32_t idleCycles;        /* Cycles run at the power governor's reduced clock (same period) */
+  uint32_t staleTriggerTicks; /* Cycles that ran safe-brake because the trigger sample was stale */
+  uint32_t repeatTriggerTicks; /* Cycles that found no new trigger sample since the previous one */
+  uint32_t triggerToPwmLast_us; /* [µs] Trigger read completed -> duty written, latest cycle */
+  uint32_t triggerToPwmAvg_us;  /* [µs] Same, 1/8 running average */
+  uint32_t triggerToPwmMax_us;  /* [µs] Same, worst since reset */
+  uint32_t filterLag_us;        /* [µs] Trigger filter time constant at its current cutoff (0 = no filter) */
+  uint16_t filterCutoff_dHz;    /* [0.1 Hz] Adaptive trigger filter cutoff, latest sample */
+  uint8_t filterMode;           /* TRIGGER_FILTER_* */
+  bool timerActive;           /* false = hardware timer unavailable, loop runs on tick fallback */
+  bool deadlineArmed;         /* Deadline monitor running */
+  uint32_t deadlineOverruns;  /* Safe outputs forced by the deadline monitor (not reset) */
+  uint32_t lastOverrunMs;     /* [ms] millis() of the latest one, 0 = none */
+  uint32_t lastOverrunLate_us; /* [µs] Time since the last completed cycle when it tripped */
+} ControlLoopStats_type;
+
+void controlLoopDeadlineBegin();
+void controlLoopServiceDeadlineEvents(uint8_t carIndex, const CarParam_type* activeCarParam);
 void Task2code(void *pvParameters);
+void controlLoopGetStats(ControlLoopStats_type* out);
+void controlLoopResetStats();
 
 #endif  /* TASK_CONTROL_LOOP_H_ */
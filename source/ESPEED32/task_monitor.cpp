@@ -0,0 +1,182 @@
+#include "task_monitor.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+
+#if (configUSE_TRACE_FACILITY == 1) && (configGENERATE_RUN_TIME_STATS == 1)
+  #define TASK_MONITOR_RUN_TIME_STATS 1
+#else
+  #define TASK_MONITOR_RUN_TIME_STATS 0
+#endif
+
+#define TASK_MONITOR_STATUS_CAPACITY  32U  /* uxTaskGetSystemState() fails if the array is short */
+
+static portMUX_TYPE g_monMux = portMUX_INITIALIZER_UNLOCKED;
+static TaskMonitorStats_type g_monStats;
+
+/* WiFiTask only */
+static uint32_t g_monLastSample_ms = 0;
+static bool g_monSampled = false;
+static uint32_t g_monMinLargest = UINT32_MAX;
+#if TASK_MONITOR_RUN_TIME_STATS
+static TaskStatus_t g_monStatus[TASK_MONITOR_STATUS_CAPACITY];
+static TaskHandle_t g_monPrevHandle[TASK_MONITOR_STATUS_CAPACITY];
+static uint32_t g_monPrevCounter[TASK_MONITOR_STATUS_CAPACITY];
+static uint8_t g_monPrevCount = 0;
+static uint32_t g_monPrevTotal = 0;
+#else
+static const char* const TASK_MONITOR_APP_TASKS[] = {"Task1", "Task2", "WiFiTask"};
+#endif
+
+static void taskMonitorCopyName(char* dst, const char* src) {
+  strncpy(dst, src, TASK_MONITOR_NAME_LEN - 1);
+  dst[TASK_MONITOR_NAME_LEN - 1] = '\0';
+}
+
+static uint16_t taskMonitorPermille(uint32_t part, uint32_t whole) {
+  if (whole == 0) {
+    return 0;
+  }
+  uint64_t permille = ((uint64_t)part * 1000U) / whole;
+  return (uint16_t)((permille > 1000U) ? 1000U : permille);
+}
+
+#if TASK_MONITOR_RUN_TIME_STATS
+/**
+ * @brief Run-time counter of a task in the previous snapshot
+ * @return false if the task did not exist then
+ */
+static bool taskMonitorPrevCounter(TaskHandle_t handle, uint32_t* out) {
+  for (uint8_t i = 0; i < g_monPrevCount; i++) {
+    if (g_monPrevHandle[i] == handle) {
+      *out = g_monPrevCounter[i];
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Fill the task table from uxTaskGetSystemState() and the counters since the last call
+ */
+static void taskMonitorSampleTasks(TaskMonitorStats_type* stats) {
+  uint32_t total = 0;
+  UBaseType_t count = uxTaskGetSystemState(g_monStatus, TASK_MONITOR_STATUS_CAPACITY, &total);
+  uint32_t elapsed = total - g_monPrevTotal;  /* Run-time counter units, per core */
+  bool haveDelta = g_monSampled && count > 0 && elapsed > 0;
+  uint32_t idle[TASK_MONITOR_CORES] = {0, 0};
+  bool idleSeen[TASK_MONITOR_CORES] = {false, false};
+
+  stats->runTimeStats = (count > 0);
+  stats->taskCount = 0;
+  for (UBaseType_t i = 0; i < count; i++) {
+    const TaskStatus_t& status = g_monStatus[i];
+    uint32_t prev = 0;
+    bool known = taskMonitorPrevCounter(status.xHandle, &prev);
+    uint32_t delta = known ? (uint32_t)(status.ulRunTimeCounter - prev) : 0U;
+    uint8_t core = TASK_MONITOR_CORE_ANY;
+#if configTASKLIST_INCLUDE_COREID
+    if (status.xCoreID >= 0 && status.xCoreID < (BaseType_t)TASK_MONITOR_CORES) {
+      core = (uint8_t)status.xCoreID;
+    }
+#endif
+    if (core != TASK_MONITOR_CORE_ANY && strncmp(status.pcTaskName, "IDLE", 4) == 0) {
+      idle[core] += delta;
+      idleSeen[core] = true;
+    }
+    if (stats->taskCount < TASK_MONITOR_MAX_TASKS) {
+      TaskMonitorTask_type& task = stats->tasks[stats->taskCount++];
+      taskMonitorCopyName(task.name, status.pcTaskName);
+      task.core = core;
+      task.priority = (uint8_t)status.uxCurrentPriority;
+      task.load_permille = (haveDelta && known) ? taskMonitorPermille(delta, elapsed) : TASK_MONITOR_LOAD_UNKNOWN;
+      task.stackFree_bytes = (uint32_t)status.usStackHighWaterMark * sizeof(StackType_t);
+    }
+  }
+  for (uint8_t core = 0; core < TASK_MONITOR_CORES; core++) {
+    stats->coreLoad_permille[core] = (haveDelta && idleSeen[core])
+        ? (uint16_t)(1000U - taskMonitorPermille(idle[core], elapsed)) : TASK_MONITOR_LOAD_UNKNOWN;
+  }
+
+  g_monPrevCount = 0;
+  for (UBaseType_t i = 0; i < count && g_monPrevCount < TASK_MONITOR_STATUS_CAPACITY; i++) {
+    g_monPrevHandle[g_monPrevCount] = g_monStatus[i].xHandle;
+    g_monPrevCounter[g_monPrevCount] = g_monStatus[i].ulRunTimeCounter;
+    g_monPrevCount++;
+  }
+  g_monPrevTotal = total;
+}
+#else
+/**
+ * @brief No run-time stats in this build: stack marks of the app tasks only
+ */
+static void taskMonitorSampleTasks(TaskMonitorStats_type* stats) {
+  stats->runTimeStats = false;
+  stats->taskCount = 0;
+  for (size_t i = 0; i < sizeof(TASK_MONITOR_APP_TASKS) / sizeof(TASK_MONITOR_APP_TASKS[0]); i++) {
+    TaskHandle_t handle = xTaskGetHandle(TASK_MONITOR_APP_TASKS[i]);
+    if (handle == NULL) {
+      continue;
+    }
+    TaskMonitorTask_type& task = stats->tasks[stats->taskCount++];
+    taskMonitorCopyName(task.name, TASK_MONITOR_APP_TASKS[i]);
+    task.core = TASK_MONITOR_CORE_ANY;
+    task.priority = (uint8_t)uxTaskPriorityGet(handle);
+    task.load_permille = TASK_MONITOR_LOAD_UNKNOWN;
+    task.stackFree_bytes = (uint32_t)uxTaskGetStackHighWaterMark(handle) * sizeof(StackType_t);
+  }
+  for (uint8_t core = 0; core < TASK_MONITOR_CORES; core++) {
+    stats->coreLoad_permille[core] = TASK_MONITOR_LOAD_UNKNOWN;
+  }
+}
+#endif
+
+/**
+ * @brief Take a snapshot every TASK_MONITOR_PERIOD_MS (WiFiTask)
+ * @details Built in a static scratch copy, then published under the lock in one go.
+ */
+void taskMonitorService() {
+  static TaskMonitorStats_type scratch;
+  uint32_t now_ms = millis();
+  if (g_monSampled && (now_ms - g_monLastSample_ms) < TASK_MONITOR_PERIOD_MS) {
+    return;
+  }
+
+  taskMonitorSampleTasks(&scratch);
+  scratch.period_ms = g_monSampled ? (now_ms - g_monLastSample_ms) : 0U;
+  g_monLastSample_ms = now_ms;
+  g_monSampled = true;
+
+  scratch.heapFree_bytes = (uint32_t)heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  scratch.heapMinFree_bytes = (uint32_t)heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  scratch.heapLargest_bytes = (uint32_t)heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  if (scratch.heapLargest_bytes < g_monMinLargest) {
+    g_monMinLargest = scratch.heapLargest_bytes;
+  }
+  scratch.heapMinLargest_bytes = g_monMinLargest;
+  scratch.heapFragmentation_pct = (scratch.heapFree_bytes > 0)
+      ? (uint8_t)(100U - (uint32_t)(((uint64_t)scratch.heapLargest_bytes * 100U) / scratch.heapFree_bytes)) : 0U;
+
+  portENTER_CRITICAL(&g_monMux);
+  scratch.samples = g_monStats.samples + 1U;
+  g_monStats = scratch;
+  portEXIT_CRITICAL(&g_monMux);
+}
+
+void taskMonitorGetStats(TaskMonitorStats_type* out) {
+  if (out == NULL) {
+    return;
+  }
+  portENTER_CRITICAL(&g_monMux);
+  *out = g_monStats;
+  portEXIT_CRITICAL(&g_monMux);
+}
+
+bool taskMonitorFindTask(const TaskMonitorStats_type* stats, const char* name, TaskMonitorTask_type* out) {
+  for (uint8_t i = 0; i < stats->taskCount; i++) {
+    if (strcmp(stats->tasks[i].name, name) == 0) {
+      *out = stats->tasks[i];
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,50 @@
+#ifndef TASK_MONITOR_H_
+#define TASK_MONITOR_H_
+
+#include <stdint.h>
+
+/* Runtime task and heap monitor (WiFiTask).
+ * taskMonitorService() takes a snapshot every TASK_MONITOR_PERIOD_MS:
+ *   - every FreeRTOS task with its core, priority, stack high-water mark (bytes never used)
+ *     and CPU load over the last period, from the run-time counters. Builds without
+ *     run-time stats (or without the trace facility) report the app tasks' stacks only and
+ *     load as TASK_MONITOR_LOAD_UNKNOWN
+ *   - per-core load: 100% minus what the core's idle task got
+ *   - internal heap: free now, lowest free since boot, largest free block now and the
+ *     smallest largest-block seen, which is what a large String builder runs into
+ * Loads are fractions of one core, so Task1 and WiFiTask sharing core 0 add up to at most
+ * 100% between them. */
+#define TASK_MONITOR_PERIOD_MS    1000U
+#define TASK_MONITOR_MAX_TASKS    24U
+#define TASK_MONITOR_NAME_LEN     16U
+#define TASK_MONITOR_CORES        2U
+#define TASK_MONITOR_LOAD_UNKNOWN 0xFFFFU
+#define TASK_MONITOR_CORE_ANY     0xFFU    /* Task not pinned */
+
+typedef struct {
+  char name[TASK_MONITOR_NAME_LEN];
+  uint8_t core;               /* TASK_MONITOR_CORE_ANY if unpinned */
+  uint8_t priority;
+  uint16_t load_permille;     /* [0.1%] of one core over the last period */
+  uint32_t stackFree_bytes;   /* Stack high-water mark */
+} TaskMonitorTask_type;
+
+typedef struct {
+  bool runTimeStats;          /* Load figures available */
+  uint8_t taskCount;
+  uint16_t coreLoad_permille[TASK_MONITOR_CORES];
+  uint32_t samples;
+  uint32_t period_ms;         /* Length of the last sampling period */
+  uint32_t heapFree_bytes;
+  uint32_t heapMinFree_bytes;
+  uint32_t heapLargest_bytes;
+  uint32_t heapMinLargest_bytes;
+  uint8_t heapFragmentation_pct;  /* 100 - largest block / free */
+  TaskMonitorTask_type tasks[TASK_MONITOR_MAX_TASKS];
+} TaskMonitorStats_type;
+
+void taskMonitorService();
+void taskMonitorGetStats(TaskMonitorStats_type* out);
+bool taskMonitorFindTask(const TaskMonitorStats_type* stats, const char* name, TaskMonitorTask_type* out);
+
+#endif  /* TASK_MONITOR_H_ */
@@ -0,0 +1,122 @@
+#include "telemetry_frame.h"
+#include <string.h>
+#include <esp_rom_crc.h>
+#include "telemetry_logging.h"
+
+static inline uint8_t* telemetryFramePutU16(uint8_t* p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  return p + 2;
+}
+
+static inline uint8_t* telemetryFramePutU32(uint8_t* p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+  return p + 4;
+}
+
+static uint8_t* telemetryFramePutSample(uint8_t* p, const TelemetrySample& s, uint64_t base_us) {
+  uint64_t t_us = (uint64_t)s.t_ms * 1000U + s.tFrac_us;
+  p = telemetryFramePutU32(p, (uint32_t)(t_us - base_us));
+  p = telemetryFramePutU16(p, s.vin_mV);
+  p = telemetryFramePutU16(p, s.current_mA);
+  *p++ = (uint8_t)min(s.sensi_halfPct, (uint16_t)0xFFU);
+  *p++ = s.trigger_pct;
+  *p++ = s.output_pct;
+  *p++ = s.brake_pct;
+  *p++ = s.carIndex;
+  *p++ = (uint8_t)(((s.releaseMode & 0x03U) << 6) | (s.flags & 0x3FU));
+  *p++ = s.speed_halfPct;
+  return p;
+}
+
+typedef struct {
+  uint8_t* p;
+  uint32_t firstSeq;
+  uint32_t lastSeq;
+  uint64_t base_us;
+  uint16_t count;
+} TelemetryFrameFill_type;
+
+/* TelemetrySampleVisit_fn; ctx is a TelemetryFrameFill_type */
+static bool telemetryFrameAppendSample(void* ctx, const TelemetrySample* sample) {
+  TelemetryFrameFill_type* fill = (TelemetryFrameFill_type*)ctx;
+  if (fill->count == 0) {
+    fill->firstSeq = sample->seq;
+    fill->base_us = (uint64_t)sample->t_ms * 1000U + sample->tFrac_us;
+  } else if (sample->seq != fill->lastSeq + 1U) {
+    return false;  /* Overrun mid-frame: the client continues from the last seq it got */
+  }
+  fill->p = telemetryFramePutSample(fill->p, *sample, fill->base_us);
+  fill->lastSeq = sample->seq;
+  fill->count++;
+  return true;
+}
+
+/**
+ * @brief Encode samples newer than afterSeq as one binary live frame
+ * @details Samples go from the ring straight into the frame through a cursor. Stops early
+ *          (and reports hasMore) if the ring overran the reader mid-frame, because sample
+ *          seqs in a frame are implied and must be contiguous.
+ * @param outLastSeq Optional: seq of the last sample in the frame (afterSeq if none)
+ * @return Frame length in bytes, 0 if outSize is too small
+ */
+size_t telemetryEncodeLiveFrame(uint32_t afterSeq, size_t limit, uint8_t* out, size_t outSize, uint32_t* outLastSeq) {
+  if (out == nullptr || outSize < TELEMETRY_FRAME_HEADER_SIZE + TELEMETRY_FRAME_CRC_SIZE) {
+    return 0;
+  }
+  if (limit > TELEMETRY_FRAME_MAX_SAMPLES) {
+    limit = TELEMETRY_FRAME_MAX_SAMPLES;
+  }
+  size_t roomSamples = (outSize - TELEMETRY_FRAME_HEADER_SIZE - TELEMETRY_FRAME_CRC_SIZE) / TELEMETRY_FRAME_SAMPLE_SIZE;
+  if (limit > roomSamples) {
+    limit = roomSamples;
+  }
+
+  TelemetryStatus status;
+  TelemetryCursor_type cursor;
+  TelemetryFrameFill_type fill = {out + TELEMETRY_FRAME_HEADER_SIZE, 0, afterSeq, 0, 0};
+  telemetryCursorBegin(&cursor, 0, afterSeq, 0);
+  telemetryCursorRead(&cursor, 0, limit, telemetryFrameAppendSample, &fill, &status);
+  bool truncated = cursor.truncated && (fill.count == 0 || fill.firstSeq != afterSeq + 1U);
+  bool hasMore = cursor.hasMore;
+  uint32_t firstSeq = fill.firstSeq;
+  uint64_t base_us = fill.base_us;
+  uint16_t count = fill.count;
+  uint8_t* p = fill.p;
+  afterSeq = fill.lastSeq;
+
+  uint8_t flags = 0;
+  if (status.loggingActive) flags |= TELEMETRY_FRAME_FLAG_LOGGING;
+  if (status.hasData) flags |= TELEMETRY_FRAME_FLAG_HAS_DATA;
+  if (status.wrapped) flags |= TELEMETRY_FRAME_FLAG_WRAPPED;
+  if (truncated) flags |= TELEMETRY_FRAME_FLAG_TRUNCATED;
+  if (hasMore) flags |= TELEMETRY_FRAME_FLAG_HAS_MORE;
+  if (status.psram) flags |= TELEMETRY_FRAME_FLAG_PSRAM;
+
+  uint8_t* h = out;
+  h = telemetryFramePutU32(h, TELEMETRY_FRAME_MAGIC);
+  *h++ = TELEMETRY_FRAME_VERSION;
+  *h++ = TELEMETRY_FRAME_HEADER_SIZE;
+  *h++ = TELEMETRY_FRAME_SAMPLE_SIZE;
+  *h++ = flags;
+  h = telemetryFramePutU32(h, status.sessionId);
+  h = telemetryFramePutU32(h, status.oldestSeq);
+  h = telemetryFramePutU32(h, status.latestSeq);
+  h = telemetryFramePutU32(h, status.latestEventId);
+  h = telemetryFramePutU32(h, status.capacity);
+  h = telemetryFramePutU32(h, status.sampleIntervalUs);
+  h = telemetryFramePutU32(h, firstSeq);
+  h = telemetryFramePutU32(h, (uint32_t)(base_us / 1000U));
+  h = telemetryFramePutU16(h, (uint16_t)(base_us % 1000U));
+  h = telemetryFramePutU16(h, count);
+
+  if (outLastSeq != nullptr) {
+    *outLastSeq = afterSeq;
+  }
+  size_t length = (size_t)(p - out);
+  p = telemetryFramePutU32(p, esp_rom_crc32_le(0, out, (uint32_t)length));
+  return length + TELEMETRY_FRAME_CRC_SIZE;
+}
@@ -0,0 +1,39 @@
+#ifndef TELEMETRY_FRAME_H_
+#define TELEMETRY_FRAME_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Binary live-telemetry frame (/api/telemetry/live.bin, serial TLIVEB). All fields little-endian.
+ *
+ *   Header (TELEMETRY_FRAME_HEADER_SIZE bytes)
+ *     u32 magic "ETLF"    u8 version   u8 headerSize   u8 sampleSize   u8 flags
+ *     u32 sessionId       u32 oldestSeq   u32 latestSeq   u32 latestEventId
+ *     u32 capacity        u32 sampleIntervalUs
+ *     u32 firstSeq        u32 baseT_ms    u16 baseTFrac_us   u16 sampleCount
+ *   sampleCount x Sample (TELEMETRY_FRAME_SAMPLE_SIZE bytes), seq = firstSeq + index
+ *     u32 tOffset_us (since base time)   u16 vin_mV   u16 current_mA
+ *     u8 sensi_halfPct  u8 trigger_pct  u8 output_pct  u8 brake_pct  u8 carIndex
+ *     u8 releaseMode << 6 | flags   u8 speed_halfPct (0xFF = no back-EMF estimate)
+ *   u32 CRC-32 (IEEE, same as zlib) over everything before it
+ *
+ * Events are not framed: a client refetches the JSON live payload when latestEventId changes.
+ * Decoders must honour headerSize/sampleSize so fields can be appended without a version bump. */
+#define TELEMETRY_FRAME_MAGIC          0x464C5445UL  /* "ETLF" */
+#define TELEMETRY_FRAME_VERSION        1U
+#define TELEMETRY_FRAME_HEADER_SIZE    44U
+#define TELEMETRY_FRAME_SAMPLE_SIZE    15U
+#define TELEMETRY_FRAME_CRC_SIZE       4U
+#define TELEMETRY_FRAME_MAX_SAMPLES    256U
+#define TELEMETRY_FRAME_MAX_SIZE       (TELEMETRY_FRAME_HEADER_SIZE + TELEMETRY_FRAME_MAX_SAMPLES * TELEMETRY_FRAME_SAMPLE_SIZE + TELEMETRY_FRAME_CRC_SIZE)
+
+#define TELEMETRY_FRAME_FLAG_LOGGING       0x01U
+#define TELEMETRY_FRAME_FLAG_HAS_DATA      0x02U
+#define TELEMETRY_FRAME_FLAG_WRAPPED       0x04U
+#define TELEMETRY_FRAME_FLAG_TRUNCATED     0x08U
+#define TELEMETRY_FRAME_FLAG_HAS_MORE      0x10U
+#define TELEMETRY_FRAME_FLAG_PSRAM         0x20U
+
+size_t telemetryEncodeLiveFrame(uint32_t afterSeq, size_t limit, uint8_t* out, size_t outSize, uint32_t* outLastSeq);
+
+#endif  /* TELEMETRY_FRAME_H_ */
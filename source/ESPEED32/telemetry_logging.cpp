@@ -2,40 +2,175 @@
 #include <Arduino.h>
 #include <stdlib.h>
 #include <string.h>
+#include <atomic>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+
+/* Samples: single producer (telemetryCaptureSample() on the control task), lock-free.
+ * Sample seq N lives in slot (N - 1) % capacity and becomes visible when g_telemetryNextSeq
+ * is advanced past it. Cursor readers decode slots in place, outside the mux, and check each
+ * sample against the write position before handing it out; anything the producer may have
+ * overwritten meanwhile is skipped. g_telemetryRingEpoch tells them the ring was reset under
+ * them, g_telemetryReaders holds telemetryClear() off the memory until they are done.
+ * Everything else (events, config snapshot, session bookkeeping) is consumer-side state
+ * guarded by g_telemetryMux, which the control task never takes. */
+
+/* Events: a record keeps the event header plus only the car fields that differ from its
+ * keyframe, a full CarParam_type copy taken on car select, on a car name change, every
+ * TELEMETRY_EVENT_KEYFRAME_EVERY events and whenever more than TELEMETRY_EVENT_DELTA_FIELDS
+ * fields have drifted. Because the delta is against the keyframe and not the previous event,
+ * any record expands to a full TelemetryEvent from two slots. Reusing a keyframe slot drops
+ * the oldest records still pointing at it. */
+typedef struct {
+  uint32_t t_ms;
+  uint32_t sampleSeq;
+  uint16_t changedMask;
+  uint16_t deltaMask;       /* TELEMETRY_CHANGE_* fields that differ from the keyframe */
+  uint16_t delta[TELEMETRY_EVENT_DELTA_FIELDS];  /* Their values, in mask bit order */
+  uint16_t keyframe;        /* Keyframe number, low 16 bits */
+  uint8_t type;
+  uint8_t carIndex;
+  uint8_t previousCarIndex;
+  uint8_t reserved;
+} TelemetryEventRecord_type;
+
+/* RAM ring: every TELEMETRY_BLOCK_SAMPLES-th sample starts a block whose absolute time is
+ * kept in the block table, the others store the time since the previous sample (dt_10us).
+ * Seq is implied by the slot. */
+static_assert(sizeof(TelemetryPackedSample) == 13, "TelemetryPackedSample layout");
+static_assert(TELEMETRY_BUFFER_CAPACITY % TELEMETRY_BLOCK_SAMPLES == 0, "capacity must be whole blocks");
+static_assert(TELEMETRY_PSRAM_BUFFER_CAPACITY % TELEMETRY_BLOCK_SAMPLES == 0, "capacity must be whole blocks");
+static_assert(sizeof(TelemetryEventRecord_type) == 24, "TelemetryEventRecord_type layout");
+static_assert((65536UL % TELEMETRY_EVENT_KEYFRAMES) == 0, "keyframe slot from the 16-bit number");
+static_assert(MIN_SPEED_MAX_VALUE <= 0xFF && RELEASE_BRAKE_DRAG <= 3 && TELEMETRY_FLAG_TRIGGER_STALE < 0x40,
+              "TelemetryPackedSample field ranges");
+
+#define TELEMETRY_DT_MAX_10US  0xFFFFU
 
 static portMUX_TYPE g_telemetryMux = portMUX_INITIALIZER_UNLOCKED;
-static TelemetrySample* g_telemetrySamples = nullptr;
-static TelemetryEvent* g_telemetryEvents = nullptr;
+static TelemetryPackedSample* g_telemetrySamples = nullptr;
+static uint32_t* g_telemetryBlockBase_10us = nullptr;   /* Session time of each block's first sample */
+static uint32_t g_telemetryCapacity = 0;
+static bool g_telemetryInPsram = false;
+static TelemetryEventRecord_type* g_telemetryEvents = nullptr;
+static CarParam_type* g_telemetryKeyframes = nullptr;   /* Behind the records, same allocation */
 static TelemetryConfigSnapshot g_telemetryConfigSnapshot;
 static bool g_telemetryConfigValid = false;
-static bool g_telemetryLoggingActive = false;
-static bool g_telemetryWrapped = false;
-static uint16_t g_telemetryHead = 0;
-static uint16_t g_telemetryCount = 0;
+static std::atomic<bool> g_telemetryLoggingActive(false);
+static std::atomic<bool> g_telemetryProducerBusy(false);
+static std::atomic<uint32_t> g_telemetryNextSeq(1);
+static std::atomic<uint32_t> g_telemetryRingEpoch(0);   /* Bumped when the ring is reset or freed */
+static std::atomic<uint16_t> g_telemetryReaders(0);     /* Cursor reads walking the ring */
 static uint16_t g_telemetryEventHead = 0;
 static uint16_t g_telemetryEventCount = 0;
-static uint32_t g_telemetryNextSeq = 1;
 static uint32_t g_telemetryNextEventId = 1;
+static uint32_t g_telemetryNextKeyframe = 0;
+static uint16_t g_telemetryEventsSinceKeyframe = 0;
+static uint8_t g_telemetryKeyframeCarIndex = 0;
 static uint32_t g_telemetrySessionId = 0;
 static uint32_t g_telemetrySessionStartMs = 0;
-static uint32_t g_telemetryLastCaptureMs = 0;
+static int64_t g_telemetrySessionStartUs = 0;
+static uint32_t g_telemetrySampleInterval_us = TELEMETRY_SAMPLE_INTERVAL_US_DEFAULT;
+static uint32_t g_telemetryLastCapture_10us = 0;  /* Producer-owned */
 static uint8_t g_telemetrySessionStartCarIndex = 0;
 static uint8_t g_telemetryLastSelectedCarIndex = 0;
 static bool g_telemetryLastActiveCarValid = false;
 static CarParam_type g_telemetryLastActiveCar;
 
-static uint32_t telemetryOldestSeqLocked() {
-  if (g_telemetryCount == 0 || g_telemetryNextSeq == 0) {
-    return 0;
-  }
-  return g_telemetryNextSeq - (uint32_t)g_telemetryCount;
+static uint32_t telemetryPublishedCount(uint32_t nextSeq) {
+  return (nextSeq > 1U) ? (nextSeq - 1U) : 0U;
 }
 
-static uint32_t telemetryLatestSeqLocked() {
-  if (g_telemetryCount == 0 || g_telemetryNextSeq <= 1U) {
-    return 0;
+static uint32_t telemetryStoredCount(uint32_t nextSeq) {
+  uint32_t published = telemetryPublishedCount(nextSeq);
+  return (published < g_telemetryCapacity) ? published : g_telemetryCapacity;
+}
+
+static uint32_t telemetryOldestSeq(uint32_t nextSeq) {
+  uint32_t count = telemetryStoredCount(nextSeq);
+  return (count == 0) ? 0 : nextSeq - count;
+}
+
+static uint32_t telemetryLatestSeq(uint32_t nextSeq) {
+  return (telemetryStoredCount(nextSeq) == 0) ? 0 : nextSeq - 1U;
+}
+
+static inline uint32_t telemetrySlotForSeq(uint32_t seq) {
+  return (seq - 1U) % g_telemetryCapacity;
+}
+
+static inline bool telemetryIsBlockStart(uint32_t seq) {
+  return ((seq - 1U) % TELEMETRY_BLOCK_SAMPLES) == 0U;
+}
+
+static inline uint32_t telemetryBlockStartSeq(uint32_t seq) {
+  return seq - ((seq - 1U) % TELEMETRY_BLOCK_SAMPLES);
+}
+
+/**
+ * @brief Expand a stored sample
+ * @param t_10us [10 µs] Session time of the sample, rebuilt by the caller from its block
+ */
+void telemetryUnpackSample(const TelemetryPackedSample* packed, uint32_t seq, uint32_t t_10us, TelemetrySample* out) {
+  out->seq = seq;
+  out->t_ms = t_10us / 100U;
+  out->tFrac_us = (uint16_t)((t_10us % 100U) * 10U);
+  out->vin_mV = packed->vin_mV;
+  out->current_mA = packed->current_mA;
+  out->sensi_halfPct = packed->sensi_halfPct;
+  out->trigger_pct = packed->trigger_pct;
+  out->output_pct = packed->output_pct;
+  out->brake_pct = packed->brake_pct;
+  out->carIndex = packed->carIndex;
+  out->releaseMode = (uint8_t)(packed->modeFlags >> 6);
+  out->flags = (uint8_t)(packed->modeFlags & 0x3FU);
+  out->speed_halfPct = packed->speed_halfPct;
+}
+
+/**
+ * @brief Pack a sample for storage outside the RAM ring (the control task fills ring slots directly)
+ */
+void telemetryPackSample(const TelemetrySample* sample, uint16_t dt_10us, TelemetryPackedSample* out) {
+  out->dt_10us = dt_10us;
+  out->vin_mV = sample->vin_mV;
+  out->current_mA = sample->current_mA;
+  out->sensi_halfPct = (uint8_t)min(sample->sensi_halfPct, (uint16_t)0xFFU);
+  out->trigger_pct = sample->trigger_pct;
+  out->output_pct = sample->output_pct;
+  out->brake_pct = sample->brake_pct;
+  out->carIndex = sample->carIndex;
+  out->modeFlags = (uint8_t)(((sample->releaseMode & 0x03U) << 6) | (sample->flags & 0x3FU));
+  out->speed_halfPct = sample->speed_halfPct;
+}
+
+/**
+ * @brief Allocate the sample ring and its block table
+ * @details PSRAM when present (TELEMETRY_PSRAM_BUFFER_CAPACITY samples), otherwise internal RAM
+ *          with the classic TELEMETRY_BUFFER_CAPACITY window.
+ */
+static TelemetryPackedSample* telemetryAllocSamples(uint32_t* outCapacity, bool* outInPsram) {
+  uint32_t capacity = TELEMETRY_PSRAM_BUFFER_CAPACITY;
+  size_t bytes = (size_t)capacity * sizeof(TelemetryPackedSample) + (size_t)(capacity / TELEMETRY_BLOCK_SAMPLES) * sizeof(uint32_t);
+  void* buffer = psramFound() ? heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT) : nullptr;
+  *outInPsram = (buffer != nullptr);
+  if (buffer == nullptr) {
+    capacity = TELEMETRY_BUFFER_CAPACITY;
+    bytes = (size_t)capacity * sizeof(TelemetryPackedSample) + (size_t)(capacity / TELEMETRY_BLOCK_SAMPLES) * sizeof(uint32_t);
+    buffer = malloc(bytes);
+  }
+  *outCapacity = (buffer != nullptr) ? capacity : 0;
+  return (TelemetryPackedSample*)buffer;
+}
+
+/**
+ * @brief Stop the producer and wait until it is outside telemetryCaptureSample()
+ * @details Needed before the sample buffer is reset or freed. The producer section is a
+ *          handful of stores, so the wait is a few microseconds at most.
+ */
+static void telemetryQuiesceProducer() {
+  g_telemetryLoggingActive.store(false);
+  while (g_telemetryProducerBusy.load()) {
   }
-  return g_telemetryNextSeq - 1U;
 }
 
 static uint32_t telemetryOldestEventIdLocked() {
@@ -52,13 +187,6 @@ static uint32_t telemetryLatestEventIdLocked() {
   return g_telemetryNextEventId - 1U;
 }
 
-static uint16_t telemetryOldestIndexLocked() {
-  if (g_telemetryCount == 0) {
-    return 0;
-  }
-  return (uint16_t)((g_telemetryHead + TELEMETRY_BUFFER_CAPACITY - g_telemetryCount) % TELEMETRY_BUFFER_CAPACITY);
-}
-
 static uint16_t telemetryOldestEventIndexLocked() {
   if (g_telemetryEventCount == 0) {
     return 0;
@@ -85,9 +213,50 @@ static uint16_t telemetryComputeCarParamChangeMask(const CarParam_type* before,
   if (before->quickBrakeEnabled != after->quickBrakeEnabled) mask |= TELEMETRY_CHANGE_RELEASE_MODE;
   if (before->quickBrakeThreshold != after->quickBrakeThreshold) mask |= TELEMETRY_CHANGE_RELEASE_ZONE;
   if (before->quickBrakeStrength != after->quickBrakeStrength) mask |= TELEMETRY_CHANGE_RELEASE_LEVEL;
+  if (before->antiSpinMode != after->antiSpinMode) mask |= TELEMETRY_CHANGE_ANTI_SPIN_MODE;
+  if (before->brakeBite != after->brakeBite || before->brakeBiteHold != after->brakeBiteHold ||
+      before->brakeRamp != after->brakeRamp) mask |= TELEMETRY_CHANGE_BRAKE_ENVELOPE;
   return mask;
 }
 
+/* The numeric CarParam_type field behind a TELEMETRY_CHANGE_* bit; nullptr for the car name and envelope */
+static uint16_t* telemetryCarParamField(CarParam_type* carParam, uint16_t changeBit) {
+  switch (changeBit) {
+    case TELEMETRY_CHANGE_MIN_SPEED:      return &carParam->minSpeed;
+    case TELEMETRY_CHANGE_BRAKE:          return &carParam->brake;
+    case TELEMETRY_CHANGE_MAX_SPEED:      return &carParam->maxSpeed;
+    case TELEMETRY_CHANGE_CURVE_INPUT:    return &carParam->throttleCurveVertex.inputThrottle;
+    case TELEMETRY_CHANGE_CURVE_DIFF:     return &carParam->throttleCurveVertex.curveSpeedDiff;
+    case TELEMETRY_CHANGE_FADE:           return &carParam->fade;
+    case TELEMETRY_CHANGE_ANTI_SPIN:      return &carParam->antiSpin;
+    case TELEMETRY_CHANGE_FREQ_PWM:       return &carParam->freqPWM;
+    case TELEMETRY_CHANGE_BRAKE_BUTTON:   return &carParam->brakeButtonReduction;
+    case TELEMETRY_CHANGE_RELEASE_MODE:   return &carParam->quickBrakeEnabled;
+    case TELEMETRY_CHANGE_RELEASE_ZONE:   return &carParam->quickBrakeThreshold;
+    case TELEMETRY_CHANGE_RELEASE_LEVEL:  return &carParam->quickBrakeStrength;
+    case TELEMETRY_CHANGE_ANTI_SPIN_MODE: return &carParam->antiSpinMode;
+    default:                              return nullptr;
+  }
+}
+
+/**
+ * @brief Start a new keyframe from carParam
+ * @details The slot it reuses may still be the base of the oldest records; those go first.
+ */
+static uint16_t telemetryWriteKeyframeLocked(uint8_t carIndex, const CarParam_type* carParam) {
+  uint32_t number = g_telemetryNextKeyframe++;
+  if (number >= TELEMETRY_EVENT_KEYFRAMES) {
+    uint16_t evicted = (uint16_t)(number - TELEMETRY_EVENT_KEYFRAMES);
+    while (g_telemetryEventCount > 0 && g_telemetryEvents[telemetryOldestEventIndexLocked()].keyframe == evicted) {
+      g_telemetryEventCount--;
+    }
+  }
+  g_telemetryKeyframes[number % TELEMETRY_EVENT_KEYFRAMES] = *carParam;
+  g_telemetryKeyframeCarIndex = carIndex;
+  g_telemetryEventsSinceKeyframe = 0;
+  return (uint16_t)number;
+}
+
 static void telemetryRecordEventLocked(uint8_t type,
                                        uint32_t tMs,
                                        uint32_t sampleSeq,
@@ -99,67 +268,123 @@ static void telemetryRecordEventLocked(uint8_t type,
     return;
   }
 
-  TelemetryEvent event;
-  event.id = g_telemetryNextEventId++;
+  TelemetryEventRecord_type record;
+  memset(&record, 0, sizeof(record));
+  record.t_ms = tMs;
+  record.sampleSeq = sampleSeq;
+  record.changedMask = changedMask;
+  record.type = type;
+  record.carIndex = carIndex;
+  record.previousCarIndex = previousCarIndex;
+
+  uint16_t keyframe = (uint16_t)(g_telemetryNextKeyframe - 1U);
+  uint16_t deltaMask = 0U;
+  bool needKeyframe = (g_telemetryNextKeyframe == 0U) ||
+                      (type == TELEMETRY_EVENT_CAR_SELECT) ||
+                      (carIndex != g_telemetryKeyframeCarIndex) ||
+                      (g_telemetryEventsSinceKeyframe >= TELEMETRY_EVENT_KEYFRAME_EVERY);
+  if (!needKeyframe) {
+    deltaMask = telemetryComputeCarParamChangeMask(&g_telemetryKeyframes[keyframe % TELEMETRY_EVENT_KEYFRAMES], carParam);
+    needKeyframe = (deltaMask & (TELEMETRY_CHANGE_CAR_NAME | TELEMETRY_CHANGE_BRAKE_ENVELOPE)) != 0U ||
+                   __builtin_popcount(deltaMask) > (int)TELEMETRY_EVENT_DELTA_FIELDS;
+  }
+  if (needKeyframe) {
+    keyframe = telemetryWriteKeyframeLocked(carIndex, carParam);
+    deltaMask = 0U;
+  } else {
+    CarParam_type source = *carParam;
+    uint8_t n = 0;
+    for (uint16_t bit = 1U; bit != 0U && n < TELEMETRY_EVENT_DELTA_FIELDS; bit <<= 1) {
+      if ((deltaMask & bit) != 0U) {
+        record.delta[n++] = *telemetryCarParamField(&source, bit);
+      }
+    }
+  }
+  record.keyframe = keyframe;
+  record.deltaMask = deltaMask;
+  g_telemetryEventsSinceKeyframe++;
+
+  g_telemetryNextEventId++;
   if (g_telemetryNextEventId == 0U) {
     g_telemetryNextEventId = 1U;
   }
-  event.t_ms = tMs;
-  event.sampleSeq = sampleSeq;
-  event.changedMask = changedMask;
-  event.type = type;
-  event.carIndex = carIndex;
-  event.previousCarIndex = previousCarIndex;
-  event.carParam = *carParam;
-
-  g_telemetryEvents[g_telemetryEventHead] = event;
+  g_telemetryEvents[g_telemetryEventHead] = record;
   g_telemetryEventHead = (uint16_t)((g_telemetryEventHead + 1U) % TELEMETRY_EVENT_BUFFER_CAPACITY);
   if (g_telemetryEventCount < TELEMETRY_EVENT_BUFFER_CAPACITY) {
     g_telemetryEventCount++;
   }
 }
 
+/**
+ * @brief Rebuild the full event stored in record slot index
+ */
+static void telemetryExpandEventLocked(uint16_t index, uint32_t id, TelemetryEvent* out) {
+  const TelemetryEventRecord_type* record = &g_telemetryEvents[index];
+  out->id = id;
+  out->t_ms = record->t_ms;
+  out->sampleSeq = record->sampleSeq;
+  out->changedMask = record->changedMask;
+  out->type = record->type;
+  out->carIndex = record->carIndex;
+  out->previousCarIndex = record->previousCarIndex;
+  out->carParam = g_telemetryKeyframes[record->keyframe % TELEMETRY_EVENT_KEYFRAMES];
+  uint8_t n = 0;
+  for (uint16_t bit = 1U; bit != 0U && n < TELEMETRY_EVENT_DELTA_FIELDS; bit <<= 1) {
+    if ((record->deltaMask & bit) != 0U) {
+      *telemetryCarParamField(&out->carParam, bit) = record->delta[n++];
+    }
+  }
+}
+
 static void telemetryFillStatusLocked(TelemetryStatus* outStatus) {
   if (outStatus == nullptr) {
     return;
   }
+  uint32_t nextSeq = g_telemetryNextSeq.load(std::memory_order_acquire);
+  uint32_t storedCount = telemetryStoredCount(nextSeq);
   outStatus->sessionId = g_telemetrySessionId;
   outStatus->sessionStartMs = g_telemetrySessionStartMs;
-  outStatus->oldestSeq = telemetryOldestSeqLocked();
-  outStatus->latestSeq = telemetryLatestSeqLocked();
+  outStatus->oldestSeq = telemetryOldestSeq(nextSeq);
+  outStatus->latestSeq = telemetryLatestSeq(nextSeq);
   outStatus->oldestEventId = telemetryOldestEventIdLocked();
   outStatus->latestEventId = telemetryLatestEventIdLocked();
-  outStatus->storedCount = g_telemetryCount;
-  outStatus->capacity = TELEMETRY_BUFFER_CAPACITY;
+  outStatus->storedCount = storedCount;
+  outStatus->capacity = (g_telemetryCapacity > 0) ? g_telemetryCapacity : TELEMETRY_BUFFER_CAPACITY;
   outStatus->eventCount = g_telemetryEventCount;
   outStatus->eventCapacity = TELEMETRY_EVENT_BUFFER_CAPACITY;
-  outStatus->sampleRateMs = TELEMETRY_SAMPLE_INTERVAL_MS;
+  outStatus->sampleRateMs = (uint16_t)((g_telemetrySampleInterval_us + 999UL) / 1000UL);
+  outStatus->sampleIntervalUs = g_telemetrySampleInterval_us;
+  outStatus->psram = g_telemetryInPsram;
   outStatus->sessionStartCarIndex = g_telemetrySessionStartCarIndex;
-  outStatus->loggingActive = g_telemetryLoggingActive;
-  outStatus->hasData = (g_telemetryCount > 0);
-  outStatus->wrapped = g_telemetryWrapped;
+  outStatus->loggingActive = g_telemetryLoggingActive.load();
+  outStatus->hasData = (storedCount > 0);
+  outStatus->wrapped = telemetryPublishedCount(nextSeq) > g_telemetryCapacity;
 }
 
 bool telemetryStartLogging(const StoredVar_type* storedVar,
                            uint16_t antiSpinStepMs,
                            uint16_t encoderInvertEnabled,
                            uint16_t adcVoltageRange_mV,
-                           uint8_t activeCarIndex) {
+                           uint8_t activeCarIndex,
+                           uint32_t sampleInterval_us) {
   if (storedVar == nullptr || activeCarIndex >= CAR_MAX_COUNT) {
     return false;
   }
+  sampleInterval_us = constrain(sampleInterval_us, TELEMETRY_SAMPLE_INTERVAL_US_MIN, TELEMETRY_SAMPLE_INTERVAL_US_MAX);
 
-  uint32_t nowMs = millis();
-  TelemetrySample* allocatedBuffer = g_telemetrySamples;
-  TelemetryEvent* allocatedEventBuffer = g_telemetryEvents;
+  TelemetryPackedSample* allocatedBuffer = g_telemetrySamples;
+  uint32_t allocatedCapacity = g_telemetryCapacity;
+  bool allocatedInPsram = g_telemetryInPsram;
+  TelemetryEventRecord_type* allocatedEventBuffer = g_telemetryEvents;
   if (allocatedBuffer == nullptr) {
-    allocatedBuffer = (TelemetrySample*)malloc(sizeof(TelemetrySample) * TELEMETRY_BUFFER_CAPACITY);
+    allocatedBuffer = telemetryAllocSamples(&allocatedCapacity, &allocatedInPsram);
     if (allocatedBuffer == nullptr) {
       return false;
     }
   }
   if (allocatedEventBuffer == nullptr) {
-    allocatedEventBuffer = (TelemetryEvent*)malloc(sizeof(TelemetryEvent) * TELEMETRY_EVENT_BUFFER_CAPACITY);
+    allocatedEventBuffer = (TelemetryEventRecord_type*)malloc(sizeof(TelemetryEventRecord_type) * TELEMETRY_EVENT_BUFFER_CAPACITY +
+                                                              sizeof(CarParam_type) * TELEMETRY_EVENT_KEYFRAMES);
     if (allocatedEventBuffer == nullptr) {
       if (g_telemetrySamples == nullptr && allocatedBuffer != nullptr) {
         free(allocatedBuffer);
@@ -168,12 +393,20 @@ bool telemetryStartLogging(const StoredVar_type* storedVar,
     }
   }
 
+  telemetryQuiesceProducer();
+  uint32_t nowMs = millis();
+  int64_t nowUs = esp_timer_get_time();
+
   portENTER_CRITICAL(&g_telemetryMux);
   if (g_telemetrySamples == nullptr) {
     g_telemetrySamples = allocatedBuffer;
+    g_telemetryCapacity = allocatedCapacity;
+    g_telemetryInPsram = allocatedInPsram;
+    g_telemetryBlockBase_10us = (uint32_t*)(allocatedBuffer + allocatedCapacity);
   }
   if (g_telemetryEvents == nullptr) {
     g_telemetryEvents = allocatedEventBuffer;
+    g_telemetryKeyframes = (CarParam_type*)(allocatedEventBuffer + TELEMETRY_EVENT_BUFFER_CAPACITY);
   }
   bool shouldFreeTempBuffer = (allocatedBuffer != nullptr && g_telemetrySamples != allocatedBuffer);
   bool shouldFreeTempEventBuffer = (allocatedEventBuffer != nullptr && g_telemetryEvents != allocatedEventBuffer);
@@ -183,24 +416,26 @@ bool telemetryStartLogging(const StoredVar_type* storedVar,
   g_telemetryConfigSnapshot.adcVoltageRange_mV = adcVoltageRange_mV;
   g_telemetryConfigValid = true;
 
-  g_telemetryHead = 0;
-  g_telemetryCount = 0;
+  g_telemetryRingEpoch.fetch_add(1);
+  g_telemetryNextSeq.store(1, std::memory_order_relaxed);
   g_telemetryEventHead = 0;
   g_telemetryEventCount = 0;
-  g_telemetryWrapped = false;
-  g_telemetryNextSeq = 1;
   g_telemetryNextEventId = 1;
+  g_telemetryNextKeyframe = 0;
+  g_telemetryEventsSinceKeyframe = 0;
   g_telemetrySessionStartMs = nowMs;
-  g_telemetryLastCaptureMs = 0;
+  g_telemetrySessionStartUs = nowUs;
+  g_telemetrySampleInterval_us = sampleInterval_us;
+  g_telemetryLastCapture_10us = 0;
   g_telemetrySessionStartCarIndex = activeCarIndex;
   g_telemetryLastSelectedCarIndex = activeCarIndex;
-  g_telemetryLastActiveCar = storedVar->carParam[activeCarIndex];
+  g_telemetryLastActiveCar = storedVar->activeCar;
   g_telemetryLastActiveCarValid = true;
   g_telemetrySessionId++;
   if (g_telemetrySessionId == 0) {
     g_telemetrySessionId = 1;
   }
-  g_telemetryLoggingActive = true;
+  g_telemetryLoggingActive.store(true);  /* Releases the reset state above to the producer */
   portEXIT_CRITICAL(&g_telemetryMux);
 
   if (shouldFreeTempBuffer) {
@@ -214,35 +449,43 @@ bool telemetryStartLogging(const StoredVar_type* storedVar,
 }
 
 void telemetryStopLogging() {
-  portENTER_CRITICAL(&g_telemetryMux);
-  g_telemetryLoggingActive = false;
-  portEXIT_CRITICAL(&g_telemetryMux);
+  g_telemetryLoggingActive.store(false);
 }
 
 void telemetryClear() {
-  TelemetrySample* bufferToFree = nullptr;
-  TelemetryEvent* eventBufferToFree = nullptr;
+  TelemetryPackedSample* bufferToFree = nullptr;
+  TelemetryEventRecord_type* eventBufferToFree = nullptr;
+  telemetryQuiesceProducer();
   portENTER_CRITICAL(&g_telemetryMux);
-  g_telemetryLoggingActive = false;
   bufferToFree = g_telemetrySamples;
   eventBufferToFree = g_telemetryEvents;
   g_telemetrySamples = nullptr;
+  g_telemetryBlockBase_10us = nullptr;
+  g_telemetryCapacity = 0;
+  g_telemetryInPsram = false;
   g_telemetryEvents = nullptr;
-  g_telemetryHead = 0;
-  g_telemetryCount = 0;
+  g_telemetryKeyframes = nullptr;
+  g_telemetryRingEpoch.fetch_add(1);
+  g_telemetryNextSeq.store(1, std::memory_order_relaxed);
   g_telemetryEventHead = 0;
   g_telemetryEventCount = 0;
-  g_telemetryWrapped = false;
-  g_telemetryNextSeq = 1;
   g_telemetryNextEventId = 1;
+  g_telemetryNextKeyframe = 0;
+  g_telemetryEventsSinceKeyframe = 0;
   g_telemetrySessionStartMs = 0;
-  g_telemetryLastCaptureMs = 0;
+  g_telemetrySessionStartUs = 0;
+  g_telemetryLastCapture_10us = 0;
   g_telemetrySessionStartCarIndex = 0;
   g_telemetryLastSelectedCarIndex = 0;
   g_telemetryLastActiveCarValid = false;
   g_telemetryConfigValid = false;
   portEXIT_CRITICAL(&g_telemetryMux);
 
+  /* A cursor read that took the buffer before it was unhooked may still be walking it.
+     Yield rather than spin: the reader can be a lower priority task on this core. */
+  while (g_telemetryReaders.load() > 0) {
+    vTaskDelay(1);
+  }
   if (bufferToFree != nullptr) {
     free(bufferToFree);
   }
@@ -252,19 +495,11 @@ void telemetryClear() {
 }
 
 bool telemetryIsLoggingActive() {
-  bool active = false;
-  portENTER_CRITICAL(&g_telemetryMux);
-  active = g_telemetryLoggingActive;
-  portEXIT_CRITICAL(&g_telemetryMux);
-  return active;
+  return g_telemetryLoggingActive.load();
 }
 
 bool telemetryHasData() {
-  bool hasData = false;
-  portENTER_CRITICAL(&g_telemetryMux);
-  hasData = (g_telemetryCount > 0);
-  portEXIT_CRITICAL(&g_telemetryMux);
-  return hasData;
+  return telemetryStoredCount(g_telemetryNextSeq.load(std::memory_order_acquire)) > 0;
 }
 
 void telemetryGetStatus(TelemetryStatus* outStatus) {
@@ -290,95 +525,268 @@ bool telemetryGetConfigSnapshot(TelemetryConfigSnapshot* outSnapshot) {
   return hasSnapshot;
 }
 
-size_t telemetryCopySamplesAfter(uint32_t afterSeq,
-                                 TelemetrySample* outSamples,
-                                 size_t maxSamples,
-                                 bool* outTruncated,
-                                 bool* outHasMore,
-                                 TelemetryStatus* outStatus) {
-  bool truncated = false;
-  bool hasMore = false;
-  size_t copied = 0;
-
-  portENTER_CRITICAL(&g_telemetryMux);
+/**
+ * @brief Position a cursor
+ * @param sessionId Session to follow, 0 for whichever is current at the first read
+ */
+void telemetryCursorBegin(TelemetryCursor_type* cursor, uint32_t sessionId, uint32_t afterSeq, uint32_t afterEventId) {
+  if (cursor == nullptr) {
+    return;
+  }
+  memset(cursor, 0, sizeof(*cursor));
+  cursor->sessionId = sessionId;
+  cursor->afterSeq = afterSeq;
+  cursor->afterEventId = afterEventId;
+}
 
-  telemetryFillStatusLocked(outStatus);
+/* A cursor only ever reads the session it is bound to; seqs and event ids restart with a new one */
+static bool telemetryCursorAttachLocked(TelemetryCursor_type* cursor) {
+  if (cursor->sessionId == 0) {
+    cursor->sessionId = g_telemetrySessionId;
+  }
+  return cursor->sessionId == g_telemetrySessionId;
+}
 
-  if (g_telemetryCount > 0 && outSamples != nullptr && maxSamples > 0) {
-    uint32_t oldestSeq = telemetryOldestSeqLocked();
-    uint32_t latestSeq = telemetryLatestSeqLocked();
-    uint16_t oldestIndex = telemetryOldestIndexLocked();
-    uint32_t firstSeq = afterSeq + 1U;
+/**
+ * @brief First seq at or after firstSeq whose block the producer is not about to reuse
+ * @details Writing seq nextSeq reuses the slot of nextSeq - capacity, and a block start also
+ *          its block base, so a walk can only start in a block that begins after that.
+ */
+static uint32_t telemetryCursorFirstValidSeq(uint32_t firstSeq, uint32_t nextSeq, uint32_t capacity) {
+  uint32_t firstSafeSeq = (nextSeq + 1U > capacity) ? (nextSeq + 1U - capacity) : 1U;
+  if (telemetryBlockStartSeq(firstSeq) >= firstSafeSeq) {
+    return firstSeq;
+  }
+  return telemetryIsBlockStart(firstSafeSeq) ? firstSafeSeq : telemetryBlockStartSeq(firstSafeSeq) + TELEMETRY_BLOCK_SAMPLES;
+}
 
-    if (firstSeq < oldestSeq) {
-      firstSeq = oldestSeq;
-      truncated = true;
+/**
+ * @brief Visit the samples after cursor->afterSeq in place, oldest first
+ * @details Runs concurrently with the producer and takes the mux only to pick up the ring.
+ *          Each sample is decoded from its slot (time rebuilt from the block base on) and
+ *          checked against the write position before visit sees it. If the producer laps the
+ *          reader, the cursor skips to the oldest block still intact and adds the gap to
+ *          cursor->lost. A reset or clear of the ring ends the read. telemetryClear() waits
+ *          for running reads, so visit must not block: consumers that write to a network
+ *          or flash sink copy a bounded batch out and write it after the read returns.
+ * @param untilSeq Last seq wanted, 0 for the newest
+ * @param outStatus Optional: ring status when the read started
+ * @return Samples visited (and consumed)
+ */
+size_t telemetryCursorRead(TelemetryCursor_type* cursor,
+                           uint32_t untilSeq,
+                           size_t maxSamples,
+                           TelemetrySampleVisit_fn visit,
+                           void* ctx,
+                           TelemetryStatus* outStatus) {
+  if (cursor == nullptr || visit == nullptr) {
+    if (outStatus != nullptr) {
+      telemetryGetStatus(outStatus);
     }
+    return 0;
+  }
+  cursor->truncated = false;
+  cursor->hasMore = false;
+  size_t visited = 0;
 
-    if (firstSeq <= latestSeq) {
-      size_t available = (size_t)(latestSeq - firstSeq + 1U);
-      copied = (available < maxSamples) ? available : maxSamples;
+  g_telemetryReaders.fetch_add(1);
+  portENTER_CRITICAL(&g_telemetryMux);
+  telemetryFillStatusLocked(outStatus);
+  bool attached = telemetryCursorAttachLocked(cursor);
+  const TelemetryPackedSample* samples = g_telemetrySamples;
+  const uint32_t* blockBase_10us = g_telemetryBlockBase_10us;
+  uint32_t capacity = g_telemetryCapacity;
+  uint32_t epoch = g_telemetryRingEpoch.load(std::memory_order_relaxed);
+  uint32_t nextSeq = g_telemetryNextSeq.load(std::memory_order_acquire);
+  uint32_t latestSeq = telemetryLatestSeq(nextSeq);
+  portEXIT_CRITICAL(&g_telemetryMux);
 
-      for (size_t i = 0; i < copied; i++) {
-        uint32_t seq = firstSeq + (uint32_t)i;
-        uint16_t offset = (uint16_t)(seq - oldestSeq);
-        uint16_t index = (uint16_t)((oldestIndex + offset) % TELEMETRY_BUFFER_CAPACITY);
-        outSamples[i] = g_telemetrySamples[index];
+  if (!attached) {
+    cursor->truncated = true;    /* The session it followed has been replaced */
+  } else if (samples != nullptr && latestSeq > 0) {
+    if (untilSeq != 0 && untilSeq < latestSeq) {
+      latestSeq = untilSeq;
+    }
+    bool stopped = false;
+    bool reset = false;
+    while (!stopped && cursor->afterSeq < latestSeq && visited < maxSamples) {
+      uint32_t firstSeq = telemetryCursorFirstValidSeq(cursor->afterSeq + 1U, nextSeq, capacity);
+      if (firstSeq != cursor->afterSeq + 1U) {
+        cursor->lost += firstSeq - cursor->afterSeq - 1U;
+        cursor->afterSeq = firstSeq - 1U;
+        cursor->truncated = true;
+        continue;
       }
 
-      hasMore = (firstSeq + (uint32_t)copied - 1U) < latestSeq;
+      /* Walk from the start of the block to recover absolute time */
+      uint32_t anchorSeq = telemetryBlockStartSeq(firstSeq);
+      uint32_t t_10us = 0;
+      for (uint32_t seq = anchorSeq; seq <= latestSeq && visited < maxSamples; seq++) {
+        uint32_t slot = (seq - 1U) % capacity;
+        const TelemetryPackedSample* packed = &samples[slot];
+        if (telemetryIsBlockStart(seq)) {
+          anchorSeq = seq;
+          t_10us = blockBase_10us[slot / TELEMETRY_BLOCK_SAMPLES];
+        } else {
+          t_10us += packed->dt_10us;
+        }
+        if (seq < firstSeq) {
+          continue;
+        }
+        TelemetrySample sample;
+        telemetryUnpackSample(packed, seq, t_10us, &sample);
+
+        /* Everything decoded since anchorSeq is intact while the producer is writing short of its slot */
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (g_telemetryRingEpoch.load(std::memory_order_relaxed) != epoch) {
+          reset = true;
+          break;
+        }
+        nextSeq = g_telemetryNextSeq.load(std::memory_order_relaxed);
+        if (anchorSeq + capacity <= nextSeq) {
+          break;                   /* Lapped: the outer loop skips ahead */
+        }
+        if (!visit(ctx, &sample)) {
+          stopped = true;
+          break;
+        }
+        cursor->afterSeq = seq;
+        visited++;
+      }
+      stopped = stopped || reset;
     }
+    cursor->truncated = cursor->truncated || reset;
+    cursor->hasMore = !reset && cursor->afterSeq < latestSeq;
   }
 
-  portEXIT_CRITICAL(&g_telemetryMux);
+  g_telemetryReaders.fetch_sub(1);
+  return visited;
+}
 
-  if (outTruncated != nullptr) {
-    *outTruncated = truncated;
-  }
-  if (outHasMore != nullptr) {
-    *outHasMore = hasMore;
+/**
+ * @brief Visit the events after cursor->afterEventId, oldest first
+ * @details Records are expanded one at a time under the mux onto the stack and visited
+ *          outside it. Sets cursor->truncated if events after the position were overwritten.
+ * @param untilId Last event id wanted, 0 for the newest
+ */
+size_t telemetryCursorReadEvents(TelemetryCursor_type* cursor,
+                                 uint32_t untilId,
+                                 size_t maxEvents,
+                                 TelemetryEventVisit_fn visit,
+                                 void* ctx) {
+  if (cursor == nullptr || visit == nullptr) {
+    return 0;
   }
+  cursor->truncated = false;
+  size_t visited = 0;
+
+  while (visited < maxEvents) {
+    TelemetryEvent event;
+    bool found = false;
+    portENTER_CRITICAL(&g_telemetryMux);
+    if (!telemetryCursorAttachLocked(cursor)) {
+      cursor->truncated = true;
+    } else if (g_telemetryEvents != nullptr && g_telemetryEventCount > 0) {
+      uint32_t oldestId = telemetryOldestEventIdLocked();
+      uint32_t latestId = telemetryLatestEventIdLocked();
+      if (untilId != 0 && untilId < latestId) {
+        latestId = untilId;
+      }
+      uint32_t id = cursor->afterEventId + 1U;
+      if (id < oldestId) {
+        cursor->truncated = cursor->truncated || cursor->afterEventId != 0;
+        id = oldestId;
+      }
+      if (id <= latestId) {
+        uint16_t index = (uint16_t)((telemetryOldestEventIndexLocked() + (id - oldestId)) % TELEMETRY_EVENT_BUFFER_CAPACITY);
+        telemetryExpandEventLocked(index, id, &event);
+        found = true;
+      }
+    }
+    portEXIT_CRITICAL(&g_telemetryMux);
 
-  return copied;
+    if (!found || !visit(ctx, &event)) {
+      break;
+    }
+    cursor->afterEventId = event.id;
+    visited++;
+  }
+  return visited;
 }
 
-size_t telemetryCopyEvents(TelemetryEvent* outEvents,
-                           size_t maxEvents,
-                           bool* outTruncated,
-                           TelemetryStatus* outStatus) {
-  bool truncated = false;
-  size_t copied = 0;
-
-  portENTER_CRITICAL(&g_telemetryMux);
-
-  telemetryFillStatusLocked(outStatus);
+/**
+ * @brief Record car selection / parameter change events for the active car
+ * @details Consumer side: call periodically from Task1. Events carry the seq of the next
+ *          sample, i.e. the first sample recorded with the new settings.
+ */
+void telemetryServiceEvents(uint8_t carIndex, const CarParam_type* activeCarParam) {
+  if (carIndex >= CAR_MAX_COUNT || activeCarParam == nullptr || !g_telemetryLoggingActive.load()) {
+    return;
+  }
 
-  if (g_telemetryEventCount > 0 && outEvents != nullptr && maxEvents > 0) {
-    uint16_t oldestIndex = telemetryOldestEventIndexLocked();
-    size_t available = g_telemetryEventCount;
-    copied = (available < maxEvents) ? available : maxEvents;
-    if (available > maxEvents) {
-      truncated = true;
-      oldestIndex = (uint16_t)((oldestIndex + (available - maxEvents)) % TELEMETRY_EVENT_BUFFER_CAPACITY);
-    }
+  CarParam_type carParam = *activeCarParam;  /* Local copy: the UI/web may be editing it */
 
-    for (size_t i = 0; i < copied; i++) {
-      uint16_t index = (uint16_t)((oldestIndex + i) % TELEMETRY_EVENT_BUFFER_CAPACITY);
-      outEvents[i] = g_telemetryEvents[index];
+  portENTER_CRITICAL(&g_telemetryMux);
+  uint32_t sampleSeq = g_telemetryNextSeq.load(std::memory_order_acquire);
+  uint32_t relativeTimeMs = millis() - g_telemetrySessionStartMs;
+  if (!g_telemetryLastActiveCarValid) {
+    g_telemetryLastSelectedCarIndex = carIndex;
+    g_telemetryLastActiveCar = carParam;
+    g_telemetryLastActiveCarValid = true;
+  } else if (g_telemetryLastSelectedCarIndex != carIndex) {
+    telemetryRecordEventLocked(TELEMETRY_EVENT_CAR_SELECT,
+                               relativeTimeMs,
+                               sampleSeq,
+                               carIndex,
+                               g_telemetryLastSelectedCarIndex,
+                               0U,
+                               &carParam);
+    g_telemetryLastSelectedCarIndex = carIndex;
+    g_telemetryLastActiveCar = carParam;
+  } else {
+    uint16_t changedMask = telemetryComputeCarParamChangeMask(&g_telemetryLastActiveCar, &carParam);
+    if (changedMask != 0U) {
+      telemetryRecordEventLocked(TELEMETRY_EVENT_CAR_PARAMS,
+                                 relativeTimeMs,
+                                 sampleSeq,
+                                 carIndex,
+                                 g_telemetryLastSelectedCarIndex,
+                                 changedMask,
+                                 &carParam);
+      g_telemetryLastActiveCar = carParam;
     }
   }
-
   portEXIT_CRITICAL(&g_telemetryMux);
+}
 
-  if (outTruncated != nullptr) {
-    *outTruncated = truncated;
+/**
+ * @brief Record control deadline overruns reported by the control loop (Task1)
+ * @param overruns New overruns since the previous event, kept in changedMask
+ */
+void telemetryRecordDeadlineEvent(uint8_t carIndex, const CarParam_type* activeCarParam, uint16_t overruns) {
+  if (carIndex >= CAR_MAX_COUNT || activeCarParam == nullptr || !g_telemetryLoggingActive.load()) {
+    return;
   }
 
-  return copied;
+  CarParam_type carParam = *activeCarParam;
+
+  portENTER_CRITICAL(&g_telemetryMux);
+  telemetryRecordEventLocked(TELEMETRY_EVENT_DEADLINE,
+                             millis() - g_telemetrySessionStartMs,
+                             g_telemetryNextSeq.load(std::memory_order_acquire),
+                             carIndex,
+                             carIndex,
+                             overruns,
+                             &carParam);
+  portEXIT_CRITICAL(&g_telemetryMux);
 }
 
+/**
+ * @brief Append one sample (producer side, control task)
+ * @details Lock-free: a few stores into the ring slot followed by a release of the new
+ *          write position. Never waits on readers.
+ */
 void telemetryCaptureSample(uint8_t carIndex,
-                            const CarParam_type* activeCarParam,
                             uint8_t triggerPct,
                             uint8_t outputPct,
                             uint16_t vin_mV,
@@ -386,84 +794,48 @@ void telemetryCaptureSample(uint8_t carIndex,
                             uint8_t brakePct,
                             uint16_t sensi_halfPct,
                             uint8_t releaseMode,
-                            uint8_t flags) {
+                            uint8_t flags,
+                            uint8_t speed_halfPct) {
   if (carIndex >= CAR_MAX_COUNT) {
     return;
   }
 
-  uint32_t nowMs = millis();
-
-  portENTER_CRITICAL(&g_telemetryMux);
-
-  if (!g_telemetryLoggingActive) {
-    portEXIT_CRITICAL(&g_telemetryMux);
-    return;
-  }
-
-  if (g_telemetrySamples == nullptr) {
-    g_telemetryLoggingActive = false;
-    portEXIT_CRITICAL(&g_telemetryMux);
+  g_telemetryProducerBusy.store(true);
+  if (!g_telemetryLoggingActive.load() || g_telemetrySamples == nullptr) {
+    g_telemetryProducerBusy.store(false);
     return;
   }
 
-  if (g_telemetryCount > 0 && (uint32_t)(nowMs - g_telemetryLastCaptureMs) < TELEMETRY_SAMPLE_INTERVAL_MS) {
-    portEXIT_CRITICAL(&g_telemetryMux);
+  uint32_t now_10us = (uint32_t)((esp_timer_get_time() - g_telemetrySessionStartUs) / 10);
+  uint32_t sampleSeq = g_telemetryNextSeq.load(std::memory_order_relaxed);
+  uint32_t elapsed_10us = now_10us - g_telemetryLastCapture_10us;
+  /* Half a control tick of slack so "every tick" is not defeated by scheduling jitter */
+  uint32_t interval_10us = (g_telemetrySampleInterval_us - (ESC_PERIOD_US / 2U)) / 10U;
+  if (sampleSeq > 1U && elapsed_10us < interval_10us) {
+    g_telemetryProducerBusy.store(false);
     return;
   }
 
-  uint32_t sampleSeq = g_telemetryNextSeq;
-  uint32_t relativeTimeMs = nowMs - g_telemetrySessionStartMs;
-  if (activeCarParam != nullptr) {
-    if (!g_telemetryLastActiveCarValid) {
-      g_telemetryLastSelectedCarIndex = carIndex;
-      g_telemetryLastActiveCar = *activeCarParam;
-      g_telemetryLastActiveCarValid = true;
-    } else if (g_telemetryLastSelectedCarIndex != carIndex) {
-      telemetryRecordEventLocked(TELEMETRY_EVENT_CAR_SELECT,
-                                 relativeTimeMs,
-                                 sampleSeq,
-                                 carIndex,
-                                 g_telemetryLastSelectedCarIndex,
-                                 0U,
-                                 activeCarParam);
-      g_telemetryLastSelectedCarIndex = carIndex;
-      g_telemetryLastActiveCar = *activeCarParam;
-    } else {
-      uint16_t changedMask = telemetryComputeCarParamChangeMask(&g_telemetryLastActiveCar, activeCarParam);
-      if (changedMask != 0U) {
-        telemetryRecordEventLocked(TELEMETRY_EVENT_CAR_PARAMS,
-                                   relativeTimeMs,
-                                   sampleSeq,
-                                   carIndex,
-                                   g_telemetryLastSelectedCarIndex,
-                                   changedMask,
-                                   activeCarParam);
-        g_telemetryLastActiveCar = *activeCarParam;
-      }
-    }
-  }
-
-  TelemetrySample sample;
-  sample.seq = g_telemetryNextSeq++;
-  sample.t_ms = relativeTimeMs;
-  sample.vin_mV = vin_mV;
-  sample.current_mA = current_mA;
-  sample.sensi_halfPct = sensi_halfPct;
-  sample.trigger_pct = triggerPct;
-  sample.output_pct = outputPct;
-  sample.brake_pct = brakePct;
-  sample.carIndex = carIndex;
-  sample.releaseMode = releaseMode;
-  sample.flags = flags;
-
-  g_telemetrySamples[g_telemetryHead] = sample;
-  g_telemetryHead = (uint16_t)((g_telemetryHead + 1U) % TELEMETRY_BUFFER_CAPACITY);
-  if (g_telemetryCount < TELEMETRY_BUFFER_CAPACITY) {
-    g_telemetryCount++;
+  uint32_t slot = telemetrySlotForSeq(sampleSeq);
+  TelemetryPackedSample* sample = &g_telemetrySamples[slot];
+  if (telemetryIsBlockStart(sampleSeq)) {
+    g_telemetryBlockBase_10us[slot / TELEMETRY_BLOCK_SAMPLES] = now_10us;
+    sample->dt_10us = 0;
   } else {
-    g_telemetryWrapped = true;
-  }
-  g_telemetryLastCaptureMs = nowMs;
-
-  portEXIT_CRITICAL(&g_telemetryMux);
+    sample->dt_10us = (uint16_t)((elapsed_10us < TELEMETRY_DT_MAX_10US) ? elapsed_10us : TELEMETRY_DT_MAX_10US);
+    now_10us = g_telemetryLastCapture_10us + sample->dt_10us;  /* Keep decoded time consistent if clamped */
+  }
+  sample->vin_mV = vin_mV;
+  sample->current_mA = current_mA;
+  sample->sensi_halfPct = (uint8_t)min(sensi_halfPct, (uint16_t)0xFFU);
+  sample->trigger_pct = triggerPct;
+  sample->output_pct = outputPct;
+  sample->brake_pct = brakePct;
+  sample->carIndex = carIndex;
+  sample->modeFlags = (uint8_t)(((releaseMode & 0x03U) << 6) | (flags & 0x3FU));
+  sample->speed_halfPct = speed_halfPct;
+  g_telemetryNextSeq.store(sampleSeq + 1U, std::memory_order_release);
+  g_telemetryLastCapture_10us = now_10us;
+
+  g_telemetryProducerBusy.store(false);
 }
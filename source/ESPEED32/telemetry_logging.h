@@ -6,18 +6,32 @@
 #include <Arduino.h>
 #include "slot_ESC.h"
 
-#define TELEMETRY_SAMPLE_INTERVAL_MS 20U
-#define TELEMETRY_BUFFER_CAPACITY    3000U
-#define TELEMETRY_EVENT_BUFFER_CAPACITY 128U
+#define TELEMETRY_SAMPLE_INTERVAL_MS 20U     /* Default capture interval */
+#define TELEMETRY_SAMPLE_INTERVAL_US_DEFAULT  (TELEMETRY_SAMPLE_INTERVAL_MS * 1000UL)
+#define TELEMETRY_SAMPLE_INTERVAL_US_MIN      ESC_PERIOD_US   /* Every control tick */
+#define TELEMETRY_SAMPLE_INTERVAL_US_MAX      100000UL
+#define TELEMETRY_BUFFER_CAPACITY    3000U   /* Samples in internal RAM (no PSRAM) */
+#ifndef TELEMETRY_PSRAM_BUFFER_CAPACITY
+#define TELEMETRY_PSRAM_BUFFER_CAPACITY 240000UL  /* Samples when PSRAM is present (~3.1 MB, 2 min at 2 kHz) */
+#endif
+#define TELEMETRY_BLOCK_SAMPLES      40U     /* Timestamp keyframe interval; divides both capacities */
+#define TELEMETRY_EVENT_BUFFER_CAPACITY 256U   /* Delta records, see telemetry_logging.cpp */
+#define TELEMETRY_EVENT_KEYFRAMES       16U    /* Full CarParam_type copies the records refer to */
+#define TELEMETRY_EVENT_KEYFRAME_EVERY  32U    /* Events between forced keyframes */
+#define TELEMETRY_EVENT_DELTA_FIELDS    3U     /* Fields a record holds before a keyframe is due */
 
 #define TELEMETRY_FLAG_BRAKE_BUTTON      0x01U
 #define TELEMETRY_FLAG_TRIGGER_RELEASING 0x02U
 #define TELEMETRY_FLAG_IN_RELEASE_ZONE   0x04U
 #define TELEMETRY_FLAG_RELEASE_ACTIVE    0x08U
 #define TELEMETRY_FLAG_CURRENT_SENSE     0x10U
+#define TELEMETRY_FLAG_TRIGGER_STALE     0x20U
+
+#define TELEMETRY_SPEED_UNKNOWN          0xFFU   /* speed_halfPct without a back-EMF estimate */
 
 #define TELEMETRY_EVENT_CAR_SELECT 0x01U
 #define TELEMETRY_EVENT_CAR_PARAMS 0x02U
+#define TELEMETRY_EVENT_DEADLINE   0x03U   /* Control deadline overrun; changedMask = overruns since the last one */
 
 #define TELEMETRY_CHANGE_MIN_SPEED      0x0001U
 #define TELEMETRY_CHANGE_BRAKE          0x0002U
@@ -32,6 +46,8 @@
 #define TELEMETRY_CHANGE_RELEASE_MODE   0x0400U
 #define TELEMETRY_CHANGE_RELEASE_ZONE   0x0800U
 #define TELEMETRY_CHANGE_RELEASE_LEVEL  0x1000U
+#define TELEMETRY_CHANGE_ANTI_SPIN_MODE 0x2000U
+#define TELEMETRY_CHANGE_BRAKE_ENVELOPE 0x4000U   /* Bite, hold or ramp; carried by a keyframe */
 
 typedef struct {
   StoredVar_type storedVar;
@@ -43,6 +59,7 @@ typedef struct {
 typedef struct {
   uint32_t seq;
   uint32_t t_ms;
+  uint16_t tFrac_us;     /* [µs] Part of the timestamp below t_ms (10 µs steps) */
   uint16_t vin_mV;
   uint16_t current_mA;
   uint16_t sensi_halfPct;
@@ -52,8 +69,24 @@ typedef struct {
   uint8_t carIndex;
   uint8_t releaseMode;
   uint8_t flags;
+  uint8_t speed_halfPct;  /* [0.5%] Back-EMF speed estimate, TELEMETRY_SPEED_UNKNOWN if none */
 } TelemetrySample;
 
+/* Stored form of a sample (RAM ring and flash session log). Timestamps are delta-encoded
+ * against the previous sample of the same block; the block keeps the absolute time. */
+typedef struct __attribute__((packed)) {
+  uint16_t dt_10us;        /* [10 µs] Time since previous sample (0 at a block start) */
+  uint16_t vin_mV;
+  uint16_t current_mA;
+  uint8_t sensi_halfPct;   /* <= MIN_SPEED_MAX_VALUE */
+  uint8_t trigger_pct;
+  uint8_t output_pct;
+  uint8_t brake_pct;
+  uint8_t carIndex;
+  uint8_t modeFlags;       /* releaseMode << 6 | flags */
+  uint8_t speed_halfPct;   /* <= 200 or TELEMETRY_SPEED_UNKNOWN */
+} TelemetryPackedSample;
+
 typedef struct {
   uint32_t id;
   uint32_t t_ms;
@@ -72,40 +105,66 @@ typedef struct {
   uint32_t latestSeq;
   uint32_t oldestEventId;
   uint32_t latestEventId;
-  uint16_t storedCount;
-  uint16_t capacity;
+  uint32_t storedCount;
+  uint32_t capacity;
   uint16_t eventCount;
   uint16_t eventCapacity;
-  uint16_t sampleRateMs;
+  uint16_t sampleRateMs;       /* Capture interval rounded up to whole ms (legacy clients) */
+  uint32_t sampleIntervalUs;   /* Capture interval */
+  bool psram;                  /* Sample buffer lives in PSRAM */
   uint8_t sessionStartCarIndex;
   bool loggingActive;
   bool hasData;
   bool wrapped;
 } TelemetryStatus;
 
+/* Read position of one consumer (exporter, live client, flash recorder, ...). The ring keeps
+ * no per-reader state, so any number of cursors read it independently and a new consumer
+ * costs its cursor and nothing else. */
+typedef struct {
+  uint32_t sessionId;      /* Session followed; 0 binds to the current one on the first read */
+  uint32_t afterSeq;       /* Last sample delivered */
+  uint32_t afterEventId;   /* Last event delivered */
+  uint32_t lost;           /* Samples overwritten before this reader got to them */
+  bool truncated;          /* Last read skipped data (overrun, or the session is gone) */
+  bool hasMore;            /* Last sample read stopped before the newest sample */
+} TelemetryCursor_type;
+
+/* Called per sample or event of a cursor read, oldest first; the item is decoded from its
+ * ring slot onto the reader's stack. Return false to stop, the item is delivered again on
+ * the next read. */
+typedef bool (*TelemetrySampleVisit_fn)(void* ctx, const TelemetrySample* sample);
+typedef bool (*TelemetryEventVisit_fn)(void* ctx, const TelemetryEvent* event);
+
 bool telemetryStartLogging(const StoredVar_type* storedVar,
                            uint16_t antiSpinStepMs,
                            uint16_t encoderInvertEnabled,
                            uint16_t adcVoltageRange_mV,
-                           uint8_t activeCarIndex);
+                           uint8_t activeCarIndex,
+                           uint32_t sampleInterval_us);
 void telemetryStopLogging();
 void telemetryClear();
 bool telemetryIsLoggingActive();
 bool telemetryHasData();
 void telemetryGetStatus(TelemetryStatus* outStatus);
 bool telemetryGetConfigSnapshot(TelemetryConfigSnapshot* outSnapshot);
-size_t telemetryCopySamplesAfter(uint32_t afterSeq,
-                                 TelemetrySample* outSamples,
-                                 size_t maxSamples,
-                                 bool* outTruncated,
-                                 bool* outHasMore,
-                                 TelemetryStatus* outStatus);
-size_t telemetryCopyEvents(TelemetryEvent* outEvents,
-                           size_t maxEvents,
-                           bool* outTruncated,
+void telemetryCursorBegin(TelemetryCursor_type* cursor, uint32_t sessionId, uint32_t afterSeq, uint32_t afterEventId);
+size_t telemetryCursorRead(TelemetryCursor_type* cursor,
+                           uint32_t untilSeq,
+                           size_t maxSamples,
+                           TelemetrySampleVisit_fn visit,
+                           void* ctx,
                            TelemetryStatus* outStatus);
+size_t telemetryCursorReadEvents(TelemetryCursor_type* cursor,
+                                 uint32_t untilId,
+                                 size_t maxEvents,
+                                 TelemetryEventVisit_fn visit,
+                                 void* ctx);
+void telemetryPackSample(const TelemetrySample* sample, uint16_t dt_10us, TelemetryPackedSample* out);
+void telemetryUnpackSample(const TelemetryPackedSample* packed, uint32_t seq, uint32_t t_10us, TelemetrySample* out);
+void telemetryServiceEvents(uint8_t carIndex, const CarParam_type* activeCarParam);
+void telemetryRecordDeadlineEvent(uint8_t carIndex, const CarParam_type* activeCarParam, uint16_t overruns);
 void telemetryCaptureSample(uint8_t carIndex,
-                            const CarParam_type* activeCarParam,
                             uint8_t triggerPct,
                             uint8_t outputPct,
                             uint16_t vin_mV,
@@ -113,6 +172,7 @@ void telemetryCaptureSample(uint8_t carIndex,
                             uint8_t brakePct,
                             uint16_t sensi_halfPct,
                             uint8_t releaseMode,
-                            uint8_t flags);
+                            uint8_t flags,
+                            uint8_t speed_halfPct);
 
 #endif  /* TELEMETRY_LOGGING_H_ */
@@ -0,0 +1,299 @@
+#include "telemetry_pyramid.h"
+#include <Arduino.h>
+#include <stdlib.h>
+#include <string.h>
+#include <esp_heap_caps.h>
+#include "telemetry_logging.h"
+
+#define TELEMETRY_BUCKET_UNUSED   0xFFFFFFFFUL
+
+typedef struct {
+  TelemetryBucket_type* buckets[TELEMETRY_PYRAMID_LEVELS];   /* [0] unused: level 0 is the sample ring */
+  uint32_t capacity[TELEMETRY_PYRAMID_LEVELS];
+  uint32_t sessionId;
+  uint32_t firstSeq;        /* First sample folded in this session, 0 if none */
+  TelemetryCursor_type cursor;  /* Ring position: afterSeq is the newest sample folded in */
+} TelemetryPyramid_type;
+
+/* Running merge of buckets/samples into query points */
+typedef struct {
+  TelemetryQueryPoint_type point;
+  uint32_t sum[TELEMETRY_CH_COUNT];
+  uint32_t stride;
+  uint32_t group;
+  bool open;
+  uint32_t emitted;
+  TelemetryQueryPoint_fn emit;
+  void* ctx;
+} TelemetryQueryAcc_type;
+
+/* WiFiTask only */
+static TelemetryPyramid_type g_pyr;
+
+static inline uint32_t telemetryPyramidShift(uint8_t level) {
+  return TELEMETRY_PYRAMID_LEVEL_SHIFT * level;
+}
+
+static bool telemetryPyramidAlloc() {
+  uint32_t l1 = TELEMETRY_PYRAMID_L1_BUCKETS_PSRAM;
+  uint32_t l2 = TELEMETRY_PYRAMID_L2_BUCKETS_PSRAM;
+  void* buffer = psramFound()
+                   ? heap_caps_malloc((size_t)(l1 + l2) * sizeof(TelemetryBucket_type), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+                   : nullptr;
+  if (buffer == nullptr) {
+    l1 = TELEMETRY_PYRAMID_L1_BUCKETS;
+    l2 = TELEMETRY_PYRAMID_L2_BUCKETS;
+    buffer = malloc((size_t)(l1 + l2) * sizeof(TelemetryBucket_type));
+  }
+  if (buffer == nullptr) {
+    return false;
+  }
+  g_pyr.buckets[1] = (TelemetryBucket_type*)buffer;
+  g_pyr.buckets[2] = g_pyr.buckets[1] + l1;
+  g_pyr.capacity[1] = l1;
+  g_pyr.capacity[2] = l2;
+  return true;
+}
+
+static void telemetryPyramidFree() {
+  free(g_pyr.buckets[1]);
+  memset(&g_pyr, 0, sizeof(g_pyr));
+}
+
+static void telemetryPyramidReset(uint32_t sessionId) {
+  for (uint8_t level = 1; level < TELEMETRY_PYRAMID_LEVELS; level++) {
+    for (uint32_t i = 0; i < g_pyr.capacity[level]; i++) {
+      g_pyr.buckets[level][i].index = TELEMETRY_BUCKET_UNUSED;
+    }
+  }
+  g_pyr.sessionId = sessionId;
+  g_pyr.firstSeq = 0;
+  telemetryCursorBegin(&g_pyr.cursor, sessionId, 0, 0);
+}
+
+static void telemetrySampleChannels(const TelemetrySample* s, uint16_t* out) {
+  out[TELEMETRY_CH_TRIGGER] = s->trigger_pct;
+  out[TELEMETRY_CH_OUTPUT] = s->output_pct;
+  out[TELEMETRY_CH_BRAKE] = s->brake_pct;
+  out[TELEMETRY_CH_VIN] = s->vin_mV;
+  out[TELEMETRY_CH_CURRENT] = s->current_mA;
+}
+
+static void telemetryPyramidFold(const TelemetrySample* s) {
+  uint16_t value[TELEMETRY_CH_COUNT];
+  telemetrySampleChannels(s, value);
+  for (uint8_t level = 1; level < TELEMETRY_PYRAMID_LEVELS; level++) {
+    uint32_t index = (s->seq - 1U) >> telemetryPyramidShift(level);
+    TelemetryBucket_type* b = &g_pyr.buckets[level][index % g_pyr.capacity[level]];
+    if (b->index != index) {
+      b->index = index;
+      b->t_ms = s->t_ms;
+      b->count = 0;
+      for (uint8_t ch = 0; ch < TELEMETRY_CH_COUNT; ch++) {
+        b->min[ch] = 0xFFFFU;
+        b->max[ch] = 0;
+        b->sum[ch] = 0;
+      }
+    }
+    for (uint8_t ch = 0; ch < TELEMETRY_CH_COUNT; ch++) {
+      if (value[ch] < b->min[ch]) b->min[ch] = value[ch];
+      if (value[ch] > b->max[ch]) b->max[ch] = value[ch];
+      b->sum[ch] += value[ch];
+    }
+    b->count++;
+  }
+}
+
+/* TelemetrySampleVisit_fn; folds one sample from the ring */
+static bool telemetryPyramidFoldVisit(void* ctx, const TelemetrySample* s) {
+  (void)ctx;
+  if (g_pyr.firstSeq == 0) {
+    g_pyr.firstSeq = s->seq;
+  }
+  telemetryPyramidFold(s);
+  return true;
+}
+
+/* Oldest seq a level can still answer for; level 0 is whatever the RAM ring holds */
+static uint32_t telemetryPyramidOldestSeq(uint8_t level, const TelemetryStatus* status) {
+  if (level == 0) {
+    return status->oldestSeq;
+  }
+  uint32_t shift = telemetryPyramidShift(level);
+  uint32_t newestIndex = (g_pyr.cursor.afterSeq - 1U) >> shift;
+  uint32_t oldestIndex = (newestIndex + 1U > g_pyr.capacity[level]) ? newestIndex + 1U - g_pyr.capacity[level] : 0;
+  uint32_t oldestSeq = (oldestIndex << shift) + 1U;
+  return (oldestSeq > g_pyr.firstSeq) ? oldestSeq : g_pyr.firstSeq;
+}
+
+/**
+ * @brief Fold new samples from the RAM ring into the bucket levels (WiFiTask)
+ */
+void telemetryPyramidService() {
+  if (g_pyr.buckets[1] == nullptr && !telemetryHasData()) {
+    return;
+  }
+  TelemetryStatus status;
+  telemetryGetStatus(&status);
+  if (!status.hasData && !status.loggingActive) {
+    if (g_pyr.buckets[1] != nullptr) {
+      telemetryPyramidFree();    /* Buffer cleared: give the RAM back with it */
+    }
+    return;
+  }
+  if (g_pyr.buckets[1] == nullptr) {
+    if (!telemetryPyramidAlloc()) {
+      return;
+    }
+    telemetryPyramidReset(status.sessionId);
+  }
+  if (status.sessionId != g_pyr.sessionId || status.latestSeq < g_pyr.cursor.afterSeq) {
+    telemetryPyramidReset(status.sessionId);
+  }
+
+  telemetryCursorRead(&g_pyr.cursor, 0, TELEMETRY_PYRAMID_INGEST_MAX, telemetryPyramidFoldVisit, nullptr, nullptr);
+}
+
+/**
+ * @brief Choose the level and stride for a query
+ * @param fromSeq First sample wanted, 0 for the oldest available
+ * @param toSeq Last sample wanted, 0 for the newest
+ * @return false if there is nothing in the range
+ */
+bool telemetryPyramidPlan(uint32_t fromSeq, uint32_t toSeq, uint32_t maxPoints, TelemetryQueryPlan_type* outPlan) {
+  if (outPlan == nullptr || g_pyr.buckets[1] == nullptr || g_pyr.cursor.afterSeq == 0) {
+    return false;
+  }
+  TelemetryStatus status;
+  telemetryGetStatus(&status);
+  if (status.sessionId != g_pyr.sessionId) {
+    return false;
+  }
+
+  uint32_t oldest[TELEMETRY_PYRAMID_LEVELS];
+  uint32_t earliest = UINT32_MAX;
+  for (uint8_t level = 0; level < TELEMETRY_PYRAMID_LEVELS; level++) {
+    oldest[level] = telemetryPyramidOldestSeq(level, &status);
+    if (level == 0 && status.storedCount == 0) {
+      oldest[level] = UINT32_MAX;
+    }
+    if (oldest[level] < earliest) earliest = oldest[level];
+  }
+  if (fromSeq < earliest) fromSeq = earliest;
+  if (toSeq == 0 || toSeq > g_pyr.cursor.afterSeq) toSeq = g_pyr.cursor.afterSeq;
+  if (fromSeq > toSeq) {
+    return false;
+  }
+
+  maxPoints = constrain(maxPoints, 1U, TELEMETRY_QUERY_POINTS_MAX);
+  uint32_t span = toSeq - fromSeq + 1U;
+  uint32_t minStride = (span + maxPoints - 1U) / maxPoints;
+
+  /* Coarsest level that still resolves the stride, else the finest one that has the range */
+  int8_t chosen = -1;
+  for (int8_t level = TELEMETRY_PYRAMID_LEVELS - 1; level >= 0 && chosen < 0; level--) {
+    if ((1UL << telemetryPyramidShift(level)) <= minStride && oldest[level] <= fromSeq) {
+      chosen = level;
+    }
+  }
+  for (uint8_t level = 0; level < TELEMETRY_PYRAMID_LEVELS && chosen < 0; level++) {
+    if (oldest[level] <= fromSeq) {
+      chosen = (int8_t)level;
+    }
+  }
+  if (chosen < 0) {
+    return false;
+  }
+
+  uint32_t factor = 1UL << telemetryPyramidShift((uint8_t)chosen);
+  uint32_t stride = (minStride > factor) ? minStride : factor;
+  outPlan->sessionId = g_pyr.sessionId;
+  outPlan->fromSeq = fromSeq;
+  outPlan->toSeq = toSeq;
+  outPlan->stride = ((stride + factor - 1U) / factor) * factor;
+  outPlan->levelFactor = (uint16_t)factor;
+  return true;
+}
+
+static void telemetryQueryFlush(TelemetryQueryAcc_type* acc) {
+  if (!acc->open) {
+    return;
+  }
+  for (uint8_t ch = 0; ch < TELEMETRY_CH_COUNT; ch++) {
+    acc->point.avg[ch] = (uint16_t)(acc->sum[ch] / acc->point.count);
+  }
+  acc->emit(acc->ctx, &acc->point);
+  acc->emitted++;
+  acc->open = false;
+}
+
+static void telemetryQueryAdd(TelemetryQueryAcc_type* acc, uint32_t seq, uint32_t t_ms, uint32_t count,
+                              const uint16_t* min, const uint16_t* max, const uint32_t* sum) {
+  uint32_t group = (seq - 1U) / acc->stride;
+  if (acc->open && group != acc->group) {
+    telemetryQueryFlush(acc);
+  }
+  if (!acc->open) {
+    acc->open = true;
+    acc->group = group;
+    acc->point.firstSeq = group * acc->stride + 1U;
+    acc->point.t_ms = t_ms;
+    acc->point.count = 0;
+    for (uint8_t ch = 0; ch < TELEMETRY_CH_COUNT; ch++) {
+      acc->point.min[ch] = 0xFFFFU;
+      acc->point.max[ch] = 0;
+      acc->sum[ch] = 0;
+    }
+  }
+  for (uint8_t ch = 0; ch < TELEMETRY_CH_COUNT; ch++) {
+    if (min[ch] < acc->point.min[ch]) acc->point.min[ch] = min[ch];
+    if (max[ch] > acc->point.max[ch]) acc->point.max[ch] = max[ch];
+    acc->sum[ch] += sum[ch];
+  }
+  acc->point.count += count;
+}
+
+/* TelemetrySampleVisit_fn; ctx is a TelemetryQueryAcc_type */
+static bool telemetryQueryAddSample(void* ctx, const TelemetrySample* s) {
+  uint16_t value[TELEMETRY_CH_COUNT];
+  uint32_t sum[TELEMETRY_CH_COUNT];
+  telemetrySampleChannels(s, value);
+  for (uint8_t ch = 0; ch < TELEMETRY_CH_COUNT; ch++) {
+    sum[ch] = value[ch];
+  }
+  telemetryQueryAdd((TelemetryQueryAcc_type*)ctx, s->seq, s->t_ms, 1U, value, value, sum);
+  return true;
+}
+
+/**
+ * @brief Stream the points of a planned query, oldest first
+ * @return Points emitted
+ */
+uint32_t telemetryPyramidRun(const TelemetryQueryPlan_type* plan, TelemetryQueryPoint_fn emit, void* ctx) {
+  if (plan == nullptr || emit == nullptr || plan->sessionId != g_pyr.sessionId || g_pyr.buckets[1] == nullptr) {
+    return 0;
+  }
+  TelemetryQueryAcc_type acc;
+  memset(&acc, 0, sizeof(acc));
+  acc.stride = plan->stride;
+  acc.emit = emit;
+  acc.ctx = ctx;
+
+  if (plan->levelFactor == 1U) {
+    TelemetryCursor_type cursor;
+    telemetryCursorBegin(&cursor, plan->sessionId, plan->fromSeq - 1U, 0);
+    telemetryCursorRead(&cursor, plan->toSeq, plan->toSeq - plan->fromSeq + 1U, telemetryQueryAddSample, &acc, nullptr);
+  } else {
+    uint8_t level = (plan->levelFactor == (1U << TELEMETRY_PYRAMID_LEVEL_SHIFT)) ? 1 : 2;
+    uint32_t shift = telemetryPyramidShift(level);
+    uint32_t lastIndex = (plan->toSeq - 1U) >> shift;
+    for (uint32_t index = (plan->fromSeq - 1U) >> shift; index <= lastIndex; index++) {
+      const TelemetryBucket_type* b = &g_pyr.buckets[level][index % g_pyr.capacity[level]];
+      if (b->index == index && b->count > 0) {
+        telemetryQueryAdd(&acc, (index << shift) + 1U, b->t_ms, b->count, b->min, b->max, b->sum);
+      }
+    }
+  }
+  telemetryQueryFlush(&acc);
+  return acc.emitted;
+}
@@ -0,0 +1,65 @@
+#ifndef TELEMETRY_PYRAMID_H_
+#define TELEMETRY_PYRAMID_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Min/max/avg decimation pyramid over the telemetry session (WiFiTask only).
+ * telemetryPyramidService() follows the RAM ring behind the producer and folds every sample
+ * into two bucket levels beside it: one bucket per 16 samples and one per 256. Each level is
+ * a ring of buckets indexed by (seq - 1) / factor, so it outlives the sample ring by 16x/256x.
+ * A query over [from, to] picks the coarsest level that still gives the requested number of
+ * points (raw samples when zoomed in far enough) and merges its buckets into point-sized
+ * strides, so an overview of a whole session reads a few hundred buckets. */
+#define TELEMETRY_PYRAMID_LEVEL_SHIFT   4U       /* Each level is 16x the one below */
+#define TELEMETRY_PYRAMID_LEVELS        3U       /* Raw, 16x, 256x */
+#define TELEMETRY_PYRAMID_L1_BUCKETS    256U     /* 4096 samples: more than the internal-RAM ring */
+#define TELEMETRY_PYRAMID_L2_BUCKETS    384U     /* 98304 samples: 30 min at 20 ms */
+#define TELEMETRY_PYRAMID_L1_BUCKETS_PSRAM 16384U
+#define TELEMETRY_PYRAMID_L2_BUCKETS_PSRAM 2048U
+#define TELEMETRY_PYRAMID_INGEST_MAX    256U     /* Samples folded in per service call */
+#define TELEMETRY_QUERY_POINTS_DEFAULT  300U
+#define TELEMETRY_QUERY_POINTS_MAX      1024U
+
+typedef enum {
+  TELEMETRY_CH_TRIGGER,     /* [%] */
+  TELEMETRY_CH_OUTPUT,      /* [%] */
+  TELEMETRY_CH_BRAKE,       /* [%] */
+  TELEMETRY_CH_VIN,         /* [mV] */
+  TELEMETRY_CH_CURRENT,     /* [mA] */
+  TELEMETRY_CH_COUNT
+} TelemetryChannel_enum;
+
+typedef struct {
+  uint32_t index;           /* Bucket number at its level, UINT32_MAX if unused */
+  uint32_t t_ms;            /* First sample in the bucket */
+  uint16_t count;
+  uint16_t min[TELEMETRY_CH_COUNT];
+  uint16_t max[TELEMETRY_CH_COUNT];
+  uint32_t sum[TELEMETRY_CH_COUNT];
+} TelemetryBucket_type;
+
+typedef struct {
+  uint32_t firstSeq;        /* Start of the stride the point covers */
+  uint32_t t_ms;            /* First sample in the point */
+  uint32_t count;           /* Samples merged into the point */
+  uint16_t min[TELEMETRY_CH_COUNT];
+  uint16_t max[TELEMETRY_CH_COUNT];
+  uint16_t avg[TELEMETRY_CH_COUNT];
+} TelemetryQueryPoint_type;
+
+typedef struct {
+  uint32_t sessionId;
+  uint32_t fromSeq;         /* Clamped to what the chosen level still has */
+  uint32_t toSeq;
+  uint32_t stride;          /* Samples per point */
+  uint16_t levelFactor;     /* 1, 16 or 256 */
+} TelemetryQueryPlan_type;
+
+typedef void (*TelemetryQueryPoint_fn)(void* ctx, const TelemetryQueryPoint_type* point);
+
+void telemetryPyramidService();
+bool telemetryPyramidPlan(uint32_t fromSeq, uint32_t toSeq, uint32_t maxPoints, TelemetryQueryPlan_type* outPlan);
+uint32_t telemetryPyramidRun(const TelemetryQueryPlan_type* plan, TelemetryQueryPoint_fn emit, void* ctx);
+
+#endif  /* TELEMETRY_PYRAMID_H_ */
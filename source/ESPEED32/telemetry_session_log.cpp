@@ -0,0 +1,568 @@
+#include "telemetry_session_log.h"
+#include <Arduino.h>
+#include <SPIFFS.h>
+#include <Preferences.h>
+#include <string.h>
+#include "connectivity_portal.h"
+
+#define TELEMETRY_LOG_PREF_NAMESPACE    "tlm"
+#define TELEMETRY_LOG_PREF_NEXT_SESSION "next_sess"
+#define TELEMETRY_LOG_PATH_MAX          24
+#define TELEMETRY_LOG_SCAN_MAX          32      /* Session files looked at when pruning/listing */
+#define TELEMETRY_LOG_DT_MAX_10US       0xFFFFU
+
+static_assert(sizeof(TelemetryLogBlockHeader_type) == 12, "TelemetryLogBlockHeader_type layout");
+static_assert(TELEMETRY_LOG_BLOCK_SAMPLE_MAX <= 0xFF && TELEMETRY_LOG_BLOCK_EVENT_MAX >= 1, "block record counts");
+
+typedef struct {
+  uint32_t sessionId;          /* Flash session */
+  uint32_t ramSessionId;       /* RAM session being recorded, 0 if none */
+  uint32_t nextSessionId;
+  bool fileCreated;
+  bool closed;                 /* Session stopped and flushed, or recording given up */
+  TelemetryCursor_type ringCursor;   /* Position in the RAM ring, bound to ramSessionId */
+  uint32_t prevSample_10us;
+  uint32_t sampleIntervalUs;
+  uint8_t sessionStartCarIndex;
+  TelemetryConfigSnapshot config;
+  TelemetryLogBlockHeader_type sampleHeader;
+  TelemetryLogBlockHeader_type eventHeader;
+  uint8_t sampleBlock[TELEMETRY_LOG_BLOCK_BYTES];
+  uint8_t eventBlock[TELEMETRY_LOG_BLOCK_BYTES];
+  uint8_t batch[(TELEMETRY_LOG_BATCH_BLOCKS + 1U) * TELEMETRY_LOG_BLOCK_BYTES];   /* +1: trailing event block */
+  uint8_t batchBlocks;
+  uint32_t batchLastSeq;       /* Newest sample in the batch */
+} TelemetryLogState_type;
+
+/* telemetryLogService() only */
+static TelemetryLogState_type g_tlm;
+static bool g_tlmReady = false;
+
+/* Written by telemetryLogService(), read by anyone under g_tlmMux */
+static portMUX_TYPE g_tlmMux = portMUX_INITIALIZER_UNLOCKED;
+static TelemetryLogStatus_type g_tlmStatus;
+
+static void telemetryLogPath(uint32_t sessionId, char* out, size_t outLen) {
+  snprintf(out, outLen, TELEMETRY_LOG_DIR "/s%05lu.tlm", (unsigned long)sessionId);
+}
+
+static uint32_t telemetryLogFreeBytes() {
+  return SPIFFS.totalBytes() - SPIFFS.usedBytes();
+}
+
+/*********************************************************************************************************************/
+/*                                                  Session files                                                    */
+/*********************************************************************************************************************/
+
+static bool telemetryLogParseName(const char* name, uint32_t* outId) {
+  const char* base = strrchr(name, '/');
+  base = (base != nullptr) ? base + 1 : name;
+  unsigned long id = 0;
+  char ext[5] = {0};
+  if (sscanf(base, "s%lu.%4s", &id, ext) != 2 || strcmp(ext, "tlm") != 0) {
+    return false;
+  }
+  *outId = (uint32_t)id;
+  return true;
+}
+
+/**
+ * @brief Collect session ids present on SPIFFS, ascending
+ */
+static uint8_t telemetryLogScan(uint32_t* ids, uint8_t maxIds) {
+  uint8_t count = 0;
+  /* SPIFFS is flat: TELEMETRY_LOG_DIR is only a name prefix, so walk the root */
+  File dir = SPIFFS.open("/");
+  if (!dir) {
+    return 0;
+  }
+  File f = dir.openNextFile();
+  while (f && count < maxIds) {
+    uint32_t id;
+    if (strncmp(f.path(), TELEMETRY_LOG_DIR "/", sizeof(TELEMETRY_LOG_DIR)) == 0 && telemetryLogParseName(f.path(), &id)) {
+      uint8_t pos = count++;
+      while (pos > 0 && ids[pos - 1] > id) {
+        ids[pos] = ids[pos - 1];
+        pos--;
+      }
+      ids[pos] = id;
+    }
+    f.close();
+    f = dir.openNextFile();
+  }
+  dir.close();
+  return count;
+}
+
+/**
+ * @brief Delete the oldest sessions (never the one being recorded) until the limits are met
+ * @param reserveSlot Leave room for a session that is about to be created
+ */
+static void telemetryLogPrune(bool reserveSlot) {
+  uint32_t ids[TELEMETRY_LOG_SCAN_MAX];
+  uint8_t count = telemetryLogScan(ids, TELEMETRY_LOG_SCAN_MAX);
+  uint8_t limit = reserveSlot ? (TELEMETRY_LOG_MAX_SESSIONS - 1) : TELEMETRY_LOG_MAX_SESSIONS;
+  char path[TELEMETRY_LOG_PATH_MAX];
+  for (uint8_t i = 0; i < count; i++) {
+    if (g_tlm.fileCreated && ids[i] == g_tlm.sessionId) {
+      continue;
+    }
+    bool tooMany = (count - i) > limit;
+    bool tooFull = telemetryLogFreeBytes() < TELEMETRY_LOG_MIN_FREE_BYTES;
+    if (!tooMany && !tooFull) {
+      break;
+    }
+    telemetryLogPath(ids[i], path, sizeof(path));
+    SPIFFS.remove(path);
+  }
+}
+
+static bool telemetryLogCreate() {
+  telemetryLogPrune(true);
+  if (telemetryLogFreeBytes() < TELEMETRY_LOG_MIN_FREE_BYTES / 2) {
+    return false;     /* Filesystem is all UI assets and laps: keep the session in RAM only */
+  }
+  char path[TELEMETRY_LOG_PATH_MAX];
+  telemetryLogPath(g_tlm.sessionId, path, sizeof(path));
+  File f = SPIFFS.open(path, FILE_WRITE);
+  if (!f) {
+    return false;
+  }
+
+  /* Header padded to a whole block, so every block starts on a page boundary */
+  TelemetryLogHeader_type header;
+  memset(&header, 0, sizeof(header));
+  header.magic = TELEMETRY_LOG_MAGIC;
+  header.version = TELEMETRY_LOG_VERSION;
+  header.sessionStartCarIndex = g_tlm.sessionStartCarIndex;
+  header.blockBytes = TELEMETRY_LOG_BLOCK_BYTES;
+  header.sampleSize = sizeof(TelemetryPackedSample);
+  header.eventSize = sizeof(TelemetryEvent);
+  header.sessionId = g_tlm.sessionId;
+  header.sampleIntervalUs = g_tlm.sampleIntervalUs;
+  header.config = g_tlm.config;
+  bool ok = f.write((const uint8_t*)&header, sizeof(header)) == sizeof(header);
+  static const uint8_t zeros[64] = {0};
+  size_t pad = TELEMETRY_LOG_DATA_OFFSET - sizeof(header);
+  while (ok && pad > 0) {
+    size_t n = (pad < sizeof(zeros)) ? pad : sizeof(zeros);
+    ok = f.write(zeros, n) == n;
+    pad -= n;
+  }
+  f.close();
+  if (!ok) {
+    SPIFFS.remove(path);
+    return false;
+  }
+
+  Preferences pref;
+  if (pref.begin(TELEMETRY_LOG_PREF_NAMESPACE, false)) {
+    pref.putUInt(TELEMETRY_LOG_PREF_NEXT_SESSION, g_tlm.sessionId + 1U);
+    pref.end();
+  }
+  g_tlm.nextSessionId = g_tlm.sessionId + 1U;
+  g_tlm.fileCreated = true;
+  return true;
+}
+
+/*********************************************************************************************************************/
+/*                                                    Recording                                                      */
+/*********************************************************************************************************************/
+
+static void telemetryLogCloseBlock(TelemetryLogBlockHeader_type* header, uint8_t* block) {
+  if (header->count == 0) {
+    return;
+  }
+  memcpy(block, header, sizeof(*header));
+  if (header->type == TELEMETRY_LOG_BLOCK_SAMPLES) {
+    g_tlm.batchLastSeq = header->first + header->count - 1U;
+  }
+  uint8_t* dest = &g_tlm.batch[(size_t)g_tlm.batchBlocks * TELEMETRY_LOG_BLOCK_BYTES];
+  memcpy(dest, block, TELEMETRY_LOG_BLOCK_BYTES);
+  g_tlm.batchBlocks++;
+  memset(header, 0, sizeof(*header));
+  memset(block, 0, TELEMETRY_LOG_BLOCK_BYTES);
+}
+
+/**
+ * @brief Append the batch to the session file
+ * @details A failed write gives up on the rest of the session; it stays in the RAM ring.
+ */
+static void telemetryLogWriteBatch() {
+  /* Event blocks are rare: ride along with whatever batch goes out next */
+  telemetryLogCloseBlock(&g_tlm.eventHeader, g_tlm.eventBlock);
+  if (g_tlm.batchBlocks == 0) {
+    return;
+  }
+
+  bool ok = SPIFFS.begin(false) && (g_tlm.fileCreated || telemetryLogCreate());
+  if (ok && telemetryLogFreeBytes() < TELEMETRY_LOG_MIN_FREE_BYTES / 2) {
+    telemetryLogPrune(false);
+    ok = telemetryLogFreeBytes() >= (uint32_t)g_tlm.batchBlocks * TELEMETRY_LOG_BLOCK_BYTES + TELEMETRY_LOG_MIN_FREE_BYTES / 4;
+  }
+  if (ok) {
+    char path[TELEMETRY_LOG_PATH_MAX];
+    telemetryLogPath(g_tlm.sessionId, path, sizeof(path));
+    File f = SPIFFS.open(path, FILE_APPEND);
+    size_t bytes = (size_t)g_tlm.batchBlocks * TELEMETRY_LOG_BLOCK_BYTES;
+    ok = f && f.write(g_tlm.batch, bytes) == bytes;
+    if (f) {
+      f.close();
+    }
+  }
+
+  uint8_t blocks = g_tlm.batchBlocks;
+  g_tlm.batchBlocks = 0;
+  if (!ok) {
+    g_tlm.closed = true;
+  }
+  portENTER_CRITICAL(&g_tlmMux);
+  g_tlmStatus.logAvailable = ok;
+  if (ok) {
+    g_tlmStatus.blocksWritten += blocks;
+    g_tlmStatus.sessionId = g_tlm.sessionId;
+    g_tlmStatus.lastLoggedSeq = g_tlm.batchLastSeq;
+  } else {
+    g_tlmStatus.recording = false;
+  }
+  portEXIT_CRITICAL(&g_tlmMux);
+}
+
+static void telemetryLogPushBlock(TelemetryLogBlockHeader_type* header, uint8_t* block) {
+  telemetryLogCloseBlock(header, block);
+  if (g_tlm.batchBlocks >= TELEMETRY_LOG_BATCH_BLOCKS) {
+    telemetryLogWriteBatch();
+  }
+}
+
+static void telemetryLogAppendSample(const TelemetrySample* s) {
+  uint32_t t_10us = s->t_ms * 100U + s->tFrac_us / 10U;
+  TelemetryLogBlockHeader_type* header = &g_tlm.sampleHeader;
+  /* A block holds consecutive samples only; a ring overrun or a long pause starts a new one */
+  if (header->count > 0 &&
+      (s->seq != header->first + header->count || (t_10us - g_tlm.prevSample_10us) > TELEMETRY_LOG_DT_MAX_10US)) {
+    telemetryLogPushBlock(header, g_tlm.sampleBlock);
+  }
+  uint16_t dt_10us = 0;
+  if (header->count == 0) {
+    header->type = TELEMETRY_LOG_BLOCK_SAMPLES;
+    header->first = s->seq;
+    header->base_10us = t_10us;
+  } else {
+    dt_10us = (uint16_t)(t_10us - g_tlm.prevSample_10us);
+  }
+  TelemetryPackedSample* packed =
+    (TelemetryPackedSample*)(g_tlm.sampleBlock + sizeof(TelemetryLogBlockHeader_type)) + header->count;
+  telemetryPackSample(s, dt_10us, packed);
+  header->count++;
+  g_tlm.prevSample_10us = t_10us;
+  if (header->count >= TELEMETRY_LOG_BLOCK_SAMPLE_MAX) {
+    telemetryLogPushBlock(header, g_tlm.sampleBlock);
+  }
+}
+
+static void telemetryLogAppendEvent(const TelemetryEvent* event) {
+  TelemetryLogBlockHeader_type* header = &g_tlm.eventHeader;
+  if (header->count == 0) {
+    header->type = TELEMETRY_LOG_BLOCK_EVENTS;
+    header->first = event->id;
+  }
+  memcpy(g_tlm.eventBlock + sizeof(TelemetryLogBlockHeader_type) + (size_t)header->count * sizeof(TelemetryEvent),
+         event, sizeof(TelemetryEvent));
+  header->count++;
+  if (header->count >= TELEMETRY_LOG_BLOCK_EVENT_MAX) {
+    telemetryLogPushBlock(header, g_tlm.eventBlock);
+  }
+}
+
+/* TelemetryEventVisit_fn; stops once a write failure closed the session */
+static bool telemetryLogEventVisit(void* ctx, const TelemetryEvent* event) {
+  (void)ctx;
+  if (g_tlm.closed) {
+    return false;
+  }
+  telemetryLogAppendEvent(event);
+  return true;
+}
+
+/* Samples of one ring read. Appending can write a batch to SPIFFS, which must not happen
+ * inside the read: telemetryClear() waits for running reads. */
+typedef struct {
+  TelemetrySample samples[TELEMETRY_LOG_DRAIN_BATCH];
+  size_t count;
+} TelemetryLogDrainBatch_type;
+
+/* TelemetrySampleVisit_fn; ctx is a TelemetryLogDrainBatch_type, read with maxSamples <= TELEMETRY_LOG_DRAIN_BATCH */
+static bool telemetryLogCollectSample(void* ctx, const TelemetrySample* sample) {
+  TelemetryLogDrainBatch_type* batch = (TelemetryLogDrainBatch_type*)ctx;
+  batch->samples[batch->count++] = *sample;
+  return true;
+}
+
+static void telemetryLogDrainEvents() {
+  size_t moved = telemetryCursorReadEvents(&g_tlm.ringCursor, 0, SIZE_MAX, telemetryLogEventVisit, nullptr);
+  portENTER_CRITICAL(&g_tlmMux);
+  g_tlmStatus.loggedEvents += (uint32_t)moved;
+  portEXIT_CRITICAL(&g_tlmMux);
+}
+
+static void telemetryLogDrainSamples() {
+  uint32_t lostBefore = g_tlm.ringCursor.lost;
+  size_t moved = 0;
+  size_t logged = 0;
+  TelemetryLogDrainBatch_type batch;
+  do {
+    size_t want = TELEMETRY_LOG_DRAIN_MAX - moved;
+    batch.count = 0;
+    telemetryCursorRead(&g_tlm.ringCursor, 0, (want < TELEMETRY_LOG_DRAIN_BATCH) ? want : TELEMETRY_LOG_DRAIN_BATCH,
+                        telemetryLogCollectSample, &batch, nullptr);
+    /* After a write failure closed the session the rest are consumed unlogged; it stays in the ring */
+    for (size_t i = 0; i < batch.count && !g_tlm.closed; i++) {
+      telemetryLogAppendSample(&batch.samples[i]);
+      logged++;
+    }
+    moved += batch.count;
+  } while (batch.count > 0 && g_tlm.ringCursor.hasMore && !g_tlm.closed && moved < TELEMETRY_LOG_DRAIN_MAX);
+  portENTER_CRITICAL(&g_tlmMux);
+  g_tlmStatus.loggedSamples += (uint32_t)logged;
+  g_tlmStatus.droppedSamples += g_tlm.ringCursor.lost - lostBefore;
+  portEXIT_CRITICAL(&g_tlmMux);
+}
+
+static void telemetryLogStartSession(const TelemetryStatus* status) {
+  uint32_t nextSessionId = g_tlm.nextSessionId;
+  memset(&g_tlm, 0, sizeof(g_tlm));
+  g_tlm.sessionId = nextSessionId;
+  g_tlm.nextSessionId = nextSessionId;
+  g_tlm.ramSessionId = status->sessionId;
+  telemetryCursorBegin(&g_tlm.ringCursor, status->sessionId, 0, 0);
+  g_tlm.sampleIntervalUs = status->sampleIntervalUs;
+  g_tlm.sessionStartCarIndex = status->sessionStartCarIndex;
+  telemetryGetConfigSnapshot(&g_tlm.config);
+
+  portENTER_CRITICAL(&g_tlmMux);
+  bool logAvailable = g_tlmStatus.logAvailable;
+  memset(&g_tlmStatus, 0, sizeof(g_tlmStatus));
+  g_tlmStatus.ramSessionId = status->sessionId;
+  g_tlmStatus.recording = true;
+  g_tlmStatus.logAvailable = logAvailable;
+  portEXIT_CRITICAL(&g_tlmMux);
+}
+
+/**
+ * @brief Write out everything still pending and stop recording the session
+ */
+static void telemetryLogFinishSession() {
+  if (g_tlm.ramSessionId == 0 || g_tlm.closed) {
+    return;
+  }
+  telemetryLogPushBlock(&g_tlm.sampleHeader, g_tlm.sampleBlock);
+  telemetryLogWriteBatch();
+  g_tlm.closed = true;
+  portENTER_CRITICAL(&g_tlmMux);
+  g_tlmStatus.recording = false;
+  portEXIT_CRITICAL(&g_tlmMux);
+}
+
+/*********************************************************************************************************************/
+/*                                                  Public API                                                       */
+/*********************************************************************************************************************/
+
+/**
+ * @brief Restore the session counter
+ */
+void telemetryLogBegin() {
+  uint32_t nextSession = 1;
+  Preferences pref;
+  if (pref.begin(TELEMETRY_LOG_PREF_NAMESPACE, true)) {
+    nextSession = pref.getUInt(TELEMETRY_LOG_PREF_NEXT_SESSION, 1);
+    pref.end();
+  }
+  memset(&g_tlm, 0, sizeof(g_tlm));
+  g_tlm.nextSessionId = nextSession;
+  g_tlm.closed = true;
+  g_tlmReady = true;
+}
+
+/**
+ * @brief Move new samples and events from the RAM ring to flash (WiFiTask)
+ */
+void telemetryLogService() {
+#if TELEMETRY_LOG_ENABLED
+  bool loggingActive = telemetryIsLoggingActive();
+  if (!g_tlmReady || (!loggingActive && g_tlm.closed) || isOtaInProgress()) {
+    return;
+  }
+
+  TelemetryStatus status;
+  telemetryGetStatus(&status);
+  if (status.sessionId != g_tlm.ramSessionId) {
+    telemetryLogFinishSession();
+    if (!status.loggingActive) {
+      return;
+    }
+    telemetryLogStartSession(&status);
+  }
+
+  telemetryLogDrainEvents();
+  telemetryLogDrainSamples();
+
+  /* Stopped (or cleared): once the ring has been drained the session is complete */
+  if (!status.loggingActive && g_tlm.ringCursor.afterSeq >= status.latestSeq) {
+    telemetryLogFinishSession();
+  }
+#endif
+}
+
+void telemetryLogGetStatus(TelemetryLogStatus_type* out) {
+  if (out == nullptr) return;
+  portENTER_CRITICAL(&g_tlmMux);
+  *out = g_tlmStatus;
+  portEXIT_CRITICAL(&g_tlmMux);
+}
+
+/**
+ * @brief Flash session holding a RAM telemetry session of this boot, 0 if it has none on flash
+ */
+uint32_t telemetryLogSessionForRam(uint32_t ramSessionId) {
+  uint32_t sessionId = 0;
+  portENTER_CRITICAL(&g_tlmMux);
+  if (ramSessionId != 0 && g_tlmStatus.ramSessionId == ramSessionId && g_tlmStatus.blocksWritten > 0) {
+    sessionId = g_tlmStatus.sessionId;
+  }
+  portEXIT_CRITICAL(&g_tlmMux);
+  return sessionId;
+}
+
+/**
+ * @brief List the recorded sessions, oldest first
+ */
+uint8_t telemetryLogListSessions(TelemetryLogSessionInfo_type* out, uint8_t maxSessions) {
+  if (out == nullptr || maxSessions == 0 || !SPIFFS.begin(false)) return 0;
+  uint32_t ids[TELEMETRY_LOG_SCAN_MAX];
+  uint8_t count = telemetryLogScan(ids, TELEMETRY_LOG_SCAN_MAX);
+  uint8_t first = (count > maxSessions) ? (uint8_t)(count - maxSessions) : 0;
+  uint8_t listed = 0;
+  char path[TELEMETRY_LOG_PATH_MAX];
+  for (uint8_t i = first; i < count; i++) {
+    telemetryLogPath(ids[i], path, sizeof(path));
+    File f = SPIFFS.open(path, FILE_READ);
+    TelemetryLogHeader_type header;
+    if (!f) continue;
+    if (f.read((uint8_t*)&header, sizeof(header)) == sizeof(header) && header.magic == TELEMETRY_LOG_MAGIC) {
+      out[listed].sessionId = header.sessionId;
+      out[listed].bytes = f.size();
+      out[listed].sampleIntervalUs = header.sampleIntervalUs;
+      out[listed].sessionStartCarIndex = header.sessionStartCarIndex;
+      listed++;
+    }
+    f.close();
+  }
+  return listed;
+}
+
+/*********************************************************************************************************************/
+/*                                                     Reader                                                        */
+/*********************************************************************************************************************/
+
+/**
+ * @brief Open a recorded session for sequential reading
+ */
+bool telemetryLogReaderOpen(TelemetryLogReader_type* reader, uint32_t sessionId, TelemetryLogHeader_type* outHeader) {
+  if (reader == nullptr || sessionId == 0 || !SPIFFS.begin(false)) return false;
+  char path[TELEMETRY_LOG_PATH_MAX];
+  telemetryLogPath(sessionId, path, sizeof(path));
+  File f = SPIFFS.open(path, FILE_READ);
+  if (!f) return false;
+
+  TelemetryLogHeader_type header;
+  if (f.read((uint8_t*)&header, sizeof(header)) != sizeof(header) || header.magic != TELEMETRY_LOG_MAGIC ||
+      header.version != TELEMETRY_LOG_VERSION || header.blockBytes != TELEMETRY_LOG_BLOCK_BYTES ||
+      header.sampleSize != sizeof(TelemetryPackedSample) || header.eventSize != sizeof(TelemetryEvent)) {
+    f.close();
+    return false;
+  }
+  if (outHeader != nullptr) {
+    *outHeader = header;
+  }
+  reader->file = f;
+  telemetryLogReaderRewind(reader);
+  return true;
+}
+
+/* Load the next block of the given type */
+static bool telemetryLogReaderLoad(TelemetryLogReader_type* reader, uint8_t type) {
+  for (;;) {
+    if (!reader->file.seek(TELEMETRY_LOG_DATA_OFFSET + reader->nextBlock * TELEMETRY_LOG_BLOCK_BYTES) ||
+        reader->file.read(reader->block, TELEMETRY_LOG_BLOCK_BYTES) != TELEMETRY_LOG_BLOCK_BYTES) {
+      return false;
+    }
+    reader->nextBlock++;
+    memcpy(&reader->blockHeader, reader->block, sizeof(reader->blockHeader));
+    if (reader->blockHeader.type == type && reader->blockHeader.count > 0) {
+      reader->index = 0;
+      return true;
+    }
+  }
+}
+
+bool telemetryLogReaderNextSample(TelemetryLogReader_type* reader, TelemetrySample* out) {
+  if (reader->blockHeader.type != TELEMETRY_LOG_BLOCK_SAMPLES || reader->index >= reader->blockHeader.count) {
+    if (!telemetryLogReaderLoad(reader, TELEMETRY_LOG_BLOCK_SAMPLES)) {
+      return false;
+    }
+  }
+  const TelemetryPackedSample* packed =
+    (const TelemetryPackedSample*)(reader->block + sizeof(TelemetryLogBlockHeader_type)) + reader->index;
+  reader->t_10us = (reader->index == 0) ? reader->blockHeader.base_10us : reader->t_10us + packed->dt_10us;
+  telemetryUnpackSample(packed, reader->blockHeader.first + reader->index, reader->t_10us, out);
+  reader->index++;
+  return true;
+}
+
+bool telemetryLogReaderNextEvent(TelemetryLogReader_type* reader, TelemetryEvent* out) {
+  if (reader->blockHeader.type != TELEMETRY_LOG_BLOCK_EVENTS || reader->index >= reader->blockHeader.count) {
+    if (!telemetryLogReaderLoad(reader, TELEMETRY_LOG_BLOCK_EVENTS)) {
+      return false;
+    }
+  }
+  memcpy(out, reader->block + sizeof(TelemetryLogBlockHeader_type) + (size_t)reader->index * sizeof(TelemetryEvent),
+         sizeof(TelemetryEvent));
+  reader->index++;
+  return true;
+}
+
+/**
+ * @brief Count the logged samples from the block headers alone; rewinds the reader
+ */
+uint32_t telemetryLogReaderCountSamples(TelemetryLogReader_type* reader, uint32_t* outLastSeq) {
+  uint32_t total = 0;
+  uint32_t lastSeq = 0;
+  TelemetryLogBlockHeader_type header;
+  for (uint32_t block = 0;; block++) {
+    if (!reader->file.seek(TELEMETRY_LOG_DATA_OFFSET + block * TELEMETRY_LOG_BLOCK_BYTES) ||
+        reader->file.read((uint8_t*)&header, sizeof(header)) != sizeof(header)) {
+      break;
+    }
+    if (header.type == TELEMETRY_LOG_BLOCK_SAMPLES) {
+      total += header.count;
+      lastSeq = header.first + header.count - 1U;
+    }
+  }
+  telemetryLogReaderRewind(reader);
+  if (outLastSeq != nullptr) *outLastSeq = lastSeq;
+  return total;
+}
+
+void telemetryLogReaderRewind(TelemetryLogReader_type* reader) {
+  reader->nextBlock = 0;
+  reader->index = 0;
+  reader->t_10us = 0;
+  memset(&reader->blockHeader, 0, sizeof(reader->blockHeader));
+}
+
+void telemetryLogReaderClose(TelemetryLogReader_type* reader) {
+  if (reader != nullptr && reader->file) {
+    reader->file.close();
+  }
+}
@@ -0,0 +1,109 @@
+#ifndef TELEMETRY_SESSION_LOG_H_
+#define TELEMETRY_SESSION_LOG_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <FS.h>
+#include "telemetry_logging.h"
+
+/* Flash session recorder for telemetry.
+ * While logging is active, telemetryLogService() (WiFiTask) drains the RAM ring behind the
+ * producer and appends it to /tlm/sNNNNN.tlm on SPIFFS, so a whole heat survives the ring
+ * wrapping, reboots and deep sleep:
+ *   - the file is a TelemetryLogHeader_type (config at session start) padded to one block,
+ *     followed by fixed TELEMETRY_LOG_BLOCK_BYTES blocks, two SPIFFS pages each
+ *   - a sample block holds up to TELEMETRY_LOG_BLOCK_SAMPLE_MAX consecutive samples in the
+ *     RAM ring's packed, delta-timed form; an event block holds TelemetryEvent records
+ *   - blocks are written TELEMETRY_LOG_BATCH_BLOCKS at a time, a partial batch once the
+ *     session stops; a gap in the sample sequence (ring overrun) just starts a new block
+ *   - block N sits at TELEMETRY_LOG_DATA_OFFSET + N * TELEMETRY_LOG_BLOCK_BYTES, so the block
+ *     headers are the index: readers seek block by block and never load more than one
+ *   - the oldest sessions are deleted to stay within TELEMETRY_LOG_MAX_SESSIONS and keep
+ *     TELEMETRY_LOG_MIN_FREE_BYTES free (more than the lap log needs, so laps always fit).
+ * A SPIFFS firmware-UI update formats the partition and so drops the recorded sessions. */
+#ifndef TELEMETRY_LOG_ENABLED
+#define TELEMETRY_LOG_ENABLED          1
+#endif
+#define TELEMETRY_LOG_DIR              "/tlm"
+#define TELEMETRY_LOG_MAGIC            0x54323345UL  /* "E32T" */
+#define TELEMETRY_LOG_VERSION          1
+#define TELEMETRY_LOG_BLOCK_BYTES      512U
+#define TELEMETRY_LOG_BATCH_BLOCKS     4U
+#define TELEMETRY_LOG_MAX_SESSIONS     8
+#define TELEMETRY_LOG_MIN_FREE_BYTES   131072UL
+#define TELEMETRY_LOG_DRAIN_MAX        256U    /* Samples moved per service call */
+#define TELEMETRY_LOG_DRAIN_BATCH      32U     /* Samples copied out per ring read, logged after it */
+
+#define TELEMETRY_LOG_BLOCK_SAMPLES    0x01U
+#define TELEMETRY_LOG_BLOCK_EVENTS     0x02U
+
+typedef struct {
+  uint32_t magic;             /* TELEMETRY_LOG_MAGIC */
+  uint8_t version;
+  uint8_t sessionStartCarIndex;
+  uint16_t blockBytes;        /* TELEMETRY_LOG_BLOCK_BYTES */
+  uint16_t sampleSize;        /* sizeof(TelemetryPackedSample) */
+  uint16_t eventSize;         /* sizeof(TelemetryEvent) */
+  uint32_t sessionId;
+  uint32_t sampleIntervalUs;
+  TelemetryConfigSnapshot config;
+} TelemetryLogHeader_type;
+
+typedef struct {
+  uint8_t type;               /* TELEMETRY_LOG_BLOCK_* */
+  uint8_t count;              /* Records in the block */
+  uint16_t reserved;
+  uint32_t first;             /* Seq of the first sample / id of the first event */
+  uint32_t base_10us;         /* [10 µs] Session time of the first sample (sample blocks) */
+} TelemetryLogBlockHeader_type;
+
+#define TELEMETRY_LOG_DATA_OFFSET \
+  (((sizeof(TelemetryLogHeader_type) + TELEMETRY_LOG_BLOCK_BYTES - 1U) / TELEMETRY_LOG_BLOCK_BYTES) * TELEMETRY_LOG_BLOCK_BYTES)
+#define TELEMETRY_LOG_BLOCK_SAMPLE_MAX \
+  ((TELEMETRY_LOG_BLOCK_BYTES - sizeof(TelemetryLogBlockHeader_type)) / sizeof(TelemetryPackedSample))
+#define TELEMETRY_LOG_BLOCK_EVENT_MAX \
+  ((TELEMETRY_LOG_BLOCK_BYTES - sizeof(TelemetryLogBlockHeader_type)) / sizeof(TelemetryEvent))
+
+typedef struct {
+  uint32_t sessionId;         /* Flash session being recorded, 0 if none this boot */
+  uint32_t ramSessionId;      /* RAM telemetry session it belongs to */
+  uint32_t loggedSamples;
+  uint32_t droppedSamples;    /* Overwritten in the RAM ring before they could be written */
+  uint32_t loggedEvents;
+  uint32_t lastLoggedSeq;     /* Newest sample on flash */
+  uint32_t blocksWritten;
+  bool recording;
+  bool logAvailable;          /* Last flash write succeeded */
+} TelemetryLogStatus_type;
+
+typedef struct {
+  uint32_t sessionId;
+  uint32_t bytes;
+  uint32_t sampleIntervalUs;
+  uint8_t sessionStartCarIndex;
+} TelemetryLogSessionInfo_type;
+
+/* Sequential reader over one session file; holds one block */
+typedef struct {
+  File file;
+  uint32_t nextBlock;
+  uint32_t t_10us;
+  uint8_t index;              /* Next record in block */
+  TelemetryLogBlockHeader_type blockHeader;
+  uint8_t block[TELEMETRY_LOG_BLOCK_BYTES];
+} TelemetryLogReader_type;
+
+void telemetryLogBegin();
+void telemetryLogService();
+void telemetryLogGetStatus(TelemetryLogStatus_type* out);
+uint32_t telemetryLogSessionForRam(uint32_t ramSessionId);
+uint8_t telemetryLogListSessions(TelemetryLogSessionInfo_type* out, uint8_t maxSessions);
+
+bool telemetryLogReaderOpen(TelemetryLogReader_type* reader, uint32_t sessionId, TelemetryLogHeader_type* outHeader);
+bool telemetryLogReaderNextSample(TelemetryLogReader_type* reader, TelemetrySample* out);
+bool telemetryLogReaderNextEvent(TelemetryLogReader_type* reader, TelemetryEvent* out);
+uint32_t telemetryLogReaderCountSamples(TelemetryLogReader_type* reader, uint32_t* outLastSeq);
+void telemetryLogReaderRewind(TelemetryLogReader_type* reader);
+void telemetryLogReaderClose(TelemetryLogReader_type* reader);
+
+#endif  /* TELEMETRY_SESSION_LOG_H_ */
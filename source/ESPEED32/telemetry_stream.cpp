@@ -0,0 +1,199 @@
+#include "telemetry_stream.h"
+#include <Arduino.h>
+#include "HAL.h"
+#include "telemetry_logging.h"
+#include "telemetry_frame.h"
+
+typedef enum {
+  TELEMETRY_STREAM_IDLE,
+  TELEMETRY_STREAM_STARTING,    /* Task1 asked; WiFiTask sends the ack and switches rate */
+  TELEMETRY_STREAM_STREAMING,
+  TELEMETRY_STREAM_STOPPING     /* Finish the frame in flight, then restore the rate */
+} TelemetryStreamState_enum;
+
+static const uint32_t TELEMETRY_STREAM_BAUDS[] = {
+  115200UL, 230400UL, 460800UL, 921600UL, 1500000UL, 2000000UL
+};
+
+static portMUX_TYPE g_streamMux = portMUX_INITIALIZER_UNLOCKED;
+static volatile TelemetryStreamState_enum g_streamState = TELEMETRY_STREAM_IDLE;
+static volatile bool g_streamStopRequested = false;
+static volatile uint32_t g_streamKeepAlive_ms = 0;
+static uint32_t g_streamBaud = HAL_SERIAL_BAUD;
+static uint32_t g_streamAfterSeq = 0;
+
+/* WiFiTask only */
+static uint8_t g_streamFrame[TELEMETRY_FRAME_MAX_SIZE];
+static size_t g_streamFrameLen = 0;
+static size_t g_streamFrameSent = 0;
+static uint32_t g_streamSessionId = 0;
+static uint32_t g_streamLastFrame_ms = 0;
+static uint32_t g_streamFrames = 0;
+static uint32_t g_streamSamples = 0;
+
+bool telemetryStreamBaudSupported(uint32_t baud) {
+  for (size_t i = 0; i < sizeof(TELEMETRY_STREAM_BAUDS) / sizeof(TELEMETRY_STREAM_BAUDS[0]); i++) {
+    if (TELEMETRY_STREAM_BAUDS[i] == baud) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Ask the WiFiTask to start streaming (Task1, serial command handler)
+ * @param baud UART rate to switch to after the ack, 0 to keep HAL_SERIAL_BAUD
+ * @param afterSeq Stream samples newer than this seq (0: everything still in the ring)
+ * @return false if a stream is already running or the rate is not supported
+ */
+bool telemetryStreamStart(uint32_t baud, uint32_t afterSeq) {
+  if (baud == 0U) {
+    baud = HAL_SERIAL_BAUD;
+  }
+  if (!telemetryStreamBaudSupported(baud)) {
+    return false;
+  }
+  bool started = false;
+  portENTER_CRITICAL(&g_streamMux);
+  if (g_streamState == TELEMETRY_STREAM_IDLE) {
+    g_streamBaud = baud;
+    g_streamAfterSeq = afterSeq;
+    g_streamStopRequested = false;
+    g_streamKeepAlive_ms = millis();
+    g_streamState = TELEMETRY_STREAM_STARTING;
+    started = true;
+  }
+  portEXIT_CRITICAL(&g_streamMux);
+  return started;
+}
+
+void telemetryStreamStop() {
+  g_streamStopRequested = true;
+}
+
+void telemetryStreamKeepAlive() {
+  g_streamKeepAlive_ms = millis();
+}
+
+/**
+ * @brief True from TSTREAM until the stop reply has been sent
+ * @details The serial command handler must not write while this is set.
+ */
+bool telemetryStreamActive() {
+  return g_streamState != TELEMETRY_STREAM_IDLE;
+}
+
+static void telemetryStreamSetBaud(uint32_t baud) {
+#if !ARDUINO_USB_CDC_ON_BOOT
+  Serial.flush();
+  Serial.updateBaudRate(baud);
+#else
+  (void)baud;
+#endif
+}
+
+/**
+ * @brief Write as much of the pending frame as the TX ring takes without blocking
+ * @return true once the whole frame is out
+ */
+static bool telemetryStreamDrainFrame() {
+  while (g_streamFrameSent < g_streamFrameLen) {
+    int room = Serial.availableForWrite();
+    if (room <= 0) {
+      return false;
+    }
+    size_t chunk = min((size_t)room, g_streamFrameLen - g_streamFrameSent);
+    size_t written = Serial.write(g_streamFrame + g_streamFrameSent, chunk);
+    if (written == 0) {
+      return false;
+    }
+    g_streamFrameSent += written;
+  }
+  return true;
+}
+
+/**
+ * @brief Encode the next frame if enough samples are waiting or a heartbeat is due
+ */
+static void telemetryStreamNextFrame(uint32_t now_ms) {
+  TelemetryStatus status;
+  telemetryGetStatus(&status);
+  if (status.sessionId != g_streamSessionId) {
+    g_streamSessionId = status.sessionId;  /* New session: seqs restart */
+    g_streamAfterSeq = 0;
+  }
+
+  uint32_t waiting = (status.hasData && status.latestSeq > g_streamAfterSeq) ? (status.latestSeq - g_streamAfterSeq) : 0U;
+  uint32_t age_ms = now_ms - g_streamLastFrame_ms;
+  if (waiting < TELEMETRY_STREAM_MIN_SAMPLES &&
+      !(waiting > 0U && age_ms >= TELEMETRY_STREAM_FLUSH_MS) &&
+      age_ms < TELEMETRY_STREAM_IDLE_FRAME_MS) {
+    return;
+  }
+
+  uint32_t lastSeq = g_streamAfterSeq;
+  size_t len = telemetryEncodeLiveFrame(g_streamAfterSeq, TELEMETRY_FRAME_MAX_SAMPLES,
+                                        g_streamFrame, sizeof(g_streamFrame), &lastSeq);
+  if (len == 0) {
+    return;
+  }
+  if (lastSeq > g_streamAfterSeq) {
+    g_streamSamples += (uint32_t)((len - TELEMETRY_FRAME_HEADER_SIZE - TELEMETRY_FRAME_CRC_SIZE) / TELEMETRY_FRAME_SAMPLE_SIZE);
+  }
+  g_streamAfterSeq = lastSeq;
+  g_streamFrameLen = len;
+  g_streamFrameSent = 0;
+  g_streamLastFrame_ms = now_ms;
+  g_streamFrames++;
+}
+
+/**
+ * @brief Stream state machine (WiFiTask); the only serial writer while a stream runs
+ */
+void telemetryStreamService() {
+  TelemetryStreamState_enum state = g_streamState;
+  if (state == TELEMETRY_STREAM_IDLE) {
+    return;
+  }
+  uint32_t now_ms = millis();
+
+  if (state == TELEMETRY_STREAM_STARTING) {
+    TelemetryStatus status;
+    telemetryGetStatus(&status);
+    g_streamSessionId = status.sessionId;
+    g_streamFrameLen = 0;
+    g_streamFrameSent = 0;
+    g_streamFrames = 0;
+    g_streamSamples = 0;
+    g_streamLastFrame_ms = now_ms - TELEMETRY_STREAM_IDLE_FRAME_MS;  /* First frame right away */
+    Serial.printf("OK TSTREAM %lu\n", (unsigned long)g_streamBaud);
+    if (g_streamBaud != HAL_SERIAL_BAUD) {
+      telemetryStreamSetBaud(g_streamBaud);
+    }
+    g_streamState = TELEMETRY_STREAM_STREAMING;
+    return;
+  }
+
+  if (state == TELEMETRY_STREAM_STREAMING &&
+      (g_streamStopRequested || (now_ms - g_streamKeepAlive_ms) > TELEMETRY_STREAM_KEEPALIVE_MS)) {
+    g_streamState = state = TELEMETRY_STREAM_STOPPING;
+  }
+
+  if (!telemetryStreamDrainFrame()) {
+    return;
+  }
+  if (state == TELEMETRY_STREAM_STREAMING) {
+    telemetryStreamNextFrame(now_ms);
+    telemetryStreamDrainFrame();
+    return;
+  }
+
+  /* Stopping and the last frame is out */
+  if (g_streamBaud != HAL_SERIAL_BAUD) {
+    telemetryStreamSetBaud(HAL_SERIAL_BAUD);
+  }
+  Serial.printf("OK TSTREAM STOP frames=%lu samples=%lu\n",
+                (unsigned long)g_streamFrames, (unsigned long)g_streamSamples);
+  g_streamStopRequested = false;
+  g_streamState = TELEMETRY_STREAM_IDLE;
+}
@@ -0,0 +1,34 @@
+#ifndef TELEMETRY_STREAM_H_
+#define TELEMETRY_STREAM_H_
+
+#include <stdint.h>
+
+/* Continuous serial telemetry stream (serial TSTREAM).
+ * Instead of one TLIVEB request per frame, the WiFiTask pushes raw binary telemetry frames
+ * (telemetry_frame.h, no base64, no length prefix) back to back as samples are captured:
+ *   - "TSTREAM [baud [afterSeq]]" is acknowledged with "OK TSTREAM <baud>\n" at the current
+ *     rate, then the UART switches to <baud> and the first frame follows. On native USB-CDC
+ *     the rate is meaningless and is left alone. Without afterSeq the stream starts at the
+ *     newest sample; afterSeq 0 replays what is still in the ring first
+ *   - each frame carries firstSeq/sampleCount and a CRC-32, so the host detects gaps (seq
+ *     jumps, TRUNCATED) and resynchronises on the "ETLF" magic after a corrupt frame
+ *   - with no new samples an empty frame is sent every TELEMETRY_STREAM_IDLE_FRAME_MS as a
+ *     heartbeat carrying the ring status
+ *   - while streaming only TSTREAM lines are acted on, so no text reply lands inside a frame.
+ *     The host sends any line at least every TELEMETRY_STREAM_KEEPALIVE_MS ("TSTREAM" is
+ *     enough) or the stream stops by itself
+ *   - "TSTREAM STOP" or the keepalive timeout finishes the frame in flight, returns the UART
+ *     to HAL_SERIAL_BAUD and replies "OK TSTREAM STOP\n" there */
+#define TELEMETRY_STREAM_KEEPALIVE_MS   3000U
+#define TELEMETRY_STREAM_IDLE_FRAME_MS  500U
+#define TELEMETRY_STREAM_MIN_SAMPLES    8U      /* Batch at least this many unless idle-flushing */
+#define TELEMETRY_STREAM_FLUSH_MS       20U     /* ... or this old, whichever comes first */
+
+bool telemetryStreamStart(uint32_t baud, uint32_t afterSeq);
+void telemetryStreamStop();
+void telemetryStreamKeepAlive();
+bool telemetryStreamActive();
+bool telemetryStreamBaudSupported(uint32_t baud);
+void telemetryStreamService();
+
+#endif  /* TELEMETRY_STREAM_H_ */
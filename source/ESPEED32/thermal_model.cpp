@@ -0,0 +1,201 @@
+#include "thermal_model.h"
+#include <Arduino.h>
+#include "HAL.h"
+#include "half_bridge.h"
+#include "current_sampler.h"
+
+#define THERMAL_TEMP_SENSE  (CURRENT_SENSE_PROFILE == CURRENT_SENSE_PROFILE_BTN99X0)
+
+typedef enum {
+  THERMAL_SENSE_IDLE,
+  THERMAL_SENSE_SETTLING,   /* Sense pattern written, waiting for it to latch and IS to settle */
+  THERMAL_SENSE_READING     /* Sampler asked for the IS reading */
+} ThermalSenseState_enum;
+
+/* Control task only */
+static ThermalSenseState_enum g_thSenseState = THERMAL_SENSE_IDLE;
+static uint32_t g_thSenseStartUs = 0;
+static uint32_t g_thSenseWaitUs = 0;
+static uint32_t g_thSenseSeq = 0;
+static uint32_t g_thLastSenseMs = 0;
+static uint32_t g_thReleasedSinceMs = 0;
+static bool g_thWasReleased = false;
+static uint64_t g_thHeat_x256 = 0;          /* EMA of (I / 10 mA)², x256 */
+static uint32_t g_thLastUpdateMs = 0;
+static uint16_t g_thLimit_x100 = 10000;     /* [0.01%] Applied share of maxSpeed */
+static int16_t g_thChipTemp_C = THERMAL_TEMP_UNKNOWN;
+static uint32_t g_thChipTempMs = 0;
+static uint32_t g_thSenseReads = 0;
+static uint32_t g_thSenseAborts = 0;
+
+static portMUX_TYPE g_thermalMux = portMUX_INITIALIZER_UNLOCKED;
+static ThermalStatus_type g_thStatus = {THERMAL_TEMP_UNKNOWN, 0, 0, 100, 100, false, THERMAL_TEMP_SENSE, 0, 0};
+
+/* 100% at or below start, THERMAL_DERATE_MIN_PCT at or above end, linear in between */
+static uint8_t thermalDerateBetween(int32_t value, int32_t start, int32_t end) {
+  if (value <= start) {
+    return 100;
+  }
+  if (value >= end) {
+    return THERMAL_DERATE_MIN_PCT;
+  }
+  return (uint8_t)(100 - ((value - start) * (int32_t)(100U - THERMAL_DERATE_MIN_PCT)) / (end - start));
+}
+
+#if THERMAL_TEMP_SENSE
+static void thermalSenseFinish(uint32_t nowMs) {
+  currentSamplerHoldForSense(false);
+  g_thSenseState = THERMAL_SENSE_IDLE;
+  g_thLastSenseMs = nowMs;
+}
+#endif
+
+/* Junction temperature reading; true while the sense pattern owns the bridge outputs */
+static bool thermalSenseTick(bool triggerReleased, uint32_t nowMs) {
+#if THERMAL_TEMP_SENSE
+  if (g_thSenseState != THERMAL_SENSE_IDLE && !triggerReleased) {
+    g_thSenseAborts++;  /* Driver is back on the trigger: hand the bridge back right away */
+    thermalSenseFinish(nowMs);
+    return false;
+  }
+
+  switch (g_thSenseState) {
+    case THERMAL_SENSE_IDLE: {
+      if (!triggerReleased || (nowMs - g_thReleasedSinceMs) < THERMAL_SENSE_IDLE_MS ||
+          (nowMs - g_thLastSenseMs) < THERMAL_SENSE_INTERVAL_MS) {
+        return false;
+      }
+      uint32_t freq_hz = ledcReadFreq(HB_IN_PIN);
+      g_thSenseWaitUs = ((freq_hz > 0) ? (1000000UL / freq_hz) : 1000UL) + THERMAL_SENSE_SETTLE_US;
+      currentSamplerHoldForSense(true);
+      HalfBridge_SetTemperatureSensePattern();
+      g_thSenseStartUs = micros();
+      g_thSenseState = THERMAL_SENSE_SETTLING;
+      return true;
+    }
+    case THERMAL_SENSE_SETTLING:
+      if ((uint32_t)(micros() - g_thSenseStartUs) < g_thSenseWaitUs) {
+        return true;
+      }
+      g_thSenseSeq = currentSamplerGetSenseRead(nullptr);
+      currentSamplerRequestSenseRead();
+      g_thSenseState = THERMAL_SENSE_READING;
+      return true;
+    case THERMAL_SENSE_READING: {
+      uint16_t raw = 0;
+      if (currentSamplerGetSenseRead(&raw) != g_thSenseSeq) {
+        int16_t temp_C = HalfBridge_SenseRawToCelsius(raw);
+        if (temp_C >= THERMAL_TEMP_MIN_C && temp_C <= THERMAL_TEMP_MAX_C) {
+          g_thChipTemp_C = temp_C;
+          g_thChipTempMs = nowMs;
+          g_thSenseReads++;
+        } else {
+          g_thSenseAborts++;
+        }
+        thermalSenseFinish(nowMs);
+        return false;
+      }
+      if ((uint32_t)(micros() - g_thSenseStartUs) > THERMAL_SENSE_TIMEOUT_MS * 1000UL) {
+        g_thSenseAborts++;
+        thermalSenseFinish(nowMs);
+        return false;
+      }
+      return true;
+    }
+  }
+  return false;
+#else
+  (void)triggerReleased;
+  (void)nowMs;
+  return false;
+#endif
+}
+
+/* I²t integration, derate target and slew; every THERMAL_UPDATE_MS */
+static void thermalModelUpdate(uint16_t current_mA, uint32_t nowMs) {
+  uint32_t dtMs = nowMs - g_thLastUpdateMs;
+  if (dtMs < THERMAL_UPDATE_MS) {
+    return;
+  }
+  g_thLastUpdateMs = nowMs;
+  if (dtMs > 1000U) {
+    dtMs = 1000U;  /* Control task was stalled; don't integrate the gap as one step */
+  }
+
+  uint32_t current_10mA = current_mA / 10U;
+  uint64_t square_x256 = ((uint64_t)current_10mA * current_10mA) << 8;
+  if (square_x256 >= g_thHeat_x256) {
+    g_thHeat_x256 += ((square_x256 - g_thHeat_x256) * dtMs) / THERMAL_I2T_TAU_MS;
+  } else {
+    g_thHeat_x256 -= ((g_thHeat_x256 - square_x256) * dtMs) / THERMAL_I2T_TAU_MS;
+  }
+  const uint64_t contSquare_x256 = ((uint64_t)(THERMAL_I2T_CONT_MA / 10U) * (THERMAL_I2T_CONT_MA / 10U)) << 8;
+  uint32_t load_pct = (uint32_t)min((g_thHeat_x256 * 100U) / contSquare_x256, (uint64_t)0xFFFFU);
+
+  uint32_t tempAge_ms = nowMs - g_thChipTempMs;
+  bool tempFresh = g_thChipTemp_C != THERMAL_TEMP_UNKNOWN && tempAge_ms <= THERMAL_TEMP_STALE_MS;
+  uint8_t target = thermalDerateBetween((int32_t)load_pct, THERMAL_LOAD_DERATE_START_PCT, THERMAL_LOAD_DERATE_END_PCT);
+  if (tempFresh) {
+    target = min(target, thermalDerateBetween(g_thChipTemp_C, THERMAL_TEMP_DERATE_START_C, THERMAL_TEMP_DERATE_END_C));
+  }
+
+  uint16_t step_x100 = (uint16_t)max((THERMAL_DERATE_SLEW_PCT_PER_S * 100UL * dtMs) / 1000UL, 1UL);
+  uint16_t target_x100 = (uint16_t)target * 100U;
+  if (g_thLimit_x100 > target_x100) {
+    g_thLimit_x100 = (g_thLimit_x100 - target_x100 > step_x100) ? (uint16_t)(g_thLimit_x100 - step_x100) : target_x100;
+  } else if (g_thLimit_x100 < target_x100) {
+    g_thLimit_x100 = (target_x100 - g_thLimit_x100 > step_x100) ? (uint16_t)(g_thLimit_x100 + step_x100) : target_x100;
+  }
+
+  portENTER_CRITICAL(&g_thermalMux);
+  g_thStatus.chipTemp_C = g_thChipTemp_C;
+  g_thStatus.tempAge_ms = (g_thChipTemp_C != THERMAL_TEMP_UNKNOWN) ? tempAge_ms : 0;
+  g_thStatus.load_pct = (uint16_t)load_pct;
+  g_thStatus.limit_pct = (uint8_t)((g_thLimit_x100 + 50U) / 100U);
+  g_thStatus.target_pct = target;
+  g_thStatus.derating = g_thLimit_x100 < 10000U;
+  g_thStatus.senseReads = g_thSenseReads;
+  g_thStatus.senseAborts = g_thSenseAborts;
+  portEXIT_CRITICAL(&g_thermalMux);
+}
+
+/**
+ * @brief Run the thermal model for one control tick
+ * @param duty_permille Duty about to be written
+ * @param current_mA Latest motor current
+ * @param triggerReleased Trigger at rest (output 0): a temperature reading may take the bridge
+ * @return true if a temperature reading owns the bridge outputs: skip this tick's PWM write
+ */
+bool thermalModelControlTick(uint16_t duty_permille, uint16_t current_mA, bool triggerReleased) {
+  uint32_t nowMs = millis();
+  bool released = triggerReleased && duty_permille == 0;
+  if (released && !g_thWasReleased) {
+    g_thReleasedSinceMs = nowMs;
+  }
+  g_thWasReleased = released;
+
+  thermalModelUpdate(current_mA, nowMs);
+  return thermalSenseTick(released, nowMs);
+}
+
+/**
+ * @brief Cap a duty at the derated share of maxSpeed
+ * @param duty_permille [0.1%] Duty after the throttle curve and anti-spin
+ * @param maxSpeed_pct [%] Car maxSpeed
+ */
+uint16_t thermalModelLimitPermille(uint16_t duty_permille, uint16_t maxSpeed_pct) {
+  if (g_thLimit_x100 >= 10000U) {
+    return duty_permille;
+  }
+  uint16_t cap = (uint16_t)(((uint32_t)maxSpeed_pct * 10U * g_thLimit_x100) / 10000U);
+  return min(duty_permille, cap);
+}
+
+void thermalModelGetStatus(ThermalStatus_type* outStatus) {
+  if (outStatus == nullptr) {
+    return;
+  }
+  portENTER_CRITICAL(&g_thermalMux);
+  *outStatus = g_thStatus;
+  portEXIT_CRITICAL(&g_thermalMux);
+}
@@ -0,0 +1,65 @@
+#ifndef THERMAL_MODEL_H_
+#define THERMAL_MODEL_H_
+
+#include <stdint.h>
+
+/* Half-bridge thermal model and maxSpeed derating (control task).
+ * Two inputs, each able to pull the output limit down on its own:
+ *   - I²t load: an exponential average of the squared motor current with the board's thermal
+ *     time constant; 100% = steady state at THERMAL_I2T_CONT_MA.
+ *   - Junction temperature from the BTN99x0 IS pin (BTN99X0 current-sense profile only). The
+ *     reading needs INH low and IN high, so it is only taken while the trigger has been released
+ *     for a while: the bridge floats for about one PWM period plus one sampler read (a few ms,
+ *     at most every THERMAL_SENSE_INTERVAL_MS) and the read itself runs on the current sampler.
+ * Between the START and END limits the allowed output falls linearly from maxSpeed to
+ * THERMAL_DERATE_MIN_PCT of maxSpeed; the applied limit slews at THERMAL_DERATE_SLEW_PCT_PER_S
+ * so it never steps while driving. Override the limits at build time. */
+#define THERMAL_UPDATE_MS              10U     /* I²t integration / derate slew period */
+#define THERMAL_SENSE_INTERVAL_MS      2000U   /* Junction temperature reading period */
+#define THERMAL_SENSE_IDLE_MS          300U    /* Trigger released at least this long before a reading */
+#define THERMAL_SENSE_SETTLE_US        20U     /* [µs] IS settling after IN rises (datasheet: 7 µs) */
+#define THERMAL_SENSE_TIMEOUT_MS       12U     /* Sampler did not answer: give the bridge back (< CURRENT_SYNC_STALE_MS) */
+#define THERMAL_TEMP_STALE_MS          15000UL /* Older readings no longer derate (driving without pauses) */
+#define THERMAL_TEMP_MIN_C             -40     /* Readings outside this range are discarded */
+#define THERMAL_TEMP_MAX_C             200
+#ifndef THERMAL_TEMP_DERATE_START_C
+#define THERMAL_TEMP_DERATE_START_C    110     /* [°C] Junction temperature where derating starts */
+#endif
+#ifndef THERMAL_TEMP_DERATE_END_C
+#define THERMAL_TEMP_DERATE_END_C      150     /* [°C] ... and reaches THERMAL_DERATE_MIN_PCT */
+#endif
+#ifndef THERMAL_I2T_CONT_MA
+#define THERMAL_I2T_CONT_MA            8000U   /* [mA] Current the board carries indefinitely */
+#endif
+#ifndef THERMAL_I2T_TAU_MS
+#define THERMAL_I2T_TAU_MS             30000UL /* [ms] Board/heatsink thermal time constant */
+#endif
+#ifndef THERMAL_LOAD_DERATE_START_PCT
+#define THERMAL_LOAD_DERATE_START_PCT  100U    /* [%] I²t load where derating starts */
+#endif
+#ifndef THERMAL_LOAD_DERATE_END_PCT
+#define THERMAL_LOAD_DERATE_END_PCT    150U    /* [%] ... and reaches THERMAL_DERATE_MIN_PCT */
+#endif
+#ifndef THERMAL_DERATE_MIN_PCT
+#define THERMAL_DERATE_MIN_PCT         40U     /* [%] Share of maxSpeed that is always left */
+#endif
+#define THERMAL_DERATE_SLEW_PCT_PER_S  10U     /* [%/s] Fastest change of the applied limit */
+#define THERMAL_TEMP_UNKNOWN           INT16_MIN
+
+typedef struct {
+  int16_t chipTemp_C;       /* [°C] Last junction reading, THERMAL_TEMP_UNKNOWN if none */
+  uint32_t tempAge_ms;      /* Age of chipTemp_C */
+  uint16_t load_pct;        /* [%] I²t load */
+  uint8_t limit_pct;        /* [%] Allowed share of maxSpeed (100 = no derating) */
+  uint8_t target_pct;       /* [%] Where limit_pct is heading */
+  bool derating;            /* limit_pct < 100 */
+  bool tempSense;           /* This build can read the junction temperature */
+  uint32_t senseReads;
+  uint32_t senseAborts;     /* Readings cut short by the trigger or a sampler timeout */
+} ThermalStatus_type;
+
+bool thermalModelControlTick(uint16_t duty_permille, uint16_t current_mA, bool triggerReleased);
+uint16_t thermalModelLimitPermille(uint16_t duty_permille, uint16_t maxSpeed_pct);
+void thermalModelGetStatus(ThermalStatus_type* outStatus);
+
+#endif  /* THERMAL_MODEL_H_ */
@@ -0,0 +1,371 @@
+#include "throttle_lut.h"
+#include <Arduino.h>
+#include <atomic>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "slot_ESC.h"
+
+extern ESC_type g_escVar;
+
+typedef struct {
+  ThrottleLutKey_type key;
+  uint16_t outputPermille[THROTTLE_LUT_ENTRIES];  /* [0.1%] throttleCurveEvaluate() result per trigger step */
+} ThrottleLut_type;
+
+/* Double buffer: g_lutPublishSeq selects the active table (seq & 1), 0 = nothing published yet.
+ * The builder only ever writes the inactive table and then bumps the sequence, so a reader that
+ * sees the same sequence before and after its lookup cannot have observed a partial rebuild. */
+static ThrottleLut_type g_lutTables[2];
+static std::atomic<uint32_t> g_lutPublishSeq(0);
+static uint32_t g_lutRebuilds = 0;
+static volatile uint32_t g_lutFallbacks = 0;
+
+#define THROTTLE_CURVE_KNOTS_MAX  (THROTTLE_CURVE_POINTS_MAX + 2)  /* Points plus the SENSI and LIMIT ends */
+
+/**
+ * @brief A multi-point curve resolved against SENSI, LIMIT and FADE
+ */
+typedef struct {
+  uint8_t count;
+  bool spline;
+  uint16_t x[THROTTLE_CURVE_KNOTS_MAX];   /* Normalized trigger, strictly increasing */
+  int32_t y[THROTTLE_CURVE_KNOTS_MAX];    /* [0.1%] Output */
+  float slope[THROTTLE_CURVE_KNOTS_MAX];  /* [0.1% per trigger step] Hermite tangents (spline only) */
+} ThrottleCurveKnots_type;
+
+static inline bool throttleLutKeyEquals(const ThrottleLutKey_type* a, const ThrottleLutKey_type* b) {
+  return a->sensiRaw == b->sensiRaw &&
+         a->maxSpeed == b->maxSpeed &&
+         a->fade == b->fade &&
+         a->vertexInput == b->vertexInput &&
+         a->vertexSpeedDiff == b->vertexSpeedDiff &&
+         memcmp(&a->shape, &b->shape, sizeof(a->shape)) == 0;
+}
+
+/**
+ * @brief Curve inputs of an active tuning snapshot
+ */
+void throttleLutKeyFromTuning(const ActiveTuning_type* tuning, ThrottleLutKey_type* outKey) {
+  outKey->sensiRaw = tuning->effectiveSensi_raw;
+  outKey->maxSpeed = tuning->maxSpeed;
+  outKey->fade = tuning->fade;
+  outKey->vertexInput = tuning->vertexInput;
+  outKey->vertexSpeedDiff = tuning->vertexSpeedDiff;
+  outKey->shape = tuning->curveShape;
+}
+
+/**
+ * @brief Curve inputs of a stored car profile (stored SENSI, no ext pot)
+ */
+void throttleLutKeyFromCar(const CarParam_type* car, ThrottleLutKey_type* outKey) {
+  outKey->sensiRaw = car->minSpeed;
+  outKey->maxSpeed = car->maxSpeed;
+  outKey->fade = car->fade;
+  outKey->vertexInput = car->throttleCurveVertex.inputThrottle;
+  outKey->vertexSpeedDiff = car->throttleCurveVertex.curveSpeedDiff;
+  outKey->shape = car->throttleCurveShape;
+}
+
+/**
+ * @brief Place the control points between (FADE, SENSI) and (full trigger, LIMIT) and compute the tangents
+ * @details Points that land on or before the previous one (a long FADE squeezes them) are dropped.
+ *          Tangents: PCHIP, the weighted harmonic mean of the neighbouring secants, 0 at a
+ *          local extremum; secants at the ends. That keeps every segment monotone.
+ */
+static void throttleCurvePrepareKnots(const ThrottleLutKey_type* key, ThrottleCurveKnots_type* k) {
+  const ThrottleCurveShape_type* shape = &key->shape;
+  uint16_t minRaw = key->sensiRaw * (1000U / (100U * SENSI_SCALE));
+  uint16_t maxRaw = key->maxSpeed * 10U;
+  uint16_t fadeThrottleNorm = fadePctToThrottleNorm(min((uint16_t)FADE_MAX_VALUE, key->fade));
+  uint8_t pointCount = min(shape->count, (uint8_t)THROTTLE_CURVE_POINTS_MAX);
+  k->spline = (shape->mode == THROTTLE_CURVE_MODE_SPLINE);
+  k->count = 0;
+  k->x[k->count] = fadeThrottleNorm;
+  k->y[k->count++] = minRaw;
+  for (uint8_t i = 0; i < pointCount; i++) {
+    uint16_t inputNorm = (uint16_t)(((uint32_t)min(shape->points[i].input_pct, (uint8_t)100U) * THROTTLE_NORMALIZED) / 100U);
+    uint16_t x = curveVertexInputWithFade(fadeThrottleNorm, inputNorm);
+    if (x <= k->x[k->count - 1] || x >= THROTTLE_NORMALIZED) {
+      continue;
+    }
+    k->x[k->count] = x;
+    k->y[k->count++] = (int32_t)minRaw + (((int32_t)maxRaw - (int32_t)minRaw) * (int32_t)min(shape->points[i].output_pct, (uint8_t)100U)) / 100;
+  }
+  k->x[k->count] = THROTTLE_NORMALIZED;
+  k->y[k->count++] = maxRaw;
+
+  if (!k->spline) {
+    return;
+  }
+  float secant[THROTTLE_CURVE_KNOTS_MAX] = {};  /* count >= 2 (both ends), so secant[0..count-2] are all set */
+  for (uint8_t i = 0; i + 1 < k->count; i++) {
+    secant[i] = (float)(k->y[i + 1] - k->y[i]) / (float)(k->x[i + 1] - k->x[i]);
+  }
+  k->slope[0] = secant[0];
+  k->slope[k->count - 1] = secant[k->count - 2];
+  for (uint8_t i = 1; i + 1 < k->count; i++) {
+    float d0 = secant[i - 1];
+    float d1 = secant[i];
+    if (d0 * d1 <= 0.0f) {
+      k->slope[i] = 0.0f;
+      continue;
+    }
+    float h0 = (float)(k->x[i] - k->x[i - 1]);
+    float h1 = (float)(k->x[i + 1] - k->x[i]);
+    k->slope[i] = 3.0f * (h0 + h1) / ((2.0f * h1 + h0) / d0 + (h1 + 2.0f * h0) / d1);
+  }
+}
+
+/**
+ * @brief Output of a prepared multi-point curve past FADE
+ */
+static uint16_t throttleCurveEvaluateKnots(const ThrottleCurveKnots_type* k, uint16_t inputThrottleNorm) {
+  uint8_t seg = 0;
+  while (seg + 2 < k->count && inputThrottleNorm > k->x[seg + 1]) {
+    seg++;
+  }
+  int32_t x0 = k->x[seg];
+  int32_t x1 = k->x[seg + 1];
+  int32_t y0 = k->y[seg];
+  int32_t y1 = k->y[seg + 1];
+  int32_t y;
+  if (!k->spline) {
+    y = (int32_t)map(inputThrottleNorm, x0, x1, y0, y1);
+  } else {
+    float h = (float)(x1 - x0);
+    float t = (float)((int32_t)inputThrottleNorm - x0) / h;
+    float t2 = t * t;
+    float t3 = t2 * t;
+    float value = (2.0f * t3 - 3.0f * t2 + 1.0f) * (float)y0 + (t3 - 2.0f * t2 + t) * h * k->slope[seg] +
+                  (-2.0f * t3 + 3.0f * t2) * (float)y1 + (t3 - t2) * h * k->slope[seg + 1];
+    y = (int32_t)lroundf(value);
+    y = constrain(y, min(y0, y1), max(y0, y1));  /* Rounding only; PCHIP stays inside */
+  }
+  return (uint16_t)constrain(y, (int32_t)0, (int32_t)1000);
+}
+
+/**
+ * throttleCurveEvaluate: Map trigger position(throttle) to speed (duty) on a broken line curve, with midpoint set as throttleCurveVertex
+ * dual throttle curve: When decelerating , if dragB is higher than 100%-minSpeed, then set a lower minSpeed
+ * @param key Curve inputs (see throttleLutKeyFromTuning())
+ * @param inputThrottleNorm The input Trigger value, normalized between 0 and THROTTLE_NORMALIZED
+ * @param knots Prepared multi-point curve, nullptr for the vertex curve
+ * @return [0.1%] duty cyle to be applied at that specific thrigger position on the selected curve (0-1000)
+ */
+static uint16_t throttleCurveEvaluateWith(const ThrottleLutKey_type* key, const ThrottleCurveKnots_type* knots,
+                                          uint16_t inputThrottleNorm)
+{
+  uint32_t throttleCurveVertexSpeedRaw;  /* Output speed in 0.1% units at the curve vertex */
+  uint16_t outputSpeedRaw = 0;           /* Output speed in 0.1% units */
+  uint16_t tmpMinSpeedRaw;               /* Minimum speed in 0.1% units */
+  uint16_t maxSpeedRaw;                  /* Maximum speed in 0.1% units */
+  uint16_t fadeThrottleNorm;
+  uint16_t curveVertexInputNorm;
+
+  /* dual throttle curve: When decelerating , if dragB is higher than 100%-minSpeed, then set a lower minSpeed on the curve to allow the desired drag brake to be applied*/
+  tmpMinSpeedRaw = key->sensiRaw * (1000U / (100U * SENSI_SCALE));
+  maxSpeedRaw = key->maxSpeed * 10U;
+  fadeThrottleNorm = fadePctToThrottleNorm(min((uint16_t)FADE_MAX_VALUE, key->fade));
+  curveVertexInputNorm = curveVertexInputWithFade(fadeThrottleNorm, key->vertexInput);
+
+  /* Calculate the output speed of the throttle curve vertex
+     This is calculated as the curveSpeedDiff (from 10% to 90%) percentage of the difference between minSpeed and maxSpeed */
+  throttleCurveVertexSpeedRaw = tmpMinSpeedRaw + (((uint32_t)maxSpeedRaw - (uint32_t)tmpMinSpeedRaw) * ((uint32_t)key->vertexSpeedDiff) / 100);
+
+  if (inputThrottleNorm == 0)   /* If input throttle is 0 --> output speed is 0% */
+  {
+    outputSpeedRaw = 0;
+  }
+  else if (fadeThrottleNorm > 0 && inputThrottleNorm <= fadeThrottleNorm)
+  {
+    /* FADE fills the gap between 0 output and SENSI over the first part of trigger travel. */
+    outputSpeedRaw = (uint16_t)map(inputThrottleNorm, 0, fadeThrottleNorm, 0, tmpMinSpeedRaw);
+  }
+  else if (knots != nullptr)
+  {
+    outputSpeedRaw = throttleCurveEvaluateKnots(knots, inputThrottleNorm);
+  }
+  else if (inputThrottleNorm <= curveVertexInputNorm)
+  {
+    if (curveVertexInputNorm <= fadeThrottleNorm)
+    {
+      outputSpeedRaw = (uint16_t)throttleCurveVertexSpeedRaw;
+    }
+    else
+    {
+      outputSpeedRaw = (uint16_t)map(inputThrottleNorm, fadeThrottleNorm, curveVertexInputNorm, tmpMinSpeedRaw, throttleCurveVertexSpeedRaw);
+    }
+  }
+  else
+  {
+    if (curveVertexInputNorm >= THROTTLE_NORMALIZED)
+    {
+      outputSpeedRaw = maxSpeedRaw;
+    }
+    else
+    {
+      outputSpeedRaw = (uint16_t)map(inputThrottleNorm, curveVertexInputNorm, THROTTLE_NORMALIZED, throttleCurveVertexSpeedRaw, maxSpeedRaw);
+    }
+  }
+
+  return outputSpeedRaw;
+}
+
+/**
+ * @brief Curve output for one trigger step (see throttleCurveEvaluateWith())
+ * @details Prepares a multi-point curve on every call; table builders prepare it once.
+ */
+uint16_t throttleCurveEvaluate(const ThrottleLutKey_type* key, uint16_t inputThrottleNorm) {
+  if (!throttleCurveShapeActive(&key->shape)) {
+    return throttleCurveEvaluateWith(key, nullptr, inputThrottleNorm);
+  }
+  ThrottleCurveKnots_type knots;
+  throttleCurvePrepareKnots(key, &knots);
+  return throttleCurveEvaluateWith(key, &knots, inputThrottleNorm);
+}
+
+/**
+ * @brief Throttle curve output for the selected car, from the published table when it is current
+ * @details Called from the control loop after activeTuningAcquire(). Falls back to
+ *          throttleCurveEvaluate() while the table lags behind a parameter/SENSI change, so the
+ *          output never depends on rebuild timing.
+ */
+uint16_t throttleLutLookup(uint16_t inputThrottleNorm) {
+  ThrottleLutKey_type liveKey;
+  throttleLutKeyFromTuning(activeTuningTick(), &liveKey);
+  if (inputThrottleNorm > THROTTLE_NORMALIZED) {
+    inputThrottleNorm = THROTTLE_NORMALIZED;
+  }
+
+  uint32_t seq = g_lutPublishSeq.load(std::memory_order_acquire);
+  if (seq != 0) {
+    const ThrottleLut_type* table = &g_lutTables[seq & 1U];
+    if (throttleLutKeyEquals(&table->key, &liveKey)) {
+      uint16_t outputPermille = table->outputPermille[inputThrottleNorm];
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (g_lutPublishSeq.load(std::memory_order_relaxed) == seq) {
+        return outputPermille;
+      }
+    }
+  }
+
+  g_lutFallbacks = g_lutFallbacks + 1U;
+  return throttleCurveEvaluate(&liveKey, inputThrottleNorm);
+}
+
+/**
+ * @brief Rebuild and publish the table if the published curve inputs changed
+ * @details Call periodically from Task1 (single writer), after activeTuningService().
+ * @return true if a new table was published
+ */
+bool throttleLutService() {
+  ActiveTuning_type tuning;
+  activeTuningGetPublished(&tuning);
+  if (tuning.extPotSensi) {
+    tuning.effectiveSensi_raw = g_escVar.effectiveSensi_raw;  /* Last ext-pot value seen by the control task */
+  }
+  ThrottleLutKey_type liveKey;
+  throttleLutKeyFromTuning(&tuning, &liveKey);
+
+  uint32_t seq = g_lutPublishSeq.load(std::memory_order_relaxed);
+  if (seq != 0 && throttleLutKeyEquals(&g_lutTables[seq & 1U].key, &liveKey)) {
+    return false;
+  }
+
+  uint32_t nextSeq = seq + 1U;
+  ThrottleLut_type* table = &g_lutTables[nextSeq & 1U];
+  table->key = liveKey;
+  ThrottleCurveKnots_type knots;
+  const ThrottleCurveKnots_type* shapeKnots = nullptr;
+  if (throttleCurveShapeActive(&liveKey.shape)) {
+    throttleCurvePrepareKnots(&liveKey, &knots);
+    shapeKnots = &knots;
+  }
+  for (uint16_t i = 0; i < THROTTLE_LUT_ENTRIES; i++) {
+    table->outputPermille[i] = throttleCurveEvaluateWith(&liveKey, shapeKnots, i);  /* <= maxSpeed * 10 <= 1000 */
+  }
+  g_lutPublishSeq.store(nextSeq, std::memory_order_release);
+  g_lutRebuilds++;
+  return true;
+}
+
+void throttleLutGetStats(ThrottleLutStats_type* outStats) {
+  if (outStats == nullptr) {
+    return;
+  }
+  outStats->rebuilds = g_lutRebuilds;
+  outStats->fallbacks = g_lutFallbacks;
+}
+
+/**
+ * @brief Parse a multi-point curve from "x:y,x:y,..." (percent, see ThrottleCurveShape_type)
+ * @details An empty text leaves no points, which means the vertex curve whatever the mode.
+ * @return false (outShape untouched) on a bad mode, syntax, range or ordering
+ */
+bool throttleCurveShapeParse(const char* text, uint8_t mode, ThrottleCurveShape_type* outShape) {
+  if (mode > THROTTLE_CURVE_MODE_SPLINE) {
+    return false;
+  }
+  ThrottleCurveShape_type shape;
+  memset(&shape, 0, sizeof(shape));
+  shape.mode = mode;
+  const char* p = text;
+  while (*p == ' ') p++;
+  while (*p != '\0') {
+    if (shape.count >= THROTTLE_CURVE_POINTS_MAX) {
+      return false;
+    }
+    char* end = nullptr;
+    long x = strtol(p, &end, 10);
+    if (end == p || *end != ':') {
+      return false;
+    }
+    p = end + 1;
+    long y = strtol(p, &end, 10);
+    if (end == p) {
+      return false;
+    }
+    p = end;
+    while (*p == ' ') p++;
+    if (*p == ',') {
+      p++;
+      while (*p == ' ') p++;
+      if (*p == '\0') return false;
+    } else if (*p != '\0') {
+      return false;
+    }
+    if (x < 1 || x > 99 || y < 0 || y > 100) {
+      return false;
+    }
+    if (shape.count > 0) {
+      const ThrottleCurvePoint_type* prev = &shape.points[shape.count - 1];
+      if (x <= prev->input_pct || y < prev->output_pct) {
+        return false;  /* X must rise, Y must not fall */
+      }
+    }
+    shape.points[shape.count].input_pct = (uint8_t)x;
+    shape.points[shape.count].output_pct = (uint8_t)y;
+    shape.count++;
+  }
+  *outShape = shape;
+  return true;
+}
+
+/**
+ * @brief Write the points as "x:y,x:y,..." (empty without points)
+ */
+void throttleCurveShapeFormat(const ThrottleCurveShape_type* shape, char* out, size_t outSize) {
+  if (outSize == 0) {
+    return;
+  }
+  out[0] = '\0';
+  size_t len = 0;
+  uint8_t count = min(shape->count, (uint8_t)THROTTLE_CURVE_POINTS_MAX);
+  for (uint8_t i = 0; i < count && len < outSize; i++) {
+    int n = snprintf(out + len, outSize - len, "%s%u:%u", (i > 0) ? "," : "",
+                     (unsigned)shape->points[i].input_pct, (unsigned)shape->points[i].output_pct);
+    if (n < 0) break;
+    len += (size_t)n;
+  }
+}
@@ -0,0 +1,49 @@
+#ifndef THROTTLE_LUT_H_
+#define THROTTLE_LUT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "HAL.h"
+#include "active_tuning.h"
+
+/* Throttle response table: one output entry per normalized trigger step (0..THROTTLE_NORMALIZED).
+ * Task1 rebuilds it from the published active tuning (once per publish, or when an ext pot
+ * moves SENSI); the control loop only indexes it with its per-tick snapshot as the key.
+ * Entries are in permille so SENSI's 0.5% steps and the curve slope survive down to the
+ * LEDC output instead of being rounded to whole percent.
+ * A multi-point curve (THROTTLE_CURVE_MODE_LINEAR/SPLINE) is evaluated only here, when the
+ * table is built, so the control loop pays one lookup whatever the curve; the monotone
+ * cubic uses Fritsch-Carlson (PCHIP) slopes, which never overshoot between the points. */
+#define THROTTLE_LUT_ENTRIES  (THROTTLE_NORMALIZED + 1)
+
+/**
+ * @brief Everything the throttle curve output depends on
+ * @details A table is valid for the control loop only while its key equals the live key.
+ */
+typedef struct {
+  uint16_t sensiRaw;        /* [0.5%] Effective SENSI (car minSpeed or ext pot) */
+  uint16_t maxSpeed;        /* [%] Car maxSpeed */
+  uint16_t fade;            /* [%] Car fade */
+  uint16_t vertexInput;     /* Car throttleCurveVertex.inputThrottle */
+  uint16_t vertexSpeedDiff; /* [%] Car throttleCurveVertex.curveSpeedDiff */
+  ThrottleCurveShape_type shape;  /* Car throttleCurveShape */
+} ThrottleLutKey_type;
+
+/**
+ * @brief Table usage counters
+ */
+typedef struct {
+  uint32_t rebuilds;   /* Tables built and published by throttleLutService() */
+  uint32_t fallbacks;  /* Control ticks that evaluated the curve directly (no matching table yet) */
+} ThrottleLutStats_type;
+
+void throttleLutKeyFromTuning(const ActiveTuning_type* tuning, ThrottleLutKey_type* outKey);
+void throttleLutKeyFromCar(const CarParam_type* car, ThrottleLutKey_type* outKey);
+uint16_t throttleCurveEvaluate(const ThrottleLutKey_type* key, uint16_t inputThrottleNorm);
+uint16_t throttleLutLookup(uint16_t inputThrottleNorm);
+bool throttleLutService();
+void throttleLutGetStats(ThrottleLutStats_type* outStats);
+bool throttleCurveShapeParse(const char* text, uint8_t mode, ThrottleCurveShape_type* outShape);
+void throttleCurveShapeFormat(const ThrottleCurveShape_type* shape, char* out, size_t outSize);
+
+#endif  /* THROTTLE_LUT_H_ */
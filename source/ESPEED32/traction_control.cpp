@@ -0,0 +1,101 @@
+#include "traction_control.h"
+#include <Arduino.h>
+
+/* Control task only */
+static bool g_tcHasPrev = false;
+static uint8_t g_tcPrevSpeed_halfPct = 0;
+static uint32_t g_tcPrevSampleMs = 0;
+static uint32_t g_tcCurrentBaseline_mA = 0;
+static uint8_t g_tcSlipCount = 0;
+static uint32_t g_tcTrim_x1000 = 0;       /* [0.001%] Duty currently taken away */
+static uint32_t g_tcPrevCallUs = 0;
+
+/**
+ * @brief Forget the slip model and drop any trim (trigger released, braking, mode change)
+ */
+void tractionControlReset() {
+  g_tcHasPrev = false;
+  g_tcSlipCount = 0;
+  g_tcTrim_x1000 = 0;
+  g_tcCurrentBaseline_mA = 0;
+  g_tcPrevCallUs = micros();
+}
+
+/* One new back-EMF sample: update the slip detector and the current baseline */
+static void tractionControlOnSample(uint16_t antiSpinMs, uint8_t speed_halfPct, uint32_t sampleMs, uint16_t current_mA) {
+  uint32_t dtMs = sampleMs - g_tcPrevSampleMs;
+  if (g_tcHasPrev && dtMs > 0 && dtMs <= TRACTION_SAMPLE_GAP_MAX_MS) {
+    int32_t rise_halfPct = (int32_t)speed_halfPct - (int32_t)g_tcPrevSpeed_halfPct;
+    /* Grip limit: 0 -> 100% (200 half-percent) no faster than antiSpin ms */
+    int32_t allowed_halfPct = (int32_t)((200UL * dtMs + antiSpinMs - 1U) / antiSpinMs);
+    bool currentNotRising = (uint32_t)current_mA * 100U <=
+                            g_tcCurrentBaseline_mA * (100U + TRACTION_CURRENT_MARGIN_PCT);
+    if (rise_halfPct > allowed_halfPct && currentNotRising) {
+      if (g_tcSlipCount < 0xFF) g_tcSlipCount++;
+    } else {
+      g_tcSlipCount = 0;
+    }
+    if (g_tcSlipCount >= TRACTION_SLIP_CONFIRM_SAMPLES) {
+      g_tcTrim_x1000 = min(g_tcTrim_x1000 + TRACTION_TRIM_STEP_PCT * 1000UL, (uint32_t)TRACTION_TRIM_MAX_PCT * 1000UL);
+    }
+    g_tcCurrentBaseline_mA = (g_tcCurrentBaseline_mA * 7U + current_mA) / 8U;
+  } else {
+    g_tcSlipCount = 0;
+    g_tcCurrentBaseline_mA = current_mA;
+  }
+  g_tcPrevSpeed_halfPct = speed_halfPct;
+  g_tcPrevSampleMs = sampleMs;
+  g_tcHasPrev = true;
+}
+
+/**
+ * @brief Trim the requested duty while the back-EMF shows wheel spin
+ * @param requestedSpeed [0.1%] Duty after the throttle curve
+ * @param minSpeed [0.1%] SENSI floor: a trimmed duty never drops below it
+ * @param antiSpinMs Grip-limited time to full speed; 0 disables traction control
+ * @param speedValid false while no fresh back-EMF estimate exists (high duty, no off-window):
+ *        detection pauses and the trim keeps fading out
+ * @return [0.1%] Duty to apply
+ */
+uint16_t tractionControlApply(uint16_t requestedSpeed,
+                              uint16_t minSpeed,
+                              uint16_t antiSpinMs,
+                              bool speedValid,
+                              uint8_t speed_halfPct,
+                              uint32_t sampleMs,
+                              uint16_t current_mA) {
+  uint32_t nowUs = micros();
+  uint32_t dtUs = nowUs - g_tcPrevCallUs;
+  g_tcPrevCallUs = nowUs;
+
+  if (antiSpinMs == 0 || requestedSpeed == 0) {
+    tractionControlReset();
+    return requestedSpeed;
+  }
+
+  if (!speedValid) {
+    g_tcHasPrev = false;
+  } else if (!g_tcHasPrev || sampleMs != g_tcPrevSampleMs) {
+    tractionControlOnSample(antiSpinMs, speed_halfPct, sampleMs, current_mA);
+  }
+
+  /* Recover: the full trim fades out over antiSpin ms once the slip has stopped */
+  if (g_tcSlipCount < TRACTION_SLIP_CONFIRM_SAMPLES && g_tcTrim_x1000 > 0) {
+    uint32_t fade_x1000 = ((uint32_t)TRACTION_TRIM_MAX_PCT * dtUs) / antiSpinMs;
+    g_tcTrim_x1000 = (fade_x1000 >= g_tcTrim_x1000) ? 0 : g_tcTrim_x1000 - fade_x1000;
+  }
+
+  uint16_t trim = (uint16_t)(g_tcTrim_x1000 / 100U);  /* [0.1%] */
+  if (trim == 0 || requestedSpeed <= minSpeed) {
+    return requestedSpeed;
+  }
+  uint16_t trimmed = (requestedSpeed > trim) ? (uint16_t)(requestedSpeed - trim) : 0;
+  return max(trimmed, minSpeed);
+}
+
+/**
+ * @brief Duty currently taken away by traction control [%]
+ */
+uint8_t tractionControlGetTrimPct() {
+  return (uint8_t)(g_tcTrim_x1000 / 1000U);
+}
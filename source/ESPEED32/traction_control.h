@@ -0,0 +1,31 @@
+#ifndef TRACTION_CONTROL_H_
+#define TRACTION_CONTROL_H_
+
+#include <stdint.h>
+
+/* Closed-loop anti-spin (ANTISPIN_MODE_TRACTION).
+ * With grip the car's mass limits how fast the rotor can speed up; when the tyres break
+ * loose the load drops away, the back-EMF speed jumps and the motor current stops rising
+ * with the duty. A back-EMF sample counts as slip when the speed rose faster than the
+ * grip limit (full speed in antiSpin ms) while the current stayed at or below its recent
+ * baseline. Confirmed slip trims the duty step by step; without slip the trim fades out
+ * over antiSpin ms, so launches with grip are never limited.
+ * Runs on the control task per tick: a few integer operations, no divisions per sample
+ * beyond the two limits. */
+#define TRACTION_SLIP_CONFIRM_SAMPLES  2     /* Consecutive slipping samples before trimming */
+#define TRACTION_TRIM_STEP_PCT         4     /* [%] Trim added per slipping sample */
+#define TRACTION_TRIM_MAX_PCT          40    /* [%] Largest duty reduction */
+#define TRACTION_CURRENT_MARGIN_PCT    10    /* [%] Current rise above baseline that still counts as "not rising" */
+#define TRACTION_SAMPLE_GAP_MAX_MS     20U   /* Larger gaps between back-EMF samples restart the model */
+
+void tractionControlReset();
+uint16_t tractionControlApply(uint16_t requestedSpeed,
+                              uint16_t minSpeed,
+                              uint16_t antiSpinMs,
+                              bool speedValid,
+                              uint8_t speed_halfPct,
+                              uint32_t sampleMs,
+                              uint16_t current_mA);
+uint8_t tractionControlGetTrimPct();
+
+#endif  /* TRACTION_CONTROL_H_ */
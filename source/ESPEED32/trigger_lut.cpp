@@ -0,0 +1,200 @@
+#include "trigger_lut.h"
+#include <Arduino.h>
+#include <atomic>
+#include <string.h>
+#include "control_math.h"
+
+typedef struct {
+  int16_t minRaw;
+  int16_t maxRaw;
+  int16_t linPoints[TRIGGER_LIN_POINTS];
+} TriggerLutKey_type;
+
+typedef struct {
+  TriggerLutKey_type key;
+  bool linearized;                            /* key.linPoints passed triggerLutPointsValid() */
+  uint8_t shift;                              /* Entry = (raw - minRaw) >> shift */
+  uint16_t entries;
+  uint16_t norm[TRIGGER_LUT_ENTRIES_MAX];     /* triggerLutEvaluate() per entry */
+} TriggerLut_type;
+
+/* Double buffer, same scheme as throttle_lut.cpp: g_trigLutPublishSeq selects the active
+ * table (seq & 1), 0 = nothing published yet; the builder only writes the inactive one. */
+static TriggerLut_type g_trigLutTables[2];
+static std::atomic<uint32_t> g_trigLutPublishSeq(0);
+static uint32_t g_trigLutRebuilds = 0;
+static volatile uint32_t g_trigLutFallbacks = 0;
+
+/* Written by Task1 only (boot, CALIBRATION, restore); the table carries its own copy */
+static int16_t g_triggerLinPoints[TRIGGER_LIN_POINTS] = {0};
+
+/**
+ * @brief Distance along the trigger travel from the released end
+ */
+static inline int32_t triggerLutTravel(int16_t raw, int16_t minRaw, int16_t maxRaw) {
+  return THROTTLE_REV ? (int32_t)maxRaw - raw : (int32_t)raw - minRaw;
+}
+
+/**
+ * @brief Linearization points usable against this calibration
+ * @return false for all zero (no points) or points that do not rise strictly inside the span
+ */
+bool triggerLutPointsValid(const int16_t* linPoints, int16_t minRaw, int16_t maxRaw) {
+  if (linPoints == nullptr || maxRaw <= minRaw) {
+    return false;
+  }
+  bool any = false;
+  for (uint8_t i = 0; i < TRIGGER_LIN_POINTS; i++) {
+    any |= (linPoints[i] != 0);
+  }
+  if (!any) {
+    return false;
+  }
+  int32_t prev = 0;
+  for (uint8_t i = 0; i < TRIGGER_LIN_POINTS; i++) {
+    int32_t t = triggerLutTravel(linPoints[i], minRaw, maxRaw);
+    if (t <= prev) {
+      return false;
+    }
+    prev = t;
+  }
+  return prev < (int32_t)maxRaw - minRaw;
+}
+
+/**
+ * @brief Normalize one reading: clamp, linearize (if the points are valid), deadband
+ * @details The table is built from this, and the control loop falls back to it while no
+ *          table matches the calibration. Same result as normalizeAndClamp() + addDeadBand()
+ *          without points.
+ * @return 0..THROTTLE_NORMALIZED, 0 on an empty span (calibration in progress)
+ */
+uint16_t triggerLutEvaluate(int16_t raw, int16_t minRaw, int16_t maxRaw, const int16_t* linPoints) {
+  if (maxRaw <= minRaw) {
+    return 0;
+  }
+  if (raw < minRaw) raw = minRaw;
+  if (raw > maxRaw) raw = maxRaw;
+
+  uint16_t norm;
+  if (triggerLutPointsValid(linPoints, minRaw, maxRaw)) {
+    /* Knots along the travel: released end, the points, pressed end; output evenly spaced */
+    int32_t knot[TRIGGER_LIN_POINTS + 2];
+    knot[0] = 0;
+    for (uint8_t i = 0; i < TRIGGER_LIN_POINTS; i++) {
+      knot[i + 1] = triggerLutTravel(linPoints[i], minRaw, maxRaw);
+    }
+    knot[TRIGGER_LIN_POINTS + 1] = (int32_t)maxRaw - minRaw;
+    int32_t t = triggerLutTravel(raw, minRaw, maxRaw);
+    uint8_t s = 0;
+    while (s < TRIGGER_LIN_POINTS && t > knot[s + 1]) {
+      s++;
+    }
+    int32_t y0 = ((int32_t)s * THROTTLE_NORMALIZED) / (TRIGGER_LIN_POINTS + 1);
+    int32_t y1 = ((int32_t)(s + 1) * THROTTLE_NORMALIZED) / (TRIGGER_LIN_POINTS + 1);
+    norm = (uint16_t)(y0 + ((t - knot[s]) * (y1 - y0)) / (knot[s + 1] - knot[s]));
+  } else {
+    norm = controlMathNormalizeAndClamp((uint16_t)raw, (uint16_t)minRaw, (uint16_t)maxRaw,
+                                        THROTTLE_NORMALIZED, THROTTLE_REV);
+  }
+  return controlMathAddDeadBand(norm, 0, THROTTLE_NORMALIZED, THROTTLE_DEADBAND_NORM);
+}
+
+/**
+ * @brief Normalized trigger for the control loop: one clamp and one table load
+ * @details Falls back to triggerLutEvaluate() while the published table was built for
+ *          another calibration (during CALIBRATION, or before the first build).
+ */
+uint16_t triggerLutLookup(int16_t raw, int16_t minRaw, int16_t maxRaw) {
+  uint32_t seq = g_trigLutPublishSeq.load(std::memory_order_acquire);
+  if (seq != 0) {
+    const TriggerLut_type* table = &g_trigLutTables[seq & 1U];
+    if (table->key.minRaw == minRaw && table->key.maxRaw == maxRaw) {
+      if (raw < minRaw) raw = minRaw;
+      if (raw > maxRaw) raw = maxRaw;
+      uint16_t norm = table->norm[(uint16_t)(raw - minRaw) >> table->shift];
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (g_trigLutPublishSeq.load(std::memory_order_relaxed) == seq) {
+        return norm;
+      }
+    }
+  }
+
+  g_trigLutFallbacks = g_trigLutFallbacks + 1U;
+  return triggerLutEvaluate(raw, minRaw, maxRaw, g_triggerLinPoints);
+}
+
+/**
+ * @brief Rebuild and publish the table if the calibration changed
+ * @details Call from Task1 (single writer) outside the CALIBRATION state, so the table is
+ *          built once per saved calibration rather than on every new extreme of the sweep.
+ * @return true if a new table was published
+ */
+bool triggerLutService(int16_t minRaw, int16_t maxRaw) {
+  TriggerLutKey_type liveKey;
+  memset(&liveKey, 0, sizeof(liveKey));
+  liveKey.minRaw = minRaw;
+  liveKey.maxRaw = maxRaw;
+  memcpy(liveKey.linPoints, g_triggerLinPoints, sizeof(liveKey.linPoints));
+
+  uint32_t seq = g_trigLutPublishSeq.load(std::memory_order_relaxed);
+  if (seq != 0 && memcmp(&g_trigLutTables[seq & 1U].key, &liveKey, sizeof(liveKey)) == 0) {
+    return false;
+  }
+  if (maxRaw <= minRaw) {
+    return false;  /* Nothing to tabulate; lookups fall back and return 0 */
+  }
+
+  uint32_t nextSeq = seq + 1U;
+  TriggerLut_type* table = &g_trigLutTables[nextSeq & 1U];
+  table->key = liveKey;
+  table->linearized = triggerLutPointsValid(liveKey.linPoints, minRaw, maxRaw);
+  uint32_t span = (uint32_t)((int32_t)maxRaw - minRaw);
+  uint8_t shift = 0;
+  while ((span >> shift) >= TRIGGER_LUT_ENTRIES_MAX) {
+    shift++;
+  }
+  table->shift = shift;
+  table->entries = (uint16_t)((span >> shift) + 1U);
+  for (uint16_t i = 0; i < table->entries; i++) {
+    /* Middle of the readings sharing the entry; exact when shift is 0 */
+    int32_t raw = (int32_t)minRaw + (int32_t)((uint32_t)i << shift) + (int32_t)((1U << shift) >> 1);
+    if (raw > maxRaw) raw = maxRaw;
+    table->norm[i] = triggerLutEvaluate((int16_t)raw, minRaw, maxRaw, liveKey.linPoints);
+  }
+  g_trigLutPublishSeq.store(nextSeq, std::memory_order_release);
+  g_trigLutRebuilds++;
+  return true;
+}
+
+/**
+ * @brief Replace the linearization points (nullptr clears them); Task1 only
+ */
+void triggerLutSetPoints(const int16_t* linPoints) {
+  if (linPoints == nullptr) {
+    memset(g_triggerLinPoints, 0, sizeof(g_triggerLinPoints));
+  } else {
+    memcpy(g_triggerLinPoints, linPoints, sizeof(g_triggerLinPoints));
+  }
+}
+
+void triggerLutGetPoints(int16_t* outPoints) {
+  if (outPoints != nullptr) {
+    memcpy(outPoints, g_triggerLinPoints, sizeof(g_triggerLinPoints));
+  }
+}
+
+void triggerLutGetStats(TriggerLutStats_type* outStats) {
+  if (outStats == nullptr) {
+    return;
+  }
+  memset(outStats, 0, sizeof(*outStats));
+  outStats->rebuilds = g_trigLutRebuilds;
+  outStats->fallbacks = g_trigLutFallbacks;
+  uint32_t seq = g_trigLutPublishSeq.load(std::memory_order_acquire);
+  if (seq != 0) {
+    const TriggerLut_type* table = &g_trigLutTables[seq & 1U];
+    outStats->entries = table->entries;
+    outStats->shift = table->shift;
+    outStats->linearized = table->linearized;
+  }
+}
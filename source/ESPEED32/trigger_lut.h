@@ -0,0 +1,43 @@
+#ifndef TRIGGER_LUT_H_
+#define TRIGGER_LUT_H_
+
+#include <stdint.h>
+#include "HAL.h"
+
+/* Trigger normalization table: raw sensor reading -> trigger_norm (0..THROTTLE_NORMALIZED),
+ * clamp, optional linearization and deadband folded into one entry per raw step.
+ * Task1 rebuilds it when the calibration (min/max raw, linearization points) changes and
+ * never while the CALIBRATION state is sweeping; the control loop clamps the reading to
+ * the calibrated span and loads one entry. Spans wider than TRIGGER_LUT_ENTRIES_MAX raw
+ * steps share an entry between 2^shift neighbouring readings, still finer than the
+ * normalized output.
+ * Linearization: the calibration screen can capture TRIGGER_LIN_POINTS readings with the
+ * trigger at 1/(N+1) .. N/(N+1) of its travel. The curve then runs piecewise linear through
+ * them instead of straight from min to max, which evens out magnetic angle sensors
+ * (AS5600, MT6701) over a short trigger arc. All zero = no points; points that do not
+ * rise along the travel are rejected. */
+#ifndef TRIGGER_LIN_POINTS
+#define TRIGGER_LIN_POINTS        3
+#endif
+#define TRIGGER_LUT_ENTRIES_MAX   1024U
+
+/**
+ * @brief Table usage counters
+ */
+typedef struct {
+  uint32_t rebuilds;   /* Tables built and published by triggerLutService() */
+  uint32_t fallbacks;  /* Control ticks that normalized arithmetically (no matching table yet) */
+  uint16_t entries;    /* Entries in the published table, 0 = none */
+  uint8_t shift;       /* Raw steps per entry = 1 << shift */
+  bool linearized;     /* Published table uses the linearization points */
+} TriggerLutStats_type;
+
+uint16_t triggerLutEvaluate(int16_t raw, int16_t minRaw, int16_t maxRaw, const int16_t* linPoints);
+uint16_t triggerLutLookup(int16_t raw, int16_t minRaw, int16_t maxRaw);
+bool triggerLutService(int16_t minRaw, int16_t maxRaw);
+bool triggerLutPointsValid(const int16_t* linPoints, int16_t minRaw, int16_t maxRaw);
+void triggerLutSetPoints(const int16_t* linPoints);
+void triggerLutGetPoints(int16_t* outPoints);
+void triggerLutGetStats(TriggerLutStats_type* outStats);
+
+#endif  /* TRIGGER_LUT_H_ */
@@ -0,0 +1,131 @@
+#include "trigger_replay.h"
+#include <Arduino.h>
+#include <string.h>
+#include "HAL.h"
+
+static void triggerReplayPrepare(TriggerReplayCandidate_type* c, const CarParam_type* car) {
+  memset(c, 0, sizeof(*c));
+  c->car = *car;
+  throttleLutKeyFromCar(car, &c->curve);
+  c->antiSpinParams = { car->antiSpin, ANTISPIN_MAX_VALUE, car->minSpeed, SENSI_SCALE, car->maxSpeed };
+  brakeEnvelopePrepare(car, &c->envelope);
+  c->releaseZone_norm = (uint32_t)car->quickBrakeThreshold * THROTTLE_NORMALIZED / 100;
+  c->envelopeDone = true;
+}
+
+/**
+ * @brief Start a replay of about expectedSamples samples against carCount candidates
+ * @param applyDeadBand true for raw traces; recorded telemetry is already past the deadband
+ */
+void triggerReplayBegin(TriggerReplay_type* replay, const CarParam_type* cars, uint8_t carCount,
+                        uint32_t expectedSamples, bool applyDeadBand) {
+  memset(replay, 0, sizeof(*replay));
+  replay->candidateCount = min(carCount, (uint8_t)TRIGGER_REPLAY_MAX_CANDIDATES);
+  replay->applyDeadBand = applyDeadBand;
+  replay->bucketSamples = max((uint32_t)1U, (expectedSamples + TRIGGER_REPLAY_MAX_POINTS - 1U) / TRIGGER_REPLAY_MAX_POINTS);
+  for (uint8_t i = 0; i < replay->candidateCount; i++) {
+    triggerReplayPrepare(&replay->candidates[i], &cars[i]);
+  }
+}
+
+/* One control tick of one candidate, same decisions as runControlCycle() */
+static void triggerReplayStep(TriggerReplayCandidate_type* c, uint32_t now_us, uint32_t dt_us,
+                              uint16_t triggerNorm, bool brakeButton) {
+  const CarParam_type* car = &c->car;
+  bool triggerReleasing = triggerNorm < c->prevTriggerNorm;
+  bool inReleaseZone = (c->releaseZone_norm > 0) && (triggerNorm < c->releaseZone_norm);
+  uint16_t output_permille = 0;
+  uint16_t drag_permille = 0;
+
+  if (triggerNorm == 0) {
+    if (c->prevTriggerNorm != 0) {
+      c->brakeStart_us = now_us;
+      c->envelopeDone = !c->envelope.enabled;
+    }
+    drag_permille = (brakeButton ? car->brakeButtonReduction : car->brake) * 10U;
+    if (!brakeButton && !c->envelopeDone) {
+      uint32_t elapsed_us = now_us - c->brakeStart_us;
+      drag_permille = brakeEnvelopeLevel(&c->envelope, drag_permille, elapsed_us);
+      c->envelopeDone = elapsed_us >= c->envelope.hold_us + c->envelope.ramp_us;
+    }
+    controlMathAntiSpinRamp(&c->antiSpin, 0, &c->antiSpinParams, now_us);
+  } else if (car->quickBrakeEnabled == RELEASE_BRAKE_QUICK && inReleaseZone) {
+    drag_permille = car->quickBrakeStrength * 10U;
+    c->releaseActive_us += dt_us;
+    controlMathAntiSpinRamp(&c->antiSpin, 0, &c->antiSpinParams, now_us);
+  } else {
+    uint16_t curve_permille = throttleCurveEvaluate(&c->curve, triggerNorm);
+    output_permille = controlMathAntiSpinRamp(&c->antiSpin, curve_permille, &c->antiSpinParams, now_us);
+    if (output_permille < curve_permille) {
+      c->antiSpinLimited_us += dt_us;
+    }
+    if (car->quickBrakeEnabled == RELEASE_BRAKE_DRAG && triggerReleasing) {
+      drag_permille = car->quickBrakeStrength * 10U;
+      c->releaseActive_us += dt_us;
+    }
+  }
+  c->prevTriggerNorm = triggerNorm;
+
+  if (drag_permille > 0) {
+    c->brake_us += dt_us;
+  }
+  if (output_permille > c->peakOutput_permille) {
+    c->peakOutput_permille = output_permille;
+  }
+  c->outputSum_permille += output_permille;
+  c->brakeSum_permille += drag_permille;
+  c->bucketOutput_permille += output_permille;
+  c->bucketBrake_permille += drag_permille;
+}
+
+static void triggerReplayCloseBucket(TriggerReplay_type* replay) {
+  if (replay->bucketFill == 0 || replay->pointCount >= TRIGGER_REPLAY_MAX_POINTS) {
+    return;
+  }
+  uint16_t point = replay->pointCount++;
+  replay->trigger_norm[point] = (uint16_t)(replay->bucketTrigger_norm / replay->bucketFill);
+  for (uint8_t i = 0; i < replay->candidateCount; i++) {
+    TriggerReplayCandidate_type* c = &replay->candidates[i];
+    c->output_permille[point] = (uint16_t)(c->bucketOutput_permille / replay->bucketFill);
+    c->brake_permille[point] = (uint16_t)(c->bucketBrake_permille / replay->bucketFill);
+    c->bucketOutput_permille = 0;
+    c->bucketBrake_permille = 0;
+  }
+  replay->bucketFill = 0;
+  replay->bucketTrigger_norm = 0;
+}
+
+/**
+ * @brief Feed the next trace sample to every candidate
+ * @param dt_us Time since the previous sample
+ * @param trigger_norm 0..THROTTLE_NORMALIZED
+ * @return false once TRIGGER_REPLAY_MAX_SAMPLES were fed (the sample is dropped)
+ */
+bool triggerReplayFeed(TriggerReplay_type* replay, uint32_t dt_us, uint16_t trigger_norm, bool brakeButton) {
+  if (replay->samples >= TRIGGER_REPLAY_MAX_SAMPLES) {
+    return false;
+  }
+  if (trigger_norm > THROTTLE_NORMALIZED) {
+    trigger_norm = THROTTLE_NORMALIZED;
+  }
+  if (replay->applyDeadBand) {
+    trigger_norm = controlMathAddDeadBand(trigger_norm, 0, THROTTLE_NORMALIZED, THROTTLE_DEADBAND_NORM);
+  }
+  replay->now_us += dt_us;
+  for (uint8_t i = 0; i < replay->candidateCount; i++) {
+    triggerReplayStep(&replay->candidates[i], replay->now_us, dt_us, trigger_norm, brakeButton);
+  }
+  replay->samples++;
+  replay->bucketTrigger_norm += trigger_norm;
+  if (++replay->bucketFill >= replay->bucketSamples) {
+    triggerReplayCloseBucket(replay);
+  }
+  return true;
+}
+
+/**
+ * @brief Close the last, partly filled point
+ */
+void triggerReplayEnd(TriggerReplay_type* replay) {
+  triggerReplayCloseBucket(replay);
+}
@@ -0,0 +1,68 @@
+#ifndef TRIGGER_REPLAY_H_
+#define TRIGGER_REPLAY_H_
+
+#include <stdint.h>
+#include "slot_ESC.h"
+#include "control_math.h"
+#include "throttle_lut.h"
+#include "brake_envelope.h"
+
+/* Trigger-trace replay: evaluate car settings against a recorded trigger trace, off-line.
+ * A trace (telemetry ring or uploaded) is fed sample by sample through the same stages the
+ * control loop runs - deadband (uploaded traces only: recorded trigger_pct is already past
+ * it), throttleCurveEvaluate(), controlMathAntiSpinRamp(), release brake and the brake
+ * envelope - once per candidate CarParam_type, on a virtual clock driven by the trace
+ * timestamps. Nothing touches the half bridge or the live tuning, so it runs in the
+ * WiFiTask as fast as the CPU allows. Not modelled: ext pots (stored values are used),
+ * traction control (needs a real back-EMF; the open-loop ramp is used) and the thermal
+ * limit. Output and brake are kept per bucket of samples so a long trace still fits in
+ * TRIGGER_REPLAY_MAX_POINTS points per candidate. */
+#define TRIGGER_REPLAY_MAX_CANDIDATES  4U
+#define TRIGGER_REPLAY_MAX_POINTS      256U
+#define TRIGGER_REPLAY_MAX_SAMPLES     200000UL   /* ~100 s of 2 kHz telemetry */
+
+/**
+ * @brief One candidate: pipeline state and what it produced
+ */
+typedef struct {
+  CarParam_type car;
+  ThrottleLutKey_type curve;
+  AntiSpinRampParams_type antiSpinParams;
+  AntiSpinRamp_type antiSpin;
+  BrakeEnvelope_type envelope;
+  uint16_t releaseZone_norm;
+  uint16_t prevTriggerNorm;
+  uint32_t brakeStart_us;
+  bool envelopeDone;
+  /* Results */
+  uint64_t outputSum_permille;          /* Over all samples */
+  uint64_t brakeSum_permille;
+  uint16_t peakOutput_permille;
+  uint32_t antiSpinLimited_us;          /* Ramp held the output below the curve */
+  uint32_t releaseActive_us;            /* QUICK or DRAG release brake acting */
+  uint32_t brake_us;                    /* Any brake above 0 */
+  uint32_t bucketOutput_permille;       /* Sums of the bucket being filled */
+  uint32_t bucketBrake_permille;
+  uint16_t output_permille[TRIGGER_REPLAY_MAX_POINTS];  /* Bucket means */
+  uint16_t brake_permille[TRIGGER_REPLAY_MAX_POINTS];
+} TriggerReplayCandidate_type;
+
+typedef struct {
+  uint8_t candidateCount;
+  bool applyDeadBand;
+  uint32_t bucketSamples;               /* Samples per point */
+  uint32_t samples;                     /* Fed so far */
+  uint32_t now_us;                      /* Virtual clock */
+  uint16_t pointCount;
+  uint32_t bucketFill;
+  uint32_t bucketTrigger_norm;
+  uint16_t trigger_norm[TRIGGER_REPLAY_MAX_POINTS];     /* Bucket means of the input */
+  TriggerReplayCandidate_type candidates[TRIGGER_REPLAY_MAX_CANDIDATES];
+} TriggerReplay_type;
+
+void triggerReplayBegin(TriggerReplay_type* replay, const CarParam_type* cars, uint8_t carCount,
+                        uint32_t expectedSamples, bool applyDeadBand);
+bool triggerReplayFeed(TriggerReplay_type* replay, uint32_t dt_us, uint16_t trigger_norm, bool brakeButton);
+void triggerReplayEnd(TriggerReplay_type* replay);
+
+#endif  /* TRIGGER_REPLAY_H_ */
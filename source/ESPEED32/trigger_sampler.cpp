@@ -0,0 +1,130 @@
+#include "trigger_sampler.h"
+#include <Arduino.h>
+#include <atomic>
+#include "HAL.h"
+#include "perf_probe.h"
+#include "latency_bench.h"
+
+/* Single-slot buffer guarded by a sequence counter (seqlock).
+ * One writer (sampler task), any number of readers; readers never block the writer.
+ * Odd sequence = write in progress. */
+static std::atomic<uint32_t> g_trigSlotSeq(0);
+static volatile int16_t g_trigSlotRaw = 0;
+static volatile uint32_t g_trigSlotTime_us = 0;
+static volatile uint32_t g_trigSlotCount = 0;
+static TaskHandle_t g_trigSamplerTask = NULL;
+
+static const uint8_t TRIGGER_SLOT_READ_RETRIES = 4;
+
+static void triggerSamplerPublish(int16_t raw, uint32_t timestamp_us) {
+  uint32_t seq = g_trigSlotSeq.load(std::memory_order_relaxed);
+  g_trigSlotSeq.store(seq + 1U, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  g_trigSlotRaw = raw;
+  g_trigSlotTime_us = timestamp_us;
+  g_trigSlotCount = g_trigSlotCount + 1U;
+  std::atomic_thread_fence(std::memory_order_release);
+  g_trigSlotSeq.store(seq + 2U, std::memory_order_release);
+}
+
+static void triggerSamplerTaskcode(void *pvParameters) {
+  (void)pvParameters;
+  for (;;) {
+    /* One read per control tick; the blocking I2C transfer happens here, not in Task2 */
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    uint32_t busStart = perfProbeStart();
+    uint32_t readStart_us = micros();
+    int16_t raw = HAL_ReadTriggerRaw();
+    perfProbeEnd(PERF_STAGE_SENSOR_BUS, busStart);
+    /* The latency bench swaps in its synthetic steps here, so the whole pipeline sees them */
+    triggerSamplerPublish(latencyBenchTriggerRaw(raw, readStart_us), micros());
+  }
+}
+
+/**
+ * @brief Create the sampler task and take a first synchronous reading
+ * @return true if the sampler task is running
+ */
+bool triggerSamplerStart() {
+  if (g_trigSamplerTask != NULL) {
+    return true;
+  }
+  /* Seed the slot so the first control tick has a valid sample */
+  triggerSamplerPublish(HAL_ReadTriggerRaw(), micros());
+  BaseType_t ok = xTaskCreatePinnedToCore(
+    triggerSamplerTaskcode,
+    "TrigSampler",
+    TRIGGER_SAMPLER_STACK_SIZE,
+    NULL,
+    TRIGGER_SAMPLER_TASK_PRIORITY,
+    &g_trigSamplerTask,
+    TRIGGER_SAMPLER_TASK_CORE);
+  if (ok != pdPASS) {
+    g_trigSamplerTask = NULL;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Request one sensor read; returns immediately
+ */
+void triggerSamplerKick() {
+  if (g_trigSamplerTask != NULL) {
+    xTaskNotifyGive(g_trigSamplerTask);
+  }
+}
+
+/**
+ * @brief Load the latest published sample without blocking
+ * @return false if no sample has been published yet or the slot kept changing under the reader
+ */
+bool triggerSamplerGetLatest(TriggerSample_type* outSample) {
+  if (outSample == nullptr) {
+    return false;
+  }
+  for (uint8_t attempt = 0; attempt < TRIGGER_SLOT_READ_RETRIES; attempt++) {
+    uint32_t seqBefore = g_trigSlotSeq.load(std::memory_order_acquire);
+    if (seqBefore & 1U) {
+      continue;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    int16_t raw = g_trigSlotRaw;
+    uint32_t timestamp_us = g_trigSlotTime_us;
+    uint32_t count = g_trigSlotCount;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (g_trigSlotSeq.load(std::memory_order_acquire) == seqBefore) {
+      if (count == 0) {
+        return false;
+      }
+      outSample->raw = raw;
+      outSample->timestamp_us = timestamp_us;
+      outSample->seq = count;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Load the latest sample if it is younger than maxAge_us, and tell whether it is new
+ * @details A read that is still in flight when the consumer comes back leaves the same sample
+ *          in the slot; that is reported as a repeat rather than as a new reading.
+ * @param lastSeq Consumer's last consumed sequence (0 = none); advanced on TRIGGER_SAMPLE_NEW
+ */
+TriggerSampleStatus_enum triggerSamplerGetFresh(TriggerSample_type* outSample, uint32_t maxAge_us,
+                                                uint32_t* lastSeq) {
+  if (!triggerSamplerGetLatest(outSample)) {
+    return TRIGGER_SAMPLE_STALE;
+  }
+  if ((uint32_t)(micros() - outSample->timestamp_us) > maxAge_us) {
+    return TRIGGER_SAMPLE_STALE;
+  }
+  if (lastSeq != nullptr) {
+    if (outSample->seq == *lastSeq) {
+      return TRIGGER_SAMPLE_REPEAT;
+    }
+    *lastSeq = outSample->seq;
+  }
+  return TRIGGER_SAMPLE_NEW;
+}
@@ -0,0 +1,39 @@
+#ifndef TRIGGER_SAMPLER_H_
+#define TRIGGER_SAMPLER_H_
+
+#include <stdint.h>
+
+/* Trigger sampler: reads the trigger sensor in its own task so I2C bus time
+ * never blocks the control tick. The control loop kicks one read per tick and
+ * consumes the latest published sample on the next tick. */
+#define TRIGGER_SAMPLER_TASK_PRIORITY  3       /* Above Task2: preempts only to start/finish a transfer */
+#define TRIGGER_SAMPLER_TASK_CORE      1       /* Same core as Task2 */
+#define TRIGGER_SAMPLER_STACK_SIZE     4096
+#ifndef TRIGGER_SAMPLE_STALE_US
+#define TRIGGER_SAMPLE_STALE_US        20000UL /* [µs] Older samples are treated as a sensor fault -> safe brake */
+#endif
+
+/**
+ * @brief Latest trigger sensor reading published by the sampler
+ */
+typedef struct {
+  int16_t raw;             /* Raw sensor value, same scale as HAL_ReadTriggerRaw() */
+  uint32_t timestamp_us;   /* micros() when the read completed */
+  uint32_t seq;            /* Increments once per published sample */
+} TriggerSample_type;
+
+/**
+ * @brief Result of triggerSamplerGetFresh()
+ */
+typedef enum {
+  TRIGGER_SAMPLE_NEW,      /* Fresh and not seen by this consumer yet */
+  TRIGGER_SAMPLE_REPEAT,   /* Still fresh, but the consumer already has it (no read completed since) */
+  TRIGGER_SAMPLE_STALE     /* None published, unreadable, or older than maxAge_us */
+} TriggerSampleStatus_enum;
+
+bool triggerSamplerStart();
+void triggerSamplerKick();
+bool triggerSamplerGetLatest(TriggerSample_type* outSample);
+TriggerSampleStatus_enum triggerSamplerGetFresh(TriggerSample_type* outSample, uint32_t maxAge_us, uint32_t* lastSeq);
+
+#endif  /* TRIGGER_SAMPLER_H_ */
@@ -5,6 +5,9 @@
 #include "ui_strings.h"
 #include "ui_text_access.h"
 #include "connectivity_portal.h"
+#include "oled_frame.h"
+#include "oled_screen_cache.h"
+#include "scheduler_profile.h"
 
 extern StoredVar_type g_storedVar;
 extern ESC_type g_escVar;
@@ -74,11 +77,27 @@ static void formatAntiSpinValue(char* out, size_t outSize, uint16_t antiSpinMs)
   }
 }
 
+#define UI_MENU_MAX_LINES 5   /* getMenuLines() with the small list font */
+
+/* Retained fields of the main screens: redrawn only when their text changes */
+static OledField_type g_statusFields[STATUS_SLOTS];
+static OledField_type g_limiterField;
+static OledField_type g_raceLabelFields[4];
+static OledField_type g_raceValueFields[4];
+static OledField_type g_menuNameFields[UI_MENU_MAX_LINES];
+static OledField_type g_menuValueFields[UI_MENU_MAX_LINES];
+
+static void invalidateRaceFields() {
+  for (uint8_t i = 0; i < 4; i++) {
+    oledFieldInvalidate(&g_raceLabelFields[i]);
+    oledFieldInvalidate(&g_raceValueFields[i]);
+  }
+}
+
 /**
- * @brief Display bottom status line with throttle, car name and voltage
- * @details Common function used by both main menu and screensaver
+ * @brief Draw the bottom status line into the frame (no flush)
  */
-void displayStatusLine() {
+static void drawStatusLine() {
   const uint8_t Y = 3 * HEIGHT12x16 + HEIGHT8x8;  /* y = 56 (bottom status row) */
 
   /* Fixed column x-positions for each slot (4 × 32px = 128px total).
@@ -100,6 +119,8 @@ void displayStatusLine() {
   char buf[7];  /* 5 chars + null */
   int8_t lockSlot = -1;
   int8_t wifiSlot = -1;
+  int8_t raceSlot = -1;
+  bool raceProfile = (schedProfileGet() == SCHED_PROFILE_RACE);
 
   /* Settings lock indicator: find a blank slot, or steal slot 0 */
   if (isSettingsLocked()) {
@@ -127,26 +148,41 @@ void displayStatusLine() {
     }
   }
 
+  /* Race scheduler profile: a spare blank slot if there is one; the WiFi indicator also
+   * reads "WIFI-" while the portal is throttled */
+  if (raceProfile) {
+    for (uint8_t s = 0; s < STATUS_SLOTS; s++) {
+      if ((int8_t)s == lockSlot || (int8_t)s == wifiSlot) continue;
+      if (normalizeStatusSlotValue(g_storedVar.statusSlot[s]) == STATUS_BLANK) {
+        raceSlot = (int8_t)s;
+        break;
+      }
+    }
+  }
+
   for (uint8_t s = 0; s < STATUS_SLOTS; s++) {
     uint16_t slot = normalizeStatusSlotValue(g_storedVar.statusSlot[s]);
     uint8_t color = OBD_BLACK;
 
     if (lockSlot == (int8_t)s) {
-      strcpy(buf, "LOCK ");
-      obdWriteString(&g_obd, 0, SLOT_X[s], Y, buf, FONT_6x8, OBD_WHITE, 1);
+      oledFieldDraw(&g_statusFields[s], SLOT_X[s], Y, "LOCK ", FONT_6x8, OBD_WHITE);
       continue;
     }
 
     if (wifiSlot == (int8_t)s) {
-      strcpy(buf, "WIFI ");
-      obdWriteString(&g_obd, 0, SLOT_X[s], Y, buf, FONT_6x8, color, 1);
+      oledFieldDraw(&g_statusFields[s], SLOT_X[s], Y, raceProfile ? "WIFI-" : "WIFI ", FONT_6x8, color);
+      continue;
+    }
+
+    if (raceSlot == (int8_t)s) {
+      oledFieldDraw(&g_statusFields[s], SLOT_X[s], Y, "RACE ", FONT_6x8, color);
       continue;
     }
 
     switch (slot) {
       case STATUS_OUTPUT:
         if (digitalRead(BUTT_PIN) == BUTTON_PRESSED && g_escVar.trigger_norm == 0) {
-          sprintf(buf, "B%3d%%", g_storedVar.carParam[g_carSel].brakeButtonReduction);
+          sprintf(buf, "B%3d%%", g_storedVar.activeCar.brakeButtonReduction);
         } else {
           sprintf(buf, "%3d%%O", g_escVar.outputSpeed_pct);
         }
@@ -158,7 +194,7 @@ void displayStatusLine() {
         break;
       }
       case STATUS_CAR:
-        snprintf(buf, 6, "%-5s", g_storedVar.carParam[g_carSel].carName);
+        snprintf(buf, 6, "%-5s", g_storedVar.activeCar.carName);
         color = carSelected ? OBD_WHITE : OBD_BLACK;
         break;
       case STATUS_CURRENT:
@@ -183,43 +219,59 @@ void displayStatusLine() {
       case STATUS_ACTIVE_BRAKE:
         formatActiveBrakeStatus(buf, sizeof(buf), g_escVar.activeBrakeKind, g_escVar.activeBrake_pct);
         break;
+      case STATUS_TEMP:
+        if (g_escVar.chipTemp_C == INT16_MIN) {
+          strcpy(buf, g_escVar.thermalLimit_pct < 100 ? "  --*" : "  --C");
+        } else {
+          snprintf(buf, sizeof(buf), "%3dC%c", (int)constrain(g_escVar.chipTemp_C, -99, 999),
+                   g_escVar.thermalLimit_pct < 100 ? '*' : ' ');
+        }
+        color = (g_escVar.thermalLimit_pct < 100) ? OBD_WHITE : OBD_BLACK;
+        break;
       default:  /* STATUS_BLANK */
         strcpy(buf, "     ");
         break;
     }
 
-    obdWriteString(&g_obd, 0, SLOT_X[s], Y, buf, FONT_6x8, color, 1);
+    oledFieldDraw(&g_statusFields[s], SLOT_X[s], Y, buf, FONT_6x8, color);
+  }
+}
+
+/**
+ * @brief Display bottom status line with throttle, car name and voltage
+ * @details Common function used by both main menu and screensaver.
+ *          Only slots whose text changed reach the panel.
+ */
+void displayStatusLine() {
+  drawStatusLine();
+  oledFrameFlush();
+}
+
+/**
+ * @brief Draw the LIMITER warning row if LIMIT is any value other than 100%
+ */
+static void drawLimiterWarning() {
+  if (g_storedVar.activeCar.maxSpeed < MAX_SPEED_DEFAULT) {
+    oledFieldDraw(&g_limiterField, WIDTH8x8, 3 * HEIGHT12x16, STR_LIMITER[g_storedVar.language], FONT_8x8, OBD_WHITE);
+  } else {
+    oledFieldDraw(&g_limiterField, WIDTH8x8, 3 * HEIGHT12x16, "             ", FONT_8x8, OBD_BLACK);
   }
 }
 
 /**
  * @brief Display simple race mode - shows only BRAKE and SENSI with larger font
- * @details Simplified race view with just the two most important parameters
+ * @details Simplified race view with just the two most important parameters.
+ *          Draws into the retained frame; printMainMenu() flushes it.
  * @param selectedItem Item selected for editing (0=BRAKE, 1=SENSI, 2=CAR if enabled)
  * @param isEditing True if currently editing a value
  */
 void displayRaceModeSimple(uint8_t selectedItem, bool isEditing) {
-  static uint16_t lastBrake = 999;
-  static uint16_t lastSensi = 999;
-  static bool lastBrakeUsesPot = false;
-  static bool lastSensiUsesPot = false;
-  static uint8_t lastSelectedItem = 255;
-  static bool lastIsEditing = false;
-  static uint16_t lastCarSel = 999;
-
   /* Simple mode: 0=BRAKE, 1=SENSI, 2=CAR (if enabled) */
   int col1_center = 32;   /* Center of left half (128/4 = 32) */
   int col2_center = 96;   /* Center of right half (128*3/4 = 96) */
 
-  /* Check if forced redraw, selection or car changed - force update of ALL items */
-  if (g_forceRaceRedraw || selectedItem != lastSelectedItem || isEditing != lastIsEditing || g_carSel != lastCarSel) {
-    lastBrake = 999;
-    lastSensi = 999;
-    lastBrakeUsesPot = false;
-    lastSensiUsesPot = false;
-    lastSelectedItem = selectedItem;
-    lastIsEditing = isEditing;
-    lastCarSel = g_carSel;
+  if (g_forceRaceRedraw) {
+    invalidateRaceFields();
   }
 
   /* Determine colors based on selection state */
@@ -227,43 +279,32 @@ void displayRaceModeSimple(uint8_t selectedItem, bool isEditing) {
   uint8_t colorSensi = (selectedItem == 1) ? OBD_WHITE : OBD_BLACK;
 
   /* BRAKE - left column, using FONT_12x16 for both label and value */
-  bool brakeUsesPot = isExtPotBrakeTarget() && !(isEditing && selectedItem == 0);
-  uint16_t brakeValue = getEffectiveBrakePct();
-  if (brakeUsesPot != lastBrakeUsesPot || (!brakeUsesPot && brakeValue != lastBrake)) {
-    /* Label - using language-specific text with FONT_12x16: 5 chars × 12px = 60px wide */
-    const char* brakeLabel = getRaceLabel(g_storedVar.language, 0);
-    uint8_t labelWidth = strlen(brakeLabel) * 12;
-    obdWriteString(&g_obd, 0, col1_center - (labelWidth / 2), 0, (char *)brakeLabel, FONT_12x16, colorBrake, 1);
-    if (brakeUsesPot) {
-      formatExtPotLabel(msgStr, sizeof(msgStr), getExtPotIndexForTarget(EXT_POT_TARGET_BRAKE));
-      obdWriteString(&g_obd, 0, col1_center - ((strlen(msgStr) * WIDTH12x16) / 2), 16, msgStr, FONT_12x16, colorBrake, 1);
-    } else {
-      /* Value - "100%" with FONT_12x16: 4 chars × 12px = 48px wide, center at col1_center - 24 */
-      sprintf(msgStr, "%3d%%", brakeValue);
-      obdWriteString(&g_obd, 0, col1_center - 24, 16, msgStr, FONT_12x16, colorBrake, 1);
-    }
-    lastBrake = brakeValue;
-    lastBrakeUsesPot = brakeUsesPot;
+  /* Label - using language-specific text with FONT_12x16: 5 chars × 12px = 60px wide */
+  const char* brakeLabel = uiText(UI_TEXT_RACE, g_storedVar.language, 0);
+  uint8_t labelWidth = strlen(brakeLabel) * 12;
+  oledFieldDraw(&g_raceLabelFields[0], col1_center - (labelWidth / 2), 0, brakeLabel, FONT_12x16, colorBrake);
+  if (isExtPotBrakeTarget() && !(isEditing && selectedItem == 0)) {
+    formatExtPotLabel(msgStr, sizeof(msgStr), getExtPotIndexForTarget(EXT_POT_TARGET_BRAKE));
+    oledFieldDraw(&g_raceValueFields[0], col1_center - ((strlen(msgStr) * WIDTH12x16) / 2), 16, msgStr, FONT_12x16, colorBrake);
+  } else {
+    /* Value - "100%" with FONT_12x16: 4 chars × 12px = 48px wide, center at col1_center - 24 */
+    sprintf(msgStr, "%3d%%", getEffectiveBrakePct());
+    oledFieldDraw(&g_raceValueFields[0], col1_center - 24, 16, msgStr, FONT_12x16, colorBrake);
   }
 
   /* SENSI - right column, using FONT_12x16 for both label and value */
-  bool sensiUsesPot = isExtPotSensiTarget() && !(isEditing && selectedItem == 1);
-  uint16_t sensiRaw = getEffectiveSensiRaw();
-  if (sensiUsesPot != lastSensiUsesPot || (!sensiUsesPot && sensiRaw != lastSensi)) {
-    /* Label - using language-specific text with FONT_12x16: 5 chars × 12px = 60px wide */
-    const char* sensiLabel = getRaceLabel(g_storedVar.language, 1);
-    uint8_t labelWidth = strlen(sensiLabel) * 12;
-    obdWriteString(&g_obd, 0, col2_center - (labelWidth / 2), 0, (char *)sensiLabel, FONT_12x16, colorSensi, 1);
-    if (sensiUsesPot) {
-      formatExtPotLabel(msgStr, sizeof(msgStr), getExtPotIndexForTarget(EXT_POT_TARGET_SENSI));
-      obdWriteString(&g_obd, 0, col2_center - ((strlen(msgStr) * WIDTH12x16) / 2), 16, msgStr, FONT_12x16, colorSensi, 1);
-    } else {
-      /* Value in 0.5% resolution, e.g. 20.5% */
-      sprintf(msgStr, "%2u.%u%%", sensiRaw / SENSI_SCALE, sensiFracDigit(sensiRaw));
-      obdWriteString(&g_obd, 0, col2_center - 30, 16, msgStr, FONT_12x16, colorSensi, 1);
-    }
-    lastSensi = sensiRaw;
-    lastSensiUsesPot = sensiUsesPot;
+  /* Label - using language-specific text with FONT_12x16: 5 chars × 12px = 60px wide */
+  const char* sensiLabel = uiText(UI_TEXT_RACE, g_storedVar.language, 1);
+  labelWidth = strlen(sensiLabel) * 12;
+  oledFieldDraw(&g_raceLabelFields[1], col2_center - (labelWidth / 2), 0, sensiLabel, FONT_12x16, colorSensi);
+  if (isExtPotSensiTarget() && !(isEditing && selectedItem == 1)) {
+    formatExtPotLabel(msgStr, sizeof(msgStr), getExtPotIndexForTarget(EXT_POT_TARGET_SENSI));
+    oledFieldDraw(&g_raceValueFields[1], col2_center - ((strlen(msgStr) * WIDTH12x16) / 2), 16, msgStr, FONT_12x16, colorSensi);
+  } else {
+    /* Value in 0.5% resolution, e.g. 20.5% */
+    uint16_t sensiRaw = getEffectiveSensiRaw();
+    sprintf(msgStr, "%2u.%u%%", sensiRaw / SENSI_SCALE, sensiFracDigit(sensiRaw));
+    oledFieldDraw(&g_raceValueFields[1], col2_center - 30, 16, msgStr, FONT_12x16, colorSensi);
   }
 
   /* Note: Car name, voltage, and LIMITER warning are displayed by displayStatusLine() */
@@ -272,41 +313,19 @@ void displayRaceModeSimple(uint8_t selectedItem, bool isEditing) {
 
 /**
  * @brief Display race mode - compact grid showing all key parameters
- * @details Shows throttle, brake, sensitivity, antispin, curve, limit, car name and voltage
+ * @details Shows throttle, brake, sensitivity, antispin, curve, limit, car name and voltage.
+ *          Draws into the retained frame; printMainMenu() flushes it.
  * @param selectedItem Item selected for editing (0-5, or 255 if none selected)
  * @param isEditing True if currently editing a value
  */
 void displayRaceMode(uint8_t selectedItem, bool isEditing) {
-  static uint16_t lastBrake = 999;
-  static uint16_t lastSensi = 999;
-  static bool lastBrakeUsesPot = false;
-  static bool lastSensiUsesPot = false;
-  static uint16_t lastAntis = 999;
-  static uint16_t lastAntisMode = 0xFFFF;
-  static uint16_t lastCurve = 999;
-  static uint8_t lastSelectedItem = 255;
-  static bool lastIsEditing = false;
-  static uint16_t lastCarSel = 999;
-
   /* Vertical layout - label above value, centered */
   /* Grid items: 0=BRAKE, 1=SENSI, 2=ANTIS, 3=CURVE, 4=CAR (if enabled) */
   int col1_center = 32;   /* Center of left half (128/4 = 32) */
   int col2_center = 96;   /* Center of right half (128*3/4 = 96) */
 
-  /* Check if forced redraw, selection or car changed - force update of ALL items */
-  if (g_forceRaceRedraw || selectedItem != lastSelectedItem || isEditing != lastIsEditing || g_carSel != lastCarSel) {
-    /* Force redraw of all items when selection changes */
-    lastBrake = 999;
-    lastSensi = 999;
-    lastBrakeUsesPot = false;
-    lastSensiUsesPot = false;
-    lastAntis = 999;
-    lastAntisMode = 0xFFFF;
-    lastCurve = 999;
-
-    lastSelectedItem = selectedItem;
-    lastIsEditing = isEditing;
-    lastCarSel = g_carSel;
+  if (g_forceRaceRedraw) {
+    invalidateRaceFields();
   }
 
   /* Determine colors based on selection state */
@@ -314,72 +333,58 @@ void displayRaceMode(uint8_t selectedItem, bool isEditing) {
   uint8_t colorSensi = (selectedItem == 1) ? OBD_WHITE : OBD_BLACK;
   uint8_t colorAntis = (selectedItem == 2) ? OBD_WHITE : OBD_BLACK;
   uint8_t colorCurve = (selectedItem == 3) ? OBD_WHITE : OBD_BLACK;
-  uint8_t colorCar = (selectedItem == 4) ? OBD_WHITE : OBD_BLACK;
 
   /* BRAKE - left column */
-  bool brakeUsesPot = isExtPotBrakeTarget() && !(isEditing && selectedItem == 0);
-  uint16_t brakeValue = getEffectiveBrakePct();
-  if (brakeUsesPot != lastBrakeUsesPot || (!brakeUsesPot && brakeValue != lastBrake)) {
-    /* Label - using language-specific text, dynamically centered */
-    const char* brakeLabel = getRaceLabel(g_storedVar.language, 0);
-    uint8_t labelWidth = strlen(brakeLabel) * 6;
-    obdWriteString(&g_obd, 0, col1_center - (labelWidth / 2), 2, (char *)brakeLabel, FONT_6x8, colorBrake, 1);
-    if (brakeUsesPot) {
-      formatExtPotLabel(msgStr, sizeof(msgStr), getExtPotIndexForTarget(EXT_POT_TARGET_BRAKE));
-      obdWriteString(&g_obd, 0, col1_center - ((strlen(msgStr) * WIDTH8x8) / 2), 12, msgStr, FONT_8x8, colorBrake, 1);
-    } else {
-      /* Value - "100%" is 4 chars × 8px = 32px wide, center at col1_center - 16 */
-      sprintf(msgStr, "%3d%%", brakeValue);
-      obdWriteString(&g_obd, 0, col1_center - 16, 12, msgStr, FONT_8x8, colorBrake, 1);
-    }
-    lastBrake = brakeValue;
-    lastBrakeUsesPot = brakeUsesPot;
+  /* Label - using language-specific text, dynamically centered */
+  const char* brakeLabel = uiText(UI_TEXT_RACE, g_storedVar.language, 0);
+  uint8_t labelWidth = strlen(brakeLabel) * 6;
+  oledFieldDraw(&g_raceLabelFields[0], col1_center - (labelWidth / 2), 2, brakeLabel, FONT_6x8, colorBrake);
+  if (isExtPotBrakeTarget() && !(isEditing && selectedItem == 0)) {
+    formatExtPotLabel(msgStr, sizeof(msgStr), getExtPotIndexForTarget(EXT_POT_TARGET_BRAKE));
+    oledFieldDraw(&g_raceValueFields[0], col1_center - ((strlen(msgStr) * WIDTH8x8) / 2), 12, msgStr, FONT_8x8, colorBrake);
+  } else {
+    /* Value - "100%" is 4 chars × 8px = 32px wide, center at col1_center - 16 */
+    sprintf(msgStr, "%3d%%", getEffectiveBrakePct());
+    oledFieldDraw(&g_raceValueFields[0], col1_center - 16, 12, msgStr, FONT_8x8, colorBrake);
   }
 
   /* SENSI - right column */
-  bool sensiUsesPot = isExtPotSensiTarget() && !(isEditing && selectedItem == 1);
-  uint16_t sensiRaw = getEffectiveSensiRaw();
-  if (sensiUsesPot != lastSensiUsesPot || (!sensiUsesPot && sensiRaw != lastSensi)) {
-    /* Label - using language-specific text, shifted 1px right */
-    const char* sensiLabel = getRaceLabel(g_storedVar.language, 1);
-    uint8_t labelWidth = strlen(sensiLabel) * 6;
-    obdWriteString(&g_obd, 0, col2_center - (labelWidth / 2) + 1, 2, (char *)sensiLabel, FONT_6x8, colorSensi, 1);
-    if (sensiUsesPot) {
-      formatExtPotLabel(msgStr, sizeof(msgStr), getExtPotIndexForTarget(EXT_POT_TARGET_SENSI));
-      obdWriteString(&g_obd, 0, col2_center - ((strlen(msgStr) * WIDTH8x8) / 2), 12, msgStr, FONT_8x8, colorSensi, 1);
-    } else {
-      /* Value in 0.5% resolution, e.g. 20.5% */
-      sprintf(msgStr, "%2u.%u%%", sensiRaw / SENSI_SCALE, sensiFracDigit(sensiRaw));
-      obdWriteString(&g_obd, 0, col2_center - 20, 12, msgStr, FONT_8x8, colorSensi, 1);
-    }
-    lastSensi = sensiRaw;
-    lastSensiUsesPot = sensiUsesPot;
+  /* Label - using language-specific text, shifted 1px right */
+  const char* sensiLabel = uiText(UI_TEXT_RACE, g_storedVar.language, 1);
+  labelWidth = strlen(sensiLabel) * 6;
+  oledFieldDraw(&g_raceLabelFields[1], col2_center - (labelWidth / 2) + 1, 2, sensiLabel, FONT_6x8, colorSensi);
+  if (isExtPotSensiTarget() && !(isEditing && selectedItem == 1)) {
+    formatExtPotLabel(msgStr, sizeof(msgStr), getExtPotIndexForTarget(EXT_POT_TARGET_SENSI));
+    oledFieldDraw(&g_raceValueFields[1], col2_center - ((strlen(msgStr) * WIDTH8x8) / 2), 12, msgStr, FONT_8x8, colorSensi);
+  } else {
+    /* Value in 0.5% resolution, e.g. 20.5% */
+    uint16_t sensiRaw = getEffectiveSensiRaw();
+    sprintf(msgStr, "%2u.%u%%", sensiRaw / SENSI_SCALE, sensiFracDigit(sensiRaw));
+    oledFieldDraw(&g_raceValueFields[1], col2_center - 20, 12, msgStr, FONT_8x8, colorSensi);
   }
 
   /* ANTIS - left column, lower */
-  if (g_storedVar.carParam[g_carSel].antiSpin != lastAntis || g_antiSpinDisplayMode != lastAntisMode) {
-    /* Label - using language-specific text, dynamically centered */
-    const char* antisLabel = getRaceLabel(g_storedVar.language, 2);
-    uint8_t labelWidth = strlen(antisLabel) * 6;
-    obdWriteString(&g_obd, 0, col1_center - (labelWidth / 2), 24, (char *)antisLabel, FONT_6x8, colorAntis, 1);
-    formatAntiSpinValue(msgStr, sizeof(msgStr), g_storedVar.carParam[g_carSel].antiSpin);
-    uint8_t valueWidth = (uint8_t)strlen(msgStr) * WIDTH8x8;
-    obdWriteString(&g_obd, 0, col1_center - (valueWidth / 2), 34, msgStr, FONT_8x8, colorAntis, 1);
-    lastAntis = g_storedVar.carParam[g_carSel].antiSpin;
-    lastAntisMode = g_antiSpinDisplayMode;
-  }
+  /* Label - using language-specific text, dynamically centered */
+  const char* antisLabel = uiText(UI_TEXT_RACE, g_storedVar.language, 2);
+  labelWidth = strlen(antisLabel) * 6;
+  oledFieldDraw(&g_raceLabelFields[2], col1_center - (labelWidth / 2), 24, antisLabel, FONT_6x8, colorAntis);
+  formatAntiSpinValue(msgStr, sizeof(msgStr), g_storedVar.activeCar.antiSpin);
+  uint8_t valueWidth = (uint8_t)strlen(msgStr) * WIDTH8x8;
+  oledFieldDraw(&g_raceValueFields[2], col1_center - (valueWidth / 2), 34, msgStr, FONT_8x8, colorAntis);
 
   /* CURVE - right column, lower */
-  if (g_storedVar.carParam[g_carSel].throttleCurveVertex.curveSpeedDiff != lastCurve) {
-    /* Label - using language-specific text, shifted 1px right */
-    const char* curveLabel = getRaceLabel(g_storedVar.language, 3);
-    uint8_t labelWidth = strlen(curveLabel) * 6;
-    obdWriteString(&g_obd, 0, col2_center - (labelWidth / 2) + 1, 24, (char *)curveLabel, FONT_6x8, colorCurve, 1);
-    /* Value */
-    sprintf(msgStr, "%3d%%", g_storedVar.carParam[g_carSel].throttleCurveVertex.curveSpeedDiff);
-    obdWriteString(&g_obd, 0, col2_center - 16, 34, msgStr, FONT_8x8, colorCurve, 1);
-    lastCurve = g_storedVar.carParam[g_carSel].throttleCurveVertex.curveSpeedDiff;
+  /* Label - using language-specific text, shifted 1px right */
+  const char* curveLabel = uiText(UI_TEXT_RACE, g_storedVar.language, 3);
+  labelWidth = strlen(curveLabel) * 6;
+  oledFieldDraw(&g_raceLabelFields[3], col2_center - (labelWidth / 2) + 1, 24, curveLabel, FONT_6x8, colorCurve);
+  /* Value */
+  const ThrottleCurveShape_type* curveShape = &g_storedVar.activeCar.throttleCurveShape;
+  if (throttleCurveShapeActive(curveShape)) {
+    sprintf(msgStr, "%s%u", (curveShape->mode == THROTTLE_CURVE_MODE_SPLINE) ? "SP" : "LN", (unsigned)curveShape->count);
+  } else {
+    sprintf(msgStr, "%3d%%", g_storedVar.activeCar.throttleCurveVertex.curveSpeedDiff);
   }
+  oledFieldDraw(&g_raceValueFields[3], col2_center - 16, 34, msgStr, FONT_8x8, colorCurve);
 
   /* Note: Car name, voltage, and LIMITER warning are displayed by displayStatusLine() */
   /* CAR selection (item 4) uses the existing car name display in status line when enabled */
@@ -388,26 +393,34 @@ void displayRaceMode(uint8_t selectedItem, bool isEditing) {
 /**
  * @brief Show screensaver with branding
  * @details Displays personalized branding only (full screen, no status line).
- *          Text is configurable on-device and via web UI.
+ *          Text is configurable on-device and via web UI; the rendered screen is cached per text.
  */
 void showScreensaver() {
+  uint32_t screenKey = oledScreenKeyBegin(OLED_SCREEN_SCREENSAVER);
+  screenKey = oledScreenKeyAddString(screenKey, g_storedVar.screensaverLine1);
+  screenKey = oledScreenKeyAddString(screenKey, g_storedVar.screensaverLine2);
+  if (oledScreenCacheShow(screenKey)) {
+    return;
+  }
+
   /* Clear screen */
-  obdFill(&g_obd, OBD_WHITE, 1);
+  oledFrameClear();
 
   /* Calculate text width for centering (16 pixels per character for FONT_16x32) */
   int line1_width = strlen(g_storedVar.screensaverLine1) * 16;
   int line1_x = (OLED_WIDTH - line1_width) / 2;
 
   /* Display main text in extra large font centered */
-  obdWriteString(&g_obd, 0, line1_x, 8, g_storedVar.screensaverLine1, FONT_16x32, OBD_BLACK, 1);
+  obdWriteString(&g_obd, 0, line1_x, 8, g_storedVar.screensaverLine1, FONT_16x32, OBD_BLACK, OLED_FRAME_RENDER);
 
   /* Calculate text width for centering (6 pixels per character for FONT_6x8) */
   int line2_width = strlen(g_storedVar.screensaverLine2) * 6;
   int line2_x = (OLED_WIDTH - line2_width) / 2;
 
   /* Display subtitle in smaller font centered below */
-  obdWriteString(&g_obd, 0, line2_x, 34, g_storedVar.screensaverLine2, FONT_6x8, OBD_BLACK, 1);
+  obdWriteString(&g_obd, 0, line2_x, 34, g_storedVar.screensaverLine2, FONT_6x8, OBD_BLACK, OLED_FRAME_RENDER);
 
+  oledScreenCachePresent(screenKey);
 }
 
 /**
@@ -437,6 +450,7 @@ void printMainMenu(MenuState_enum currMenuState)
   uint8_t visibleLines = min(getMenuLines(), mainMenuItems);
 
   if (visibleLines < 1) visibleLines = 1;
+  if (visibleLines > UI_MENU_MAX_LINES) visibleLines = UI_MENU_MAX_LINES;
   if (g_encoderMainSelector < 1) g_encoderMainSelector = 1;
   if (g_encoderMainSelector > mainMenuItems) g_encoderMainSelector = mainMenuItems;
 
@@ -445,7 +459,7 @@ void printMainMenu(MenuState_enum currMenuState)
     frameUpper = 1;
     frameLower = visibleLines;
     lastVisibleLines = visibleLines;
-    obdFill(&g_obd, OBD_WHITE, 1);
+    oledFrameClear();
   }
 
   /* In encoder move out of frame, adjust frame */
@@ -453,14 +467,14 @@ void printMainMenu(MenuState_enum currMenuState)
   {
     frameLower = g_encoderMainSelector;
     frameUpper = frameLower - visibleLines + 1;
-    obdFill(&g_obd, OBD_WHITE, 1);
+    oledFrameClear();
     screensaverActive = false;
   }
   else if (g_encoderMainSelector < frameUpper)
   {
     frameUpper = g_encoderMainSelector;
     frameLower = frameUpper + visibleLines - 1;
-    obdFill(&g_obd, OBD_WHITE, 1);
+    oledFrameClear();
     screensaverActive = false;
   }
 
@@ -485,12 +499,12 @@ void printMainMenu(MenuState_enum currMenuState)
     if (lastViewMode != VIEW_MODE_GRID) {
       lastViewMode = VIEW_MODE_GRID;
       g_forceRaceRedraw = true;
-      obdFill(&g_obd, OBD_WHITE, 1);
+      oledFrameClear();
     }
 
     /* Clear screen if coming from screensaver */
     if (screensaverActive) {
-      obdFill(&g_obd, OBD_WHITE, 1);
+      oledFrameClear();
       screensaverActive = false;
     }
 
@@ -521,15 +535,7 @@ void printMainMenu(MenuState_enum currMenuState)
     }
     g_forceRaceRedraw = false;  /* Reset force redraw flag after display */
 
-    /* Print LIMITER warning if LIMIT is any value other than 100% */
-    if (g_storedVar.carParam[g_carSel].maxSpeed < MAX_SPEED_DEFAULT)
-    {
-      obdWriteString(&g_obd, 0, WIDTH8x8, 3 * HEIGHT12x16, (char *)STR_LIMITER[g_storedVar.language], FONT_8x8, OBD_WHITE, 1);
-    }
-    else
-    {
-      obdWriteString(&g_obd, 0, WIDTH8x8, 3 * HEIGHT12x16, (char *)"             ", FONT_8x8, OBD_BLACK, 1);
-    }
+    drawLimiterWarning();
   }
   else {
   /* LIST mode: show screensaver or menu */
@@ -540,7 +546,7 @@ void printMainMenu(MenuState_enum currMenuState)
 
   bool wakeUpTriggered = refreshIdleInteractionFromControls(&g_lastEncoderInteraction, &screensaverActive, &screensaverEncoderPos);
   if (wakeUpTriggered) {
-    obdFill(&g_obd, OBD_WHITE, 1);
+    oledFrameClear();
   }
 
   if (g_storedVar.screensaverTimeout > 0 && millis() - g_lastEncoderInteraction > (g_storedVar.screensaverTimeout * 1000UL))
@@ -564,9 +570,7 @@ void printMainMenu(MenuState_enum currMenuState)
         millis() - g_lastEncoderInteraction > (g_storedVar.screensaverTimeout * 1000UL) + ((uint32_t)g_storedVar.deepSleepTimeout * 60000UL)) {
       showDeepSleep();  /* Never returns */
     }
-    /* Screensaver is active - don't draw menu.
-     * Yield to FreeRTOS so the IDLE task can feed the watchdog timer. */
-    vTaskDelay(10);
+    /* Screensaver is active - don't draw menu (Task1 sleeps on the input queue after this pass) */
   }
   else if (!screensaverActive)
   {
@@ -582,7 +586,7 @@ void printMainMenu(MenuState_enum currMenuState)
       if (menuIndex >= mainMenuItems) break;
       /* Print item name */
       /* Item color: WHITE if item is selected, black otherwise */
-      obdWriteString(&g_obd, 0, 0, i * lineHeight, g_mainMenu.item[menuIndex].name, menuFont, (g_encoderMainSelector - frameUpper == i) ? OBD_WHITE : OBD_BLACK, 1);
+      oledFieldDraw(&g_menuNameFields[i], 0, i * lineHeight, g_mainMenu.item[menuIndex].name, menuFont, (g_encoderMainSelector - frameUpper == i) ? OBD_WHITE : OBD_BLACK);
 
       /* Only print value if value != ITEM_NO_VALUE */
       /* Value color: WHITE if corresponding item is selected AND menu state is VALUE_SELECTION, black otherwise */
@@ -592,7 +596,7 @@ void printMainMenu(MenuState_enum currMenuState)
         /* if the value is a number, cast to *(unit16_t *), then print number and unit */
         if (g_mainMenu.item[menuIndex].type == VALUE_TYPE_INTEGER)
         {
-          if (strcmp(g_mainMenu.item[menuIndex].name, getMenuName(g_storedVar.language, 0)) == 0) {
+          if (strcmp(g_mainMenu.item[menuIndex].name, uiText(UI_TEXT_MENU, g_storedVar.language, 0)) == 0) {
             if (isExtPotBrakeTarget() && !isSelectedValueEditing) {
               formatExtPotLabel(msgStr, sizeof(msgStr), getExtPotIndexForTarget(EXT_POT_TARGET_BRAKE));
             } else {
@@ -600,7 +604,7 @@ void printMainMenu(MenuState_enum currMenuState)
             }
           }
           /* SENSI is stored in 0.5% steps and shown with one decimal */
-          else if (strcmp(g_mainMenu.item[menuIndex].name, getMenuName(g_storedVar.language, 1)) == 0) {
+          else if (strcmp(g_mainMenu.item[menuIndex].name, uiText(UI_TEXT_MENU, g_storedVar.language, 1)) == 0) {
             if (isExtPotSensiTarget() && !isSelectedValueEditing) {
               formatExtPotLabel(msgStr, sizeof(msgStr), getExtPotIndexForTarget(EXT_POT_TARGET_SENSI));
             } else {
@@ -608,8 +612,8 @@ void printMainMenu(MenuState_enum currMenuState)
               sprintf(msgStr, "%2u.%u%%", sensiRaw / SENSI_SCALE, sensiFracDigit(sensiRaw));
             }
           }
-          else if (strcmp(g_mainMenu.item[menuIndex].name, getMenuName(g_storedVar.language, 2)) == 0) {
-            formatAntiSpinValue(msgStr, sizeof(msgStr), g_storedVar.carParam[g_carSel].antiSpin);
+          else if (strcmp(g_mainMenu.item[menuIndex].name, uiText(UI_TEXT_MENU, g_storedVar.language, 2)) == 0) {
+            formatAntiSpinValue(msgStr, sizeof(msgStr), g_storedVar.activeCar.antiSpin);
           }
           else {
             /* value is a generic pointer to void, so first cast to uint16_t pointer, then take the pointed value */
@@ -617,7 +621,7 @@ void printMainMenu(MenuState_enum currMenuState)
           }
           /* Right-align: calculate text width and position from right edge */
           int textWidth = strlen(msgStr) * charWidth;
-          obdWriteString(&g_obd, 0, OLED_WIDTH - textWidth, i * lineHeight, msgStr, menuFont, (isSelectedValueEditing ? OBD_WHITE : OBD_BLACK), 1);
+          oledFieldDraw(&g_menuValueFields[i], OLED_WIDTH - textWidth, i * lineHeight, msgStr, menuFont, (isSelectedValueEditing ? OBD_WHITE : OBD_BLACK));
         }
         /* If the value is a decimal, cast to *(unit16_t *), divide by 10^decimalPoint then print number and unit */
         else if (g_mainMenu.item[menuIndex].type == VALUE_TYPE_DECIMAL)
@@ -627,7 +631,7 @@ void printMainMenu(MenuState_enum currMenuState)
           sprintf(msgStr, " %d.%01d%s", tmp / 10, (tmp % 10), g_mainMenu.item[menuIndex].unit);
           /* Right-align: calculate text width and position from right edge */
           int textWidth = strlen(msgStr) * charWidth;
-          obdWriteString(&g_obd, 0, OLED_WIDTH - textWidth, i * lineHeight, msgStr, menuFont, (((g_encoderMainSelector - frameUpper == i) && (currMenuState == VALUE_SELECTION)) ? OBD_WHITE : OBD_BLACK), 1);
+          oledFieldDraw(&g_menuValueFields[i], OLED_WIDTH - textWidth, i * lineHeight, msgStr, menuFont, (((g_encoderMainSelector - frameUpper == i) && (currMenuState == VALUE_SELECTION)) ? OBD_WHITE : OBD_BLACK));
         }
         /* If the value is a string, cast to (char *) then print the string */
         else if (g_mainMenu.item[menuIndex].type == VALUE_TYPE_STRING)
@@ -636,7 +640,7 @@ void printMainMenu(MenuState_enum currMenuState)
           if (strcmp(g_mainMenu.item[menuIndex].name, "VIEW") == 0) {
             uint16_t raceViewMode = *(uint16_t *)(g_mainMenu.item[menuIndex].value);
             uint16_t lang = g_storedVar.language;
-            sprintf(msgStr, "%6s", VIEW_MODE_LABELS[lang][raceViewMode]);
+            sprintf(msgStr, "%6s", uiTextUpper(UI_TEXT_VIEW_MODE, lang, raceViewMode));
           }
           /* Special handling for LANG menu item */
           else if (strcmp(g_mainMenu.item[menuIndex].name, "LANG") == 0) {
@@ -650,26 +654,19 @@ void printMainMenu(MenuState_enum currMenuState)
           }
           /* Right-align: calculate text width and position from right edge */
           int textWidth = strlen(msgStr) * charWidth;
-          obdWriteString(&g_obd, 0, OLED_WIDTH - textWidth, i * lineHeight, msgStr, menuFont, (((g_encoderMainSelector - frameUpper == i) && (currMenuState == VALUE_SELECTION)) ? OBD_WHITE : OBD_BLACK), 1);
+          oledFieldDraw(&g_menuValueFields[i], OLED_WIDTH - textWidth, i * lineHeight, msgStr, menuFont, (((g_encoderMainSelector - frameUpper == i) && (currMenuState == VALUE_SELECTION)) ? OBD_WHITE : OBD_BLACK));
         }
       }
     }
 
     initMenuItems();  /* update menu items with the storedVar that could have been changed in previous for cycle */
-    /* Print LIMITER warning if LIMIT is any value other than 100% */
-    if (g_storedVar.carParam[g_carSel].maxSpeed < MAX_SPEED_DEFAULT) 
-    {
-      obdWriteString(&g_obd, 0, WIDTH8x8, 3 * HEIGHT12x16, (char *)STR_LIMITER[g_storedVar.language], FONT_8x8, OBD_WHITE, 1);
-    } 
-    else
-    {
-      obdWriteString(&g_obd, 0, WIDTH8x8, 3 * HEIGHT12x16, (char *)"             ", FONT_8x8, OBD_BLACK, 1);
-    }
+    drawLimiterWarning();
   }
   } /* End of else (LIST mode) */
 
   /* Display bottom status line – only when screensaver is not active */
   if (!screensaverActive) {
-    displayStatusLine();
+    drawStatusLine();
   }
+  oledFrameFlush();
 }
@@ -0,0 +1,394 @@
+/* Generated by scripts/build_ui_strings.py from ui_strings_src.json. Do not edit. */
+
+#include "ui_string_pool.h"
+
+/* Upper-case labels, each stored once */
+const char UI_TEXT_POOL[] =
+  /*    0 */ "STATUSLEISTE\0"
+  /*   13 */ "BARRA STATO\0"
+  /*   25 */ "STATUSLINJE\0"
+  /*   37 */ "DEEP SLEEP\0"
+  /*   48 */ "RACE MODUS\0"
+  /*   59 */ "SKRIFTSTRL\0"
+  /*   70 */ "SONNO PROF\0"
+  /*   81 */ "STATUS BAR\0"
+  /*   92 */ "STATUSBALK\0"
+  /*  103 */ "ANTISPINN\0"
+  /*  113 */ "BARRA EST\0"
+  /*  123 */ "DIM TESTO\0"
+  /*  133 */ "FONT SIZE\0"
+  /*  143 */ "ITEM MENU\0"
+  /*  153 */ "MENU ITEM\0"
+  /*  163 */ "MENUPUNKT\0"
+  /*  173 */ "MODO GARA\0"
+  /*  183 */ "MODO RACE\0"
+  /*  193 */ "NULLSTILL\0"
+  /*  203 */ "RACE MODE\0"
+  /*  213 */ "RACEMODUS\0"
+  /*  223 */ "SONO PROF\0"
+  /*  233 */ "SUSP PROF\0"
+  /*  243 */ "TAM TEXTO\0"
+  /*  253 */ "TIEF SCHL\0"
+  /*  263 */ "VOCE MENU\0"
+  /*  273 */ "ANTISPIN\0"
+  /*  282 */ "ARRANQUE\0"
+  /*  291 */ "BEVESTIG\0"
+  /*  300 */ "DIEP SLP\0"
+  /*  309 */ "HARDWARE\0"
+  /*  318 */ "INDIETRO\0"
+  /*  327 */ "INNSTILL\0"
+  /*  336 */ "LANGUAGE\0"
+  /*  345 */ "MENYVALG\0"
+  /*  354 */ "OPPSTART\0"
+  /*  363 */ "PANTALLA\0"
+  /*  372 */ "RACEMODE\0"
+  /*  381 */ "SCORCIAT\0"
+  /*  390 */ "SETTINGS\0"
+  /*  399 */ "SHORTCUT\0"
+  /*  408 */ "TEKSTGRT\0"
+  /*  417 */ "USB INFO\0"
+  /*  426 */ "VIN CAL.\0"
+  /*  435 */ "VIN KAL.\0"
+  /*  444 */ "*CARRO*\0"
+  /*  452 */ "AJUSTES\0"
+  /*  460 */ "ANZEIGE\0"
+  /*  468 */ "BEKREFT\0"
+  /*  476 */ "BESTAET\0"
+  /*  484 */ "BLOQUEO\0"
+  /*  492 */ "BREMSE+\0"
+  /*  500 */ "CARRERA\0"
+  /*  508 */ "CONFIRM\0"
+  /*  516 */ "CORRIDA\0"
+  /*  524 */ "DISPLAY\0"
+  /*  532 */ "DYP SOV\0"
+  /*  540 */ "ENERGIA\0"
+  /*  548 */ "HERNOEM\0"
+  /*  556 */ "INSTELL\0"
+  /*  564 */ "KUERZEL\0"
+  /*  572 */ "LOGGING\0"
+  /*  580 */ "POTENZA\0"
+  /*  588 */ "RACESWP\0"
+  /*  596 */ "SCHERMO\0"
+  /*  604 */ "SCHRIFT\0"
+  /*  612 */ "SNARVEI\0"
+  /*  620 */ "SNELKOP\0"
+  /*  628 */ "SPRACHE\0"
+  /*  636 */ "STARTUP\0"
+  /*  644 */ "TILBAKE\0"
+  /*  652 */ "TRAVAO+\0"
+  /*  660 */ "*AUTO*\0"
+  /*  667 */ "ACERCA\0"
+  /*  674 */ "ATALHO\0"
+  /*  681 */ "ATTACK\0"
+  /*  688 */ "BLOCCO\0"
+  /*  695 */ "BRAKE+\0"
+  /*  702 */ "BREMS+\0"
+  /*  709 */ "BREMSE\0"
+  /*  716 */ "CHOKE1\0"
+  /*  723 */ "CHOKE2\0"
+  /*  730 */ "COPIAR\0"
+  /*  737 */ "DORMIR\0"
+  /*  744 */ "ELEGIR\0"
+  /*  751 */ "ESCOLH\0"
+  /*  758 */ "ESTILO\0"
+  /*  765 */ "FRENO+\0"
+  /*  772 */ "GELUID\0"
+  /*  779 */ "IDIOMA\0"
+  /*  786 */ "INICIO\0"
+  /*  793 */ "KOPIER\0"
+  /*  800 */ "LIMIET\0"
+  /*  807 */ "LIMITE\0"
+  /*  814 */ "LINGUA\0"
+  /*  821 */ "NAVNGI\0"
+  /*  828 */ "PROFIL\0"
+  /*  835 */ "Pascal\0"
+  /*  842 */ "RENAME\0"
+  /*  849 */ "RENNEN\0"
+  /*  856 */ "RENOMB\0"
+  /*  863 */ "RENOME\0"
+  /*  870 */ "REPOSO\0"
+  /*  877 */ "RIPOSO\0"
+  /*  884 */ "SCEGLI\0"
+  /*  891 */ "SCHLAF\0"
+  /*  898 */ "SELECT\0"
+  /*  905 */ "SIMPLE\0"
+  /*  912 */ "SKJERM\0"
+  /*  919 */ "SLAPEN\0"
+  /*  926 */ "SONIDO\0"
+  /*  933 */ "SPERRE\0"
+  /*  940 */ "STROOM\0"
+  /*  947 */ "TRAVAO\0"
+  /*  954 */ "VOLTAR\0"
+  /*  961 */ "ZURUCK\0"
+  /*  968 */ "*BIL*\0"
+  /*  974 */ "*CAR*\0"
+  /*  980 */ "ABOUT\0"
+  /*  986 */ "ANTIS\0"
+  /*  992 */ "ATAJO\0"
+  /*  998 */ "ATRAS\0"
+  /* 1004 */ "AVVIO\0"
+  /* 1010 */ "BRAKE\0"
+  /* 1016 */ "BREMS\0"
+  /* 1022 */ "CHOKE\0"
+  /* 1028 */ "COPIA\0"
+  /* 1034 */ "CURVA\0"
+  /* 1040 */ "CURVE\0"
+  /* 1046 */ "DVALE\0"
+  /* 1052 */ "ENKEL\0"
+  /* 1058 */ "FRENO\0"
+  /* 1064 */ "GRAND\0"
+  /* 1070 */ "GROOT\0"
+  /* 1076 */ "GROSS\0"
+  /* 1082 */ "HOOFD\0"
+  /* 1088 */ "KOPIE\0"
+  /* 1094 */ "KURVE\0"
+  /* 1100 */ "LARGE\0"
+  /* 1106 */ "LIMIT\0"
+  /* 1112 */ "MAIUS\0"
+  /* 1118 */ "MAYUS\0"
+  /* 1124 */ "PIENO\0"
+  /* 1130 */ "POWER\0"
+  /* 1136 */ "PWM_F\0"
+  /* 1142 */ "RESET\0"
+  /* 1148 */ "RINOM\0"
+  /* 1154 */ "SCRSV\0"
+  /* 1160 */ "SEMPL\0"
+  /* 1166 */ "SENSI\0"
+  /* 1172 */ "SETUP\0"
+  /* 1178 */ "SKJSP\0"
+  /* 1184 */ "SOBRE\0"
+  /* 1190 */ "SOUND\0"
+  /* 1196 */ "SPRAK\0"
+  /* 1202 */ "STATS\0"
+  /* 1208 */ "STIJL\0"
+  /* 1214 */ "STILE\0"
+  /* 1220 */ "STROM\0"
+  /* 1226 */ "SUONO\0"
+  /* 1232 */ "TERUG\0"
+  /* 1238 */ "TOTAL\0"
+  /* 1244 */ "UPPER\0"
+  /* 1250 */ "VERGR\0"
+  /* 1256 */ "klein\0"
+  /* 1262 */ "liten\0"
+  /* 1268 */ "picc.\0"
+  /* 1274 */ "small\0"
+  /* 1280 */ "BACK\0"
+  /* 1285 */ "BLOQ\0"
+  /* 1290 */ "BOOT\0"
+  /* 1295 */ "CASE\0"
+  /* 1300 */ "COPY\0"
+  /* 1305 */ "ECRA\0"
+  /* 1310 */ "EENV\0"
+  /* 1315 */ "EINF\0"
+  /* 1320 */ "FADE\0"
+  /* 1325 */ "FULL\0"
+  /* 1330 */ "KIES\0"
+  /* 1335 */ "LOCK\0"
+  /* 1340 */ "REM+\0"
+  /* 1345 */ "SIMP\0"
+  /* 1350 */ "STIL\0"
+  /* 1355 */ "STOR\0"
+  /* 1360 */ "STYL\0"
+  /* 1365 */ "TAAL\0"
+  /* 1370 */ "VELG\0"
+  /* 1375 */ "VOLL\0"
+  /* 1380 */ "WAHL\0"
+  /* 1385 */ "WIFI\0"
+  /* 1390 */ "peq.\0"
+  /* 1395 */ "10s\0"
+  /* 1399 */ "AAN\0"
+  /* 1403 */ "AUS\0"
+  /* 1407 */ "DRG\0"
+  /* 1411 */ "EIN\0"
+  /* 1415 */ "LAS\0"
+  /* 1419 */ "LYD\0"
+  /* 1423 */ "OFF\0"
+  /* 1427 */ "QCK\0"
+  /* 1431 */ "REM\0"
+  /* 1435 */ "SOM\0"
+  /* 1439 */ "TON\0"
+  /* 1443 */ "UIT\0"
+  /* 1447 */ "VOL\0"
+  /* 1451 */ "1s\0"
+  /* 1454 */ "2s\0"
+  /* 1457 */ "3s\0"
+  /* 1460 */ "4s\0"
+  /* 1463 */ "5s\0"
+  /* 1466 */ "6s\0"
+  /* 1469 */ "7s\0"
+  /* 1472 */ "8s\0"
+  /* 1475 */ "9s\0"
+  /* 1478 */ "AV\0"
+  /* 1481 */ "PA\0";
+
+/* [table][language][item]: pool offset | case rule << UI_TEXT_CASE_SHIFT */
+const uint16_t UI_TEXT_INDEX[] = {
+  /* MENU */
+  /* NOR */ 0x43F8, 0x448E, 0x43DA, 0x4446, 0x4528, 0x4470, 0x42BE, 0x44C4, 0x4147, 0x44B2, 0x4587, 0x43C8,
+  /* ENG */ 0x43F2, 0x448E, 0x43DA, 0x4410, 0x4528, 0x4470, 0x42B7, 0x4452, 0x4186, 0x44B2, 0x4537, 0x43CE,
+  /* CS  */ 0x43F2, 0x42A9, 0x42D3, 0x433C, 0x4528, 0x4470, 0x42B7, 0x42CC, 0x4186, 0x44B2, 0x4537, 0x43CE,
+  /* ACD */ 0x43F2, 0x448E, 0x43DA, 0x4410, 0x4528, 0x4470, 0x42B7, 0x43FE, 0x4186, 0x44B2, 0x4537, 0x43CE,
+  /* ESP */ 0x4422, 0x448E, 0x43DA, 0x440A, 0x4528, 0x4470, 0x42FD, 0x4327, 0x41C4, 0x44B2, 0x41E4, 0x4294,
+  /* DEU */ 0x42C5, 0x448E, 0x43DA, 0x4446, 0x4528, 0x4470, 0x41EC, 0x4452, 0x4494, 0x44B2, 0x43A5, 0x4294,
+  /* ITA */ 0x4422, 0x448E, 0x43DA, 0x440A, 0x4528, 0x4470, 0x42FD, 0x4327, 0x4494, 0x44B2, 0x42B0, 0x4294,
+  /* NLD */ 0x4597, 0x448E, 0x43DA, 0x4410, 0x4528, 0x4470, 0x453C, 0x4320, 0x422C, 0x44B2, 0x44E2, 0x4294,
+  /* POR */ 0x43B3, 0x448E, 0x43DA, 0x440A, 0x4528, 0x4470, 0x428C, 0x4327, 0x41C4, 0x44B2, 0x4505, 0x41BC,
+  /* SETTINGS_MENU */
+  /* NOR */ 0x44C4, 0x4390, 0x458B, 0x4135, 0x44B2, 0x4569, 0x423C, 0x4587, 0x81A1, 0x40C1, 0x41A5, 0x4284,
+  /* ENG */ 0x446A, 0x420C, 0x44A6, 0x4135, 0x44B2, 0x4569, 0x423C, 0x4537, 0x81A1, 0x4476, 0x43D4, 0x4500,
+  /* CS  */ 0x446A, 0x420C, 0x44A6, 0x4135, 0x44B2, 0x4569, 0x423C, 0x4537, 0x81A1, 0x4476, 0x43D4, 0x4500,
+  /* ACD */ 0x446A, 0x420C, 0x44A6, 0x4135, 0x44B2, 0x4569, 0x423C, 0x4537, 0x81A1, 0x4476, 0x43D4, 0x4500,
+  /* ESP */ 0x421C, 0x416B, 0x439E, 0x4135, 0x44B2, 0x4569, 0x423C, 0x41E4, 0x81A1, 0x4476, 0x429B, 0x43E6,
+  /* DEU */ 0x44C4, 0x41CC, 0x459F, 0x4135, 0x44B2, 0x4569, 0x423C, 0x43A5, 0x81A1, 0x4476, 0x41A5, 0x43C1,
+  /* ITA */ 0x4244, 0x4254, 0x44CA, 0x4135, 0x44B2, 0x4569, 0x423C, 0x42B0, 0x81A1, 0x4476, 0x41A5, 0x413E,
+  /* NLD */ 0x43AC, 0x420C, 0x4304, 0x4135, 0x44B2, 0x4569, 0x423C, 0x44E2, 0x81A1, 0x4476, 0x41A5, 0x44D0,
+  /* POR */ 0x421C, 0x4519, 0x459B, 0x4135, 0x44B2, 0x4569, 0x423C, 0x4505, 0x81A1, 0x4476, 0x44A0, 0x43BA,
+  /* POWER_MENU */
+  /* NOR */ 0x449A, 0x4416, 0x4214, 0x4162, 0x81B3, 0x4284,
+  /* ENG */ 0x4482, 0x402A, 0x4025, 0x427C, 0x41AA, 0x4500,
+  /* CS  */ 0x4482, 0x402A, 0x4025, 0x427C, 0x41AA, 0x4500,
+  /* ACD */ 0x4482, 0x402A, 0x4025, 0x427C, 0x41AA, 0x4500,
+  /* ESP */ 0x4482, 0x4366, 0x40E9, 0x411A, 0x41AA, 0x43E6,
+  /* DEU */ 0x4482, 0x437B, 0x40FD, 0x4165, 0x41B3, 0x43C1,
+  /* ITA */ 0x4482, 0x436D, 0x4046, 0x43EC, 0x41AA, 0x413E,
+  /* NLD */ 0x4482, 0x4397, 0x412C, 0x4165, 0x81B3, 0x44D0,
+  /* POR */ 0x4482, 0x42E1, 0x40DF, 0x411A, 0x41AA, 0x43BA,
+  /* DISPLAY_MENU */
+  /* NOR */ 0x40D5, 0x44AC, 0x4550, 0x403B, 0x4067, 0x4019, 0x4284,
+  /* ENG */ 0x40CB, 0x4150, 0x450F, 0x4085, 0x4111, 0x8051, 0x4500,
+  /* CS  */ 0x40CB, 0x4150, 0x450F, 0x4085, 0x4111, 0x8051, 0x4500,
+  /* ACD */ 0x40CB, 0x4150, 0x450F, 0x4085, 0x4111, 0x8051, 0x4500,
+  /* ESP */ 0x40B7, 0x430B, 0x42F6, 0x80F3, 0x4111, 0x8071, 0x43E6,
+  /* DEU */ 0x4030, 0x4274, 0x4546, 0x425C, 0x4111, 0x4000, 0x43C1,
+  /* ITA */ 0x40AD, 0x432E, 0x44BE, 0x807B, 0x4111, 0x800D, 0x413E,
+  /* NLD */ 0x4030, 0x4555, 0x44B8, 0x4198, 0x4111, 0x405C, 0x44D0,
+  /* POR */ 0x40B7, 0x430B, 0x42F6, 0x80F3, 0x4111, 0x8071, 0x43BA,
+  /* RACE */
+  /* NOR */ 0x43F8, 0x448E, 0x43DA, 0x4446,
+  /* ENG */ 0x43F2, 0x448E, 0x43DA, 0x4410,
+  /* CS  */ 0x43F2, 0x42A9, 0x42D3, 0x433C,
+  /* ACD */ 0x43F2, 0x448E, 0x43DA, 0x4410,
+  /* ESP */ 0x4422, 0x448E, 0x43DA, 0x440A,
+  /* DEU */ 0x42C5, 0x448E, 0x43DA, 0x4446,
+  /* ITA */ 0x4422, 0x448E, 0x43DA, 0x440A,
+  /* NLD */ 0x4597, 0x448E, 0x43DA, 0x4410,
+  /* POR */ 0x43B3, 0x448E, 0x43DA, 0x440A,
+  /* CAR_MENU */
+  /* NOR */ 0x455A, 0x4335, 0x424C, 0x4319, 0x40C1,
+  /* ENG */ 0x4382, 0x434A, 0x424C, 0x4514, 0x4476,
+  /* CS  */ 0x4382, 0x434A, 0x424C, 0x4514, 0x4476,
+  /* ACD */ 0x4382, 0x434A, 0x424C, 0x4514, 0x4476,
+  /* ESP */ 0x42E8, 0x4358, 0x424C, 0x42DA, 0x4476,
+  /* DEU */ 0x4564, 0x434C, 0x424C, 0x4319, 0x4476,
+  /* ITA */ 0x4374, 0x447C, 0x424C, 0x4404, 0x4476,
+  /* NLD */ 0x4532, 0x4224, 0x424C, 0x4440, 0x4476,
+  /* POR */ 0x42EF, 0x435F, 0x424C, 0x42DA, 0x4476,
+  /* VIEW_MODE */
+  /* NOR */ 0x45C6, 0x452D, 0x441C,
+  /* ENG */ 0x458F, 0x452D, 0x4389,
+  /* CS  */ 0x458F, 0x452D, 0x4389,
+  /* ACD */ 0x458F, 0x452D, 0x4389,
+  /* ESP */ 0x458F, 0x44D6, 0x4389,
+  /* DEU */ 0x457B, 0x455F, 0x4523,
+  /* ITA */ 0x458F, 0x4464, 0x4488,
+  /* NLD */ 0x45A3, 0x45A7, 0x451E,
+  /* POR */ 0x458F, 0x44D6, 0x4541,
+  /* SOUND_MENU */
+  /* NOR */ 0x4162, 0x4174, 0x4284,
+  /* ENG */ 0x450A, 0x40BC, 0x4500,
+  /* CS  */ 0x450A, 0x40BC, 0x4500,
+  /* ACD */ 0x450A, 0x40BC, 0x4500,
+  /* ESP */ 0x4312, 0x41F4, 0x43E6,
+  /* DEU */ 0x4165, 0x4351, 0x43C1,
+  /* ITA */ 0x43EC, 0x40B2, 0x413E,
+  /* NLD */ 0x4165, 0x40BC, 0x44D0,
+  /* POR */ 0x411A, 0x4204, 0x43BA,
+  /* ON_OFF */
+  /* NOR */ 0x45C6, 0x45C9,
+  /* ENG */ 0x458F, 0x45A0,
+  /* CS  */ 0x458F, 0x45A0,
+  /* ACD */ 0x458F, 0x45A0,
+  /* ESP */ 0x458F, 0x45A0,
+  /* DEU */ 0x457B, 0x4583,
+  /* ITA */ 0x458F, 0x45A0,
+  /* NLD */ 0x45A3, 0x4577,
+  /* POR */ 0x458F, 0x45A0,
+  /* RELEASE_BRAKE_MODE */
+  /* NOR */ 0x45C6, 0x4593, 0x457F,
+  /* ENG */ 0x458F, 0x4593, 0x457F,
+  /* CS  */ 0x458F, 0x4593, 0x457F,
+  /* ACD */ 0x458F, 0x4593, 0x457F,
+  /* ESP */ 0x458F, 0x4593, 0x457F,
+  /* DEU */ 0x457B, 0x4593, 0x457F,
+  /* ITA */ 0x458F, 0x4593, 0x457F,
+  /* NLD */ 0x45A3, 0x4593, 0x457F,
+  /* POR */ 0x458F, 0x4593, 0x457F,
+  /* LOCK_MENU */
+  /* NOR */ 0x4159, 0x4264, 0x41D4, 0x4284,
+  /* ENG */ 0x4099, 0x418F, 0x41FC, 0x4500,
+  /* CS  */ 0x4099, 0x418F, 0x41FC, 0x4500,
+  /* ACD */ 0x4099, 0x418F, 0x41FC, 0x4500,
+  /* ESP */ 0x4094, 0x43E0, 0x41FC, 0x43E6,
+  /* DEU */ 0x40A3, 0x4234, 0x41DC, 0x43C1,
+  /* ITA */ 0x4107, 0x417D, 0x41FC, 0x413E,
+  /* NLD */ 0x4099, 0x426C, 0x4123, 0x44D0,
+  /* POR */ 0x408F, 0x42A2, 0x41FC, 0x43BA,
+  /* LOCK_SHORTCUT */
+  /* NOR */ 0x05C6, 0x05AB, 0x05AE, 0x05B1, 0x05B4, 0x05B7, 0x05BA, 0x05BD, 0x05C0, 0x05C3, 0x0573,
+  /* ENG */ 0x058F, 0x05AB, 0x05AE, 0x05B1, 0x05B4, 0x05B7, 0x05BA, 0x05BD, 0x05C0, 0x05C3, 0x0573,
+  /* CS  */ 0x058F, 0x05AB, 0x05AE, 0x05B1, 0x05B4, 0x05B7, 0x05BA, 0x05BD, 0x05C0, 0x05C3, 0x0573,
+  /* ACD */ 0x058F, 0x05AB, 0x05AE, 0x05B1, 0x05B4, 0x05B7, 0x05BA, 0x05BD, 0x05C0, 0x05C3, 0x0573,
+  /* ESP */ 0x058F, 0x05AB, 0x05AE, 0x05B1, 0x05B4, 0x05B7, 0x05BA, 0x05BD, 0x05C0, 0x05C3, 0x0573,
+  /* DEU */ 0x057B, 0x05AB, 0x05AE, 0x05B1, 0x05B4, 0x05B7, 0x05BA, 0x05BD, 0x05C0, 0x05C3, 0x0573,
+  /* ITA */ 0x058F, 0x05AB, 0x05AE, 0x05B1, 0x05B4, 0x05B7, 0x05BA, 0x05BD, 0x05C0, 0x05C3, 0x0573,
+  /* NLD */ 0x05A3, 0x05AB, 0x05AE, 0x05B1, 0x05B4, 0x05B7, 0x05BA, 0x05BD, 0x05C0, 0x05C3, 0x0573,
+  /* POR */ 0x058F, 0x05AB, 0x05AE, 0x05B1, 0x05B4, 0x05B7, 0x05BA, 0x05BD, 0x05C0, 0x05C3, 0x0573,
+  /* BACK */
+  /* NOR */ 0x4284,
+  /* ENG */ 0x4500,
+  /* CS  */ 0x4500,
+  /* ACD */ 0x4500,
+  /* ESP */ 0x43E6,
+  /* DEU */ 0x43C1,
+  /* ITA */ 0x413E,
+  /* NLD */ 0x44D0,
+  /* POR */ 0x43BA,
+  /* TEXT_CASE */
+  /* NOR */ 0x04DC, 0x0343,
+  /* ENG */ 0x04DC, 0x0343,
+  /* CS  */ 0x04DC, 0x0343,
+  /* ACD */ 0x04DC, 0x0343,
+  /* ESP */ 0x045E, 0x0343,
+  /* DEU */ 0x0434, 0x0343,
+  /* ITA */ 0x0458, 0x0343,
+  /* NLD */ 0x043A, 0x0343,
+  /* POR */ 0x0458, 0x0343,
+  /* FONT_SIZE */
+  /* NOR */ 0x054B, 0x04EE,
+  /* ENG */ 0x044C, 0x04FA,
+  /* CS  */ 0x044C, 0x04FA,
+  /* ACD */ 0x044C, 0x04FA,
+  /* ESP */ 0x0428, 0x056E,
+  /* DEU */ 0x0434, 0x04E8,
+  /* ITA */ 0x0428, 0x04F4,
+  /* NLD */ 0x042E, 0x04E8,
+  /* POR */ 0x0428, 0x056E,
+};
+
+const UiTextTable_type UI_TEXT_TABLES[UI_TEXT_TABLE_COUNT] = {
+  {   0, 12},  /* UI_TEXT_MENU */
+  { 108, 12},  /* UI_TEXT_SETTINGS_MENU */
+  { 216,  6},  /* UI_TEXT_POWER_MENU */
+  { 270,  7},  /* UI_TEXT_DISPLAY_MENU */
+  { 333,  4},  /* UI_TEXT_RACE */
+  { 369,  5},  /* UI_TEXT_CAR_MENU */
+  { 414,  3},  /* UI_TEXT_VIEW_MODE */
+  { 441,  3},  /* UI_TEXT_SOUND_MENU */
+  { 468,  2},  /* UI_TEXT_ON_OFF */
+  { 486,  3},  /* UI_TEXT_RELEASE_BRAKE_MODE */
+  { 513,  4},  /* UI_TEXT_LOCK_MENU */
+  { 549, 11},  /* UI_TEXT_LOCK_SHORTCUT */
+  { 648,  1},  /* UI_TEXT_BACK */
+  { 657,  2},  /* UI_TEXT_TEXT_CASE */
+  { 675,  2},  /* UI_TEXT_FONT_SIZE */
+};
@@ -0,0 +1,61 @@
+/* Generated by scripts/build_ui_strings.py from ui_strings_src.json. Do not edit. */
+
+#ifndef UI_STRING_POOL_H_
+#define UI_STRING_POOL_H_
+
+#include <stdint.h>
+
+/* 1484 pool bytes and 693 index entries for 9 languages */
+typedef enum {
+  UI_TEXT_MENU,
+  UI_TEXT_SETTINGS_MENU,
+  UI_TEXT_POWER_MENU,
+  UI_TEXT_DISPLAY_MENU,
+  UI_TEXT_RACE,
+  UI_TEXT_CAR_MENU,
+  UI_TEXT_VIEW_MODE,
+  UI_TEXT_SOUND_MENU,
+  UI_TEXT_ON_OFF,
+  UI_TEXT_RELEASE_BRAKE_MODE,
+  UI_TEXT_LOCK_MENU,
+  UI_TEXT_LOCK_SHORTCUT,
+  UI_TEXT_BACK,
+  UI_TEXT_TEXT_CASE,
+  UI_TEXT_FONT_SIZE,
+  UI_TEXT_TABLE_COUNT
+} UiTextTable_enum;
+
+#define UI_TEXT_MENU_COUNT                  12
+#define UI_TEXT_SETTINGS_MENU_COUNT         12
+#define UI_TEXT_POWER_MENU_COUNT            6
+#define UI_TEXT_DISPLAY_MENU_COUNT          7
+#define UI_TEXT_RACE_COUNT                  4
+#define UI_TEXT_CAR_MENU_COUNT              5
+#define UI_TEXT_VIEW_MODE_COUNT             3
+#define UI_TEXT_SOUND_MENU_COUNT            3
+#define UI_TEXT_ON_OFF_COUNT                2
+#define UI_TEXT_RELEASE_BRAKE_MODE_COUNT    3
+#define UI_TEXT_LOCK_MENU_COUNT             4
+#define UI_TEXT_LOCK_SHORTCUT_COUNT         11
+#define UI_TEXT_BACK_COUNT                  1
+#define UI_TEXT_TEXT_CASE_COUNT             2
+#define UI_TEXT_FONT_SIZE_COUNT             2
+
+#define UI_TEXT_LANG_COUNT        9
+#define UI_TEXT_MAX_LEN           12     /* Longest label, without the terminator */
+#define UI_TEXT_OFFSET_MASK       0x3FFFU
+#define UI_TEXT_CASE_SHIFT        14
+#define UI_TEXT_CASE_FIXED        0     /* Shown as stored in both text cases */
+#define UI_TEXT_CASE_TITLE        1     /* Pascal: first letter of every word upper */
+#define UI_TEXT_CASE_SENTENCE     2     /* Pascal: only the first letter upper */
+
+typedef struct {
+  uint16_t firstEntry;   /* UI_TEXT_INDEX position of [language 0][item 0] */
+  uint8_t itemCount;     /* Items per language */
+} UiTextTable_type;
+
+extern const char UI_TEXT_POOL[];
+extern const uint16_t UI_TEXT_INDEX[];
+extern const UiTextTable_type UI_TEXT_TABLES[UI_TEXT_TABLE_COUNT];
+
+#endif  /* UI_STRING_POOL_H_ */
@@ -1,63 +1,64 @@
 #include "ui_text_access.h"
 #include "slot_ESC.h"
-#include "ui_strings.h"
 
 extern StoredVar_type g_storedVar;
 
-const char* getMenuName(uint8_t lang, uint8_t item) {
-  return (g_storedVar.textCase == TEXT_CASE_PASCAL) ? MENU_NAMES_PASCAL[lang][item] : MENU_NAMES[lang][item];
-}
-
-const char* getSettingsMenuName(uint8_t lang, uint8_t item) {
-  return (g_storedVar.textCase == TEXT_CASE_PASCAL) ? SETTINGS_MENU_NAMES_PASCAL[lang][item] : SETTINGS_MENU_NAMES[lang][item];
-}
-
-const char* getPowerMenuName(uint8_t lang, uint8_t item) {
-  return (g_storedVar.textCase == TEXT_CASE_PASCAL) ? POWER_MENU_NAMES_PASCAL[lang][item] : POWER_MENU_NAMES[lang][item];
-}
-
-const char* getDisplayMenuName(uint8_t lang, uint8_t item) {
-  return (g_storedVar.textCase == TEXT_CASE_PASCAL) ? DISPLAY_MENU_NAMES_PASCAL[lang][item] : DISPLAY_MENU_NAMES[lang][item];
-}
-
-const char* getRaceLabel(uint8_t lang, uint8_t param) {
-  return (g_storedVar.textCase == TEXT_CASE_PASCAL) ? RACE_LABELS_PASCAL[lang][param] : RACE_LABELS[lang][param];
-}
-
-const char* getCarMenuOption(uint8_t lang, uint8_t option) {
-  return (g_storedVar.textCase == TEXT_CASE_PASCAL) ? CAR_MENU_OPTIONS_PASCAL[lang][option] : CAR_MENU_OPTIONS[lang][option];
-}
-
-const char* getViewModeLabel(uint8_t lang, uint8_t mode) {
-  return (g_storedVar.textCase == TEXT_CASE_PASCAL) ? VIEW_MODE_LABELS_PASCAL[lang][mode] : VIEW_MODE_LABELS[lang][mode];
-}
-
-const char* getSoundMenuName(uint8_t lang, uint8_t item) {
-  return (g_storedVar.textCase == TEXT_CASE_PASCAL) ? SOUND_MENU_NAMES_PASCAL[lang][item] : SOUND_MENU_NAMES[lang][item];
-}
-
-const char* getOnOffLabel(uint8_t lang, uint8_t state) {
-  return (g_storedVar.textCase == TEXT_CASE_PASCAL) ? ON_OFF_LABELS_PASCAL[lang][state] : ON_OFF_LABELS[lang][state];
-}
+static char g_uiTextRing[UI_TEXT_RING_SIZE][UI_TEXT_MAX_LEN + 1];
+static uint8_t g_uiTextRingNext = 0;
 
-const char* getReleaseBrakeModeLabel(uint8_t lang, uint8_t mode) {
-  if (mode > RELEASE_BRAKE_DRAG) mode = RELEASE_BRAKE_OFF;
-  return (g_storedVar.textCase == TEXT_CASE_PASCAL)
-    ? RELEASE_BRAKE_MODE_LABELS_PASCAL[lang][mode]
-    : RELEASE_BRAKE_MODE_LABELS[lang][mode];
+static uint16_t uiTextEntry(uint8_t table, uint8_t lang, uint8_t item) {
+  if (table >= UI_TEXT_TABLE_COUNT) table = UI_TEXT_BACK;
+  if (lang >= UI_TEXT_LANG_COUNT) lang = LANG_ENG;
+  const UiTextTable_type* info = &UI_TEXT_TABLES[table];
+  if (item >= info->itemCount) item = 0;
+  return UI_TEXT_INDEX[info->firstEntry + (uint16_t)lang * info->itemCount + item];
 }
 
-const char* getLockMenuName(uint8_t lang, uint8_t item) {
-  return (g_storedVar.textCase == TEXT_CASE_PASCAL) ? LOCK_MENU_NAMES_PASCAL[lang][item] : LOCK_MENU_NAMES[lang][item];
+/**
+ * @brief Pascal spelling of an upper-case label (must match build_ui_strings.py)
+ * @details TITLE: first letter of every word upper, a word being a run of letters.
+ *          SENTENCE: only the first letter upper.
+ */
+static void uiTextApplyCase(char* out, const char* text, uint8_t rule) {
+  bool wordStarted = false;
+  bool firstSeen = false;
+  for (; *text; text++, out++) {
+    char c = *text;
+    bool letter = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+    if (!letter) {
+      *out = c;
+      wordStarted = false;
+      continue;
+    }
+    bool upper = (rule == UI_TEXT_CASE_TITLE) ? !wordStarted : !firstSeen;
+    *out = upper ? (char)toupper((unsigned char)c) : (char)tolower((unsigned char)c);
+    wordStarted = true;
+    firstSeen = true;
+  }
+  *out = '\0';
 }
 
-const char* getLockShortcutLabel(uint8_t lang, uint8_t idx) {
-  if (idx > LOCK_SHORTCUT_COUNT) idx = 0;
-  return LOCK_SHORTCUT_LABELS[lang][idx];
+/**
+ * @brief Label in the current text case
+ */
+const char* uiText(uint8_t table, uint8_t lang, uint8_t item) {
+  uint16_t entry = uiTextEntry(table, lang, item);
+  const char* text = &UI_TEXT_POOL[entry & UI_TEXT_OFFSET_MASK];
+  uint8_t rule = (uint8_t)(entry >> UI_TEXT_CASE_SHIFT);
+  if (g_storedVar.textCase != TEXT_CASE_PASCAL || rule == UI_TEXT_CASE_FIXED) {
+    return text;
+  }
+  char* out = g_uiTextRing[g_uiTextRingNext];
+  g_uiTextRingNext = (uint8_t)((g_uiTextRingNext + 1U) % UI_TEXT_RING_SIZE);
+  uiTextApplyCase(out, text, rule);
+  return out;
 }
 
-const char* getBackLabel(uint8_t lang) {
-  return (g_storedVar.textCase == TEXT_CASE_PASCAL) ? BACK_LABELS_PASCAL[lang] : BACK_LABELS[lang];
+/**
+ * @brief Label as stored (upper case), whatever the text case setting
+ */
+const char* uiTextUpper(uint8_t table, uint8_t lang, uint8_t item) {
+  return &UI_TEXT_POOL[uiTextEntry(table, lang, item) & UI_TEXT_OFFSET_MASK];
 }
 
 uint8_t getMenuLines() {
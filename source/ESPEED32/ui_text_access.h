@@ -2,20 +2,17 @@
 #define UI_TEXT_ACCESS_H_
 
 #include <Arduino.h>
+#include "ui_string_pool.h"
 
-const char* getMenuName(uint8_t lang, uint8_t item);
-const char* getSettingsMenuName(uint8_t lang, uint8_t item);
-const char* getPowerMenuName(uint8_t lang, uint8_t item);
-const char* getDisplayMenuName(uint8_t lang, uint8_t item);
-const char* getRaceLabel(uint8_t lang, uint8_t param);
-const char* getCarMenuOption(uint8_t lang, uint8_t option);
-const char* getViewModeLabel(uint8_t lang, uint8_t mode);
-const char* getSoundMenuName(uint8_t lang, uint8_t item);
-const char* getOnOffLabel(uint8_t lang, uint8_t state);
-const char* getReleaseBrakeModeLabel(uint8_t lang, uint8_t mode);
-const char* getLockMenuName(uint8_t lang, uint8_t item);
-const char* getLockShortcutLabel(uint8_t lang, uint8_t idx);
-const char* getBackLabel(uint8_t lang);
+/* OLED labels from the generated pool (scripts/build_ui_strings.py, ui_strings_src.json).
+ * uiText() follows g_storedVar.textCase: UPPER returns the pooled text as is, PASCAL
+ * derives the mixed-case spelling into one of UI_TEXT_RING_SIZE scratch buffers, so up to
+ * that many results stay valid at once. UI task only. Out-of-range items fall back to
+ * item 0, an unknown language to ENG. */
+#define UI_TEXT_RING_SIZE  4
+
+const char* uiText(uint8_t table, uint8_t lang, uint8_t item);
+const char* uiTextUpper(uint8_t table, uint8_t lang, uint8_t item);
 uint8_t getMenuLines();
 
 #endif  /* UI_TEXT_ACCESS_H_ */